@@ -6,10 +6,11 @@ attribute vec2 aTexCoord;
 uniform mat4 uProjection;
 uniform mat4 uView;
 uniform mat4 uModel;
+uniform vec4 uUVRect;
 
 varying vec2 TexCoord;
 
 void main() {
     gl_Position = uProjection * uView * uModel * vec4(aPos, 1.0);
-    TexCoord = aTexCoord;
+    TexCoord = mix(uUVRect.xy, uUVRect.zw, aTexCoord);
 }
\ No newline at end of file
@@ -66,7 +66,7 @@ public:
     void Update(float deltaTime) {
         if (m_engine) {
             // Обновляем AI системы
-            m_pathfindingManager.Update(deltaTime);
+            m_pathfindingManager.Update();
             m_behaviorTreeManager.Update(deltaTime);
             
             // Обновляем Cinematic Editor
@@ -152,9 +152,9 @@ private:
             }
         }
         
-        auto navMesh = std::make_shared<NavMesh>();
+        auto navMesh = std::make_unique<NavMesh>();
         if (navMesh->GenerateFromMesh(vertices, indices)) {
-            m_pathfindingManager.AddNavMesh("TestNavMesh", navMesh);
+            m_pathfindingManager.AddNavMesh("TestNavMesh", std::move(navMesh));
             std::cout << "Test NavMesh created successfully" << std::endl;
         }
     }
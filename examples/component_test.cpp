@@ -33,7 +33,7 @@ public:
         ResourceManager::GetInstance().Initialize();
         
         // Создаем системы через World
-        m_animationSystem = m_engine->GetWorld()->AddSystem<AnimationSystem>();
+        m_animationSystem = m_engine->GetWorld()->AddSystem<AnimationSystem>(m_engine->GetWorld());
         m_physicsSystem = m_engine->GetWorld()->AddSystem<PhysicsSystem>();
         
         // Создаем тестовые сущности
@@ -6,6 +6,10 @@
 #include <functional>
 #include <unordered_map>
 #include <any>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <glm/glm.hpp>
 
 namespace FastEngine {
 
@@ -225,8 +229,11 @@ public:
     
     // Выполнение
     BehaviorStatus Execute(BehaviorContext& context);
+    BehaviorStatus Execute() { return Execute(m_context); } // Со своим контекстом дерева
     void Reset();
     
+    BehaviorContext& GetContext() { return m_context; }
+    
     // Сериализация
     std::string Serialize() const;
     void Deserialize(const std::string& data);
@@ -246,13 +253,43 @@ private:
     BehaviorContext m_context;
 };
 
+class CompiledBehaviorTree;
+class BehaviorAgentGroup;
+class Blackboard;
+
+using BehaviorAgentId = uint32_t;
+constexpr BehaviorAgentId INVALID_BEHAVIOR_AGENT = 0xFFFFFFFFu;
+
+/**
+ * Уровень детализации ИИ: агенты дальше maxDistance от точки LOD
+ * (с учетом важности) тикают раз в tickInterval кадров
+ */
+struct BehaviorLodLevel {
+    float maxDistance;
+    int tickInterval;
+    
+    BehaviorLodLevel() : maxDistance(0.0f), tickInterval(1) {}
+    BehaviorLodLevel(float distance, int interval) : maxDistance(distance), tickInterval(interval) {}
+};
+
 /**
  * Менеджер деревьев поведения
+ *
+ * Деревья на узлах BehaviorNode тикаются последовательно со своим
+ * контекстом. Агенты скомпилированных деревьев планируются по кадрам:
+ * - интервал тика выбирается по уровням LOD от расстояния до точки LOD,
+ *   деленного на важность агента;
+ * - агенты с одним интервалом распределены по кадрам по фазе от
+ *   идентификатора, поэтому нагрузка не собирается в один кадр;
+ * - готовые агенты тикаются порциями через JobSystem::ParallelForRange
+ *   (без запущенного планировщика - в потоке Update);
+ * - при превышении бюджета кадра оставшиеся агенты переносятся на
+ *   следующий кадр и идут первыми. Время между тиками передается в дерево.
  */
 class BehaviorTreeManager {
 public:
     BehaviorTreeManager();
-    ~BehaviorTreeManager() = default;
+    ~BehaviorTreeManager();
     
     // Инициализация
     bool Initialize();
@@ -263,15 +300,92 @@ public:
     void RemoveTree(const std::string& name);
     std::shared_ptr<BehaviorTree> GetTree(const std::string& name) const;
     
+    // Скомпилированные деревья и их агенты
+    bool AddCompiledTree(const std::string& name, std::shared_ptr<const CompiledBehaviorTree> tree);
+    BehaviorAgentId AddAgent(const std::string& treeName);
+    void RemoveAgent(BehaviorAgentId agent);
+    bool HasAgent(BehaviorAgentId agent) const;
+    Blackboard GetBlackboard(BehaviorAgentId agent);
+    BehaviorStatus GetAgentStatus(BehaviorAgentId agent) const;
+    void SetAgentPosition(BehaviorAgentId agent, const glm::vec3& position);
+    void SetAgentImportance(BehaviorAgentId agent, float importance);
+    
+    // Настройки планировщика
+    void SetLodOrigin(const glm::vec3& origin) { m_lodOrigin = origin; }
+    void SetLodLevels(const std::vector<BehaviorLodLevel>& levels); // По возрастанию расстояния
+    void SetFrameBudget(float milliseconds) { m_frameBudgetMs = milliseconds; } // 0 - без ограничения
+    void SetUserData(void* userData) { m_userData = userData; }
+    
     // Выполнение
     void Update(float deltaTime);
     
     // Статистика
     int GetActiveTrees() const { return m_activeTrees.size(); }
+    size_t GetAgentCount() const { return m_agentCount; }
+    size_t GetLastTickedAgents() const { return m_lastTickedAgents; }
+    size_t GetLastDeferredAgents() const { return m_lastDeferredAgents; }
+    float GetLastUpdateTime() const { return m_lastUpdateTimeMs; }
     
 private:
+    // Расписание агента (индексы совпадают с индексами в BehaviorAgentGroup)
+    struct AgentSchedule {
+        glm::vec3 position;
+        float importance;
+        uint64_t nextTickFrame;
+        double lastTickTime;
+        uint32_t phase;
+    };
+    
+    struct AgentGroupEntry {
+        std::string name;
+        std::unique_ptr<BehaviorAgentGroup> group;
+        std::vector<AgentSchedule> schedule;
+        std::vector<BehaviorAgentId> ids;
+    };
+    
+    struct AgentLocation {
+        uint32_t group;
+        uint32_t index;
+        bool alive;
+    };
+    
+    struct TickItem {
+        uint32_t group;
+        uint32_t index;
+    };
+    
     std::unordered_map<std::string, std::shared_ptr<BehaviorTree>> m_trees;
     std::vector<std::string> m_activeTrees;
+    
+    // Агенты скомпилированных деревьев
+    std::vector<AgentGroupEntry> m_groups;
+    std::unordered_map<std::string, uint32_t> m_groupIndex;
+    std::vector<AgentLocation> m_agents;
+    std::vector<BehaviorAgentId> m_freeAgentIds;
+    size_t m_agentCount;
+    
+    // Планирование
+    std::vector<BehaviorLodLevel> m_lodLevels;
+    glm::vec3 m_lodOrigin;
+    float m_frameBudgetMs;
+    void* m_userData;
+    uint64_t m_frame;
+    double m_time;
+    std::vector<TickItem> m_dueAgents;
+    std::vector<TickItem> m_scheduledAgents;
+    size_t m_lastTickedAgents;
+    size_t m_lastDeferredAgents;
+    float m_lastUpdateTimeMs;
+    
+    // Порции тика раздаются заданиям JobSystem
+    std::atomic<size_t> m_tickedAgents;
+    std::chrono::steady_clock::time_point m_deadline;
+    
+    static constexpr size_t TICK_CHUNK_SIZE = 64;
+    
+    void RunTickChunks(size_t first, size_t last);
+    void TickAgent(const TickItem& item);
+    int GetTickInterval(const AgentSchedule& schedule) const;
 };
 
 } // namespace FastEngine
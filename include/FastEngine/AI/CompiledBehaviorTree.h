@@ -0,0 +1,311 @@
+#pragma once
+
+#include "FastEngine/AI/BehaviorTree.h"
+#include <vector>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace FastEngine {
+
+/**
+ * Ключ типизированного слота доски (смещение в блоке агента)
+ */
+template<typename T>
+struct BlackboardKey {
+    static constexpr uint32_t INVALID_OFFSET = 0xFFFFFFFFu;
+
+    uint32_t offset;
+
+    BlackboardKey() : offset(INVALID_OFFSET) {}
+    explicit BlackboardKey(uint32_t o) : offset(o) {}
+
+    bool IsValid() const { return offset != INVALID_OFFSET; }
+};
+
+/**
+ * Раскладка доски: имена слотов разрешаются в смещения один раз при
+ * построении дерева, во время тика доступ идет по смещению.
+ * Типы слотов - тривиально копируемые значения.
+ */
+class BlackboardLayout {
+public:
+    BlackboardLayout() : m_size(0) {}
+
+    // Добавление слота; повторный вызов с тем же именем и типом возвращает прежний ключ
+    template<typename T>
+    BlackboardKey<T> AddSlot(const std::string& name) {
+        static_assert(std::is_trivially_copyable<T>::value, "Blackboard slots must be trivially copyable");
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Blackboard slot alignment is too large");
+
+        for (const auto& slot : m_slots) {
+            if (slot.name == name) {
+                return slot.type == TypeTag<T>() ? BlackboardKey<T>(slot.offset) : BlackboardKey<T>();
+            }
+        }
+
+        uint32_t offset = (m_size + static_cast<uint32_t>(alignof(T)) - 1) & ~(static_cast<uint32_t>(alignof(T)) - 1);
+        m_slots.push_back(Slot{name, offset, TypeTag<T>()});
+        m_size = offset + static_cast<uint32_t>(sizeof(T));
+        return BlackboardKey<T>(offset);
+    }
+
+    // Поиск слота; недействительный ключ, если слота нет или тип другой
+    template<typename T>
+    BlackboardKey<T> FindSlot(const std::string& name) const {
+        for (const auto& slot : m_slots) {
+            if (slot.name == name && slot.type == TypeTag<T>()) {
+                return BlackboardKey<T>(slot.offset);
+            }
+        }
+        return BlackboardKey<T>();
+    }
+
+    size_t GetSlotCount() const { return m_slots.size(); }
+    uint32_t GetSize() const { return m_size; }
+
+private:
+    struct Slot {
+        std::string name;
+        uint32_t offset;
+        const void* type;
+    };
+
+    template<typename T>
+    static const void* TypeTag() {
+        static const char tag = 0;
+        return &tag;
+    }
+
+    std::vector<Slot> m_slots;
+    uint32_t m_size;
+};
+
+/**
+ * Доска одного агента - окно в общий блок состояний
+ */
+class Blackboard {
+public:
+    explicit Blackboard(unsigned char* data) : m_data(data) {}
+
+    template<typename T>
+    T Get(BlackboardKey<T> key) const {
+        T value;
+        std::memcpy(&value, m_data + key.offset, sizeof(T));
+        return value;
+    }
+
+    template<typename T>
+    void Set(BlackboardKey<T> key, const T& value) {
+        std::memcpy(m_data + key.offset, &value, sizeof(T));
+    }
+
+private:
+    unsigned char* m_data;
+};
+
+/**
+ * Контекст вызова условия или действия скомпилированного дерева
+ */
+struct BehaviorTickContext {
+    Blackboard blackboard;
+    uint32_t agent;
+    float deltaTime;
+    void* userData;
+
+    BehaviorTickContext(unsigned char* data, uint32_t a, float dt, void* user)
+        : blackboard(data), agent(a), deltaTime(dt), userData(user) {}
+};
+
+using BehaviorConditionFunc = bool (*)(BehaviorTickContext& context);
+using BehaviorActionFunc = BehaviorStatus (*)(BehaviorTickContext& context);
+
+/**
+ * Тип узла скомпилированного дерева
+ */
+enum class BehaviorNodeType : uint8_t {
+    Sequence,
+    Selector,
+    Parallel,
+    Condition,
+    Action,
+    Repeat,
+    Inverter,
+    Delay
+};
+
+/**
+ * Узел в плоском массиве (обход в прямом порядке): первый потомок лежит
+ * сразу за узлом, следующий брат - по индексу next. Слоты состояния
+ * поддерева занимают непрерывные диапазоны [stateSlot, stateEnd) и
+ * [timerSlot, timerEnd); собственный слот узла - первый в диапазоне.
+ */
+struct CompiledBehaviorNode {
+    static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    BehaviorNodeType type;
+    uint32_t parent;      // INVALID_INDEX у корня
+    uint32_t next;        // Индекс за концом поддерева
+    uint32_t childCount;
+    uint32_t stateSlot;   // Счетчик (Sequence, Selector, Parallel, Repeat)
+    uint32_t stateEnd;
+    uint32_t timerSlot;   // Таймер (Delay)
+    uint32_t timerEnd;
+    int32_t param0;       // Repeat: число повторов (< 0 - бесконечно); Parallel: требуемые успехи
+    int32_t param1;       // Parallel: требуемые неудачи
+    float delay;
+    uint32_t callback;    // Индекс условия или действия
+};
+
+/**
+ * Скомпилированное дерево поведения. Неизменяемо и разделяется всеми
+ * агентами; изменяемое состояние агентов хранит BehaviorAgentGroup.
+ */
+class CompiledBehaviorTree {
+public:
+    CompiledBehaviorTree();
+    ~CompiledBehaviorTree() = default;
+
+    const std::vector<CompiledBehaviorNode>& GetNodes() const { return m_nodes; }
+    const BlackboardLayout& GetLayout() const { return m_layout; }
+    uint32_t GetStateSlotCount() const { return m_stateSlotCount; }
+    uint32_t GetTimerSlotCount() const { return m_timerSlotCount; }
+
+    BehaviorConditionFunc GetCondition(uint32_t index) const { return m_conditions[index]; }
+    BehaviorActionFunc GetAction(uint32_t index) const { return m_actions[index]; }
+
+    // Parallel хранит статусы потомков по 2 бита в одном слоте
+    static constexpr uint32_t MAX_PARALLEL_CHILDREN = 16;
+
+private:
+    friend class BehaviorTreeBuilder;
+
+    std::vector<CompiledBehaviorNode> m_nodes;
+    std::vector<BehaviorConditionFunc> m_conditions;
+    std::vector<BehaviorActionFunc> m_actions;
+    BlackboardLayout m_layout;
+    uint32_t m_stateSlotCount;
+    uint32_t m_timerSlotCount;
+};
+
+/**
+ * Построитель скомпилированного дерева
+ *
+ *   BehaviorTreeBuilder builder;
+ *   auto target = builder.GetLayout().AddSlot<int>("target");
+ *   builder.Selector()
+ *              .Sequence().Condition(HasTarget).Action(Attack).End()
+ *              .Action(Patrol)
+ *          .End();
+ *   auto tree = builder.Build();
+ *
+ * Составные узлы (Sequence, Selector, Parallel, Repeat, Inverter)
+ * закрываются End(); Condition, Action и Delay - листья.
+ */
+class BehaviorTreeBuilder {
+public:
+    BehaviorTreeBuilder();
+    ~BehaviorTreeBuilder() = default;
+
+    BlackboardLayout& GetLayout() { return m_tree->m_layout; }
+
+    BehaviorTreeBuilder& Sequence();
+    BehaviorTreeBuilder& Selector();
+    BehaviorTreeBuilder& Parallel(int successRequired = 1, int failureRequired = 1);
+    BehaviorTreeBuilder& Repeat(int count = -1);
+    BehaviorTreeBuilder& Inverter();
+    BehaviorTreeBuilder& End();
+
+    BehaviorTreeBuilder& Condition(BehaviorConditionFunc condition);
+    BehaviorTreeBuilder& Action(BehaviorActionFunc action);
+    BehaviorTreeBuilder& Delay(float delay);
+
+    // Проверка и выдача дерева; nullptr при ошибке построения
+    std::shared_ptr<const CompiledBehaviorTree> Build();
+
+private:
+    std::shared_ptr<CompiledBehaviorTree> m_tree;
+    std::vector<uint32_t> m_openNodes;
+    bool m_valid;
+
+    uint32_t AddNode(BehaviorNodeType type, bool composite);
+};
+
+/**
+ * Состояния агентов одного скомпилированного дерева.
+ * Хранение - структура массивов по видам данных (статусы, счетчики,
+ * таймеры, доски); внутри каждого массива данные агента лежат подряд,
+ * так что тик агента читает несколько коротких непрерывных участков.
+ * Удаление агента переносит последнего агента на его место.
+ *
+ * Если тик закончился статусом Running, запоминается узел, с которого его
+ * нужно продолжить (выполняющийся лист, Parallel или Repeat между
+ * итерациями). Следующий тик начинается с этого узла и поднимается к
+ * корню только после его завершения, не спускаясь заново от корня.
+ * Разные агенты можно тикать из разных потоков одновременно.
+ */
+class BehaviorAgentGroup {
+public:
+    explicit BehaviorAgentGroup(std::shared_ptr<const CompiledBehaviorTree> tree);
+    ~BehaviorAgentGroup() = default;
+
+    // Управление агентами
+    uint32_t AddAgent();
+    void RemoveAgent(uint32_t agent);
+    void ResetAgent(uint32_t agent);
+    void Reserve(size_t count);
+    size_t GetAgentCount() const { return m_status.size(); }
+
+    // Данные агента
+    Blackboard GetBlackboard(uint32_t agent) { return Blackboard(BlackboardData(agent)); }
+    BehaviorStatus GetStatus(uint32_t agent) const { return m_status[agent]; }
+    uint32_t GetResumeNode(uint32_t agent) const { return m_resume[agent]; } // INVALID_INDEX - с корня
+    const std::shared_ptr<const CompiledBehaviorTree>& GetTree() const { return m_tree; }
+
+    // Выполнение
+    BehaviorStatus Tick(uint32_t agent, float deltaTime, void* userData = nullptr);
+    void TickRange(uint32_t first, uint32_t last, float deltaTime, void* userData = nullptr);
+    void TickAll(float deltaTime, void* userData = nullptr);
+
+private:
+    // Блок доски выровнен по max_align_t
+    struct alignas(alignof(std::max_align_t)) BlackboardChunk {
+        unsigned char bytes[alignof(std::max_align_t)];
+    };
+
+    std::shared_ptr<const CompiledBehaviorTree> m_tree;
+    const CompiledBehaviorNode* m_nodes;
+    uint32_t m_stateStride;
+    uint32_t m_timerStride;
+    uint32_t m_blackboardStride; // В блоках BlackboardChunk
+
+    std::vector<BehaviorStatus> m_status;
+    std::vector<uint32_t> m_resume;
+    std::vector<uint32_t> m_states;
+    std::vector<float> m_timers;
+    std::vector<BlackboardChunk> m_blackboards;
+
+    unsigned char* BlackboardData(uint32_t agent) {
+        return m_blackboards.empty() ? nullptr : m_blackboards[static_cast<size_t>(agent) * m_blackboardStride].bytes;
+    }
+
+    // Состояние агента на время одного тика
+    struct AgentCursor {
+        uint32_t* states;
+        float* timers;
+        uint32_t resume;
+    };
+
+    BehaviorStatus TickNode(uint32_t index, AgentCursor& cursor, BehaviorTickContext& context) const;
+    BehaviorStatus RunChildren(uint32_t index, uint32_t position, uint32_t child,
+                               AgentCursor& cursor, BehaviorTickContext& context) const;
+    BehaviorStatus FinishRepeatIteration(uint32_t index, BehaviorStatus childStatus, AgentCursor& cursor) const;
+    BehaviorStatus ContinueAfterChild(uint32_t parent, uint32_t child, BehaviorStatus childStatus,
+                                      AgentCursor& cursor, BehaviorTickContext& context) const;
+    void ResetSubtree(const CompiledBehaviorNode& node, AgentCursor& cursor) const;
+};
+
+} // namespace FastEngine
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "FastEngine/AI/NavMesh.h"
+#include "FastEngine/AI/Pathfinding.h"
+#include <vector>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
+
+namespace FastEngine {
+
+/**
+ * Иерархический поиск пути (HPA*)
+ *
+ * Узлы навигационной сетки разбиваются на кластеры - квадраты плоскости XZ
+ * со стороной clusterSize. На каждом участке общей границы соседних
+ * кластеров ставится пара порталов (на длинных участках - две пары по
+ * краям); порталы одного кластера связаны
+ * заранее посчитанными стоимостями. Запрос ищет путь по графу порталов и
+ * уточняет его локальным A* внутри кластеров, поэтому длина пути не
+ * ограничена числом итераций. Недавние абстрактные пути хранятся в LRU-кэше.
+ *
+ * Сетка - неизменяемый снимок, как в PathfindingManager. Новую версию
+ * (например, из EditNavMesh) передает UpdateNavMesh: при той же топологии
+ * он помечает кластеры с измененными узлами, и перед следующим запросом
+ * перестраиваются только порталы и ребра этих кластеров и их соседей;
+ * иначе граф строится заново.
+ *
+ * Экземпляр не потокобезопасен: для параллельных запросов нужен экземпляр на поток.
+ */
+class HierarchicalPathfinder {
+public:
+    HierarchicalPathfinder();
+    ~HierarchicalPathfinder() = default;
+
+    // Настройки (размер кластера применяется при Build)
+    void SetClusterSize(float size) { m_clusterSize = size; }
+    void SetCacheCapacity(size_t capacity);
+    void SetSmoothing(bool smooth) { m_smoothPath = smooth; }
+
+    // Построение абстрактного графа
+    bool Build(std::shared_ptr<const NavMesh> navMesh);
+    void Clear();
+    bool IsBuilt() const { return m_navMesh != nullptr; }
+    const std::shared_ptr<const NavMesh>& GetNavMesh() const { return m_navMesh; }
+
+    // Поиск пути
+    PathfindingResult FindPath(const glm::vec3& start, const glm::vec3& end);
+
+    // Новая версия сетки с инкрементальным обновлением графа
+    bool UpdateNavMesh(std::shared_ptr<const NavMesh> navMesh);
+    void RepairDirtyClusters();
+
+    // Статистика
+    int GetClusterCount() const { return m_clusterCountX * m_clusterCountZ; }
+    size_t GetPortalCount() const { return m_portals.size() - m_freePortals.size(); }
+    int GetCacheHits() const { return m_cacheHits; }
+    int GetCacheMisses() const { return m_cacheMisses; }
+    int GetLastAbstractNodesExplored() const { return m_lastAbstractNodesExplored; }
+
+private:
+    // Участок границы из стольких ребер и длиннее получает порталы по краям
+    static constexpr size_t LONG_ENTRANCE_EDGES = 6;
+
+    struct PortalEdge {
+        int target;  // Индекс портала
+        float cost;
+        bool intra;  // Внутри кластера (иначе - переход через границу)
+    };
+
+    struct Portal {
+        int navNode;
+        int cluster;
+        bool active;
+        std::vector<PortalEdge> edges;
+    };
+
+    // Абстрактный путь (последовательность узлов сетки: старт, порталы, цель)
+    struct CacheEntry {
+        uint64_t key;
+        std::vector<int> abstractPath;
+        std::vector<int> clusters;
+    };
+
+    std::shared_ptr<const NavMesh> m_navMesh;
+    float m_clusterSize;
+    bool m_smoothPath;
+
+    // Разбиение на кластеры
+    glm::vec2 m_origin;
+    int m_clusterCountX;
+    int m_clusterCountZ;
+    std::vector<int> m_nodeCluster;
+    std::vector<std::vector<int>> m_clusterNodes;
+    std::vector<std::vector<int>> m_clusterNeighbors;
+
+    // Граф порталов
+    std::vector<Portal> m_portals;
+    std::vector<int> m_freePortals;
+    std::vector<std::vector<int>> m_clusterPortals;
+    std::unordered_map<uint64_t, std::vector<int>> m_entrancePortals; // Пара кластеров -> порталы
+    AStarScratch m_abstractScratch;
+
+    // Инкрементальное обновление
+    std::unordered_set<int> m_dirtyClusters;
+    bool m_flushCache; // Путь мог стать короче - кэш сбрасывается целиком
+
+    // LRU-кэш абстрактных путей
+    std::list<CacheEntry> m_cache;
+    std::unordered_map<uint64_t, std::list<CacheEntry>::iterator> m_cacheIndex;
+    size_t m_cacheCapacity;
+    int m_cacheHits;
+    int m_cacheMisses;
+    int m_lastAbstractNodesExplored;
+
+    // Построение
+    static uint64_t PairKey(int a, int b);
+    int AllocatePortal(int navNode, int cluster);
+    void ReleaseEntrance(uint64_t pairKey);
+    void BuildEntrance(int clusterA, int clusterB);
+    void BuildIntraEdges(int cluster);
+
+    // Поиск
+    float SearchCluster(int cluster, int source, int target, bool reverse, AStarScratch& scratch) const;
+    bool SearchAbstract(int startNode, int goalNode, std::vector<int>& abstractPath);
+    bool Refine(const std::vector<int>& abstractPath, std::vector<int>& nodePath, float& cost) const;
+
+    // Кэш
+    const CacheEntry* FindCached(uint64_t key);
+    void StoreCached(uint64_t key, const std::vector<int>& abstractPath);
+    void InvalidateCache(const std::unordered_set<int>& clusters);
+};
+
+} // namespace FastEngine
@@ -2,9 +2,9 @@
 
 #include <vector>
 #include <memory>
+#include <string>
+#include <cstddef>
 #include <glm/glm.hpp>
-#include <unordered_map>
-#include <unordered_set>
 
 namespace FastEngine {
 
@@ -13,7 +13,6 @@ namespace FastEngine {
  */
 struct NavNode {
     glm::vec3 position;
-    std::vector<int> connections; // Индексы связанных узлов
     bool walkable;
     float cost; // Стоимость прохождения через узел
     
@@ -42,8 +41,85 @@ struct NavTriangle {
     }
 };
 
+/**
+ * Плоская карта высот: строки по stride элементов, данные не копируются.
+ * Позволяет передавать часть большего буфера без переупаковки.
+ */
+struct HeightmapView {
+    const float* data;
+    int width;
+    int height;
+    size_t stride; // Шаг строки в элементах
+    
+    HeightmapView() : data(nullptr), width(0), height(0), stride(0) {}
+    HeightmapView(const float* d, int w, int h, size_t s = 0)
+        : data(d), width(w), height(h), stride(s != 0 ? s : static_cast<size_t>(w)) {}
+    
+    float At(int x, int y) const { return data[static_cast<size_t>(y) * stride + x]; }
+    bool IsValid() const { return data != nullptr && width > 0 && height > 0 && stride >= static_cast<size_t>(width); }
+};
+
+/**
+ * Диапазон индексов в плоском (CSR) массиве навигационной сетки
+ */
+struct NavIndexRange {
+    const int* first;
+    const int* last;
+    
+    NavIndexRange() : first(nullptr), last(nullptr) {}
+    NavIndexRange(const int* f, const int* l) : first(f), last(l) {}
+    
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+    size_t size() const { return static_cast<size_t>(last - first); }
+    bool empty() const { return first == last; }
+};
+
+/**
+ * Равномерная сетка в плоскости XZ над треугольниками и узлами
+ * навигационной сетки. Ячейки хранят индексы в формате CSR.
+ */
+struct NavSpatialGrid {
+    glm::vec2 origin;
+    float cellSize;
+    float inverseCellSize;
+    int width;
+    int height;
+    std::vector<int> triangleOffsets; // Ячейка -> треугольники, чей AABB ее пересекает
+    std::vector<int> triangles;
+    std::vector<int> nodeOffsets;     // Ячейка -> узлы внутри ячейки
+    std::vector<int> nodes;
+    
+    NavSpatialGrid() : origin(0.0f), cellSize(1.0f), inverseCellSize(1.0f), width(0), height(0) {}
+    
+    bool IsEmpty() const { return width == 0 || height == 0; }
+    
+    // Координаты ячейки, прижатые к границам сетки; NaN дает 0, а не UB приведения
+    int CellX(float x) const {
+        float cell = (x - origin.x) * inverseCellSize;
+        return !(cell > 0.0f) ? 0 : (cell >= static_cast<float>(width - 1) ? width - 1 : static_cast<int>(cell));
+    }
+    int CellZ(float z) const {
+        float cell = (z - origin.y) * inverseCellSize;
+        return !(cell > 0.0f) ? 0 : (cell >= static_cast<float>(height - 1) ? height - 1 : static_cast<int>(cell));
+    }
+    
+    NavIndexRange GetTriangles(int cellX, int cellZ) const {
+        int cell = cellZ * width + cellX;
+        return NavIndexRange(triangles.data() + triangleOffsets[cell], triangles.data() + triangleOffsets[cell + 1]);
+    }
+    NavIndexRange GetNodes(int cellX, int cellZ) const {
+        int cell = cellZ * width + cellX;
+        return NavIndexRange(nodes.data() + nodeOffsets[cell], nodes.data() + nodeOffsets[cell + 1]);
+    }
+};
+
 /**
  * Навигационная сетка
+ * Проходимость и точечные запросы рассматриваются в плоскости XZ.
+ * Смежность узлов хранится в формате CSR: соседи узла i лежат в
+ * m_adjacency[m_adjacencyOffsets[i] .. m_adjacencyOffsets[i + 1]).
+ * Ребро проходимо, если проходимы оба его узла.
  */
 class NavMesh {
 public:
@@ -55,36 +131,92 @@ public:
                          const std::vector<unsigned int>& indices);
     bool GenerateFromHeightmap(const std::vector<std::vector<float>>& heightmap, 
                                float cellSize, float heightThreshold);
+    bool GenerateFromHeightmap(const HeightmapView& heightmap, float cellSize, float heightThreshold);
     
     // Поиск пути
     std::vector<glm::vec3> FindPath(const glm::vec3& start, const glm::vec3& end);
     bool IsWalkable(const glm::vec3& position) const;
     glm::vec3 GetNearestWalkablePoint(const glm::vec3& position) const;
+    int FindNearestNode(const glm::vec3& position) const; // -1, если проходимых узлов нет
+    int FindTriangle(const glm::vec3& position, bool walkableOnly = true) const; // -1, если точка вне сетки
+    
+    // Луч по поверхности сетки: true, если отрезок выходит за границу или
+    // пересекает непроходимую область; hitPoint - точка выхода
+    bool Raycast(const glm::vec3& from, const glm::vec3& to, glm::vec3* hitPoint = nullptr) const;
     
     // Получение информации о сетке
     const std::vector<NavNode>& GetNodes() const { return m_nodes; }
     const std::vector<NavTriangle>& GetTriangles() const { return m_triangles; }
+    size_t GetNodeCount() const { return m_nodes.size(); }
+    
+    // Смежность (CSR)
+    NavIndexRange GetNeighbors(int nodeIndex) const {
+        const int* base = m_adjacency.data();
+        return NavIndexRange(base + m_adjacencyOffsets[nodeIndex], base + m_adjacencyOffsets[nodeIndex + 1]);
+    }
+    NavIndexRange GetNodeTriangles(int nodeIndex) const {
+        const int* base = m_nodeTriangles.data();
+        return NavIndexRange(base + m_nodeTriangleOffsets[nodeIndex], base + m_nodeTriangleOffsets[nodeIndex + 1]);
+    }
+    const std::vector<int>& GetAdjacencyOffsets() const { return m_adjacencyOffsets; }
+    const std::vector<int>& GetAdjacency() const { return m_adjacency; }
+    
+    // Соседний треугольник через ребро edge (vertices[edge] -> vertices[(edge + 1) % 3]), -1 на границе
+    int GetTriangleNeighbor(int triangleIndex, int edge) const { return m_triangleNeighbors[triangleIndex * 3 + edge]; }
+    const NavSpatialGrid& GetSpatialGrid() const { return m_grid; }
     bool IsValid() const { return !m_nodes.empty() && !m_triangles.empty(); }
     
+    // Изменение узлов без перестройки смежности и индекса. Сетки
+    // PathfindingManager меняются через EditNavMesh - на копии
+    void SetNodeWalkable(int nodeIndex, bool walkable);
+    void SetNodeCost(int nodeIndex, float cost);
+    
     // Сериализация
     std::string Serialize() const;
     void Deserialize(const std::string& data);
     
 private:
+    // Генератор заполняет узлы и треугольники по тайлам напрямую
+    friend class NavMeshGenerator;
+    
     std::vector<NavNode> m_nodes;
     std::vector<NavTriangle> m_triangles;
-    std::unordered_map<int, std::vector<int>> m_nodeToTriangles; // Узел -> треугольники
+    
+    // Плоские списки смежности (размер смещений = количество узлов + 1)
+    std::vector<int> m_adjacencyOffsets;
+    std::vector<int> m_adjacency;
+    std::vector<int> m_nodeTriangleOffsets; // Узел -> треугольники
+    std::vector<int> m_nodeTriangles;
+    std::vector<int> m_triangleNeighbors;   // 3 на треугольник
+    
+    // Пространственный индекс для точечных запросов
+    NavSpatialGrid m_grid;
+    
+    // Порог высоты, с которым сетку построил тайловый конвейер NavMeshGenerator;
+    // RebuildRegion применяет его же. false - сетка построена не генератором
+    bool m_hasTileSource;
+    float m_tileThreshold;
     
     // Вспомогательные методы
     void TriangulateMesh(const std::vector<glm::vec3>& vertices, 
                         const std::vector<unsigned int>& indices);
     void BuildConnections();
+    void BuildTriangleNeighbors();
+    void BuildSpatialIndex();
+    void ClearMesh();
     bool IsPointInTriangle(const glm::vec3& point, const NavTriangle& triangle) const;
     glm::vec3 GetTriangleCenter(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2) const;
 };
 
 /**
  * Генератор навигационной сетки
+ * Карта высот (и растеризованные коллайдеры) обрабатывается квадратными
+ * тайлами по tileSize ячеек параллельно: фильтрация по порогу высоты,
+ * уклону и радиусу агента и триангуляция. Тайлы пишут узлы и треугольники
+ * в общие массивы по глобальным индексам сетки, поэтому граничные вершины
+ * соседних тайлов совпадают и сшивка не требует слияния. Для фильтров
+ * тайл читает полосу соседних отсчетов шириной в радиус агента.
+ * Смежность регулярной сетки заполняется по формулам, без сортировки ребер.
  */
 class NavMeshGenerator {
 public:
@@ -96,25 +228,54 @@ public:
     void SetHeightThreshold(float threshold) { m_heightThreshold = threshold; }
     void SetAgentRadius(float radius) { m_agentRadius = radius; }
     void SetMaxSlope(float slope) { m_maxSlope = slope; }
+    void SetTileSize(int cells) { m_tileSize = cells > 0 ? cells : 1; }
+    void SetWorkerCount(size_t count) { m_workerCount = count; } // 0 - JobSystem или по числу ядер
     
     // Генерация из различных источников
     std::unique_ptr<NavMesh> GenerateFromMesh(const std::vector<glm::vec3>& vertices,
                                               const std::vector<unsigned int>& indices);
     std::unique_ptr<NavMesh> GenerateFromHeightmap(const std::vector<std::vector<float>>& heightmap);
+    std::unique_ptr<NavMesh> GenerateFromHeightmap(const HeightmapView& heightmap);
+    // Коллайдеры - AABB (центр и полный размер); проходима верхняя грань
     std::unique_ptr<NavMesh> GenerateFromColliders(const std::vector<glm::vec3>& colliderPositions,
                                                    const std::vector<glm::vec3>& colliderSizes);
     
+    // Перестраивает тайлы, на которые влияет изменение отсчетов
+    // [minX, maxX] x [minY, maxY] карты высот, из которой построена сетка.
+    // Порог высоты берется из сетки, а не из текущих настроек: для сетки из
+    // коллайдеров heightmap - их растр. Топология сетки не меняется.
+    // Возвращает число тайлов, -1 при ошибке или сетке не от генератора
+    int RebuildRegion(NavMesh& navMesh, const HeightmapView& heightmap,
+                      int minX, int minY, int maxX, int maxY);
+    
+    int GetTileSize() const { return m_tileSize; }
+    size_t GetWorkerCount() const;
+    
 private:
+    // Вход тайлового конвейера
+    struct TileSource {
+        HeightmapView heights;
+        glm::vec2 origin;
+        float threshold;
+    };
+    
     float m_cellSize;
     float m_heightThreshold;
     float m_agentRadius;
     float m_maxSlope;
+    int m_tileSize;
+    size_t m_workerCount;
     
-    // Алгоритмы генерации
-    void DelaunayTriangulation(std::vector<glm::vec3>& points, 
-                              std::vector<NavTriangle>& triangles);
-    void FilterWalkableAreas(NavMesh& navMesh);
-    void SimplifyMesh(NavMesh& navMesh);
+    // Тайловый конвейер
+    int GetFilterRadius() const;
+    bool IsPassable(const TileSource& source, int x, int y) const;
+    void BuildTile(const TileSource& source, int tileX, int tileY, NavMesh& navMesh,
+                   std::vector<unsigned char>& scratch) const;
+    void BuildTiles(const TileSource& source, const std::vector<int>& tiles, NavMesh& navMesh) const;
+    void BuildGridTopology(NavMesh& navMesh, int width, int height) const;
+    std::unique_ptr<NavMesh> GenerateTiled(const TileSource& source);
+    template<typename Func>
+    void ParallelFor(size_t count, const Func& func) const;
 };
 
 } // namespace FastEngine
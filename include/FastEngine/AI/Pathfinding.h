@@ -1,12 +1,20 @@
 #pragma once
 
 #include "FastEngine/AI/NavMesh.h"
+#include "FastEngine/Jobs/JobSystem.h"
 #include <vector>
 #include <memory>
+#include <string>
+#include <cstdint>
 #include <queue>
+#include <deque>
 #include <unordered_map>
-#include <unordered_set>
 #include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
 
 namespace FastEngine {
 
@@ -41,6 +49,69 @@ struct PathfindingResult {
     PathfindingResult() : success(false), totalCost(0.0f), nodesExplored(0) {}
 };
 
+/**
+ * Эвристика по умолчанию (евклидово расстояние)
+ */
+struct EuclideanHeuristic {
+    float operator()(const glm::vec3& a, const glm::vec3& b) const {
+        return glm::distance(a, b);
+    }
+};
+
+/**
+ * Рабочие буферы A*, переиспользуемые между запросами одного потока.
+ * Состояние узла действительно, только если его метка совпадает с текущим
+ * поколением, поэтому между поисками массивы не очищаются.
+ */
+class AStarScratch {
+public:
+    AStarScratch() : m_generation(0) {}
+    
+    // Начало нового поиска по сетке из nodeCount узлов
+    void Begin(size_t nodeCount);
+    
+    // Состояние узлов
+    bool IsVisited(int node) const { return m_nodes[node].visitStamp == m_generation; }
+    bool IsClosed(int node) const { return m_nodes[node].closedStamp == m_generation; }
+    float GetG(int node) const { return m_nodes[node].gScore; }
+    int GetParent(int node) const { return m_nodes[node].parent; }
+    void Close(int node) { m_nodes[node].closedStamp = m_generation; }
+    void Relax(int node, float g, int parent) {
+        NodeState& state = m_nodes[node];
+        state.gScore = g;
+        state.parent = parent;
+        state.visitStamp = m_generation;
+    }
+    
+    // Открытый список: 4-арная min-куча по f
+    bool OpenEmpty() const { return m_open.empty(); }
+    void PushOpen(float f, int node);
+    int PopOpen();
+    
+    // Буфер для восстановления пути
+    std::vector<int>& GetPathBuffer() { return m_path; }
+    
+private:
+    struct NodeState {
+        float gScore;
+        int parent;
+        uint32_t visitStamp;
+        uint32_t closedStamp;
+    };
+    
+    struct OpenEntry {
+        float f;
+        int node;
+    };
+    
+    static constexpr size_t HEAP_ARITY = 4;
+    
+    std::vector<NodeState> m_nodes;
+    std::vector<OpenEntry> m_open;
+    std::vector<int> m_path;
+    uint32_t m_generation;
+};
+
 /**
  * Алгоритм поиска пути A*
  */
@@ -54,15 +125,28 @@ public:
     void SetMaxIterations(int maxIter) { m_maxIterations = maxIter; }
     void SetSmoothing(bool smooth) { m_smoothPath = smooth; }
     
-    // Поиск пути
+    // Поиск пути (эвристика из SetHeuristic или евклидова по умолчанию)
     PathfindingResult FindPath(const NavMesh& navMesh, 
                               const glm::vec3& start, 
                               const glm::vec3& end);
     
+    // Поиск пути с эвристикой, подставляемой на этапе компиляции
+    template <typename Heuristic>
+    PathfindingResult FindPath(const NavMesh& navMesh,
+                              const glm::vec3& start,
+                              const glm::vec3& end,
+                              const Heuristic& heuristic);
+    
+    // Натягивание пути по поверхности сетки (используется при SetSmoothing(true))
+    std::vector<glm::vec3> SmoothPath(const NavMesh& navMesh, const std::vector<glm::vec3>& path) const;
+    
     // Получение статистики
     int GetLastNodesExplored() const { return m_lastNodesExplored; }
     float GetLastPathCost() const { return m_lastPathCost; }
     
+    // Буферы поиска текущего потока
+    static AStarScratch& GetThreadScratch();
+    
 private:
     std::function<float(const glm::vec3&, const glm::vec3&)> m_heuristic;
     int m_maxIterations;
@@ -71,53 +155,257 @@ private:
     float m_lastPathCost;
     
     // Вспомогательные методы
-    float CalculateHeuristic(const glm::vec3& start, const glm::vec3& end) const;
-    std::vector<int> ReconstructPath(const std::unordered_map<int, int>& cameFrom, 
-                                    int start, int end) const;
-    std::vector<glm::vec3> SmoothPath(const std::vector<glm::vec3>& path) const;
-    bool IsValidMove(const NavMesh& navMesh, int from, int to) const;
+    bool ResolveEndpoints(const NavMesh& navMesh, const glm::vec3& start, const glm::vec3& end,
+                          int& startNode, int& endNode, PathfindingResult& result) const;
+    void FinishSearch(const NavMesh& navMesh, AStarScratch& scratch, int endNode, bool found,
+                      int iterations, int nodesExplored, PathfindingResult& result);
+    void ReconstructPath(const AStarScratch& scratch, int end, std::vector<int>& path) const;
 };
 
+template <typename Heuristic>
+PathfindingResult AStarPathfinding::FindPath(const NavMesh& navMesh,
+                                            const glm::vec3& start,
+                                            const glm::vec3& end,
+                                            const Heuristic& heuristic) {
+    PathfindingResult result;
+    int startNode = -1;
+    int endNode = -1;
+    
+    if (!ResolveEndpoints(navMesh, start, end, startNode, endNode, result)) {
+        return result;
+    }
+    
+    const std::vector<NavNode>& nodes = navMesh.GetNodes();
+    const glm::vec3 goal = nodes[endNode].position;
+    
+    AStarScratch& scratch = GetThreadScratch();
+    scratch.Begin(nodes.size());
+    scratch.Relax(startNode, 0.0f, -1);
+    scratch.PushOpen(heuristic(nodes[startNode].position, goal), startNode);
+    
+    int iterations = 0;
+    int nodesExplored = 0;
+    bool found = false;
+    
+    while (!scratch.OpenEmpty() && iterations < m_maxIterations) {
+        ++iterations;
+        
+        int current = scratch.PopOpen();
+        if (current == endNode) {
+            found = true;
+            break;
+        }
+        
+        // Устаревшая запись кучи (узел уже раскрыт с меньшей стоимостью)
+        if (scratch.IsClosed(current)) {
+            continue;
+        }
+        scratch.Close(current);
+        ++nodesExplored;
+        
+        const float currentG = scratch.GetG(current);
+        const glm::vec3& currentPos = nodes[current].position;
+        
+        for (int neighbor : navMesh.GetNeighbors(current)) {
+            if (scratch.IsClosed(neighbor) || !nodes[neighbor].walkable) {
+                continue;
+            }
+            
+            const NavNode& next = nodes[neighbor];
+            float tentativeGScore = currentG + glm::distance(currentPos, next.position) * next.cost;
+            
+            if (!scratch.IsVisited(neighbor) || tentativeGScore < scratch.GetG(neighbor)) {
+                scratch.Relax(neighbor, tentativeGScore, current);
+                scratch.PushOpen(tentativeGScore + heuristic(next.position, goal), neighbor);
+            }
+        }
+    }
+    
+    FinishSearch(navMesh, scratch, endNode, found, iterations, nodesExplored, result);
+    return result;
+}
+
+/**
+ * Идентификатор асинхронного запроса пути (0 - недействительный)
+ */
+using PathRequestId = uint64_t;
+
+/**
+ * Приоритет асинхронного запроса пути
+ */
+enum class PathRequestPriority {
+    Low = 0,
+    Normal = 1,
+    High = 2
+};
+
+/**
+ * Обратный вызов с результатом запроса (вызывается в потоке PathfindingManager::Update)
+ */
+using PathResultCallback = std::function<void(PathRequestId, const PathfindingResult&)>;
+
 /**
  * Менеджер поиска пути
+ *
+ * Синхронный FindPath выполняется в вызывающем потоке. RequestPath ставит
+ * запрос в очередь с приоритетом; Update каждый кадр отдает не больше
+ * m_maxDispatchPerFrame поисков заданиям JobSystem (или собственным
+ * потокам, если их число задано SetWorkerCount) и доставляет готовые
+ * результаты. Без потоков и без запущенного JobSystem поиски выполняются
+ * в Update в пределах бюджета времени. Запросы с одинаковыми клетками старта и цели на одной версии
+ * сетки объединяются в один поиск.
+ *
+ * Менеджер владеет сетками и хранит их как неизменяемые снимки: AddNavMesh
+ * забирает сетку, GetNavMesh отдает ее только для чтения. EditNavMesh
+ * копирует текущий снимок, применяет изменения к копии и публикует ее как
+ * новую версию; запрос удерживает версию, на которой был создан, поэтому
+ * рабочие потоки никогда не читают изменяемую сетку. Копирование стоит
+ * O(размер сетки), поэтому изменения одного кадра лучше собирать в один
+ * вызов EditNavMesh.
+ *
+ * Бюджет кадра ограничивает время Update: без рабочих потоков - поиски и
+ * доставку, с потоками или заданиями - доставку результатов (обратные вызовы); не
+ * уложившиеся результаты доставляются в следующих кадрах.
  */
 class PathfindingManager {
 public:
+    using HeuristicFunction = std::function<float(const glm::vec3&, const glm::vec3&)>;
+    
     PathfindingManager();
-    ~PathfindingManager() = default;
+    ~PathfindingManager();
     
     // Инициализация
     bool Initialize();
     void Shutdown();
     
     // Управление навигационными сетками
-    void AddNavMesh(const std::string& name, std::shared_ptr<NavMesh> navMesh);
+    void AddNavMesh(const std::string& name, std::unique_ptr<NavMesh> navMesh);
     void RemoveNavMesh(const std::string& name);
-    std::shared_ptr<NavMesh> GetNavMesh(const std::string& name) const;
+    std::shared_ptr<const NavMesh> GetNavMesh(const std::string& name) const;
+    // Новая версия сетки: edit получает копию текущей. false - сетки нет
+    bool EditNavMesh(const std::string& name, const std::function<void(NavMesh&)>& edit);
     
     // Поиск пути
     PathfindingResult FindPath(const std::string& navMeshName,
                               const glm::vec3& start,
                               const glm::vec3& end);
     
+    // Асинхронные запросы
+    PathRequestId RequestPath(const std::string& navMeshName,
+                              const glm::vec3& start,
+                              const glm::vec3& end,
+                              PathResultCallback callback,
+                              PathRequestPriority priority = PathRequestPriority::Normal);
+    bool CancelRequest(PathRequestId requestId);
+    bool IsRequestPending(PathRequestId requestId) const;
+    size_t GetPendingRequestCount() const { return m_requests.size(); }
+    
     // Настройки
     void SetDefaultHeuristic(std::function<float(const glm::vec3&, const glm::vec3&)> heuristic);
     void SetMaxIterations(int maxIter) { m_maxIterations = maxIter; }
+    // До Initialize: собственные потоки; 0 - JobSystem, если запущен, иначе поиск в Update
+    void SetWorkerCount(int count) { m_workerCount = count; }
+    void SetMaxDispatchPerFrame(int count) { m_maxDispatchPerFrame = count; }
+    void SetFrameBudget(float milliseconds) { m_frameBudgetMs = milliseconds; } // Хотя бы один результат за кадр
+    void SetDeduplicationCellSize(float size) { m_dedupCellSize = size; }
+    int GetWorkerCount() const { return static_cast<int>(m_workers.size()); }
     
-    // Обновление
-    void Update(float deltaTime);
+    // Обновление: раздача запросов и доставка результатов в пределах бюджета кадра
+    void Update();
     
     // Статистика
     int GetTotalPathsFound() const { return m_totalPathsFound; }
     float GetAveragePathCost() const { return m_averagePathCost; }
+    int GetTotalRequests() const { return m_totalRequests; }
+    int GetDeduplicatedRequests() const { return m_deduplicatedRequests; }
     
 private:
-    std::unordered_map<std::string, std::shared_ptr<NavMesh>> m_navMeshes;
+    // Клетки старта и цели на конкретной сетке
+    struct PathQueryKey {
+        const NavMesh* navMesh;
+        int cells[6];
+        
+        bool operator==(const PathQueryKey& other) const;
+    };
+    
+    struct PathQueryKeyHash {
+        size_t operator()(const PathQueryKey& key) const;
+    };
+    
+    struct PathSubscriber {
+        PathRequestId id;
+        PathResultCallback callback;
+    };
+    
+    // Один уникальный поиск, на который могут быть подписаны несколько запросов
+    struct PathQuery {
+        std::shared_ptr<const NavMesh> navMesh;
+        std::shared_ptr<const HeuristicFunction> heuristic;
+        glm::vec3 start;
+        glm::vec3 end;
+        int maxIterations;
+        PathQueryKey key;
+        PathRequestPriority priority;
+        bool dispatched;
+        std::vector<PathSubscriber> subscribers;
+        PathfindingResult result; // Пишется только выполняющим поиск потоком
+    };
+    
+    struct PendingEntry {
+        PathRequestPriority priority;
+        uint64_t sequence;
+        std::shared_ptr<PathQuery> query;
+        
+        bool operator<(const PendingEntry& other) const {
+            // Сначала более высокий приоритет, затем более ранний запрос
+            if (priority != other.priority) return priority < other.priority;
+            return sequence > other.sequence;
+        }
+    };
+    
+    std::unordered_map<std::string, std::shared_ptr<const NavMesh>> m_navMeshes;
     std::unique_ptr<AStarPathfinding> m_pathfinder;
+    std::shared_ptr<const HeuristicFunction> m_heuristic;
     int m_maxIterations;
     int m_totalPathsFound;
     float m_averagePathCost;
     
+    // Очередь запросов (доступ только из потока Update)
+    std::priority_queue<PendingEntry> m_pending;
+    std::unordered_map<PathQueryKey, std::shared_ptr<PathQuery>, PathQueryKeyHash> m_activeQueries;
+    std::unordered_map<PathRequestId, std::shared_ptr<PathQuery>> m_requests;
+    PathRequestId m_nextRequestId;
+    uint64_t m_nextSequence;
+    int m_maxDispatchPerFrame;
+    float m_frameBudgetMs;
+    float m_dedupCellSize;
+    int m_totalRequests;
+    int m_deduplicatedRequests;
+    
+    // Задания JobSystem или собственные рабочие потоки
+    JobCounter m_searchJobs;
+    int m_workerCount;
+    std::vector<std::thread> m_workers;
+    std::deque<std::shared_ptr<PathQuery>> m_workQueue;
+    std::mutex m_workMutex;
+    std::condition_variable m_workCondition;
+    std::vector<std::shared_ptr<PathQuery>> m_completed;
+    std::mutex m_completedMutex;
+    std::atomic<bool> m_stopWorkers;
+    std::deque<std::shared_ptr<PathQuery>> m_ready; // Готовые, не доставленные из-за бюджета (поток Update)
+    
+    // Вспомогательные методы
+    PathQueryKey MakeQueryKey(const NavMesh* navMesh, const glm::vec3& start, const glm::vec3& end) const;
+    void StartWorkers();
+    void StopWorkers();
+    void WorkerThreadFunction();
+    static void RunQuery(PathQuery& query);
+    void CompleteQuery(std::shared_ptr<PathQuery> query);
+    void DispatchPending(std::chrono::steady_clock::time_point frameStart);
+    void DeliverCompleted(std::chrono::steady_clock::time_point frameStart);
+    bool IsBudgetExhausted(std::chrono::steady_clock::time_point frameStart) const;
+    void DeliverQuery(PathQuery& query);
+    
     // Обновление статистики
     void UpdateStatistics(const PathfindingResult& result);
 };
@@ -128,10 +416,17 @@ private:
 class PathfindingComponent {
 public:
     PathfindingComponent();
-    ~PathfindingComponent() = default;
+    ~PathfindingComponent();
+    
+    // Обратный вызов запроса ссылается на компонент, поэтому копирование запрещено
+    PathfindingComponent(const PathfindingComponent&) = delete;
+    PathfindingComponent& operator=(const PathfindingComponent&) = delete;
     
     // Настройки
+    void SetPathfindingManager(PathfindingManager* manager) { m_manager = manager; }
     void SetNavMeshName(const std::string& name) { m_navMeshName = name; }
+    void SetPosition(const glm::vec3& position) { m_position = position; }
+    void SetPriority(PathRequestPriority priority) { m_priority = priority; }
     void SetTargetPosition(const glm::vec3& target) { m_target = target; }
     void SetSpeed(float speed) { m_speed = speed; }
     void SetArrivalDistance(float distance) { m_arrivalDistance = distance; }
@@ -139,6 +434,8 @@ public:
     // Состояние
     bool HasPath() const { return !m_path.empty(); }
     bool IsMoving() const { return m_isMoving; }
+    bool IsPathPending() const { return m_pendingRequest != 0; }
+    PathRequestId GetPendingRequest() const { return m_pendingRequest; }
     glm::vec3 GetNextWaypoint() const;
     
     // Управление
@@ -149,10 +446,15 @@ public:
     // Получение данных
     const std::vector<glm::vec3>& GetPath() const { return m_path; }
     const glm::vec3& GetTarget() const { return m_target; }
+    const glm::vec3& GetPosition() const { return m_position; }
     float GetSpeed() const { return m_speed; }
     
 private:
+    PathfindingManager* m_manager;
+    PathRequestId m_pendingRequest;
+    PathRequestPriority m_priority;
     std::string m_navMeshName;
+    glm::vec3 m_position;
     glm::vec3 m_target;
     std::vector<glm::vec3> m_path;
     int m_currentWaypoint;
@@ -160,6 +462,8 @@ private:
     float m_arrivalDistance;
     bool m_isMoving;
     
+    void OnPathResult(PathRequestId requestId, const PathfindingResult& result);
+    
     // Callbacks
     std::function<void()> m_onPathComplete;
     std::function<void()> m_onPathFailed;
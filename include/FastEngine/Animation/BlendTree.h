@@ -0,0 +1,90 @@
+#pragma once
+
+#include "FastEngine/Animation/SkeletalClip.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace FastEngine {
+    /**
+     * Рабочие буферы вычисления дерева; свои у каждого потока
+     */
+    struct BlendTreeContext {
+        SkeletalSampleContext sample;
+        std::vector<Pose> stack; // Промежуточные позы по глубине дерева
+    };
+
+    /**
+     * Дерево смешивания поз
+     *
+     * Узлы: клип, смешивание двух узлов по параметру и одномерное
+     * пространство смешивания (узлы на порогах параметра). Дочерний узел
+     * добавляется раньше родителя, поэтому циклов нет. Ветви с нулевым
+     * весом не вычисляются. Дерево неизменяемо после построения и
+     * разделяется экземплярами; время и значения параметров хранит
+     * SkeletalAnimator.
+     */
+    class BlendTree {
+    public:
+        static constexpr uint32_t INVALID_NODE = 0xFFFFFFFFu;
+
+        // Параметры
+        uint32_t AddParameter(const std::string& name, float defaultValue = 0.0f);
+        int FindParameter(const std::string& name) const;
+        uint32_t GetParameterCount() const { return static_cast<uint32_t>(m_parameterNames.size()); }
+        float GetParameterDefault(uint32_t parameter) const { return m_parameterDefaults[parameter]; }
+
+        // Узлы; INVALID_NODE при ошибке. Все клипы - на одно число костей
+        uint32_t AddClip(std::shared_ptr<const SkeletalClip> clip, float speed = 1.0f, bool looping = true);
+        // Вес to - значение параметра, зажатое в [0, 1]
+        uint32_t AddBlend(uint32_t from, uint32_t to, uint32_t parameter);
+        // Точки (порог, узел) по возрастанию порога
+        uint32_t AddBlend1D(uint32_t parameter, const std::vector<std::pair<float, uint32_t>>& points);
+
+        // По умолчанию корень - последний добавленный узел
+        void SetRoot(uint32_t node);
+        uint32_t GetRoot() const { return m_root; }
+        uint32_t GetNodeCount() const { return static_cast<uint32_t>(m_nodes.size()); }
+        uint32_t GetBoneCount() const { return m_boneCount; }
+
+        // Поза в момент time (секунды) при значениях parameters
+        void Evaluate(float time, const float* parameters, BlendTreeContext& context, Pose& out) const;
+
+        // Дерево из одного зацикленного клипа
+        static std::shared_ptr<BlendTree> FromClip(std::shared_ptr<const SkeletalClip> clip);
+
+    private:
+        enum class NodeType {
+            Clip,
+            Blend,
+            Blend1D
+        };
+
+        struct Node {
+            NodeType type;
+            std::shared_ptr<const SkeletalClip> clip;
+            float speed;
+            bool looping;
+            uint32_t from;
+            uint32_t to;
+            uint32_t parameter;
+            uint32_t firstPoint;
+            uint32_t pointCount;
+        };
+
+        std::vector<Node> m_nodes;
+        std::vector<std::pair<float, uint32_t>> m_points;
+        std::vector<std::string> m_parameterNames;
+        std::vector<float> m_parameterDefaults;
+        uint32_t m_root = INVALID_NODE;
+        uint32_t m_boneCount = 0;
+
+        uint32_t AddNode(const Node& node);
+        void EvaluateNode(uint32_t node, float time, const float* parameters, BlendTreeContext& context,
+                          uint32_t depth, Pose& out) const;
+        void EvaluateBlend(uint32_t from, uint32_t to, float weight, float time, const float* parameters,
+                           BlendTreeContext& context, uint32_t depth, Pose& out) const;
+    };
+}
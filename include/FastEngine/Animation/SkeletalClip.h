@@ -0,0 +1,97 @@
+#pragma once
+
+#include "FastEngine/Animation/Skeleton.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace FastEngine {
+    /**
+     * Исходный клип: кадры с постоянным шагом, преобразование каждой
+     * кости в каждом кадре (кадр за кадром)
+     */
+    struct RawSkeletalClip {
+        std::string name;
+        float sampleRate;       // Кадров в секунду
+        uint32_t boneCount;
+        std::vector<BoneTransform> frames;
+
+        RawSkeletalClip() : sampleRate(30.0f), boneCount(0) {}
+        uint32_t GetFrameCount() const { return boneCount ? static_cast<uint32_t>(frames.size() / boneCount) : 0; }
+    };
+
+    struct SkeletalCompressionSettings {
+        float translationTolerance; // Единицы сцены
+        float rotationTolerance;    // Радианы
+        float scaleTolerance;
+
+        SkeletalCompressionSettings()
+            : translationTolerance(0.001f), rotationTolerance(0.001f), scaleTolerance(0.001f) {}
+    };
+
+    /**
+     * Рабочие буферы выборки клипа; свои у каждого потока
+     */
+    struct SkeletalSampleContext {
+        Pose keyA;
+        Pose keyB;
+        std::vector<float> weights; // Перенос, поворот, масштаб - по GetStride() на каждый
+    };
+
+    /**
+     * Сжатый клип скелетной анимации
+     *
+     * Дорожка - перенос, поворот или масштаб одной кости. Ключи, которые
+     * линейная интерполяция соседних восстанавливает в пределах допуска,
+     * отбрасываются; постоянная дорожка хранит один ключ. Повороты
+     * квантуются схемой "три наименьших" в 48 бит, перенос и масштаб -
+     * по 16 бит на компоненту в диапазоне дорожки. Клип неизменяемый и
+     * разделяется между экземплярами через shared_ptr.
+     */
+    class SkeletalClip {
+    public:
+        // nullptr при ошибке
+        static std::shared_ptr<const SkeletalClip> Compress(const RawSkeletalClip& raw,
+                                                            const SkeletalCompressionSettings& settings = SkeletalCompressionSettings());
+
+        const std::string& GetName() const { return m_name; }
+        float GetDuration() const { return m_duration; }
+        float GetSampleRate() const { return m_sampleRate; }
+        uint32_t GetBoneCount() const { return m_boneCount; }
+        uint32_t GetFrameCount() const { return m_frameCount; }
+        size_t GetKeyCount() const { return m_keyFrames.size(); }
+        size_t GetCompressedSize() const;
+        size_t GetRawSize() const { return static_cast<size_t>(m_frameCount) * m_boneCount * sizeof(BoneTransform); }
+
+        // Поза в момент time, секунды; время зажимается в [0, GetDuration()]
+        void Sample(float time, SkeletalSampleContext& context, Pose& out) const;
+
+    private:
+        enum TrackKind {
+            TRACK_TRANSLATION,
+            TRACK_ROTATION,
+            TRACK_SCALE,
+            TRACK_KIND_COUNT
+        };
+
+        struct Track {
+            uint32_t firstKey;
+            uint32_t keyCount;
+            float rangeMin[3];    // Перенос и масштаб: начало диапазона
+            float rangeExtent[3]; // и его ширина
+        };
+
+        SkeletalClip() : m_duration(0.0f), m_sampleRate(30.0f), m_boneCount(0), m_frameCount(0) {}
+
+        std::string m_name;
+        float m_duration;
+        float m_sampleRate;
+        uint32_t m_boneCount;
+        uint32_t m_frameCount;
+        std::vector<Track> m_tracks;         // bone * TRACK_KIND_COUNT + kind
+        std::vector<uint16_t> m_keyFrames;   // Номер кадра ключа
+        std::vector<uint16_t> m_keyValues;   // Три слова на ключ
+    };
+}
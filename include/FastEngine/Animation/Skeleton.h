@@ -0,0 +1,139 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace FastEngine {
+    /**
+     * Локальное преобразование кости: перенос, поворот (кватернион
+     * x, y, z, w) и масштаб
+     */
+    struct BoneTransform {
+        glm::vec3 translation;
+        glm::vec4 rotation;
+        glm::vec3 scale;
+
+        BoneTransform() : translation(0.0f), rotation(0.0f, 0.0f, 0.0f, 1.0f), scale(1.0f) {}
+        BoneTransform(const glm::vec3& t, const glm::vec4& r, const glm::vec3& s = glm::vec3(1.0f))
+            : translation(t), rotation(r), scale(s) {}
+    };
+
+    /**
+     * Матрица 4x4 по столбцам - та же раскладка, что у glm::mat4 и
+     * uniform-массивов OpenGL
+     */
+    struct alignas(16) BoneMatrix {
+        float m[16];
+
+        static BoneMatrix Identity();
+        static BoneMatrix FromTransform(const BoneTransform& transform);
+        glm::vec3 TransformPoint(const glm::vec3& point) const;
+    };
+
+    // result = a * b; result может совпадать с a или b
+    void MultiplyBoneMatrices(const BoneMatrix& a, const BoneMatrix& b, BoneMatrix& result);
+
+    /**
+     * Скелет: иерархия костей в порядке "родитель раньше потомка"
+     *
+     * Порядок позволяет считать модельные матрицы одним проходом.
+     * Обратные bind-матрицы считаются при добавлении костей.
+     */
+    class Skeleton {
+    public:
+        static constexpr int NO_PARENT = -1;
+        static constexpr uint32_t MAX_BONES = 1024;
+
+        // Родитель должен быть уже добавлен; -1 при ошибке
+        int AddBone(const std::string& name, int parent, const BoneTransform& bindLocal);
+
+        uint32_t GetBoneCount() const { return static_cast<uint32_t>(m_parents.size()); }
+        int GetParent(uint32_t bone) const { return m_parents[bone]; }
+        const std::vector<int16_t>& GetParents() const { return m_parents; }
+        const std::string& GetBoneName(uint32_t bone) const { return m_names[bone]; }
+        int FindBone(const std::string& name) const;
+
+        const BoneTransform& GetBindLocal(uint32_t bone) const { return m_bindLocal[bone]; }
+        const std::vector<BoneMatrix>& GetInverseBindMatrices() const { return m_inverseBind; }
+
+    private:
+        std::vector<std::string> m_names;
+        std::vector<int16_t> m_parents;
+        std::vector<BoneTransform> m_bindLocal;
+        std::vector<BoneMatrix> m_bindModel;
+        std::vector<BoneMatrix> m_inverseBind;
+    };
+
+    enum PoseChannel {
+        POSE_TRANSLATION_X, POSE_TRANSLATION_Y, POSE_TRANSLATION_Z,
+        POSE_ROTATION_X, POSE_ROTATION_Y, POSE_ROTATION_Z, POSE_ROTATION_W,
+        POSE_SCALE_X, POSE_SCALE_Y, POSE_SCALE_Z,
+        POSE_CHANNEL_COUNT
+    };
+
+    /**
+     * Поза скелета в раскладке SoA
+     *
+     * Каждая компонента (перенос x, ..., масштаб z) всех костей лежит
+     * отдельным массивом, длина которого кратна 4 - проходы смешивания
+     * обрабатывают по четыре кости за инструкцию. Хвост заполнен
+     * единичным преобразованием.
+     */
+    class Pose {
+    public:
+        static constexpr uint32_t LANES = 4;
+
+        explicit Pose(uint32_t boneCount = 0);
+
+        void Resize(uint32_t boneCount);
+        void SetBind(const Skeleton& skeleton);
+
+        uint32_t GetBoneCount() const { return m_boneCount; }
+        uint32_t GetStride() const { return m_stride; }
+        float* Channel(PoseChannel channel) { return m_data.data() + static_cast<size_t>(channel) * m_stride; }
+        const float* Channel(PoseChannel channel) const { return m_data.data() + static_cast<size_t>(channel) * m_stride; }
+
+        BoneTransform GetBone(uint32_t bone) const;
+        void SetBone(uint32_t bone, const BoneTransform& transform);
+
+    private:
+        uint32_t m_boneCount;
+        uint32_t m_stride;
+        std::vector<float> m_data;
+    };
+
+    // out = a + (b - a) * weight; поворот - нормализованный lerp по
+    // кратчайшей дуге. out может совпадать с a или b
+    void BlendPoses(const Pose& a, const Pose& b, float weight, Pose& out);
+    // То же с весами на кость (маска слоя, интерполяция ключей); массивы
+    // длиной не меньше GetStride()
+    void BlendPoses(const Pose& a, const Pose& b, const float* translationWeights,
+                    const float* rotationWeights, const float* scaleWeights, Pose& out);
+
+    // Локальные преобразования позы -> модельные матрицы костей
+    void LocalToModel(const Skeleton& skeleton, const Pose& pose, BoneMatrix* model);
+    // skinning[i] = model[i] * inverseBind[i]
+    void ComputeSkinningMatrices(const Skeleton& skeleton, const BoneMatrix* model, BoneMatrix* skinning);
+
+    /**
+     * Меш для CPU-скиннинга: до четырех костей на вершину
+     */
+    struct SkinnedMeshData {
+        static constexpr uint32_t MAX_INFLUENCES = 4;
+
+        std::vector<glm::vec3> positions;
+        std::vector<glm::vec3> normals;                // Пусто - без нормалей
+        std::vector<uint16_t> boneIndices;             // MAX_INFLUENCES на вершину
+        std::vector<float> boneWeights;                // Сумма весов вершины - 1
+
+        uint32_t GetVertexCount() const { return static_cast<uint32_t>(positions.size()); }
+    };
+
+    // Скиннинг на CPU (запасной путь без скиннинга в шейдере). Нормали
+    // преобразуются той же матрицей - масштаб костей предполагается
+    // равномерным
+    void SkinVertices(const SkinnedMeshData& mesh, const BoneMatrix* skinning,
+                      std::vector<glm::vec3>& positions, std::vector<glm::vec3>& normals);
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace FastEngine {
+    /**
+     * Декодированный звук: float PCM, кадры каналов подряд (interleaved)
+     */
+    struct AudioClip {
+        std::vector<float> samples;
+        uint32_t channels;   // 1 или 2
+        uint32_t sampleRate;
+        uint32_t frameCount;
+
+        AudioClip() : channels(1), sampleRate(48000), frameCount(0) {}
+
+        static std::shared_ptr<AudioClip> Create(std::vector<float> samples, uint32_t channels, uint32_t sampleRate) {
+            auto clip = std::make_shared<AudioClip>();
+            clip->channels = channels == 2 ? 2 : 1;
+            clip->sampleRate = sampleRate;
+            clip->frameCount = static_cast<uint32_t>(samples.size() / clip->channels);
+            clip->samples = std::move(samples);
+            return clip;
+        }
+
+        float GetDuration() const { return sampleRate > 0 ? static_cast<float>(frameCount) / sampleRate : 0.0f; }
+        size_t GetMemorySize() const { return samples.size() * sizeof(float); }
+    };
+
+    using AudioClipPtr = std::shared_ptr<const AudioClip>;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "FastEngine/Audio/AudioClip.h"
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace FastEngine {
+    /**
+     * Кэш декодированных коротких звуков
+     *
+     * Файл декодируется один раз и разделяется всеми владельцами клипа
+     * (звуки, голоса микшера). Кэш держит слабые ссылки: память
+     * освобождается вместе с последним владельцем, счетчик ссылок -
+     * счетчик shared_ptr.
+     */
+    class AudioClipCache {
+    public:
+        static AudioClipCache& GetInstance();
+
+        // Клип из кэша или декодированный файл; nullptr при ошибке
+        AudioClipPtr Load(const std::string& filePath);
+        AudioClipPtr Find(const std::string& filePath) const;
+
+        // Владельцев клипа вне кэша (0 - не загружен)
+        long GetReferenceCount(const std::string& filePath) const;
+
+        size_t GetClipCount() const;
+        size_t GetMemoryUsage() const;  // Байт декодированных данных живых клипов
+        uint64_t GetDecodeCount() const;
+        uint64_t GetHitCount() const;
+
+        // Убирает записи освобожденных клипов
+        void Purge();
+
+    private:
+        AudioClipCache() : m_decodeCount(0), m_hitCount(0) {}
+
+        AudioClipCache(const AudioClipCache&) = delete;
+        AudioClipCache& operator=(const AudioClipCache&) = delete;
+
+        std::unordered_map<std::string, std::weak_ptr<const AudioClip>> m_clips;
+        mutable std::mutex m_mutex;
+        uint64_t m_decodeCount;
+        uint64_t m_hitCount;
+    };
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "FastEngine/Audio/AudioClip.h"
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace FastEngine {
+    /**
+     * Формат данных WAV
+     */
+    enum class AudioEncoding {
+        Pcm,      // Целые 8/16/24/32 бит
+        Float,    // IEEE float 32 бит
+        ImaAdpcm  // IMA ADPCM 4 бит, сжатие 4:1
+    };
+
+    /**
+     * Последовательный декодер звукового файла
+     *
+     * Читает файл по частям: в памяти только заголовок и один блок,
+     * поэтому подходит и для потокового воспроизведения длинной музыки.
+     */
+    class AudioDecoder {
+    public:
+        virtual ~AudioDecoder() = default;
+
+        // Открывает файл по содержимому; nullptr, если формат не поддерживается
+        static std::unique_ptr<AudioDecoder> Open(const std::string& filePath);
+
+        virtual uint32_t GetChannels() const = 0;
+        virtual uint32_t GetSampleRate() const = 0;
+        virtual uint32_t GetFrameCount() const = 0;
+        virtual AudioEncoding GetEncoding() const = 0;
+
+        // Декодирует до frames кадров interleaved float; 0 - конец файла или ошибка
+        virtual uint32_t Read(float* output, uint32_t frames) = 0;
+        virtual bool Seek(uint32_t frame) = 0;
+
+        float GetDuration() const { return GetSampleRate() > 0 ? static_cast<float>(GetFrameCount()) / GetSampleRate() : 0.0f; }
+    };
+
+    /**
+     * Декодер RIFF/WAVE: PCM, float и IMA ADPCM (блоки Microsoft)
+     */
+    class WavDecoder : public AudioDecoder {
+    public:
+        WavDecoder();
+
+        bool Open(const std::string& filePath);
+
+        uint32_t GetChannels() const override { return m_channels; }
+        uint32_t GetSampleRate() const override { return m_sampleRate; }
+        uint32_t GetFrameCount() const override { return m_frameCount; }
+        AudioEncoding GetEncoding() const override { return m_encoding; }
+
+        uint32_t Read(float* output, uint32_t frames) override;
+        bool Seek(uint32_t frame) override;
+
+    private:
+        std::ifstream m_file;
+        AudioEncoding m_encoding;
+        uint32_t m_channels;
+        uint32_t m_sampleRate;
+        uint32_t m_bitsPerSample;
+        uint32_t m_blockAlign;       // Байт на кадр (PCM) или на блок (ADPCM)
+        uint32_t m_framesPerBlock;
+        uint32_t m_frameCount;
+        std::streamoff m_dataOffset;
+        uint32_t m_dataSize;
+        uint32_t m_position;         // Следующий кадр для Read
+
+        std::vector<uint8_t> m_raw;
+        std::vector<float> m_block;  // Декодированный блок ADPCM
+        uint32_t m_blockIndex;       // Какой блок лежит в m_block
+        uint32_t m_blockFrames;
+
+        uint32_t ReadPcm(float* output, uint32_t frames);
+        uint32_t ReadAdpcm(float* output, uint32_t frames);
+        bool DecodeAdpcmBlock(uint32_t block);
+    };
+
+    /**
+     * Кодирование в WAV (импорт ассетов, экспорт проекта, тесты)
+     */
+    namespace AudioEncoder {
+        bool WriteWav(const std::string& filePath, const AudioClip& clip, AudioEncoding encoding = AudioEncoding::Pcm);
+        // framesPerBlock для ADPCM: 1 + кратное 8
+        bool WriteImaAdpcm(const std::string& filePath, const AudioClip& clip, uint32_t framesPerBlock = 1017);
+    }
+
+    // Декодирует файл целиком
+    AudioClipPtr DecodeAudioFile(const std::string& filePath);
+}
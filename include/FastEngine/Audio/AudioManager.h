@@ -6,6 +6,10 @@
 
 namespace FastEngine {
     class Sound;
+    class AudioMixer;
+    class AudioSink;
+    class AudioStreamer;
+    struct AudioMixerConfig;
     
     class AudioManager {
     public:
@@ -16,6 +20,15 @@ namespace FastEngine {
         bool Initialize();
         void Shutdown();
         
+        // Раз в кадр: освобождает клипы завершенных голосов
+        void Update();
+        
+        // Микшер и приемник вывода (по умолчанию - NullAudioSink)
+        AudioMixer* GetMixer() const { return m_mixer.get(); }
+        AudioStreamer* GetStreamer() const { return m_streamer.get(); }
+        bool SetOutputSink(std::unique_ptr<AudioSink> sink);
+        void SetMixerConfig(const AudioMixerConfig& config);
+        
         // Управление звуками
         Sound* LoadSound(const std::string& filePath);
         void UnloadSound(const std::string& filePath);
@@ -33,6 +46,9 @@ namespace FastEngine {
         
     private:
         std::unordered_map<std::string, std::unique_ptr<Sound>> m_sounds;
+        std::unique_ptr<AudioMixer> m_mixer;
+        std::unique_ptr<AudioStreamer> m_streamer;
+        std::unique_ptr<AudioMixerConfig> m_mixerConfig;
         float m_masterVolume;
         bool m_muted;
         bool m_initialized;
@@ -0,0 +1,212 @@
+#pragma once
+
+#include "FastEngine/Audio/AudioClip.h"
+#include "FastEngine/Audio/AudioSink.h"
+#include "FastEngine/Audio/AudioStream.h"
+#include "FastEngine/Platform/SpscRing.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace FastEngine {
+    /**
+     * Параметры микшера
+     */
+    struct AudioMixerConfig {
+        uint32_t sampleRate;       // Частота выхода
+        uint32_t blockFrames;      // Кадров в блоке смешивания
+        uint32_t maxVoices;        // Размер пула голосов
+        uint32_t commandQueueSize; // Емкость очереди команд
+
+        AudioMixerConfig() : sampleRate(48000), blockFrames(256), maxVoices(64), commandQueueSize(1024) {}
+    };
+
+    /**
+     * Параметры запуска голоса
+     */
+    struct VoiceParams {
+        float volume;   // 0..1
+        float pan;      // -1 (лево) .. 1 (право)
+        float pitch;    // 0.1..4, через пересэмплирование
+        int priority;   // Больше - важнее при нехватке голосов
+        bool looping;
+        uint32_t startFrame; // Кадр клипа, с которого начать (для петли - по модулю длины)
+
+        VoiceParams() : volume(1.0f), pan(0.0f), pitch(1.0f), priority(0), looping(false), startFrame(0) {}
+    };
+
+    using VoiceHandle = uint32_t;
+    constexpr VoiceHandle INVALID_VOICE = 0;
+
+    /**
+     * Программный микшер
+     *
+     * Игровой поток отправляет команды через очередь без блокировок,
+     * поток микшера применяет их в начале блока и смешивает активные
+     * голоса в стерео float: пересэмплирование с линейной интерполяцией,
+     * затем накопление с рампой громкости и панорамы на SIMD (SSE2/NEON,
+     * иначе скалярно). При нехватке голосов вытесняется наименее важный;
+     * если все важнее нового звука, новый отклоняется.
+     *
+     * Методы управления вызываются из одного игрового потока. Клип или
+     * поток удерживается игровым потоком, пока голос не завершится,
+     * поэтому поток микшера не трогает счетчики ссылок и не освобождает
+     * память. Потоковый голос читает кадры последовательно через окно
+     * с хвостом прошлого блока; его шаг ограничен MAX_STREAM_STEP.
+     * Render можно вызывать напрямую, если поток не запущен (офлайн,
+     * тесты, бенчмарки).
+     */
+    class AudioMixer {
+    public:
+        static constexpr uint32_t MAX_STREAM_STEP = 8;
+
+        explicit AudioMixer(const AudioMixerConfig& config = AudioMixerConfig());
+        ~AudioMixer();
+
+        AudioMixer(const AudioMixer&) = delete;
+        AudioMixer& operator=(const AudioMixer&) = delete;
+
+        // Поток микшера пишет блоки в sink
+        bool Start(std::unique_ptr<AudioSink> sink);
+        void Stop();
+        bool IsRunning() const { return m_running.load(std::memory_order_acquire); }
+
+        // Управление голосами (игровой поток)
+        VoiceHandle Play(const AudioClipPtr& clip, const VoiceParams& params = VoiceParams());
+        // Петля и начальный кадр потока задаются при его открытии,
+        // params.looping и params.startFrame не учитываются
+        VoiceHandle PlayStream(const std::shared_ptr<AudioStream>& stream, const VoiceParams& params = VoiceParams());
+        void StopVoice(VoiceHandle voice);
+        void StopAll();
+        void SetVoiceVolume(VoiceHandle voice, float volume);
+        void SetVoicePan(VoiceHandle voice, float pan);
+        void SetVoicePitch(VoiceHandle voice, float pitch);
+        void SetVoicePaused(VoiceHandle voice, bool paused);
+        void SetMasterVolume(float volume);
+
+        // Забирает уведомления о завершенных голосах и отпускает их клипы;
+        // если очередь уведомлений переполнялась, сверяет голоса со слотами микшера
+        void Update();
+        // Голос запущен и еще не завершился (по состоянию на последний Update)
+        bool IsPlaying(VoiceHandle voice) const;
+
+        // Смешивает frames кадров в interleaved стерео (поток микшера)
+        void Render(float* output, uint32_t frames);
+
+        // Статистика
+        const AudioMixerConfig& GetConfig() const { return m_config; }
+        uint32_t GetActiveVoiceCount() const { return m_activeVoices.load(std::memory_order_relaxed); }
+        uint64_t GetStolenVoiceCount() const { return m_stolenVoices.load(std::memory_order_relaxed); }
+        uint64_t GetRejectedVoiceCount() const { return m_rejectedVoices.load(std::memory_order_relaxed); }
+        uint64_t GetRenderedFrames() const { return m_renderedFrames.load(std::memory_order_relaxed); }
+        double GetAverageBlockTimeUs() const; // Время смешивания блока
+        double GetLoad() const;                // Доля длительности блока
+
+    private:
+        enum class CommandType : uint8_t {
+            Play,
+            Stop,
+            StopAll,
+            SetVolume,
+            SetPan,
+            SetPitch,
+            SetPaused,
+            SetMasterVolume
+        };
+
+        struct Command {
+            CommandType type;
+            VoiceHandle voice;
+            const AudioClip* clip;
+            AudioStream* stream;
+            float value;
+            VoiceParams params;
+
+            Command() : type(CommandType::Stop), voice(INVALID_VOICE), clip(nullptr), stream(nullptr), value(0.0f) {}
+        };
+
+        struct Voice {
+            VoiceHandle handle;      // INVALID_VOICE - слот свободен
+            const AudioClip* clip;
+            AudioStream* stream;
+            uint32_t channels;
+            uint32_t sampleRate;
+            uint64_t position;       // Кадр в формате 32.32 (для потока - в окне)
+            uint64_t step;           // Шаг позиции на кадр выхода
+            float volume;
+            float pan;
+            float pitch;
+            float gainLeft;          // Текущее усиление (конец прошлой рампы)
+            float gainRight;
+            uint64_t startOrder;
+            int priority;
+            bool looping;
+            bool paused;
+            bool stopping;           // Затухает за блок, затем освобождается
+            float carry[4];          // Хвост окна потока: до двух кадров
+            uint32_t carryFrames;
+        };
+
+        struct LiveVoice {
+            AudioClipPtr clip;
+            std::shared_ptr<AudioStream> stream;
+            uint64_t sequence;       // Номер команды Play среди всех Play
+        };
+
+        AudioMixerConfig m_config;
+
+        // Игровой поток
+        SpscRing<Command> m_commands;
+        std::vector<Command> m_backlog;
+        std::unordered_map<VoiceHandle, LiveVoice> m_liveVoices;
+        VoiceHandle m_nextHandle;
+        uint64_t m_playsSent;
+
+        // Поток микшера
+        SpscRing<VoiceHandle> m_finished;
+        std::vector<Voice> m_voices;
+        // Копия Voice::handle для игрового потока и число разобранных Play:
+        // по ним Update находит завершенные голоса, уведомления о которых потеряны
+        std::vector<std::atomic<VoiceHandle>> m_slotHandles;
+        std::atomic<uint64_t> m_playsProcessed;
+        std::atomic<bool> m_finishedLost;
+        std::vector<float> m_mixLeft;
+        std::vector<float> m_mixRight;
+        std::vector<float> m_sourceLeft;
+        std::vector<float> m_sourceRight;
+        std::vector<float> m_streamWindow;
+        float m_masterVolume;
+        uint64_t m_startCounter;
+
+        std::unique_ptr<AudioSink> m_sink;
+        std::thread m_thread;
+        std::atomic<bool> m_running;
+
+        std::atomic<uint32_t> m_activeVoices;
+        std::atomic<uint64_t> m_stolenVoices;
+        std::atomic<uint64_t> m_rejectedVoices;
+        std::atomic<uint64_t> m_renderedFrames;
+        std::atomic<uint64_t> m_renderedBlocks;
+        std::atomic<uint64_t> m_renderTimeNs;
+
+        VoiceHandle AddVoice(LiveVoice live, const VoiceParams& params);
+        void Send(const Command& command);
+        void FlushBacklog();
+        void SweepLiveVoices();
+
+        void ProcessCommands();
+        void StartVoice(const Command& command);
+        Voice* FindVoice(VoiceHandle handle);
+        void SetSlotHandle(Voice& voice, VoiceHandle handle);
+        void NotifyFinished(VoiceHandle handle);
+        void ReleaseVoice(Voice& voice);
+        void UpdateStep(Voice& voice) const;
+        void RenderBlock(float* output, uint32_t frames);
+        bool FetchClip(Voice& voice, uint32_t frames);
+        bool FetchStream(Voice& voice, uint32_t frames);
+        void MixerThread();
+    };
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "FastEngine/Platform/FixedTickLoop.h"
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace FastEngine {
+    /**
+     * Приемник смешанного звука
+     *
+     * Получает блоки стерео float из потока микшера. Write блокирует,
+     * пока устройство не готово принять следующий блок, - так приемник
+     * задает темп микшера.
+     */
+    class AudioSink {
+    public:
+        virtual ~AudioSink() = default;
+
+        virtual bool Open(uint32_t sampleRate, uint32_t channels, uint32_t blockFrames) = 0;
+        virtual void Close() = 0;
+        virtual bool Write(const float* samples, uint32_t frames) = 0;
+    };
+
+    /**
+     * Приемник без вывода (сервер, тесты): в реальном времени ждет
+     * длительность блока, иначе принимает блоки сразу
+     */
+    class NullAudioSink : public AudioSink {
+    public:
+        explicit NullAudioSink(bool realtime = true);
+
+        bool Open(uint32_t sampleRate, uint32_t channels, uint32_t blockFrames) override;
+        void Close() override {}
+        bool Write(const float* samples, uint32_t frames) override;
+
+        uint64_t GetFramesWritten() const { return m_framesWritten.load(std::memory_order_relaxed); }
+        float GetPeak() const { return m_peak.load(std::memory_order_relaxed); }
+
+    private:
+        bool m_realtime;
+        uint32_t m_sampleRate;
+        uint32_t m_channels;
+        PreciseWaiter m_waiter;
+        PreciseWaiter::Clock::time_point m_deadline;
+        bool m_started;
+        std::atomic<uint64_t> m_framesWritten;
+        std::atomic<float> m_peak;
+    };
+
+    /**
+     * Запись в WAV (16 бит PCM); размеры в заголовке дописываются в Close
+     */
+    class WavFileAudioSink : public AudioSink {
+    public:
+        explicit WavFileAudioSink(const std::string& filePath);
+        ~WavFileAudioSink() override;
+
+        bool Open(uint32_t sampleRate, uint32_t channels, uint32_t blockFrames) override;
+        void Close() override;
+        bool Write(const float* samples, uint32_t frames) override;
+
+        uint64_t GetFramesWritten() const { return m_framesWritten.load(std::memory_order_relaxed); }
+
+    private:
+        std::string m_filePath;
+        std::ofstream m_file;
+        uint32_t m_sampleRate;
+        uint32_t m_channels;
+        std::atomic<uint64_t> m_framesWritten;
+        std::vector<int16_t> m_buffer;
+
+        void WriteHeader(uint32_t sampleRate, uint32_t dataBytes);
+    };
+}
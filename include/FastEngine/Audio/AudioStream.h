@@ -0,0 +1,109 @@
+#pragma once
+
+#include "FastEngine/Audio/AudioCodec.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace FastEngine {
+    /**
+     * Потоковый источник звука с двойной буферизацией
+     *
+     * Поток подгрузки декодирует файл в два буфера по очереди, поток
+     * микшера читает готовый буфер и возвращает его на заполнение.
+     * Буферы передаются через атомарные флаги, без блокировок. Один
+     * поток воспроизводится одним голосом.
+     */
+    class AudioStream {
+    public:
+        static constexpr uint32_t DEFAULT_CHUNK_FRAMES = 8192;
+
+        AudioStream(std::unique_ptr<AudioDecoder> decoder, bool looping, uint32_t chunkFrames = DEFAULT_CHUNK_FRAMES);
+
+        AudioStream(const AudioStream&) = delete;
+        AudioStream& operator=(const AudioStream&) = delete;
+
+        uint32_t GetChannels() const { return m_channels; }
+        uint32_t GetSampleRate() const { return m_sampleRate; }
+        uint32_t GetFrameCount() const { return m_frameCount; }
+        bool IsLooping() const { return m_looping; }
+        size_t GetMemorySize() const { return GetBufferSize(m_chunkFrames, m_channels); }
+        static size_t GetBufferSize(uint32_t chunkFrames, uint32_t channels) { return 2ull * chunkFrames * channels * sizeof(float); }
+
+        // Поток микшера: до frames кадров interleaved; меньше - недогрузка или конец
+        uint32_t Read(float* output, uint32_t frames);
+        bool IsFinished() const { return m_finished.load(std::memory_order_acquire); }
+        uint64_t GetUnderrunCount() const { return m_underruns.load(std::memory_order_relaxed); }
+
+        // Поток подгрузки: заполняет свободные буферы; true, если что-то декодировано
+        bool Fill();
+
+    private:
+        struct Chunk {
+            std::vector<float> samples;
+            uint32_t frames;
+            bool endOfStream;
+            std::atomic<bool> ready;
+
+            Chunk() : frames(0), endOfStream(false), ready(false) {}
+        };
+
+        std::unique_ptr<AudioDecoder> m_decoder;
+        uint32_t m_channels;
+        uint32_t m_sampleRate;
+        uint32_t m_frameCount;
+        uint32_t m_chunkFrames;
+        bool m_looping;
+        Chunk m_chunks[2];
+
+        // Сторона потока подгрузки
+        uint32_t m_writeChunk;
+        bool m_decoderFinished;
+
+        // Сторона микшера
+        uint32_t m_readChunk;
+        uint32_t m_readOffset;
+        std::atomic<bool> m_finished;
+        std::atomic<uint64_t> m_underruns;
+    };
+
+    /**
+     * Фоновый поток подгрузки для всех открытых потоков
+     *
+     * Open декодирует оба буфера сразу, поэтому воспроизведение
+     * начинается без недогрузки. Поток держит слабые ссылки: закрытый
+     * (освобожденный) поток просто выпадает из обхода.
+     */
+    class AudioStreamer {
+    public:
+        explicit AudioStreamer(uint32_t chunkFrames = AudioStream::DEFAULT_CHUNK_FRAMES, float pollInterval = 0.01f);
+        ~AudioStreamer();
+
+        AudioStreamer(const AudioStreamer&) = delete;
+        AudioStreamer& operator=(const AudioStreamer&) = delete;
+
+        bool Start();
+        void Stop();
+        bool IsRunning() const { return m_running; }
+
+        std::shared_ptr<AudioStream> Open(const std::string& filePath, bool looping = false, uint32_t startFrame = 0);
+        size_t GetStreamCount() const;
+        uint32_t GetChunkFrames() const { return m_chunkFrames; }
+
+    private:
+        uint32_t m_chunkFrames;
+        float m_pollInterval;
+        std::vector<std::weak_ptr<AudioStream>> m_streams;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::thread m_thread;
+        bool m_running;
+
+        void Run();
+    };
+}
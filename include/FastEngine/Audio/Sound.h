@@ -1,8 +1,21 @@
 #pragma once
 
+#include "FastEngine/Audio/AudioClip.h"
+#include <cstdint>
 #include <string>
 
 namespace FastEngine {
+    class AudioMixer;
+    class AudioStreamer;
+    
+    /**
+     * Звук из файла (WAV: PCM или IMA ADPCM)
+     *
+     * Короткие звуки декодируются один раз в общий AudioClipCache,
+     * длинные (дольше порога) воспроизводятся потоком с диска. Играет
+     * через микшер, если он задан SetOutput (AudioManager::LoadSound
+     * делает это сам); без микшера хранит только состояние.
+     */
     class Sound {
     public:
         Sound();
@@ -12,8 +25,15 @@ namespace FastEngine {
         bool LoadFromFile(const std::string& filePath);
         void Destroy();
         
-        // Воспроизведение
-        void Play();
+        // Вывод через микшер; потоковые звуки требуют streamer
+        void SetOutput(AudioMixer* mixer, AudioStreamer* streamer);
+        
+        // Звуки длиннее порога (секунды) загружаются потоком
+        static void SetStreamingThreshold(float seconds) { s_streamingThreshold = seconds; }
+        static float GetStreamingThreshold() { return s_streamingThreshold; }
+        
+        // Воспроизведение; startTime - смещение от начала, секунды
+        void Play(float startTime = 0.0f);
         void Stop();
         void Pause();
         void Resume();
@@ -28,23 +48,46 @@ namespace FastEngine {
         void SetPitch(float pitch);
         float GetPitch() const { return m_pitch; }
         
+        void SetPan(float pan); // -1.0 (лево) до 1.0 (право)
+        float GetPan() const { return m_pan; }
+        
+        // Приоритет голоса в микшере, применяется при следующем Play
+        void SetPriority(int priority) { m_priority = priority; }
+        int GetPriority() const { return m_priority; }
+        
         // Состояние
-        bool IsPlaying() const { return m_playing; }
+        bool IsPlaying() const;
         bool IsPaused() const { return m_paused; }
         
         // Получение информации
         const std::string& GetFilePath() const { return m_filePath; }
+        bool IsLoaded() const { return m_loaded; }
+        bool IsStreaming() const { return m_streaming; }
+        AudioClipPtr GetClip() const { return m_clip; }
+        float GetDuration() const { return m_duration; }
+        // Декодированные данные или буферы потока, байт
+        size_t GetMemorySize() const;
         
     private:
         std::string m_filePath;
         float m_volume;
         bool m_looping;
         float m_pitch;
+        float m_pan;
+        int m_priority;
         bool m_playing;
         bool m_paused;
         bool m_loaded;
+        bool m_streaming;
+        float m_duration;
+        uint32_t m_channels;
+        uint32_t m_sampleRate;
+        
+        AudioClipPtr m_clip;
+        AudioMixer* m_mixer;
+        AudioStreamer* m_streamer;
+        uint32_t m_voice; // VoiceHandle микшера
         
-        // Платформо-специфичные данные
-        void* m_audioData;
+        static float s_streamingThreshold;
     };
 }
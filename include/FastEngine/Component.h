@@ -1,11 +1,16 @@
 #pragma once
 
+#include "FastEngine/Memory/PoolAllocator.h"
+
 namespace FastEngine {
     class Component {
     public:
         Component() = default;
         virtual ~Component() = default;
         
+        // Компоненты выделяются из пулов по классам размеров
+        FASTENGINE_POOLED_ALLOCATION
+        
         // Виртуальные методы для инициализации и обновления
         virtual void Initialize() {}
         virtual void Update(float deltaTime) {}
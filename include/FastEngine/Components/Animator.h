@@ -1,68 +1,77 @@
 #pragma once
 
 #include "FastEngine/Component.h"
-#include <glm/glm.hpp>
+#include "FastEngine/Resources/AnimationClip.h"
 #include <string>
 #include <vector>
 #include <map>
 #include <functional>
 
 namespace FastEngine {
-    enum class AnimationType {
-        Loop,       // Зацикленная анимация
-        Once,       // Одноразовая анимация
-        PingPong    // Анимация туда-обратно
-    };
+    class AnimationSystem;
     
-    struct AnimationFrame {
-        std::string texturePath;
-        float duration;     // Длительность кадра в секундах
-        glm::vec2 offset;   // Смещение спрайта
-        glm::vec2 size;     // Размер спрайта
-        
-        AnimationFrame() : duration(0.1f), offset(0.0f), size(1.0f) {}
-        AnimationFrame(const std::string& path, float dur = 0.1f) 
-            : texturePath(path), duration(dur), offset(0.0f), size(1.0f) {}
+    enum AnimationPlaybackFlags : uint8_t {
+        ANIMATION_PLAYING = 1,
+        ANIMATION_PAUSED = 2
     };
     
-    struct Animation {
-        std::string name;
-        std::vector<AnimationFrame> frames;
-        AnimationType type;
-        float speed;        // Скорость воспроизведения (множитель)
-        bool autoPlay;      // Автоматический запуск
-        
-        Animation() : type(AnimationType::Loop), speed(1.0f), autoPlay(false) {}
-        Animation(const std::string& animName) 
-            : name(animName), type(AnimationType::Loop), speed(1.0f), autoPlay(false) {}
+    /**
+     * Состояние воспроизведения одного аниматора (16 байт, POD)
+     */
+    struct AnimationPlayback {
+        AnimationClipHandle clip;
+        float time;         // Время в текущем кадре, секунды
+        float speed;        // Множитель аниматора (SetSpeed), к скорости клипа
+        uint16_t frame;
+        int8_t direction;   // PingPong: 1 - вперед, -1 - назад
+        uint8_t flags;      // AnimationPlaybackFlags
     };
     
+    /**
+     * Аниматор спрайта
+     *
+     * Клипы общие (AnimationClipLibrary), у аниматора - таблица имен и
+     * AnimationPlayback. Подключенный к AnimationSystem аниматор хранит
+     * состояние в плотных массивах системы, она же пишет UV кадра в
+     * Sprite; без системы Update продвигает собственное состояние.
+     */
     class Animator : public Component {
     public:
+        // События Step
+        static constexpr uint32_t EVENT_FRAME_CHANGED = 1;
+        static constexpr uint32_t EVENT_COMPLETED = 2;
+        
         Animator();
-        ~Animator() override = default;
+        ~Animator() override;
+        
+        Animator(const Animator&) = delete;
+        Animator& operator=(const Animator&) = delete;
         
         // Управление анимациями
         void AddAnimation(const Animation& animation);
+        void AddClip(AnimationClipHandle clip); // Заранее зарегистрированный клип
         void RemoveAnimation(const std::string& name);
         void ClearAnimations();
         
         // Воспроизведение анимаций
         void Play(const std::string& animationName);
+        void Play(AnimationClipHandle clip);
         void Stop();
         void Pause();
         void Resume();
         
         // Управление состоянием
-        bool IsPlaying() const { return m_isPlaying; }
-        bool IsPaused() const { return m_isPaused; }
-        std::string GetCurrentAnimation() const { return m_currentAnimation; }
-        int GetCurrentFrame() const { return m_currentFrame; }
+        bool IsPlaying() const { return (GetPlayback().flags & ANIMATION_PLAYING) != 0; }
+        bool IsPaused() const { return (GetPlayback().flags & ANIMATION_PAUSED) != 0; }
+        const std::string& GetCurrentAnimation() const;
+        int GetCurrentFrame() const { return GetPlayback().frame; }
+        AnimationClipHandle GetCurrentClip() const { return GetPlayback().clip; }
+        AnimationPlayback GetPlayback() const;
         
-        // Получение текущего кадра
-        AnimationFrame GetCurrentFrameData() const;
+        // Получение текущего кадра (без копирования)
+        const AnimationFrame& GetCurrentFrameData() const;
         
-        // Обновление анимации
+        // Обновление анимации (без AnimationSystem)
         void Update(float deltaTime) override;
         
         // События анимации
@@ -70,28 +79,33 @@ namespace FastEngine {
         void SetOnFrameChange(std::function<void(int)> callback);
         
         // Настройки
-        void SetSpeed(float speed) { m_speed = speed; }
-        float GetSpeed() const { return m_speed; }
+        void SetSpeed(float speed);
+        float GetSpeed() const { return GetPlayback().speed; }
         
         // Получение информации об анимациях
-        const std::vector<std::string>& GetAnimationNames() const;
+        const std::vector<std::string>& GetAnimationNames() const { return m_names; }
         bool HasAnimation(const std::string& name) const;
         const Animation* GetAnimation(const std::string& name) const;
         
+        // Продвигает state на целые кадры, пока time не меньше длительности
+        // текущего; возвращает EVENT_*. Общий шаг Update и AnimationSystem
+        static uint32_t Step(AnimationPlayback& state, const AnimationClip& clip);
+    
     private:
-        std::map<std::string, Animation> m_animations;
-        std::string m_currentAnimation;
-        int m_currentFrame;
-        float m_frameTimer;
-        bool m_isPlaying;
-        bool m_isPaused;
-        float m_speed;
+        friend class AnimationSystem;
+        
+        std::map<std::string, AnimationClipHandle> m_animations;
+        std::vector<std::string> m_names;
+        AnimationPlayback m_playback; // Пока не подключен к системе
+        AnimationSystem* m_system;
+        uint32_t m_slot;
         
         // События
         std::function<void(const std::string&)> m_onAnimationComplete;
         std::function<void(int)> m_onFrameChange;
         
-        void NextFrame();
-        void ResetAnimation();
+        void SetPlayback(const AnimationPlayback& state);
+        void DispatchEvents(uint32_t events, const AnimationPlayback& state);
+        void RebuildNames();
     };
 }
@@ -7,6 +7,8 @@
 
 namespace FastEngine {
     class Sound;
+    class AudioMixer;
+    class AudioStreamer;
     
     enum class AudioState {
         Stopped,
@@ -21,6 +23,15 @@ namespace FastEngine {
         Ambient     // Амбиент
     };
     
+    /**
+     * Источник звука на сущности
+     *
+     * Play только переводит источник в состояние Playing: голос микшера
+     * выдает AudioSystem по слышимости, остальные источники виртуальные -
+     * позиция воспроизведения отслеживается по времени, и голос при
+     * возврате продолжает с нее. Без AudioSystem источник хранит только
+     * состояние.
+     */
     class AudioSource : public Component {
     public:
         AudioSource();
@@ -52,11 +63,11 @@ namespace FastEngine {
         void SetPan(float pan); // -1.0 (лево) до 1.0 (право)
         float GetPan() const { return m_pan; }
         
-        // Зацикливание
+        // Зацикливание (применяется при следующем запуске голоса)
         void SetLooping(bool loop) { m_looping = loop; }
         bool IsLooping() const { return m_looping; }
         
-        // 3D позиционирование
+        // 3D позиционирование: громкость и панорама от Transform слушателя (AudioSystem)
         void Set3DEnabled(bool enabled) { m_3DEnabled = enabled; }
         bool Is3DEnabled() const { return m_3DEnabled; }
         
@@ -91,6 +102,25 @@ namespace FastEngine {
         // Получение информации о звуке
         std::string GetSoundPath() const { return m_soundPath; }
         bool HasSound() const { return m_sound != nullptr; }
+        float GetPlaybackTime() const { return m_playbackTime; } // Секунды от начала
+        
+        // Громкость и высота с учетом fade и временных эффектов
+        float GetEffectiveVolume() const { return m_tempVolumeActive ? m_tempVolume : m_volume; }
+        float GetEffectivePitch() const { return m_tempPitchActive ? m_tempPitch : m_pitch; }
+        
+        // Голос микшера (вызывается AudioSystem)
+        void SetOutput(AudioMixer* mixer, AudioStreamer* streamer);
+        bool HasOutput() const { return m_mixer != nullptr; }
+        bool HasVoice() const { return m_hasVoice; }
+        bool IsVirtual() const { return IsPlaying() && !m_hasVoice; }
+        // Затухание и панорама от слушателя; голос обновляется, если изменились
+        void SetSpatialParams(float gain, float pan);
+        float GetSpatialGain() const { return m_spatialGain; }
+        float GetSpatialPan() const { return m_spatialPan; }
+        // Запускает голос с текущей позиции; false - нет вывода или микшер отказал
+        bool StartVoice();
+        // Освобождает голос, позиция продолжает отслеживаться
+        void Virtualize();
         
         // Fade эффекты
         void FadeIn(float duration);
@@ -104,6 +134,8 @@ namespace FastEngine {
     private:
         std::shared_ptr<Sound> m_sound;
         std::string m_soundPath;
+        AudioMixer* m_mixer;
+        AudioStreamer* m_streamer;
         AudioState m_state;
         AudioType m_audioType;
         
@@ -123,6 +155,15 @@ namespace FastEngine {
         int m_priority;
         bool m_autoPlay;
         
+        // Воспроизведение
+        bool m_hasVoice;
+        float m_playbackTime;
+        float m_spatialGain;
+        float m_spatialPan;
+        float m_voiceVolume; // Последние отправленные в микшер значения
+        float m_voicePan;
+        float m_voicePitch;
+        
         // Fade эффекты
         bool m_fadingIn;
         bool m_fadingOut;
@@ -145,6 +186,7 @@ namespace FastEngine {
         // Вспомогательные методы
         void UpdateFade(float deltaTime);
         void UpdateTemporaryEffects(float deltaTime);
-        void Apply3DPositioning();
+        void UpdatePlayback(float deltaTime);
+        void CompletePlayback();
     };
 }
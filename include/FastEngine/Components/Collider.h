@@ -115,6 +115,8 @@ namespace FastEngine {
         
         // Вспомогательные методы
         glm::vec2 RotatePoint(const glm::vec2& point, const glm::vec2& center, float angle) const;
+        // Вершины в мировых координатах в out (m_vertices.size() элементов)
+        void TransformVertices(const glm::vec2& position, float rotation, glm::vec2* out) const;
         void UpdateVertices();
     };
 }
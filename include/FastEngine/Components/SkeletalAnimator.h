@@ -0,0 +1,87 @@
+#pragma once
+
+#include "FastEngine/Component.h"
+#include "FastEngine/Animation/BlendTree.h"
+#include "FastEngine/Animation/Skeleton.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace FastEngine {
+    /**
+     * Скелетная анимация сущности
+     *
+     * Скелет, дерево смешивания и меш общие; экземпляр хранит время,
+     * параметры дерева и результат: позу, модельные матрицы и матрицы
+     * скиннинга (для uniform-массива шейдера). С включенным CPU-скиннингом
+     * также вершины меша в позе. SkeletalAnimationSystem вычисляет
+     * аниматоры мира параллельно; Update - для использования без системы.
+     */
+    class SkeletalAnimator : public Component {
+    public:
+        explicit SkeletalAnimator(std::shared_ptr<const Skeleton> skeleton);
+        ~SkeletalAnimator() override;
+
+        const std::shared_ptr<const Skeleton>& GetSkeleton() const { return m_skeleton; }
+
+        // Дерево смешивания; false, если число костей не совпадает со скелетом.
+        // Время сбрасывается, параметры получают значения по умолчанию
+        bool SetBlendTree(std::shared_ptr<const BlendTree> tree);
+        const std::shared_ptr<const BlendTree>& GetBlendTree() const { return m_tree; }
+        // Один зацикленный клип
+        bool Play(std::shared_ptr<const SkeletalClip> clip);
+
+        // Параметры дерева
+        void SetParameter(uint32_t parameter, float value);
+        bool SetParameter(const std::string& name, float value);
+        float GetParameter(uint32_t parameter) const { return m_parameters[parameter]; }
+
+        // Воспроизведение
+        void SetSpeed(float speed) { m_speed = speed; }
+        float GetSpeed() const { return m_speed; }
+        void SetPaused(bool paused) { m_paused = paused; }
+        bool IsPaused() const { return m_paused; }
+        void SetTime(float time) { m_time = time; }
+        float GetTime() const { return m_time; }
+
+        // CPU-скиннинг - запасной путь для рендера без скиннинга в шейдере
+        void SetSkinnedMesh(std::shared_ptr<const SkinnedMeshData> mesh) { m_mesh = std::move(mesh); }
+        const std::shared_ptr<const SkinnedMeshData>& GetSkinnedMesh() const { return m_mesh; }
+        void SetCpuSkinning(bool enabled) { m_cpuSkinning = enabled; }
+        bool IsCpuSkinning() const { return m_cpuSkinning; }
+        const std::vector<glm::vec3>& GetSkinnedPositions() const { return m_skinnedPositions; }
+        const std::vector<glm::vec3>& GetSkinnedNormals() const { return m_skinnedNormals; }
+
+        // Результат последнего вычисления
+        const Pose& GetPose() const { return m_pose; }
+        const std::vector<BoneMatrix>& GetModelMatrices() const { return m_model; }
+        const std::vector<BoneMatrix>& GetSkinningMatrices() const { return m_skinning; }
+
+        // Продвигает время и вычисляет позу (без SkeletalAnimationSystem)
+        void Update(float deltaTime) override;
+
+        // Шаги, которые SkeletalAnimationSystem выполняет раздельно: время
+        // продвигается в игровом потоке, вычисление - в рабочих
+        void Advance(float deltaTime);
+        // Вычисляет позу, матрицы и вершины; context - буферы вызывающего потока
+        void Evaluate(BlendTreeContext& context);
+        bool CanEvaluate() const { return m_tree && m_skeleton && m_skeleton->GetBoneCount() > 0; }
+
+    private:
+        std::shared_ptr<const Skeleton> m_skeleton;
+        std::shared_ptr<const BlendTree> m_tree;
+        std::shared_ptr<const SkinnedMeshData> m_mesh;
+        std::vector<float> m_parameters;
+        float m_time;
+        float m_speed;
+        bool m_paused;
+        bool m_cpuSkinning;
+
+        Pose m_pose;
+        std::vector<BoneMatrix> m_model;
+        std::vector<BoneMatrix> m_skinning;
+        std::vector<glm::vec3> m_skinnedPositions;
+        std::vector<glm::vec3> m_skinnedNormals;
+        std::unique_ptr<BlendTreeContext> m_context; // Для Update без системы
+    };
+}
@@ -27,6 +27,10 @@ namespace FastEngine {
         void SetColor(float r, float g, float b, float a = 1.0f) { m_color = glm::vec4(r, g, b, a); }
         void SetColor(const glm::vec4& color) { m_color = color; }
         
+        // Область текстуры (u0, v0, u1, v1); кадр атласа пишет AnimationSystem
+        const glm::vec4& GetUVRect() const { return m_uvRect; }
+        void SetUVRect(const glm::vec4& rect) { m_uvRect = rect; }
+        
         // Видимость
         bool IsVisible() const { return m_visible; }
         void SetVisible(bool visible) { m_visible = visible; }
@@ -35,6 +39,7 @@ namespace FastEngine {
         Texture* m_texture;
         glm::vec2 m_size;
         glm::vec4 m_color;
+        glm::vec4 m_uvRect;
         bool m_visible;
     };
 }
\ No newline at end of file
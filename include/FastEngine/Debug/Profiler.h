@@ -1,5 +1,6 @@
 #pragma once
 
+#include "FastEngine/Profiling/ScopeProfiler.h"
 #include <string>
 #include <map>
 #include <vector>
@@ -23,6 +24,13 @@ namespace FastEngine {
         ProfileData() : totalTime(0.0), averageTime(0.0), minTime(0.0), maxTime(0.0), callCount(0), lastTime(0.0) {}
     };
     
+    /**
+     * Отладочный профилировщик
+     *
+     * Фасад над ScopeProfiler: области пишутся в буферы потоков без
+     * блокировок, Update раз в кадр забирает агрегированную статистику
+     * для вывода и экспорта.
+     */
     class Profiler {
     public:
         static Profiler& GetInstance();
@@ -31,21 +39,18 @@ namespace FastEngine {
         bool Initialize();
         void Shutdown();
         
-        // Управление профилированием
+        // Управление профилированием; области вкладываются, EndProfile
+        // закрывает последнюю открытую область потока
         void StartProfile(const std::string& name);
         void EndProfile(const std::string& name);
         
         // Автоматическое профилирование с RAII
         class ScopedTimer {
         public:
-            ScopedTimer(const std::string& name) : m_name(name) {
-                Profiler::GetInstance().StartProfile(name);
-            }
-            ~ScopedTimer() {
-                Profiler::GetInstance().EndProfile(m_name);
-            }
+            explicit ScopedTimer(const std::string& name) : m_scope(ProfileNames::Register(name)) {}
+            explicit ScopedTimer(ProfileNameId name) : m_scope(name) {}
         private:
-            std::string m_name;
+            ScopeProfiler::Scope m_scope;
         };
         
         // Получение данных
@@ -61,8 +66,8 @@ namespace FastEngine {
         void Update(float deltaTime);
         void Render(Renderer* renderer);
         
-        // Настройки
-        void SetEnabled(bool enabled) { m_enabled = enabled; }
+        // Настройки; выключение останавливает запись областей
+        void SetEnabled(bool enabled);
         bool IsEnabled() const { return m_enabled; }
         
         void SetMaxHistory(int max) { m_maxHistory = max; }
@@ -96,23 +101,23 @@ namespace FastEngine {
         Profiler& operator=(const Profiler&) = delete;
         
         // Состояние
-        bool m_enabled;
-        bool m_initialized;
-        int m_displayMode; // 0 = Simple, 1 = Detailed, 2 = Graph
-        int m_maxHistory;
-        double m_minTime;
+        bool m_enabled = false;
+        bool m_initialized = false;
+        int m_displayMode = 0; // 0 = Simple, 1 = Detailed, 2 = Graph
+        int m_maxHistory = 1000;
+        double m_minTime = 0.0;
         
-        // Профили
+        // Профили - снимок статистики ScopeProfiler
         std::map<std::string, ProfileData> m_profiles;
-        std::map<std::string, std::chrono::high_resolution_clock::time_point> m_activeProfiles;
         
-        // Статистика кадров
+        // Статистика кадров; кольцо, m_nextFrameTime - самая старая запись
         std::vector<double> m_frameTimes;
-        double m_totalFrameTime;
-        int m_frameCount;
+        size_t m_nextFrameTime = 0;
+        double m_totalFrameTime = 0.0;
+        int m_frameCount = 0;
         
         // Вспомогательные методы
-        void UpdateProfileData(const std::string& name, double time);
+        void RefreshProfiles();
         void RenderSimple(Renderer* renderer);
         void RenderDetailed(Renderer* renderer);
         void RenderGraph(Renderer* renderer);
@@ -120,8 +125,8 @@ namespace FastEngine {
         glm::vec4 GetColorForTime(double time) const;
     };
     
-    // Макрос для удобного профилирования
-    #define PROFILE_SCOPE(name) Profiler::ScopedTimer _profiler_timer(name)
+    // Макрос для удобного профилирования; имя регистрируется один раз
+    #define PROFILE_SCOPE(name) FASTENGINE_PROFILE_SCOPE(name)
     #define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
 }
 
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "FastEngine/Platform/FixedTickLoop.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+namespace FastEngine {
+    class World;
+
+    /**
+     * Выделенный сервер
+     *
+     * Держит несколько матчей в одном процессе: у каждого свой World,
+     * свой поток и свой цикл с фиксированным тиком, без окна, рендерера
+     * и аудио. Колбэк тика (сеть, правила матча) вызывается в потоке
+     * матча перед World::Update. Миры матчей не разделяют состояние,
+     * поэтому потоки не синхронизируются между собой.
+     */
+    class DedicatedServer {
+    public:
+        using TickCallback = std::function<void(World& world, float deltaTime, uint64_t tick)>;
+        using SetupCallback = std::function<void(World& world)>;
+
+        explicit DedicatedServer(const FixedTickConfig& config = FixedTickConfig());
+        ~DedicatedServer();
+
+        // setup наполняет мир до первого тика; матч запускается сразу,
+        // если сервер уже работает
+        size_t AddMatch(TickCallback onTick = nullptr, SetupCallback setup = nullptr);
+        void StopMatch(size_t match);
+
+        bool Start();
+        void Stop();
+        bool IsRunning() const { return m_running; }
+
+        // Мир матча: из колбэка тика или при остановленном матче
+        World* GetWorld(size_t match) const;
+        size_t GetMatchCount() const { return m_matches.size(); }
+        bool IsMatchRunning(size_t match) const;
+
+        // Статистика тиков
+        TickStats GetMatchStats(size_t match) const;
+        void WriteStats(std::ostream& out) const;
+
+    private:
+        struct Match {
+            std::unique_ptr<World> world;
+            FixedTickLoop loop;
+            TickCallback onTick;
+            std::thread thread;
+            std::atomic<bool> running;
+
+            explicit Match(const FixedTickConfig& config);
+        };
+
+        FixedTickConfig m_config;
+        std::vector<std::unique_ptr<Match>> m_matches;
+        bool m_running;
+
+        void StartMatch(Match& match);
+    };
+}
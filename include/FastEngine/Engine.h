@@ -1,5 +1,8 @@
 #pragma once
 
+#include "FastEngine/Input/InputRecording.h"
+#include "FastEngine/Platform/FixedTickLoop.h"
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -12,6 +15,8 @@ namespace FastEngine {
     class AudioManager;
     class InputManager;
     class RenderSystem;
+    class AudioSystem;
+    class QuantileSketch;
     
     class Engine {
     public:
@@ -20,12 +25,22 @@ namespace FastEngine {
         
         // Инициализация и завершение работы
         bool Initialize(const std::string& title, int width, int height);
+        // Выделенный сервер: только World, без окна, рендерера, аудио и ввода;
+        // Run и RunOneFrame идут фиксированным тиком config.tickRate.
+        // Несколько матчей в процессе - DedicatedServer
+        bool InitializeHeadless(const FixedTickConfig& config = FixedTickConfig());
+        // Воспроизведение записи ввода: World и InputManager без окна, рендера
+        // и аудио, кадры без ожидания. RunOneFrame подает события очередного
+        // кадра и шаг config.fixedDeltaTime (0 - записанный); после
+        // последнего кадра Engine останавливается
+        bool InitializeReplay(std::shared_ptr<const InputRecording> recording,
+                              const ReplayConfig& config = ReplayConfig());
         void Shutdown();
         
         // Основной игровой цикл
         void Run();
         
-        // Один кадр (для iOS/внешнего цикла)
+        // Один кадр (для iOS/внешнего цикла); без окна - ожидание и один тик
         void RunOneFrame();
         
         // Получение основных систем
@@ -34,37 +49,57 @@ namespace FastEngine {
         AudioManager* GetAudioManager() const { return m_audioManager.get(); }
         InputManager* GetInputManager() const { return m_inputManager.get(); }
         RenderSystem* GetRenderSystem() const { return m_renderSystem.get(); }
+        AudioSystem* GetAudioSystem() const { return m_audioSystem.get(); }
         
         // Управление состоянием
-        bool IsRunning() const { return m_running; }
-        void Stop() { m_running = false; }
+        bool IsRunning() const { return m_running.load(std::memory_order_acquire); }
+        void Stop() { m_running.store(false, std::memory_order_release); } // Из любого потока
+        bool IsHeadless() const { return m_headless; }
+        bool IsReplaying() const { return m_replay != nullptr; }
+        // Время Update кадров воспроизведения после прогрева, мс; nullptr без воспроизведения
+        const QuantileSketch* GetReplayFrameTimes() const { return m_replayFrameTimes.get(); }
         
         // Получение времени и счётчика кадров
         float GetDeltaTime() const { return m_deltaTime; }
         float GetFPS() const { return m_fps; }
         uint64_t GetFrameCount() const { return m_frameCount; }
+        TickStats GetTickStats() const; // Без окна; иначе пустая
         
         // Получение информации о платформе
         std::string GetPlatformName() const;
         
         /// Колбэк, вызываемый в конце каждого кадра после отрисовки мира (для UI, FPS и т.д.)
         void SetRenderCallback(std::function<void()> cb) { m_renderCallback = std::move(cb); }
+        /// Колбэк логики игры: каждый кадр после публикации снимка ввода, до World (и при воспроизведении)
+        void SetUpdateCallback(std::function<void(float)> cb) { m_updateCallback = std::move(cb); }
         
     private:
         void Update(float deltaTime);
         void Render();
+        void RunReplayFrame();
         
         std::unique_ptr<World> m_world;
         std::unique_ptr<Renderer> m_renderer;
         std::unique_ptr<AudioManager> m_audioManager;
         std::unique_ptr<InputManager> m_inputManager;
         std::unique_ptr<RenderSystem> m_renderSystem;
+        std::unique_ptr<AudioSystem> m_audioSystem;
+        std::unique_ptr<FixedTickLoop> m_tickLoop;
+        std::shared_ptr<const InputRecording> m_replay;
+        ReplayConfig m_replayConfig;
+        size_t m_replayFrame;
+        std::unique_ptr<QuantileSketch> m_replayFrameTimes;
         
-        bool m_running;
+        std::atomic<bool> m_running;
+        bool m_headless;
+        bool m_ownsJobSystem; // JobSystem запущен этим Engine
         float m_deltaTime;
         float m_fps;
         float m_lastFrameTime;
+        float m_fpsTimer;
+        int m_framesInSecond;
         uint64_t m_frameCount;
         std::function<void()> m_renderCallback;
+        std::function<void(float)> m_updateCallback;
     };
 }
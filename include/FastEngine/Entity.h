@@ -1,5 +1,6 @@
 #pragma once
 
+#include "FastEngine/Memory/PoolAllocator.h"
 #include <vector>
 #include <memory>
 #include <typeindex>
@@ -14,6 +15,9 @@ namespace FastEngine {
         Entity(World* world);
         ~Entity();
         
+        // Сущности выделяются из пулов по классам размеров
+        FASTENGINE_POOLED_ALLOCATION
+        
         // Добавление и удаление компонентов
         template<typename T, typename... Args>
         T* AddComponent(Args&&... args) {
@@ -36,7 +36,7 @@ struct QualitySettings {
     // Аудио
     int audioSampleRate = 44100;
     int audioBitRate = 128;
-    std::string audioFormat = "OGG"; // OGG, MP3, WAV
+    std::string audioFormat = "ADPCM"; // ADPCM (WAV IMA ADPCM, 4:1), WAV - то, что декодирует движок
     
     // Общие настройки
     bool stripDebugInfo = true;
@@ -1,74 +1,135 @@
 #pragma once
 
-#include <memory>
+#include "FastEngine/Input/InputSnapshot.h"
+#include "FastEngine/Platform/SpscRing.h"
+#include "FastEngine/Profiling/QuantileSketch.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <vector>
 #include <functional>
 #include <glm/glm.hpp>
 
 namespace FastEngine {
-    class TouchInput;
-    class KeyboardInput;
-    
+    class InputRecording;
+
+    /**
+     * Менеджер ввода
+     *
+     * On* только кладут событие с меткой времени в очередь без блокировок
+     * и могут вызываться из потока платформы (один поток-производитель).
+     * Update в потоке игры применяет накопленные события к новому снимку
+     * InputSnapshot, публикует его и вызывает обратные вызовы. Запросы
+     * Is* и GetSnapshot отвечают по последнему опубликованному снимку,
+     * поэтому весь кадр видит одно и то же состояние ввода.
+     */
     class InputManager {
     public:
+        static constexpr size_t EVENT_QUEUE_CAPACITY = 1024;
+        // Опубликованный снимок не перезаписывается столько кадров
+        static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 3;
+
         struct TouchPoint {
             int id;
             glm::vec2 position;
             bool pressed;
             bool released;
         };
-        
+
         struct KeyEvent {
             int key;
             bool pressed;
             bool released;
             bool repeated;
         };
-        
+
         InputManager();
         ~InputManager();
-        
+
         // Инициализация и завершение работы
         bool Initialize();
         void Shutdown();
-        
-        // Обновление состояния ввода
+
+        // Разбор очереди событий и публикация снимка кадра
         void Update(float deltaTime);
-        
-        // Обработка событий
-        void OnTouchDown(int id, float x, float y);
-        void OnTouchUp(int id, float x, float y);
-        void OnTouchMove(int id, float x, float y);
-        void OnKeyDown(int key);
-        void OnKeyUp(int key);
-        
+
+        // Обработка событий; ticks - ProfileClock::Now() при получении, 0 - текущее время
+        void OnTouchDown(int id, float x, float y, uint64_t ticks = 0);
+        void OnTouchUp(int id, float x, float y, uint64_t ticks = 0);
+        void OnTouchMove(int id, float x, float y, uint64_t ticks = 0);
+        void OnKeyDown(int key, uint64_t ticks = 0);
+        void OnKeyUp(int key, uint64_t ticks = 0);
+
         // Получение состояния ввода
         bool IsKeyPressed(int key) const;
         bool IsKeyJustPressed(int key) const;
         bool IsKeyJustReleased(int key) const;
-        
+
         bool IsTouchPressed(int id) const;
         bool IsTouchJustPressed(int id) const;
         bool IsTouchJustReleased(int id) const;
         glm::vec2 GetTouchPosition(int id) const;
-        
+
         // Получение всех активных касаний
         const std::vector<TouchPoint>& GetActiveTouches() const { return m_activeTouches; }
-        
-        // Обратные вызовы
+
+        // Снимок последнего Update; безопасно читать из любых потоков
+        const InputSnapshot& GetSnapshot() const { return *m_current.load(std::memory_order_acquire); }
+
+        // Событие из записи (или теста) в ту же очередь; ticks 0 - текущее время
+        void InjectEvent(const InputEvent& event);
+
+        /**
+         * Запись сессии: каждый Update добавляет в recording кадр с
+         * deltaTime и примененными событиями. Запись принадлежит
+         * вызывающему и должна жить до StopRecording
+         */
+        void StartRecording(InputRecording* recording) { m_recording = recording; }
+        void StopRecording() { m_recording = nullptr; }
+        bool IsRecording() const { return m_recording != nullptr; }
+
+        // Событий, потерянных из-за переполнения очереди, с Initialize
+        uint64_t GetDroppedEventCount() const { return m_droppedTotal; }
+
+        /**
+         * Вызывается после показа кадра: задержка от самого раннего
+         * события снимка до показа попадает в статистику
+         */
+        void OnFramePresented();
+        // Миллисекунды от события до показа кадра
+        const QuantileSketch& GetLatencyStats() const { return m_latency; }
+        double GetLastLatencyMs() const { return m_lastLatencyMs; }
+
+        // Обратные вызовы; вызываются из Update после публикации снимка
         std::function<void(const TouchPoint&)> OnTouchDownCallback;
         std::function<void(const TouchPoint&)> OnTouchUpCallback;
         std::function<void(const TouchPoint&)> OnTouchMoveCallback;
         std::function<void(const KeyEvent&)> OnKeyDownCallback;
         std::function<void(const KeyEvent&)> OnKeyUpCallback;
-        
+
     private:
-        std::unique_ptr<TouchInput> m_touchInput;
-        std::unique_ptr<KeyboardInput> m_keyboardInput;
-        
+        SpscRing<InputEvent> m_events;
+        std::atomic<uint32_t> m_droppedEvents; // Производитель увеличивает, Update забирает
+        uint64_t m_droppedTotal;
+
+        std::array<InputSnapshot, MAX_FRAMES_IN_FLIGHT> m_snapshots;
+        std::atomic<const InputSnapshot*> m_current;
+        uint64_t m_frame;
+
+        // События последнего Update для обратных вызовов
+        std::vector<InputEvent> m_frameEvents;
         std::vector<TouchPoint> m_activeTouches;
-        std::vector<KeyEvent> m_keyEvents;
-        
-        bool m_initialized;
+
+        InputRecording* m_recording;
+
+        QuantileSketch m_latency;
+        double m_lastLatencyMs;
+        uint64_t m_presentedFrame;
+
+        std::atomic<bool> m_initialized;
+
+        void PushEvent(InputEvent::Type type, int code, float x, float y, uint64_t ticks);
+        static void ApplyEvent(InputSnapshot& snapshot, const InputEvent& event);
+        void DispatchCallbacks(const InputSnapshot& previous);
     };
 }
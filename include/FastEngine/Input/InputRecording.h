@@ -0,0 +1,72 @@
+#pragma once
+
+#include "FastEngine/Input/InputSnapshot.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace FastEngine {
+    /**
+     * Запись сессии ввода: события каждого кадра и шаг кадра
+     *
+     * Пишется InputManager::StartRecording, воспроизводится
+     * Engine::InitializeReplay. Кадр хранит события в порядке применения,
+     * поэтому при воспроизведении снимки InputSnapshot совпадают с
+     * записанными. Метки времени событий не сохраняются - при
+     * воспроизведении они заново берутся с часов.
+     *
+     * Двоичный формат упакован BitWriter: заголовок, затем для кадра бит
+     * "шаг как у прошлого кадра" (иначе float), число событий (varint) и
+     * события - тип 3 бита, код zigzag-varint, для касаний x и y float.
+     * Кадр с прежним шагом и без событий занимает 9 бит.
+     */
+    class InputRecording {
+    public:
+        static constexpr uint32_t MAGIC = 0x52494546u; // "FEIR"
+        static constexpr uint32_t FORMAT_VERSION = 1;
+        static constexpr const char* FILE_EXTENSION = ".feir";
+
+        struct Frame {
+            float deltaTime;
+            uint32_t firstEvent;
+            uint32_t eventCount;
+        };
+
+        InputRecording();
+
+        void Clear();
+        void AddFrame(float deltaTime, const InputEvent* events, size_t count);
+
+        size_t GetFrameCount() const { return m_frames.size(); }
+        const Frame& GetFrame(size_t index) const { return m_frames[index]; }
+        const InputEvent* GetEvents(const Frame& frame) const { return m_events.data() + frame.firstEvent; }
+        size_t GetEventCount() const { return m_events.size(); }
+        // Сумма шагов, секунды
+        double GetDuration() const { return m_duration; }
+        bool IsEmpty() const { return m_frames.empty(); }
+
+        // Заменяет содержимое data; false при ошибке упаковки
+        bool Serialize(std::vector<uint8_t>& data) const;
+        // false и пустая запись при поврежденных данных
+        bool Deserialize(const uint8_t* data, size_t size);
+
+        bool SaveToFile(const std::string& path) const;
+        bool LoadFromFile(const std::string& path);
+
+    private:
+        std::vector<Frame> m_frames;
+        std::vector<InputEvent> m_events;
+        double m_duration;
+    };
+
+    /**
+     * Параметры воспроизведения записи ввода
+     */
+    struct ReplayConfig {
+        float fixedDeltaTime;  // 0 - записанный шаг кадра
+        uint32_t warmupFrames; // Первые кадры не попадают в статистику времени кадра
+
+        ReplayConfig() : fixedDeltaTime(0.0f), warmupFrames(0) {}
+    };
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace FastEngine {
+    /**
+     * Событие ввода с меткой времени - 24 байта
+     *
+     * ticks - ProfileClock::Now() в момент получения события от
+     * платформы; по нему считается задержка до кадра, который его увидел.
+     */
+    struct InputEvent {
+        enum Type : uint8_t {
+            KEY_DOWN,
+            KEY_UP,
+            TOUCH_DOWN,
+            TOUCH_UP,
+            TOUCH_MOVE
+        };
+
+        uint64_t ticks;
+        int32_t code;    // Клавиша или идентификатор касания
+        float x;
+        float y;
+        uint8_t type;
+    };
+
+    /**
+     * Неизменяемое состояние ввода одного кадра
+     *
+     * Строится в InputManager::Update из событий, накопленных с прошлого
+     * кадра. Клавиши - битовые множества по коду (скан-коды SDL и коды
+     * GLFW меньше MAX_KEYS), касания - фиксированный массив без
+     * выделений. После публикации снимок не меняется MAX_FRAMES_IN_FLIGHT
+     * кадров, поэтому задания симуляции читают его без блокировок.
+     */
+    struct InputSnapshot {
+        static constexpr int MAX_KEYS = 512;
+        static constexpr int MAX_TOUCHES = 10;
+
+        struct Touch {
+            int id;
+            glm::vec2 position;
+            glm::vec2 delta;       // Смещение за кадр
+            bool down;             // Удерживается в конце кадра
+            bool pressed;          // Нажато в этом кадре
+            bool released;         // Отпущено в этом кадре
+        };
+
+        std::bitset<MAX_KEYS> keysDown;
+        std::bitset<MAX_KEYS> keysPressed;
+        std::bitset<MAX_KEYS> keysReleased;
+
+        // Касания, активные в кадре, и отпущенные в нем же
+        std::array<Touch, MAX_TOUCHES> touches;
+        uint32_t touchCount;
+
+        uint64_t frame;
+        uint32_t eventCount;      // Событий, примененных в этом кадре
+        uint32_t droppedEvents;   // Потеряно из-за переполнения очереди с прошлого кадра
+        uint64_t oldestEventTicks; // 0, если событий не было
+        uint64_t newestEventTicks;
+        uint64_t publishTicks;    // ProfileClock::Now() при публикации
+
+        InputSnapshot()
+            : touchCount(0)
+            , frame(0)
+            , eventCount(0)
+            , droppedEvents(0)
+            , oldestEventTicks(0)
+            , newestEventTicks(0)
+            , publishTicks(0) {
+        }
+
+        static bool IsValidKey(int key) { return key >= 0 && key < MAX_KEYS; }
+
+        bool IsKeyDown(int key) const { return IsValidKey(key) && keysDown.test(key); }
+        bool IsKeyPressed(int key) const { return IsValidKey(key) && keysPressed.test(key); }
+        bool IsKeyReleased(int key) const { return IsValidKey(key) && keysReleased.test(key); }
+
+        // nullptr, если касания с таким id в кадре нет
+        const Touch* FindTouch(int id) const {
+            for (uint32_t i = 0; i < touchCount; ++i) {
+                if (touches[i].id == id) {
+                    return &touches[i];
+                }
+            }
+            return nullptr;
+        }
+        Touch* FindTouch(int id) {
+            return const_cast<Touch*>(static_cast<const InputSnapshot*>(this)->FindTouch(id));
+        }
+    };
+}
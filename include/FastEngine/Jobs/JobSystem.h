@@ -0,0 +1,285 @@
+#pragma once
+
+#include "FastEngine/Profiling/ScopeProfiler.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace FastEngine {
+
+class JobCounter;
+class JobSystem;
+
+/**
+ * Задание планировщика
+ *
+ * Вызываемый объект до STORAGE_SIZE байт хранится внутри задания,
+ * крупнее - в куче. Задания берутся из кольца потока, который их
+ * планирует; прикладной код работает с ними только через
+ * JobSystem::Schedule.
+ */
+struct alignas(64) Job {
+    static constexpr size_t STORAGE_SIZE = 64;
+
+    using Function = void (*)(Job& job);
+
+    Function function;   // Вызывает и уничтожает объект из storage
+    JobCounter* counter; // Уменьшается после выполнения
+    Job* nextWaiter;     // Список заданий, ждущих счетчик
+    uint64_t flowId;     // Связь планирования и выполнения в трассе
+    ProfileNameId name;
+    bool heap;           // Выделено в куче, а не в кольце потока
+    std::atomic<bool> inUse;
+    alignas(16) unsigned char storage[STORAGE_SIZE];
+
+    Job() : function(nullptr), counter(nullptr), nextWaiter(nullptr), flowId(0), name(0), heap(false), inUse(false) {}
+};
+
+/**
+ * Счетчик незавершенных заданий
+ *
+ * Schedule увеличивает счетчик, завершение задания уменьшает его.
+ * Задание, запланированное с зависимостью от счетчика, попадает в
+ * очередь, когда счетчик станет нулевым; так из счетчиков строится граф
+ * заданий без волокон. Счетчик можно переиспользовать после Wait.
+ */
+class JobCounter {
+public:
+    JobCounter() : m_value(0), m_waiters(nullptr) {}
+    // Ждет, пока последнее задание отпустит счетчик
+    ~JobCounter() { std::lock_guard<std::mutex> lock(m_mutex); }
+
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool IsDone() const { return m_value.load(std::memory_order_acquire) == 0; }
+    uint32_t GetValue() const { return m_value.load(std::memory_order_acquire); }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<uint32_t> m_value;
+    std::mutex m_mutex; // Список ожидающих и переход в ноль
+    Job* m_waiters;
+};
+
+/**
+ * Статистика планировщика с момента Start
+ */
+struct JobSystemStats {
+    uint64_t executed;  // Выполнено заданий
+    uint64_t stolen;    // Из них украдено у других потоков
+    uint64_t injected;  // Запланировано из потоков без своего дека
+    uint64_t heapJobs;  // Заданий, не поместившихся в кольцо потока
+    uint32_t workers;
+
+    JobSystemStats() : executed(0), stolen(0), injected(0), heapJobs(0), workers(0) {}
+};
+
+/**
+ * Общий планировщик заданий движка
+ *
+ * Фиксированный пул рабочих потоков (по умолчанию ядра минус один) и
+ * дек Chase-Lev у каждого из них и у потока, вызвавшего Start (индекс
+ * 0, обычно главный). Поток выполняет свои задания в порядке LIFO и
+ * крадет чужие с другого конца; задания из прочих потоков попадают в
+ * общую очередь под мьютексом. Wait и ParallelFor не блокируют поток, а
+ * выполняют чужие задания, пока счетчик не обнулится.
+ *
+ * Каждое задание - область профилировщика с именем задания (или
+ * "Job"), при записи трассы - еще и поток событий от Schedule до
+ * выполнения. Пока планировщик не запущен, задания выполняются сразу в
+ * вызывающем потоке, поэтому системы могут пользоваться им без Engine.
+ *
+ * Задания не должны бросать исключения (исключение сообщается и
+ * подавляется) и не должны блокироваться надолго: ввод-вывод с
+ * ожиданием - в отдельных потоках. Память FrameArena, полученная в
+ * задании на рабочем потоке, действительна только до конца задания.
+ */
+class JobSystem {
+public:
+    static constexpr size_t DEQUE_CAPACITY = 4096;
+    static constexpr size_t JOB_RING_SIZE = 1024;
+    static constexpr uint32_t NO_THREAD = 0xFFFFFFFFu;
+
+    static JobSystem& GetInstance();
+
+    // workerCount - рабочие потоки; 0 - по числу ядер минус один.
+    // false, если уже запущен
+    bool Start(uint32_t workerCount = 0);
+    // Дожидается всех заданий и останавливает рабочие потоки. Schedule
+    // не должен вызываться одновременно со Stop
+    void Stop();
+    bool IsRunning() const { return m_running.load(std::memory_order_acquire); }
+
+    uint32_t GetWorkerCount() const { return static_cast<uint32_t>(m_workers.size()); }
+    // Потоки с собственным деком: рабочие и поток Start
+    uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_threads.size()); }
+    // 0 - поток Start, 1..N - рабочие, NO_THREAD - прочие
+    static uint32_t GetThreadIndex();
+
+    JobSystemStats GetStats() const;
+    // Запланированные, но не завершенные задания
+    uint32_t GetPendingCount() const { return m_pending.load(std::memory_order_relaxed); }
+
+    /**
+     * Планирует function(); counter - увеличивается сейчас и уменьшается
+     * после выполнения, dependency - задание ждет его обнуления
+     */
+    template<typename F>
+    void Schedule(F&& function, JobCounter* counter = nullptr, JobCounter* dependency = nullptr,
+                  ProfileNameId name = 0) {
+        using Callable = typename std::decay<F>::type;
+        if (!IsRunning()) {
+            // Зависимость без запущенного планировщика всегда выполнена
+            std::forward<F>(function)();
+            return;
+        }
+        Job* job = AllocateJob();
+        if constexpr (sizeof(Callable) <= Job::STORAGE_SIZE && alignof(Callable) <= 16) {
+            new (job->storage) Callable(std::forward<F>(function));
+            job->function = &InvokeStored<Callable>;
+        } else {
+            *reinterpret_cast<Callable**>(job->storage) = new Callable(std::forward<F>(function));
+            job->function = &InvokeHeap<Callable>;
+        }
+        Enqueue(job, counter, dependency, name);
+    }
+
+    // Выполняет задания, пока counter не обнулится
+    void Wait(JobCounter& counter);
+
+    /**
+     * body(first, last) для частей [begin, end); возвращается после
+     * обработки всего диапазона
+     *
+     * Ленивое бинарное деление: поток обрабатывает диапазон порциями и
+     * отдает вторую половину остатка в дек, только когда его дек пуст
+     * (предыдущую половину украли). Так число заданий подстраивается под
+     * свободные потоки, а не под размер диапазона. minChunk - нижняя
+     * граница порции для дешевых итераций.
+     */
+    template<typename F>
+    void ParallelForRange(size_t begin, size_t end, const F& body, size_t minChunk = 1, ProfileNameId name = 0) {
+        if (begin >= end) {
+            return;
+        }
+        const size_t count = end - begin;
+        minChunk = std::max<size_t>(minChunk, 1);
+        if (!IsRunning() || m_workers.empty() || count <= minChunk) {
+            body(begin, end);
+            return;
+        }
+
+        // Около 16 порций на поток: достаточно для баланса, мало проверок
+        JobCounter counter;
+        RangeContext<F> context{&body, &counter, name,
+                                std::max(minChunk, count / (static_cast<size_t>(GetThreadCount()) * 16))};
+        RunRange(context, begin, end);
+        Wait(counter);
+    }
+
+    // body(index) для каждого индекса [begin, end)
+    template<typename F>
+    void ParallelFor(size_t begin, size_t end, const F& body, size_t minChunk = 1, ProfileNameId name = 0) {
+        ParallelForRange(begin, end, [&body](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                body(i);
+            }
+        }, minChunk, name);
+    }
+
+private:
+    struct ThreadState;
+
+    template<typename F>
+    struct RangeContext {
+        const F* body;
+        JobCounter* counter;
+        ProfileNameId name;
+        size_t chunk;
+    };
+
+    JobSystem();
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    std::atomic<bool> m_running;
+    std::thread::id m_ownerThread;
+    std::vector<std::unique_ptr<ThreadState>> m_threads; // [0] - поток Start
+    std::vector<std::thread> m_workers;
+
+    // Задания из потоков без дека
+    std::mutex m_injectMutex;
+    std::deque<Job*> m_injected;
+    std::atomic<size_t> m_injectedCount;
+    std::atomic<uint64_t> m_injectedTotal;
+
+    // Сон рабочих: эпоха растет при каждой постановке в очередь
+    std::mutex m_sleepMutex;
+    std::condition_variable m_sleepCondition;
+    std::atomic<uint64_t> m_epoch;
+    std::atomic<uint32_t> m_sleeping;
+    bool m_stopWorkers;
+
+    std::atomic<uint32_t> m_pending;
+    std::atomic<uint64_t> m_foreignExecuted; // Выполнено потоками без дека
+    std::atomic<uint64_t> m_heapJobs;
+    std::atomic<uint64_t> m_nextFlowId;
+
+    Job* AllocateJob();
+    void ReleaseJob(Job* job);
+    void Enqueue(Job* job, JobCounter* counter, JobCounter* dependency, ProfileNameId name);
+    void Submit(Job* job);
+    void Execute(Job* job, bool stolen);
+    void Finish(JobCounter* counter);
+    Job* FindJob(bool& stolen);
+    bool IsLocalQueueEmpty() const;
+    void WorkerThreadFunction(uint32_t index);
+
+    template<typename C>
+    static void InvokeStored(Job& job) {
+        C* callable = reinterpret_cast<C*>(job.storage);
+        struct Destroy {
+            C* callable;
+            ~Destroy() { callable->~C(); }
+        } destroy{callable};
+        (*callable)();
+    }
+
+    template<typename C>
+    static void InvokeHeap(Job& job) {
+        std::unique_ptr<C> callable(*reinterpret_cast<C**>(job.storage));
+        (*callable)();
+    }
+
+    template<typename F>
+    void RunRange(const RangeContext<F>& context, size_t begin, size_t end) {
+        while (begin < end) {
+            if (end - begin > context.chunk * 2 && IsLocalQueueEmpty()) {
+                size_t middle = begin + (end - begin) / 2;
+                Schedule([this, &context, middle, end]() { RunRange(context, middle, end); },
+                         context.counter, nullptr, context.name);
+                end = middle;
+                continue;
+            }
+            size_t last = std::min(end, begin + context.chunk);
+            (*context.body)(begin, last);
+            begin = last;
+        }
+    }
+};
+
+} // namespace FastEngine
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace FastEngine {
+
+/**
+ * Дек Chase-Lev для кражи работы
+ *
+ * Push и Pop вызывает только поток-владелец (работа с нижним концом,
+ * порядок LIFO), Steal - любые потоки (верхний конец, FIFO). Емкость
+ * фиксирована и округляется вверх до степени двойки: при переполнении
+ * Push возвращает false, и задание уходит в общую очередь. Без
+ * перевыделения буфера не нужно и отложенное освобождение старых
+ * массивов. T - указатель или другой тривиально копируемый тип.
+ *
+ * Порядок памяти - по Le, Pop, Cohen, Zappa Nardelli (PPoPP 2013), но
+ * вместо отдельных барьеров используются seq_cst-операции над
+ * индексами: на x86 это те же инструкции, а ThreadSanitizer понимает
+ * такую синхронизацию.
+ */
+template<typename T>
+class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(size_t capacity = 4096)
+        : m_top(0)
+        , m_bottom(0) {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        m_buffer.reset(new std::atomic<T>[size]);
+        m_capacity = size;
+        m_mask = size - 1;
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // Поток-владелец; false, если дек полон
+    bool Push(T value) {
+        int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        int64_t top = m_top.load(std::memory_order_acquire);
+        if (bottom - top >= static_cast<int64_t>(m_capacity)) {
+            return false;
+        }
+        m_buffer[bottom & m_mask].store(value, std::memory_order_relaxed);
+        m_bottom.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Поток-владелец; последний элемент разыгрывается с ворами через CAS
+    bool Pop(T& value) {
+        int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        m_bottom.store(bottom, std::memory_order_seq_cst);
+        int64_t top = m_top.load(std::memory_order_seq_cst);
+        if (top > bottom) {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+        value = m_buffer[bottom & m_mask].load(std::memory_order_relaxed);
+        if (top == bottom) {
+            bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                     std::memory_order_relaxed);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // Любой поток; false, если дек пуст или элемент забрал другой поток
+    bool Steal(T& value) {
+        int64_t top = m_top.load(std::memory_order_seq_cst);
+        int64_t bottom = m_bottom.load(std::memory_order_seq_cst);
+        if (top >= bottom) {
+            return false;
+        }
+        // Слот может быть перезаписан владельцем только после сдвига top,
+        // тогда CAS ниже не пройдет
+        T candidate = m_buffer[top & m_mask].load(std::memory_order_relaxed);
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                           std::memory_order_relaxed)) {
+            return false;
+        }
+        value = candidate;
+        return true;
+    }
+
+    size_t GetCapacity() const { return m_capacity; }
+
+    // Приблизительный размер; точен только для владельца без воров
+    size_t GetSize() const {
+        int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        int64_t top = m_top.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+    }
+    bool IsEmpty() const { return GetSize() == 0; }
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    std::unique_ptr<std::atomic<T>[]> m_buffer;
+    size_t m_capacity;
+    size_t m_mask;
+
+    // Воры двигают top, владелец - bottom
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> m_top;
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> m_bottom;
+};
+
+} // namespace FastEngine
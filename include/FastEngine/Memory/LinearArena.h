@@ -0,0 +1,210 @@
+#pragma once
+
+#include "FastEngine/Memory/MemoryDebug.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace FastEngine {
+
+/**
+ * Линейная арена: выделение - сдвиг указателя, освобождение - сброс
+ * целиком или откат к отметке
+ *
+ * Память берется блоками по chunkSize (запросы крупнее получают свой
+ * блок). Если за цикл понадобилось несколько блоков, Reset заменяет их
+ * одним общим, чтобы следующий цикл уложился в один блок. Деструкторы
+ * размещенных объектов не вызываются. Не потокобезопасна.
+ */
+class LinearArena {
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+    static constexpr size_t GUARD_SIZE = 16;
+
+    /**
+     * Позиция для Rewind
+     */
+    struct Marker {
+        size_t chunk;
+        size_t offset;
+        size_t base;
+        size_t guards;
+        uint64_t generation;
+    };
+
+    explicit LinearArena(size_t chunkSize = DEFAULT_CHUNK_SIZE, uint32_t debugFlags = MEMORY_DEBUG_DEFAULT);
+    ~LinearArena();
+
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+
+    // nullptr при нехватке памяти; alignment - степень двойки
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    // Возвращает память, только если это последнее выделение
+    void Deallocate(void* pointer, size_t size);
+
+    // Массив без инициализации элементов
+    template<typename T>
+    T* AllocateArray(size_t count) {
+        if (count > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            return nullptr;
+        }
+        return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    template<typename T, typename... Args>
+    T* New(Args&&... args) {
+        void* memory = Allocate(sizeof(T), alignof(T));
+        return memory ? new (memory) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    Marker GetMarker() const;
+    // Освобождает все выделения после отметки текущего цикла
+    void Rewind(const Marker& marker);
+    // Освобождает все; указатели прошлого цикла становятся недействительными
+    void Reset();
+
+    // Указатель внутри занятой части текущего цикла
+    bool Owns(const void* pointer) const;
+
+    // Проверка защитных байтов; false и сообщение при перезаписи
+    bool CheckGuards();
+
+    size_t GetUsed() const { return m_base + m_offset; } // С учетом выравнивания и пропущенных хвостов блоков
+    size_t GetPeakUsed() const { return m_peak; }
+    size_t GetCapacity() const;
+    size_t GetChunkCount() const { return m_chunks.size(); }
+    size_t GetAllocationCount() const { return m_allocations; } // С последнего сброса
+    uint64_t GetGeneration() const { return m_generation; }     // Растет при каждом Reset
+    size_t GetOverrunCount() const { return m_overruns; }
+
+    void SetDebugFlags(uint32_t flags) { m_debugFlags = flags; }
+    uint32_t GetDebugFlags() const { return m_debugFlags; }
+
+private:
+    struct Chunk {
+        uint8_t* data;
+        size_t size;
+        uint8_t tag; // Тег MemoryTracker
+    };
+
+    std::vector<Chunk> m_chunks;
+    size_t m_current;
+    size_t m_offset;
+    size_t m_base; // Размер блоков до текущего
+    size_t m_peak;
+    size_t m_allocations;
+    uint64_t m_generation;
+    size_t m_chunkSize;
+    uint32_t m_debugFlags;
+
+    // Начала защитных зон в порядке выделения
+    std::vector<uint8_t*> m_guards;
+    size_t m_overruns;
+
+    bool AddChunk(size_t size);
+    void FreeChunks();
+    bool CheckGuardsFrom(size_t first);
+    void PoisonFrom(size_t chunk, size_t offset);
+};
+
+/**
+ * Откатывает арену к состоянию на входе в блок
+ */
+class ArenaScope {
+public:
+    explicit ArenaScope(LinearArena& arena) : m_arena(arena), m_marker(arena.GetMarker()) {}
+    ~ArenaScope() { m_arena.Rewind(m_marker); }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+    LinearArena& GetArena() { return m_arena; }
+
+private:
+    LinearArena& m_arena;
+    LinearArena::Marker m_marker;
+};
+
+/**
+ * Память на один кадр
+ *
+ * У каждого потока своя арена и свои границы кадров: арену сбрасывает
+ * только BeginFrame, вызванный в этом же потоке. Его вызывает цикл,
+ * которому принадлежит поток, в начале своего тика (FixedTickLoop::Step,
+ * Engine::Update), а рабочий поток JobSystem - после каждого задания.
+ * Поэтому тик одного цикла не сбрасывает арену другого, а Get внутри
+ * тика никогда не сбрасывает память, полученную раньше в этом же тике.
+ * Память действительна до следующего BeginFrame своего потока (в
+ * задании - до конца задания); ссылку на арену не следует хранить
+ * между кадрами и передавать в другие потоки.
+ */
+class FrameArena {
+public:
+    static LinearArena& Get();
+    static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        return Get().Allocate(size, alignment);
+    }
+
+    // Начало кадра потока: сброс его арены
+    static void BeginFrame();
+    // Число BeginFrame в текущем потоке
+    static uint64_t GetFrameIndex();
+
+    // Параметры арен, создаваемых после вызова
+    static void SetDefaults(size_t chunkSize, uint32_t debugFlags);
+};
+
+/**
+ * Аллокатор STL поверх линейной арены
+ *
+ * По умолчанию - арена кадра текущего потока. deallocate возвращает
+ * память только для последнего выделения: при росте вектора старые
+ * буферы остаются до сброса арены, поэтому размер лучше резервировать.
+ */
+template<typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    ArenaAllocator() noexcept : m_arena(&FrameArena::Get()) {}
+    explicit ArenaAllocator(LinearArena& arena) noexcept : m_arena(&arena) {}
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_arena(other.GetArena()) {}
+
+    T* allocate(size_t count) {
+        T* memory = m_arena->AllocateArray<T>(count);
+        if (!memory) {
+            throw std::bad_alloc();
+        }
+        return memory;
+    }
+
+    void deallocate(T* pointer, size_t count) noexcept {
+        m_arena->Deallocate(pointer, count * sizeof(T));
+    }
+
+    LinearArena* GetArena() const noexcept { return m_arena; }
+
+private:
+    LinearArena* m_arena;
+};
+
+template<typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept {
+    return a.GetArena() == b.GetArena();
+}
+
+template<typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept {
+    return a.GetArena() != b.GetArena();
+}
+
+// Временный вектор кадра
+template<typename T>
+using FrameVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace FastEngine
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SANITIZE_ADDRESS__)
+#define FASTENGINE_MEMORY_ASAN 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define FASTENGINE_MEMORY_ASAN 1
+#endif
+#endif
+
+#if defined(FASTENGINE_MEMORY_ASAN)
+#include <sanitizer/asan_interface.h>
+#endif
+
+namespace FastEngine {
+
+/**
+ * Отладочные проверки арен и пулов
+ */
+enum MemoryDebugFlags : uint32_t {
+    MEMORY_DEBUG_NONE = 0,
+    // Защитные байты после каждого выделения; проверяются при сбросе
+    MEMORY_DEBUG_GUARDS = 1 << 0,
+    // Освобожденная память заполняется POISON_BYTE, под ASan - отравляется;
+    // повторное освобождение блока пула обнаруживается
+    MEMORY_DEBUG_POISON = 1 << 1,
+    MEMORY_DEBUG_ALL = MEMORY_DEBUG_GUARDS | MEMORY_DEBUG_POISON
+};
+
+// Сборка с FASTENGINE_MEMORY_DEBUG включает проверки по умолчанию
+#if defined(FASTENGINE_MEMORY_DEBUG)
+constexpr uint32_t MEMORY_DEBUG_DEFAULT = MEMORY_DEBUG_ALL;
+#else
+constexpr uint32_t MEMORY_DEBUG_DEFAULT = MEMORY_DEBUG_NONE;
+#endif
+
+constexpr uint8_t MEMORY_GUARD_BYTE = 0xFD;  // За концом выделения
+constexpr uint8_t MEMORY_POISON_BYTE = 0xDD; // Освобожденная память
+constexpr uint8_t MEMORY_FRESH_BYTE = 0xCD;  // Выделенная, но не записанная
+
+// Заполняет освобожденную область; чтение под ASan становится ошибкой.
+// Область может уже быть частично отравлена (отступы выравнивания)
+inline void PoisonMemory(void* pointer, size_t size) {
+#if defined(FASTENGINE_MEMORY_ASAN)
+    ASAN_UNPOISON_MEMORY_REGION(pointer, size);
+#endif
+    std::memset(pointer, MEMORY_POISON_BYTE, size);
+#if defined(FASTENGINE_MEMORY_ASAN)
+    ASAN_POISON_MEMORY_REGION(pointer, size);
+#endif
+}
+
+// Снимает отравление перед повторной выдачей или освобождением
+inline void UnpoisonMemory(void* pointer, size_t size) {
+#if defined(FASTENGINE_MEMORY_ASAN)
+    ASAN_UNPOISON_MEMORY_REGION(pointer, size);
+#else
+    (void)pointer;
+    (void)size;
+#endif
+}
+
+inline size_t AlignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace FastEngine
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "FastEngine/Memory/LinearArena.h"
+#include "FastEngine/Memory/PoolAllocator.h"
+
+// std::pmr есть не во всех стандартных библиотеках целевых платформ
+// (libc++ до iOS 17 / macOS 14); без него адаптеры не объявляются,
+// а ArenaAllocator работает как обычный аллокатор STL
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+
+#if defined(__cpp_lib_memory_resource)
+#define FASTENGINE_HAS_PMR 1
+
+namespace FastEngine {
+
+/**
+ * memory_resource поверх линейной арены; освобождение - как у
+ * ArenaAllocator, только для последнего выделения
+ */
+class ArenaResource : public std::pmr::memory_resource {
+public:
+    explicit ArenaResource(LinearArena& arena) : m_arena(arena) {}
+
+    LinearArena& GetArena() { return m_arena; }
+
+private:
+    LinearArena& m_arena;
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* memory = m_arena.Allocate(bytes, alignment);
+        if (!memory) {
+            throw std::bad_alloc();
+        }
+        return memory;
+    }
+
+    void do_deallocate(void* pointer, size_t bytes, size_t) override {
+        m_arena.Deallocate(pointer, bytes);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        const ArenaResource* arena = dynamic_cast<const ArenaResource*>(&other);
+        return arena && &arena->m_arena == &m_arena;
+    }
+};
+
+/**
+ * memory_resource поверх SizeClassAllocator; выравнивание больше 16
+ * байт - через глобальный operator new
+ */
+class SizeClassResource : public std::pmr::memory_resource {
+public:
+    explicit SizeClassResource(SizeClassAllocator& allocator = SizeClassAllocator::GetShared())
+        : m_allocator(allocator) {}
+
+private:
+    SizeClassAllocator& m_allocator;
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* memory = alignment <= SizeClassAllocator::GRANULARITY
+            ? m_allocator.Allocate(bytes)
+            : ::operator new(bytes, std::align_val_t(alignment), std::nothrow);
+        if (!memory) {
+            throw std::bad_alloc();
+        }
+        return memory;
+    }
+
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override {
+        if (alignment <= SizeClassAllocator::GRANULARITY) {
+            m_allocator.Free(pointer, bytes);
+        } else {
+            ::operator delete(pointer, std::align_val_t(alignment));
+        }
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        const SizeClassResource* resource = dynamic_cast<const SizeClassResource*>(&other);
+        return resource && &resource->m_allocator == &m_allocator;
+    }
+};
+
+} // namespace FastEngine
+
+#endif
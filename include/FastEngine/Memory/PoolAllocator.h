@@ -0,0 +1,172 @@
+#pragma once
+
+#include "FastEngine/Memory/MemoryDebug.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace FastEngine {
+
+/**
+ * Пул блоков одного размера
+ *
+ * Блоки нарезаются из слэбов по blocksPerSlab штук; свободные блоки
+ * связаны в список через свои первые байты. Слэбы не возвращаются до
+ * уничтожения пула. С MEMORY_DEBUG_POISON освобожденный блок
+ * заполняется и помечается, повторное освобождение сообщается и
+ * игнорируется. Не потокобезопасен.
+ */
+class PoolAllocator {
+public:
+    static constexpr size_t DEFAULT_BLOCKS_PER_SLAB = 256;
+
+    PoolAllocator(size_t blockSize, size_t alignment = alignof(std::max_align_t),
+                  size_t blocksPerSlab = DEFAULT_BLOCKS_PER_SLAB, uint32_t debugFlags = MEMORY_DEBUG_DEFAULT);
+    ~PoolAllocator();
+
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+    // nullptr при нехватке памяти
+    void* Allocate();
+    void Free(void* pointer);
+
+    bool Owns(const void* pointer) const;
+
+    size_t GetBlockSize() const { return m_blockSize; }
+    size_t GetLiveCount() const { return m_live; }
+    size_t GetCapacity() const { return m_slabs.size() * m_blocksPerSlab; }
+    size_t GetSlabCount() const { return m_slabs.size(); }
+    size_t GetDoubleFreeCount() const { return m_doubleFrees; }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+        uint64_t canary; // Только с MEMORY_DEBUG_POISON
+    };
+
+    struct Slab {
+        uint8_t* data;
+        uint8_t tag; // Тег MemoryTracker
+    };
+
+    size_t m_blockSize;
+    size_t m_alignment;
+    size_t m_blocksPerSlab;
+    uint32_t m_debugFlags;
+    std::vector<Slab> m_slabs;
+    FreeBlock* m_free;
+    size_t m_live;
+    size_t m_doubleFrees;
+
+    bool AddSlab();
+    bool IsOnFreeList(const FreeBlock* block) const;
+};
+
+/**
+ * Пул объектов одного типа
+ */
+template<typename T>
+class ObjectPool {
+public:
+    explicit ObjectPool(size_t blocksPerSlab = PoolAllocator::DEFAULT_BLOCKS_PER_SLAB,
+                        uint32_t debugFlags = MEMORY_DEBUG_DEFAULT)
+        : m_pool(sizeof(T), alignof(T), blocksPerSlab, debugFlags) {}
+
+    // nullptr при нехватке памяти
+    template<typename... Args>
+    T* Create(Args&&... args) {
+        void* memory = m_pool.Allocate();
+        if (!memory) {
+            return nullptr;
+        }
+        try {
+            return new (memory) T(std::forward<Args>(args)...);
+        } catch (...) {
+            m_pool.Free(memory);
+            throw;
+        }
+    }
+
+    void Destroy(T* object) {
+        if (object) {
+            object->~T();
+            m_pool.Free(object);
+        }
+    }
+
+    PoolAllocator& GetPool() { return m_pool; }
+    const PoolAllocator& GetPool() const { return m_pool; }
+
+private:
+    PoolAllocator m_pool;
+};
+
+/**
+ * Пулы по классам размеров с кратностью 16 байт
+ *
+ * Потокобезопасен: у каждого класса свой мьютекс. Запросы больше
+ * MAX_POOLED_SIZE уходят в глобальный operator new. Free принимает тот
+ * же размер, что и Allocate. Через GetShared выделяются сущности и
+ * компоненты.
+ */
+class SizeClassAllocator {
+public:
+    static constexpr size_t GRANULARITY = 16;
+    static constexpr size_t MAX_POOLED_SIZE = 512;
+    static constexpr size_t CLASS_COUNT = MAX_POOLED_SIZE / GRANULARITY;
+
+    explicit SizeClassAllocator(uint32_t debugFlags = MEMORY_DEBUG_DEFAULT);
+    ~SizeClassAllocator();
+
+    SizeClassAllocator(const SizeClassAllocator&) = delete;
+    SizeClassAllocator& operator=(const SizeClassAllocator&) = delete;
+
+    // nullptr при нехватке памяти
+    void* Allocate(size_t size);
+    void Free(void* pointer, size_t size);
+
+    size_t GetLiveCount() const;
+
+    // Общий экземпляр; не уничтожается до конца процесса
+    static SizeClassAllocator& GetShared();
+
+private:
+    struct SizeClass {
+        mutable std::mutex mutex;
+        std::unique_ptr<PoolAllocator> pool; // Создается при первом запросе
+    };
+
+    SizeClass m_classes[CLASS_COUNT];
+    uint32_t m_debugFlags;
+};
+
+} // namespace FastEngine
+
+// Выделение объектов класса через SizeClassAllocator::GetShared; для
+// выравнивания больше 16 байт - глобальный operator new
+#define FASTENGINE_POOLED_ALLOCATION \
+    static void* operator new(std::size_t size) { \
+        void* memory = ::FastEngine::SizeClassAllocator::GetShared().Allocate(size); \
+        if (!memory) { \
+            throw std::bad_alloc(); \
+        } \
+        return memory; \
+    } \
+    static void operator delete(void* pointer, std::size_t size) noexcept { \
+        ::FastEngine::SizeClassAllocator::GetShared().Free(pointer, size); \
+    } \
+    static void* operator new(std::size_t size, std::align_val_t alignment) { \
+        return ::operator new(size, alignment); \
+    } \
+    static void operator delete(void* pointer, std::size_t size, std::align_val_t alignment) noexcept { \
+        ::operator delete(pointer, size, alignment); \
+    } \
+    static void* operator new(std::size_t, void* place) noexcept { \
+        return place; \
+    } \
+    static void operator delete(void*, void*) noexcept {}
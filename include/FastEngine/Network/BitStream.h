@@ -0,0 +1,226 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace FastEngine {
+
+/**
+ * Квантование числа с плавающей точкой
+ *
+ * Значение из [min, max] переводится в целое с шагом precision; число бит
+ * вычисляется по диапазону. Значения вне диапазона прижимаются к границам.
+ */
+struct FloatQuantization {
+    float min;
+    float max;
+    float precision;
+    uint32_t bits;
+
+    FloatQuantization() : min(0.0f), max(1.0f), precision(1.0f), bits(1) {}
+    FloatQuantization(float minValue, float maxValue, float step);
+
+    uint32_t Quantize(float value) const;
+    float Dequantize(uint32_t value) const;
+    // Наибольший код, допустимый в диапазоне
+    uint32_t GetMaxCode() const { return m_maxCode; }
+
+private:
+    uint32_t m_maxCode;
+};
+
+/**
+ * Запись битового потока в буфер вызывающего
+ *
+ * Биты копятся в 64-битном накопителе и сбрасываются в буфер словами,
+ * поэтому перед отправкой данных нужен Flush. Не выделяет память: при
+ * нехватке места выставляется флаг переполнения, дальнейшие записи
+ * игнорируются. Буфер можно переиспользовать через Reset.
+ */
+class BitWriter {
+public:
+    BitWriter(uint8_t* buffer, uint32_t capacity) { Reset(buffer, capacity); }
+
+    void Reset(uint8_t* buffer, uint32_t capacity) {
+        m_buffer = buffer;
+        m_capacity = capacity;
+        m_size = 0;
+        m_scratch = 0;
+        m_scratchBits = 0;
+        m_overflow = false;
+    }
+    void Reset() { Reset(m_buffer, m_capacity); }
+
+    // value - младшие bits бит (bits <= 32)
+    void WriteBits(uint32_t value, uint32_t bits) {
+        if (bits < 32) {
+            value &= (1u << bits) - 1u;
+        }
+        m_scratch |= static_cast<uint64_t>(value) << m_scratchBits;
+        m_scratchBits += bits;
+        if (m_scratchBits >= 32) {
+            // Сброс словом: байты младшими вперед независимо от платформы
+            if (m_size + 4 <= m_capacity) {
+                uint32_t word = static_cast<uint32_t>(m_scratch);
+                m_buffer[m_size] = static_cast<uint8_t>(word);
+                m_buffer[m_size + 1] = static_cast<uint8_t>(word >> 8);
+                m_buffer[m_size + 2] = static_cast<uint8_t>(word >> 16);
+                m_buffer[m_size + 3] = static_cast<uint8_t>(word >> 24);
+                m_size += 4;
+                m_scratch >>= 32;
+                m_scratchBits -= 32;
+            } else {
+                FlushBytes();
+            }
+        }
+    }
+
+    void WriteBool(bool value) { WriteBits(value ? 1u : 0u, 1); }
+    void WriteVarUint(uint64_t value);
+    void WriteVarInt(int64_t value) {
+        WriteVarUint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+    void WriteFloat(float value);
+    void WriteQuantized(float value, const FloatQuantization& quantization) {
+        WriteBits(quantization.Quantize(value), quantization.bits);
+    }
+    void WriteQuantized(const glm::vec3& value, const FloatQuantization& quantization) {
+        WriteQuantized(value.x, quantization);
+        WriteQuantized(value.y, quantization);
+        WriteQuantized(value.z, quantization);
+    }
+    // Длина (varint) и байты
+    void WriteBytes(const void* data, uint32_t size);
+    void WriteString(const std::string& value) { WriteBytes(value.data(), static_cast<uint32_t>(value.size())); }
+
+    // Дописывает неполный байт; размер данных после этого - GetBytesWritten
+    void Flush();
+
+    uint32_t GetBytesWritten() const { return m_size + (m_scratchBits + 7) / 8; }
+    uint32_t GetBitsWritten() const { return m_size * 8 + m_scratchBits; }
+    const uint8_t* GetData() const { return m_buffer; }
+    bool IsOverflow() const { return m_overflow; }
+
+private:
+    uint8_t* m_buffer;
+    uint32_t m_capacity;
+    uint32_t m_size;
+    uint64_t m_scratch;
+    uint32_t m_scratchBits; // < 32 между вызовами
+    bool m_overflow;
+
+    // Сброс целых байт накопителя в буфер
+    void FlushBytes();
+};
+
+/**
+ * Подсчет размера записи без самой записи
+ *
+ * Интерфейс записи совпадает с BitWriter, поэтому шаблонные функции
+ * сериализации могут заранее узнать размер записи.
+ */
+class BitCounter {
+public:
+    BitCounter() : m_bits(0) {}
+
+    void WriteBits(uint32_t, uint32_t bits) { m_bits += bits; }
+    void WriteBool(bool) { ++m_bits; }
+    void WriteVarUint(uint64_t value) {
+        do {
+            m_bits += 8;
+            value >>= 7;
+        } while (value != 0);
+    }
+    void WriteVarInt(int64_t value) {
+        WriteVarUint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+    void WriteFloat(float) { m_bits += 32; }
+    void WriteBytes(const void*, uint32_t size) {
+        WriteVarUint(size);
+        m_bits += size * 8;
+    }
+    void WriteString(const std::string& value) { WriteBytes(value.data(), static_cast<uint32_t>(value.size())); }
+
+    uint32_t GetBitsWritten() const { return m_bits; }
+
+private:
+    uint32_t m_bits;
+};
+
+/**
+ * Чтение битового потока с проверкой границ
+ *
+ * Чтение за концом данных возвращает false и выставляет флаг ошибки;
+ * после ошибки все чтения неуспешны.
+ */
+class BitReader {
+public:
+    BitReader(const uint8_t* data, uint32_t size)
+        : m_data(data), m_size(size), m_position(0), m_scratch(0), m_scratchBits(0), m_error(false) {}
+
+    bool ReadBits(uint32_t bits, uint32_t& value) {
+        while (m_scratchBits < bits) {
+            if (m_position >= m_size) {
+                m_error = true;
+            }
+            if (m_error) {
+                value = 0;
+                return false;
+            }
+            m_scratch |= static_cast<uint64_t>(m_data[m_position++]) << m_scratchBits;
+            m_scratchBits += 8;
+        }
+        value = static_cast<uint32_t>(bits < 32 ? m_scratch & ((1ull << bits) - 1ull) : m_scratch);
+        m_scratch >>= bits;
+        m_scratchBits -= bits;
+        return !m_error;
+    }
+
+    bool ReadBool(bool& value) {
+        uint32_t bit = 0;
+        bool result = ReadBits(1, bit);
+        value = bit != 0;
+        return result;
+    }
+    bool ReadVarUint(uint64_t& value);
+    bool ReadVarUint(uint32_t& value);
+    bool ReadVarInt(int64_t& value) {
+        uint64_t encoded = 0;
+        bool result = ReadVarUint(encoded);
+        value = static_cast<int64_t>(encoded >> 1) ^ -static_cast<int64_t>(encoded & 1);
+        return result;
+    }
+    bool ReadFloat(float& value);
+    bool ReadQuantized(const FloatQuantization& quantization, float& value) {
+        uint32_t code = 0;
+        if (!ReadBits(quantization.bits, code) || code > quantization.GetMaxCode()) {
+            m_error = true;
+            return false;
+        }
+        value = quantization.Dequantize(code);
+        return true;
+    }
+    bool ReadQuantized(const FloatQuantization& quantization, glm::vec3& value) {
+        return ReadQuantized(quantization, value.x) && ReadQuantized(quantization, value.y) &&
+               ReadQuantized(quantization, value.z);
+    }
+    // Строка, записанная WriteString; длиннее maxSize - ошибка.
+    // Переиспользует емкость value
+    bool ReadString(std::string& value, uint32_t maxSize = 0xFFFF);
+    // Байты, записанные WriteBytes, в буфер вызывающего
+    bool ReadBytes(uint8_t* data, uint32_t capacity, uint32_t& size);
+
+    uint32_t GetBitsRemaining() const { return (m_size - m_position) * 8 + m_scratchBits; }
+    bool IsError() const { return m_error; }
+
+private:
+    const uint8_t* m_data;
+    uint32_t m_size;
+    uint32_t m_position;
+    uint64_t m_scratch;
+    uint32_t m_scratchBits;
+    bool m_error;
+};
+
+} // namespace FastEngine
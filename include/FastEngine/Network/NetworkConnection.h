@@ -0,0 +1,186 @@
+#pragma once
+
+#include "FastEngine/Network/NetworkTransport.h"
+#include <deque>
+#include <vector>
+#include <cstdint>
+
+namespace FastEngine {
+
+/**
+ * Канал доставки сообщений
+ */
+enum class NetworkChannel : uint8_t {
+    Unreliable,         // Без повторов и порядка
+    ReliableOrdered,    // С повторами, в порядке отправки
+    ReliableUnordered   // С повторами, в порядке прихода
+};
+
+constexpr int NETWORK_CHANNEL_COUNT = 3;
+
+/**
+ * Статистика соединения
+ */
+struct NetworkConnectionStats {
+    float roundTripTime;     // Сглаженное RTT, мс
+    uint32_t rttSamples;
+    uint32_t packetsSent;
+    uint32_t packetsReceived;
+    uint32_t packetsAcked;
+    uint32_t packetsLost;
+    uint32_t packetsRefused; // Не приняты из-за нехватки буферов пула
+    uint64_t bytesSent;
+    uint64_t bytesReceived;
+
+    NetworkConnectionStats()
+        : roundTripTime(0.0f), rttSamples(0), packetsSent(0), packetsReceived(0)
+        , packetsAcked(0), packetsLost(0), packetsRefused(0), bytesSent(0), bytesReceived(0) {}
+};
+
+// Доставка сообщения получателю: буфер пула (сообщение в data[0..size))
+// переходит получателю, и тот сам возвращает его в пул
+using NetworkDeliverFunc = void (*)(void* userData, NetworkPacket* payload);
+
+/**
+ * Соединение с удаленным узлом поверх датаграмм
+ *
+ * Каждый пакет несет номер, номер последнего принятого пакета и битовое
+ * поле подтверждений 32 предыдущих. По подтверждениям считаются RTT и
+ * потери: пакет, выпавший из окна подтверждений или не подтвержденный
+ * за несколько RTT, считается потерянным.
+ * Надежные сообщения хранятся в буферах пула до подтверждения любого
+ * пакета, который их нес, и повторяются по таймауту от RTT. Упорядоченный
+ * канал придерживает сообщения, пришедшие раньше пропущенных.
+ * Входящий пакет подтверждается, только если всем его новым сообщениям
+ * хватило буферов пула; иначе он отбрасывается целиком и отправитель
+ * повторит надежные сообщения, так что доставленное подтверждением не
+ * теряется.
+ * Пакеты только с подтверждениями не требуют ответа, поэтому узлы не
+ * обмениваются ими бесконечно; при долгом молчании отправляется
+ * keep-alive.
+ *
+ * Не потокобезопасно: используется только сетевым потоком.
+ */
+class NetworkConnection {
+public:
+    NetworkConnection(const NetworkAddress& address, PacketPool& pool);
+    ~NetworkConnection();
+
+    NetworkConnection(const NetworkConnection&) = delete;
+    NetworkConnection& operator=(const NetworkConnection&) = delete;
+
+    const NetworkAddress& GetAddress() const { return m_address; }
+    const NetworkConnectionStats& GetStats() const { return m_stats; }
+    double GetLastReceiveTime() const { return m_lastReceiveTime; }
+
+    // Постановка сообщения в очередь. Соединение забирает буфер пула
+    // (payload в data[0..size)) и вернет его в пул само; false - очередь
+    // надежных сообщений переполнена, буфер возвращен в пул
+    bool QueueMessage(NetworkChannel channel, NetworkPacket* payload);
+
+    // Сборка исходящих пакетов в переданные буферы; число заполненных.
+    // time - монотонное время в секундах
+    int WritePackets(double time, NetworkPacket* const* packets, int maxPackets);
+
+    // Разбор входящего пакета; false - пакет поврежден или чужой.
+    // Пакет без буферов для сообщений не подтверждается (packetsRefused)
+    bool ReadPacket(const NetworkPacket& packet, double time, NetworkDeliverFunc deliver, void* userData);
+
+    // Максимальный размер сообщения, помещающегося в один пакет
+    static constexpr uint32_t MAX_MESSAGE_SIZE = MAX_PACKET_SIZE - 11 - 5;
+    static constexpr uint16_t PROTOCOL_ID = 0x4645;
+    // Надежных сообщений в очереди соединения (оба канала). Каждое держит
+    // буфер пула, поэтому предел должен быть заметно меньше пула
+    static constexpr size_t MAX_PENDING_RELIABLE = 1024;
+
+private:
+    static constexpr uint32_t SENT_PACKET_WINDOW = 256;
+    static constexpr uint32_t MAX_MESSAGES_PER_PACKET = 64;
+    static constexpr uint16_t RELIABLE_WINDOW = 256;     // Надежных сообщений "в полете" на канал
+    static constexpr uint32_t RECEIVED_ID_WINDOW = 1024;
+    static constexpr size_t MAX_UNRELIABLE_QUEUE = 1024;
+    static constexpr double KEEPALIVE_INTERVAL = 0.25;
+
+    // Надежное сообщение, ожидающее подтверждения
+    struct PendingMessage {
+        uint16_t id;
+        bool acked;
+        double lastSendTime; // < 0 - еще не отправлялось
+        NetworkPacket* payload;
+    };
+
+    // Запись об отправленном пакете
+    struct SentPacket {
+        uint16_t sequence;
+        bool tracked;  // Требует подтверждения (не пакет только с подтверждениями)
+        bool resolved; // Подтвержден или засчитан потерянным
+        double sendTime;
+        uint32_t messageCount;
+        uint8_t channels[MAX_MESSAGES_PER_PACKET];
+        uint16_t messageIds[MAX_MESSAGES_PER_PACKET];
+    };
+
+    struct ReliableSendChannel {
+        std::deque<PendingMessage> pending; // Последовательные id, подтвержденные снимаются с начала
+        uint16_t nextId;
+    };
+
+    // Придержанное сообщение упорядоченного канала
+    struct HeldMessage {
+        bool valid;
+        uint16_t id;
+        NetworkPacket* payload;
+    };
+
+    // Сообщение разбираемого пакета, уже скопированное в буфер пула
+    struct ReceivedMessage {
+        NetworkChannel channel;
+        uint16_t id;
+        NetworkPacket* payload;
+    };
+
+    NetworkAddress m_address;
+    PacketPool& m_pool;
+    NetworkConnectionStats m_stats;
+
+    // Отправка
+    uint16_t m_nextSequence;
+    uint16_t m_lossCursor; // Самый старый пакет, судьба которого не решена
+    uint16_t m_latestAck;
+    bool m_hasLatestAck;
+    std::vector<SentPacket> m_sentPackets;
+    std::deque<NetworkPacket*> m_unreliableQueue;
+    ReliableSendChannel m_reliable[2];
+    double m_lastSendTime;
+
+    // Прием
+    bool m_hasReceived;
+    bool m_ackPending;
+    uint16_t m_remoteSequence;
+    uint32_t m_receivedBits;
+    double m_lastReceiveTime;
+    uint16_t m_orderedExpected;
+    std::vector<HeldMessage> m_heldMessages;
+    std::vector<uint32_t> m_unorderedReceived; // id + 1, 0 - пусто
+    std::vector<ReceivedMessage> m_received;
+
+    static bool SequenceGreater(uint16_t a, uint16_t b) {
+        return static_cast<int16_t>(a - b) > 0;
+    }
+
+    ReliableSendChannel& GetReliableChannel(NetworkChannel channel) {
+        return m_reliable[channel == NetworkChannel::ReliableOrdered ? 0 : 1];
+    }
+
+    double GetResendDelay() const;
+    void ProcessAcks(uint16_t ack, uint32_t ackBits, double time);
+    void AckPacket(SentPacket& record, double time);
+    void ResolveLostPackets(double time);
+    void ReleaseAckedMessages(ReliableSendChannel& channel);
+    bool IsNewSequence(uint16_t sequence) const;
+    void MarkSequenceReceived(uint16_t sequence);
+    bool NeedsDelivery(NetworkChannel channel, uint16_t id) const;
+    void DeliverReliable(const ReceivedMessage& message, NetworkDeliverFunc deliver, void* userData);
+};
+
+} // namespace FastEngine
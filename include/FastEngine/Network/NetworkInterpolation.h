@@ -0,0 +1,92 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+
+namespace FastEngine {
+
+/**
+ * Состояние объекта на момент серверного времени
+ */
+struct NetworkStateSample {
+    double time; // Серверное время, с
+    glm::vec3 position;
+    glm::vec3 rotation; // Градусы
+};
+
+/**
+ * Временная шкала состояний реплицируемого объекта
+ *
+ * Хранит CAPACITY последних состояний по возрастанию серверного времени
+ * (запоздавшие снимки встают на свое место) и выдает состояние на
+ * произвольный момент: линейная интерполяция между соседями, поворот - по
+ * кратчайшей дуге. За последним состоянием - экстраполяция по последней
+ * скорости не дальше maxExtrapolation, затем удержание.
+ */
+class NetworkTimeline {
+public:
+    static constexpr uint32_t CAPACITY = 32;
+
+    NetworkTimeline();
+
+    void AddSample(double time, const glm::vec3& position, const glm::vec3& rotation);
+    // false - шкала пуста
+    bool Sample(double time, glm::vec3& position, glm::vec3& rotation) const;
+    void Clear() { m_count = 0; }
+
+    uint32_t GetSampleCount() const { return m_count; }
+    double GetLatestTime() const { return m_count > 0 ? m_samples[m_count - 1].time : 0.0; }
+    void SetMaxExtrapolation(double seconds) { m_maxExtrapolation = seconds; }
+
+private:
+    NetworkStateSample m_samples[CAPACITY];
+    uint32_t m_count;
+    double m_maxExtrapolation;
+};
+
+/**
+ * Часы интерполяции
+ *
+ * По парам (серверное время снимка, локальное время прихода) оценивает
+ * смещение часов по минимальной задержке доставки, интервал между
+ * снимками и джиттер (сглаженное изменение задержки, как в RFC 3550).
+ * Отображаемое время отстает от оценки серверного на задержку
+ * snapshotMargin * интервал + jitterMultiplier * джиттер в пределах
+ * [minDelay, maxDelay]; задержка меняется плавно, без скачков времени.
+ */
+class InterpolationClock {
+public:
+    InterpolationClock();
+
+    void AddSnapshot(double serverTime, double localTime);
+    void Reset();
+
+    // Время, которое сейчас отображается, в серверных секундах
+    double GetRenderTime(double localTime) const { return GetServerTime(localTime) - m_delay; }
+    double GetServerTime(double localTime) const { return localTime - m_offset; }
+    bool IsSynchronized() const { return m_synchronized; }
+
+    double GetDelay() const { return m_delay; }
+    double GetJitter() const { return m_jitter; }
+    double GetSnapshotInterval() const { return m_interval; }
+
+    // Настройки
+    void SetSnapshotMargin(double snapshots) { m_snapshotMargin = snapshots; }
+    void SetJitterMultiplier(double multiplier) { m_jitterMultiplier = multiplier; }
+    void SetDelayBounds(double minDelay, double maxDelay);
+
+private:
+    bool m_synchronized;
+    double m_offset;          // Локальное время минус серверное при минимальной задержке
+    double m_lastTransit;
+    double m_lastServerTime;
+    double m_interval;
+    double m_jitter;
+    double m_delay;
+    double m_snapshotMargin;
+    double m_jitterMultiplier;
+    double m_minDelay;
+    double m_maxDelay;
+};
+
+} // namespace FastEngine
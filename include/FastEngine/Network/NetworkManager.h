@@ -5,14 +5,19 @@
 #include <memory>
 #include <functional>
 #include <unordered_map>
-#include <queue>
-#include <mutex>
 #include <thread>
 #include <atomic>
 #include <glm/glm.hpp>
+#include "FastEngine/Network/BitStream.h"
+#include "FastEngine/Network/NetworkInterpolation.h"
+#include "FastEngine/Network/NetworkConnection.h"
+#include "FastEngine/Network/NetworkTransport.h"
+#include "FastEngine/Platform/SpscRing.h"
 
 namespace FastEngine {
 
+class ObjectReplicator;
+
 /**
  * Типы сетевых сообщений
  */
@@ -33,14 +38,26 @@ enum class NetworkMessageType {
  */
 struct NetworkMessage {
     NetworkMessageType type;
+    NetworkChannel channel;
     std::string data;
-    std::string senderId;
+    std::string senderId; // У принятых сообщений без отправителя - адрес узла
     uint32_t timestamp;
     uint32_t sequence;
     
-    NetworkMessage() : type(NetworkMessageType::Custom), timestamp(0), sequence(0) {}
-    NetworkMessage(NetworkMessageType t, const std::string& d, const std::string& sender = "")
-        : type(t), data(d), senderId(sender), timestamp(0), sequence(0) {}
+    NetworkMessage() : type(NetworkMessageType::Custom), channel(NetworkChannel::ReliableOrdered), timestamp(0), sequence(0) {}
+    NetworkMessage(NetworkMessageType t, const std::string& d, const std::string& sender = "",
+                   NetworkChannel c = NetworkChannel::ReliableOrdered)
+        : type(t), channel(c), data(d), senderId(sender), timestamp(0), sequence(0) {}
+    
+    // Двоичное представление: тип (4 бита), номер и время (varint),
+    // отправитель и данные (длина + байты). Канал задается при отправке
+    void Write(BitWriter& writer) const {
+        Write(writer, type, sequence, timestamp, senderId, data.data(), static_cast<uint32_t>(data.size()));
+    }
+    static void Write(BitWriter& writer, NetworkMessageType type, uint32_t sequence, uint32_t timestamp,
+                      const std::string& senderId, const void* data, uint32_t size);
+    // Переиспользует емкость строк; false - запись повреждена
+    bool Read(BitReader& reader);
 };
 
 /**
@@ -59,6 +76,34 @@ struct PlayerInfo {
         : id(playerId), name(playerName), position(0.0f), rotation(0.0f), connected(true), lastUpdateTime(0) {}
 };
 
+/**
+ * Поля сетевого объекта для двоичной синхронизации
+ */
+enum NetworkObjectField : uint32_t {
+    NETWORK_FIELD_OWNER = 1 << 0,
+    NETWORK_FIELD_POSITION = 1 << 1,
+    NETWORK_FIELD_ROTATION = 1 << 2,
+    NETWORK_FIELD_ALL = (1 << 3) - 1
+};
+
+constexpr uint32_t NETWORK_OBJECT_FIELD_COUNT = 3;
+
+/**
+ * Схема полей сетевого объекта
+ *
+ * Задает границы и точность квантования позиции и поворота (градусы).
+ * По умолчанию: позиция в [-4096, 4096] с шагом 1 см (20 бит на
+ * компоненту), поворот в [-360, 360] с шагом 0.05 градуса (14 бит).
+ */
+struct NetworkObjectSchema {
+    FloatQuantization position;
+    FloatQuantization rotation;
+    
+    NetworkObjectSchema() : position(-4096.0f, 4096.0f, 0.01f), rotation(-360.0f, 360.0f, 0.05f) {}
+    NetworkObjectSchema(const FloatQuantization& positionQuantization, const FloatQuantization& rotationQuantization)
+        : position(positionQuantization), rotation(rotationQuantization) {}
+};
+
 /**
  * Сетевой объект
  */
@@ -74,6 +119,10 @@ public:
     const std::string& GetOwnerId() const { return m_ownerId; }
     void SetOwnerId(const std::string& ownerId) { m_ownerId = ownerId; }
     
+    // Числовой идентификатор для двоичной синхронизации (пишется varint)
+    uint32_t GetNetId() const { return m_netId; }
+    void SetNetId(uint32_t netId) { m_netId = netId; }
+    
     // Позиция и поворот
     const glm::vec3& GetPosition() const { return m_position; }
     void SetPosition(const glm::vec3& position) { m_position = position; }
@@ -85,16 +134,25 @@ public:
     bool IsDirty() const { return m_dirty; }
     void SetDirty(bool dirty) { m_dirty = dirty; }
     
-    // Синхронизация
+    // Синхронизация (JSON)
     virtual std::string Serialize() const;
     virtual void Deserialize(const std::string& data);
     
+    // Двоичная синхронизация: маска полей (NetworkObjectField), затем
+    // отмеченные поля. Идентификатор пишет вызывающий, чтобы получатель
+    // мог найти объект до разбора. ReadState применяет поля, только если
+    // запись прочитана целиком
+    virtual void WriteState(BitWriter& writer, const NetworkObjectSchema& schema,
+                            uint32_t fields = NETWORK_FIELD_ALL) const;
+    virtual bool ReadState(BitReader& reader, const NetworkObjectSchema& schema);
+    
     // Обновление
     virtual void Update(float deltaTime) {}
     
 private:
     std::string m_id;
     std::string m_ownerId;
+    uint32_t m_netId;
     glm::vec3 m_position;
     glm::vec3 m_rotation;
     bool m_dirty;
@@ -102,6 +160,9 @@ private:
 
 /**
  * Профилировщик сети
+ *
+ * NetworkManager каждый кадр передает сюда RTT и счетчики пакетов,
+ * собранные по подтверждениям транспорта.
  */
 class NetworkProfiler {
 public:
@@ -111,15 +172,19 @@ public:
     // Метрики
     void RecordMessageSent(const NetworkMessage& message);
     void RecordMessageReceived(const NetworkMessage& message);
-    void RecordLatency(uint32_t latency);
+    void RecordLatency(float latency); // RTT, мс
     void RecordBandwidth(float bytesPerSecond);
+    void RecordPacketsSent(uint32_t count) { m_packetsSent += count; }
+    void RecordPacketsLost(uint32_t count) { m_packetsLost += count; }
     
     // Получение статистики
     float GetAverageLatency() const { return m_averageLatency; }
     float GetBandwidthUsage() const { return m_bandwidthUsage; }
     uint32_t GetMessagesSent() const { return m_messagesSent; }
     uint32_t GetMessagesReceived() const { return m_messagesReceived; }
+    uint32_t GetPacketsSent() const { return m_packetsSent; }
     uint32_t GetPacketsLost() const { return m_packetsLost; }
+    float GetPacketLoss() const { return m_packetsSent > 0 ? static_cast<float>(m_packetsLost) / m_packetsSent : 0.0f; }
     
     // Сброс статистики
     void Reset();
@@ -129,8 +194,9 @@ private:
     float m_bandwidthUsage;
     uint32_t m_messagesSent;
     uint32_t m_messagesReceived;
+    uint32_t m_packetsSent;
     uint32_t m_packetsLost;
-    std::vector<uint32_t> m_latencyHistory;
+    std::vector<float> m_latencyHistory;
     std::vector<float> m_bandwidthHistory;
     
     void UpdateAverageLatency();
@@ -139,6 +205,12 @@ private:
 
 /**
  * Менеджер сети
+ *
+ * Сетевой поток владеет транспортом и соединениями: принимает пачки
+ * датаграмм, разбирает подтверждения, собирает и отправляет пакеты.
+ * С игровым потоком он обменивается буферами пула через две очереди
+ * SPSC без блокировок. SendMessage, Update и GetReceivedMessages
+ * вызываются только из игрового потока.
  */
 class NetworkManager {
 public:
@@ -149,6 +221,13 @@ public:
     bool Initialize();
     void Shutdown();
     
+    // Транспорт (до Connect/StartServer); по умолчанию - UdpTransport
+    void SetTransport(std::unique_ptr<NetworkTransport> transport);
+    void SetMaxConnections(int count) { m_maxConnections = count; }
+    void SetConnectionTimeout(float seconds) { m_connectionTimeout = seconds; }
+    int GetConnectionCount() const { return m_connectionCount.load(std::memory_order_relaxed); }
+    NetworkAddress GetLocalAddress() const;
+    
     // Подключение
     bool Connect(const std::string& host, int port);
     bool Disconnect();
@@ -175,6 +254,12 @@ public:
     void SendMessage(const NetworkMessage& message);
     void SendMessageToPlayer(const std::string& playerId, const NetworkMessage& message);
     void BroadcastMessage(const NetworkMessage& message);
+    // Отправка двоичных данных (например, из BitWriter) без промежуточных
+    // строк: данные кодируются сразу в буфер пула
+    void SendPayload(NetworkMessageType type, const uint8_t* data, uint32_t size,
+                     NetworkChannel channel = NetworkChannel::Unreliable);
+    void SendPayloadToPlayer(const std::string& playerId, NetworkMessageType type, const uint8_t* data,
+                             uint32_t size, NetworkChannel channel = NetworkChannel::Unreliable);
     
     // Обновление
     void Update(float deltaTime);
@@ -187,8 +272,13 @@ public:
     void SetOnPlayerLeave(std::function<void(const PlayerInfo&)> callback) { m_onPlayerLeave = callback; }
     void SetOnMessageReceived(std::function<void(const NetworkMessage&)> callback) { m_onMessageReceived = callback; }
     
+    // Репликатор, которому передаются сообщения ObjectUpdate и который
+    // обновляется в Update сервера (см. ObjectReplicator::Initialize)
+    void SetReplicator(ObjectReplicator* replicator) { m_replicator = replicator; }
+    
     // Профилировщик
     NetworkProfiler& GetProfiler() { return m_profiler; }
+    uint32_t GetDroppedMessages() const { return m_droppedMessages.load(std::memory_order_relaxed); }
     
 private:
     bool m_initialized;
@@ -201,15 +291,50 @@ private:
     std::vector<std::shared_ptr<NetworkObject>> m_objects;
     std::unordered_map<std::string, std::shared_ptr<NetworkObject>> m_objectMap;
     
-    std::queue<NetworkMessage> m_sendQueue;
-    std::queue<NetworkMessage> m_receiveQueue;
-    std::mutex m_sendMutex;
-    std::mutex m_receiveMutex;
+    // Сообщение игрового потока для сетевого
+    struct OutgoingMessage {
+        NetworkPacket* payload; // Адрес получателя - в payload->address
+        NetworkChannel channel;
+        bool broadcast;
+    };
+    
+    // Обмен между потоками: буферы пула через очереди SPSC
+    PacketPool m_packetPool;
+    SpscRing<OutgoingMessage> m_sendRing;
+    SpscRing<NetworkPacket*> m_receiveRing;
+    
+    // Состояние сетевого потока
+    std::unique_ptr<NetworkTransport> m_transport;
+    NetworkAddress m_serverAddress;
+    std::vector<std::unique_ptr<NetworkConnection>> m_connections;
+    std::unordered_map<NetworkAddress, size_t, NetworkAddressHash> m_connectionIndex;
+    std::vector<NetworkPacket> m_sendBuffers;
+    std::vector<NetworkPacket> m_receiveBuffers;
+    NetworkAddress m_deliverFrom;          // Отправитель разбираемого пакета
+    NetworkConnectionStats m_closedStats;  // Накопленное закрытыми соединениями
+    int m_maxConnections;
+    float m_connectionTimeout;
     
     std::thread m_networkThread;
     std::atomic<bool> m_running;
     
+    // Статистика, публикуемая сетевым потоком
+    std::atomic<int> m_connectionCount;
+    std::atomic<uint32_t> m_statPacketsSent;
+    std::atomic<uint32_t> m_statPacketsLost;
+    std::atomic<uint64_t> m_statBytes;
+    std::atomic<uint32_t> m_statRttSamples;
+    std::atomic<float> m_statRoundTripTime;
+    std::atomic<uint32_t> m_droppedMessages;
+    std::vector<OutgoingMessage> m_sendBacklog; // Не поместившееся в очередь отправки
+    std::vector<NetworkPacket*> m_receiveBacklog; // Не поместившееся в очередь приема (сетевой поток)
+    uint32_t m_reportedPacketsSent;
+    uint32_t m_reportedPacketsLost;
+    uint64_t m_reportedBytes;
+    uint32_t m_reportedRttSamples;
+    
     NetworkProfiler m_profiler;
+    ObjectReplicator* m_replicator;
     
     // Callbacks
     std::function<void(const PlayerInfo&)> m_onPlayerJoin;
@@ -222,44 +347,245 @@ private:
     void ProcessSendQueue();
     void HandleMessage(const NetworkMessage& message);
     void UpdateObjects(float deltaTime);
-    void SynchronizeObjects();
-    
-    // Сетевые операции
-    bool SendData(const std::string& data);
-    std::string ReceiveData();
-    void HandleConnection();
-    void HandleDisconnection();
+    void SynchronizeObjects(float deltaTime);
+    void UpdateProfiler(float deltaTime);
+    // header задает тип, отправителя, номер, время и канал; данные - data[0..size)
+    void QueueOutgoing(const NetworkMessage& header, const void* data, uint32_t size,
+                       const NetworkAddress& target, bool broadcast);
+    bool PopReceivedMessage(NetworkMessage& message);
+    
+    // Сетевой поток
+    bool StartNetworkThread(uint16_t port);
+    void StopNetworkThread();
+    bool SendData(double time);
+    bool ReceiveData(double time);
+    NetworkConnection* FindConnection(const NetworkAddress& address);
+    NetworkConnection* HandleConnection(const NetworkAddress& address);
+    void HandleDisconnection(size_t index);
+    void PublishStats();
+    void PushReceived(NetworkPacket* payload);
+    void FlushReceiveBacklog();
+    static void DeliverMessage(void* userData, NetworkPacket* payload);
 };
 
 /**
  * Репликатор объектов
+ *
+ * Сервер раз в 1/rate секунды снимает квантованное состояние всех объектов
+ * в кольцо из SNAPSHOT_WINDOW снимков. Каждый клиент получает один пакет
+ * на снимок: объекты из его зоны интереса (равномерная сетка по позициям,
+ * радиус maxReplicationDistance), изменившиеся относительно состояния,
+ * подтвержденного этим клиентом, в порядке приоритета (важность,
+ * расстояние, давность отправки) в пределах бюджета полосы. Квантованные
+ * поля кодируются разностью с подтвержденным снимком, объекты без такого
+ * снимка - целиком.
+ *
+ * Клиент хранит состояния объектов из последних снимков, восстанавливает
+ * по ним базу разности и подтверждает каждый принятый снимок. Объекты,
+ * вышедшие из зоны интереса, у клиента остаются с последним состоянием.
+ *
+ * Снимок несет серверное время. С включенной интерполяцией клиент
+ * складывает состояния объектов на их временные шкалы и в
+ * UpdateReplication показывает их с задержкой InterpolationClock, так что
+ * движение остается плавным при редких снимках, потерях и джиттере.
+ * Объекты локального владельца (SetLocalOwnerId) получают последнее
+ * состояние сервера сразу - их ведет предсказание (PredictionBuffer).
+ *
+ * С NetworkManager (Initialize) пакеты идут сообщениями ObjectUpdate по
+ * ненадежному каналу, а на сервере клиенты - подключенные игроки с
+ * точкой обзора в PlayerInfo::position. Без него пакеты передаются через
+ * SetSendCallback и HandlePayload.
  */
 class ObjectReplicator {
 public:
+    // Отправка пакета: targetId - клиент (сервером) или отправитель снимка (клиентом)
+    using SendCallback = std::function<void(const std::string& targetId, const uint8_t* data, uint32_t size)>;
+    // Создание объекта, впервые пришедшего клиенту
+    using ObjectFactory = std::function<std::shared_ptr<NetworkObject>(uint32_t netId)>;
+    // Новое состояние сервера для объекта локального владельца
+    using AuthoritativeStateCallback = std::function<void(NetworkObject& object, double serverTime)>;
+    
+    static constexpr uint32_t SNAPSHOT_WINDOW = 32;
+    
     ObjectReplicator();
     ~ObjectReplicator() = default;
     
     // Инициализация
     void Initialize(NetworkManager* networkManager);
+    void SetSendCallback(SendCallback callback) { m_sendCallback = callback; }
+    void SetObjectFactory(ObjectFactory factory) { m_objectFactory = factory; }
     
-    // Управление репликацией
+    // Управление репликацией (сервер)
     void StartReplicating(std::shared_ptr<NetworkObject> object);
     void StopReplicating(const std::string& objectId);
+    void SetObjectRelevance(const std::string& objectId, float relevance);
     void UpdateReplication(float deltaTime);
     
+    // Клиенты (сервер)
+    void AddClient(const std::string& clientId);
+    void RemoveClient(const std::string& clientId);
+    void SetClientViewpoint(const std::string& clientId, const glm::vec3& position);
+    void SetClientBandwidth(const std::string& clientId, float bytesPerSecond);
+    void AcknowledgeSnapshot(const std::string& clientId, uint32_t snapshotId);
+    size_t GetClientCount() const { return m_clients.size(); }
+    
+    // Прием (сервер - подтверждения, клиент - снимки)
+    void HandleMessage(const NetworkMessage& message);
+    bool HandlePayload(const std::string& senderId, const uint8_t* data, uint32_t size);
+    std::shared_ptr<NetworkObject> GetReplicatedObject(uint32_t netId) const;
+    size_t GetReplicatedObjectCount() const { return m_objectSlots.size() + m_receivedObjects.size(); }
+    
+    // Интерполяция и предсказание (клиент)
+    void SetInterpolationEnabled(bool enabled) { m_interpolationEnabled = enabled; }
+    bool IsInterpolationEnabled() const { return m_interpolationEnabled; }
+    void SetLocalOwnerId(const std::string& ownerId) { m_localOwnerId = ownerId; }
+    void SetAuthoritativeStateCallback(AuthoritativeStateCallback callback) { m_authoritativeStateCallback = callback; }
+    InterpolationClock& GetInterpolationClock() { return m_clock; }
+    const InterpolationClock& GetInterpolationClock() const { return m_clock; }
+    
     // Настройки
     void SetReplicationRate(float rate) { m_replicationRate = rate; }
     void SetMaxReplicationDistance(float distance) { m_maxReplicationDistance = distance; }
+    void SetInterestCellSize(float size) { m_interestCellSize = size; } // 0 - половина дистанции
+    void SetBandwidthBudget(float bytesPerSecond) { m_defaultBandwidth = bytesPerSecond; }
+    void SetSchema(const NetworkObjectSchema& schema) { m_schema = schema; }
+    const NetworkObjectSchema& GetSchema() const { return m_schema; }
+    
+    // Статистика последнего снимка
+    uint32_t GetSnapshotId() const { return m_snapshotId; }
+    double GetLastUpdateTime() const { return m_lastUpdateTime; } // мс
+    uint64_t GetLastBytesSent() const { return m_lastBytesSent; }
+    uint32_t GetLastObjectsSent() const { return m_lastObjectsSent; }
+    uint32_t GetLastCandidates() const { return m_lastCandidates; }
     
 private:
+    static constexpr uint32_t FIELD_CODES = 6; // Позиция и поворот
+    static constexpr uint32_t MAX_REMOVALS_PER_PACKET = 64;
+    
+    // Квантованное состояние объекта в снимке
+    struct ReplicatedState {
+        uint32_t netId; // 0 - слот пуст
+        uint32_t ownerHash;
+        uint32_t codes[FIELD_CODES];
+    };
+    
+    struct Snapshot {
+        uint32_t id;
+        std::vector<ReplicatedState> states; // По слотам объектов
+    };
+    
+    struct ObjectSlot {
+        std::shared_ptr<NetworkObject> object;
+        float relevance;
+        uint32_t lastChanged; // Снимок, в котором квантованное состояние последний раз изменилось
+    };
+    
+    // Пакет, отправленный клиенту: какие слоты в каком снимке
+    struct SentRecord {
+        uint32_t snapshotId;
+        bool acked;
+        std::vector<uint32_t> slots;
+    };
+    
+    struct PendingRemoval {
+        uint32_t netId;
+        uint32_t firstSent; // 0 - еще не отправлялось
+    };
+    
+    struct ReplicationClient {
+        std::string id;
+        glm::vec3 viewpoint;
+        float bandwidth; // <= 0 - общий бюджет
+        bool fromPlayers;
+        std::vector<uint32_t> ackedSnapshot;    // По слотам: последний подтвержденный снимок с объектом
+        std::vector<uint32_t> lastSentSnapshot; // По слотам
+        std::vector<SentRecord> sent;           // SNAPSHOT_WINDOW записей
+        std::vector<PendingRemoval> removals;
+    };
+    
+    struct Candidate {
+        float priority;
+        uint32_t slot;
+        uint32_t baseline;             // 0 - без базы
+        const ReplicatedState* base;
+    };
+    
+    // Равномерная сетка по позициям объектов в формате CSR
+    struct InterestGrid {
+        glm::vec3 origin;
+        float inverseCellSize;
+        int size[3];
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> slots;
+        std::vector<uint32_t> cells;        // Ячейка каждого слота
+        std::vector<glm::vec3> positions;   // Квантованная позиция каждого слота
+    };
+    
+    // Объект на стороне клиента с историей состояний по снимкам
+    struct ReceivedObject {
+        std::shared_ptr<NetworkObject> object;
+        uint32_t latestSnapshot;
+        uint32_t historyIds[SNAPSHOT_WINDOW];
+        uint32_t historyCodes[SNAPSHOT_WINDOW][FIELD_CODES];
+        NetworkTimeline timeline;
+    };
+    
+    struct RemovedObject {
+        uint32_t netId;
+        uint32_t snapshotId;
+    };
+    
     NetworkManager* m_networkManager;
-    std::vector<std::shared_ptr<NetworkObject>> m_replicatedObjects;
+    SendCallback m_sendCallback;
+    ObjectFactory m_objectFactory;
+    NetworkObjectSchema m_schema;
     float m_replicationRate;
     float m_maxReplicationDistance;
+    float m_interestCellSize;
+    float m_defaultBandwidth;
     float m_lastReplicationTime;
-    
-    bool ShouldReplicate(std::shared_ptr<NetworkObject> object);
-    void ReplicateObject(std::shared_ptr<NetworkObject> object);
+    double m_localTime; // Сумма deltaTime UpdateReplication; на сервере - время снимков
+    
+    // Сервер
+    std::vector<ObjectSlot> m_objectSlots;
+    std::vector<uint32_t> m_freeSlots;
+    std::unordered_map<std::string, uint32_t> m_slotIndex;
+    uint32_t m_nextNetId;
+    uint32_t m_snapshotId;
+    std::vector<Snapshot> m_snapshots;
+    std::vector<std::unique_ptr<ReplicationClient>> m_clients;
+    InterestGrid m_grid;
+    std::vector<Candidate> m_candidates;
+    std::vector<uint8_t> m_packetBuffer;
+    
+    // Клиент
+    std::unordered_map<uint32_t, std::unique_ptr<ReceivedObject>> m_receivedObjects;
+    std::vector<RemovedObject> m_removedObjects; // Удаленные за последние SNAPSHOT_WINDOW снимков
+    uint32_t m_latestReceivedSnapshot;
+    std::string m_ownerScratch;
+    bool m_interpolationEnabled;
+    std::string m_localOwnerId;
+    AuthoritativeStateCallback m_authoritativeStateCallback;
+    InterpolationClock m_clock;
+    
+    // Статистика
+    double m_lastUpdateTime;
+    uint64_t m_lastBytesSent;
+    uint32_t m_lastObjectsSent;
+    uint32_t m_lastCandidates;
+    
+    ReplicationClient* FindClient(const std::string& clientId);
+    void SyncClientsWithPlayers();
+    void CaptureSnapshot();
+    void BuildInterestGrid();
+    void CollectCandidates(ReplicationClient& client);
+    void WriteClientPacket(ReplicationClient& client);
+    const ReplicatedState* GetBaseline(const ReplicationClient& client, uint32_t slot, uint32_t& baselineId) const;
+    bool ReadSnapshot(BitReader& reader, uint32_t& snapshotId);
+    bool IsLocallyOwned(const NetworkObject& object) const;
+    void ApplyInterpolation();
+    void RemoveReceivedObject(uint32_t netId, uint32_t snapshotId);
+    void Send(const std::string& targetId, const uint8_t* data, uint32_t size);
 };
 
 } // namespace FastEngine
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "FastEngine/WorldSnapshot.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace FastEngine {
+
+/**
+ * Предсказание на клиенте с откатом
+ *
+ * Клиент применяет свой ввод сразу, не дожидаясь сервера: Predict
+ * присваивает вводу номер тика, симулирует его и снимает предсказанное
+ * состояние (capture выбирает компоненты объектов, которыми владеет
+ * клиент). Номер тика уходит на сервер вместе с вводом, сервер отвечает
+ * авторитетным состоянием после обработки этого тика.
+ *
+ * Reconcile откатывает мир к предсказанию для подтвержденного тика и
+ * вызывает correct, который переносит в мир состояние сервера. Если
+ * correct сообщает о расхождении, ввод после тика симулируется заново
+ * поверх исправленного состояния. История хранит capacity тиков, снимки
+ * переиспользуют память.
+ */
+template<typename Input>
+class PredictionBuffer {
+public:
+    using CaptureFunction = std::function<void(World& world, WorldSnapshot& snapshot)>;
+    using SimulateFunction = std::function<void(World& world, const Input& input, float deltaTime)>;
+    // true - состояние сервера отличается от предсказанного и записано в мир
+    using CorrectFunction = std::function<bool(World& world)>;
+
+    PredictionBuffer(World& world, CaptureFunction capture, SimulateFunction simulate, uint32_t capacity = 128)
+        : m_world(world)
+        , m_capture(std::move(capture))
+        , m_simulate(std::move(simulate))
+        , m_frames(capacity > 0 ? capacity : 1)
+        , m_latestTick(0)
+        , m_acknowledgedTick(0)
+        , m_lastResimulated(0) {
+        for (Frame& frame : m_frames) {
+            frame.tick = 0;
+        }
+    }
+
+    // Возвращает номер тика для отправки на сервер
+    uint32_t Predict(const Input& input, float deltaTime) {
+        const uint32_t tick = ++m_latestTick;
+        Frame& frame = m_frames[tick % m_frames.size()];
+        frame.tick = tick;
+        frame.input = input;
+        frame.deltaTime = deltaTime;
+        m_simulate(m_world, input, deltaTime);
+        CaptureFrame(frame);
+        return tick;
+    }
+
+    // Число пересимулированных тиков; -1 - тик вне истории
+    int Reconcile(uint32_t tick, const CorrectFunction& correct) {
+        if (tick <= m_acknowledgedTick) {
+            return 0; // Повтор или запоздавший ответ
+        }
+        Frame& frame = m_frames[tick % m_frames.size()];
+        if (tick > m_latestTick || frame.tick != tick) {
+            return -1;
+        }
+
+        frame.state.Restore(m_world);
+        const bool corrected = correct(m_world);
+        m_acknowledgedTick = tick;
+        m_lastResimulated = 0;
+        if (!corrected) {
+            // Предсказание совпало: возврат к последнему тику
+            if (tick != m_latestTick) {
+                m_frames[m_latestTick % m_frames.size()].state.Restore(m_world);
+            }
+            return 0;
+        }
+
+        CaptureFrame(frame);
+        for (uint32_t replay = tick + 1; replay <= m_latestTick; ++replay) {
+            Frame& next = m_frames[replay % m_frames.size()];
+            m_simulate(m_world, next.input, next.deltaTime);
+            CaptureFrame(next);
+            ++m_lastResimulated;
+        }
+        return static_cast<int>(m_lastResimulated);
+    }
+
+    // Ввод еще не подтвержденного тика (для повторной отправки)
+    const Input* GetInput(uint32_t tick) const {
+        const Frame& frame = m_frames[tick % m_frames.size()];
+        return tick > m_acknowledgedTick && frame.tick == tick ? &frame.input : nullptr;
+    }
+
+    uint32_t GetLatestTick() const { return m_latestTick; }
+    uint32_t GetAcknowledgedTick() const { return m_acknowledgedTick; }
+    uint32_t GetPendingCount() const { return m_latestTick - m_acknowledgedTick; }
+    uint32_t GetLastResimulated() const { return m_lastResimulated; }
+
+private:
+    struct Frame {
+        uint32_t tick;
+        Input input;
+        float deltaTime;
+        WorldSnapshot state; // После применения ввода
+    };
+
+    World& m_world;
+    CaptureFunction m_capture;
+    SimulateFunction m_simulate;
+    std::vector<Frame> m_frames;
+    uint32_t m_latestTick;
+    uint32_t m_acknowledgedTick;
+    uint32_t m_lastResimulated;
+
+    void CaptureFrame(Frame& frame) {
+        frame.state.Clear();
+        m_capture(m_world, frame.state);
+    }
+};
+
+} // namespace FastEngine
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+namespace FastEngine {
+
+// Максимальный размер датаграммы (без фрагментации по типичному MTU)
+constexpr uint32_t MAX_PACKET_SIZE = 1200;
+
+// Число пакетов в одном системном вызове приема или отправки
+constexpr int NETWORK_BATCH_SIZE = 32;
+
+/**
+ * Адрес IPv4 и порт (в порядке байт хоста)
+ */
+struct NetworkAddress {
+    uint32_t ip;
+    uint16_t port;
+
+    NetworkAddress() : ip(0), port(0) {}
+    NetworkAddress(uint32_t a, uint16_t p) : ip(a), port(p) {}
+
+    // Хост - "localhost", адрес вида 127.0.0.1 или имя для разрешения
+    static bool Resolve(const std::string& host, int port, NetworkAddress& address);
+    // Строка вида "127.0.0.1:7777" (формат ToString)
+    static bool Parse(const std::string& endpoint, NetworkAddress& address);
+
+    std::string ToString() const;
+    bool IsValid() const { return port != 0; }
+
+    bool operator==(const NetworkAddress& other) const { return ip == other.ip && port == other.port; }
+    bool operator!=(const NetworkAddress& other) const { return !(*this == other); }
+};
+
+struct NetworkAddressHash {
+    size_t operator()(const NetworkAddress& address) const {
+        return std::hash<uint64_t>()((static_cast<uint64_t>(address.ip) << 16) | address.port);
+    }
+};
+
+/**
+ * Буфер датаграммы из пула
+ */
+struct NetworkPacket {
+    NetworkAddress address;
+    uint32_t size;
+    uint8_t data[MAX_PACKET_SIZE];
+
+    NetworkPacket() : size(0) {}
+};
+
+/**
+ * Пул пакетных буферов фиксированного размера. Буферы выделяются один раз;
+ * Acquire и Release работают без блокировок из любых потоков (стек
+ * свободных индексов со счетчиком версий против ABA).
+ */
+class PacketPool {
+public:
+    explicit PacketPool(size_t capacity = 4096);
+    ~PacketPool() = default;
+
+    PacketPool(const PacketPool&) = delete;
+    PacketPool& operator=(const PacketPool&) = delete;
+
+    // nullptr, если свободных буферов нет
+    NetworkPacket* Acquire();
+    void Release(NetworkPacket* packet);
+
+    size_t GetCapacity() const { return m_capacity; }
+    size_t GetFreeCount() const { return m_freeCount.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    size_t m_capacity;
+    std::unique_ptr<NetworkPacket[]> m_packets;
+    std::unique_ptr<std::atomic<uint32_t>[]> m_next;
+    std::atomic<uint64_t> m_head; // Версия в старших 32 битах, индекс - в младших
+    std::atomic<size_t> m_freeCount;
+};
+
+/**
+ * Неблокирующий датаграммный транспорт
+ */
+class NetworkTransport {
+public:
+    virtual ~NetworkTransport() = default;
+
+    // port == 0 - любой свободный порт
+    virtual bool Open(uint16_t port) = 0;
+    virtual void Close() = 0;
+    virtual bool IsOpen() const = 0;
+    virtual NetworkAddress GetLocalAddress() const = 0;
+
+    // Отправка пачки пакетов (адрес назначения - в packet->address); число отправленных
+    virtual int SendBatch(NetworkPacket* const* packets, int count) = 0;
+    // Прием без блокировки в переданные буферы (адрес отправителя - в packet->address); число принятых
+    virtual int ReceiveBatch(NetworkPacket* const* packets, int count) = 0;
+    // Ожидание входящих данных не дольше timeoutMs
+    virtual void WaitForData(int timeoutMs) = 0;
+};
+
+/**
+ * UDP-сокет. В Linux пачки уходят и принимаются одним вызовом
+ * sendmmsg/recvmmsg, на других POSIX-системах - циклом sendto/recvfrom.
+ */
+class UdpTransport : public NetworkTransport {
+public:
+    UdpTransport();
+    ~UdpTransport() override;
+
+    bool Open(uint16_t port) override;
+    void Close() override;
+    bool IsOpen() const override { return m_socket >= 0; }
+    NetworkAddress GetLocalAddress() const override { return m_localAddress; }
+
+    int SendBatch(NetworkPacket* const* packets, int count) override;
+    int ReceiveBatch(NetworkPacket* const* packets, int count) override;
+    void WaitForData(int timeoutMs) override;
+
+private:
+    int m_socket;
+    NetworkAddress m_localAddress;
+};
+
+/**
+ * Внутрипроцессная замена UDP для тестов. Транспорты одного процесса
+ * находят друг друга по номеру порта (адрес 127.0.0.1); можно задать
+ * долю теряемых пакетов и задержку доставки.
+ */
+class LoopbackTransport : public NetworkTransport {
+public:
+    LoopbackTransport();
+    ~LoopbackTransport() override;
+
+    // Имитация сети (до отправки первых пакетов)
+    void SetPacketLoss(float ratio) { m_packetLoss = ratio; }
+    void SetLatency(float milliseconds) { m_latencyMs = milliseconds; }
+    void SetSeed(uint32_t seed) { m_random = seed; }
+
+    bool Open(uint16_t port) override;
+    void Close() override;
+    bool IsOpen() const override { return m_endpoint != nullptr; }
+    NetworkAddress GetLocalAddress() const override { return m_localAddress; }
+
+    int SendBatch(NetworkPacket* const* packets, int count) override;
+    int ReceiveBatch(NetworkPacket* const* packets, int count) override;
+    void WaitForData(int timeoutMs) override;
+
+    struct Endpoint;
+
+private:
+    std::shared_ptr<Endpoint> m_endpoint;
+    NetworkAddress m_localAddress;
+    float m_packetLoss;
+    float m_latencyMs;
+    uint32_t m_random;
+};
+
+} // namespace FastEngine
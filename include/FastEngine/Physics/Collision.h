@@ -72,6 +72,9 @@ namespace FastEngine {
         // SAT (Separating Axis Theorem) для полигонов
         static bool SATvsSAT(const Polygon& a, const Polygon& b);
         static CollisionInfo SATvsSATInfo(const Polygon& a, const Polygon& b);
+        // То же по массивам вершин; оси считаются на лету, без выделений
+        static bool SATvsSAT(const glm::vec2* a, size_t countA, const glm::vec2* b, size_t countB);
+        static CollisionInfo SATvsSATInfo(const glm::vec2* a, size_t countA, const glm::vec2* b, size_t countB);
         
         // Утилиты
         static AABB TransformAABB(const AABB& aabb, const glm::mat3& transform);
@@ -80,8 +83,9 @@ namespace FastEngine {
         
     private:
         // Вспомогательные функции для SAT
-        static std::vector<glm::vec2> GetAxes(const Polygon& polygon);
-        static glm::vec2 ProjectPolygon(const Polygon& polygon, const glm::vec2& axis);
+        static bool SeparatedByEdges(const glm::vec2* edges, size_t edgeCount,
+                                     const glm::vec2* a, size_t countA, const glm::vec2* b, size_t countB);
+        static glm::vec2 ProjectPoints(const glm::vec2* points, size_t count, const glm::vec2& axis);
         static bool Overlap(const glm::vec2& projection1, const glm::vec2& projection2);
     };
 }
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace FastEngine {
+    /**
+     * Параметры цикла с фиксированным тиком
+     */
+    struct FixedTickConfig {
+        float tickRate;            // Тиков в секунду
+        uint32_t maxCatchUpTicks;  // Отставание, которое догоняется тиками подряд; больше - сбрасывается
+        float spinThreshold;       // Последние секунды ожидания проходят в активном ожидании
+
+        FixedTickConfig() : tickRate(60.0f), maxCatchUpTicks(5), spinThreshold(0.0015f) {}
+        explicit FixedTickConfig(float rate) : tickRate(rate), maxCatchUpTicks(5), spinThreshold(0.0015f) {}
+    };
+
+    /**
+     * Статистика тиков (времена в миллисекундах)
+     */
+    struct TickStats {
+        uint64_t ticks;
+        uint64_t overruns;        // Тик закончился позже начала следующего
+        uint64_t droppedTicks;    // Пропущено при сбросе отставания
+        double tickPeriodMs;
+        double lastTickMs;
+        double averageTickMs;
+        double maxTickMs;
+        double p99TickMs;         // По последним HISTORY_SIZE тикам
+        double averageWakeErrorMs; // Опоздание пробуждения относительно срока тика
+        double maxWakeErrorMs;
+        double load;              // Доля периода, занятая тиком
+
+        TickStats()
+            : ticks(0), overruns(0), droppedTicks(0), tickPeriodMs(0.0), lastTickMs(0.0), averageTickMs(0.0)
+            , maxTickMs(0.0), p99TickMs(0.0), averageWakeErrorMs(0.0), maxWakeErrorMs(0.0), load(0.0) {}
+    };
+
+    /**
+     * Точное ожидание: сон ОС с запасом на его погрешность, затем
+     * активное ожидание с уступкой процессора. Погрешность сна
+     * измеряется на каждом вызове: быстро растет после опоздания
+     * планировщика и медленно спадает.
+     */
+    class PreciseWaiter {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit PreciseWaiter(float spinThreshold = 0.0015f);
+
+        void WaitUntil(Clock::time_point deadline);
+        double GetSleepOvershoot() const { return m_sleepOvershoot; } // с
+
+    private:
+        double m_spinThreshold;
+        double m_sleepOvershoot;
+    };
+
+    /**
+     * Цикл с фиксированным тиком
+     *
+     * Step ждет срока очередного тика и вызывает tick с постоянным шагом
+     * 1/tickRate, поэтому симуляция не зависит от скорости кадров. Тик,
+     * не уложившийся в период, сдвигает следующий без ожидания; отставание
+     * больше maxCatchUpTicks периодов отбрасывается. Каждый тик начинает
+     * кадр FrameArena вызывающего потока. Статистику можно читать из
+     * любого потока.
+     */
+    class FixedTickLoop {
+    public:
+        using Clock = PreciseWaiter::Clock;
+        using TickFunction = std::function<void(float deltaTime, uint64_t tick)>;
+
+        static constexpr size_t HISTORY_SIZE = 512;
+
+        explicit FixedTickLoop(const FixedTickConfig& config = FixedTickConfig());
+
+        // Следующий тик начинается сейчас
+        void Reset();
+        // Дождаться срока и выполнить один тик
+        void Step(const TickFunction& tick);
+        // Тики до сброса running
+        void Run(const TickFunction& tick, const std::atomic<bool>& running);
+
+        float GetDeltaTime() const { return m_deltaTime; }
+        uint64_t GetTickCount() const { return m_tick; }
+        const FixedTickConfig& GetConfig() const { return m_config; }
+
+        TickStats GetStats() const;
+        void ResetStats();
+
+    private:
+        FixedTickConfig m_config;
+        float m_deltaTime;
+        Clock::duration m_period;
+        Clock::time_point m_nextTick;
+        bool m_started;
+        uint64_t m_tick;
+        PreciseWaiter m_waiter;
+
+        // Статистика под мьютексом: пишет поток цикла раз в тик
+        mutable std::mutex m_statsMutex;
+        TickStats m_stats;
+        double m_totalTickMs;
+        double m_totalWakeErrorMs;
+        uint64_t m_wakeSamples;
+        std::vector<float> m_history;
+        size_t m_historyCount;
+    };
+}
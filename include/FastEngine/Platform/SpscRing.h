@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace FastEngine {
+
+/**
+ * Кольцевая очередь без блокировок для одного производителя и одного
+ * потребителя. Емкость округляется вверх до степени двойки.
+ * Push вызывается только из потока-производителя, Pop - только из
+ * потока-потребителя. Индексы головы и хвоста лежат в разных строках кэша,
+ * каждая сторона кэширует чужой индекс и перечитывает его только когда
+ * очередь кажется полной (пустой).
+ */
+template<typename T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacity = 1024)
+        : m_head(0)
+        , m_cachedTail(0)
+        , m_tail(0)
+        , m_cachedHead(0) {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        m_buffer.resize(size);
+        m_mask = size - 1;
+    }
+
+    // Поток-производитель; false, если очередь полна
+    bool Push(const T& value) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead == m_buffer.size()) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead == m_buffer.size()) {
+                return false;
+            }
+        }
+        m_buffer[tail & m_mask] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Поток-потребитель; false, если очередь пуста
+    bool Pop(T& value) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cachedTail) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail) {
+                return false;
+            }
+        }
+        value = m_buffer[head & m_mask];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t GetCapacity() const { return m_buffer.size(); }
+
+    // Приблизительный размер (точен, только если другой поток не работает с очередью)
+    size_t GetSize() const {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+    bool IsEmpty() const { return GetSize() == 0; }
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    std::vector<T> m_buffer;
+    size_t m_mask;
+
+    // Сторона потребителя
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_head;
+    size_t m_cachedTail;
+
+    // Сторона производителя
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_tail;
+    size_t m_cachedHead;
+};
+
+} // namespace FastEngine
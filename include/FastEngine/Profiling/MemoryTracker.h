@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace FastEngine {
+
+/**
+ * Тег подсистемы для учета памяти; 0 - без тега
+ */
+using MemoryTag = uint8_t;
+
+/**
+ * Счетчики одного тега
+ */
+struct MemoryTagStats {
+    MemoryTag tag;
+    int64_t liveBytes;
+    uint64_t allocations;
+    uint64_t frees;
+    uint64_t bytesAllocated;
+
+    MemoryTagStats() : tag(0), liveBytes(0), allocations(0), frees(0), bytesAllocated(0) {}
+};
+
+/**
+ * Сумма счетчиков всех потоков на момент запроса
+ */
+struct MemoryTrackerSnapshot {
+    std::vector<MemoryTagStats> tags; // Индекс - тег
+    int64_t liveBytes;
+    uint64_t allocations;
+    uint64_t frees;
+    uint64_t bytesAllocated;
+
+    MemoryTrackerSnapshot() : liveBytes(0), allocations(0), frees(0), bytesAllocated(0) {}
+};
+
+/**
+ * Живое выделение со снятым стеком вызовов
+ */
+struct AllocationSample {
+    static constexpr uint32_t MAX_FRAMES = 16;
+
+    const void* address;
+    size_t size;
+    MemoryTag tag;
+    uint32_t depth;
+    void* frames[MAX_FRAMES];
+};
+
+/**
+ * Учет выделений памяти
+ *
+ * Allocate/Free добавляют к блоку 16-байтный заголовок (размер, тег,
+ * смещение выравнивания) и ведут счетчики по тегам. Ими пользуются
+ * замена глобальных operator new/delete (сборка с
+ * FASTENGINE_TRACK_ALLOCATIONS) и аллокаторы движка; аллокаторы со
+ * своей памятью (пулы, арены) сообщают о выделениях через
+ * OnAllocate/OnFree.
+ *
+ * Тег берется с вершины стека тегов потока (MemoryTagScope). Каждый
+ * поток пишет в свой блок счетчиков без атомарных операций чтения-
+ * записи; GetSnapshot суммирует блоки. Блок завершившегося потока
+ * достается следующему новому потоку, его значения сохраняются.
+ * Пиковое значение снимается по снимкам, а не по каждому выделению.
+ * Выключенный учет - одна проверка флага на выделение.
+ */
+class MemoryTracker {
+public:
+    static constexpr uint32_t MAX_TAGS = 64;
+    static constexpr uint32_t MAX_TAG_DEPTH = 32;
+    static constexpr uint32_t MAX_SAMPLES = 1024;
+    static constexpr size_t DEFAULT_ALIGNMENT = 16;
+    static constexpr MemoryTag UNTAGGED = 0;
+    // Результат OnAllocate при выключенном учете
+    static constexpr MemoryTag NOT_TRACKED = 0xFF;
+
+    // Учитываются выделения, сделанные после включения
+    static void SetEnabled(bool enabled);
+    static bool IsEnabled();
+    // Стек вызовов каждого N-го выделения; 0 - выключено
+    static void SetSampleRate(uint32_t everyN);
+    static uint32_t GetSampleRate();
+    // Заменены ли глобальные operator new/delete
+    static bool HasGlobalHooks();
+
+    // Теги подсистем; UNTAGGED, если таблица заполнена
+    static MemoryTag RegisterTag(const char* name);
+    static const char* GetTagName(MemoryTag tag);
+    static uint32_t GetTagCount();
+    static void PushTag(MemoryTag tag);
+    static void PopTag();
+    static MemoryTag GetCurrentTag();
+
+    // nullptr при нехватке памяти; alignment - степень двойки
+    static void* Allocate(size_t size, size_t alignment = DEFAULT_ALIGNMENT) noexcept;
+    static void Free(void* pointer) noexcept;
+    static size_t GetAllocationSize(const void* pointer);
+
+    // Учет памяти, которую аллокатор раздает сам; OnFree получает тег,
+    // возвращенный OnAllocate
+    static MemoryTag OnAllocate(size_t size);
+    static void OnFree(size_t size, MemoryTag tag);
+
+    static MemoryTrackerSnapshot GetSnapshot();
+    static std::vector<AllocationSample> GetLiveSamples();
+    // Символ кадра стека или адрес, если символов нет
+    static std::string DescribeFrame(void* frame);
+};
+
+/**
+ * Тег до конца блока
+ */
+class MemoryTagScope {
+public:
+    explicit MemoryTagScope(MemoryTag tag) { MemoryTracker::PushTag(tag); }
+    ~MemoryTagScope() { MemoryTracker::PopTag(); }
+
+    MemoryTagScope(const MemoryTagScope&) = delete;
+    MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+};
+
+} // namespace FastEngine
+
+#define FASTENGINE_MEMORY_CONCAT_INNER(a, b) a##b
+#define FASTENGINE_MEMORY_CONCAT(a, b) FASTENGINE_MEMORY_CONCAT_INNER(a, b)
+
+// Тег подсистемы до конца блока; name - строковый литерал
+#define FASTENGINE_MEMORY_TAG(name) \
+    static const ::FastEngine::MemoryTag FASTENGINE_MEMORY_CONCAT(_memory_tag_, __LINE__) = \
+        ::FastEngine::MemoryTracker::RegisterTag(name); \
+    ::FastEngine::MemoryTagScope FASTENGINE_MEMORY_CONCAT(_memory_scope_, __LINE__)( \
+        FASTENGINE_MEMORY_CONCAT(_memory_tag_, __LINE__))
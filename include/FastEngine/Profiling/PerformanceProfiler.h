@@ -1,5 +1,9 @@
 #pragma once
 
+#include "FastEngine/Profiling/MemoryTracker.h"
+#include "FastEngine/Profiling/QuantileSketch.h"
+#include "FastEngine/Profiling/ScopeProfiler.h"
+#include "FastEngine/Profiling/TraceCapture.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -44,6 +48,10 @@ struct PerformanceMetric {
 
 /**
  * Статистика производительности
+ *
+ * Перцентили оцениваются гистограммой QuantileSketch: память постоянная,
+ * запрос любого перцентиля - O(1), статистики разных потоков
+ * объединяются через Merge. Update поддерживает все поля.
  */
 struct PerformanceStats {
     double min = 0.0;
@@ -53,7 +61,8 @@ struct PerformanceStats {
     double p95 = 0.0;
     double p99 = 0.0;
     size_t sampleCount = 0;
-    std::chrono::milliseconds totalTime;
+    std::chrono::milliseconds totalTime{0};
+    QuantileSketch sketch;
     
     void Update(double value) {
         if (sampleCount == 0) {
@@ -64,51 +73,79 @@ struct PerformanceStats {
             average = (average * sampleCount + value) / (sampleCount + 1);
         }
         sampleCount++;
+        sketch.Add(value);
+        RefreshPercentiles();
+    }
+    
+    void Merge(const PerformanceStats& other) {
+        if (other.sampleCount == 0) {
+            return;
+        }
+        if (sampleCount == 0) {
+            *this = other;
+            return;
+        }
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+        average = (average * sampleCount + other.average * other.sampleCount) / (sampleCount + other.sampleCount);
+        sampleCount += other.sampleCount;
+        totalTime += other.totalTime;
+        sketch.Merge(other.sketch);
+        RefreshPercentiles();
+    }
+    
+    // Любой перцентиль, q в [0, 1]
+    double GetPercentile(double q) const { return sketch.GetQuantile(q); }
+    
+    void RefreshPercentiles() {
+        median = sketch.GetQuantile(0.5);
+        p95 = sketch.GetQuantile(0.95);
+        p99 = sketch.GetQuantile(0.99);
     }
 };
 
 /**
  * CPU Profiler
+ *
+ * Области пишутся в ScopeProfiler (кольцевые буферы потоков без
+ * блокировок); пока профилирование идет, каждая завершенная область
+ * любого потока добавляется в кольцо последних m_maxSamples метрик.
+ * Строковые BeginSample/EndSample регистрируют имя при каждом вызове -
+ * в горячем коде нужен идентификатор или FASTENGINE_PROFILE_SCOPE.
  */
 class CPUProfiler {
 public:
     CPUProfiler();
-    ~CPUProfiler() = default;
+    ~CPUProfiler();
     
     // Управление профилированием
     void StartProfiling();
     void StopProfiling();
     void Reset();
     
-    // Измерение времени выполнения
+    // Измерение времени выполнения; области вкладываются, EndSample
+    // закрывает последнюю открытую область потока
     void BeginSample(const std::string& name);
     void EndSample(const std::string& name);
+    void BeginSample(ProfileNameId name);
+    void EndSample();
     
     // Получение статистики
     PerformanceStats GetStats(const std::string& name) const;
     std::vector<PerformanceMetric> GetMetrics() const;
     
     // Настройки
-    void SetMaxSamples(size_t maxSamples) { m_maxSamples = maxSamples; }
+    void SetMaxSamples(size_t maxSamples);
     void SetSamplingRate(float rate) { m_samplingRate = rate; }
     
 private:
-    struct Sample {
-        std::string name;
-        std::chrono::high_resolution_clock::time_point startTime;
-        std::chrono::high_resolution_clock::time_point endTime;
-        double duration;
-        bool active;
-        
-        Sample() : duration(0.0), active(false) {}
-    };
-    
-    std::map<std::string, Sample> m_samples;
-    std::vector<PerformanceMetric> m_metrics;
+    std::vector<PerformanceMetric> m_metrics; // Кольцо; m_nextMetric - самая старая, когда заполнено
+    size_t m_nextMetric;
     std::mutex m_mutex;
     std::atomic<bool> m_profiling;
     size_t m_maxSamples;
     float m_samplingRate;
+    uint32_t m_listener;
     std::chrono::high_resolution_clock::time_point m_profilingStart;
     
     void AddMetric(const std::string& name, double duration);
@@ -141,6 +178,7 @@ public:
     void RecordVertices(int count);
     void RecordTextureMemory(size_t bytes);
     void RecordBufferMemory(size_t bytes);
+    int GetDrawCalls() const;
     
 private:
     struct GPUQuery {
@@ -156,6 +194,7 @@ private:
     
     std::map<std::string, GPUQuery> m_queries;
     std::vector<PerformanceMetric> m_metrics;
+    std::map<std::string, PerformanceStats> m_stats; // Обновляются при записи
     std::mutex m_mutex;
     std::atomic<bool> m_profiling;
     
@@ -189,15 +228,26 @@ public:
     void RecordDeallocation(const std::string& category, size_t size);
     void RecordMemoryUsage(const std::string& category, size_t current, size_t peak);
     
+    // Раз в кадр: счетчики MemoryTracker по тегам становятся категориями
+    void CaptureTrackedAllocations();
+    
     // Получение статистики
     PerformanceStats GetStats(const std::string& category) const;
     std::vector<PerformanceMetric> GetMetrics() const;
     size_t GetTotalMemoryUsage() const;
     size_t GetPeakMemoryUsage() const;
     
+    // Данные MemoryTracker на последнем захвате
+    int64_t GetTrackedMemoryUsage() const;
+    int64_t GetTrackedPeakMemoryUsage() const;
+    uint64_t GetAllocationsPerFrame() const;
+    PerformanceStats GetAllocationStats() const;
+    
     // Анализ утечек памяти
     void DetectMemoryLeaks();
     std::vector<std::string> GetMemoryLeaks() const;
+    // Живые выделения из выборки, сгруппированные по стеку; крупные первыми
+    std::vector<std::string> GetAllocationSites(size_t maxSites = 10) const;
     
 private:
     struct MemoryCategory {
@@ -219,6 +269,14 @@ private:
     size_t m_totalMemory;
     size_t m_peakMemory;
     
+    // Учет MemoryTracker
+    int64_t m_trackedMemory;
+    int64_t m_trackedPeak;
+    uint64_t m_lastAllocationCount;
+    uint64_t m_allocationsPerFrame;
+    bool m_trackedCaptured;
+    PerformanceStats m_allocationStats;
+    
     void AddMetric(const std::string& category, double value, const std::string& unit = "bytes");
 };
 
@@ -295,6 +353,13 @@ public:
     void ExportToJSON(const std::string& filename) const;
     void ExportToHTML(const std::string& filename) const;
     
+    // Трасса Chrome Trace Event (chrome://tracing, ui.perfetto.dev):
+    // события областей, счетчики и связи по кадрам
+    bool CaptureFrames(const std::string& filename, uint32_t frames);
+    void SetSpikeCapture(double thresholdMs, uint32_t framesBefore, uint32_t framesAfter, const std::string& filePrefix);
+    void DisableSpikeCapture();
+    TraceCapture& GetTraceCapture() { return TraceCapture::GetInstance(); }
+    
     // Настройки
     void SetMonitoringEnabled(bool enabled) { m_monitoringEnabled = enabled; }
     void SetExportEnabled(bool enabled) { m_exportEnabled = enabled; }
@@ -315,6 +380,7 @@ private:
     std::atomic<bool> m_exportEnabled;
     float m_exportInterval;
     float m_exportTimer;
+    int m_lastDrawCalls;
     
     std::function<void(const std::string&, double)> m_performanceAlertCallback;
     
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace FastEngine {
+
+/**
+ * Потоковая оценка перцентилей - логарифмически-линейная гистограмма
+ * (как HDR histogram)
+ *
+ * Корзина - двоичный порядок значения и старшие SUB_BITS бит мантиссы,
+ * поэтому относительная ошибка не больше 1/64 при любых единицах
+ * (миллисекунды, байты). Порядки от 2^MIN_EXPONENT до 2^MAX_EXPONENT;
+ * значения вне диапазона попадают в крайние корзины, для них ответ -
+ * точные min и max.
+ * Память постоянная, Add - O(1), GetQuantile - не больше GROUPS +
+ * SUB_BUCKETS шагов. Гистограммы разных потоков складываются через Merge.
+ * Переполнение корзины уменьшает все счетчики вдвое - форма
+ * распределения сохраняется.
+ */
+class QuantileSketch {
+public:
+    static constexpr int SUB_BITS = 5;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BITS;
+    static constexpr int MIN_EXPONENT = -20;
+    static constexpr int MAX_EXPONENT = 43;
+    static constexpr int GROUPS = MAX_EXPONENT - MIN_EXPONENT + 1;
+    static constexpr int BUCKETS = GROUPS * SUB_BUCKETS;
+
+    QuantileSketch() { Reset(); }
+
+    // Значения должны быть неотрицательными; отрицательные считаются нулем
+    void Add(double value) {
+        if (!(value > 0.0)) {
+            value = 0.0;
+        }
+        if (m_count == 0) {
+            m_min = m_max = value;
+        } else {
+            m_min = value < m_min ? value : m_min;
+            m_max = value > m_max ? value : m_max;
+        }
+        m_count++;
+        m_weight++;
+
+        const int index = GetBucket(value);
+        m_groups[index >> SUB_BITS]++;
+        if (++m_buckets[index] == UINT32_MAX) {
+            Halve();
+        }
+    }
+
+    void Merge(const QuantileSketch& other);
+    void Reset();
+
+    // q в [0, 1]; 0 - пустая гистограмма
+    double GetQuantile(double q) const;
+
+    // Число значений с последнего Reset (не уменьшается при Halve)
+    uint64_t GetCount() const { return m_count; }
+    double GetMin() const { return m_min; }
+    double GetMax() const { return m_max; }
+
+    static int GetBucket(double value) {
+        if (value <= 0.0) {
+            return 0;
+        }
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        const int exponent = static_cast<int>((bits >> 52) & 0x7FF) - 1023;
+        if (exponent < MIN_EXPONENT) {
+            return 0;
+        }
+        if (exponent > MAX_EXPONENT) {
+            return BUCKETS - 1;
+        }
+        const int sub = static_cast<int>((bits >> (52 - SUB_BITS)) & (SUB_BUCKETS - 1));
+        return ((exponent - MIN_EXPONENT) << SUB_BITS) | sub;
+    }
+
+    // Середина корзины
+    static double GetBucketValue(int bucket);
+
+private:
+    std::array<uint32_t, BUCKETS> m_buckets;
+    std::array<uint64_t, GROUPS> m_groups; // Суммы корзин порядка - для быстрого поиска
+    uint64_t m_count;
+    uint64_t m_weight;                     // Сумма корзин; после Halve меньше m_count
+    double m_min;
+    double m_max;
+
+    void Halve();
+};
+
+} // namespace FastEngine
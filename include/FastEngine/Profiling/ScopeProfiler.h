@@ -0,0 +1,317 @@
+#pragma once
+
+#include "FastEngine/Profiling/QuantileSketch.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define FASTENGINE_PROFILE_TSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define FASTENGINE_PROFILE_TSC
+#endif
+
+namespace FastEngine {
+
+template<typename T>
+class SpscRing;
+
+struct ProfileThreadBuffer;
+
+/**
+ * Идентификатор имени области профилирования; 0 - нет имени
+ */
+using ProfileNameId = uint32_t;
+
+/**
+ * Таблица имен областей
+ *
+ * Имя регистрируется один раз (макрос FASTENGINE_PROFILE_SCOPE хранит
+ * идентификатор в статической переменной), события содержат только
+ * идентификатор. Строки не удаляются до завершения программы.
+ */
+class ProfileNames {
+public:
+    static ProfileNameId Register(const std::string& name);
+    // 0, если имя не зарегистрировано
+    static ProfileNameId Find(const std::string& name);
+    static const std::string& Get(ProfileNameId id);
+    static uint32_t GetCount();
+};
+
+/**
+ * Часы профилировщика: TSC на x86, виртуальный счетчик на ARM64,
+ * steady_clock на остальных платформах
+ */
+class ProfileClock {
+public:
+    static uint64_t Now() {
+#if defined(FASTENGINE_PROFILE_TSC)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t ticks;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+        return ticks;
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    // Частота калибруется при первом вызове (около 20 мс на x86)
+    static double GetTicksPerMillisecond();
+    static double ToMilliseconds(uint64_t ticks) { return ticks / GetTicksPerMillisecond(); }
+};
+
+/**
+ * Событие кольцевого буфера потока - 16 байт
+ */
+struct ProfileEvent {
+    enum Kind : uint8_t {
+        BEGIN,
+        END
+    };
+
+    uint64_t ticks;
+    ProfileNameId name;
+    uint16_t depth;
+    uint8_t kind;
+    uint8_t reserved;
+};
+
+/**
+ * Завершенная область; передается слушателям из потока агрегации
+ */
+struct CompletedScope {
+    ProfileNameId name;
+    uint32_t thread;   // Порядковый номер потока в профилировщике
+    uint16_t depth;
+    uint64_t startTicks;
+    uint64_t endTicks;
+
+    double GetDurationMs() const { return ProfileClock::ToMilliseconds(endTicks - startTicks); }
+};
+
+/**
+ * Узел дерева вызовов кадра: одинаковые области под одним родителем
+ * в одном потоке объединены
+ */
+struct ProfileNode {
+    static constexpr uint32_t NO_NODE = 0xFFFFFFFFu;
+
+    ProfileNameId name;
+    uint32_t thread;
+    uint32_t parent;
+    uint32_t firstChild;
+    uint32_t nextSibling;
+    uint16_t depth;
+    uint32_t calls;
+    double totalMs;
+    double selfMs;     // Без вложенных областей
+};
+
+/**
+ * Кадр между двумя вызовами MarkFrame
+ */
+struct ProfileFrame {
+    uint64_t index;
+    uint64_t startTicks;
+    uint64_t endTicks;
+    double durationMs;
+    std::vector<ProfileNode> nodes; // Корни - с parent == NO_NODE
+
+    ProfileFrame() : index(0), startTicks(0), endTicks(0), durationMs(0.0) {}
+};
+
+/**
+ * Накопленная статистика области; перцентили - по гистограмме всех
+ * вызовов с последнего ResetStats
+ */
+struct ScopeStats {
+    ProfileNameId name;
+    uint64_t calls;
+    double totalMs;
+    double minMs;
+    double maxMs;
+    double lastMs;
+    double p50Ms;
+    double p95Ms;
+    double p99Ms;
+
+    ScopeStats() : name(0), calls(0), totalMs(0.0), minMs(0.0), maxMs(0.0), lastMs(0.0),
+                   p50Ms(0.0), p95Ms(0.0), p99Ms(0.0) {}
+    double GetAverageMs() const { return calls ? totalMs / calls : 0.0; }
+};
+
+/**
+ * Иерархический профилировщик CPU
+ *
+ * Begin/End пишут 16-байтное событие (тики, идентификатор имени,
+ * глубина) в кольцевой буфер SPSC своего потока - без блокировок и
+ * выделений памяти. Фоновый поток агрегации забирает события, собирает
+ * завершенные области, статистику по именам и деревья вызовов кадров.
+ * Переполненный буфер теряет события (GetDroppedEvents); агрегатор
+ * восстанавливает вложенность по глубине событий. Область принадлежит
+ * кадру, в котором завершилась ее корневая область; кадр закрывается
+ * после следующего MarkFrame, то есть с задержкой на кадр.
+ */
+class ScopeProfiler {
+public:
+    static constexpr size_t DEFAULT_THREAD_CAPACITY = 16384;
+    static constexpr size_t DEFAULT_FRAME_HISTORY = 120;
+
+    static ScopeProfiler& GetInstance();
+
+    ScopeProfiler(const ScopeProfiler&) = delete;
+    ScopeProfiler& operator=(const ScopeProfiler&) = delete;
+
+    // Горячий путь; Begin возвращает false, если запись выключена
+    static bool Begin(ProfileNameId name);
+    static void End();
+    static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    // Граница кадра; вызывается из одного потока (главного)
+    static void MarkFrame();
+
+    // Имя потока для отчетов; регистрирует поток
+    static void SetThreadName(const std::string& name);
+    // Порядковый номер вызывающего потока; регистрирует поток.
+    // NO_THREAD - поток уже завершается
+    static constexpr uint32_t NO_THREAD = 0xFFFFFFFFu;
+    static uint32_t GetCurrentThread();
+
+    // Счетчик пользователей: первый Start включает запись и поток
+    // агрегации, последний Stop сбрасывает буферы и останавливает его
+    void Start();
+    void Stop();
+    bool IsRunning() const;
+
+    // Немедленная агрегация в вызывающем потоке
+    void Flush();
+    // Сбрасывает статистику и историю кадров, имена и потоки остаются
+    void ResetStats();
+
+    // Настройки; емкость применяется к потокам, зарегистрированным позже
+    void SetThreadCapacity(size_t events) { m_threadCapacity.store(events, std::memory_order_relaxed); }
+    size_t GetThreadCapacity() const { return m_threadCapacity.load(std::memory_order_relaxed); }
+    void SetAggregationInterval(std::chrono::milliseconds interval) {
+        m_intervalMs.store(static_cast<uint32_t>(interval.count()), std::memory_order_relaxed);
+    }
+    void SetFrameHistory(size_t frames);
+
+    // Результаты
+    ScopeStats GetStats(ProfileNameId name) const;
+    // O(1) для любого q в [0, 1]; гистограмма - для объединения и своих перцентилей
+    double GetPercentile(ProfileNameId name, double q) const;
+    bool GetSketch(ProfileNameId name, QuantileSketch& sketch) const;
+    std::vector<ScopeStats> GetAllStats() const;
+    bool GetLastFrame(ProfileFrame& frame) const;
+    std::vector<ProfileFrame> GetFrameHistory() const;
+    uint64_t GetDroppedEvents() const;
+    uint32_t GetThreadCount() const;
+    std::string GetThreadName(uint32_t thread) const;
+
+    // Слушатели завершенных областей и закрытых кадров вызываются в
+    // потоке агрегации; кадр приходит после всех разобранных к этому
+    // моменту областей. После Remove* слушатель больше не вызывается.
+    // Из слушателя можно вызывать только GetThreadName и GetThreadCount
+    using Listener = std::function<void(const CompletedScope&)>;
+    uint32_t AddListener(Listener listener);
+    void RemoveListener(uint32_t id);
+    using FrameListener = std::function<void(const ProfileFrame&)>;
+    uint32_t AddFrameListener(FrameListener listener);
+    void RemoveFrameListener(uint32_t id);
+
+    /**
+     * Область до конца блока
+     */
+    class Scope {
+    public:
+        explicit Scope(ProfileNameId name) : m_active(Begin(name)) {}
+        ~Scope() {
+            if (m_active) {
+                End();
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        bool m_active;
+    };
+
+private:
+    struct ThreadState;
+    struct NameStats;
+    struct PendingRoot;
+
+    ScopeProfiler();
+    ~ScopeProfiler();
+
+    static std::atomic<bool> s_enabled;
+
+    static ProfileThreadBuffer* RegisterThread();
+
+    // Потоки; буфер завершившегося потока удаляется после разбора
+    mutable std::mutex m_threadsMutex;
+    std::vector<std::shared_ptr<ProfileThreadBuffer>> m_threads;
+    std::vector<std::string> m_threadNames;
+    std::atomic<size_t> m_threadCapacity;
+    std::atomic<uint64_t> m_retiredDropped;
+
+    // Кадры: MarkFrame -> поток агрегации
+    std::unique_ptr<SpscRing<uint64_t>> m_frameMarkers;
+    std::atomic<uint64_t> m_droppedMarkers;
+
+    // Поток агрегации
+    std::mutex m_controlMutex;
+    int m_users;
+    std::thread m_aggregator;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+    bool m_stopAggregator;
+    std::atomic<uint32_t> m_intervalMs;
+
+    // Состояние агрегации и результаты
+    mutable std::mutex m_mutex;
+    std::vector<ThreadState> m_states;
+    std::vector<NameStats> m_stats;
+    std::vector<PendingRoot> m_pendingRoots; // Корневые области, ждущие закрытия кадра
+    std::deque<uint64_t> m_frameStarts;      // Начала незакрытых кадров
+    uint64_t m_nextFrameIndex;
+    std::deque<ProfileFrame> m_frames;
+    size_t m_frameHistory;
+    std::vector<std::pair<uint32_t, Listener>> m_listeners;
+    std::vector<std::pair<uint32_t, FrameListener>> m_frameListeners;
+    uint32_t m_nextListenerId;
+
+    void AggregatorThreadFunction();
+    void Aggregate();
+    void DrainThread(ProfileThreadBuffer& buffer);
+    void CompleteScope(const CompletedScope& scope);
+    void CloseFrames();
+    static void MergeRoot(ProfileFrame& frame, const PendingRoot& root);
+};
+
+} // namespace FastEngine
+
+#define FASTENGINE_PROFILE_CONCAT_INNER(a, b) a##b
+#define FASTENGINE_PROFILE_CONCAT(a, b) FASTENGINE_PROFILE_CONCAT_INNER(a, b)
+
+// Область до конца блока; name - строковый литерал или __FUNCTION__
+#define FASTENGINE_PROFILE_SCOPE(name) \
+    static const ::FastEngine::ProfileNameId FASTENGINE_PROFILE_CONCAT(_profile_id_, __LINE__) = \
+        ::FastEngine::ProfileNames::Register(name); \
+    ::FastEngine::ScopeProfiler::Scope FASTENGINE_PROFILE_CONCAT(_profile_scope_, __LINE__)( \
+        FASTENGINE_PROFILE_CONCAT(_profile_id_, __LINE__))
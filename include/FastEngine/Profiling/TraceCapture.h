@@ -0,0 +1,205 @@
+#pragma once
+
+#include "FastEngine/Profiling/ScopeProfiler.h"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace FastEngine {
+
+/**
+ * Потоковая запись Chrome Trace Event JSON
+ *
+ * События пишутся в файл по мере поступления, в памяти ничего не
+ * накапливается. Файл открывается в chrome://tracing и ui.perfetto.dev.
+ * Время - в микросекундах от начала записи.
+ */
+class TraceWriter {
+public:
+    // Дорожка кадров в отчете
+    static constexpr uint32_t FRAME_TRACK = 0xFFFFu;
+
+    TraceWriter();
+    ~TraceWriter();
+
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+
+    bool Open(const std::string& filename);
+    void Close();
+    bool IsOpen() const { return m_file.is_open(); }
+
+    void WriteThreadName(uint32_t thread, const std::string& name);
+    void WriteSlice(const std::string& name, const char* category, uint32_t thread, double startUs, double durationUs);
+    void WriteCounter(const std::string& name, double timeUs, double value);
+    // Связь между областями разных потоков: начало привязывается к
+    // объемлющей области отправителя, конец - к области получателя
+    void WriteFlow(const std::string& name, uint64_t id, uint32_t thread, double timeUs, bool start);
+
+    uint64_t GetEventCount() const { return m_events; }
+
+private:
+    std::ofstream m_file;
+    uint64_t m_events;
+
+    void BeginEvent();
+    void WriteString(const std::string& value);
+};
+
+/**
+ * Событие захвата: завершенная область, значение счетчика или точка связи
+ */
+struct TraceEvent {
+    enum Kind : uint8_t {
+        SLICE,
+        COUNTER,
+        FLOW_BEGIN,
+        FLOW_END
+    };
+
+    uint8_t kind;
+    uint32_t thread;
+    ProfileNameId name;
+    uint64_t startTicks;
+    uint64_t endTicks;   // Для счетчиков и связей совпадает с началом
+    uint64_t flowId;
+    double value;
+};
+
+/**
+ * Итоги завершенного захвата
+ */
+struct TraceCaptureInfo {
+    std::string filename;
+    uint64_t firstFrame;
+    uint64_t lastFrame;
+    uint32_t frames;
+    uint64_t events;
+    bool spike;          // Запущен триггером пиков
+    double spikeMs;      // Длительность кадра, вызвавшего захват
+
+    TraceCaptureInfo() : firstFrame(0), lastFrame(0), frames(0), events(0), spike(false), spikeMs(0.0) {}
+};
+
+/**
+ * Захват кадров в трассу
+ *
+ * Области приходят от ScopeProfiler, счетчики и связи пишутся из любого
+ * потока через Counter/FlowBegin/FlowEnd. События копятся до закрытия
+ * своего кадра и сразу уходят в файл, поэтому длинный захват не растет
+ * в памяти. Триггер пиков держит последние кадры и, если кадр дольше
+ * порога, пишет их, сам кадр и несколько следующих в отдельный файл.
+ * Пока нет ни захвата, ни триггера, Counter и Flow* - одна проверка флага.
+ */
+class TraceCapture {
+public:
+    static constexpr size_t MAX_PENDING_EVENTS = 1 << 20;
+
+    static TraceCapture& GetInstance();
+
+    TraceCapture(const TraceCapture&) = delete;
+    TraceCapture& operator=(const TraceCapture&) = delete;
+
+    // Запись из любого потока
+    static bool IsRecording() { return s_recording.load(std::memory_order_relaxed); }
+    static void Counter(ProfileNameId name, double value);
+    static void FlowBegin(ProfileNameId name, uint64_t id);
+    static void FlowEnd(ProfileNameId name, uint64_t id);
+
+    // Захват кадров, начинающихся после вызова; false, если захват уже
+    // идет или файл не открылся
+    bool StartCapture(const std::string& filename, uint32_t frames);
+    // Досрочное завершение: в файле остаются закрытые кадры
+    void StopCapture();
+    bool IsCapturing() const;
+
+    // Файлы триггера: <filePrefix>_frame<номер кадра>.json
+    void SetSpikeTrigger(double thresholdMs, uint32_t framesBefore, uint32_t framesAfter, const std::string& filePrefix);
+    void DisableSpikeTrigger();
+    bool IsSpikeTriggerEnabled() const;
+
+    // Отключает слушатели профилировщика после автоматического
+    // завершения захвата; вызывается раз в кадр (PerformanceMonitor::Update)
+    void Update();
+
+    uint32_t GetCaptureCount() const;
+    bool GetLastCapture(TraceCaptureInfo& info) const;
+    uint64_t GetDroppedEvents() const;
+
+    // Вызывается в потоке агрегации ScopeProfiler; из обработчика нельзя
+    // обращаться к TraceCapture и ScopeProfiler
+    void SetOnCaptureComplete(std::function<void(const TraceCaptureInfo&)> callback);
+
+private:
+    struct FrameEvents {
+        uint64_t index;
+        uint64_t startTicks;
+        uint64_t endTicks;
+        double durationMs;
+        std::vector<TraceEvent> events;
+    };
+
+    TraceCapture();
+    ~TraceCapture();
+
+    static std::atomic<bool> s_recording;
+
+    // Подключение к ScopeProfiler; под m_controlMutex
+    std::mutex m_controlMutex;
+    bool m_attached;
+    uint32_t m_scopeListener;
+    uint32_t m_frameListener;
+
+    // Состояние захвата; слушатели берут m_mutex под мьютексом ScopeProfiler
+    mutable std::mutex m_mutex;
+    std::vector<TraceEvent> m_pending;     // События незакрытых кадров
+    std::deque<FrameEvents> m_history;     // Последние кадры для триггера
+    uint64_t m_dropped;
+
+    TraceWriter m_writer;
+    bool m_capturing;
+    bool m_captureStarted;
+    uint64_t m_captureFrom;                // Захватываются кадры, начавшиеся позже
+    uint64_t m_baseTicks;                  // Ноль времени в файле
+    uint32_t m_framesLeft;
+    std::vector<bool> m_namedThreads;
+    TraceCaptureInfo m_current;
+
+    bool m_triggerEnabled;
+    double m_thresholdMs;
+    uint32_t m_framesBefore;
+    uint32_t m_framesAfter;
+    std::string m_filePrefix;
+
+    uint32_t m_captureCount;
+    TraceCaptureInfo m_lastCapture;
+    std::function<void(const TraceCaptureInfo&)> m_onCaptureComplete;
+
+    void Record(const TraceEvent& event);
+    void UpdateRecording();
+    void Attach();
+    void DetachIfIdle();
+
+    void OnScope(const CompletedScope& scope);
+    void OnFrame(const ProfileFrame& frame);
+    bool OpenCapture(const std::string& filename, uint64_t baseTicks);
+    void WriteFrame(const FrameEvents& frame);
+    void FinishCapture();
+    double ToMicroseconds(uint64_t ticks) const;
+};
+
+} // namespace FastEngine
+
+// Значение счетчика в трассе; name - строковый литерал
+#define FASTENGINE_TRACE_COUNTER(name, value) \
+    do { \
+        if (::FastEngine::TraceCapture::IsRecording()) { \
+            static const ::FastEngine::ProfileNameId _trace_counter_id = ::FastEngine::ProfileNames::Register(name); \
+            ::FastEngine::TraceCapture::Counter(_trace_counter_id, static_cast<double>(value)); \
+        } \
+    } while (0)
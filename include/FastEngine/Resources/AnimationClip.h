@@ -0,0 +1,97 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace FastEngine {
+    enum class AnimationType {
+        Loop,       // Зацикленная анимация
+        Once,       // Одноразовая анимация
+        PingPong    // Анимация туда-обратно
+    };
+
+    struct AnimationFrame {
+        std::string texturePath;
+        float duration;     // Длительность кадра в секундах
+        glm::vec2 offset;   // Смещение спрайта
+        glm::vec2 size;     // Размер спрайта
+        glm::vec4 uvRect;   // Область атласа: u0, v0, u1, v1
+
+        AnimationFrame() : duration(0.1f), offset(0.0f), size(1.0f), uvRect(0.0f, 0.0f, 1.0f, 1.0f) {}
+        AnimationFrame(const std::string& path, float dur = 0.1f)
+            : texturePath(path), duration(dur), offset(0.0f), size(1.0f), uvRect(0.0f, 0.0f, 1.0f, 1.0f) {}
+        AnimationFrame(const glm::vec4& rect, float dur = 0.1f)
+            : duration(dur), offset(0.0f), size(1.0f), uvRect(rect) {}
+    };
+
+    struct Animation {
+        std::string name;
+        std::vector<AnimationFrame> frames;
+        AnimationType type;
+        float speed;        // Скорость воспроизведения (множитель)
+        bool autoPlay;      // Автоматический запуск
+
+        Animation() : type(AnimationType::Loop), speed(1.0f), autoPlay(false) {}
+        Animation(const std::string& animName)
+            : name(animName), type(AnimationType::Loop), speed(1.0f), autoPlay(false) {}
+    };
+
+    using AnimationClipHandle = uint32_t;
+    constexpr AnimationClipHandle INVALID_ANIMATION_CLIP = 0;
+
+    /**
+     * Неизменяемый клип анимации
+     *
+     * Длительности и UV-прямоугольники кадров лежат в отдельных
+     * массивах для прохода AnimationSystem; исходное описание хранится
+     * для редактора и GetCurrentFrameData.
+     */
+    struct AnimationClip {
+        Animation source;
+        std::vector<float> frameDurations; // Не меньше MIN_FRAME_DURATION
+        std::vector<glm::vec4> uvRects;
+        float duration;                    // Сумма длительностей кадров
+        float cycleDuration;               // Период Loop/PingPong; 0 - Once
+
+        static constexpr float MIN_FRAME_DURATION = 1e-4f;
+
+        uint32_t GetFrameCount() const { return static_cast<uint32_t>(frameDurations.size()); }
+        const std::string& GetName() const { return source.name; }
+    };
+
+    // UV-прямоугольник ячейки атласа-сетки: ячейки слева направо, сверху вниз
+    glm::vec4 AtlasGridRect(uint32_t columns, uint32_t rows, uint32_t index);
+
+    /**
+     * Общее хранилище клипов анимации
+     *
+     * Аниматоры ссылаются на клипы по целочисленному дескриптору.
+     * Одинаковые анимации (имя, тип, скорость и кадры) регистрируются
+     * один раз, поэтому тысячи сущностей с одной анимацией делят один
+     * клип. Клипы не удаляются, дескрипторы стабильны. Регистрация и
+     * чтение - из игрового потока.
+     */
+    class AnimationClipLibrary {
+    public:
+        static AnimationClipLibrary& GetInstance();
+
+        // Пустая анимация не регистрируется
+        AnimationClipHandle Register(const Animation& animation);
+        // Первый клип с таким именем
+        AnimationClipHandle Find(const std::string& name) const;
+        const AnimationClip* Get(AnimationClipHandle handle) const {
+            return handle != INVALID_ANIMATION_CLIP && handle <= m_clips.size() ? m_clips[handle - 1].get() : nullptr;
+        }
+        size_t GetClipCount() const { return m_clips.size(); }
+
+    private:
+        AnimationClipLibrary() = default;
+
+        std::vector<std::unique_ptr<AnimationClip>> m_clips; // Индекс - дескриптор минус 1
+        std::unordered_multimap<std::string, AnimationClipHandle> m_byName;
+    };
+}
@@ -5,9 +5,12 @@
 #include <memory>
 #include <functional>
 #include <vector>
+#include <deque>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
 #include <atomic>
+#include <chrono>
 
 namespace FastEngine {
     class Texture;
@@ -48,7 +51,9 @@ namespace FastEngine {
         std::shared_ptr<Sound> LoadSound(const std::string& path, bool persistent = false);
         std::shared_ptr<Shader> LoadShader(const std::string& vertexPath, const std::string& fragmentPath, bool persistent = false);
         
-        // Асинхронная загрузка
+        // Асинхронная загрузка в потоке ввода-вывода менеджера, а не в
+        // заданиях JobSystem: чтение файла блокирует. Загрузки идут по
+        // очереди; callback - в потоке ввода-вывода
         void LoadTextureAsync(const std::string& path, std::function<void(std::shared_ptr<Texture>)> callback, bool persistent = false);
         void LoadSoundAsync(const std::string& path, std::function<void(std::shared_ptr<Sound>)> callback, bool persistent = false);
         
@@ -113,6 +118,8 @@ namespace FastEngine {
         void UpdateResourceAccess(const std::string& path);
         void CheckFileChanges();
         void ReloadResource(const std::string& path);
+        bool QueueLoad(std::function<void()> load); // false - менеджер остановлен
+        void LoadThreadFunction();
         
         // Хранилище ресурсов
         std::unordered_map<std::string, std::shared_ptr<Texture>> m_textures;
@@ -132,8 +139,12 @@ namespace FastEngine {
         std::unordered_map<std::string, std::chrono::system_clock::time_point> m_fileTimestamps;
         std::vector<std::string> m_watchedFiles;
         
-        // Асинхронная загрузка
-        std::vector<std::thread> m_loadingThreads;
+        // Асинхронная загрузка: поток ввода-вывода запускается первым запросом
+        std::deque<std::function<void()>> m_loadQueue;
+        std::mutex m_loadMutex;
+        std::condition_variable m_loadCondition;
+        std::thread m_loadThread;
+        bool m_stopLoading;
         std::mutex m_mutex;
         std::atomic<bool> m_shutdown;
         
@@ -4,16 +4,44 @@
 #include "FastEngine/Components/Animator.h"
 #include "FastEngine/Components/Sprite.h"
 #include "FastEngine/Entity.h"
+#include <cstdint>
 #include <vector>
 
 namespace FastEngine {
+    /**
+     * Статистика AnimationSystem за последний Update
+     */
+    struct AnimationSystemStats {
+        uint32_t animators;     // Подключенные аниматоры
+        uint32_t playing;       // Из них продвигаются (не на паузе)
+        uint32_t frameChanges;  // Аниматоры, сменившие кадр
+        uint32_t completed;     // Завершившиеся Once-анимации
+        
+        AnimationSystemStats() : animators(0), playing(0), frameChanges(0), completed(0) {}
+    };
+    
+    /**
+     * Система анимации спрайтов
+     *
+     * Аниматоры мира подключаются к системе и хранят состояние в ее
+     * плотных массивах: время, скорость и длительность текущего кадра
+     * лежат отдельными float-массивами, поэтому кадр - один
+     * векторизуемый цикл сложения и сравнения. Шаг по кадрам и запись
+     * UV-прямоугольника в Sprite выполняются только для аниматоров,
+     * перешедших границу кадра; колбэки вызываются после прохода.
+     */
     class AnimationSystem : public System {
     public:
-        AnimationSystem();
-        ~AnimationSystem() override = default;
+        explicit AnimationSystem(World* world = nullptr);
+        ~AnimationSystem() override;
+        
+        AnimationSystem(const AnimationSystem&) = delete;
+        AnimationSystem& operator=(const AnimationSystem&) = delete;
         
         // Обновление системы
         void Update(float deltaTime) override;
+        // Отключает аниматоры, состояние возвращается в них
+        void Cleanup() override;
         
         // Управление анимациями
         void PlayAnimation(Entity* entity, const std::string& animationName);
@@ -33,13 +61,47 @@ namespace FastEngine {
         void SetPaused(bool paused) { m_paused = paused; }
         bool IsPaused() const { return m_paused; }
         
+        size_t GetAnimatorCount() const { return m_owners.size(); }
+        const AnimationSystemStats& GetStats() const { return m_stats; }
+        
     private:
+        friend class Animator;
+        
         float m_globalSpeed;
         bool m_paused;
+        AnimationSystemStats m_stats;
+        
+        // Слот на аниматор; удаление - перестановкой последнего слота
+        std::vector<Animator*> m_owners;
+        std::vector<Sprite*> m_sprites;
+        std::vector<const AnimationClip*> m_clips;
+        std::vector<AnimationPlayback> m_playback; // Поле time не используется
+        std::vector<uint8_t> m_uvDirty;            // UV кадра еще не записан в Sprite
+        
+        // Горячие данные прохода
+        std::vector<float> m_time;
+        std::vector<float> m_rate;          // 0, если не играет или на паузе
+        std::vector<float> m_frameDuration; // Бесконечность, если не играет
+        std::vector<uint32_t> m_crossed;
+        
+        // Колбэки кадра; владелец обнуляется, если аниматор удален до вызова
+        struct PendingEvent {
+            Animator* owner;
+            uint32_t events;
+            AnimationPlayback state;
+        };
+        std::vector<PendingEvent> m_events;
+        
+        void Attach(Animator* animator);
+        void Detach(Animator* animator);
+        AnimationPlayback GetPlayback(uint32_t slot) const;
+        void SetPlayback(uint32_t slot, const AnimationPlayback& state);
+        void RefreshSlot(uint32_t slot);
+        void GatherAnimators();
+        void DispatchEvents();
         
         // Вспомогательные методы
         Animator* GetAnimator(Entity* entity) const;
         Sprite* GetSprite(Entity* entity) const;
-        void UpdateSpriteTexture(Entity* entity, const AnimationFrame& frame);
     };
 }
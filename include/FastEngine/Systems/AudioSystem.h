@@ -0,0 +1,93 @@
+#pragma once
+
+#include "FastEngine/System.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace FastEngine {
+    class AudioManager;
+    class AudioSource;
+    class Entity;
+
+    /**
+     * Статистика прохода AudioSystem за последний кадр
+     */
+    struct AudioSystemStats {
+        uint32_t playingSources;  // Источники в состоянии Playing
+        uint32_t realVoices;      // Из них с голосом микшера
+        uint32_t virtualVoices;   // Без голоса: неслышимы или не вошли в лимит
+        uint32_t inaudibleSources; // Слышимость ниже порога
+        uint32_t startedVoices;   // Голоса, выданные за кадр
+        uint32_t virtualizedVoices; // Голоса, отобранные за кадр
+
+        AudioSystemStats()
+            : playingSources(0), realVoices(0), virtualVoices(0), inaudibleSources(0)
+            , startedVoices(0), virtualizedVoices(0) {}
+    };
+
+    /**
+     * Пространственный звук для AudioSource
+     *
+     * Раз в кадр собирает играющие источники в массивы по полям (SoA),
+     * одним циклом считает громкость и панораму от Transform слушателя:
+     * обратное расстояние между min и max дистанцией с rolloff и
+     * затуханием до нуля у maxDistance. Голоса микшера получают только
+     * самые слышимые источники (приоритет, затем громкость) в пределах
+     * лимита; остальные виртуальные и только отсчитывают позицию.
+     * Источники без Transform или с выключенным 3D играют с собственной
+     * панорамой и полной громкостью.
+     */
+    class AudioSystem : public System {
+    public:
+        AudioSystem(World* world, AudioManager* audioManager);
+        ~AudioSystem() override = default;
+
+        void Update(float deltaTime) override;
+        // Отключает источники от микшера (до AudioManager::Shutdown)
+        void Cleanup() override;
+
+        // Слушатель - сущность с Transform; без него - начало координат
+        void SetListener(Entity* listener);
+        Entity* GetListener() const;
+
+        // Лимит реальных голосов (не больше голосов микшера)
+        void SetMaxRealVoices(uint32_t count) { m_maxRealVoices = count; }
+        uint32_t GetMaxRealVoices() const { return m_maxRealVoices; }
+
+        // Источники тише порога (громкость * затухание) всегда виртуальные
+        void SetAudibilityThreshold(float threshold) { m_audibilityThreshold = threshold; }
+        float GetAudibilityThreshold() const { return m_audibilityThreshold; }
+
+        const AudioSystemStats& GetStats() const { return m_stats; }
+
+    private:
+        AudioManager* m_audioManager;
+        size_t m_listenerId;
+        bool m_hasListener;
+        uint32_t m_maxRealVoices;
+        float m_audibilityThreshold;
+        AudioSystemStats m_stats;
+
+        // Играющие источники текущего кадра, по полю на массив
+        std::vector<AudioSource*> m_sources;
+        std::vector<float> m_positionX;
+        std::vector<float> m_positionY;
+        std::vector<float> m_minDistance;
+        std::vector<float> m_maxDistance;
+        std::vector<float> m_rolloff;
+        std::vector<float> m_volume;
+        std::vector<float> m_pan;
+        std::vector<float> m_spatial; // 1 - 3D, 0 - собственная панорама
+        std::vector<int> m_priority;
+        std::vector<float> m_gain;
+        std::vector<float> m_audibility;
+        std::vector<uint32_t> m_candidates;
+        std::vector<uint8_t> m_real;
+
+        void GatherSources(float deltaTime);
+        void Spatialize();
+        void SelectRealVoices();
+        void ApplyVoices();
+    };
+}
@@ -10,6 +10,9 @@
 namespace FastEngine {
     class PhysicsSystem : public System {
     public:
+        // Меньше тел на порцию - накладные расходы планировщика заметнее работы
+        static constexpr size_t INTEGRATE_CHUNK_SIZE = 256;
+        
         PhysicsSystem();
         ~PhysicsSystem() override = default;
         
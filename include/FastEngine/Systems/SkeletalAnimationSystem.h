@@ -0,0 +1,88 @@
+#pragma once
+
+#include "FastEngine/System.h"
+#include "FastEngine/Components/SkeletalAnimator.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace FastEngine {
+    class JobSystem;
+    
+    /**
+     * Статистика SkeletalAnimationSystem за последний Update
+     */
+    struct SkeletalAnimationStats {
+        uint32_t animators;       // Вычисленные аниматоры
+        uint32_t bones;           // Суммарно костей
+        uint32_t skinnedVertices; // Вершин после CPU-скиннинга
+        uint32_t workers;         // Рабочих потоков, участвовавших в кадре
+        float updateTimeMs;
+        
+        SkeletalAnimationStats() : animators(0), bones(0), skinnedVertices(0), workers(0), updateTimeMs(0.0f) {}
+    };
+    
+    /**
+     * Система скелетной анимации
+     *
+     * Время аниматоров продвигается в потоке Update, затем позы, матрицы
+     * и CPU-скиннинг вычисляются порциями по ANIMATOR_CHUNK_SIZE: порции
+     * раздает атомарный счетчик, их забирают поток Update и постоянные
+     * рабочие потоки. Без своих потоков при запущенном JobSystem
+     * порции выполняет общий планировщик. Аниматоры независимы, у
+     * каждого потока свои буферы BlendTreeContext, поэтому
+     * синхронизация - только в начале и в конце кадра.
+     */
+    class SkeletalAnimationSystem : public System {
+    public:
+        static constexpr size_t ANIMATOR_CHUNK_SIZE = 8;
+        
+        // workerCount - собственные потоки; 0 - JobSystem, если запущен, иначе только поток Update
+        explicit SkeletalAnimationSystem(World* world = nullptr, uint32_t workerCount = 0);
+        ~SkeletalAnimationSystem() override;
+        
+        SkeletalAnimationSystem(const SkeletalAnimationSystem&) = delete;
+        SkeletalAnimationSystem& operator=(const SkeletalAnimationSystem&) = delete;
+        
+        void Update(float deltaTime) override;
+        void Cleanup() override;
+        
+        // Перезапускает рабочие потоки
+        void SetWorkerCount(uint32_t count);
+        uint32_t GetWorkerCount() const { return static_cast<uint32_t>(m_workers.size()); }
+        
+        void SetPaused(bool paused) { m_paused = paused; }
+        bool IsPaused() const { return m_paused; }
+        
+        const SkeletalAnimationStats& GetStats() const { return m_stats; }
+        
+    private:
+        bool m_paused;
+        SkeletalAnimationStats m_stats;
+        std::vector<SkeletalAnimator*> m_animators;
+        
+        // Буферы вычисления: [0] - поток Update, [i + 1] - рабочий i
+        std::vector<std::unique_ptr<BlendTreeContext>> m_contexts;
+        std::atomic<size_t> m_nextChunk;
+        
+        // Рабочие потоки
+        std::vector<std::thread> m_workers;
+        std::mutex m_workMutex;
+        std::condition_variable m_workCondition;
+        std::condition_variable m_doneCondition;
+        uint64_t m_jobGeneration;
+        uint32_t m_busyWorkers;
+        bool m_stopWorkers;
+        
+        void GatherAnimators(float deltaTime);
+        void RunChunks(BlendTreeContext& context);
+        void RunJobs(JobSystem& jobs);
+        void StartWorkers(uint32_t count);
+        void StopWorkers();
+        void WorkerThreadFunction(uint32_t index, uint64_t seenGeneration);
+    };
+}
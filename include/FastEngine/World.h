@@ -1,5 +1,6 @@
 #pragma once
 
+#include "FastEngine/Memory/LinearArena.h"
 #include <vector>
 #include <memory>
 #include <unordered_map>
@@ -19,6 +20,7 @@ namespace FastEngine {
         // Управление сущностями
         Entity* CreateEntity();
         void DestroyEntity(Entity* entity);
+        Entity* GetEntity(size_t id) const; // nullptr - сущность удалена
         
         // Управление системами
         template<typename T, typename... Args>
@@ -50,8 +52,13 @@ namespace FastEngine {
         template<typename... ComponentTypes>
         std::vector<Entity*> GetEntitiesWithComponents();
         
+        // То же в память кадра; out очищается
+        template<typename... ComponentTypes>
+        void GetEntitiesWithComponents(FrameVector<Entity*>& out);
+        
     private:
         std::vector<std::unique_ptr<Entity>> m_entities;
+        std::unordered_map<size_t, Entity*> m_entityIndex;
         std::vector<std::unique_ptr<System>> m_systems;
     };
 }
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "FastEngine/Component.h"
+#include "FastEngine/Entity.h"
+#include "FastEngine/World.h"
+#include <memory>
+#include <type_traits>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+namespace FastEngine {
+    /**
+     * Снимок значений компонентов мира
+     *
+     * Копирует компоненты выбранных типов присваиванием в непрерывные
+     * массивы (ID сущности, значение) и присваивает их обратно при
+     * восстановлении. Емкость массивов сохраняется между захватами, так что
+     * повторный захват того же набора не выделяет память. Сущности,
+     * удаленные после захвата, и компоненты, снятые с них, пропускаются;
+     * созданные позже не затрагиваются.
+     */
+    class WorldSnapshot {
+    public:
+        WorldSnapshot() = default;
+        WorldSnapshot(const WorldSnapshot&) = delete;
+        WorldSnapshot& operator=(const WorldSnapshot&) = delete;
+        WorldSnapshot(WorldSnapshot&&) = default;
+        WorldSnapshot& operator=(WorldSnapshot&&) = default;
+
+        // Все компоненты типа T в мире
+        template<typename T>
+        void Capture(World& world) {
+            Store<T>& store = GetStore<T>();
+            for (const auto& entity : world.GetEntities()) {
+                if (T* component = entity->GetComponent<T>()) {
+                    store.entries.emplace_back(entity->GetID(), *component);
+                }
+            }
+        }
+
+        // Компонент типа T одной сущности
+        template<typename T>
+        void Capture(Entity& entity) {
+            if (T* component = entity.GetComponent<T>()) {
+                GetStore<T>().entries.emplace_back(entity.GetID(), *component);
+            }
+        }
+
+        void Restore(World& world) const {
+            for (const auto& store : m_stores) {
+                store.second->Restore(world);
+            }
+        }
+
+        // Очистка с сохранением емкости
+        void Clear() {
+            for (auto& store : m_stores) {
+                store.second->Clear();
+            }
+        }
+
+        size_t GetComponentCount() const {
+            size_t count = 0;
+            for (const auto& store : m_stores) {
+                count += store.second->GetSize();
+            }
+            return count;
+        }
+
+    private:
+        struct StoreBase {
+            virtual ~StoreBase() = default;
+            virtual void Restore(World& world) const = 0;
+            virtual void Clear() = 0;
+            virtual size_t GetSize() const = 0;
+        };
+
+        template<typename T>
+        struct Store : StoreBase {
+            std::vector<std::pair<size_t, T>> entries;
+
+            void Restore(World& world) const override {
+                for (const auto& entry : entries) {
+                    Entity* entity = world.GetEntity(entry.first);
+                    if (!entity) {
+                        continue;
+                    }
+                    if (T* component = entity->GetComponent<T>()) {
+                        *component = entry.second;
+                    }
+                }
+            }
+            void Clear() override { entries.clear(); }
+            size_t GetSize() const override { return entries.size(); }
+        };
+
+        // Типов в снимке единицы - линейный поиск
+        template<typename T>
+        Store<T>& GetStore() {
+            static_assert(std::is_base_of_v<Component, T>, "T must be derived from Component");
+            const std::type_index type(typeid(T));
+            for (auto& store : m_stores) {
+                if (store.first == type) {
+                    return static_cast<Store<T>&>(*store.second);
+                }
+            }
+            m_stores.emplace_back(type, std::make_unique<Store<T>>());
+            return static_cast<Store<T>&>(*m_stores.back().second);
+        }
+
+        std::vector<std::pair<std::type_index, std::unique_ptr<StoreBase>>> m_stores;
+    };
+}
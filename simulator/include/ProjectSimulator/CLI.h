@@ -26,6 +26,10 @@ struct CLIArgs {
     bool listProjects;
     bool listTests;
     std::string configFile;
+    std::vector<std::string> replaySessions;
+    float replayFixedDeltaTime;
+    int replayWarmupFrames;
+    float replayFrameBudgetMs;
 };
 
 /**
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
@@ -16,7 +17,8 @@ enum class TestType {
     Integration,    // Интеграционные тесты
     Performance,    // Тесты производительности
     Compatibility,  // Тесты совместимости
-    Stress          // Стресс-тесты
+    Stress,         // Стресс-тесты
+    Replay          // Воспроизведение записей ввода как бенчмарк
 };
 
 /**
@@ -42,6 +44,13 @@ struct TestConfig {
     float timeout;
     bool generateReport;
     std::string reportPath;
+
+    // Бенчмарк воспроизведения: файлы InputRecording; пусто - все
+    // recordings/*.feir рядом с файлом проекта
+    std::vector<std::string> replaySessions;
+    float replayFixedDeltaTime = 0.0f;  // 0 - записанный шаг кадра
+    uint32_t replayWarmupFrames = 0;
+    float replayFrameBudgetMs = 0.0f;   // p99 времени кадра выше - провал; 0 - без проверки
 };
 
 /**
@@ -113,6 +122,17 @@ public:
      */
     std::vector<TestResult> RunStressTests(std::shared_ptr<Project> project, int iterations = 100);
 
+    /**
+     * Воспроизведение записанных сессий ввода без окна и рендера
+     * Каждая сессия проигрывается config.iterations раз одним и тем же
+     * шагом; в metrics - распределение времени кадра (p50/p90/p99/max)
+     * и разброс медианы между повторами
+     * @param project проект для тестирования
+     * @param config конфигурация тестирования
+     * @return результаты тестирования
+     */
+    std::vector<TestResult> RunReplayBenchmarks(std::shared_ptr<Project> project, const TestConfig& config);
+
     /**
      * Установка callback для прогресса тестирования
      * @param callback функция обратного вызова
@@ -194,6 +214,16 @@ private:
      */
     TestResult ExecuteStressTest(const std::string& testName, std::shared_ptr<Project> project, int iterations);
 
+    /**
+     * Выполнение бенчмарка воспроизведения одной сессии
+     */
+    TestResult ExecuteReplayBenchmark(const std::string& sessionPath, std::shared_ptr<Project> project, const TestConfig& config);
+
+    /**
+     * Поиск записей сессий для бенчмарка воспроизведения
+     */
+    std::vector<std::string> FindReplaySessions(std::shared_ptr<Project> project, const TestConfig& config) const;
+
     /**
      * Обновление прогресса
      */
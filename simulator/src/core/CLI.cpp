@@ -54,6 +54,9 @@ CLIArgs CLI::ParseArgs(int argc, char* argv[]) {
     args.listProjects = false;
     args.listTests = false;
     args.configFile = "";
+    args.replayFixedDeltaTime = 0.0f;
+    args.replayWarmupFrames = 0;
+    args.replayFrameBudgetMs = 0.0f;
 
     // Парсинг аргументов
     for (int i = 1; i < argc; ++i) {
@@ -101,6 +104,27 @@ CLIArgs CLI::ParseArgs(int argc, char* argv[]) {
             if (i + 1 < argc) {
                 args.timeout = std::stof(argv[++i]);
             }
+        } else if (arg == "--replay") {
+            if (i + 1 < argc) {
+                std::string sessions = argv[++i];
+                std::istringstream ss(sessions);
+                std::string session;
+                while (std::getline(ss, session, ',')) {
+                    args.replaySessions.push_back(session);
+                }
+            }
+        } else if (arg == "--fixed-dt") {
+            if (i + 1 < argc) {
+                args.replayFixedDeltaTime = std::stof(argv[++i]);
+            }
+        } else if (arg == "--warmup") {
+            if (i + 1 < argc) {
+                args.replayWarmupFrames = std::stoi(argv[++i]);
+            }
+        } else if (arg == "--frame-budget") {
+            if (i + 1 < argc) {
+                args.replayFrameBudgetMs = std::stof(argv[++i]);
+            }
         } else if (arg == "--verbose" || arg == "-v") {
             args.verbose = true;
         } else if (arg == "--no-report") {
@@ -214,6 +238,10 @@ void CLI::ShowHelp() {
     std::cout << "  -v, --verbose           Verbose output" << std::endl;
     std::cout << "  --no-report             Don't generate HTML report" << std::endl;
     std::cout << "  -c, --config FILE       Load configuration from file" << std::endl;
+    std::cout << "  --replay FILES          Comma-separated input recordings for replay tests" << std::endl;
+    std::cout << "  --fixed-dt SECONDS      Replay with a fixed timestep instead of recorded" << std::endl;
+    std::cout << "  --warmup N              Replay frames excluded from frame-time stats" << std::endl;
+    std::cout << "  --frame-budget MS       Fail replay tests whose frame p99 exceeds MS" << std::endl;
     std::cout << std::endl;
     std::cout << "TEST TYPES:" << std::endl;
     std::cout << "  unit                    Unit tests" << std::endl;
@@ -221,6 +249,7 @@ void CLI::ShowHelp() {
     std::cout << "  performance             Performance tests" << std::endl;
     std::cout << "  compatibility           Compatibility tests" << std::endl;
     std::cout << "  stress                  Stress tests" << std::endl;
+    std::cout << "  replay                  Headless replay of recorded input sessions" << std::endl;
     std::cout << std::endl;
     std::cout << "PLATFORMS:" << std::endl;
     std::cout << "  desktop                 Desktop platforms" << std::endl;
@@ -230,6 +259,7 @@ void CLI::ShowHelp() {
     std::cout << "EXAMPLES:" << std::endl;
     std::cout << "  simulator-cli test -p ./projects/basic_game" << std::endl;
     std::cout << "  simulator-cli test -p ./projects/basic_game -t unit,performance" << std::endl;
+    std::cout << "  simulator-cli test -p ./projects/basic_game -t replay -i 5 --fixed-dt 0.016" << std::endl;
     std::cout << "  simulator-cli simulate -p ./projects/sprite_demo" << std::endl;
     std::cout << "  simulator-cli batch-test --platforms desktop,ios" << std::endl;
     std::cout << "  simulator-cli create -p ./projects/my_game" << std::endl;
@@ -272,6 +302,7 @@ void CLI::ListTests() {
     std::cout << "  performance  - Performance tests (FPS, memory)" << std::endl;
     std::cout << "  compatibility - Compatibility tests (platform testing)" << std::endl;
     std::cout << "  stress       - Stress tests (load testing)" << std::endl;
+    std::cout << "  replay       - Replay benchmarks (frame-time distribution of recorded sessions)" << std::endl;
     std::cout << std::endl;
     std::cout << "Available Platforms:" << std::endl;
     std::cout << "===================" << std::endl;
@@ -325,6 +356,8 @@ int CLI::RunTests(const CLIArgs& args) {
             config.enabledTests.push_back(TestType::Compatibility);
         } else if (type == "stress") {
             config.enabledTests.push_back(TestType::Stress);
+        } else if (type == "replay") {
+            config.enabledTests.push_back(TestType::Replay);
         }
     }
 
@@ -333,6 +366,10 @@ int CLI::RunTests(const CLIArgs& args) {
     config.timeout = args.timeout;
     config.generateReport = args.generateReport;
     config.reportPath = args.outputPath + "/";
+    config.replaySessions = args.replaySessions;
+    config.replayFixedDeltaTime = args.replayFixedDeltaTime;
+    config.replayWarmupFrames = static_cast<uint32_t>(std::max(0, args.replayWarmupFrames));
+    config.replayFrameBudgetMs = args.replayFrameBudgetMs;
 
     // Запускаем тесты
     auto testRunner = simulator.GetTestRunner();
@@ -735,6 +772,9 @@ void CLI::PrintTestResult(const TestResult& result, bool verbose) {
         if (!result.message.empty()) {
             std::cout << " - " << result.message;
         }
+        for (const auto& metric : result.metrics) {
+            std::cout << std::endl << "      " << metric.first << ": " << metric.second;
+        }
     }
     
     std::cout << std::endl;
@@ -1,7 +1,14 @@
 #include "ProjectSimulator/TestRunner.h"
 #include "ProjectSimulator/Project.h"
+#include "FastEngine/Engine.h"
+#include "FastEngine/Input/InputRecording.h"
+#include "FastEngine/Profiling/QuantileSketch.h"
+#include <algorithm>
 #include <iostream>
 #include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
 #include <thread>
 
 namespace ProjectSimulator {
@@ -63,6 +70,9 @@ std::vector<TestResult> TestRunner::RunTests(std::shared_ptr<Project> project, c
                 case TestType::Stress:
                     m_totalTests += 1;
                     break;
+                case TestType::Replay:
+                    m_totalTests += FindReplaySessions(project, config).size();
+                    break;
             }
         }
 
@@ -102,6 +112,9 @@ std::vector<TestResult> TestRunner::RunTestType(std::shared_ptr<Project> project
         case TestType::Stress:
             results = RunStressTests(project, config.iterations);
             break;
+        case TestType::Replay:
+            results = RunReplayBenchmarks(project, config);
+            break;
     }
 
     return results;
@@ -199,6 +212,19 @@ std::vector<TestResult> TestRunner::RunStressTests(std::shared_ptr<Project> proj
     return results;
 }
 
+std::vector<TestResult> TestRunner::RunReplayBenchmarks(std::shared_ptr<Project> project, const TestConfig& config) {
+    std::vector<TestResult> results;
+
+    for (const auto& session : FindReplaySessions(project, config)) {
+        auto result = ExecuteReplayBenchmark(session, project, config);
+        results.push_back(result);
+        UpdateProgress(m_progress + 1, m_totalTests);
+        SendResult(result);
+    }
+
+    return results;
+}
+
 void TestRunner::SetProgressCallback(std::function<void(int, int)> callback) {
     m_progressCallback = callback;
 }
@@ -376,6 +402,100 @@ TestResult TestRunner::ExecuteStressTest(const std::string& testName, std::share
     return {testName, TestType::Stress, passed, message, duration, "Desktop", {}};
 }
 
+TestResult TestRunner::ExecuteReplayBenchmark(const std::string& sessionPath, std::shared_ptr<Project> project, const TestConfig& config) {
+    auto start = std::chrono::high_resolution_clock::now();
+    std::string testName = "Replay " + std::filesystem::path(sessionPath).filename().string();
+    TestResult result{testName, TestType::Replay, false, "", 0.0f, "Headless", {}};
+
+    auto recording = std::make_shared<FastEngine::InputRecording>();
+    if (!recording->LoadFromFile(sessionPath) || recording->IsEmpty()) {
+        result.message = "Failed to load input recording " + sessionPath;
+        return result;
+    }
+
+    FastEngine::ReplayConfig replayConfig;
+    replayConfig.fixedDeltaTime = config.replayFixedDeltaTime;
+    replayConfig.warmupFrames = config.replayWarmupFrames;
+
+    // Повторы с одним и тем же вводом и шагом: общее распределение и
+    // разброс медиан показывают, насколько воспроизводим замер
+    FastEngine::QuantileSketch frameTimes;
+    double minMedian = 0.0;
+    double maxMedian = 0.0;
+    double simulatedSeconds = 0.0;
+    double wallSeconds = 0.0;
+    const int iterations = std::max(1, config.iterations);
+    for (int i = 0; i < iterations; ++i) {
+        FastEngine::Engine engine;
+        if (!engine.InitializeReplay(recording, replayConfig)) {
+            result.message = "Failed to start replay";
+            return result;
+        }
+        auto runStart = std::chrono::high_resolution_clock::now();
+        engine.Run();
+        wallSeconds += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - runStart).count();
+        simulatedSeconds += replayConfig.fixedDeltaTime > 0.0f
+            ? static_cast<double>(replayConfig.fixedDeltaTime) * recording->GetFrameCount()
+            : recording->GetDuration();
+
+        const FastEngine::QuantileSketch* times = engine.GetReplayFrameTimes();
+        double median = times->GetQuantile(0.5);
+        minMedian = i == 0 ? median : std::min(minMedian, median);
+        maxMedian = i == 0 ? median : std::max(maxMedian, median);
+        frameTimes.Merge(*times);
+        engine.Shutdown();
+    }
+
+    auto format = [](double value) {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(3) << value;
+        return oss.str();
+    };
+    double p99 = frameTimes.GetQuantile(0.99);
+    result.metrics["frames"] = std::to_string(recording->GetFrameCount());
+    result.metrics["events"] = std::to_string(recording->GetEventCount());
+    result.metrics["iterations"] = std::to_string(iterations);
+    result.metrics["frame_p50_ms"] = format(frameTimes.GetQuantile(0.5));
+    result.metrics["frame_p90_ms"] = format(frameTimes.GetQuantile(0.9));
+    result.metrics["frame_p99_ms"] = format(p99);
+    result.metrics["frame_max_ms"] = format(frameTimes.GetMax());
+    result.metrics["median_spread_ms"] = format(maxMedian - minMedian);
+    result.metrics["simulated_s"] = format(simulatedSeconds);
+    result.metrics["wall_s"] = format(wallSeconds);
+
+    if (config.replayFrameBudgetMs > 0.0f && p99 > config.replayFrameBudgetMs) {
+        result.message = "Frame p99 " + format(p99) + " ms exceeds budget " + format(config.replayFrameBudgetMs) + " ms";
+    } else {
+        result.passed = true;
+        result.message = "Replayed " + std::to_string(recording->GetFrameCount()) + " frames, p99 " + format(p99) + " ms";
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    result.duration = std::chrono::duration<float>(end - start).count();
+    return result;
+}
+
+std::vector<std::string> TestRunner::FindReplaySessions(std::shared_ptr<Project> project, const TestConfig& config) const {
+    if (!config.replaySessions.empty()) {
+        return config.replaySessions;
+    }
+
+    std::vector<std::string> sessions;
+    if (!project || project->GetPath().empty()) {
+        return sessions;
+    }
+
+    std::error_code error;
+    std::filesystem::path directory = std::filesystem::path(project->GetPath()).parent_path() / "recordings";
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        if (entry.is_regular_file() && entry.path().extension() == FastEngine::InputRecording::FILE_EXTENSION) {
+            sessions.push_back(entry.path().string());
+        }
+    }
+    std::sort(sessions.begin(), sessions.end());
+    return sessions;
+}
+
 void TestRunner::UpdateProgress(int current, int total) {
     m_progress = current;
     if (m_progressCallback) {
@@ -1,42 +1,207 @@
 #include "FastEngine/Systems/AnimationSystem.h"
 #include "FastEngine/Entity.h"
 #include "FastEngine/World.h"
-#include "FastEngine/Render/Texture.h"
-#include <iostream>
+#include <algorithm>
+#include <limits>
 
 namespace FastEngine {
-    AnimationSystem::AnimationSystem() 
-        : System(nullptr)
+    AnimationSystem::AnimationSystem(World* world)
+        : System(world)
         , m_globalSpeed(1.0f)
         , m_paused(false) {
     }
     
+    AnimationSystem::~AnimationSystem() {
+        Cleanup();
+    }
+    
     void AnimationSystem::Update(float deltaTime) {
-        if (m_paused) {
+        if (!m_world || m_paused) {
             return;
         }
         
-        // Получаем все сущности с компонентом Animator
-        auto entities = m_world->GetEntitiesWithComponents<Animator>();
+        m_stats = AnimationSystemStats();
+        GatherAnimators();
+        
+        const size_t count = m_owners.size();
+        const float step = deltaTime * m_globalSpeed;
+        float* time = m_time.data();
+        const float* rate = m_rate.data();
+        const float* frameDuration = m_frameDuration.data();
+        
+        // Продвижение времени всех аниматоров - без ветвлений
+        for (size_t i = 0; i < count; ++i) {
+            time[i] += step * rate[i];
+        }
+        
+        // Индексы аниматоров, перешедших границу кадра
+        m_crossed.resize(count);
+        uint32_t* crossed = m_crossed.data();
+        uint32_t crossedCount = 0;
+        uint32_t playing = 0;
+        for (size_t i = 0; i < count; ++i) {
+            crossed[crossedCount] = static_cast<uint32_t>(i);
+            crossedCount += time[i] >= frameDuration[i] ? 1u : 0u;
+            playing += rate[i] != 0.0f ? 1u : 0u;
+        }
+        
+        for (uint32_t i = 0; i < crossedCount; ++i) {
+            const uint32_t slot = crossed[i];
+            const AnimationClip& clip = *m_clips[slot];
+            AnimationPlayback state = GetPlayback(slot);
+            const uint16_t previousFrame = state.frame;
+            
+            const uint32_t events = Animator::Step(state, clip);
+            m_playback[slot] = state;
+            m_time[slot] = state.time;
+            if (events & Animator::EVENT_COMPLETED) {
+                RefreshSlot(slot);
+                m_stats.completed++;
+            } else {
+                m_frameDuration[slot] = clip.frameDurations[state.frame];
+            }
+            if (state.frame != previousFrame) {
+                m_uvDirty[slot] = 1;
+                m_stats.frameChanges++;
+            }
+            
+            Animator* owner = m_owners[slot];
+            if (events != 0 && (owner->m_onFrameChange || owner->m_onAnimationComplete)) {
+                m_events.push_back({owner, events, state});
+            }
+        }
+        
+        // UV кадра в спрайт: только после смены кадра или клипа
+        for (size_t i = 0; i < count; ++i) {
+            if (!m_uvDirty[i] || !m_sprites[i] || !m_clips[i]) {
+                continue;
+            }
+            const AnimationClip& clip = *m_clips[i];
+            m_sprites[i]->SetUVRect(clip.uvRects[std::min<uint32_t>(m_playback[i].frame, clip.GetFrameCount() - 1)]);
+            m_uvDirty[i] = 0;
+        }
         
-        for (auto* entity : entities) {
-            Animator* animator = GetAnimator(entity);
+        m_stats.animators = static_cast<uint32_t>(count);
+        m_stats.playing = playing;
+        DispatchEvents();
+    }
+    
+    void AnimationSystem::Cleanup() {
+        while (!m_owners.empty()) {
+            Detach(m_owners.back());
+        }
+        m_events.clear();
+    }
+    
+    void AnimationSystem::GatherAnimators() {
+        // Спрайты перечитываются каждый кадр: компонент мог быть удален
+        for (const auto& entity : m_world->GetEntities()) {
+            Animator* animator = entity->GetComponent<Animator>();
             if (!animator) {
                 continue;
             }
-            
-            // Обновляем анимацию
-            animator->Update(deltaTime * m_globalSpeed);
-            
-            // Обновляем спрайт, если есть
-            Sprite* sprite = GetSprite(entity);
-            if (sprite && animator->IsPlaying()) {
-                AnimationFrame frame = animator->GetCurrentFrameData();
-                UpdateSpriteTexture(entity, frame);
+            if (!animator->m_system) {
+                Attach(animator);
+            }
+            if (animator->m_system == this) {
+                m_sprites[animator->m_slot] = GetSprite(entity.get());
             }
         }
     }
     
+    void AnimationSystem::DispatchEvents() {
+        // Колбэк может удалить сущность: владелец проверяется перед каждым вызовом
+        for (size_t i = 0; i < m_events.size(); ++i) {
+            const PendingEvent event = m_events[i];
+            if (event.owner && (event.events & Animator::EVENT_FRAME_CHANGED) && event.owner->m_onFrameChange) {
+                event.owner->m_onFrameChange(event.state.frame);
+            }
+            Animator* owner = m_events[i].owner;
+            if (owner && (event.events & Animator::EVENT_COMPLETED) && owner->m_onAnimationComplete) {
+                const AnimationClip* clip = AnimationClipLibrary::GetInstance().Get(event.state.clip);
+                owner->m_onAnimationComplete(clip ? clip->GetName() : std::string());
+            }
+        }
+        m_events.clear();
+    }
+    
+    void AnimationSystem::Attach(Animator* animator) {
+        const uint32_t slot = static_cast<uint32_t>(m_owners.size());
+        m_owners.push_back(animator);
+        m_sprites.push_back(nullptr);
+        m_clips.push_back(nullptr);
+        m_playback.push_back(animator->m_playback);
+        m_uvDirty.push_back(1);
+        m_time.push_back(animator->m_playback.time);
+        m_rate.push_back(0.0f);
+        m_frameDuration.push_back(0.0f);
+        
+        animator->m_system = this;
+        animator->m_slot = slot;
+        RefreshSlot(slot);
+    }
+    
+    void AnimationSystem::Detach(Animator* animator) {
+        const uint32_t slot = animator->m_slot;
+        animator->m_playback = GetPlayback(slot);
+        animator->m_system = nullptr;
+        animator->m_slot = 0;
+        
+        const uint32_t last = static_cast<uint32_t>(m_owners.size() - 1);
+        if (slot != last) {
+            m_owners[slot] = m_owners[last];
+            m_sprites[slot] = m_sprites[last];
+            m_clips[slot] = m_clips[last];
+            m_playback[slot] = m_playback[last];
+            m_uvDirty[slot] = m_uvDirty[last];
+            m_time[slot] = m_time[last];
+            m_rate[slot] = m_rate[last];
+            m_frameDuration[slot] = m_frameDuration[last];
+            m_owners[slot]->m_slot = slot;
+        }
+        m_owners.pop_back();
+        m_sprites.pop_back();
+        m_clips.pop_back();
+        m_playback.pop_back();
+        m_uvDirty.pop_back();
+        m_time.pop_back();
+        m_rate.pop_back();
+        m_frameDuration.pop_back();
+        
+        for (PendingEvent& event : m_events) {
+            if (event.owner == animator) {
+                event.owner = nullptr;
+            }
+        }
+    }
+    
+    AnimationPlayback AnimationSystem::GetPlayback(uint32_t slot) const {
+        AnimationPlayback state = m_playback[slot];
+        state.time = m_time[slot];
+        return state;
+    }
+    
+    void AnimationSystem::SetPlayback(uint32_t slot, const AnimationPlayback& state) {
+        m_playback[slot] = state;
+        m_time[slot] = state.time;
+        m_uvDirty[slot] = 1;
+        RefreshSlot(slot);
+    }
+    
+    void AnimationSystem::RefreshSlot(uint32_t slot) {
+        const AnimationPlayback& state = m_playback[slot];
+        const AnimationClip* clip = AnimationClipLibrary::GetInstance().Get(state.clip);
+        const bool advancing = clip && clip->GetFrameCount() > 0 &&
+            (state.flags & ANIMATION_PLAYING) != 0 && (state.flags & ANIMATION_PAUSED) == 0;
+        
+        m_clips[slot] = clip;
+        m_rate[slot] = advancing ? state.speed * clip->source.speed : 0.0f;
+        // Неактивный слот никогда не переходит границу кадра
+        m_frameDuration[slot] = advancing
+            ? clip->frameDurations[std::min<uint32_t>(state.frame, clip->GetFrameCount() - 1)]
+            : std::numeric_limits<float>::infinity();
+    }
+    
     void AnimationSystem::PlayAnimation(Entity* entity, const std::string& animationName) {
         Animator* animator = GetAnimator(entity);
         if (animator) {
@@ -87,21 +252,4 @@ namespace FastEngine {
     Sprite* AnimationSystem::GetSprite(Entity* entity) const {
         return entity->GetComponent<Sprite>();
     }
-    
-    void AnimationSystem::UpdateSpriteTexture(Entity* entity, const AnimationFrame& frame) {
-        Sprite* sprite = GetSprite(entity);
-        if (!sprite) {
-            return;
-        }
-        
-        // Загружаем текстуру из пути кадра
-        if (!frame.texturePath.empty()) {
-            // В реальной реализации здесь бы загружалась текстура
-            // sprite->SetTexture(LoadTexture(frame.texturePath));
-        }
-        
-        // Обновляем смещение и размер спрайта
-        // sprite->SetOffset(frame.offset);
-        // sprite->SetSize(frame.size);
-    }
 }
@@ -0,0 +1,226 @@
+#include "FastEngine/Systems/AudioSystem.h"
+#include "FastEngine/Audio/AudioManager.h"
+#include "FastEngine/Audio/AudioMixer.h"
+#include "FastEngine/Components/AudioSource.h"
+#include "FastEngine/Components/Transform.h"
+#include "FastEngine/Entity.h"
+#include "FastEngine/World.h"
+#include <algorithm>
+#include <cmath>
+
+namespace FastEngine {
+    namespace {
+        constexpr float MIN_DISTANCE = 0.001f;
+        // Доля диапазона у maxDistance, на которой громкость уходит в ноль
+        constexpr float EDGE_FADE = 0.1f;
+        // Преимущество уже играющих голосов: на границе лимита они не переключаются каждый кадр
+        constexpr float REAL_VOICE_BIAS = 1.25f;
+    }
+
+    AudioSystem::AudioSystem(World* world, AudioManager* audioManager)
+        : System(world)
+        , m_audioManager(audioManager)
+        , m_listenerId(0)
+        , m_hasListener(false)
+        , m_maxRealVoices(32)
+        , m_audibilityThreshold(0.001f) {
+    }
+
+    void AudioSystem::SetListener(Entity* listener) {
+        m_hasListener = listener != nullptr;
+        m_listenerId = listener ? listener->GetID() : 0;
+    }
+
+    Entity* AudioSystem::GetListener() const {
+        return m_hasListener ? m_world->GetEntity(m_listenerId) : nullptr;
+    }
+
+    void AudioSystem::Update(float deltaTime) {
+        if (!m_world) {
+            return;
+        }
+
+        m_stats = AudioSystemStats();
+        GatherSources(deltaTime);
+        Spatialize();
+        SelectRealVoices();
+        ApplyVoices();
+    }
+
+    void AudioSystem::Cleanup() {
+        if (!m_world) {
+            return;
+        }
+        for (const auto& entity : m_world->GetEntities()) {
+            if (AudioSource* source = entity->GetComponent<AudioSource>()) {
+                source->SetOutput(nullptr, nullptr);
+            }
+        }
+        m_sources.clear();
+    }
+
+    void AudioSystem::GatherSources(float deltaTime) {
+        AudioMixer* mixer = m_audioManager ? m_audioManager->GetMixer() : nullptr;
+        AudioStreamer* streamer = m_audioManager ? m_audioManager->GetStreamer() : nullptr;
+
+        m_sources.clear();
+        m_positionX.clear();
+        m_positionY.clear();
+        m_minDistance.clear();
+        m_maxDistance.clear();
+        m_rolloff.clear();
+        m_volume.clear();
+        m_pan.clear();
+        m_spatial.clear();
+        m_priority.clear();
+
+        for (const auto& entity : m_world->GetEntities()) {
+            AudioSource* source = entity->GetComponent<AudioSource>();
+            if (!source) {
+                continue;
+            }
+            if (mixer && !source->HasOutput()) {
+                source->SetOutput(mixer, streamer);
+            }
+
+            // Fade, временные эффекты и отсчет позиции - до выбора голосов
+            source->Update(deltaTime);
+            if (!source->IsPlaying()) {
+                continue;
+            }
+
+            Transform* transform = source->Is3DEnabled() ? entity->GetComponent<Transform>() : nullptr;
+            glm::vec2 position = transform ? transform->GetPosition() : glm::vec2(0.0f);
+            float minDistance = std::max(source->GetMinDistance(), MIN_DISTANCE);
+
+            m_sources.push_back(source);
+            m_positionX.push_back(position.x);
+            m_positionY.push_back(position.y);
+            m_minDistance.push_back(minDistance);
+            m_maxDistance.push_back(std::max(source->GetMaxDistance(), minDistance + MIN_DISTANCE));
+            m_rolloff.push_back(std::max(source->GetRolloffFactor(), 0.0f));
+            m_volume.push_back(source->GetEffectiveVolume());
+            m_pan.push_back(source->GetPan());
+            m_spatial.push_back(transform ? 1.0f : 0.0f);
+            m_priority.push_back(source->GetPriority());
+        }
+
+        m_stats.playingSources = static_cast<uint32_t>(m_sources.size());
+    }
+
+    void AudioSystem::Spatialize() {
+        glm::vec2 listener(0.0f);
+        float rotation = 0.0f;
+        if (Entity* entity = GetListener()) {
+            if (Transform* transform = entity->GetComponent<Transform>()) {
+                listener = transform->GetPosition();
+                rotation = transform->GetRotation();
+            }
+        }
+        // Ось "вправо" слушателя; Transform хранит поворот в градусах
+        const float radians = rotation * 3.14159265f / 180.0f;
+        const float rightX = std::cos(radians);
+        const float rightY = std::sin(radians);
+
+        const size_t count = m_sources.size();
+        m_gain.resize(count);
+        m_audibility.resize(count);
+
+        // Без ветвлений: 3D и обычные источники смешиваются через m_spatial
+        const float* positionX = m_positionX.data();
+        const float* positionY = m_positionY.data();
+        const float* minDistance = m_minDistance.data();
+        const float* maxDistance = m_maxDistance.data();
+        const float* rolloff = m_rolloff.data();
+        const float* volume = m_volume.data();
+        const float* spatial = m_spatial.data();
+        float* pan = m_pan.data();
+        float* gain = m_gain.data();
+        float* audibility = m_audibility.data();
+        for (size_t i = 0; i < count; ++i) {
+            float dx = positionX[i] - listener.x;
+            float dy = positionY[i] - listener.y;
+            float distance = std::sqrt(dx * dx + dy * dy);
+            float minD = minDistance[i];
+            float maxD = maxDistance[i];
+
+            // Обратное расстояние с rolloff (модель OpenAL inverse clamped)
+            float clamped = std::min(std::max(distance, minD), maxD);
+            float attenuation = minD / (minD + rolloff[i] * (clamped - minD));
+            // Затухание до нуля у maxDistance: отсечение без скачка громкости
+            float edge = std::min(std::max((maxD - distance) / (EDGE_FADE * (maxD - minD)), 0.0f), 1.0f);
+            // Внутри minDistance панорама плавно уходит в центр
+            float side = (dx * rightX + dy * rightY) / std::max(distance, minD);
+            float spatialPan = std::min(std::max(side, -1.0f), 1.0f);
+
+            float g = 1.0f + spatial[i] * (attenuation * edge - 1.0f);
+            pan[i] += spatial[i] * (spatialPan - pan[i]);
+            gain[i] = g;
+            audibility[i] = g * volume[i];
+        }
+    }
+
+    void AudioSystem::SelectRealVoices() {
+        const size_t count = m_sources.size();
+        m_real.assign(count, 0);
+        m_candidates.clear();
+        for (size_t i = 0; i < count; ++i) {
+            if (m_audibility[i] >= m_audibilityThreshold) {
+                m_candidates.push_back(static_cast<uint32_t>(i));
+            } else {
+                ++m_stats.inaudibleSources;
+            }
+        }
+
+        uint32_t limit = m_maxRealVoices;
+        if (AudioMixer* mixer = m_audioManager ? m_audioManager->GetMixer() : nullptr) {
+            limit = std::min(limit, mixer->GetConfig().maxVoices);
+        }
+
+        if (m_candidates.size() > limit) {
+            // Важнее приоритет, затем слышимость; частичная сортировка O(n)
+            for (uint32_t index : m_candidates) {
+                if (m_sources[index]->HasVoice()) {
+                    m_audibility[index] *= REAL_VOICE_BIAS;
+                }
+            }
+            std::nth_element(m_candidates.begin(), m_candidates.begin() + limit, m_candidates.end(),
+                [this](uint32_t a, uint32_t b) {
+                    if (m_priority[a] != m_priority[b]) {
+                        return m_priority[a] > m_priority[b];
+                    }
+                    return m_audibility[a] > m_audibility[b];
+                });
+            m_candidates.resize(limit);
+        }
+
+        for (uint32_t index : m_candidates) {
+            m_real[index] = 1;
+        }
+    }
+
+    void AudioSystem::ApplyVoices() {
+        const size_t count = m_sources.size();
+
+        // Сначала освобождаем голоса, чтобы новые не вытесняли их в микшере
+        for (size_t i = 0; i < count; ++i) {
+            if (!m_real[i] && m_sources[i]->HasVoice()) {
+                m_sources[i]->Virtualize();
+                ++m_stats.virtualizedVoices;
+            }
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            AudioSource* source = m_sources[i];
+            source->SetSpatialParams(m_gain[i], m_pan[i]);
+            if (m_real[i] && !source->HasVoice() && source->StartVoice()) {
+                ++m_stats.startedVoices;
+            }
+            if (source->HasVoice()) {
+                ++m_stats.realVoices;
+            } else {
+                ++m_stats.virtualVoices;
+            }
+        }
+    }
+}
@@ -3,6 +3,7 @@
 #include "FastEngine/World.h"
 #include "FastEngine/Components/Collider.h"
 #include "FastEngine/Physics/Collision.h"
+#include "FastEngine/Jobs/JobSystem.h"
 #include <algorithm>
 
 namespace FastEngine {
@@ -25,13 +26,16 @@ namespace FastEngine {
         m_accumulator += deltaTime;
         
         // Используем фиксированные временные шаги для стабильности физики
+        FrameVector<Entity*> entities;
         while (m_accumulator >= m_timeStep) {
             // Обновляем все RigidBody компоненты
-            auto entities = m_world->GetEntitiesWithComponents<RigidBody>();
+            m_world->GetEntitiesWithComponents<RigidBody>(entities);
             
-            for (auto* entity : entities) {
-                Integrate(entity, m_timeStep);
-            }
+            // Интегрирование тел независимо - делится между потоками JobSystem
+            static const ProfileNameId integrateJob = ProfileNames::Register("PhysicsSystem::Integrate");
+            JobSystem::GetInstance().ParallelFor(0, entities.size(), [this, &entities](size_t i) {
+                Integrate(entities[i], m_timeStep);
+            }, INTEGRATE_CHUNK_SIZE, integrateJob);
             
             // Проверяем коллизии
             CheckCollisions();
@@ -84,11 +88,11 @@ namespace FastEngine {
     }
     
     void PhysicsSystem::SetOnCollisionEnter(std::function<void(Entity*, Entity*)> callback) {
-        m_onCollisionEnter = callback;
+        m_onCollisionEnter = std::move(callback);
     }
     
     void PhysicsSystem::SetOnCollisionExit(std::function<void(Entity*, Entity*)> callback) {
-        m_onCollisionExit = callback;
+        m_onCollisionExit = std::move(callback);
     }
     
     void PhysicsSystem::Integrate(Entity* entity, float deltaTime) {
@@ -122,7 +126,8 @@ namespace FastEngine {
     }
     
     void PhysicsSystem::CheckCollisions() {
-        auto entities = m_world->GetEntitiesWithComponents<Collider>();
+        FrameVector<Entity*> entities;
+        m_world->GetEntitiesWithComponents<Collider>(entities);
         
         // Простая проверка коллизий между всеми парами сущностей
         for (size_t i = 0; i < entities.size(); ++i) {
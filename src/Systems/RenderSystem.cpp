@@ -62,7 +62,8 @@ namespace FastEngine {
 #endif
         
         // Получаем все сущности с компонентами Sprite и Transform
-        auto entities = m_world->GetEntitiesWithComponents<Sprite, Transform>();
+        FrameVector<Entity*> entities;
+        m_world->GetEntitiesWithComponents<Sprite, Transform>(entities);
         
 #if 0
         // Debug: размер экрана, letterbox, камера и элементы (отключено — включить при отладке)
@@ -0,0 +1,173 @@
+#include "FastEngine/Systems/SkeletalAnimationSystem.h"
+#include "FastEngine/Entity.h"
+#include "FastEngine/World.h"
+#include "FastEngine/Jobs/JobSystem.h"
+#include <algorithm>
+#include <chrono>
+
+namespace FastEngine {
+    SkeletalAnimationSystem::SkeletalAnimationSystem(World* world, uint32_t workerCount)
+        : System(world)
+        , m_paused(false)
+        , m_nextChunk(0)
+        , m_jobGeneration(0)
+        , m_busyWorkers(0)
+        , m_stopWorkers(false) {
+        m_contexts.push_back(std::make_unique<BlendTreeContext>());
+        StartWorkers(workerCount);
+    }
+    
+    SkeletalAnimationSystem::~SkeletalAnimationSystem() {
+        Cleanup();
+    }
+    
+    void SkeletalAnimationSystem::Cleanup() {
+        StopWorkers();
+        m_animators.clear();
+    }
+    
+    void SkeletalAnimationSystem::SetWorkerCount(uint32_t count) {
+        StopWorkers();
+        StartWorkers(count);
+    }
+    
+    void SkeletalAnimationSystem::Update(float deltaTime) {
+        if (!m_world) {
+            return;
+        }
+        
+        auto startTime = std::chrono::steady_clock::now();
+        m_stats = SkeletalAnimationStats();
+        GatherAnimators(m_paused ? 0.0f : deltaTime);
+        
+        if (!m_animators.empty()) {
+            m_nextChunk.store(0, std::memory_order_relaxed);
+            size_t chunkCount = (m_animators.size() + ANIMATOR_CHUNK_SIZE - 1) / ANIMATOR_CHUNK_SIZE;
+            bool useWorkers = !m_workers.empty() && chunkCount > 1;
+            JobSystem& jobs = JobSystem::GetInstance();
+            if (m_workers.empty() && chunkCount > 1 && jobs.IsRunning()) {
+                RunJobs(jobs);
+                m_stats.workers = jobs.GetWorkerCount();
+            } else {
+                if (useWorkers) {
+                    std::lock_guard<std::mutex> lock(m_workMutex);
+                    m_busyWorkers = static_cast<uint32_t>(m_workers.size());
+                    ++m_jobGeneration;
+                }
+                if (useWorkers) {
+                    m_workCondition.notify_all();
+                }
+                
+                RunChunks(*m_contexts[0]);
+                
+                if (useWorkers) {
+                    std::unique_lock<std::mutex> lock(m_workMutex);
+                    m_doneCondition.wait(lock, [this]() { return m_busyWorkers == 0; });
+                    m_stats.workers = static_cast<uint32_t>(m_workers.size());
+                }
+            }
+        }
+        
+        for (SkeletalAnimator* animator : m_animators) {
+            m_stats.bones += static_cast<uint32_t>(animator->GetModelMatrices().size());
+            if (animator->IsCpuSkinning() && animator->GetSkinnedMesh()) {
+                m_stats.skinnedVertices += static_cast<uint32_t>(animator->GetSkinnedPositions().size());
+            }
+        }
+        m_stats.animators = static_cast<uint32_t>(m_animators.size());
+        
+        auto endTime = std::chrono::steady_clock::now();
+        m_stats.updateTimeMs = std::chrono::duration<float, std::milli>(endTime - startTime).count();
+    }
+    
+    void SkeletalAnimationSystem::GatherAnimators(float deltaTime) {
+        m_animators.clear();
+        for (const auto& entity : m_world->GetEntities()) {
+            SkeletalAnimator* animator = entity->GetComponent<SkeletalAnimator>();
+            if (!animator || !animator->CanEvaluate()) {
+                continue;
+            }
+            animator->Advance(deltaTime);
+            m_animators.push_back(animator);
+        }
+    }
+    
+    void SkeletalAnimationSystem::RunChunks(BlendTreeContext& context) {
+        const size_t total = m_animators.size();
+        while (true) {
+            size_t first = m_nextChunk.fetch_add(ANIMATOR_CHUNK_SIZE, std::memory_order_relaxed);
+            if (first >= total) {
+                break;
+            }
+            size_t last = std::min(first + ANIMATOR_CHUNK_SIZE, total);
+            for (size_t i = first; i < last; ++i) {
+                m_animators[i]->Evaluate(context);
+            }
+        }
+    }
+    
+    void SkeletalAnimationSystem::RunJobs(JobSystem& jobs) {
+        static const ProfileNameId jobName = ProfileNames::Register("SkeletalAnimationSystem::Evaluate");
+        jobs.ParallelForRange(0, m_animators.size(), [this](size_t first, size_t last) {
+            // Порцию может взять любой поток планировщика - буферы у каждого свои
+            thread_local BlendTreeContext context;
+            for (size_t i = first; i < last; ++i) {
+                m_animators[i]->Evaluate(context);
+            }
+        }, ANIMATOR_CHUNK_SIZE, jobName);
+    }
+    
+    void SkeletalAnimationSystem::StartWorkers(uint32_t count) {
+        if (!m_workers.empty()) {
+            return;
+        }
+        
+        m_stopWorkers = false;
+        while (m_contexts.size() < count + 1) {
+            m_contexts.push_back(std::make_unique<BlendTreeContext>());
+        }
+        for (uint32_t i = 0; i < count; ++i) {
+            m_workers.emplace_back(&SkeletalAnimationSystem::WorkerThreadFunction, this, i + 1, m_jobGeneration);
+        }
+    }
+    
+    void SkeletalAnimationSystem::StopWorkers() {
+        {
+            std::lock_guard<std::mutex> lock(m_workMutex);
+            m_stopWorkers = true;
+        }
+        m_workCondition.notify_all();
+        
+        for (auto& worker : m_workers) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+        m_workers.clear();
+    }
+    
+    void SkeletalAnimationSystem::WorkerThreadFunction(uint32_t index, uint64_t seenGeneration) {
+        BlendTreeContext& context = *m_contexts[index];
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(m_workMutex);
+                m_workCondition.wait(lock, [this, seenGeneration]() {
+                    return m_stopWorkers || m_jobGeneration != seenGeneration;
+                });
+                if (m_stopWorkers) {
+                    return;
+                }
+                seenGeneration = m_jobGeneration;
+            }
+            
+            RunChunks(context);
+            
+            {
+                std::lock_guard<std::mutex> lock(m_workMutex);
+                if (--m_busyWorkers == 0) {
+                    m_doneCondition.notify_one();
+                }
+            }
+        }
+    }
+}
@@ -1,4 +1,6 @@
 #include "FastEngine/AI/BehaviorTree.h"
+#include "FastEngine/AI/CompiledBehaviorTree.h"
+#include "FastEngine/Jobs/JobSystem.h"
 #include <iostream>
 #include <algorithm>
 #include <sstream>
@@ -366,7 +368,19 @@ std::shared_ptr<DelayNode> BehaviorTree::CreateDelay(float delay) {
 }
 
 // BehaviorTreeManager implementation
-BehaviorTreeManager::BehaviorTreeManager() {}
+BehaviorTreeManager::BehaviorTreeManager()
+    : m_agentCount(0)
+    , m_lodOrigin(0.0f)
+    , m_frameBudgetMs(0.0f)
+    , m_userData(nullptr)
+    , m_frame(0)
+    , m_time(0.0)
+    , m_lastTickedAgents(0)
+    , m_lastDeferredAgents(0)
+    , m_lastUpdateTimeMs(0.0f)
+    , m_tickedAgents(0) {}
+
+BehaviorTreeManager::~BehaviorTreeManager() {}
 
 bool BehaviorTreeManager::Initialize() {
     std::cout << "BehaviorTreeManager initialized successfully" << std::endl;
@@ -376,6 +390,12 @@ bool BehaviorTreeManager::Initialize() {
 void BehaviorTreeManager::Shutdown() {
     m_trees.clear();
     m_activeTrees.clear();
+    m_groups.clear();
+    m_groupIndex.clear();
+    m_agents.clear();
+    m_freeAgentIds.clear();
+    m_dueAgents.clear();
+    m_agentCount = 0;
     std::cout << "BehaviorTreeManager shutdown" << std::endl;
 }
 
@@ -402,15 +422,221 @@ std::shared_ptr<BehaviorTree> BehaviorTreeManager::GetTree(const std::string& na
     return (it != m_trees.end()) ? it->second : nullptr;
 }
 
+bool BehaviorTreeManager::AddCompiledTree(const std::string& name, std::shared_ptr<const CompiledBehaviorTree> tree) {
+    if (!tree) {
+        std::cerr << "Cannot add empty compiled behavior tree: " << name << std::endl;
+        return false;
+    }
+    if (m_groupIndex.find(name) != m_groupIndex.end()) {
+        std::cerr << "Compiled behavior tree already exists: " << name << std::endl;
+        return false;
+    }
+
+    AgentGroupEntry entry;
+    entry.name = name;
+    entry.group.reset(new BehaviorAgentGroup(std::move(tree)));
+    m_groupIndex[name] = static_cast<uint32_t>(m_groups.size());
+    m_groups.push_back(std::move(entry));
+    std::cout << "Added compiled behavior tree: " << name << std::endl;
+    return true;
+}
+
+BehaviorAgentId BehaviorTreeManager::AddAgent(const std::string& treeName) {
+    auto it = m_groupIndex.find(treeName);
+    if (it == m_groupIndex.end()) {
+        std::cerr << "Compiled behavior tree not found: " << treeName << std::endl;
+        return INVALID_BEHAVIOR_AGENT;
+    }
+
+    BehaviorAgentId id;
+    if (!m_freeAgentIds.empty()) {
+        id = m_freeAgentIds.back();
+        m_freeAgentIds.pop_back();
+    } else {
+        id = static_cast<BehaviorAgentId>(m_agents.size());
+        m_agents.push_back(AgentLocation{0, 0, false});
+    }
+
+    AgentGroupEntry& entry = m_groups[it->second];
+    uint32_t index = entry.group->AddAgent();
+
+    // Фаза из перемешанного идентификатора: соседние агенты попадают в разные кадры
+    AgentSchedule schedule;
+    schedule.position = glm::vec3(0.0f);
+    schedule.importance = 1.0f;
+    schedule.nextTickFrame = m_frame;
+    schedule.lastTickTime = m_time;
+    schedule.phase = id * 2654435761u;
+    entry.schedule.push_back(schedule);
+    entry.ids.push_back(id);
+
+    m_agents[id] = AgentLocation{it->second, index, true};
+    ++m_agentCount;
+    return id;
+}
+
+void BehaviorTreeManager::RemoveAgent(BehaviorAgentId agent) {
+    if (!HasAgent(agent)) {
+        return;
+    }
+
+    AgentLocation location = m_agents[agent];
+    AgentGroupEntry& entry = m_groups[location.group];
+    uint32_t last = static_cast<uint32_t>(entry.ids.size() - 1);
+
+    // Группа переносит последнего агента на место удаленного - повторяем это в расписании
+    entry.group->RemoveAgent(location.index);
+    if (location.index != last) {
+        entry.schedule[location.index] = entry.schedule[last];
+        entry.ids[location.index] = entry.ids[last];
+        m_agents[entry.ids[location.index]].index = location.index;
+    }
+    entry.schedule.pop_back();
+    entry.ids.pop_back();
+
+    m_agents[agent].alive = false;
+    m_freeAgentIds.push_back(agent);
+    --m_agentCount;
+}
+
+bool BehaviorTreeManager::HasAgent(BehaviorAgentId agent) const {
+    return agent < m_agents.size() && m_agents[agent].alive;
+}
+
+Blackboard BehaviorTreeManager::GetBlackboard(BehaviorAgentId agent) {
+    if (!HasAgent(agent)) {
+        return Blackboard(nullptr);
+    }
+    const AgentLocation& location = m_agents[agent];
+    return m_groups[location.group].group->GetBlackboard(location.index);
+}
+
+BehaviorStatus BehaviorTreeManager::GetAgentStatus(BehaviorAgentId agent) const {
+    if (!HasAgent(agent)) {
+        return BehaviorStatus::Failure;
+    }
+    const AgentLocation& location = m_agents[agent];
+    return m_groups[location.group].group->GetStatus(location.index);
+}
+
+void BehaviorTreeManager::SetAgentPosition(BehaviorAgentId agent, const glm::vec3& position) {
+    if (HasAgent(agent)) {
+        const AgentLocation& location = m_agents[agent];
+        m_groups[location.group].schedule[location.index].position = position;
+    }
+}
+
+void BehaviorTreeManager::SetAgentImportance(BehaviorAgentId agent, float importance) {
+    if (HasAgent(agent)) {
+        const AgentLocation& location = m_agents[agent];
+        m_groups[location.group].schedule[location.index].importance = std::max(importance, 0.001f);
+    }
+}
+
+void BehaviorTreeManager::SetLodLevels(const std::vector<BehaviorLodLevel>& levels) {
+    m_lodLevels = levels;
+    std::sort(m_lodLevels.begin(), m_lodLevels.end(),
+              [](const BehaviorLodLevel& a, const BehaviorLodLevel& b) { return a.maxDistance < b.maxDistance; });
+    for (auto& level : m_lodLevels) {
+        level.tickInterval = std::max(level.tickInterval, 1);
+    }
+}
+
+int BehaviorTreeManager::GetTickInterval(const AgentSchedule& schedule) const {
+    if (m_lodLevels.empty()) {
+        return 1;
+    }
+
+    // Сравниваем квадраты расстояний, важность сокращает эффективную дистанцию
+    glm::vec3 offset = schedule.position - m_lodOrigin;
+    float distanceSq = glm::dot(offset, offset) / (schedule.importance * schedule.importance);
+    for (const auto& level : m_lodLevels) {
+        if (distanceSq <= level.maxDistance * level.maxDistance) {
+            return level.tickInterval;
+        }
+    }
+    return m_lodLevels.back().tickInterval;
+}
+
 void BehaviorTreeManager::Update(float deltaTime) {
-    // В реальной реализации здесь бы обновлялись все активные деревья
+    auto startTime = std::chrono::steady_clock::now();
+
+    // Деревья на узлах - последовательно, каждое со своим контекстом
     for (const auto& treeName : m_activeTrees) {
         auto tree = GetTree(treeName);
         if (tree) {
-            // Обновляем дерево
-            std::cout << "Updating behavior tree: " << treeName << std::endl;
+            tree->Execute();
         }
     }
+
+    m_time += deltaTime;
+
+    // Сначала отложенные с прошлых кадров, затем пришедшие по расписанию
+    m_dueAgents.clear();
+    m_scheduledAgents.clear();
+    for (uint32_t group = 0; group < m_groups.size(); ++group) {
+        const auto& schedule = m_groups[group].schedule;
+        for (uint32_t index = 0; index < schedule.size(); ++index) {
+            uint64_t nextTick = schedule[index].nextTickFrame;
+            if (nextTick < m_frame) {
+                m_dueAgents.push_back(TickItem{group, index});
+            } else if (nextTick == m_frame) {
+                m_scheduledAgents.push_back(TickItem{group, index});
+            }
+        }
+    }
+    m_dueAgents.insert(m_dueAgents.end(), m_scheduledAgents.begin(), m_scheduledAgents.end());
+
+    m_tickedAgents.store(0, std::memory_order_relaxed);
+    m_deadline = m_frameBudgetMs > 0.0f
+        ? startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+              std::chrono::duration<float, std::milli>(m_frameBudgetMs))
+        : std::chrono::steady_clock::time_point::max();
+
+    static const ProfileNameId tickJob = ProfileNames::Register("BehaviorTreeManager::Tick");
+    JobSystem::GetInstance().ParallelForRange(0, m_dueAgents.size(), [this](size_t first, size_t last) {
+        RunTickChunks(first, last);
+    }, TICK_CHUNK_SIZE, tickJob);
+
+    m_lastTickedAgents = m_tickedAgents.load(std::memory_order_relaxed);
+    m_lastDeferredAgents = m_dueAgents.size() - m_lastTickedAgents;
+    ++m_frame;
+
+    auto endTime = std::chrono::steady_clock::now();
+    m_lastUpdateTimeMs = std::chrono::duration<float, std::milli>(endTime - startTime).count();
+}
+
+void BehaviorTreeManager::RunTickChunks(size_t first, size_t last) {
+    size_t ticked = 0;
+
+    for (size_t begin = first; begin < last; begin += TICK_CHUNK_SIZE) {
+        // Бюджет проверяется перед каждой порцией: начатая порция доводится до конца.
+        // Первая порция кадра выполняется всегда, чтобы очередь не стояла
+        if (begin != 0 && std::chrono::steady_clock::now() >= m_deadline) {
+            break;
+        }
+        size_t end = std::min(begin + TICK_CHUNK_SIZE, last);
+        for (size_t i = begin; i < end; ++i) {
+            TickAgent(m_dueAgents[i]);
+        }
+        ticked += end - begin;
+    }
+
+    m_tickedAgents.fetch_add(ticked, std::memory_order_relaxed);
+}
+
+void BehaviorTreeManager::TickAgent(const TickItem& item) {
+    AgentGroupEntry& entry = m_groups[item.group];
+    AgentSchedule& schedule = entry.schedule[item.index];
+
+    float deltaTime = static_cast<float>(m_time - schedule.lastTickTime);
+    schedule.lastTickTime = m_time;
+    entry.group->Tick(item.index, deltaTime, m_userData);
+
+    // Следующий кадр фазы агента: (frame + phase) % interval == 0
+    uint64_t interval = static_cast<uint64_t>(GetTickInterval(schedule));
+    uint64_t offset = (m_frame + schedule.phase) % interval;
+    schedule.nextTickFrame = m_frame + (interval - offset);
 }
 
 } // namespace FastEngine
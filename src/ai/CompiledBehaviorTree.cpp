@@ -0,0 +1,432 @@
+#include "FastEngine/AI/CompiledBehaviorTree.h"
+#include <iostream>
+#include <algorithm>
+
+namespace FastEngine {
+
+// CompiledBehaviorTree implementation
+CompiledBehaviorTree::CompiledBehaviorTree() : m_stateSlotCount(0), m_timerSlotCount(0) {}
+
+// BehaviorTreeBuilder implementation
+BehaviorTreeBuilder::BehaviorTreeBuilder()
+    : m_tree(std::make_shared<CompiledBehaviorTree>())
+    , m_valid(true) {
+}
+
+uint32_t BehaviorTreeBuilder::AddNode(BehaviorNodeType type, bool composite) {
+    auto& nodes = m_tree->m_nodes;
+
+    if (m_openNodes.empty() && !nodes.empty()) {
+        std::cerr << "BehaviorTreeBuilder: Tree already has a root" << std::endl;
+        m_valid = false;
+    }
+
+    if (!m_openNodes.empty()) {
+        CompiledBehaviorNode& parent = nodes[m_openNodes.back()];
+        ++parent.childCount;
+
+        if ((parent.type == BehaviorNodeType::Inverter || parent.type == BehaviorNodeType::Repeat) &&
+            parent.childCount > 1) {
+            std::cerr << "BehaviorTreeBuilder: Decorator node accepts a single child" << std::endl;
+            m_valid = false;
+        }
+        if (parent.type == BehaviorNodeType::Parallel &&
+            parent.childCount > CompiledBehaviorTree::MAX_PARALLEL_CHILDREN) {
+            std::cerr << "BehaviorTreeBuilder: Too many children in parallel node" << std::endl;
+            m_valid = false;
+        }
+    }
+
+    CompiledBehaviorNode node = {};
+    node.type = type;
+    node.parent = m_openNodes.empty() ? CompiledBehaviorNode::INVALID_INDEX : m_openNodes.back();
+    node.stateSlot = m_tree->m_stateSlotCount;
+    node.timerSlot = m_tree->m_timerSlotCount;
+
+    switch (type) {
+        case BehaviorNodeType::Sequence:
+        case BehaviorNodeType::Selector:
+        case BehaviorNodeType::Parallel:
+        case BehaviorNodeType::Repeat:
+            ++m_tree->m_stateSlotCount;
+            break;
+        case BehaviorNodeType::Delay:
+            ++m_tree->m_timerSlotCount;
+            break;
+        default:
+            break;
+    }
+
+    uint32_t index = static_cast<uint32_t>(nodes.size());
+    node.next = index + 1;
+    node.stateEnd = m_tree->m_stateSlotCount;
+    node.timerEnd = m_tree->m_timerSlotCount;
+    nodes.push_back(node);
+
+    if (composite) {
+        m_openNodes.push_back(index);
+    }
+    return index;
+}
+
+BehaviorTreeBuilder& BehaviorTreeBuilder::Sequence() {
+    AddNode(BehaviorNodeType::Sequence, true);
+    return *this;
+}
+
+BehaviorTreeBuilder& BehaviorTreeBuilder::Selector() {
+    AddNode(BehaviorNodeType::Selector, true);
+    return *this;
+}
+
+BehaviorTreeBuilder& BehaviorTreeBuilder::Parallel(int successRequired, int failureRequired) {
+    uint32_t index = AddNode(BehaviorNodeType::Parallel, true);
+    m_tree->m_nodes[index].param0 = successRequired;
+    m_tree->m_nodes[index].param1 = failureRequired;
+    return *this;
+}
+
+BehaviorTreeBuilder& BehaviorTreeBuilder::Repeat(int count) {
+    uint32_t index = AddNode(BehaviorNodeType::Repeat, true);
+    m_tree->m_nodes[index].param0 = count;
+    return *this;
+}
+
+BehaviorTreeBuilder& BehaviorTreeBuilder::Inverter() {
+    AddNode(BehaviorNodeType::Inverter, true);
+    return *this;
+}
+
+BehaviorTreeBuilder& BehaviorTreeBuilder::End() {
+    if (m_openNodes.empty()) {
+        std::cerr << "BehaviorTreeBuilder: End() without open composite node" << std::endl;
+        m_valid = false;
+        return *this;
+    }
+
+    // Поддерево закрыто: известны его границы в массиве узлов и слотов
+    CompiledBehaviorNode& node = m_tree->m_nodes[m_openNodes.back()];
+    node.next = static_cast<uint32_t>(m_tree->m_nodes.size());
+    node.stateEnd = m_tree->m_stateSlotCount;
+    node.timerEnd = m_tree->m_timerSlotCount;
+    m_openNodes.pop_back();
+    return *this;
+}
+
+BehaviorTreeBuilder& BehaviorTreeBuilder::Condition(BehaviorConditionFunc condition) {
+    uint32_t index = AddNode(BehaviorNodeType::Condition, false);
+    m_tree->m_nodes[index].callback = static_cast<uint32_t>(m_tree->m_conditions.size());
+    m_tree->m_conditions.push_back(condition);
+    return *this;
+}
+
+BehaviorTreeBuilder& BehaviorTreeBuilder::Action(BehaviorActionFunc action) {
+    uint32_t index = AddNode(BehaviorNodeType::Action, false);
+    m_tree->m_nodes[index].callback = static_cast<uint32_t>(m_tree->m_actions.size());
+    m_tree->m_actions.push_back(action);
+    return *this;
+}
+
+BehaviorTreeBuilder& BehaviorTreeBuilder::Delay(float delay) {
+    uint32_t index = AddNode(BehaviorNodeType::Delay, false);
+    m_tree->m_nodes[index].delay = delay;
+    return *this;
+}
+
+std::shared_ptr<const CompiledBehaviorTree> BehaviorTreeBuilder::Build() {
+    if (m_tree->m_nodes.empty()) {
+        std::cerr << "BehaviorTreeBuilder: Tree is empty" << std::endl;
+        return nullptr;
+    }
+    if (!m_openNodes.empty()) {
+        std::cerr << "BehaviorTreeBuilder: " << m_openNodes.size() << " composite nodes are not closed" << std::endl;
+        return nullptr;
+    }
+    if (!m_valid) {
+        return nullptr;
+    }
+
+    std::shared_ptr<const CompiledBehaviorTree> tree = m_tree;
+
+    // Построитель переходит к новому пустому дереву
+    m_tree = std::make_shared<CompiledBehaviorTree>();
+    m_valid = true;
+    return tree;
+}
+
+// BehaviorAgentGroup implementation
+BehaviorAgentGroup::BehaviorAgentGroup(std::shared_ptr<const CompiledBehaviorTree> tree)
+    : m_tree(std::move(tree))
+    , m_nodes(m_tree->GetNodes().data())
+    , m_stateStride(m_tree->GetStateSlotCount())
+    , m_timerStride(m_tree->GetTimerSlotCount())
+    , m_blackboardStride((m_tree->GetLayout().GetSize() + sizeof(BlackboardChunk) - 1) / sizeof(BlackboardChunk)) {
+}
+
+uint32_t BehaviorAgentGroup::AddAgent() {
+    uint32_t agent = static_cast<uint32_t>(m_status.size());
+    m_status.push_back(BehaviorStatus::Success);
+    m_resume.push_back(CompiledBehaviorNode::INVALID_INDEX);
+    m_states.resize(m_states.size() + m_stateStride, 0);
+    m_timers.resize(m_timers.size() + m_timerStride, 0.0f);
+    m_blackboards.resize(m_blackboards.size() + m_blackboardStride, BlackboardChunk{});
+    return agent;
+}
+
+void BehaviorAgentGroup::RemoveAgent(uint32_t agent) {
+    const uint32_t last = static_cast<uint32_t>(m_status.size()) - 1;
+    if (agent != last) {
+        m_status[agent] = m_status[last];
+        m_resume[agent] = m_resume[last];
+        std::copy_n(m_states.begin() + static_cast<size_t>(last) * m_stateStride, m_stateStride,
+                    m_states.begin() + static_cast<size_t>(agent) * m_stateStride);
+        std::copy_n(m_timers.begin() + static_cast<size_t>(last) * m_timerStride, m_timerStride,
+                    m_timers.begin() + static_cast<size_t>(agent) * m_timerStride);
+        std::copy_n(m_blackboards.begin() + static_cast<size_t>(last) * m_blackboardStride, m_blackboardStride,
+                    m_blackboards.begin() + static_cast<size_t>(agent) * m_blackboardStride);
+    }
+
+    m_status.pop_back();
+    m_resume.pop_back();
+    m_states.resize(m_states.size() - m_stateStride);
+    m_timers.resize(m_timers.size() - m_timerStride);
+    m_blackboards.resize(m_blackboards.size() - m_blackboardStride);
+}
+
+void BehaviorAgentGroup::ResetAgent(uint32_t agent) {
+    // Сбрасывается только состояние выполнения, доска сохраняется
+    m_status[agent] = BehaviorStatus::Success;
+    m_resume[agent] = CompiledBehaviorNode::INVALID_INDEX;
+    std::fill_n(m_states.begin() + static_cast<size_t>(agent) * m_stateStride, m_stateStride, 0u);
+    std::fill_n(m_timers.begin() + static_cast<size_t>(agent) * m_timerStride, m_timerStride, 0.0f);
+}
+
+void BehaviorAgentGroup::Reserve(size_t count) {
+    m_status.reserve(count);
+    m_resume.reserve(count);
+    m_states.reserve(count * m_stateStride);
+    m_timers.reserve(count * m_timerStride);
+    m_blackboards.reserve(count * m_blackboardStride);
+}
+
+BehaviorStatus BehaviorAgentGroup::Tick(uint32_t agent, float deltaTime, void* userData) {
+    AgentCursor cursor;
+    cursor.states = m_states.data() + static_cast<size_t>(agent) * m_stateStride;
+    cursor.timers = m_timers.data() + static_cast<size_t>(agent) * m_timerStride;
+    cursor.resume = CompiledBehaviorNode::INVALID_INDEX;
+
+    BehaviorTickContext context(BlackboardData(agent), agent, deltaTime, userData);
+    BehaviorStatus status;
+
+    uint32_t node = m_resume[agent];
+    if (node == CompiledBehaviorNode::INVALID_INDEX) {
+        status = TickNode(0, cursor, context);
+    } else {
+        // Продолжение с выполнявшегося узла: предки получают его результат
+        // так же, как если бы вызвали его сами при обходе от корня
+        status = TickNode(node, cursor, context);
+        while (status != BehaviorStatus::Running && m_nodes[node].parent != CompiledBehaviorNode::INVALID_INDEX) {
+            uint32_t parent = m_nodes[node].parent;
+            status = ContinueAfterChild(parent, node, status, cursor, context);
+            node = parent;
+        }
+    }
+
+    m_resume[agent] = status == BehaviorStatus::Running ? cursor.resume : CompiledBehaviorNode::INVALID_INDEX;
+    m_status[agent] = status;
+    return status;
+}
+
+void BehaviorAgentGroup::TickRange(uint32_t first, uint32_t last, float deltaTime, void* userData) {
+    last = std::min(last, static_cast<uint32_t>(m_status.size()));
+    for (uint32_t agent = first; agent < last; ++agent) {
+        Tick(agent, deltaTime, userData);
+    }
+}
+
+void BehaviorAgentGroup::TickAll(float deltaTime, void* userData) {
+    TickRange(0, static_cast<uint32_t>(m_status.size()), deltaTime, userData);
+}
+
+BehaviorStatus BehaviorAgentGroup::TickNode(uint32_t index, AgentCursor& cursor,
+                                            BehaviorTickContext& context) const {
+    const CompiledBehaviorNode& node = m_nodes[index];
+
+    switch (node.type) {
+        case BehaviorNodeType::Sequence:
+        case BehaviorNodeType::Selector: {
+            // Продолжаем с потомка, вернувшего Running в прошлый раз
+            uint32_t current = cursor.states[node.stateSlot];
+            uint32_t child = index + 1;
+            for (uint32_t i = 0; i < current; ++i) {
+                child = m_nodes[child].next;
+            }
+            return RunChildren(index, current, child, cursor, context);
+        }
+
+        case BehaviorNodeType::Parallel: {
+            // Статусы потомков по 2 бита: 0 - выполняется, 1 - успех, 2 - неудача
+            uint32_t& packed = cursor.states[node.stateSlot];
+            int successCount = 0;
+            int failureCount = 0;
+
+            uint32_t child = index + 1;
+            for (uint32_t i = 0; i < node.childCount; ++i, child = m_nodes[child].next) {
+                uint32_t childStatus = (packed >> (i * 2)) & 3u;
+                if (childStatus == 0) {
+                    BehaviorStatus status = TickNode(child, cursor, context);
+                    childStatus = status == BehaviorStatus::Success ? 1u : (status == BehaviorStatus::Failure ? 2u : 0u);
+                    packed |= childStatus << (i * 2);
+                }
+
+                if (childStatus == 1) {
+                    ++successCount;
+                } else if (childStatus == 2) {
+                    ++failureCount;
+                }
+            }
+
+            // По завершении сбрасывается все поддерево: потомки, оставшиеся
+            // в Running, при следующем выполнении узла начнут заново
+            if (successCount >= node.param0) {
+                ResetSubtree(node, cursor);
+                return BehaviorStatus::Success;
+            }
+            if (failureCount >= node.param1) {
+                ResetSubtree(node, cursor);
+                return BehaviorStatus::Failure;
+            }
+
+            // Несколько потомков могут выполняться одновременно - продолжаем с самого узла
+            cursor.resume = index;
+            return BehaviorStatus::Running;
+        }
+
+        case BehaviorNodeType::Condition: {
+            BehaviorConditionFunc condition = m_tree->GetCondition(node.callback);
+            return condition && condition(context) ? BehaviorStatus::Success : BehaviorStatus::Failure;
+        }
+
+        case BehaviorNodeType::Action: {
+            BehaviorActionFunc action = m_tree->GetAction(node.callback);
+            BehaviorStatus status = action ? action(context) : BehaviorStatus::Failure;
+            if (status == BehaviorStatus::Running) {
+                cursor.resume = index;
+            }
+            return status;
+        }
+
+        case BehaviorNodeType::Repeat: {
+            if (node.childCount == 0) {
+                return BehaviorStatus::Failure;
+            }
+
+            BehaviorStatus status = TickNode(index + 1, cursor, context);
+            if (status == BehaviorStatus::Running) {
+                return BehaviorStatus::Running;
+            }
+            return FinishRepeatIteration(index, status, cursor);
+        }
+
+        case BehaviorNodeType::Inverter: {
+            if (node.childCount == 0) {
+                return BehaviorStatus::Failure;
+            }
+            return ContinueAfterChild(index, index + 1, TickNode(index + 1, cursor, context), cursor, context);
+        }
+
+        case BehaviorNodeType::Delay: {
+            float& elapsed = cursor.timers[node.timerSlot];
+            elapsed += context.deltaTime;
+            if (elapsed >= node.delay) {
+                elapsed = 0.0f;
+                return BehaviorStatus::Success;
+            }
+            cursor.resume = index;
+            return BehaviorStatus::Running;
+        }
+    }
+
+    return BehaviorStatus::Failure;
+}
+
+BehaviorStatus BehaviorAgentGroup::RunChildren(uint32_t index, uint32_t position, uint32_t child,
+                                               AgentCursor& cursor, BehaviorTickContext& context) const {
+    // Sequence прерывается на первой неудаче, Selector - на первом успехе
+    const CompiledBehaviorNode& node = m_nodes[index];
+    const BehaviorStatus stopStatus = node.type == BehaviorNodeType::Sequence ?
+        BehaviorStatus::Failure : BehaviorStatus::Success;
+    uint32_t& current = cursor.states[node.stateSlot];
+
+    for (uint32_t i = position; i < node.childCount; ++i, child = m_nodes[child].next) {
+        BehaviorStatus status = TickNode(child, cursor, context);
+        if (status == BehaviorStatus::Running) {
+            current = i;
+            return BehaviorStatus::Running;
+        }
+        if (status == stopStatus) {
+            current = 0;
+            return stopStatus;
+        }
+    }
+
+    current = 0;
+    return stopStatus == BehaviorStatus::Failure ? BehaviorStatus::Success : BehaviorStatus::Failure;
+}
+
+BehaviorStatus BehaviorAgentGroup::FinishRepeatIteration(uint32_t index, BehaviorStatus childStatus,
+                                                         AgentCursor& cursor) const {
+    const CompiledBehaviorNode& node = m_nodes[index];
+    uint32_t& count = cursor.states[node.stateSlot];
+
+    ResetSubtree(m_nodes[index + 1], cursor);
+
+    // Следующая итерация начнется с самого узла Repeat
+    if (node.param0 < 0 || static_cast<int32_t>(++count) < node.param0) {
+        cursor.resume = index;
+        return BehaviorStatus::Running;
+    }
+
+    count = 0;
+    return childStatus;
+}
+
+BehaviorStatus BehaviorAgentGroup::ContinueAfterChild(uint32_t parent, uint32_t child, BehaviorStatus childStatus,
+                                                      AgentCursor& cursor, BehaviorTickContext& context) const {
+    const CompiledBehaviorNode& node = m_nodes[parent];
+
+    switch (node.type) {
+        case BehaviorNodeType::Sequence:
+        case BehaviorNodeType::Selector: {
+            const BehaviorStatus stopStatus = node.type == BehaviorNodeType::Sequence ?
+                BehaviorStatus::Failure : BehaviorStatus::Success;
+            if (childStatus == stopStatus) {
+                cursor.states[node.stateSlot] = 0;
+                return stopStatus;
+            }
+
+            // Остальные потомки после завершившегося
+            uint32_t position = cursor.states[node.stateSlot] + 1;
+            return RunChildren(parent, position, m_nodes[child].next, cursor, context);
+        }
+
+        case BehaviorNodeType::Repeat:
+            return FinishRepeatIteration(parent, childStatus, cursor);
+
+        case BehaviorNodeType::Inverter:
+            if (childStatus == BehaviorStatus::Success) return BehaviorStatus::Failure;
+            if (childStatus == BehaviorStatus::Failure) return BehaviorStatus::Success;
+            return BehaviorStatus::Running;
+
+        default:
+            // Parallel сам становится точкой продолжения, поэтому ниже него тик не начинается
+            return childStatus;
+    }
+}
+
+void BehaviorAgentGroup::ResetSubtree(const CompiledBehaviorNode& node, AgentCursor& cursor) const {
+    std::fill(cursor.states + node.stateSlot, cursor.states + node.stateEnd, 0u);
+    std::fill(cursor.timers + node.timerSlot, cursor.timers + node.timerEnd, 0.0f);
+}
+
+} // namespace FastEngine
@@ -0,0 +1,676 @@
+#include "FastEngine/AI/HierarchicalPathfinding.h"
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace FastEngine {
+
+HierarchicalPathfinder::HierarchicalPathfinder()
+    : m_clusterSize(16.0f)
+    , m_smoothPath(true)
+    , m_origin(0.0f)
+    , m_clusterCountX(0)
+    , m_clusterCountZ(0)
+    , m_flushCache(false)
+    , m_cacheCapacity(256)
+    , m_cacheHits(0)
+    , m_cacheMisses(0)
+    , m_lastAbstractNodesExplored(0) {
+}
+
+void HierarchicalPathfinder::SetCacheCapacity(size_t capacity) {
+    m_cacheCapacity = capacity;
+    while (m_cache.size() > m_cacheCapacity) {
+        m_cacheIndex.erase(m_cache.back().key);
+        m_cache.pop_back();
+    }
+}
+
+bool HierarchicalPathfinder::Build(std::shared_ptr<const NavMesh> navMesh) {
+    Clear();
+
+    if (!navMesh || !navMesh->IsValid() || m_clusterSize <= 0.0f) {
+        std::cerr << "HierarchicalPathfinder: Invalid NavMesh or cluster size" << std::endl;
+        return false;
+    }
+    m_navMesh = std::move(navMesh);
+
+    const auto& nodes = m_navMesh->GetNodes();
+
+    // Кластеры - квадратная решетка над границами сетки в плоскости XZ
+    glm::vec2 minBound(std::numeric_limits<float>::max());
+    glm::vec2 maxBound(-std::numeric_limits<float>::max());
+    for (const auto& node : nodes) {
+        minBound = glm::min(minBound, glm::vec2(node.position.x, node.position.z));
+        maxBound = glm::max(maxBound, glm::vec2(node.position.x, node.position.z));
+    }
+
+    m_origin = minBound;
+    m_clusterCountX = static_cast<int>((maxBound.x - minBound.x) / m_clusterSize) + 1;
+    m_clusterCountZ = static_cast<int>((maxBound.y - minBound.y) / m_clusterSize) + 1;
+    const int clusterCount = m_clusterCountX * m_clusterCountZ;
+
+    m_nodeCluster.resize(nodes.size());
+    m_clusterNodes.assign(clusterCount, std::vector<int>());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        int x = std::min(static_cast<int>((nodes[i].position.x - m_origin.x) / m_clusterSize), m_clusterCountX - 1);
+        int z = std::min(static_cast<int>((nodes[i].position.z - m_origin.y) / m_clusterSize), m_clusterCountZ - 1);
+        m_nodeCluster[i] = z * m_clusterCountX + x;
+        m_clusterNodes[m_nodeCluster[i]].push_back(static_cast<int>(i));
+    }
+
+    // Соседство кластеров определяется топологией сетки, а не проходимостью
+    m_clusterNeighbors.assign(clusterCount, std::vector<int>());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const int cluster = m_nodeCluster[i];
+        for (int neighbor : m_navMesh->GetNeighbors(static_cast<int>(i))) {
+            const int other = m_nodeCluster[neighbor];
+            if (other == cluster) continue;
+
+            auto& list = m_clusterNeighbors[cluster];
+            if (std::find(list.begin(), list.end(), other) == list.end()) {
+                list.push_back(other);
+            }
+        }
+    }
+
+    m_clusterPortals.assign(clusterCount, std::vector<int>());
+    for (int cluster = 0; cluster < clusterCount; ++cluster) {
+        for (int other : m_clusterNeighbors[cluster]) {
+            if (cluster < other) {
+                BuildEntrance(cluster, other);
+            }
+        }
+    }
+    for (int cluster = 0; cluster < clusterCount; ++cluster) {
+        BuildIntraEdges(cluster);
+    }
+
+    std::cout << "HierarchicalPathfinder built: " << clusterCount << " clusters, "
+              << GetPortalCount() << " portals" << std::endl;
+    return true;
+}
+
+void HierarchicalPathfinder::Clear() {
+    m_navMesh.reset();
+    m_clusterCountX = 0;
+    m_clusterCountZ = 0;
+    m_nodeCluster.clear();
+    m_clusterNodes.clear();
+    m_clusterNeighbors.clear();
+    m_portals.clear();
+    m_freePortals.clear();
+    m_clusterPortals.clear();
+    m_entrancePortals.clear();
+    m_dirtyClusters.clear();
+    m_flushCache = false;
+    m_cache.clear();
+    m_cacheIndex.clear();
+}
+
+PathfindingResult HierarchicalPathfinder::FindPath(const glm::vec3& start, const glm::vec3& end) {
+    PathfindingResult result;
+
+    if (!m_navMesh) {
+        std::cerr << "HierarchicalPathfinder: Not built" << std::endl;
+        return result;
+    }
+
+    RepairDirtyClusters();
+
+    const int startNode = m_navMesh->FindNearestNode(start);
+    const int goalNode = m_navMesh->FindNearestNode(end);
+    if (startNode == -1 || goalNode == -1) {
+        std::cerr << "HierarchicalPathfinder: Could not find valid start or end node" << std::endl;
+        return result;
+    }
+
+    if (startNode == goalNode) {
+        result.success = true;
+        result.path = {start, end};
+        result.nodesExplored = 1;
+        return result;
+    }
+
+    const uint64_t key = PairKey(startNode, goalNode);
+    std::vector<int> nodePath;
+    float cost = 0.0f;
+    bool refined = false;
+
+    // Путь из кэша уточняется заново: локальные участки не хранятся
+    if (const CacheEntry* cached = FindCached(key)) {
+        refined = Refine(cached->abstractPath, nodePath, cost);
+        if (refined) {
+            ++m_cacheHits;
+        }
+    }
+
+    if (!refined) {
+        ++m_cacheMisses;
+
+        std::vector<int> abstractPath;
+        if (!SearchAbstract(startNode, goalNode, abstractPath)) {
+            return result;
+        }
+        if (!Refine(abstractPath, nodePath, cost)) {
+            std::cerr << "HierarchicalPathfinder: Failed to refine abstract path" << std::endl;
+            return result;
+        }
+        StoreCached(key, abstractPath);
+    }
+
+    const auto& nodes = m_navMesh->GetNodes();
+    result.path.reserve(nodePath.size());
+    for (int nodeIndex : nodePath) {
+        result.path.push_back(nodes[nodeIndex].position);
+    }
+
+    if (m_smoothPath) {
+        AStarPathfinding smoother;
+        result.path = smoother.SmoothPath(*m_navMesh, result.path);
+    }
+
+    result.success = true;
+    result.totalCost = cost;
+    result.nodesExplored = m_lastAbstractNodesExplored;
+    return result;
+}
+
+bool HierarchicalPathfinder::UpdateNavMesh(std::shared_ptr<const NavMesh> navMesh) {
+    if (!navMesh) {
+        return false;
+    }
+    if (navMesh == m_navMesh) {
+        return true;
+    }
+    if (!m_navMesh) {
+        return Build(std::move(navMesh));
+    }
+
+    // Кластеры и их соседство зависят от координат XZ и смежности узлов
+    const auto& previous = m_navMesh->GetNodes();
+    const auto& nodes = navMesh->GetNodes();
+    bool sameTopology = nodes.size() == previous.size() &&
+                        navMesh->GetAdjacencyOffsets() == m_navMesh->GetAdjacencyOffsets() &&
+                        navMesh->GetAdjacency() == m_navMesh->GetAdjacency();
+    for (size_t i = 0; sameTopology && i < nodes.size(); ++i) {
+        sameTopology = nodes[i].position.x == previous[i].position.x &&
+                       nodes[i].position.z == previous[i].position.z;
+    }
+    if (!sameTopology) {
+        return Build(std::move(navMesh));
+    }
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const NavNode& before = previous[i];
+        const NavNode& after = nodes[i];
+        if (after.walkable == before.walkable && after.cost == before.cost &&
+            after.position.y == before.position.y) {
+            continue;
+        }
+
+        m_dirtyClusters.insert(m_nodeCluster[i]);
+        // Узел стал доступнее или сменил высоту - путь мог стать короче
+        if ((after.walkable && !before.walkable) || after.cost < before.cost ||
+            after.position.y != before.position.y) {
+            m_flushCache = true;
+        }
+    }
+    m_navMesh = std::move(navMesh);
+    return true;
+}
+
+void HierarchicalPathfinder::RepairDirtyClusters() {
+    if (m_dirtyClusters.empty()) {
+        return;
+    }
+
+    // Перестраиваются входы измененных кластеров со всеми соседями и
+    // внутренние ребра всех кластеров, у которых поменялся набор порталов
+    std::unordered_set<uint64_t> pairs;
+    std::unordered_set<int> touched;
+    for (int cluster : m_dirtyClusters) {
+        touched.insert(cluster);
+        for (int other : m_clusterNeighbors[cluster]) {
+            touched.insert(other);
+            pairs.insert(PairKey(std::min(cluster, other), std::max(cluster, other)));
+        }
+    }
+
+    for (uint64_t pair : pairs) {
+        ReleaseEntrance(pair);
+    }
+    for (uint64_t pair : pairs) {
+        BuildEntrance(static_cast<int>(pair >> 32), static_cast<int>(pair & 0xFFFFFFFFu));
+    }
+    for (int cluster : touched) {
+        BuildIntraEdges(cluster);
+    }
+
+    if (m_flushCache) {
+        m_cache.clear();
+        m_cacheIndex.clear();
+    } else {
+        InvalidateCache(touched);
+    }
+
+    m_dirtyClusters.clear();
+    m_flushCache = false;
+}
+
+uint64_t HierarchicalPathfinder::PairKey(int a, int b) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(a)) << 32) | static_cast<uint32_t>(b);
+}
+
+int HierarchicalPathfinder::AllocatePortal(int navNode, int cluster) {
+    int index;
+    if (!m_freePortals.empty()) {
+        index = m_freePortals.back();
+        m_freePortals.pop_back();
+    } else {
+        index = static_cast<int>(m_portals.size());
+        m_portals.emplace_back();
+    }
+
+    Portal& portal = m_portals[index];
+    portal.navNode = navNode;
+    portal.cluster = cluster;
+    portal.active = true;
+    portal.edges.clear();
+
+    m_clusterPortals[cluster].push_back(index);
+    return index;
+}
+
+void HierarchicalPathfinder::ReleaseEntrance(uint64_t pairKey) {
+    auto it = m_entrancePortals.find(pairKey);
+    if (it == m_entrancePortals.end()) {
+        return;
+    }
+
+    for (int index : it->second) {
+        Portal& portal = m_portals[index];
+        auto& list = m_clusterPortals[portal.cluster];
+        list.erase(std::remove(list.begin(), list.end(), index), list.end());
+
+        portal.active = false;
+        portal.edges.clear();
+        m_freePortals.push_back(index);
+    }
+    m_entrancePortals.erase(it);
+}
+
+void HierarchicalPathfinder::BuildEntrance(int clusterA, int clusterB) {
+    const auto& nodes = m_navMesh->GetNodes();
+
+    // Проходимые ребра через границу кластеров
+    struct BorderEdge {
+        int from;
+        int to;
+    };
+    std::vector<BorderEdge> border;
+    for (int node : m_clusterNodes[clusterA]) {
+        if (!nodes[node].walkable) continue;
+
+        for (int neighbor : m_navMesh->GetNeighbors(node)) {
+            if (m_nodeCluster[neighbor] == clusterB && nodes[neighbor].walkable) {
+                border.push_back(BorderEdge{node, neighbor});
+            }
+        }
+    }
+    if (border.empty()) {
+        return;
+    }
+
+    // Непрерывные участки границы: ребра связаны, если их концы совпадают или соседствуют
+    auto touches = [this](int a, int b) {
+        if (a == b) return true;
+        NavIndexRange neighbors = m_navMesh->GetNeighbors(a);
+        return std::find(neighbors.begin(), neighbors.end(), b) != neighbors.end();
+    };
+
+    std::vector<int> group(border.size());
+    for (size_t i = 0; i < border.size(); ++i) {
+        group[i] = static_cast<int>(i);
+    }
+    auto findRoot = [&group](int i) {
+        while (group[i] != i) {
+            group[i] = group[group[i]];
+            i = group[i];
+        }
+        return i;
+    };
+    for (size_t i = 0; i < border.size(); ++i) {
+        for (size_t j = i + 1; j < border.size(); ++j) {
+            if (touches(border[i].from, border[j].from) || touches(border[i].to, border[j].to)) {
+                group[findRoot(static_cast<int>(i))] = findRoot(static_cast<int>(j));
+            }
+        }
+    }
+
+    // Порталы участка: короткий участок - одно ребро у центра,
+    // длинный - два крайних ребра, чтобы пути не делали крюк к середине
+    std::vector<std::vector<int>> groups;
+    std::unordered_map<int, size_t> groupSlot;
+    for (size_t i = 0; i < border.size(); ++i) {
+        int root = findRoot(static_cast<int>(i));
+        auto slot = groupSlot.emplace(root, groups.size());
+        if (slot.second) {
+            groups.emplace_back();
+        }
+        groups[slot.first->second].push_back(static_cast<int>(i));
+    }
+
+    auto midpoint = [&](int edgeIndex) {
+        return (nodes[border[edgeIndex].from].position + nodes[border[edgeIndex].to].position) * 0.5f;
+    };
+    auto farthestFrom = [&](const std::vector<int>& edges, const glm::vec3& point, bool nearest) {
+        int best = edges.front();
+        float bestDist = nearest ? std::numeric_limits<float>::max() : -1.0f;
+        for (int edgeIndex : edges) {
+            float dist = glm::distance(midpoint(edgeIndex), point);
+            if (nearest ? dist < bestDist : dist > bestDist) {
+                bestDist = dist;
+                best = edgeIndex;
+            }
+        }
+        return best;
+    };
+
+    std::vector<int>& entrance = m_entrancePortals[PairKey(clusterA, clusterB)];
+    auto addPortalPair = [&](const BorderEdge& edge) {
+        int portalA = AllocatePortal(edge.from, clusterA);
+        int portalB = AllocatePortal(edge.to, clusterB);
+        float length = glm::distance(nodes[edge.from].position, nodes[edge.to].position);
+        m_portals[portalA].edges.push_back(PortalEdge{portalB, length * nodes[edge.to].cost, false});
+        m_portals[portalB].edges.push_back(PortalEdge{portalA, length * nodes[edge.from].cost, false});
+
+        entrance.push_back(portalA);
+        entrance.push_back(portalB);
+    };
+
+    for (const auto& edges : groups) {
+        glm::vec3 center(0.0f);
+        for (int edgeIndex : edges) {
+            center += midpoint(edgeIndex);
+        }
+        center /= static_cast<float>(edges.size());
+
+        if (edges.size() < LONG_ENTRANCE_EDGES) {
+            addPortalPair(border[farthestFrom(edges, center, true)]);
+            continue;
+        }
+
+        int first = farthestFrom(edges, center, false);
+        int second = farthestFrom(edges, midpoint(first), false);
+        addPortalPair(border[first]);
+        addPortalPair(border[second]);
+    }
+}
+
+void HierarchicalPathfinder::BuildIntraEdges(int cluster) {
+    const std::vector<int>& portals = m_clusterPortals[cluster];
+    for (int index : portals) {
+        auto& edges = m_portals[index].edges;
+        edges.erase(std::remove_if(edges.begin(), edges.end(),
+                                   [](const PortalEdge& edge) { return edge.intra; }),
+                    edges.end());
+    }
+
+    // Дейкстра от каждого портала по узлам кластера
+    AStarScratch& scratch = AStarPathfinding::GetThreadScratch();
+    for (int index : portals) {
+        SearchCluster(cluster, m_portals[index].navNode, -1, false, scratch);
+
+        for (int other : portals) {
+            if (other == index) continue;
+
+            int navNode = m_portals[other].navNode;
+            if (scratch.IsClosed(navNode)) {
+                m_portals[index].edges.push_back(PortalEdge{other, scratch.GetG(navNode), true});
+            }
+        }
+    }
+}
+
+float HierarchicalPathfinder::SearchCluster(int cluster, int source, int target, bool reverse,
+                                            AStarScratch& scratch) const {
+    const auto& nodes = m_navMesh->GetNodes();
+    const glm::vec3 goal = target >= 0 ? nodes[target].position : glm::vec3(0.0f);
+
+    scratch.Begin(nodes.size());
+    scratch.Relax(source, 0.0f, -1);
+    scratch.PushOpen(target >= 0 ? glm::distance(nodes[source].position, goal) : 0.0f, source);
+
+    while (!scratch.OpenEmpty()) {
+        int current = scratch.PopOpen();
+        if (scratch.IsClosed(current)) {
+            continue;
+        }
+        if (current == target) {
+            return scratch.GetG(current);
+        }
+        scratch.Close(current);
+
+        const NavNode& node = nodes[current];
+        const float currentG = scratch.GetG(current);
+
+        for (int neighbor : m_navMesh->GetNeighbors(current)) {
+            if (m_nodeCluster[neighbor] != cluster || scratch.IsClosed(neighbor)) {
+                continue;
+            }
+
+            const NavNode& next = nodes[neighbor];
+            if (!next.walkable) {
+                continue;
+            }
+
+            // В обратном режиме считается стоимость пути к source: шаг
+            // neighbor -> current оплачивается стоимостью current
+            float step = glm::distance(node.position, next.position) * (reverse ? node.cost : next.cost);
+            float tentative = currentG + step;
+
+            if (!scratch.IsVisited(neighbor) || tentative < scratch.GetG(neighbor)) {
+                scratch.Relax(neighbor, tentative, current);
+                float h = target >= 0 ? glm::distance(next.position, goal) : 0.0f;
+                scratch.PushOpen(tentative + h, neighbor);
+            }
+        }
+    }
+
+    return -1.0f;
+}
+
+bool HierarchicalPathfinder::SearchAbstract(int startNode, int goalNode, std::vector<int>& abstractPath) {
+    const auto& nodes = m_navMesh->GetNodes();
+    const int startCluster = m_nodeCluster[startNode];
+    const int goalCluster = m_nodeCluster[goalNode];
+    AStarScratch& scratch = AStarPathfinding::GetThreadScratch();
+
+    // Связи старта с порталами своего кластера (и с целью в том же кластере)
+    std::vector<PortalEdge> startLinks;
+    SearchCluster(startCluster, startNode, -1, false, scratch);
+    for (int portal : m_clusterPortals[startCluster]) {
+        if (scratch.IsClosed(m_portals[portal].navNode)) {
+            startLinks.push_back(PortalEdge{portal, scratch.GetG(m_portals[portal].navNode), true});
+        }
+    }
+    const int portalCount = static_cast<int>(m_portals.size());
+    const int startId = portalCount;
+    const int goalId = portalCount + 1;
+    if (startCluster == goalCluster && scratch.IsClosed(goalNode)) {
+        startLinks.push_back(PortalEdge{goalId, scratch.GetG(goalNode), true});
+    }
+
+    // Связи порталов кластера цели с целью
+    std::vector<std::pair<int, float>> goalLinks;
+    SearchCluster(goalCluster, goalNode, -1, true, scratch);
+    for (int portal : m_clusterPortals[goalCluster]) {
+        if (scratch.IsClosed(m_portals[portal].navNode)) {
+            goalLinks.emplace_back(portal, scratch.GetG(m_portals[portal].navNode));
+        }
+    }
+
+    // A* по графу порталов; старт и цель - два дополнительных узла
+    const glm::vec3 goal = nodes[goalNode].position;
+    auto navNodeOf = [&](int id) {
+        return id == startId ? startNode : (id == goalId ? goalNode : m_portals[id].navNode);
+    };
+
+    m_abstractScratch.Begin(static_cast<size_t>(portalCount) + 2);
+    m_abstractScratch.Relax(startId, 0.0f, -1);
+    m_abstractScratch.PushOpen(glm::distance(nodes[startNode].position, goal), startId);
+
+    int explored = 0;
+    bool found = false;
+
+    auto relax = [&](int from, int to, float edgeCost) {
+        if (m_abstractScratch.IsClosed(to)) return;
+        float tentative = m_abstractScratch.GetG(from) + edgeCost;
+        if (!m_abstractScratch.IsVisited(to) || tentative < m_abstractScratch.GetG(to)) {
+            m_abstractScratch.Relax(to, tentative, from);
+            float h = to == goalId ? 0.0f : glm::distance(nodes[navNodeOf(to)].position, goal);
+            m_abstractScratch.PushOpen(tentative + h, to);
+        }
+    };
+
+    while (!m_abstractScratch.OpenEmpty()) {
+        int current = m_abstractScratch.PopOpen();
+        if (m_abstractScratch.IsClosed(current)) continue;
+        if (current == goalId) {
+            found = true;
+            break;
+        }
+        m_abstractScratch.Close(current);
+        ++explored;
+
+        if (current == startId) {
+            for (const auto& link : startLinks) {
+                relax(current, link.target, link.cost);
+            }
+            continue;
+        }
+
+        for (const auto& edge : m_portals[current].edges) {
+            relax(current, edge.target, edge.cost);
+        }
+        if (m_portals[current].cluster == goalCluster) {
+            for (const auto& link : goalLinks) {
+                if (link.first == current) {
+                    relax(current, goalId, link.second);
+                }
+            }
+        }
+    }
+
+    m_lastAbstractNodesExplored = explored;
+    if (!found) {
+        std::cerr << "HierarchicalPathfinder: Path not found" << std::endl;
+        return false;
+    }
+
+    abstractPath.clear();
+    for (int id = goalId; id != -1; id = m_abstractScratch.GetParent(id)) {
+        abstractPath.push_back(navNodeOf(id));
+    }
+    std::reverse(abstractPath.begin(), abstractPath.end());
+    return true;
+}
+
+bool HierarchicalPathfinder::Refine(const std::vector<int>& abstractPath, std::vector<int>& nodePath,
+                                    float& cost) const {
+    const auto& nodes = m_navMesh->GetNodes();
+    AStarScratch& scratch = AStarPathfinding::GetThreadScratch();
+    std::vector<int> segment;
+
+    nodePath.clear();
+    nodePath.push_back(abstractPath.front());
+    cost = 0.0f;
+
+    for (size_t i = 1; i < abstractPath.size(); ++i) {
+        const int from = abstractPath[i - 1];
+        const int to = abstractPath[i];
+        if (from == to) continue;
+
+        if (!nodes[to].walkable) {
+            return false;
+        }
+
+        if (m_nodeCluster[from] != m_nodeCluster[to]) {
+            // Переход через вход между кластерами - соседние узлы
+            cost += glm::distance(nodes[from].position, nodes[to].position) * nodes[to].cost;
+            nodePath.push_back(to);
+            continue;
+        }
+
+        float segmentCost = SearchCluster(m_nodeCluster[from], from, to, false, scratch);
+        if (segmentCost < 0.0f) {
+            return false;
+        }
+        cost += segmentCost;
+
+        segment.clear();
+        for (int node = to; node != from; node = scratch.GetParent(node)) {
+            segment.push_back(node);
+        }
+        nodePath.insert(nodePath.end(), segment.rbegin(), segment.rend());
+    }
+
+    return true;
+}
+
+const HierarchicalPathfinder::CacheEntry* HierarchicalPathfinder::FindCached(uint64_t key) {
+    auto it = m_cacheIndex.find(key);
+    if (it == m_cacheIndex.end()) {
+        return nullptr;
+    }
+
+    // Перемещаем запись в начало списка (последняя использованная)
+    m_cache.splice(m_cache.begin(), m_cache, it->second);
+    return &m_cache.front();
+}
+
+void HierarchicalPathfinder::StoreCached(uint64_t key, const std::vector<int>& abstractPath) {
+    if (m_cacheCapacity == 0) {
+        return;
+    }
+
+    auto existing = m_cacheIndex.find(key);
+    if (existing != m_cacheIndex.end()) {
+        m_cache.erase(existing->second);
+        m_cacheIndex.erase(existing);
+    }
+
+    CacheEntry entry;
+    entry.key = key;
+    entry.abstractPath = abstractPath;
+    for (int node : abstractPath) {
+        entry.clusters.push_back(m_nodeCluster[node]);
+    }
+    std::sort(entry.clusters.begin(), entry.clusters.end());
+    entry.clusters.erase(std::unique(entry.clusters.begin(), entry.clusters.end()), entry.clusters.end());
+
+    m_cache.push_front(std::move(entry));
+    m_cacheIndex[key] = m_cache.begin();
+
+    if (m_cache.size() > m_cacheCapacity) {
+        m_cacheIndex.erase(m_cache.back().key);
+        m_cache.pop_back();
+    }
+}
+
+void HierarchicalPathfinder::InvalidateCache(const std::unordered_set<int>& clusters) {
+    for (auto it = m_cache.begin(); it != m_cache.end();) {
+        bool affected = std::any_of(it->clusters.begin(), it->clusters.end(),
+                                    [&clusters](int cluster) { return clusters.count(cluster) > 0; });
+        if (affected) {
+            m_cacheIndex.erase(it->key);
+            it = m_cache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+} // namespace FastEngine
@@ -1,12 +1,18 @@
 #include "FastEngine/AI/NavMesh.h"
+#include "FastEngine/AI/Pathfinding.h"
+#include "FastEngine/Jobs/JobSystem.h"
 #include <iostream>
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <sstream>
+#include <thread>
 
 namespace FastEngine {
 
-NavMesh::NavMesh() {}
+NavMesh::NavMesh() : m_hasTileSource(false), m_tileThreshold(0.0f) {}
 
 bool NavMesh::GenerateFromMesh(const std::vector<glm::vec3>& vertices, 
                               const std::vector<unsigned int>& indices) {
@@ -16,9 +22,7 @@ bool NavMesh::GenerateFromMesh(const std::vector<glm::vec3>& vertices,
     }
     
     // Очищаем существующие данные
-    m_nodes.clear();
-    m_triangles.clear();
-    m_nodeToTriangles.clear();
+    ClearMesh();
     
     // Создаем узлы из вершин
     for (const auto& vertex : vertices) {
@@ -44,17 +48,39 @@ bool NavMesh::GenerateFromHeightmap(const std::vector<std::vector<float>>& heigh
         return false;
     }
     
-    m_nodes.clear();
-    m_triangles.clear();
-    m_nodeToTriangles.clear();
+    // Строки копируются в один непрерывный буфер
+    const size_t width = heightmap[0].size();
+    std::vector<float> flat(width * heightmap.size());
+    for (size_t y = 0; y < heightmap.size(); ++y) {
+        if (heightmap[y].size() != width) {
+            std::cerr << "NavMesh: Heightmap rows have different lengths" << std::endl;
+            return false;
+        }
+        std::copy(heightmap[y].begin(), heightmap[y].end(), flat.begin() + y * width);
+    }
+    
+    return GenerateFromHeightmap(HeightmapView(flat.data(), static_cast<int>(width), static_cast<int>(heightmap.size())),
+                                 cellSize, heightThreshold);
+}
+
+bool NavMesh::GenerateFromHeightmap(const HeightmapView& heightmap, float cellSize, float heightThreshold) {
+    if (!heightmap.IsValid()) {
+        std::cerr << "NavMesh: Invalid heightmap data" << std::endl;
+        return false;
+    }
     
-    int width = heightmap[0].size();
-    int height = heightmap.size();
+    ClearMesh();
+    
+    int width = heightmap.width;
+    int height = heightmap.height;
+    
+    m_nodes.reserve(static_cast<size_t>(width) * height);
+    m_triangles.reserve(static_cast<size_t>(width - 1) * (height - 1) * 2);
     
     // Создаем узлы из высотной карты
     for (int y = 0; y < height; ++y) {
         for (int x = 0; x < width; ++x) {
-            float heightValue = heightmap[y][x];
+            float heightValue = heightmap.At(x, y);
             bool walkable = heightValue >= heightThreshold;
             
             glm::vec3 position(x * cellSize, heightValue, y * cellSize);
@@ -97,106 +123,192 @@ std::vector<glm::vec3> NavMesh::FindPath(const glm::vec3& start, const glm::vec3
         return path;
     }
     
-    // Находим ближайшие узлы
-    int startNode = -1;
-    int endNode = -1;
-    float minStartDist = std::numeric_limits<float>::max();
-    float minEndDist = std::numeric_limits<float>::max();
+    // Поиск A* по узлам сетки без сглаживания: возвращаем позиции узлов.
+    // Ограничение итераций снято - поиск завершается, когда открытый список пуст
+    AStarPathfinding pathfinder;
+    pathfinder.SetSmoothing(false);
+    pathfinder.SetMaxIterations(std::numeric_limits<int>::max());
     
-    for (size_t i = 0; i < m_nodes.size(); ++i) {
-        if (!m_nodes[i].walkable) continue;
-        
-        float startDist = glm::distance(start, m_nodes[i].position);
-        float endDist = glm::distance(end, m_nodes[i].position);
-        
-        if (startDist < minStartDist) {
-            minStartDist = startDist;
-            startNode = static_cast<int>(i);
-        }
+    PathfindingResult result = pathfinder.FindPath(*this, start, end);
+    if (result.success) {
+        path = std::move(result.path);
+    }
+    
+    return path;
+}
+
+bool NavMesh::IsWalkable(const glm::vec3& position) const {
+    // Проверяем, находится ли точка в проходимом треугольнике
+    return FindTriangle(position, true) >= 0;
+}
+
+int NavMesh::FindTriangle(const glm::vec3& position, bool walkableOnly) const {
+    if (m_grid.IsEmpty() || !std::isfinite(position.x) || !std::isfinite(position.z)) {
+        return -1;
+    }
+    
+    // Треугольники-кандидаты - только те, чей AABB пересекает ячейку точки
+    NavIndexRange candidates = m_grid.GetTriangles(m_grid.CellX(position.x), m_grid.CellZ(position.z));
+    for (int triangleIndex : candidates) {
+        const NavTriangle& triangle = m_triangles[triangleIndex];
+        if (walkableOnly && !triangle.walkable) continue;
         
-        if (endDist < minEndDist) {
-            minEndDist = endDist;
-            endNode = static_cast<int>(i);
+        if (IsPointInTriangle(position, triangle)) {
+            return triangleIndex;
         }
     }
     
-    if (startNode == -1 || endNode == -1) {
-        std::cerr << "NavMesh: Could not find valid start or end node" << std::endl;
-        return path;
+    return -1;
+}
+
+glm::vec3 NavMesh::GetNearestWalkablePoint(const glm::vec3& position) const {
+    int nearest = FindNearestNode(position);
+    return nearest >= 0 ? m_nodes[nearest].position : position;
+}
+
+int NavMesh::FindNearestNode(const glm::vec3& position) const {
+    // Нечисловая точка не ближе ни к одному узлу
+    if (m_grid.IsEmpty() || !std::isfinite(position.x) || !std::isfinite(position.y) || !std::isfinite(position.z)) {
+        return -1;
     }
     
-    // Простой поиск пути (в реальной реализации здесь бы был A*)
-    std::vector<int> nodePath;
-    std::unordered_set<int> visited;
-    std::vector<int> queue = {startNode};
-    std::unordered_map<int, int> parent;
+    const int centerX = m_grid.CellX(position.x);
+    const int centerZ = m_grid.CellZ(position.z);
+    const int maxRadius = std::max(m_grid.width, m_grid.height);
     
-    visited.insert(startNode);
+    int nearest = -1;
+    float minDistSq = std::numeric_limits<float>::max();
     
-    while (!queue.empty()) {
-        int current = queue.front();
-        queue.erase(queue.begin());
+    // Обходим кольца ячеек вокруг точки, пока непросмотренные ячейки
+    // гарантированно не дальше найденного узла
+    for (int radius = 0; radius <= maxRadius; ++radius) {
+        const int minX = centerX - radius;
+        const int maxX = centerX + radius;
+        const int minZ = centerZ - radius;
+        const int maxZ = centerZ + radius;
         
-        if (current == endNode) {
-            // Восстанавливаем путь
-            int node = endNode;
-            while (node != -1) {
-                nodePath.push_back(node);
-                node = parent[node];
+        for (int z = std::max(minZ, 0); z <= std::min(maxZ, m_grid.height - 1); ++z) {
+            const bool edgeRow = (z == minZ || z == maxZ);
+            const int step = edgeRow ? 1 : (maxX - minX);
+            
+            for (int x = minX; x <= maxX; x += std::max(step, 1)) {
+                if (x < 0 || x >= m_grid.width) continue;
+                
+                for (int nodeIndex : m_grid.GetNodes(x, z)) {
+                    const NavNode& node = m_nodes[nodeIndex];
+                    if (!node.walkable) continue;
+                    
+                    glm::vec3 delta = node.position - position;
+                    float distSq = glm::dot(delta, delta);
+                    if (distSq < minDistSq) {
+                        minDistSq = distSq;
+                        nearest = nodeIndex;
+                    }
+                }
             }
-            std::reverse(nodePath.begin(), nodePath.end());
-            break;
         }
         
-        for (int neighbor : m_nodes[current].connections) {
-            if (visited.find(neighbor) == visited.end() && m_nodes[neighbor].walkable) {
-                visited.insert(neighbor);
-                parent[neighbor] = current;
-                queue.push_back(neighbor);
-            }
+        // Нижняя граница расстояния до еще не просмотренных ячеек
+        float bound = std::numeric_limits<float>::max();
+        if (minX > 0) bound = std::min(bound, position.x - (m_grid.origin.x + minX * m_grid.cellSize));
+        if (maxX < m_grid.width - 1) bound = std::min(bound, m_grid.origin.x + (maxX + 1) * m_grid.cellSize - position.x);
+        if (minZ > 0) bound = std::min(bound, position.z - (m_grid.origin.y + minZ * m_grid.cellSize));
+        if (maxZ < m_grid.height - 1) bound = std::min(bound, m_grid.origin.y + (maxZ + 1) * m_grid.cellSize - position.z);
+        
+        if (bound == std::numeric_limits<float>::max()) {
+            break; // Просмотрена вся сетка
+        }
+        if (nearest >= 0 && bound >= 0.0f && minDistSq <= bound * bound) {
+            break;
         }
     }
     
-    // Преобразуем в позиции
-    for (int nodeIndex : nodePath) {
-        path.push_back(m_nodes[nodeIndex].position);
-    }
-    
-    return path;
+    return nearest;
 }
 
-bool NavMesh::IsWalkable(const glm::vec3& position) const {
-    // Проверяем, находится ли точка в проходимом треугольнике
-    for (const auto& triangle : m_triangles) {
-        if (!triangle.walkable) continue;
-        
-        if (IsPointInTriangle(position, triangle)) {
-            return true;
-        }
+bool NavMesh::Raycast(const glm::vec3& from, const glm::vec3& to, glm::vec3* hitPoint) const {
+    int triangleIndex = FindTriangle(from, true);
+    if (triangleIndex < 0) {
+        if (hitPoint) *hitPoint = from;
+        return true;
     }
     
-    return false;
-}
-
-glm::vec3 NavMesh::GetNearestWalkablePoint(const glm::vec3& position) const {
-    if (m_nodes.empty()) {
-        return position;
+    const glm::vec2 origin(from.x, from.z);
+    const glm::vec2 direction(to.x - from.x, to.z - from.z);
+    const float length = glm::length(direction);
+    if (length < 1e-6f) {
+        return false;
     }
     
-    float minDist = std::numeric_limits<float>::max();
-    glm::vec3 nearestPoint = position;
+    auto cross2 = [](const glm::vec2& a, const glm::vec2& b) { return a.x * b.y - a.y * b.x; };
+    const float edgeEpsilon = 1e-5f;
+    const float probeStep = 1e-3f / length; // Шаг вдоль луча при проходе через вершину
     
-    for (const auto& node : m_nodes) {
-        if (!node.walkable) continue;
+    float currentT = 0.0f;
+    
+    // Каждый шаг продвигает луч в следующий треугольник, поэтому шагов не больше, чем треугольников
+    for (size_t step = 0; step <= m_triangles.size(); ++step) {
+        const NavTriangle& triangle = m_triangles[triangleIndex];
+        if (IsPointInTriangle(to, triangle)) {
+            return false;
+        }
+        
+        // Ребро выхода - пересечение отрезка с ребром с наибольшим параметром t
+        int exitEdge = -1;
+        float exitT = -1.0f;
+        for (int edge = 0; edge < 3; ++edge) {
+            const glm::vec3& a3 = m_nodes[triangle.vertices[edge]].position;
+            const glm::vec3& b3 = m_nodes[triangle.vertices[(edge + 1) % 3]].position;
+            const glm::vec2 a(a3.x, a3.z);
+            const glm::vec2 edgeVector(b3.x - a3.x, b3.z - a3.z);
+            
+            float denom = cross2(direction, edgeVector);
+            if (std::abs(denom) < 1e-12f) continue;
+            
+            glm::vec2 diff = a - origin;
+            float t = cross2(diff, edgeVector) / denom;
+            float u = cross2(diff, direction) / denom;
+            if (u < -edgeEpsilon || u > 1.0f + edgeEpsilon || t < currentT - edgeEpsilon) continue;
+            
+            if (t > exitT) {
+                exitT = t;
+                exitEdge = edge;
+            }
+        }
+        
+        if (exitEdge < 0) {
+            break;
+        }
+        if (exitT >= 1.0f) {
+            return false;
+        }
         
-        float dist = glm::distance(position, node.position);
-        if (dist < minDist) {
-            minDist = dist;
-            nearestPoint = node.position;
+        int next = m_triangleNeighbors[triangleIndex * 3 + exitEdge];
+        if (exitT > currentT + probeStep && next >= 0 && m_triangles[next].walkable) {
+            triangleIndex = next;
+            currentT = exitT;
+            continue;
         }
+        
+        // Луч проходит через вершину или вдоль ребра: ищем треугольник чуть дальше по лучу
+        float probeT = std::max(exitT, currentT) + probeStep;
+        if (probeT >= 1.0f) {
+            return false;
+        }
+        glm::vec3 probe = from + (to - from) * probeT;
+        int probeTriangle = FindTriangle(probe, true);
+        if (probeTriangle < 0 || probeTriangle == triangleIndex) {
+            currentT = std::max(exitT, currentT);
+            break;
+        }
+        triangleIndex = probeTriangle;
+        currentT = probeT;
     }
     
-    return nearestPoint;
+    if (hitPoint) {
+        *hitPoint = from + (to - from) * std::max(currentT, 0.0f);
+    }
+    return true;
 }
 
 std::string NavMesh::Serialize() const {
@@ -211,9 +323,10 @@ std::string NavMesh::Serialize() const {
         ss << "      \"walkable\": " << (node.walkable ? "true" : "false") << ",\n";
         ss << "      \"cost\": " << node.cost << ",\n";
         ss << "      \"connections\": [";
-        for (size_t j = 0; j < node.connections.size(); ++j) {
-            ss << node.connections[j];
-            if (j < node.connections.size() - 1) ss << ", ";
+        NavIndexRange neighbors = GetNeighbors(static_cast<int>(i));
+        for (const int* it = neighbors.begin(); it != neighbors.end(); ++it) {
+            if (it != neighbors.begin()) ss << ", ";
+            ss << *it;
         }
         ss << "]\n";
         ss << "    }";
@@ -263,39 +376,205 @@ void NavMesh::TriangulateMesh(const std::vector<glm::vec3>& vertices,
 }
 
 void NavMesh::BuildConnections() {
-    // Строим соединения между узлами на основе треугольников
+    const size_t nodeCount = m_nodes.size();
+    
+    // Узел -> треугольники: подсчет, префиксная сумма, заполнение
+    m_nodeTriangleOffsets.assign(nodeCount + 1, 0);
+    for (const auto& triangle : m_triangles) {
+        for (int j = 0; j < 3; ++j) {
+            ++m_nodeTriangleOffsets[triangle.vertices[j] + 1];
+        }
+    }
+    for (size_t i = 0; i < nodeCount; ++i) {
+        m_nodeTriangleOffsets[i + 1] += m_nodeTriangleOffsets[i];
+    }
+    
+    m_nodeTriangles.resize(m_nodeTriangleOffsets[nodeCount]);
+    std::vector<int> cursor(m_nodeTriangleOffsets.begin(), m_nodeTriangleOffsets.end() - 1);
     for (size_t i = 0; i < m_triangles.size(); ++i) {
-        const auto& triangle = m_triangles[i];
-        
         for (int j = 0; j < 3; ++j) {
-            int vertexIndex = triangle.vertices[j];
-            m_nodeToTriangles[vertexIndex].push_back(static_cast<int>(i));
+            m_nodeTriangles[cursor[m_triangles[i].vertices[j]]++] = static_cast<int>(i);
         }
     }
     
-    // Создаем соединения между узлами в одном треугольнике
+    // Ребра всех треугольников в обе стороны, ключ (from << 32 | to).
+    // Смежность описывает только топологию: ребро проходимо, если проходимы
+    // оба его узла, поэтому SetNodeWalkable не требует перестройки списков
+    std::vector<uint64_t> edges;
+    edges.reserve(m_triangles.size() * 6);
     for (const auto& triangle : m_triangles) {
-        if (!triangle.walkable) continue;
-        
         for (int i = 0; i < 3; ++i) {
-            int v0 = triangle.vertices[i];
-            int v1 = triangle.vertices[(i + 1) % 3];
-            
-            // Добавляем двустороннее соединение
-            if (std::find(m_nodes[v0].connections.begin(), m_nodes[v0].connections.end(), v1) == m_nodes[v0].connections.end()) {
-                m_nodes[v0].connections.push_back(v1);
-            }
-            if (std::find(m_nodes[v1].connections.begin(), m_nodes[v1].connections.end(), v0) == m_nodes[v1].connections.end()) {
-                m_nodes[v1].connections.push_back(v0);
+            uint64_t v0 = static_cast<uint32_t>(triangle.vertices[i]);
+            uint64_t v1 = static_cast<uint32_t>(triangle.vertices[(i + 1) % 3]);
+            edges.push_back((v0 << 32) | v1);
+            edges.push_back((v1 << 32) | v0);
+        }
+    }
+    
+    // После сортировки ребра сгруппированы по исходному узлу
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    
+    m_adjacencyOffsets.assign(nodeCount + 1, 0);
+    m_adjacency.resize(edges.size());
+    for (size_t i = 0; i < edges.size(); ++i) {
+        ++m_adjacencyOffsets[(edges[i] >> 32) + 1];
+        m_adjacency[i] = static_cast<int>(edges[i] & 0xFFFFFFFFu);
+    }
+    for (size_t i = 0; i < nodeCount; ++i) {
+        m_adjacencyOffsets[i + 1] += m_adjacencyOffsets[i];
+    }
+    
+    BuildTriangleNeighbors();
+    BuildSpatialIndex();
+}
+
+void NavMesh::SetNodeWalkable(int nodeIndex, bool walkable) {
+    m_nodes[nodeIndex].walkable = walkable;
+    
+    // Треугольник проходим, только если проходимы все три его вершины
+    for (int triangleIndex : GetNodeTriangles(nodeIndex)) {
+        NavTriangle& triangle = m_triangles[triangleIndex];
+        triangle.walkable = m_nodes[triangle.vertices[0]].walkable &&
+                            m_nodes[triangle.vertices[1]].walkable &&
+                            m_nodes[triangle.vertices[2]].walkable;
+    }
+}
+
+void NavMesh::SetNodeCost(int nodeIndex, float cost) {
+    m_nodes[nodeIndex].cost = cost;
+}
+
+void NavMesh::BuildTriangleNeighbors() {
+    m_triangleNeighbors.assign(m_triangles.size() * 3, -1);
+    
+    // Ключ ребра (min << 32 | max) и номер полуребра (треугольник * 3 + ребро)
+    std::vector<std::pair<uint64_t, int>> halfEdges;
+    halfEdges.reserve(m_triangles.size() * 3);
+    for (size_t i = 0; i < m_triangles.size(); ++i) {
+        for (int edge = 0; edge < 3; ++edge) {
+            uint64_t v0 = static_cast<uint32_t>(m_triangles[i].vertices[edge]);
+            uint64_t v1 = static_cast<uint32_t>(m_triangles[i].vertices[(edge + 1) % 3]);
+            uint64_t key = v0 < v1 ? ((v0 << 32) | v1) : ((v1 << 32) | v0);
+            halfEdges.emplace_back(key, static_cast<int>(i * 3 + edge));
+        }
+    }
+    std::sort(halfEdges.begin(), halfEdges.end());
+    
+    for (size_t i = 0; i + 1 < halfEdges.size(); ++i) {
+        if (halfEdges[i].first != halfEdges[i + 1].first) continue;
+        
+        int a = halfEdges[i].second;
+        int b = halfEdges[i + 1].second;
+        m_triangleNeighbors[a] = b / 3;
+        m_triangleNeighbors[b] = a / 3;
+        ++i;
+    }
+}
+
+void NavMesh::BuildSpatialIndex() {
+    m_grid = NavSpatialGrid();
+    if (m_nodes.empty() || m_triangles.empty()) {
+        return;
+    }
+    
+    // Границы сетки и средний размер треугольника в плоскости XZ
+    glm::vec2 minBound(std::numeric_limits<float>::max());
+    glm::vec2 maxBound(-std::numeric_limits<float>::max());
+    for (const auto& node : m_nodes) {
+        minBound = glm::min(minBound, glm::vec2(node.position.x, node.position.z));
+        maxBound = glm::max(maxBound, glm::vec2(node.position.x, node.position.z));
+    }
+    
+    float extentSum = 0.0f;
+    for (const auto& triangle : m_triangles) {
+        glm::vec2 triMin(std::numeric_limits<float>::max());
+        glm::vec2 triMax(-std::numeric_limits<float>::max());
+        for (int j = 0; j < 3; ++j) {
+            const glm::vec3& p = m_nodes[triangle.vertices[j]].position;
+            triMin = glm::min(triMin, glm::vec2(p.x, p.z));
+            triMax = glm::max(triMax, glm::vec2(p.x, p.z));
+        }
+        extentSum += std::max(triMax.x - triMin.x, triMax.y - triMin.y);
+    }
+    
+    // Ячейка порядка среднего треугольника, но не больше ~4 ячеек на треугольник
+    glm::vec2 size = maxBound - minBound;
+    float cellSize = std::max(extentSum / m_triangles.size(), 1e-3f);
+    float minCellSize = std::sqrt(std::max(size.x * size.y, 1e-6f) / (4.0f * m_triangles.size()));
+    cellSize = std::max(cellSize, minCellSize);
+    
+    m_grid.origin = minBound;
+    m_grid.cellSize = cellSize;
+    m_grid.inverseCellSize = 1.0f / cellSize;
+    m_grid.width = std::max(1, static_cast<int>(size.x * m_grid.inverseCellSize) + 1);
+    m_grid.height = std::max(1, static_cast<int>(size.y * m_grid.inverseCellSize) + 1);
+    const size_t cellCount = static_cast<size_t>(m_grid.width) * m_grid.height;
+    
+    // Треугольники: два прохода (подсчет и заполнение) по ячейкам их AABB
+    auto forEachTriangleCell = [this](const NavTriangle& triangle, auto&& visit) {
+        glm::vec2 triMin(std::numeric_limits<float>::max());
+        glm::vec2 triMax(-std::numeric_limits<float>::max());
+        for (int j = 0; j < 3; ++j) {
+            const glm::vec3& p = m_nodes[triangle.vertices[j]].position;
+            triMin = glm::min(triMin, glm::vec2(p.x, p.z));
+            triMax = glm::max(triMax, glm::vec2(p.x, p.z));
+        }
+        for (int z = m_grid.CellZ(triMin.y); z <= m_grid.CellZ(triMax.y); ++z) {
+            for (int x = m_grid.CellX(triMin.x); x <= m_grid.CellX(triMax.x); ++x) {
+                visit(z * m_grid.width + x);
             }
         }
+    };
+    
+    m_grid.triangleOffsets.assign(cellCount + 1, 0);
+    for (const auto& triangle : m_triangles) {
+        forEachTriangleCell(triangle, [this](int cell) { ++m_grid.triangleOffsets[cell + 1]; });
+    }
+    for (size_t i = 0; i < cellCount; ++i) {
+        m_grid.triangleOffsets[i + 1] += m_grid.triangleOffsets[i];
+    }
+    m_grid.triangles.resize(m_grid.triangleOffsets[cellCount]);
+    std::vector<int> cursor(m_grid.triangleOffsets.begin(), m_grid.triangleOffsets.end() - 1);
+    for (size_t i = 0; i < m_triangles.size(); ++i) {
+        forEachTriangleCell(m_triangles[i], [this, &cursor, i](int cell) {
+            m_grid.triangles[cursor[cell]++] = static_cast<int>(i);
+        });
+    }
+    
+    // Узлы: каждый узел ровно в одной ячейке
+    m_grid.nodeOffsets.assign(cellCount + 1, 0);
+    std::vector<int> nodeCells(m_nodes.size());
+    for (size_t i = 0; i < m_nodes.size(); ++i) {
+        nodeCells[i] = m_grid.CellZ(m_nodes[i].position.z) * m_grid.width + m_grid.CellX(m_nodes[i].position.x);
+        ++m_grid.nodeOffsets[nodeCells[i] + 1];
+    }
+    for (size_t i = 0; i < cellCount; ++i) {
+        m_grid.nodeOffsets[i + 1] += m_grid.nodeOffsets[i];
+    }
+    m_grid.nodes.resize(m_nodes.size());
+    cursor.assign(m_grid.nodeOffsets.begin(), m_grid.nodeOffsets.end() - 1);
+    for (size_t i = 0; i < m_nodes.size(); ++i) {
+        m_grid.nodes[cursor[nodeCells[i]]++] = static_cast<int>(i);
     }
 }
 
+void NavMesh::ClearMesh() {
+    m_nodes.clear();
+    m_triangles.clear();
+    m_adjacencyOffsets.clear();
+    m_adjacency.clear();
+    m_nodeTriangleOffsets.clear();
+    m_nodeTriangles.clear();
+    m_triangleNeighbors.clear();
+    m_grid = NavSpatialGrid();
+    m_hasTileSource = false;
+}
+
 bool NavMesh::IsPointInTriangle(const glm::vec3& point, const NavTriangle& triangle) const {
-    if (triangle.vertices[0] >= m_nodes.size() || 
-        triangle.vertices[1] >= m_nodes.size() || 
-        triangle.vertices[2] >= m_nodes.size()) {
+    if (triangle.vertices[0] >= static_cast<int>(m_nodes.size()) || 
+        triangle.vertices[1] >= static_cast<int>(m_nodes.size()) || 
+        triangle.vertices[2] >= static_cast<int>(m_nodes.size())) {
         return false;
     }
     
@@ -303,15 +582,17 @@ bool NavMesh::IsPointInTriangle(const glm::vec3& point, const NavTriangle& trian
     const glm::vec3& v1 = m_nodes[triangle.vertices[1]].position;
     const glm::vec3& v2 = m_nodes[triangle.vertices[2]].position;
     
-    // Используем барицентрические координаты
-    float denom = (v1.y - v2.y) * (v0.x - v2.x) + (v2.x - v1.x) * (v0.y - v2.y);
+    // Используем барицентрические координаты в плоскости XZ
+    float denom = (v1.z - v2.z) * (v0.x - v2.x) + (v2.x - v1.x) * (v0.z - v2.z);
     if (std::abs(denom) < 1e-10f) return false;
     
-    float a = ((v1.y - v2.y) * (point.x - v2.x) + (v2.x - v1.x) * (point.y - v2.y)) / denom;
-    float b = ((v2.y - v0.y) * (point.x - v2.x) + (v0.x - v2.x) * (point.y - v2.y)) / denom;
+    float a = ((v1.z - v2.z) * (point.x - v2.x) + (v2.x - v1.x) * (point.z - v2.z)) / denom;
+    float b = ((v2.z - v0.z) * (point.x - v2.x) + (v0.x - v2.x) * (point.z - v2.z)) / denom;
     float c = 1.0f - a - b;
     
-    return a >= 0.0f && b >= 0.0f && c >= 0.0f;
+    // Небольшой допуск, чтобы точки на общих ребрах не выпадали из сетки
+    const float epsilon = 1e-5f;
+    return a >= -epsilon && b >= -epsilon && c >= -epsilon;
 }
 
 glm::vec3 NavMesh::GetTriangleCenter(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2) const {
@@ -323,7 +604,54 @@ NavMeshGenerator::NavMeshGenerator()
     : m_cellSize(1.0f)
     , m_heightThreshold(0.5f)
     , m_agentRadius(0.5f)
-    , m_maxSlope(45.0f) {
+    , m_maxSlope(45.0f)
+    , m_tileSize(64)
+    , m_workerCount(0) {
+}
+
+size_t NavMeshGenerator::GetWorkerCount() const {
+    if (m_workerCount > 0) {
+        return m_workerCount;
+    }
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+template<typename Func>
+void NavMeshGenerator::ParallelFor(size_t count, const Func& func) const {
+    // Без явного числа потоков тайлы делятся с остальными заданиями движка
+    JobSystem& jobs = JobSystem::GetInstance();
+    if (m_workerCount == 0 && jobs.IsRunning()) {
+        static const ProfileNameId jobName = ProfileNames::Register("NavMeshGenerator::Tiles");
+        jobs.ParallelForRange(0, count, [&func](size_t first, size_t last) {
+            thread_local std::vector<unsigned char> scratch;
+            for (size_t index = first; index < last; ++index) {
+                func(index, scratch);
+            }
+        }, 1, jobName);
+        return;
+    }
+    
+    const size_t workerCount = std::min(GetWorkerCount(), count);
+    std::atomic<size_t> next(0);
+    
+    // Задания раздаются по одному через атомарный счетчик; у каждого
+    // потока свой буфер, переиспользуемый между тайлами
+    auto run = [&]() {
+        std::vector<unsigned char> scratch;
+        for (size_t index = next.fetch_add(1); index < count; index = next.fetch_add(1)) {
+            func(index, scratch);
+        }
+    };
+    
+    std::vector<std::thread> threads;
+    threads.reserve(workerCount > 0 ? workerCount - 1 : 0);
+    for (size_t i = 1; i < workerCount; ++i) {
+        threads.emplace_back(run);
+    }
+    run();
+    for (auto& thread : threads) {
+        thread.join();
+    }
 }
 
 std::unique_ptr<NavMesh> NavMeshGenerator::GenerateFromMesh(const std::vector<glm::vec3>& vertices,
@@ -331,8 +659,6 @@ std::unique_ptr<NavMesh> NavMeshGenerator::GenerateFromMesh(const std::vector<gl
     auto navMesh = std::make_unique<NavMesh>();
     
     if (navMesh->GenerateFromMesh(vertices, indices)) {
-        FilterWalkableAreas(*navMesh);
-        SimplifyMesh(*navMesh);
         return navMesh;
     }
     
@@ -340,40 +666,400 @@ std::unique_ptr<NavMesh> NavMeshGenerator::GenerateFromMesh(const std::vector<gl
 }
 
 std::unique_ptr<NavMesh> NavMeshGenerator::GenerateFromHeightmap(const std::vector<std::vector<float>>& heightmap) {
-    auto navMesh = std::make_unique<NavMesh>();
+    if (heightmap.empty() || heightmap[0].empty()) {
+        std::cerr << "NavMeshGenerator: Invalid heightmap data" << std::endl;
+        return nullptr;
+    }
     
-    if (navMesh->GenerateFromHeightmap(heightmap, m_cellSize, m_heightThreshold)) {
-        FilterWalkableAreas(*navMesh);
-        SimplifyMesh(*navMesh);
-        return navMesh;
+    const size_t width = heightmap[0].size();
+    std::vector<float> flat(width * heightmap.size());
+    for (size_t y = 0; y < heightmap.size(); ++y) {
+        if (heightmap[y].size() != width) {
+            std::cerr << "NavMeshGenerator: Heightmap rows have different lengths" << std::endl;
+            return nullptr;
+        }
+        std::copy(heightmap[y].begin(), heightmap[y].end(), flat.begin() + y * width);
     }
     
-    return nullptr;
+    return GenerateFromHeightmap(HeightmapView(flat.data(), static_cast<int>(width), static_cast<int>(heightmap.size())));
+}
+
+std::unique_ptr<NavMesh> NavMeshGenerator::GenerateFromHeightmap(const HeightmapView& heightmap) {
+    if (!heightmap.IsValid()) {
+        std::cerr << "NavMeshGenerator: Invalid heightmap data" << std::endl;
+        return nullptr;
+    }
+    
+    TileSource source;
+    source.heights = heightmap;
+    source.origin = glm::vec2(0.0f);
+    source.threshold = m_heightThreshold;
+    return GenerateTiled(source);
 }
 
 std::unique_ptr<NavMesh> NavMeshGenerator::GenerateFromColliders(const std::vector<glm::vec3>& colliderPositions,
                                                                 const std::vector<glm::vec3>& colliderSizes) {
-    // В реальной реализации здесь бы генерировалась навигационная сетка
-    // на основе коллайдеров
-    std::cout << "NavMeshGenerator: Generating from colliders not implemented yet" << std::endl;
-    return nullptr;
+    if (colliderPositions.empty() || colliderPositions.size() != colliderSizes.size() || m_cellSize <= 0.0f) {
+        std::cerr << "NavMeshGenerator: Invalid collider data" << std::endl;
+        return nullptr;
+    }
+    
+    glm::vec3 minBound(std::numeric_limits<float>::max());
+    glm::vec3 maxBound(-std::numeric_limits<float>::max());
+    for (size_t i = 0; i < colliderPositions.size(); ++i) {
+        glm::vec3 half = glm::abs(colliderSizes[i]) * 0.5f;
+        minBound = glm::min(minBound, colliderPositions[i] - half);
+        maxBound = glm::max(maxBound, colliderPositions[i] + half);
+    }
+    
+    const int width = static_cast<int>(std::floor((maxBound.x - minBound.x) / m_cellSize)) + 1;
+    const int height = static_cast<int>(std::floor((maxBound.z - minBound.z) / m_cellSize)) + 1;
+    const int tileCountX = (width + m_tileSize - 1) / m_tileSize;
+    const int tileCountZ = (height + m_tileSize - 1) / m_tileSize;
+    
+    // Коллайдеры раскладываются по тайлам, которые пересекает их проекция на XZ
+    std::vector<std::vector<int>> tileColliders(static_cast<size_t>(tileCountX) * tileCountZ);
+    for (size_t i = 0; i < colliderPositions.size(); ++i) {
+        glm::vec3 half = glm::abs(colliderSizes[i]) * 0.5f;
+        int x0 = static_cast<int>(std::floor((colliderPositions[i].x - half.x - minBound.x) / m_cellSize));
+        int x1 = static_cast<int>(std::floor((colliderPositions[i].x + half.x - minBound.x) / m_cellSize));
+        int z0 = static_cast<int>(std::floor((colliderPositions[i].z - half.z - minBound.z) / m_cellSize));
+        int z1 = static_cast<int>(std::floor((colliderPositions[i].z + half.z - minBound.z) / m_cellSize));
+        for (int tz = std::max(z0, 0) / m_tileSize; tz <= std::min(z1, height - 1) / m_tileSize; ++tz) {
+            for (int tx = std::max(x0, 0) / m_tileSize; tx <= std::min(x1, width - 1) / m_tileSize; ++tx) {
+                tileColliders[tz * tileCountX + tx].push_back(static_cast<int>(i));
+            }
+        }
+    }
+    
+    // Растеризация по тайлам: высота отсчета - верхняя грань самого высокого
+    // коллайдера над ним. Пустые отсчеты опускаются ниже порога проходимости
+    const float emptyHeight = minBound.y - 1.0f;
+    std::vector<float> heights(static_cast<size_t>(width) * height, emptyHeight);
+    ParallelFor(tileColliders.size(), [&](size_t tile, std::vector<unsigned char>&) {
+        const int tx = static_cast<int>(tile % tileCountX);
+        const int tz = static_cast<int>(tile / tileCountX);
+        const int xEnd = std::min((tx + 1) * m_tileSize, width);
+        const int zEnd = std::min((tz + 1) * m_tileSize, height);
+        
+        for (int colliderIndex : tileColliders[tile]) {
+            const glm::vec3& position = colliderPositions[colliderIndex];
+            glm::vec3 half = glm::abs(colliderSizes[colliderIndex]) * 0.5f;
+            const float top = position.y + half.y;
+            
+            int x0 = std::max(tx * m_tileSize, static_cast<int>(std::ceil((position.x - half.x - minBound.x) / m_cellSize)));
+            int x1 = std::min(xEnd - 1, static_cast<int>(std::floor((position.x + half.x - minBound.x) / m_cellSize)));
+            int z0 = std::max(tz * m_tileSize, static_cast<int>(std::ceil((position.z - half.z - minBound.z) / m_cellSize)));
+            int z1 = std::min(zEnd - 1, static_cast<int>(std::floor((position.z + half.z - minBound.z) / m_cellSize)));
+            
+            for (int z = z0; z <= z1; ++z) {
+                float* row = heights.data() + static_cast<size_t>(z) * width;
+                for (int x = x0; x <= x1; ++x) {
+                    row[x] = std::max(row[x], top);
+                }
+            }
+        }
+    });
+    
+    TileSource source;
+    source.heights = HeightmapView(heights.data(), width, height);
+    source.origin = glm::vec2(minBound.x, minBound.z);
+    source.threshold = minBound.y - 0.5f;
+    return GenerateTiled(source);
+}
+
+int NavMeshGenerator::RebuildRegion(NavMesh& navMesh, const HeightmapView& heightmap,
+                                    int minX, int minY, int maxX, int maxY) {
+    if (!navMesh.m_hasTileSource) {
+        std::cerr << "NavMeshGenerator: NavMesh was not built from a heightmap grid" << std::endl;
+        return -1;
+    }
+    
+    const int width = heightmap.width;
+    const int height = heightmap.height;
+    if (!heightmap.IsValid() || width < 2 || height < 2 ||
+        navMesh.m_nodes.size() != static_cast<size_t>(width) * height ||
+        navMesh.m_triangles.size() != static_cast<size_t>(width - 1) * (height - 1) * 2) {
+        std::cerr << "NavMeshGenerator: Heightmap does not match NavMesh layout" << std::endl;
+        return -1;
+    }
+    
+    minX = std::max(minX, 0);
+    minY = std::max(minY, 0);
+    maxX = std::min(maxX, width - 1);
+    maxY = std::min(maxY, height - 1);
+    if (minX > maxX || minY > maxY) {
+        return 0;
+    }
+    
+    // Изменение отсчета влияет на уклон соседей, эрозия расширяет влияние на
+    // радиус агента; ячейка зависит от отсчетов справа и снизу
+    const int reach = GetFilterRadius() + 1;
+    const int tileCountX = (width + m_tileSize - 1) / m_tileSize;
+    const int tileX0 = std::max(minX - reach - 1, 0) / m_tileSize;
+    const int tileY0 = std::max(minY - reach - 1, 0) / m_tileSize;
+    const int tileX1 = std::min(maxX + reach, width - 1) / m_tileSize;
+    const int tileY1 = std::min(maxY + reach, height - 1) / m_tileSize;
+    
+    std::vector<int> tiles;
+    for (int ty = tileY0; ty <= tileY1; ++ty) {
+        for (int tx = tileX0; tx <= tileX1; ++tx) {
+            tiles.push_back(ty * tileCountX + tx);
+        }
+    }
+    
+    // Координаты XZ узлов не меняются, поэтому смежность и пространственный
+    // индекс остаются прежними
+    TileSource source;
+    source.heights = heightmap;
+    source.origin = glm::vec2(navMesh.m_nodes[0].position.x, navMesh.m_nodes[0].position.z);
+    source.threshold = navMesh.m_tileThreshold;
+    BuildTiles(source, tiles, navMesh);
+    
+    return static_cast<int>(tiles.size());
 }
 
-void NavMeshGenerator::DelaunayTriangulation(std::vector<glm::vec3>& points, 
-                                            std::vector<NavTriangle>& triangles) {
-    // В реальной реализации здесь бы был алгоритм триангуляции Делоне
-    std::cout << "NavMeshGenerator: Delaunay triangulation not implemented yet" << std::endl;
+int NavMeshGenerator::GetFilterRadius() const {
+    return m_cellSize > 0.0f ? static_cast<int>(std::floor(m_agentRadius / m_cellSize)) : 0;
 }
 
-void NavMeshGenerator::FilterWalkableAreas(NavMesh& navMesh) {
-    // Фильтруем непроходимые области
-    std::cout << "NavMeshGenerator: Filtering walkable areas" << std::endl;
+bool NavMeshGenerator::IsPassable(const TileSource& source, int x, int y) const {
+    const HeightmapView& heights = source.heights;
+    const float h = heights.At(x, y);
+    if (!(h >= source.threshold)) {
+        return false;
+    }
+    
+    // Уклон проверяется только к проходимым по высоте соседям: обрыв к
+    // пустоте ограничивает эрозия по радиусу агента
+    const float maxStep = m_cellSize * std::tan(glm::radians(std::min(m_maxSlope, 89.9f)));
+    const int dx[4] = {-1, 1, 0, 0};
+    const int dy[4] = {0, 0, -1, 1};
+    for (int i = 0; i < 4; ++i) {
+        int nx = x + dx[i];
+        int ny = y + dy[i];
+        if (nx < 0 || ny < 0 || nx >= heights.width || ny >= heights.height) continue;
+        
+        float neighbor = heights.At(nx, ny);
+        if (neighbor >= source.threshold && std::abs(neighbor - h) > maxStep) {
+            return false;
+        }
+    }
+    return true;
 }
 
-void NavMeshGenerator::SimplifyMesh(NavMesh& navMesh) {
-    // Упрощаем сетку
-    std::cout << "NavMeshGenerator: Simplifying mesh" << std::endl;
+void NavMeshGenerator::BuildTile(const TileSource& source, int tileX, int tileY, NavMesh& navMesh,
+                                 std::vector<unsigned char>& scratch) const {
+    const int width = source.heights.width;
+    const int height = source.heights.height;
+    const int radius = GetFilterRadius();
+    
+    // Отсчеты тайла [x0, x1) x [y0, y1); ячейкам нужен еще отсчет справа и снизу
+    const int x0 = tileX * m_tileSize;
+    const int y0 = tileY * m_tileSize;
+    const int x1 = std::min(x0 + m_tileSize, width);
+    const int y1 = std::min(y0 + m_tileSize, height);
+    const int xLast = std::min(x0 + m_tileSize, width - 1);
+    const int yLast = std::min(y0 + m_tileSize, height - 1);
+    
+    // Проходимость по высоте и уклону с полосой соседних тайлов
+    const int bx0 = std::max(x0 - radius, 0);
+    const int by0 = std::max(y0 - radius, 0);
+    const int bx1 = std::min(xLast + radius, width - 1);
+    const int by1 = std::min(yLast + radius, height - 1);
+    const int bandWidth = bx1 - bx0 + 1;
+    const int bandHeight = by1 - by0 + 1;
+    
+    scratch.resize(static_cast<size_t>(bandWidth) * bandHeight * 2);
+    unsigned char* passable = scratch.data();
+    unsigned char* walkable = passable + static_cast<size_t>(bandWidth) * bandHeight;
+    for (int y = by0; y <= by1; ++y) {
+        for (int x = bx0; x <= bx1; ++x) {
+            passable[(y - by0) * bandWidth + (x - bx0)] = IsPassable(source, x, y) ? 1 : 0;
+        }
+    }
+    
+    // Эрозия: агент радиуса radius должен целиком помещаться на проходимой
+    // области; за краем карты опоры нет
+    for (int y = y0; y <= yLast; ++y) {
+        for (int x = x0; x <= xLast; ++x) {
+            bool fits = passable[(y - by0) * bandWidth + (x - bx0)] != 0;
+            for (int dy = -radius; fits && dy <= radius; ++dy) {
+                for (int dx = -radius; dx <= radius; ++dx) {
+                    if (dx * dx + dy * dy > radius * radius) continue;
+                    
+                    int nx = x + dx;
+                    int ny = y + dy;
+                    if (nx < 0 || ny < 0 || nx >= width || ny >= height ||
+                        !passable[(ny - by0) * bandWidth + (nx - bx0)]) {
+                        fits = false;
+                        break;
+                    }
+                }
+            }
+            walkable[(y - by0) * bandWidth + (x - bx0)] = fits ? 1 : 0;
+        }
+    }
+    auto isWalkable = [&](int x, int y) { return walkable[(y - by0) * bandWidth + (x - bx0)] != 0; };
+    
+    // Узлы тайла - по глобальным индексам отсчетов
+    std::vector<NavNode>& nodes = navMesh.m_nodes;
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
+            bool nodeWalkable = isWalkable(x, y);
+            glm::vec3 position(source.origin.x + x * m_cellSize, source.heights.At(x, y), source.origin.y + y * m_cellSize);
+            nodes[static_cast<size_t>(y) * width + x] = NavNode(position, nodeWalkable, nodeWalkable ? 1.0f : 1000.0f);
+        }
+    }
+    
+    // Треугольники ячеек тайла в той же раскладке, что и NavMesh::GenerateFromHeightmap.
+    // Позиции соседних отсчетов считаются заново, а не читаются из узлов чужого тайла
+    std::vector<NavTriangle>& triangles = navMesh.m_triangles;
+    auto positionAt = [&](int x, int y) {
+        return glm::vec3(source.origin.x + x * m_cellSize, source.heights.At(x, y), source.origin.y + y * m_cellSize);
+    };
+    for (int y = y0; y < std::min(y1, height - 1); ++y) {
+        for (int x = x0; x < std::min(x1, width - 1); ++x) {
+            int i = y * width + x;
+            int i1 = i + 1;
+            int i2 = (y + 1) * width + x;
+            int i3 = i2 + 1;
+            
+            glm::vec3 p0 = positionAt(x, y);
+            glm::vec3 p1 = positionAt(x + 1, y);
+            glm::vec3 p2 = positionAt(x, y + 1);
+            glm::vec3 p3 = positionAt(x + 1, y + 1);
+            bool w0 = isWalkable(x, y);
+            bool w1 = isWalkable(x + 1, y);
+            bool w2 = isWalkable(x, y + 1);
+            bool w3 = isWalkable(x + 1, y + 1);
+            
+            size_t cell = static_cast<size_t>(y) * (width - 1) + x;
+            triangles[cell * 2] = NavTriangle(i, i1, i2, (p0 + p1 + p2) / 3.0f, w0 && w1 && w2);
+            triangles[cell * 2 + 1] = NavTriangle(i1, i2, i3, (p1 + p2 + p3) / 3.0f, w1 && w2 && w3);
+        }
+    }
 }
 
-} // namespace FastEngine
+void NavMeshGenerator::BuildTiles(const TileSource& source, const std::vector<int>& tiles, NavMesh& navMesh) const {
+    const int tileCountX = (source.heights.width + m_tileSize - 1) / m_tileSize;
+    ParallelFor(tiles.size(), [&](size_t index, std::vector<unsigned char>& scratch) {
+        BuildTile(source, tiles[index] % tileCountX, tiles[index] / tileCountX, navMesh, scratch);
+    });
+}
+
+void NavMeshGenerator::BuildGridTopology(NavMesh& navMesh, int width, int height) const {
+    // Раскладка сетки известна заранее, поэтому смежность, узлы -> треугольники
+    // и соседи треугольников заполняются по формулам вместо сортировки ребер.
+    // Результат совпадает с NavMesh::BuildConnections
+    const size_t nodeCount = static_cast<size_t>(width) * height;
+    const int cellsX = width - 1;
+    const int cellsY = height - 1;
+    auto cellExists = [&](int x, int y) { return x >= 0 && y >= 0 && x < cellsX && y < cellsY; };
+    auto cellIndex = [&](int x, int y) { return y * cellsX + x; };
+    
+    // Соседи узла в порядке возрастания индекса: (0,-1), (1,-1), (-1,0), (1,0), (-1,1), (0,1).
+    // Диагональ (1,-1) - общее ребро треугольников ячейки (x, y - 1)
+    auto neighborCount = [&](int x, int y) {
+        return (y > 0 ? 1 : 0) + (cellExists(x, y - 1) ? 1 : 0) + (x > 0 ? 1 : 0) +
+               (x < width - 1 ? 1 : 0) + (cellExists(x - 1, y) ? 1 : 0) + (y < height - 1 ? 1 : 0);
+    };
+    // Треугольники узла по возрастанию: T1 ячейки (x-1,y-1), T0 и T1 ячейки (x,y-1),
+    // T0 и T1 ячейки (x-1,y), T0 ячейки (x,y)
+    auto triangleCount = [&](int x, int y) {
+        return (cellExists(x - 1, y - 1) ? 1 : 0) + (cellExists(x, y - 1) ? 2 : 0) +
+               (cellExists(x - 1, y) ? 2 : 0) + (cellExists(x, y) ? 1 : 0);
+    };
+    
+    navMesh.m_adjacencyOffsets.resize(nodeCount + 1);
+    navMesh.m_nodeTriangleOffsets.resize(nodeCount + 1);
+    navMesh.m_adjacencyOffsets[0] = 0;
+    navMesh.m_nodeTriangleOffsets[0] = 0;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            size_t i = static_cast<size_t>(y) * width + x;
+            navMesh.m_adjacencyOffsets[i + 1] = navMesh.m_adjacencyOffsets[i] + neighborCount(x, y);
+            navMesh.m_nodeTriangleOffsets[i + 1] = navMesh.m_nodeTriangleOffsets[i] + triangleCount(x, y);
+        }
+    }
+    navMesh.m_adjacency.resize(navMesh.m_adjacencyOffsets[nodeCount]);
+    navMesh.m_nodeTriangles.resize(navMesh.m_nodeTriangleOffsets[nodeCount]);
+    navMesh.m_triangleNeighbors.resize(static_cast<size_t>(cellsX) * cellsY * 6);
+    
+    const int bandCount = (height + m_tileSize - 1) / m_tileSize;
+    ParallelFor(static_cast<size_t>(bandCount), [&](size_t band, std::vector<unsigned char>&) {
+        const int y0 = static_cast<int>(band) * m_tileSize;
+        const int y1 = std::min(y0 + m_tileSize, height);
+        
+        for (int y = y0; y < y1; ++y) {
+            for (int x = 0; x < width; ++x) {
+                const int i = y * width + x;
+                
+                int* adjacency = navMesh.m_adjacency.data() + navMesh.m_adjacencyOffsets[i];
+                if (y > 0) *adjacency++ = i - width;
+                if (cellExists(x, y - 1)) *adjacency++ = i - width + 1;
+                if (x > 0) *adjacency++ = i - 1;
+                if (x < width - 1) *adjacency++ = i + 1;
+                if (cellExists(x - 1, y)) *adjacency++ = i + width - 1;
+                if (y < height - 1) *adjacency++ = i + width;
+                
+                int* triangles = navMesh.m_nodeTriangles.data() + navMesh.m_nodeTriangleOffsets[i];
+                if (cellExists(x - 1, y - 1)) *triangles++ = cellIndex(x - 1, y - 1) * 2 + 1;
+                if (cellExists(x, y - 1)) {
+                    *triangles++ = cellIndex(x, y - 1) * 2;
+                    *triangles++ = cellIndex(x, y - 1) * 2 + 1;
+                }
+                if (cellExists(x - 1, y)) {
+                    *triangles++ = cellIndex(x - 1, y) * 2;
+                    *triangles++ = cellIndex(x - 1, y) * 2 + 1;
+                }
+                if (cellExists(x, y)) *triangles++ = cellIndex(x, y) * 2;
+                
+                if (!cellExists(x, y)) continue;
+                
+                // T0 = (i, i+1, i+w): нижнее ребро, диагональ, левое ребро.
+                // T1 = (i+1, i+w, i+w+1): диагональ, верхнее ребро, правое ребро
+                const int cell = cellIndex(x, y);
+                int* neighbors = navMesh.m_triangleNeighbors.data() + static_cast<size_t>(cell) * 6;
+                neighbors[0] = cellExists(x, y - 1) ? cellIndex(x, y - 1) * 2 + 1 : -1;
+                neighbors[1] = cell * 2 + 1;
+                neighbors[2] = cellExists(x - 1, y) ? cellIndex(x - 1, y) * 2 + 1 : -1;
+                neighbors[3] = cell * 2;
+                neighbors[4] = cellExists(x, y + 1) ? cellIndex(x, y + 1) * 2 : -1;
+                neighbors[5] = cellExists(x + 1, y) ? cellIndex(x + 1, y) * 2 : -1;
+            }
+        }
+    });
+}
 
+std::unique_ptr<NavMesh> NavMeshGenerator::GenerateTiled(const TileSource& source) {
+    const int width = source.heights.width;
+    const int height = source.heights.height;
+    if (width < 2 || height < 2 || m_cellSize <= 0.0f) {
+        std::cerr << "NavMeshGenerator: Heightmap is too small" << std::endl;
+        return nullptr;
+    }
+    
+    auto navMesh = std::make_unique<NavMesh>();
+    navMesh->m_nodes.resize(static_cast<size_t>(width) * height);
+    navMesh->m_triangles.resize(static_cast<size_t>(width - 1) * (height - 1) * 2);
+    
+    const int tileCountX = (width + m_tileSize - 1) / m_tileSize;
+    const int tileCountY = (height + m_tileSize - 1) / m_tileSize;
+    std::vector<int> tiles(static_cast<size_t>(tileCountX) * tileCountY);
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        tiles[i] = static_cast<int>(i);
+    }
+    BuildTiles(source, tiles, *navMesh);
+    
+    BuildGridTopology(*navMesh, width, height);
+    navMesh->BuildSpatialIndex();
+    navMesh->m_hasTileSource = true;
+    navMesh->m_tileThreshold = source.threshold;
+    
+    std::cout << "NavMeshGenerator: " << tiles.size() << " tiles, " << navMesh->m_nodes.size() << " nodes, "
+              << navMesh->m_triangles.size() << " triangles" << std::endl;
+    return navMesh;
+}
+
+} // namespace FastEngine
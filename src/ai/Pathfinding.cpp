@@ -2,6 +2,7 @@
 #include <iostream>
 #include <algorithm>
 #include <cmath>
+#include <chrono>
 #include <limits>
 #include <sstream>
 
@@ -12,11 +13,8 @@ AStarPathfinding::AStarPathfinding()
     , m_smoothPath(true)
     , m_lastNodesExplored(0)
     , m_lastPathCost(0.0f) {
-    
-    // Устанавливаем эвристику по умолчанию (евклидово расстояние)
-    m_heuristic = [](const glm::vec3& start, const glm::vec3& end) {
-        return glm::distance(start, end);
-    };
+    // Без пользовательской эвристики используется EuclideanHeuristic,
+    // которая встраивается в цикл поиска без косвенного вызова
 }
 
 void AStarPathfinding::SetHeuristic(std::function<float(const glm::vec3&, const glm::vec3&)> heuristic) {
@@ -26,45 +24,31 @@ void AStarPathfinding::SetHeuristic(std::function<float(const glm::vec3&, const
 PathfindingResult AStarPathfinding::FindPath(const NavMesh& navMesh, 
                                             const glm::vec3& start, 
                                             const glm::vec3& end) {
-    PathfindingResult result;
-    
+    if (m_heuristic) {
+        return FindPath(navMesh, start, end, m_heuristic);
+    }
+    return FindPath(navMesh, start, end, EuclideanHeuristic());
+}
+
+AStarScratch& AStarPathfinding::GetThreadScratch() {
+    thread_local AStarScratch scratch;
+    return scratch;
+}
+
+bool AStarPathfinding::ResolveEndpoints(const NavMesh& navMesh, const glm::vec3& start, const glm::vec3& end,
+                                        int& startNode, int& endNode, PathfindingResult& result) const {
     if (!navMesh.IsValid()) {
         std::cerr << "AStarPathfinding: Invalid NavMesh" << std::endl;
-        return result;
-    }
-    
-    const auto& nodes = navMesh.GetNodes();
-    if (nodes.empty()) {
-        std::cerr << "AStarPathfinding: No nodes in NavMesh" << std::endl;
-        return result;
+        return false;
     }
     
     // Находим ближайшие узлы
-    int startNode = -1;
-    int endNode = -1;
-    float minStartDist = std::numeric_limits<float>::max();
-    float minEndDist = std::numeric_limits<float>::max();
-    
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        if (!nodes[i].walkable) continue;
-        
-        float startDist = glm::distance(start, nodes[i].position);
-        float endDist = glm::distance(end, nodes[i].position);
-        
-        if (startDist < minStartDist) {
-            minStartDist = startDist;
-            startNode = static_cast<int>(i);
-        }
-        
-        if (endDist < minEndDist) {
-            minEndDist = endDist;
-            endNode = static_cast<int>(i);
-        }
-    }
+    startNode = navMesh.FindNearestNode(start);
+    endNode = navMesh.FindNearestNode(end);
     
     if (startNode == -1 || endNode == -1) {
         std::cerr << "AStarPathfinding: Could not find valid start or end node" << std::endl;
-        return result;
+        return false;
     }
     
     if (startNode == endNode) {
@@ -72,168 +56,221 @@ PathfindingResult AStarPathfinding::FindPath(const NavMesh& navMesh,
         result.path = {start, end};
         result.totalCost = 0.0f;
         result.nodesExplored = 1;
-        return result;
+        return false;
     }
     
-    // Инициализируем A* алгоритм
-    std::priority_queue<PathNode, std::vector<PathNode>, std::greater<PathNode>> openSet;
-    std::unordered_set<int> closedSet;
-    std::unordered_map<int, int> cameFrom;
-    std::unordered_map<int, float> gScore;
-    std::unordered_map<int, float> fScore;
+    return true;
+}
+
+void AStarPathfinding::FinishSearch(const NavMesh& navMesh, AStarScratch& scratch, int endNode, bool found,
+                                    int iterations, int nodesExplored, PathfindingResult& result) {
+    result.nodesExplored = nodesExplored;
+    m_lastNodesExplored = nodesExplored;
     
-    // Начальный узел
-    float hStart = CalculateHeuristic(nodes[startNode].position, nodes[endNode].position);
-    gScore[startNode] = 0.0f;
-    fScore[startNode] = hStart;
-    openSet.emplace(startNode, 0.0f, hStart, -1);
+    if (!found) {
+        // Путь не найден
+        result.success = false;
+        m_lastPathCost = 0.0f;
+        std::cerr << "AStarPathfinding: Path not found after " << iterations << " iterations" << std::endl;
+        return;
+    }
     
-    int iterations = 0;
+    std::vector<int>& nodePath = scratch.GetPathBuffer();
+    ReconstructPath(scratch, endNode, nodePath);
     
-    while (!openSet.empty() && iterations < m_maxIterations) {
-        ++iterations;
-        
-        PathNode current = openSet.top();
-        openSet.pop();
-        
-        if (current.nodeIndex == endNode) {
-            // Найден путь
-            std::vector<int> nodePath = ReconstructPath(cameFrom, startNode, endNode);
-            
-            // Преобразуем в позиции
-            for (int nodeIndex : nodePath) {
-                result.path.push_back(nodes[nodeIndex].position);
-            }
-            
-            if (m_smoothPath) {
-                result.path = SmoothPath(result.path);
-            }
-            
-            result.success = true;
-            result.totalCost = gScore[endNode];
-            result.nodesExplored = static_cast<int>(closedSet.size());
-            m_lastNodesExplored = result.nodesExplored;
-            m_lastPathCost = result.totalCost;
-            
-            return result;
-        }
-        
-        closedSet.insert(current.nodeIndex);
-        
-        // Проверяем соседние узлы
-        for (int neighbor : nodes[current.nodeIndex].connections) {
-            if (closedSet.find(neighbor) != closedSet.end()) {
-                continue;
-            }
-            
-            if (!nodes[neighbor].walkable) {
-                continue;
-            }
-            
-            if (!IsValidMove(navMesh, current.nodeIndex, neighbor)) {
-                continue;
-            }
-            
-            float tentativeGScore = gScore[current.nodeIndex] + 
-                                  glm::distance(nodes[current.nodeIndex].position, nodes[neighbor].position) * 
-                                  nodes[neighbor].cost;
-            
-            if (gScore.find(neighbor) == gScore.end() || tentativeGScore < gScore[neighbor]) {
-                cameFrom[neighbor] = current.nodeIndex;
-                gScore[neighbor] = tentativeGScore;
-                float hNeighbor = CalculateHeuristic(nodes[neighbor].position, nodes[endNode].position);
-                fScore[neighbor] = tentativeGScore + hNeighbor;
-                
-                openSet.emplace(neighbor, tentativeGScore, hNeighbor, current.nodeIndex);
-            }
-        }
+    // Преобразуем в позиции
+    const auto& nodes = navMesh.GetNodes();
+    result.path.reserve(nodePath.size());
+    for (int nodeIndex : nodePath) {
+        result.path.push_back(nodes[nodeIndex].position);
     }
     
-    // Путь не найден
-    result.success = false;
-    result.nodesExplored = static_cast<int>(closedSet.size());
-    m_lastNodesExplored = result.nodesExplored;
-    m_lastPathCost = 0.0f;
-    
-    std::cerr << "AStarPathfinding: Path not found after " << iterations << " iterations" << std::endl;
-    return result;
-}
-
-float AStarPathfinding::CalculateHeuristic(const glm::vec3& start, const glm::vec3& end) const {
-    if (m_heuristic) {
-        return m_heuristic(start, end);
+    if (m_smoothPath) {
+        result.path = SmoothPath(navMesh, result.path);
     }
-    return glm::distance(start, end);
+    
+    result.success = true;
+    result.totalCost = scratch.GetG(endNode);
+    m_lastPathCost = result.totalCost;
 }
 
-std::vector<int> AStarPathfinding::ReconstructPath(const std::unordered_map<int, int>& cameFrom, 
-                                                  int start, int end) const {
-    std::vector<int> path;
-    int current = end;
-    
-    while (current != -1) {
+void AStarPathfinding::ReconstructPath(const AStarScratch& scratch, int end, std::vector<int>& path) const {
+    path.clear();
+    for (int current = end; current != -1; current = scratch.GetParent(current)) {
         path.push_back(current);
-        auto it = cameFrom.find(current);
-        current = (it != cameFrom.end()) ? it->second : -1;
     }
-    
     std::reverse(path.begin(), path.end());
-    return path;
 }
 
-std::vector<glm::vec3> AStarPathfinding::SmoothPath(const std::vector<glm::vec3>& path) const {
+std::vector<glm::vec3> AStarPathfinding::SmoothPath(const NavMesh& navMesh, const std::vector<glm::vec3>& path) const {
     if (path.size() <= 2) {
         return path;
     }
     
+    // Натягивание нити: пропускаем точки, пока отрезок от опорной точки
+    // остается на проходимой поверхности
     std::vector<glm::vec3> smoothedPath;
+    smoothedPath.reserve(path.size());
     smoothedPath.push_back(path[0]);
     
-    for (size_t i = 1; i < path.size() - 1; ++i) {
-        // Простое сглаживание - усредняем соседние точки
-        glm::vec3 smoothed = (path[i - 1] + path[i] + path[i + 1]) / 3.0f;
-        smoothedPath.push_back(smoothed);
+    size_t anchor = 0;
+    for (size_t i = 2; i < path.size(); ++i) {
+        if (navMesh.Raycast(path[anchor], path[i])) {
+            anchor = i - 1;
+            smoothedPath.push_back(path[anchor]);
+        }
     }
     
     smoothedPath.push_back(path.back());
     return smoothedPath;
 }
 
-bool AStarPathfinding::IsValidMove(const NavMesh& navMesh, int from, int to) const {
-    // В реальной реализации здесь бы проверялись препятствия
-    return true;
+// AStarScratch implementation
+void AStarScratch::Begin(size_t nodeCount) {
+    if (m_nodes.size() < nodeCount) {
+        m_nodes.resize(nodeCount, NodeState{0.0f, -1, 0, 0});
+    }
+    m_open.clear();
+    
+    // При переполнении счетчика поколений метки сбрасываются один раз
+    if (++m_generation == 0) {
+        for (auto& state : m_nodes) {
+            state.visitStamp = 0;
+            state.closedStamp = 0;
+        }
+        m_generation = 1;
+    }
+}
+
+void AStarScratch::PushOpen(float f, int node) {
+    size_t index = m_open.size();
+    m_open.push_back(OpenEntry{f, node});
+    
+    // Просеивание вверх
+    while (index > 0) {
+        size_t parent = (index - 1) / HEAP_ARITY;
+        if (m_open[parent].f <= f) {
+            break;
+        }
+        m_open[index] = m_open[parent];
+        index = parent;
+    }
+    m_open[index] = OpenEntry{f, node};
+}
+
+int AStarScratch::PopOpen() {
+    int top = m_open[0].node;
+    OpenEntry last = m_open.back();
+    m_open.pop_back();
+    
+    const size_t size = m_open.size();
+    if (size == 0) {
+        return top;
+    }
+    
+    // Просеивание вниз: выбираем минимального из HEAP_ARITY потомков
+    size_t index = 0;
+    for (;;) {
+        size_t firstChild = index * HEAP_ARITY + 1;
+        if (firstChild >= size) {
+            break;
+        }
+        
+        size_t lastChild = std::min(firstChild + HEAP_ARITY, size);
+        size_t best = firstChild;
+        for (size_t child = firstChild + 1; child < lastChild; ++child) {
+            if (m_open[child].f < m_open[best].f) {
+                best = child;
+            }
+        }
+        
+        if (last.f <= m_open[best].f) {
+            break;
+        }
+        m_open[index] = m_open[best];
+        index = best;
+    }
+    m_open[index] = last;
+    
+    return top;
 }
 
 // PathfindingManager implementation
 PathfindingManager::PathfindingManager() 
     : m_maxIterations(1000)
     , m_totalPathsFound(0)
-    , m_averagePathCost(0.0f) {
+    , m_averagePathCost(0.0f)
+    , m_nextRequestId(1)
+    , m_nextSequence(0)
+    , m_maxDispatchPerFrame(256)
+    , m_frameBudgetMs(2.0f)
+    , m_dedupCellSize(1.0f)
+    , m_totalRequests(0)
+    , m_deduplicatedRequests(0)
+    , m_workerCount(0)
+    , m_stopWorkers(false) {
+}
+
+PathfindingManager::~PathfindingManager() {
+    StopWorkers();
+    JobSystem::GetInstance().Wait(m_searchJobs);
 }
 
 bool PathfindingManager::Initialize() {
     m_pathfinder = std::make_unique<AStarPathfinding>();
+    m_pathfinder->SetMaxIterations(m_maxIterations);
     
-    // Устанавливаем эвристику по умолчанию
-    m_pathfinder->SetHeuristic([](const glm::vec3& start, const glm::vec3& end) {
-        return glm::distance(start, end);
-    });
+    StartWorkers();
     
-    std::cout << "PathfindingManager initialized successfully" << std::endl;
+    if (m_workers.empty()) {
+        std::cout << "PathfindingManager initialized successfully (JobSystem)" << std::endl;
+    } else {
+        std::cout << "PathfindingManager initialized successfully (" << m_workers.size() << " workers)" << std::endl;
+    }
     return true;
 }
 
 void PathfindingManager::Shutdown() {
+    StopWorkers();
+    // Выполняющиеся задания дописывают результаты в m_completed
+    JobSystem::GetInstance().Wait(m_searchJobs);
+    
+    m_pending = std::priority_queue<PendingEntry>();
+    m_activeQueries.clear();
+    m_requests.clear();
+    m_completed.clear();
+    m_workQueue.clear();
+    m_ready.clear();
+    
     m_navMeshes.clear();
     m_pathfinder.reset();
     std::cout << "PathfindingManager shutdown" << std::endl;
 }
 
-void PathfindingManager::AddNavMesh(const std::string& name, std::shared_ptr<NavMesh> navMesh) {
-    m_navMeshes[name] = navMesh;
+void PathfindingManager::AddNavMesh(const std::string& name, std::unique_ptr<NavMesh> navMesh) {
+    if (!navMesh) {
+        std::cerr << "PathfindingManager: Null NavMesh: " << name << std::endl;
+        return;
+    }
+    m_navMeshes[name] = std::shared_ptr<const NavMesh>(std::move(navMesh));
     std::cout << "Added NavMesh: " << name << std::endl;
 }
 
+bool PathfindingManager::EditNavMesh(const std::string& name, const std::function<void(NavMesh&)>& edit) {
+    auto it = m_navMeshes.find(name);
+    if (it == m_navMeshes.end()) {
+        std::cerr << "PathfindingManager: NavMesh not found: " << name << std::endl;
+        return false;
+    }
+    
+    // Поиски, уже держащие прежнюю версию, дочитывают ее; новые запросы
+    // получают копию с изменениями
+    std::unique_ptr<NavMesh> version = std::make_unique<NavMesh>(*it->second);
+    edit(*version);
+    it->second = std::shared_ptr<const NavMesh>(std::move(version));
+    return true;
+}
+
 void PathfindingManager::RemoveNavMesh(const std::string& name) {
     auto it = m_navMeshes.find(name);
     if (it != m_navMeshes.end()) {
@@ -242,7 +279,7 @@ void PathfindingManager::RemoveNavMesh(const std::string& name) {
     }
 }
 
-std::shared_ptr<NavMesh> PathfindingManager::GetNavMesh(const std::string& name) const {
+std::shared_ptr<const NavMesh> PathfindingManager::GetNavMesh(const std::string& name) const {
     auto it = m_navMeshes.find(name);
     return (it != m_navMeshes.end()) ? it->second : nullptr;
 }
@@ -267,16 +304,275 @@ PathfindingResult PathfindingManager::FindPath(const std::string& navMeshName,
     return result;
 }
 
+PathRequestId PathfindingManager::RequestPath(const std::string& navMeshName,
+                                              const glm::vec3& start,
+                                              const glm::vec3& end,
+                                              PathResultCallback callback,
+                                              PathRequestPriority priority) {
+    auto navMesh = GetNavMesh(navMeshName);
+    if (!navMesh) {
+        std::cerr << "PathfindingManager: NavMesh not found: " << navMeshName << std::endl;
+        return 0;
+    }
+    
+    PathRequestId requestId = m_nextRequestId++;
+    ++m_totalRequests;
+    
+    PathQueryKey key = MakeQueryKey(navMesh.get(), start, end);
+    auto existing = m_activeQueries.find(key);
+    if (existing != m_activeQueries.end()) {
+        // Тот же поиск уже в очереди или выполняется - подписываемся на него
+        std::shared_ptr<PathQuery> query = existing->second;
+        query->subscribers.push_back(PathSubscriber{requestId, std::move(callback)});
+        m_requests[requestId] = query;
+        ++m_deduplicatedRequests;
+        
+        if (!query->dispatched && priority > query->priority) {
+            query->priority = priority;
+            m_pending.push(PendingEntry{priority, m_nextSequence++, query});
+        }
+        return requestId;
+    }
+    
+    auto query = std::make_shared<PathQuery>();
+    query->navMesh = navMesh;
+    query->heuristic = m_heuristic;
+    query->start = start;
+    query->end = end;
+    query->maxIterations = m_maxIterations;
+    query->key = key;
+    query->priority = priority;
+    query->dispatched = false;
+    query->subscribers.push_back(PathSubscriber{requestId, std::move(callback)});
+    
+    m_activeQueries[key] = query;
+    m_requests[requestId] = query;
+    m_pending.push(PendingEntry{priority, m_nextSequence++, query});
+    
+    return requestId;
+}
+
+bool PathfindingManager::CancelRequest(PathRequestId requestId) {
+    auto it = m_requests.find(requestId);
+    if (it == m_requests.end()) {
+        return false;
+    }
+    
+    std::shared_ptr<PathQuery> query = it->second;
+    m_requests.erase(it);
+    
+    auto& subscribers = query->subscribers;
+    subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(),
+                                     [requestId](const PathSubscriber& s) { return s.id == requestId; }),
+                      subscribers.end());
+    
+    // Поиск без подписчиков больше не нужен; если он уже выполняется,
+    // результат будет отброшен при доставке
+    if (subscribers.empty() && !query->dispatched) {
+        m_activeQueries.erase(query->key);
+    }
+    return true;
+}
+
+bool PathfindingManager::IsRequestPending(PathRequestId requestId) const {
+    return m_requests.find(requestId) != m_requests.end();
+}
+
 void PathfindingManager::SetDefaultHeuristic(std::function<float(const glm::vec3&, const glm::vec3&)> heuristic) {
     if (m_pathfinder) {
         m_pathfinder->SetHeuristic(heuristic);
     }
+    m_heuristic = heuristic ? std::make_shared<const HeuristicFunction>(std::move(heuristic)) : nullptr;
+}
+
+void PathfindingManager::Update() {
+    const auto frameStart = std::chrono::steady_clock::now();
+    DispatchPending(frameStart);
+    DeliverCompleted(frameStart);
+}
+
+bool PathfindingManager::IsBudgetExhausted(std::chrono::steady_clock::time_point frameStart) const {
+    std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - frameStart;
+    return elapsed.count() >= m_frameBudgetMs;
+}
+
+PathfindingManager::PathQueryKey PathfindingManager::MakeQueryKey(const NavMesh* navMesh,
+                                                                  const glm::vec3& start,
+                                                                  const glm::vec3& end) const {
+    const float inverseCell = m_dedupCellSize > 0.0f ? 1.0f / m_dedupCellSize : 1.0f;
+    
+    PathQueryKey key;
+    key.navMesh = navMesh;
+    for (int i = 0; i < 3; ++i) {
+        key.cells[i] = static_cast<int>(std::floor(start[i] * inverseCell));
+        key.cells[i + 3] = static_cast<int>(std::floor(end[i] * inverseCell));
+    }
+    return key;
+}
+
+bool PathfindingManager::PathQueryKey::operator==(const PathQueryKey& other) const {
+    return navMesh == other.navMesh && std::equal(cells, cells + 6, other.cells);
+}
+
+size_t PathfindingManager::PathQueryKeyHash::operator()(const PathQueryKey& key) const {
+    size_t hash = std::hash<const void*>()(key.navMesh);
+    for (int cell : key.cells) {
+        hash ^= std::hash<int>()(cell) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+void PathfindingManager::StartWorkers() {
+    StopWorkers();
+    
+    m_stopWorkers = false;
+    for (int i = 0; i < m_workerCount; ++i) {
+        m_workers.emplace_back(&PathfindingManager::WorkerThreadFunction, this);
+    }
+}
+
+void PathfindingManager::StopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(m_workMutex);
+        m_stopWorkers = true;
+    }
+    m_workCondition.notify_all();
+    
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    m_workers.clear();
+}
+
+void PathfindingManager::WorkerThreadFunction() {
+    for (;;) {
+        std::shared_ptr<PathQuery> query;
+        {
+            std::unique_lock<std::mutex> lock(m_workMutex);
+            m_workCondition.wait(lock, [this]() { return m_stopWorkers || !m_workQueue.empty(); });
+            if (m_stopWorkers) {
+                return;
+            }
+            query = std::move(m_workQueue.front());
+            m_workQueue.pop_front();
+        }
+        
+        RunQuery(*query);
+        CompleteQuery(std::move(query));
+    }
+}
+
+void PathfindingManager::CompleteQuery(std::shared_ptr<PathQuery> query) {
+    std::lock_guard<std::mutex> lock(m_completedMutex);
+    m_completed.push_back(std::move(query));
+}
+
+void PathfindingManager::RunQuery(PathQuery& query) {
+    // Отдельный экземпляр на поиск: статистика AStarPathfinding не разделяется
+    // между потоками, а рабочие буферы берутся из thread_local AStarScratch
+    AStarPathfinding pathfinder;
+    pathfinder.SetMaxIterations(query.maxIterations);
+    
+    if (query.heuristic) {
+        query.result = pathfinder.FindPath(*query.navMesh, query.start, query.end, *query.heuristic);
+    } else {
+        query.result = pathfinder.FindPath(*query.navMesh, query.start, query.end, EuclideanHeuristic());
+    }
+}
+
+void PathfindingManager::DispatchPending(std::chrono::steady_clock::time_point frameStart) {
+    JobSystem& jobs = JobSystem::GetInstance();
+    const bool useJobs = m_workers.empty() && jobs.IsRunning();
+    const bool inlineSearch = m_workers.empty() && !useJobs;
+    int dispatched = 0;
+    
+    std::vector<std::shared_ptr<PathQuery>> batch;
+    
+    while (!m_pending.empty() && dispatched < m_maxDispatchPerFrame) {
+        std::shared_ptr<PathQuery> query = m_pending.top().query;
+        m_pending.pop();
+        
+        // Пропускаем отмененные поиски и устаревшие записи после повышения приоритета
+        if (query->dispatched || query->subscribers.empty()) {
+            continue;
+        }
+        query->dispatched = true;
+        ++dispatched;
+        
+        if (inlineSearch) {
+            RunQuery(*query);
+            DeliverQuery(*query);
+            
+            if (IsBudgetExhausted(frameStart)) {
+                break;
+            }
+        } else {
+            batch.push_back(std::move(query));
+        }
+    }
+    
+    if (useJobs) {
+        // Каждый поиск - отдельное задание; Update не ждет их, результаты
+        // забираются в DeliverCompleted этого или следующих кадров
+        static const ProfileNameId searchJob = ProfileNames::Register("PathfindingManager::Search");
+        for (auto& query : batch) {
+            jobs.Schedule([this, query]() {
+                RunQuery(*query);
+                CompleteQuery(query);
+            }, &m_searchJobs, nullptr, searchJob);
+        }
+    } else if (!batch.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(m_workMutex);
+            for (auto& query : batch) {
+                m_workQueue.push_back(std::move(query));
+            }
+        }
+        m_workCondition.notify_all();
+    }
+}
+
+void PathfindingManager::DeliverCompleted(std::chrono::steady_clock::time_point frameStart) {
+    {
+        std::lock_guard<std::mutex> lock(m_completedMutex);
+        m_ready.insert(m_ready.end(), m_completed.begin(), m_completed.end());
+        m_completed.clear();
+    }
+    
+    // Обратные вызовы подписчиков тоже укладываются в бюджет кадра;
+    // хотя бы один результат доставляется всегда
+    while (!m_ready.empty()) {
+        std::shared_ptr<PathQuery> query = std::move(m_ready.front());
+        m_ready.pop_front();
+        DeliverQuery(*query);
+        
+        if (IsBudgetExhausted(frameStart)) {
+            break;
+        }
+    }
 }
 
-void PathfindingManager::Update(float deltaTime) {
-    // В реальной реализации здесь бы обновлялись активные поиски путей
-    // и кэшированные результаты
-    // Пока что просто заглушка
+void PathfindingManager::DeliverQuery(PathQuery& query) {
+    auto active = m_activeQueries.find(query.key);
+    if (active != m_activeQueries.end() && active->second.get() == &query) {
+        m_activeQueries.erase(active);
+    }
+    
+    UpdateStatistics(query.result);
+    
+    // Подписчики забираются заранее: обратный вызов может создать новый запрос
+    std::vector<PathSubscriber> subscribers;
+    subscribers.swap(query.subscribers);
+    for (const auto& subscriber : subscribers) {
+        m_requests.erase(subscriber.id);
+    }
+    for (const auto& subscriber : subscribers) {
+        if (subscriber.callback) {
+            subscriber.callback(subscriber.id, query.result);
+        }
+    }
 }
 
 void PathfindingManager::UpdateStatistics(const PathfindingResult& result) {
@@ -288,12 +584,23 @@ void PathfindingManager::UpdateStatistics(const PathfindingResult& result) {
 
 // PathfindingComponent implementation
 PathfindingComponent::PathfindingComponent() 
-    : m_currentWaypoint(0)
+    : m_manager(nullptr)
+    , m_pendingRequest(0)
+    , m_priority(PathRequestPriority::Normal)
+    , m_position(0.0f)
+    , m_target(0.0f)
+    , m_currentWaypoint(0)
     , m_speed(5.0f)
     , m_arrivalDistance(0.5f)
     , m_isMoving(false) {
 }
 
+PathfindingComponent::~PathfindingComponent() {
+    if (m_manager && m_pendingRequest != 0) {
+        m_manager->CancelRequest(m_pendingRequest);
+    }
+}
+
 // SetTargetPosition уже определен в заголовочном файле как inline
 
 void PathfindingComponent::StartPathfinding() {
@@ -302,38 +609,84 @@ void PathfindingComponent::StartPathfinding() {
         return;
     }
     
-    // В реальной реализации здесь бы вызывался PathfindingManager
-    std::cout << "PathfindingComponent: Starting pathfinding to target" << std::endl;
-    m_isMoving = true;
+    if (!m_manager) {
+        std::cerr << "PathfindingComponent: No PathfindingManager set" << std::endl;
+        return;
+    }
+    
+    // Новый запрос заменяет незавершенный предыдущий
+    if (m_pendingRequest != 0) {
+        m_manager->CancelRequest(m_pendingRequest);
+    }
+    
+    m_pendingRequest = m_manager->RequestPath(m_navMeshName, m_position, m_target,
+        [this](PathRequestId requestId, const PathfindingResult& result) {
+            OnPathResult(requestId, result);
+        },
+        m_priority);
+    
+    if (m_pendingRequest == 0 && m_onPathFailed) {
+        m_onPathFailed();
+    }
 }
 
 void PathfindingComponent::StopPathfinding() {
+    if (m_manager && m_pendingRequest != 0) {
+        m_manager->CancelRequest(m_pendingRequest);
+    }
+    m_pendingRequest = 0;
     m_isMoving = false;
     m_path.clear();
     m_currentWaypoint = 0;
-    std::cout << "PathfindingComponent: Stopped pathfinding" << std::endl;
+}
+
+void PathfindingComponent::OnPathResult(PathRequestId requestId, const PathfindingResult& result) {
+    if (requestId != m_pendingRequest) {
+        return;
+    }
+    m_pendingRequest = 0;
+    
+    if (!result.success) {
+        m_isMoving = false;
+        if (m_onPathFailed) {
+            m_onPathFailed();
+        }
+        return;
+    }
+    
+    m_path = result.path;
+    m_currentWaypoint = 0;
+    m_isMoving = true;
 }
 
 void PathfindingComponent::Update(float deltaTime) {
-    if (!m_isMoving || m_path.empty() || m_currentWaypoint >= m_path.size()) {
-        if (m_isMoving && m_onPathComplete) {
+    if (!m_isMoving) {
+        return;
+    }
+    
+    if (m_path.empty() || m_currentWaypoint >= static_cast<int>(m_path.size())) {
+        m_isMoving = false;
+        if (m_onPathComplete) {
             m_onPathComplete();
         }
-        m_isMoving = false;
         return;
     }
     
-    // В реальной реализации здесь бы обновлялась позиция объекта
-    std::cout << "PathfindingComponent: Moving to waypoint " << m_currentWaypoint << std::endl;
+    // Движемся к текущей точке пути
+    glm::vec3 toWaypoint = m_path[m_currentWaypoint] - m_position;
+    float distance = glm::length(toWaypoint);
+    float step = m_speed * deltaTime;
     
-    // Проверяем, достигли ли текущего waypoint
-    if (m_currentWaypoint < m_path.size()) {
+    if (distance <= step || distance <= m_arrivalDistance) {
+        m_position = m_path[m_currentWaypoint];
         ++m_currentWaypoint;
+    } else {
+        m_position += toWaypoint * (step / distance);
     }
 }
 
 glm::vec3 PathfindingComponent::GetNextWaypoint() const {
-    if (m_currentWaypoint < m_path.size()) {
+    if (m_currentWaypoint < static_cast<int>(m_path.size())) {
         return m_path[m_currentWaypoint];
     }
     return m_target;
@@ -0,0 +1,171 @@
+#include "FastEngine/Animation/BlendTree.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace FastEngine {
+    uint32_t BlendTree::AddParameter(const std::string& name, float defaultValue) {
+        int existing = FindParameter(name);
+        if (existing >= 0) {
+            m_parameterDefaults[existing] = defaultValue;
+            return static_cast<uint32_t>(existing);
+        }
+        m_parameterNames.push_back(name);
+        m_parameterDefaults.push_back(defaultValue);
+        return static_cast<uint32_t>(m_parameterNames.size() - 1);
+    }
+
+    int BlendTree::FindParameter(const std::string& name) const {
+        auto it = std::find(m_parameterNames.begin(), m_parameterNames.end(), name);
+        return it != m_parameterNames.end() ? static_cast<int>(it - m_parameterNames.begin()) : -1;
+    }
+
+    uint32_t BlendTree::AddClip(std::shared_ptr<const SkeletalClip> clip, float speed, bool looping) {
+        if (!clip) {
+            std::cerr << "BlendTree: clip node without clip" << std::endl;
+            return INVALID_NODE;
+        }
+        if (m_boneCount != 0 && clip->GetBoneCount() != m_boneCount) {
+            std::cerr << "BlendTree: clip '" << clip->GetName() << "' has " << clip->GetBoneCount()
+                      << " bones, tree has " << m_boneCount << std::endl;
+            return INVALID_NODE;
+        }
+        m_boneCount = clip->GetBoneCount();
+
+        Node node = {};
+        node.type = NodeType::Clip;
+        node.clip = std::move(clip);
+        node.speed = speed;
+        node.looping = looping;
+        return AddNode(node);
+    }
+
+    uint32_t BlendTree::AddBlend(uint32_t from, uint32_t to, uint32_t parameter) {
+        if (from >= m_nodes.size() || to >= m_nodes.size() || parameter >= GetParameterCount()) {
+            std::cerr << "BlendTree: blend node references missing node or parameter" << std::endl;
+            return INVALID_NODE;
+        }
+        Node node = {};
+        node.type = NodeType::Blend;
+        node.from = from;
+        node.to = to;
+        node.parameter = parameter;
+        return AddNode(node);
+    }
+
+    uint32_t BlendTree::AddBlend1D(uint32_t parameter, const std::vector<std::pair<float, uint32_t>>& points) {
+        if (points.empty() || parameter >= GetParameterCount()) {
+            std::cerr << "BlendTree: 1D blend needs points and a parameter" << std::endl;
+            return INVALID_NODE;
+        }
+        for (size_t i = 0; i < points.size(); ++i) {
+            if (points[i].second >= m_nodes.size() || (i > 0 && points[i].first <= points[i - 1].first)) {
+                std::cerr << "BlendTree: 1D blend points must reference existing nodes in ascending order" << std::endl;
+                return INVALID_NODE;
+            }
+        }
+        Node node = {};
+        node.type = NodeType::Blend1D;
+        node.parameter = parameter;
+        node.firstPoint = static_cast<uint32_t>(m_points.size());
+        node.pointCount = static_cast<uint32_t>(points.size());
+        m_points.insert(m_points.end(), points.begin(), points.end());
+        return AddNode(node);
+    }
+
+    void BlendTree::SetRoot(uint32_t node) {
+        if (node < m_nodes.size()) {
+            m_root = node;
+        }
+    }
+
+    uint32_t BlendTree::AddNode(const Node& node) {
+        m_nodes.push_back(node);
+        m_root = static_cast<uint32_t>(m_nodes.size() - 1);
+        return m_root;
+    }
+
+    std::shared_ptr<BlendTree> BlendTree::FromClip(std::shared_ptr<const SkeletalClip> clip) {
+        auto tree = std::make_shared<BlendTree>();
+        if (tree->AddClip(std::move(clip)) == INVALID_NODE) {
+            return nullptr;
+        }
+        return tree;
+    }
+
+    void BlendTree::Evaluate(float time, const float* parameters, BlendTreeContext& context, Pose& out) const {
+        if (m_root == INVALID_NODE) {
+            return;
+        }
+        // Глубина не больше числа узлов; стек не растет во время обхода
+        if (context.stack.size() < m_nodes.size()) {
+            context.stack.resize(m_nodes.size());
+        }
+        EvaluateNode(m_root, time, parameters, context, 0, out);
+    }
+
+    void BlendTree::EvaluateNode(uint32_t index, float time, const float* parameters, BlendTreeContext& context,
+                                 uint32_t depth, Pose& out) const {
+        const Node& node = m_nodes[index];
+        switch (node.type) {
+            case NodeType::Clip: {
+                const float duration = node.clip->GetDuration();
+                float clipTime = time * node.speed;
+                if (node.looping && duration > 0.0f) {
+                    clipTime = std::fmod(clipTime, duration);
+                    if (clipTime < 0.0f) {
+                        clipTime += duration;
+                    }
+                }
+                node.clip->Sample(clipTime, context.sample, out);
+                break;
+            }
+
+            case NodeType::Blend: {
+                float weight = std::min(std::max(parameters[node.parameter], 0.0f), 1.0f);
+                EvaluateBlend(node.from, node.to, weight, time, parameters, context, depth, out);
+                break;
+            }
+
+            case NodeType::Blend1D: {
+                const std::pair<float, uint32_t>* points = m_points.data() + node.firstPoint;
+                const float value = parameters[node.parameter];
+                if (node.pointCount == 1 || value <= points[0].first) {
+                    EvaluateNode(points[0].second, time, parameters, context, depth, out);
+                    break;
+                }
+                const uint32_t last = node.pointCount - 1;
+                if (value >= points[last].first) {
+                    EvaluateNode(points[last].second, time, parameters, context, depth, out);
+                    break;
+                }
+                uint32_t segment = 0;
+                while (value > points[segment + 1].first) {
+                    ++segment;
+                }
+                const float weight = (value - points[segment].first) / (points[segment + 1].first - points[segment].first);
+                EvaluateBlend(points[segment].second, points[segment + 1].second, weight, time, parameters,
+                              context, depth, out);
+                break;
+            }
+        }
+    }
+
+    void BlendTree::EvaluateBlend(uint32_t from, uint32_t to, float weight, float time, const float* parameters,
+                                  BlendTreeContext& context, uint32_t depth, Pose& out) const {
+        // Крайние веса - одна ветвь без смешивания
+        if (weight <= 0.0f) {
+            EvaluateNode(from, time, parameters, context, depth, out);
+            return;
+        }
+        if (weight >= 1.0f) {
+            EvaluateNode(to, time, parameters, context, depth, out);
+            return;
+        }
+
+        EvaluateNode(from, time, parameters, context, depth + 1, out);
+        Pose& other = context.stack[depth];
+        EvaluateNode(to, time, parameters, context, depth + 1, other);
+        BlendPoses(out, other, weight, out);
+    }
+}
@@ -0,0 +1,273 @@
+#include "FastEngine/Animation/SkeletalClip.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace FastEngine {
+    namespace {
+        constexpr float SMALLEST_THREE_RANGE = 0.70710678f; // 1/sqrt(2)
+        constexpr float QUANTIZE_15 = 32767.0f;
+        constexpr float QUANTIZE_16 = 65535.0f;
+        constexpr uint32_t MAX_FRAMES = 65536;
+
+        struct Vec4 {
+            float v[4];
+        };
+
+        float Dot4(const Vec4& a, const Vec4& b) {
+            return a.v[0] * b.v[0] + a.v[1] * b.v[1] + a.v[2] * b.v[2] + a.v[3] * b.v[3];
+        }
+
+        // Интерполяция так же, как при воспроизведении: lerp или nlerp
+        Vec4 Interpolate(const Vec4& a, const Vec4& b, float t, bool rotation) {
+            Vec4 result;
+            float sign = rotation && Dot4(a, b) < 0.0f ? -1.0f : 1.0f;
+            for (int c = 0; c < 4; ++c) {
+                result.v[c] = a.v[c] + (b.v[c] * sign - a.v[c]) * t;
+            }
+            if (rotation) {
+                float length = std::sqrt(Dot4(result, result));
+                for (int c = 0; c < 4; ++c) {
+                    result.v[c] /= length;
+                }
+            }
+            return result;
+        }
+
+        float Error(const Vec4& a, const Vec4& b, bool rotation) {
+            if (rotation) {
+                // Угол между поворотами
+                return 2.0f * std::acos(std::min(1.0f, std::fabs(Dot4(a, b))));
+            }
+            float error = 0.0f;
+            for (int c = 0; c < 3; ++c) {
+                error = std::max(error, std::fabs(a.v[c] - b.v[c]));
+            }
+            return error;
+        }
+
+        // Номера кадров, которые остаются ключами дорожки
+        std::vector<uint32_t> ReduceKeys(const std::vector<Vec4>& values, float tolerance, bool rotation) {
+            const uint32_t count = static_cast<uint32_t>(values.size());
+            std::vector<uint32_t> keys;
+            keys.push_back(0);
+
+            bool constant = true;
+            for (uint32_t f = 1; f < count && constant; ++f) {
+                constant = Error(values[0], values[f], rotation) <= tolerance;
+            }
+            if (constant) {
+                return keys;
+            }
+
+            // Жадно: отрезок от последнего ключа тянется, пока все
+            // промежуточные кадры восстанавливаются в пределах допуска
+            uint32_t start = 0;
+            for (uint32_t end = start + 2; end < count; ++end) {
+                bool fits = true;
+                for (uint32_t f = start + 1; f < end && fits; ++f) {
+                    float t = static_cast<float>(f - start) / static_cast<float>(end - start);
+                    fits = Error(Interpolate(values[start], values[end], t, rotation), values[f], rotation) <= tolerance;
+                }
+                if (!fits) {
+                    start = end - 1;
+                    keys.push_back(start);
+                }
+            }
+            keys.push_back(count - 1);
+            return keys;
+        }
+
+        // "Три наименьших": наибольшая компонента не хранится, ее индекс -
+        // в старших битах первых двух слов
+        void EncodeRotation(Vec4 q, uint16_t* out) {
+            float length = std::sqrt(Dot4(q, q));
+            int largest = 0;
+            for (int c = 0; c < 4; ++c) {
+                q.v[c] = length > 0.0f ? q.v[c] / length : (c == 3 ? 1.0f : 0.0f);
+                if (std::fabs(q.v[c]) > std::fabs(q.v[largest])) {
+                    largest = c;
+                }
+            }
+            float sign = q.v[largest] < 0.0f ? -1.0f : 1.0f;
+            int k = 0;
+            for (int c = 0; c < 4; ++c) {
+                if (c == largest) {
+                    continue;
+                }
+                float normalized = (q.v[c] * sign + SMALLEST_THREE_RANGE) / (2.0f * SMALLEST_THREE_RANGE);
+                out[k++] = static_cast<uint16_t>(std::lround(std::min(std::max(normalized, 0.0f), 1.0f) * QUANTIZE_15));
+            }
+            out[0] |= static_cast<uint16_t>((largest & 1) << 15);
+            out[1] |= static_cast<uint16_t>((largest >> 1) << 15);
+        }
+
+        void DecodeRotation(const uint16_t* in, float* q) {
+            const int largest = (in[0] >> 15) | ((in[1] >> 15) << 1);
+            float sum = 0.0f;
+            int k = 0;
+            for (int c = 0; c < 4; ++c) {
+                if (c == largest) {
+                    continue;
+                }
+                float value = (in[k++] & 0x7FFF) / QUANTIZE_15 * (2.0f * SMALLEST_THREE_RANGE) - SMALLEST_THREE_RANGE;
+                q[c] = value;
+                sum += value * value;
+            }
+            q[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+        }
+    }
+
+    std::shared_ptr<const SkeletalClip> SkeletalClip::Compress(const RawSkeletalClip& raw,
+                                                               const SkeletalCompressionSettings& settings) {
+        const uint32_t frameCount = raw.GetFrameCount();
+        if (raw.boneCount == 0 || frameCount == 0 || raw.frames.size() != static_cast<size_t>(frameCount) * raw.boneCount) {
+            std::cerr << "SkeletalClip: invalid raw clip '" << raw.name << "'" << std::endl;
+            return nullptr;
+        }
+        if (frameCount > MAX_FRAMES || raw.sampleRate <= 0.0f) {
+            std::cerr << "SkeletalClip: clip '" << raw.name << "' is too long or has no sample rate" << std::endl;
+            return nullptr;
+        }
+
+        std::shared_ptr<SkeletalClip> clip(new SkeletalClip());
+        clip->m_name = raw.name;
+        clip->m_sampleRate = raw.sampleRate;
+        clip->m_boneCount = raw.boneCount;
+        clip->m_frameCount = frameCount;
+        clip->m_duration = static_cast<float>(frameCount - 1) / raw.sampleRate;
+        clip->m_tracks.resize(static_cast<size_t>(raw.boneCount) * TRACK_KIND_COUNT);
+
+        const float tolerances[TRACK_KIND_COUNT] = {
+            settings.translationTolerance, settings.rotationTolerance, settings.scaleTolerance
+        };
+        std::vector<Vec4> values(frameCount);
+        for (uint32_t bone = 0; bone < raw.boneCount; ++bone) {
+            for (int kind = 0; kind < TRACK_KIND_COUNT; ++kind) {
+                const bool rotation = kind == TRACK_ROTATION;
+                for (uint32_t f = 0; f < frameCount; ++f) {
+                    const BoneTransform& transform = raw.frames[static_cast<size_t>(f) * raw.boneCount + bone];
+                    const glm::vec3& v = kind == TRACK_TRANSLATION ? transform.translation : transform.scale;
+                    values[f] = rotation
+                        ? Vec4{{transform.rotation.x, transform.rotation.y, transform.rotation.z, transform.rotation.w}}
+                        : Vec4{{v.x, v.y, v.z, 0.0f}};
+                }
+                // Непрерывность знака кватерниона между кадрами
+                if (rotation) {
+                    for (uint32_t f = 1; f < frameCount; ++f) {
+                        if (Dot4(values[f - 1], values[f]) < 0.0f) {
+                            for (float& c : values[f].v) {
+                                c = -c;
+                            }
+                        }
+                    }
+                }
+
+                Track& track = clip->m_tracks[static_cast<size_t>(bone) * TRACK_KIND_COUNT + kind];
+                for (int c = 0; c < 3; ++c) {
+                    float low = values[0].v[c];
+                    float high = low;
+                    for (const Vec4& value : values) {
+                        low = std::min(low, value.v[c]);
+                        high = std::max(high, value.v[c]);
+                    }
+                    track.rangeMin[c] = low;
+                    track.rangeExtent[c] = high - low;
+                }
+
+                std::vector<uint32_t> keys = ReduceKeys(values, tolerances[kind], rotation);
+                track.firstKey = static_cast<uint32_t>(clip->m_keyFrames.size());
+                track.keyCount = static_cast<uint32_t>(keys.size());
+                for (uint32_t frame : keys) {
+                    clip->m_keyFrames.push_back(static_cast<uint16_t>(frame));
+                    uint16_t words[3] = { 0, 0, 0 };
+                    if (rotation) {
+                        EncodeRotation(values[frame], words);
+                    } else {
+                        for (int c = 0; c < 3; ++c) {
+                            float normalized = track.rangeExtent[c] > 0.0f
+                                ? (values[frame].v[c] - track.rangeMin[c]) / track.rangeExtent[c] : 0.0f;
+                            words[c] = static_cast<uint16_t>(std::lround(normalized * QUANTIZE_16));
+                        }
+                    }
+                    clip->m_keyValues.insert(clip->m_keyValues.end(), words, words + 3);
+                }
+            }
+        }
+        return clip;
+    }
+
+    size_t SkeletalClip::GetCompressedSize() const {
+        return m_tracks.size() * sizeof(Track) + (m_keyFrames.size() + m_keyValues.size()) * sizeof(uint16_t);
+    }
+
+    void SkeletalClip::Sample(float time, SkeletalSampleContext& context, Pose& out) const {
+        if (out.GetBoneCount() != m_boneCount) {
+            out.Resize(m_boneCount);
+        }
+        if (context.keyA.GetBoneCount() != m_boneCount) {
+            context.keyA.Resize(m_boneCount);
+            context.keyB.Resize(m_boneCount);
+        }
+        const uint32_t stride = out.GetStride();
+        context.weights.resize(static_cast<size_t>(stride) * TRACK_KIND_COUNT);
+
+        const float frame = std::min(std::max(time * m_sampleRate, 0.0f), static_cast<float>(m_frameCount - 1));
+        const uint16_t wholeFrame = static_cast<uint16_t>(frame);
+
+        // Распаковка двух ключей вокруг frame; интерполяция - одним
+        // SIMD-проходом BlendPoses по весам ключей
+        float* channelsA[TRACK_KIND_COUNT][4] = {
+            { context.keyA.Channel(POSE_TRANSLATION_X), context.keyA.Channel(POSE_TRANSLATION_Y), context.keyA.Channel(POSE_TRANSLATION_Z), nullptr },
+            { context.keyA.Channel(POSE_ROTATION_X), context.keyA.Channel(POSE_ROTATION_Y), context.keyA.Channel(POSE_ROTATION_Z), context.keyA.Channel(POSE_ROTATION_W) },
+            { context.keyA.Channel(POSE_SCALE_X), context.keyA.Channel(POSE_SCALE_Y), context.keyA.Channel(POSE_SCALE_Z), nullptr }
+        };
+        float* channelsB[TRACK_KIND_COUNT][4] = {
+            { context.keyB.Channel(POSE_TRANSLATION_X), context.keyB.Channel(POSE_TRANSLATION_Y), context.keyB.Channel(POSE_TRANSLATION_Z), nullptr },
+            { context.keyB.Channel(POSE_ROTATION_X), context.keyB.Channel(POSE_ROTATION_Y), context.keyB.Channel(POSE_ROTATION_Z), context.keyB.Channel(POSE_ROTATION_W) },
+            { context.keyB.Channel(POSE_SCALE_X), context.keyB.Channel(POSE_SCALE_Y), context.keyB.Channel(POSE_SCALE_Z), nullptr }
+        };
+
+        for (uint32_t bone = 0; bone < m_boneCount; ++bone) {
+            for (int kind = 0; kind < TRACK_KIND_COUNT; ++kind) {
+                const Track& track = m_tracks[static_cast<size_t>(bone) * TRACK_KIND_COUNT + kind];
+                const uint16_t* frames = m_keyFrames.data() + track.firstKey;
+
+                uint32_t first = 0;
+                float weight = 0.0f;
+                if (track.keyCount > 1) {
+                    // Последний ключ не позже wholeFrame
+                    first = static_cast<uint32_t>(std::upper_bound(frames, frames + track.keyCount, wholeFrame) - frames);
+                    first = std::min(first > 0 ? first - 1 : 0, track.keyCount - 2);
+                    float span = static_cast<float>(frames[first + 1] - frames[first]);
+                    weight = std::min(std::max((frame - frames[first]) / span, 0.0f), 1.0f);
+                }
+                const uint32_t second = track.keyCount > 1 ? first + 1 : first;
+                const uint16_t* wordsA = m_keyValues.data() + static_cast<size_t>(track.firstKey + first) * 3;
+                const uint16_t* wordsB = m_keyValues.data() + static_cast<size_t>(track.firstKey + second) * 3;
+
+                if (kind == TRACK_ROTATION) {
+                    float qa[4];
+                    float qb[4];
+                    DecodeRotation(wordsA, qa);
+                    DecodeRotation(wordsB, qb);
+                    for (int c = 0; c < 4; ++c) {
+                        channelsA[kind][c][bone] = qa[c];
+                        channelsB[kind][c][bone] = qb[c];
+                    }
+                } else {
+                    for (int c = 0; c < 3; ++c) {
+                        const float scale = track.rangeExtent[c] / QUANTIZE_16;
+                        channelsA[kind][c][bone] = track.rangeMin[c] + wordsA[c] * scale;
+                        channelsB[kind][c][bone] = track.rangeMin[c] + wordsB[c] * scale;
+                    }
+                }
+                context.weights[static_cast<size_t>(kind) * stride + bone] = weight;
+            }
+        }
+
+        const float* weights = context.weights.data();
+        BlendPoses(context.keyA, context.keyB, weights + TRACK_TRANSLATION * stride,
+                   weights + TRACK_ROTATION * stride, weights + TRACK_SCALE * stride, out);
+    }
+}
@@ -0,0 +1,452 @@
+#include "FastEngine/Animation/Skeleton.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FASTENGINE_ANIMATION_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define FASTENGINE_ANIMATION_NEON 1
+#endif
+
+namespace FastEngine {
+    namespace {
+        // Четыре float за операцию: SSE2, NEON или скалярная запасная ветка
+#if defined(FASTENGINE_ANIMATION_SSE2)
+        using Float4 = __m128;
+        inline Float4 Load4(const float* p) { return _mm_loadu_ps(p); }
+        inline void Store4(float* p, Float4 v) { _mm_storeu_ps(p, v); }
+        inline Float4 Splat4(float s) { return _mm_set1_ps(s); }
+        inline Float4 Add4(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+        inline Float4 Sub4(Float4 a, Float4 b) { return _mm_sub_ps(a, b); }
+        inline Float4 Mul4(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+        inline Float4 MulAdd4(Float4 a, Float4 b, Float4 c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+        // Знак v меняется там, где sign отрицателен
+        inline Float4 FlipSign4(Float4 v, Float4 sign) { return _mm_xor_ps(v, _mm_and_ps(sign, _mm_set1_ps(-0.0f))); }
+        inline Float4 InverseSqrt4(Float4 v) {
+            // Оценка rsqrt и шаг Ньютона: точность ~1e-7
+            Float4 y = _mm_rsqrt_ps(v);
+            Float4 halfV = _mm_mul_ps(v, _mm_set1_ps(0.5f));
+            return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(halfV, _mm_mul_ps(y, y))));
+        }
+#elif defined(FASTENGINE_ANIMATION_NEON)
+        using Float4 = float32x4_t;
+        inline Float4 Load4(const float* p) { return vld1q_f32(p); }
+        inline void Store4(float* p, Float4 v) { vst1q_f32(p, v); }
+        inline Float4 Splat4(float s) { return vdupq_n_f32(s); }
+        inline Float4 Add4(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+        inline Float4 Sub4(Float4 a, Float4 b) { return vsubq_f32(a, b); }
+        inline Float4 Mul4(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+        inline Float4 MulAdd4(Float4 a, Float4 b, Float4 c) { return vmlaq_f32(c, a, b); }
+        inline Float4 FlipSign4(Float4 v, Float4 sign) {
+            uint32x4_t mask = vandq_u32(vreinterpretq_u32_f32(sign), vdupq_n_u32(0x80000000u));
+            return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(v), mask));
+        }
+        inline Float4 InverseSqrt4(Float4 v) {
+            Float4 y = vrsqrteq_f32(v);
+            y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(v, y), y));
+            return vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(v, y), y));
+        }
+#else
+        struct Float4 {
+            float v[4];
+        };
+        inline Float4 Load4(const float* p) { return Float4{{p[0], p[1], p[2], p[3]}}; }
+        inline void Store4(float* p, Float4 a) { std::copy(a.v, a.v + 4, p); }
+        inline Float4 Splat4(float s) { return Float4{{s, s, s, s}}; }
+        template<typename Op>
+        inline Float4 Map4(Float4 a, Float4 b, Op op) {
+            return Float4{{op(a.v[0], b.v[0]), op(a.v[1], b.v[1]), op(a.v[2], b.v[2]), op(a.v[3], b.v[3])}};
+        }
+        inline Float4 Add4(Float4 a, Float4 b) { return Map4(a, b, [](float x, float y) { return x + y; }); }
+        inline Float4 Sub4(Float4 a, Float4 b) { return Map4(a, b, [](float x, float y) { return x - y; }); }
+        inline Float4 Mul4(Float4 a, Float4 b) { return Map4(a, b, [](float x, float y) { return x * y; }); }
+        inline Float4 MulAdd4(Float4 a, Float4 b, Float4 c) { return Add4(Mul4(a, b), c); }
+        inline Float4 FlipSign4(Float4 v, Float4 sign) {
+            return Map4(v, sign, [](float x, float s) { return std::signbit(s) ? -x : x; });
+        }
+        inline Float4 InverseSqrt4(Float4 a) {
+            return Float4{{1.0f / std::sqrt(a.v[0]), 1.0f / std::sqrt(a.v[1]), 1.0f / std::sqrt(a.v[2]), 1.0f / std::sqrt(a.v[3])}};
+        }
+#endif
+
+        // Веса смешивания: одно число на всю позу или массивы по костям
+        struct UniformWeights {
+            Float4 weight;
+            Float4 Translation(uint32_t) const { return weight; }
+            Float4 Rotation(uint32_t) const { return weight; }
+            Float4 Scale(uint32_t) const { return weight; }
+        };
+
+        struct BoneWeights {
+            const float* translation;
+            const float* rotation;
+            const float* scale;
+            Float4 Translation(uint32_t i) const { return Load4(translation + i); }
+            Float4 Rotation(uint32_t i) const { return Load4(rotation + i); }
+            Float4 Scale(uint32_t i) const { return Load4(scale + i); }
+        };
+
+        template<typename Weights>
+        void BlendKernel(const Pose& a, const Pose& b, const Weights& weights, Pose& out) {
+            const uint32_t stride = out.GetStride();
+            const float* ta[3] = { a.Channel(POSE_TRANSLATION_X), a.Channel(POSE_TRANSLATION_Y), a.Channel(POSE_TRANSLATION_Z) };
+            const float* tb[3] = { b.Channel(POSE_TRANSLATION_X), b.Channel(POSE_TRANSLATION_Y), b.Channel(POSE_TRANSLATION_Z) };
+            float* to[3] = { out.Channel(POSE_TRANSLATION_X), out.Channel(POSE_TRANSLATION_Y), out.Channel(POSE_TRANSLATION_Z) };
+            const float* sa[3] = { a.Channel(POSE_SCALE_X), a.Channel(POSE_SCALE_Y), a.Channel(POSE_SCALE_Z) };
+            const float* sb[3] = { b.Channel(POSE_SCALE_X), b.Channel(POSE_SCALE_Y), b.Channel(POSE_SCALE_Z) };
+            float* so[3] = { out.Channel(POSE_SCALE_X), out.Channel(POSE_SCALE_Y), out.Channel(POSE_SCALE_Z) };
+            const float* ra[4] = { a.Channel(POSE_ROTATION_X), a.Channel(POSE_ROTATION_Y), a.Channel(POSE_ROTATION_Z), a.Channel(POSE_ROTATION_W) };
+            const float* rb[4] = { b.Channel(POSE_ROTATION_X), b.Channel(POSE_ROTATION_Y), b.Channel(POSE_ROTATION_Z), b.Channel(POSE_ROTATION_W) };
+            float* ro[4] = { out.Channel(POSE_ROTATION_X), out.Channel(POSE_ROTATION_Y), out.Channel(POSE_ROTATION_Z), out.Channel(POSE_ROTATION_W) };
+
+            for (uint32_t i = 0; i < stride; i += Pose::LANES) {
+                const Float4 wt = weights.Translation(i);
+                const Float4 ws = weights.Scale(i);
+                for (int c = 0; c < 3; ++c) {
+                    Float4 t0 = Load4(ta[c] + i);
+                    Store4(to[c] + i, MulAdd4(Sub4(Load4(tb[c] + i), t0), wt, t0));
+                    Float4 s0 = Load4(sa[c] + i);
+                    Store4(so[c] + i, MulAdd4(Sub4(Load4(sb[c] + i), s0), ws, s0));
+                }
+
+                // Кватернионы q и -q - один поворот: b берется в полусфере a
+                Float4 qa[4];
+                Float4 qb[4];
+                for (int c = 0; c < 4; ++c) {
+                    qa[c] = Load4(ra[c] + i);
+                    qb[c] = Load4(rb[c] + i);
+                }
+                Float4 dot = Mul4(qa[0], qb[0]);
+                dot = MulAdd4(qa[1], qb[1], dot);
+                dot = MulAdd4(qa[2], qb[2], dot);
+                dot = MulAdd4(qa[3], qb[3], dot);
+
+                const Float4 wr = weights.Rotation(i);
+                Float4 q[4];
+                Float4 lengthSquared = Splat4(0.0f);
+                for (int c = 0; c < 4; ++c) {
+                    q[c] = MulAdd4(Sub4(FlipSign4(qb[c], dot), qa[c]), wr, qa[c]);
+                    lengthSquared = MulAdd4(q[c], q[c], lengthSquared);
+                }
+                const Float4 inverseLength = InverseSqrt4(lengthSquared);
+                for (int c = 0; c < 4; ++c) {
+                    Store4(ro[c] + i, Mul4(q[c], inverseLength));
+                }
+            }
+        }
+
+        // Столбцы column четырех матриц из SoA-векторов x, y, z, w
+        inline void StoreColumn(BoneMatrix* const* matrices, int column, Float4 x, Float4 y, Float4 z, Float4 w) {
+#if defined(FASTENGINE_ANIMATION_SSE2)
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+            _mm_store_ps(matrices[0]->m + column * 4, x);
+            _mm_store_ps(matrices[1]->m + column * 4, y);
+            _mm_store_ps(matrices[2]->m + column * 4, z);
+            _mm_store_ps(matrices[3]->m + column * 4, w);
+#else
+            float lanes[4][4];
+            Store4(lanes[0], x);
+            Store4(lanes[1], y);
+            Store4(lanes[2], z);
+            Store4(lanes[3], w);
+            for (int k = 0; k < 4; ++k) {
+                float* dst = matrices[k]->m + column * 4;
+                dst[0] = lanes[0][k];
+                dst[1] = lanes[1][k];
+                dst[2] = lanes[2][k];
+                dst[3] = lanes[3][k];
+            }
+#endif
+        }
+
+        // Обратная аффинная матрица (последняя строка 0 0 0 1)
+        BoneMatrix AffineInverse(const BoneMatrix& matrix) {
+            const float* m = matrix.m;
+            const float c00 = m[5] * m[10] - m[9] * m[6];
+            const float c01 = m[9] * m[2] - m[1] * m[10];
+            const float c02 = m[1] * m[6] - m[5] * m[2];
+            const float det = m[0] * c00 + m[4] * c01 + m[8] * c02;
+            BoneMatrix result = BoneMatrix::Identity();
+            if (std::fabs(det) < 1e-12f) {
+                return result;
+            }
+            const float inv = 1.0f / det;
+            float* r = result.m;
+            r[0] = c00 * inv;
+            r[1] = c01 * inv;
+            r[2] = c02 * inv;
+            r[4] = (m[8] * m[6] - m[4] * m[10]) * inv;
+            r[5] = (m[0] * m[10] - m[8] * m[2]) * inv;
+            r[6] = (m[4] * m[2] - m[0] * m[6]) * inv;
+            r[8] = (m[4] * m[9] - m[8] * m[5]) * inv;
+            r[9] = (m[8] * m[1] - m[0] * m[9]) * inv;
+            r[10] = (m[0] * m[5] - m[4] * m[1]) * inv;
+            r[12] = -(r[0] * m[12] + r[4] * m[13] + r[8] * m[14]);
+            r[13] = -(r[1] * m[12] + r[5] * m[13] + r[9] * m[14]);
+            r[14] = -(r[2] * m[12] + r[6] * m[13] + r[10] * m[14]);
+            return result;
+        }
+    }
+
+    BoneMatrix BoneMatrix::Identity() {
+        BoneMatrix result;
+        std::fill(result.m, result.m + 16, 0.0f);
+        result.m[0] = result.m[5] = result.m[10] = result.m[15] = 1.0f;
+        return result;
+    }
+
+    BoneMatrix BoneMatrix::FromTransform(const BoneTransform& transform) {
+        glm::vec4 q = transform.rotation;
+        float length = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+        if (length > 0.0f) {
+            q = q * (1.0f / length);
+        } else {
+            q = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        }
+        const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+        const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+        const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+        const glm::vec3& s = transform.scale;
+
+        BoneMatrix result;
+        float* m = result.m;
+        m[0] = (1.0f - 2.0f * (yy + zz)) * s.x;
+        m[1] = 2.0f * (xy + wz) * s.x;
+        m[2] = 2.0f * (xz - wy) * s.x;
+        m[3] = 0.0f;
+        m[4] = 2.0f * (xy - wz) * s.y;
+        m[5] = (1.0f - 2.0f * (xx + zz)) * s.y;
+        m[6] = 2.0f * (yz + wx) * s.y;
+        m[7] = 0.0f;
+        m[8] = 2.0f * (xz + wy) * s.z;
+        m[9] = 2.0f * (yz - wx) * s.z;
+        m[10] = (1.0f - 2.0f * (xx + yy)) * s.z;
+        m[11] = 0.0f;
+        m[12] = transform.translation.x;
+        m[13] = transform.translation.y;
+        m[14] = transform.translation.z;
+        m[15] = 1.0f;
+        return result;
+    }
+
+    glm::vec3 BoneMatrix::TransformPoint(const glm::vec3& p) const {
+        return glm::vec3(m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12],
+                         m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13],
+                         m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14]);
+    }
+
+    void MultiplyBoneMatrices(const BoneMatrix& a, const BoneMatrix& b, BoneMatrix& result) {
+        const Float4 a0 = Load4(a.m);
+        const Float4 a1 = Load4(a.m + 4);
+        const Float4 a2 = Load4(a.m + 8);
+        const Float4 a3 = Load4(a.m + 12);
+        Float4 columns[4];
+        for (int j = 0; j < 4; ++j) {
+            const float* bj = b.m + j * 4;
+            Float4 c = Mul4(a0, Splat4(bj[0]));
+            c = MulAdd4(a1, Splat4(bj[1]), c);
+            c = MulAdd4(a2, Splat4(bj[2]), c);
+            columns[j] = MulAdd4(a3, Splat4(bj[3]), c);
+        }
+        for (int j = 0; j < 4; ++j) {
+            Store4(result.m + j * 4, columns[j]);
+        }
+    }
+
+    int Skeleton::AddBone(const std::string& name, int parent, const BoneTransform& bindLocal) {
+        const int index = static_cast<int>(m_parents.size());
+        if (parent < NO_PARENT || parent >= index) {
+            std::cerr << "Skeleton: parent of bone '" << name << "' must be added first" << std::endl;
+            return -1;
+        }
+        if (m_parents.size() >= MAX_BONES) {
+            std::cerr << "Skeleton: too many bones" << std::endl;
+            return -1;
+        }
+
+        BoneMatrix model = BoneMatrix::FromTransform(bindLocal);
+        if (parent != NO_PARENT) {
+            MultiplyBoneMatrices(m_bindModel[parent], model, model);
+        }
+        m_names.push_back(name);
+        m_parents.push_back(static_cast<int16_t>(parent));
+        m_bindLocal.push_back(bindLocal);
+        m_bindModel.push_back(model);
+        m_inverseBind.push_back(AffineInverse(model));
+        return index;
+    }
+
+    int Skeleton::FindBone(const std::string& name) const {
+        auto it = std::find(m_names.begin(), m_names.end(), name);
+        return it != m_names.end() ? static_cast<int>(it - m_names.begin()) : -1;
+    }
+
+    Pose::Pose(uint32_t boneCount)
+        : m_boneCount(0)
+        , m_stride(0) {
+        Resize(boneCount);
+    }
+
+    void Pose::Resize(uint32_t boneCount) {
+        m_boneCount = boneCount;
+        m_stride = (boneCount + LANES - 1) / LANES * LANES;
+        m_data.assign(static_cast<size_t>(m_stride) * POSE_CHANNEL_COUNT, 0.0f);
+        std::fill(Channel(POSE_ROTATION_W), Channel(POSE_ROTATION_W) + m_stride, 1.0f);
+        std::fill(Channel(POSE_SCALE_X), Channel(POSE_SCALE_X) + m_stride * 3, 1.0f);
+    }
+
+    void Pose::SetBind(const Skeleton& skeleton) {
+        if (m_boneCount != skeleton.GetBoneCount()) {
+            Resize(skeleton.GetBoneCount());
+        }
+        for (uint32_t bone = 0; bone < m_boneCount; ++bone) {
+            SetBone(bone, skeleton.GetBindLocal(bone));
+        }
+    }
+
+    BoneTransform Pose::GetBone(uint32_t bone) const {
+        BoneTransform transform;
+        transform.translation = glm::vec3(Channel(POSE_TRANSLATION_X)[bone], Channel(POSE_TRANSLATION_Y)[bone],
+                                          Channel(POSE_TRANSLATION_Z)[bone]);
+        transform.rotation = glm::vec4(Channel(POSE_ROTATION_X)[bone], Channel(POSE_ROTATION_Y)[bone],
+                                       Channel(POSE_ROTATION_Z)[bone], Channel(POSE_ROTATION_W)[bone]);
+        transform.scale = glm::vec3(Channel(POSE_SCALE_X)[bone], Channel(POSE_SCALE_Y)[bone], Channel(POSE_SCALE_Z)[bone]);
+        return transform;
+    }
+
+    void Pose::SetBone(uint32_t bone, const BoneTransform& transform) {
+        Channel(POSE_TRANSLATION_X)[bone] = transform.translation.x;
+        Channel(POSE_TRANSLATION_Y)[bone] = transform.translation.y;
+        Channel(POSE_TRANSLATION_Z)[bone] = transform.translation.z;
+        Channel(POSE_ROTATION_X)[bone] = transform.rotation.x;
+        Channel(POSE_ROTATION_Y)[bone] = transform.rotation.y;
+        Channel(POSE_ROTATION_Z)[bone] = transform.rotation.z;
+        Channel(POSE_ROTATION_W)[bone] = transform.rotation.w;
+        Channel(POSE_SCALE_X)[bone] = transform.scale.x;
+        Channel(POSE_SCALE_Y)[bone] = transform.scale.y;
+        Channel(POSE_SCALE_Z)[bone] = transform.scale.z;
+    }
+
+    void BlendPoses(const Pose& a, const Pose& b, float weight, Pose& out) {
+        if (out.GetBoneCount() != a.GetBoneCount()) {
+            out.Resize(a.GetBoneCount());
+        }
+        BlendKernel(a, b, UniformWeights{Splat4(weight)}, out);
+    }
+
+    void BlendPoses(const Pose& a, const Pose& b, const float* translationWeights,
+                    const float* rotationWeights, const float* scaleWeights, Pose& out) {
+        if (out.GetBoneCount() != a.GetBoneCount()) {
+            out.Resize(a.GetBoneCount());
+        }
+        BlendKernel(a, b, BoneWeights{translationWeights, rotationWeights, scaleWeights}, out);
+    }
+
+    void LocalToModel(const Skeleton& skeleton, const Pose& pose, BoneMatrix* model) {
+        const uint32_t boneCount = std::min(skeleton.GetBoneCount(), pose.GetBoneCount());
+        const float* tx = pose.Channel(POSE_TRANSLATION_X);
+        const float* ty = pose.Channel(POSE_TRANSLATION_Y);
+        const float* tz = pose.Channel(POSE_TRANSLATION_Z);
+        const float* rx = pose.Channel(POSE_ROTATION_X);
+        const float* ry = pose.Channel(POSE_ROTATION_Y);
+        const float* rz = pose.Channel(POSE_ROTATION_Z);
+        const float* rw = pose.Channel(POSE_ROTATION_W);
+        const float* sx = pose.Channel(POSE_SCALE_X);
+        const float* sy = pose.Channel(POSE_SCALE_Y);
+        const float* sz = pose.Channel(POSE_SCALE_Z);
+
+        // Локальные матрицы по четыре кости: кватернион -> поворот * масштаб
+        const Float4 one = Splat4(1.0f);
+        const Float4 two = Splat4(2.0f);
+        const Float4 zero = Splat4(0.0f);
+        BoneMatrix tail[Pose::LANES];
+        for (uint32_t i = 0; i < boneCount; i += Pose::LANES) {
+            BoneMatrix* matrices[Pose::LANES];
+            for (uint32_t k = 0; k < Pose::LANES; ++k) {
+                matrices[k] = i + k < boneCount ? model + i + k : tail + k;
+            }
+
+            const Float4 x = Load4(rx + i), y = Load4(ry + i), z = Load4(rz + i), w = Load4(rw + i);
+            const Float4 x2 = Mul4(x, two), y2 = Mul4(y, two), z2 = Mul4(z, two);
+            const Float4 xx = Mul4(x, x2), yy = Mul4(y, y2), zz = Mul4(z, z2);
+            const Float4 xy = Mul4(x, y2), xz = Mul4(x, z2), yz = Mul4(y, z2);
+            const Float4 wx = Mul4(w, x2), wy = Mul4(w, y2), wz = Mul4(w, z2);
+            const Float4 scaleX = Load4(sx + i), scaleY = Load4(sy + i), scaleZ = Load4(sz + i);
+
+            StoreColumn(matrices, 0, Mul4(Sub4(one, Add4(yy, zz)), scaleX), Mul4(Add4(xy, wz), scaleX),
+                        Mul4(Sub4(xz, wy), scaleX), zero);
+            StoreColumn(matrices, 1, Mul4(Sub4(xy, wz), scaleY), Mul4(Sub4(one, Add4(xx, zz)), scaleY),
+                        Mul4(Add4(yz, wx), scaleY), zero);
+            StoreColumn(matrices, 2, Mul4(Add4(xz, wy), scaleZ), Mul4(Sub4(yz, wx), scaleZ),
+                        Mul4(Sub4(one, Add4(xx, yy)), scaleZ), zero);
+            StoreColumn(matrices, 3, Load4(tx + i), Load4(ty + i), Load4(tz + i), one);
+        }
+
+        // Иерархия: родитель уже в модельном пространстве
+        const std::vector<int16_t>& parents = skeleton.GetParents();
+        for (uint32_t bone = 0; bone < boneCount; ++bone) {
+            const int parent = parents[bone];
+            if (parent != Skeleton::NO_PARENT) {
+                MultiplyBoneMatrices(model[parent], model[bone], model[bone]);
+            }
+        }
+    }
+
+    void ComputeSkinningMatrices(const Skeleton& skeleton, const BoneMatrix* model, BoneMatrix* skinning) {
+        const std::vector<BoneMatrix>& inverseBind = skeleton.GetInverseBindMatrices();
+        for (uint32_t bone = 0; bone < skeleton.GetBoneCount(); ++bone) {
+            MultiplyBoneMatrices(model[bone], inverseBind[bone], skinning[bone]);
+        }
+    }
+
+    void SkinVertices(const SkinnedMeshData& mesh, const BoneMatrix* skinning,
+                      std::vector<glm::vec3>& positions, std::vector<glm::vec3>& normals) {
+        const uint32_t vertexCount = mesh.GetVertexCount();
+        const bool hasNormals = mesh.normals.size() == vertexCount;
+        positions.resize(vertexCount);
+        normals.resize(hasNormals ? vertexCount : 0);
+
+        float result[4];
+        for (uint32_t v = 0; v < vertexCount; ++v) {
+            // Матрица вершины - взвешенная сумма матриц ее костей
+            const uint16_t* indices = mesh.boneIndices.data() + v * SkinnedMeshData::MAX_INFLUENCES;
+            const float* weights = mesh.boneWeights.data() + v * SkinnedMeshData::MAX_INFLUENCES;
+            Float4 columns[4];
+            {
+                const Float4 weight = Splat4(weights[0]);
+                const float* m = skinning[indices[0]].m;
+                for (int c = 0; c < 4; ++c) {
+                    columns[c] = Mul4(Load4(m + c * 4), weight);
+                }
+            }
+            for (uint32_t k = 1; k < SkinnedMeshData::MAX_INFLUENCES; ++k) {
+                const Float4 weight = Splat4(weights[k]);
+                const float* m = skinning[indices[k]].m;
+                for (int c = 0; c < 4; ++c) {
+                    columns[c] = MulAdd4(Load4(m + c * 4), weight, columns[c]);
+                }
+            }
+
+            const glm::vec3& p = mesh.positions[v];
+            Float4 position = MulAdd4(columns[0], Splat4(p.x), columns[3]);
+            position = MulAdd4(columns[1], Splat4(p.y), position);
+            position = MulAdd4(columns[2], Splat4(p.z), position);
+            Store4(result, position);
+            positions[v] = glm::vec3(result[0], result[1], result[2]);
+
+            if (hasNormals) {
+                const glm::vec3& n = mesh.normals[v];
+                Float4 normal = Mul4(columns[0], Splat4(n.x));
+                normal = MulAdd4(columns[1], Splat4(n.y), normal);
+                normal = MulAdd4(columns[2], Splat4(n.z), normal);
+                Store4(result, normal);
+                const float length = std::sqrt(result[0] * result[0] + result[1] * result[1] + result[2] * result[2]);
+                const float inverse = length > 0.0f ? 1.0f / length : 0.0f;
+                normals[v] = glm::vec3(result[0] * inverse, result[1] * inverse, result[2] * inverse);
+            }
+        }
+    }
+}
@@ -0,0 +1,85 @@
+#include "FastEngine/Audio/AudioClipCache.h"
+#include "FastEngine/Audio/AudioCodec.h"
+
+namespace FastEngine {
+    AudioClipCache& AudioClipCache::GetInstance() {
+        static AudioClipCache instance;
+        return instance;
+    }
+
+    AudioClipPtr AudioClipCache::Load(const std::string& filePath) {
+        // Декодирование под блокировкой: параллельные загрузки одного файла не дублируются
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_clips.find(filePath);
+        if (it != m_clips.end()) {
+            AudioClipPtr clip = it->second.lock();
+            if (clip) {
+                ++m_hitCount;
+                return clip;
+            }
+        }
+
+        AudioClipPtr clip = DecodeAudioFile(filePath);
+        if (!clip) {
+            return nullptr;
+        }
+        ++m_decodeCount;
+        m_clips[filePath] = clip;
+        return clip;
+    }
+
+    AudioClipPtr AudioClipCache::Find(const std::string& filePath) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_clips.find(filePath);
+        return it != m_clips.end() ? it->second.lock() : nullptr;
+    }
+
+    long AudioClipCache::GetReferenceCount(const std::string& filePath) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_clips.find(filePath);
+        return it != m_clips.end() ? it->second.use_count() : 0;
+    }
+
+    size_t AudioClipCache::GetClipCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        size_t count = 0;
+        for (const auto& pair : m_clips) {
+            if (!pair.second.expired()) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    size_t AudioClipCache::GetMemoryUsage() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        size_t bytes = 0;
+        for (const auto& pair : m_clips) {
+            if (AudioClipPtr clip = pair.second.lock()) {
+                bytes += clip->GetMemorySize();
+            }
+        }
+        return bytes;
+    }
+
+    uint64_t AudioClipCache::GetDecodeCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_decodeCount;
+    }
+
+    uint64_t AudioClipCache::GetHitCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_hitCount;
+    }
+
+    void AudioClipCache::Purge() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_clips.begin(); it != m_clips.end();) {
+            if (it->second.expired()) {
+                it = m_clips.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
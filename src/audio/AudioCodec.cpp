@@ -0,0 +1,480 @@
+#include "FastEngine/Audio/AudioCodec.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace FastEngine {
+    namespace {
+        const uint16_t WAVE_FORMAT_PCM = 0x0001;
+        const uint16_t WAVE_FORMAT_IMA_ADPCM = 0x0011;
+        const uint16_t WAVE_FORMAT_IEEE_FLOAT = 0x0003;
+        const uint16_t WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+        // WAVE_FORMAT_EXTENSIBLE занимает 40 байт; больше - испорченный заголовок
+        const uint32_t MAX_FMT_CHUNK_SIZE = 1024;
+
+        const int16_t IMA_STEP_TABLE[89] = {
+            7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+            50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+            253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+            1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+            3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442,
+            11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+        };
+        const int8_t IMA_INDEX_TABLE[8] = { -1, -1, -1, -1, 2, 4, 6, 8 };
+
+        uint16_t ReadU16(const uint8_t* data) {
+            return static_cast<uint16_t>(data[0] | data[1] << 8);
+        }
+
+        uint32_t ReadU32(const uint8_t* data) {
+            return static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8 |
+                   static_cast<uint32_t>(data[2]) << 16 | static_cast<uint32_t>(data[3]) << 24;
+        }
+
+        void AppendU16(std::vector<uint8_t>& out, uint16_t value) {
+            out.push_back(static_cast<uint8_t>(value));
+            out.push_back(static_cast<uint8_t>(value >> 8));
+        }
+
+        void AppendU32(std::vector<uint8_t>& out, uint32_t value) {
+            for (int i = 0; i < 4; ++i) {
+                out.push_back(static_cast<uint8_t>(value >> (i * 8)));
+            }
+        }
+
+        void AppendTag(std::vector<uint8_t>& out, const char* tag) {
+            out.insert(out.end(), tag, tag + 4);
+        }
+
+        // Состояние канала IMA ADPCM; кодер и декодер обновляют его одинаково
+        struct ImaChannel {
+            int predictor;
+            int index;
+
+            ImaChannel() : predictor(0), index(0) {}
+
+            int Decode(uint8_t nibble) {
+                int step = IMA_STEP_TABLE[index];
+                int diff = step >> 3;
+                if (nibble & 1) diff += step >> 2;
+                if (nibble & 2) diff += step >> 1;
+                if (nibble & 4) diff += step;
+                if (nibble & 8) diff = -diff;
+                predictor = std::clamp(predictor + diff, -32768, 32767);
+                index = std::clamp(index + IMA_INDEX_TABLE[nibble & 7], 0, 88);
+                return predictor;
+            }
+
+            uint8_t Encode(int sample) {
+                int diff = sample - predictor;
+                uint8_t nibble = 0;
+                if (diff < 0) {
+                    nibble = 8;
+                    diff = -diff;
+                }
+                int step = IMA_STEP_TABLE[index];
+                for (uint8_t mask = 4; mask > 0; mask >>= 1) {
+                    if (diff >= step) {
+                        nibble |= mask;
+                        diff -= step;
+                    }
+                    step >>= 1;
+                }
+                Decode(nibble);
+                return nibble;
+            }
+        };
+
+        int16_t ToPcm16(float sample) {
+            return static_cast<int16_t>(std::lround(std::clamp(sample, -1.0f, 1.0f) * 32767.0f));
+        }
+
+        std::vector<uint8_t> MakeHeader(uint16_t format, const AudioClip& clip, uint32_t byteRate, uint16_t blockAlign,
+                                        uint16_t bits, const std::vector<uint8_t>& extra, uint32_t dataSize, bool fact) {
+            std::vector<uint8_t> header;
+            uint32_t fmtSize = 16 + (extra.empty() ? 0 : 2 + static_cast<uint32_t>(extra.size()));
+            uint32_t riffSize = 4 + 8 + fmtSize + (fact ? 12 : 0) + 8 + dataSize + (dataSize & 1);
+            AppendTag(header, "RIFF");
+            AppendU32(header, riffSize);
+            AppendTag(header, "WAVE");
+            AppendTag(header, "fmt ");
+            AppendU32(header, fmtSize);
+            AppendU16(header, format);
+            AppendU16(header, static_cast<uint16_t>(clip.channels));
+            AppendU32(header, clip.sampleRate);
+            AppendU32(header, byteRate);
+            AppendU16(header, blockAlign);
+            AppendU16(header, bits);
+            if (!extra.empty()) {
+                AppendU16(header, static_cast<uint16_t>(extra.size()));
+                header.insert(header.end(), extra.begin(), extra.end());
+            }
+            if (fact) {
+                AppendTag(header, "fact");
+                AppendU32(header, 4);
+                AppendU32(header, clip.frameCount);
+            }
+            AppendTag(header, "data");
+            AppendU32(header, dataSize);
+            return header;
+        }
+
+        bool WriteFile(const std::string& filePath, const std::vector<uint8_t>& header, const std::vector<uint8_t>& data) {
+            std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                std::cerr << "AudioEncoder: Failed to open " << filePath << std::endl;
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(header.data()), header.size());
+            file.write(reinterpret_cast<const char*>(data.data()), data.size());
+            if (data.size() & 1) {
+                file.put(0);
+            }
+            return file.good();
+        }
+    }
+
+    std::unique_ptr<AudioDecoder> AudioDecoder::Open(const std::string& filePath) {
+        auto decoder = std::make_unique<WavDecoder>();
+        if (!decoder->Open(filePath)) {
+            return nullptr;
+        }
+        return decoder;
+    }
+
+    WavDecoder::WavDecoder()
+        : m_encoding(AudioEncoding::Pcm)
+        , m_channels(0)
+        , m_sampleRate(0)
+        , m_bitsPerSample(0)
+        , m_blockAlign(0)
+        , m_framesPerBlock(1)
+        , m_frameCount(0)
+        , m_dataOffset(0)
+        , m_dataSize(0)
+        , m_position(0)
+        , m_blockIndex(UINT32_MAX)
+        , m_blockFrames(0) {
+    }
+
+    bool WavDecoder::Open(const std::string& filePath) {
+        m_file.open(filePath, std::ios::binary);
+        if (!m_file.is_open()) {
+            std::cerr << "WavDecoder: Failed to open " << filePath << std::endl;
+            return false;
+        }
+
+        uint8_t riff[12];
+        if (!m_file.read(reinterpret_cast<char*>(riff), sizeof(riff)) ||
+            std::memcmp(riff, "RIFF", 4) != 0 || std::memcmp(riff + 8, "WAVE", 4) != 0) {
+            std::cerr << "WavDecoder: Unsupported format " << filePath << std::endl;
+            return false;
+        }
+
+        // Чанки до data: fmt обязателен, fact дает точную длину ADPCM
+        uint16_t format = 0;
+        uint32_t factFrames = 0;
+        bool hasFormat = false;
+        bool hasFact = false;
+        uint8_t chunk[8];
+        while (m_file.read(reinterpret_cast<char*>(chunk), sizeof(chunk))) {
+            uint32_t size = ReadU32(chunk + 4);
+            if (std::memcmp(chunk, "fmt ", 4) == 0) {
+                if (size < 16 || size > MAX_FMT_CHUNK_SIZE) {
+                    break;
+                }
+                std::vector<uint8_t> fmt(size);
+                if (!m_file.read(reinterpret_cast<char*>(fmt.data()), size)) {
+                    break;
+                }
+                format = ReadU16(fmt.data());
+                m_channels = ReadU16(fmt.data() + 2);
+                m_sampleRate = ReadU32(fmt.data() + 4);
+                m_blockAlign = ReadU16(fmt.data() + 12);
+                m_bitsPerSample = ReadU16(fmt.data() + 14);
+                if (format == WAVE_FORMAT_EXTENSIBLE && size >= 26) {
+                    format = ReadU16(fmt.data() + 24);
+                }
+                if (format == WAVE_FORMAT_IMA_ADPCM && size >= 20) {
+                    m_framesPerBlock = ReadU16(fmt.data() + 18);
+                }
+                hasFormat = true;
+                if (size & 1) {
+                    m_file.seekg(1, std::ios::cur);
+                }
+            } else if (std::memcmp(chunk, "fact", 4) == 0 && size >= 4) {
+                uint8_t fact[4];
+                m_file.read(reinterpret_cast<char*>(fact), 4);
+                factFrames = ReadU32(fact);
+                hasFact = true;
+                m_file.seekg(size - 4 + (size & 1), std::ios::cur);
+            } else if (std::memcmp(chunk, "data", 4) == 0) {
+                m_dataOffset = m_file.tellg();
+                m_dataSize = size;
+                break;
+            } else {
+                m_file.seekg(size + (size & 1), std::ios::cur);
+            }
+        }
+
+        if (!hasFormat || m_dataOffset == 0 || m_channels < 1 || m_channels > 2 || m_sampleRate == 0 || m_blockAlign == 0) {
+            std::cerr << "WavDecoder: Invalid or unsupported WAV " << filePath << std::endl;
+            return false;
+        }
+        // Обрезанный файл: данные до конца файла
+        m_file.seekg(0, std::ios::end);
+        std::streamoff available = m_file.tellg() - m_dataOffset;
+        m_dataSize = static_cast<uint32_t>(std::min<std::streamoff>(m_dataSize, std::max<std::streamoff>(available, 0)));
+
+        if (format == WAVE_FORMAT_PCM && (m_bitsPerSample == 8 || m_bitsPerSample == 16 ||
+                                          m_bitsPerSample == 24 || m_bitsPerSample == 32)) {
+            m_encoding = AudioEncoding::Pcm;
+        } else if (format == WAVE_FORMAT_IEEE_FLOAT && m_bitsPerSample == 32) {
+            m_encoding = AudioEncoding::Float;
+        } else if (format == WAVE_FORMAT_IMA_ADPCM && m_bitsPerSample == 4) {
+            m_encoding = AudioEncoding::ImaAdpcm;
+        } else {
+            std::cerr << "WavDecoder: Unsupported encoding " << format << " (" << m_bitsPerSample
+                      << " bit) in " << filePath << std::endl;
+            return false;
+        }
+
+        // ReadPcm читает кадры по m_blockAlign, а разбирает по размеру отсчета
+        if (m_encoding != AudioEncoding::ImaAdpcm && m_blockAlign != m_channels * (m_bitsPerSample / 8)) {
+            std::cerr << "WavDecoder: Block align " << m_blockAlign << " does not match " << m_channels
+                      << " x " << m_bitsPerSample << " bit in " << filePath << std::endl;
+            return false;
+        }
+
+        if (m_encoding == AudioEncoding::ImaAdpcm) {
+            uint32_t expected = (m_blockAlign - 4 * m_channels) * 2 / m_channels + 1;
+            if (m_blockAlign <= 4 * m_channels || m_framesPerBlock != expected) {
+                std::cerr << "WavDecoder: Invalid ADPCM block layout in " << filePath << std::endl;
+                return false;
+            }
+            uint32_t blocks = m_dataSize / m_blockAlign;
+            uint32_t tail = m_dataSize % m_blockAlign;
+            uint32_t frames = blocks * m_framesPerBlock;
+            if (tail > 4 * m_channels) {
+                frames += (tail - 4 * m_channels) * 2 / m_channels + 1;
+            }
+            m_frameCount = hasFact ? std::min(factFrames, frames) : frames;
+            m_block.resize(static_cast<size_t>(m_framesPerBlock) * m_channels);
+            m_raw.resize(m_blockAlign);
+        } else {
+            m_frameCount = m_dataSize / m_blockAlign;
+        }
+
+        m_file.clear();
+        m_position = 0;
+        return true;
+    }
+
+    uint32_t WavDecoder::Read(float* output, uint32_t frames) {
+        frames = std::min(frames, m_frameCount - std::min(m_position, m_frameCount));
+        if (frames == 0) {
+            return 0;
+        }
+        return m_encoding == AudioEncoding::ImaAdpcm ? ReadAdpcm(output, frames) : ReadPcm(output, frames);
+    }
+
+    bool WavDecoder::Seek(uint32_t frame) {
+        if (frame > m_frameCount) {
+            return false;
+        }
+        m_position = frame;
+        return true;
+    }
+
+    uint32_t WavDecoder::ReadPcm(float* output, uint32_t frames) {
+        m_raw.resize(static_cast<size_t>(frames) * m_blockAlign);
+        m_file.clear();
+        m_file.seekg(m_dataOffset + static_cast<std::streamoff>(m_position) * m_blockAlign);
+        m_file.read(reinterpret_cast<char*>(m_raw.data()), m_raw.size());
+        frames = static_cast<uint32_t>(m_file.gcount() / m_blockAlign);
+
+        const size_t samples = static_cast<size_t>(frames) * m_channels;
+        const uint8_t* raw = m_raw.data();
+        if (m_encoding == AudioEncoding::Float) {
+            std::memcpy(output, raw, samples * sizeof(float));
+        } else if (m_bitsPerSample == 8) {
+            for (size_t i = 0; i < samples; ++i) {
+                output[i] = (static_cast<int>(raw[i]) - 128) * (1.0f / 128.0f);
+            }
+        } else if (m_bitsPerSample == 16) {
+            for (size_t i = 0; i < samples; ++i) {
+                output[i] = static_cast<int16_t>(ReadU16(raw + i * 2)) * (1.0f / 32768.0f);
+            }
+        } else if (m_bitsPerSample == 24) {
+            for (size_t i = 0; i < samples; ++i) {
+                const uint8_t* sample = raw + i * 3;
+                int32_t value = static_cast<int32_t>(static_cast<uint32_t>(sample[0]) << 8 |
+                                                     static_cast<uint32_t>(sample[1]) << 16 |
+                                                     static_cast<uint32_t>(sample[2]) << 24) >> 8;
+                output[i] = value * (1.0f / 8388608.0f);
+            }
+        } else {
+            for (size_t i = 0; i < samples; ++i) {
+                output[i] = static_cast<int32_t>(ReadU32(raw + i * 4)) * (1.0f / 2147483648.0f);
+            }
+        }
+        m_position += frames;
+        return frames;
+    }
+
+    uint32_t WavDecoder::ReadAdpcm(float* output, uint32_t frames) {
+        uint32_t written = 0;
+        while (written < frames) {
+            uint32_t block = m_position / m_framesPerBlock;
+            if (block != m_blockIndex && !DecodeAdpcmBlock(block)) {
+                break;
+            }
+            uint32_t offset = m_position - block * m_framesPerBlock;
+            if (offset >= m_blockFrames) {
+                break;
+            }
+            uint32_t count = std::min(frames - written, m_blockFrames - offset);
+            std::memcpy(output + static_cast<size_t>(written) * m_channels,
+                        m_block.data() + static_cast<size_t>(offset) * m_channels,
+                        static_cast<size_t>(count) * m_channels * sizeof(float));
+            written += count;
+            m_position += count;
+        }
+        return written;
+    }
+
+    bool WavDecoder::DecodeAdpcmBlock(uint32_t block) {
+        uint64_t offset = static_cast<uint64_t>(block) * m_blockAlign;
+        if (offset >= m_dataSize) {
+            return false;
+        }
+        uint32_t size = static_cast<uint32_t>(std::min<uint64_t>(m_blockAlign, m_dataSize - offset));
+        m_file.clear();
+        m_file.seekg(m_dataOffset + static_cast<std::streamoff>(offset));
+        if (!m_file.read(reinterpret_cast<char*>(m_raw.data()), size) || size <= 4 * m_channels) {
+            return false;
+        }
+
+        // Заголовок канала: предсказание (первый отсчет) и индекс шага
+        const uint32_t channels = m_channels;
+        ImaChannel state[2];
+        for (uint32_t c = 0; c < channels; ++c) {
+            const uint8_t* header = m_raw.data() + c * 4;
+            state[c].predictor = static_cast<int16_t>(ReadU16(header));
+            state[c].index = std::min<int>(header[2], 88);
+            m_block[c] = state[c].predictor * (1.0f / 32768.0f);
+        }
+
+        // Далее группы по 4 байта (8 отсчетов) на канал, младший полубайт первым
+        uint32_t frames = std::min((size - 4 * channels) * 2 / channels + 1, m_framesPerBlock);
+        const uint8_t* data = m_raw.data() + 4 * channels;
+        const uint32_t groups = (frames - 1 + 7) / 8;
+        for (uint32_t group = 0; group < groups; ++group) {
+            for (uint32_t c = 0; c < channels; ++c) {
+                const uint8_t* bytes = data + (group * channels + c) * 4;
+                for (uint32_t i = 0; i < 8; ++i) {
+                    uint32_t frame = 1 + group * 8 + i;
+                    if (frame >= frames) {
+                        break;
+                    }
+                    uint8_t nibble = (i & 1) ? (bytes[i / 2] >> 4) : (bytes[i / 2] & 0x0F);
+                    m_block[frame * channels + c] = state[c].Decode(nibble) * (1.0f / 32768.0f);
+                }
+            }
+        }
+
+        m_blockIndex = block;
+        m_blockFrames = std::min(frames, m_frameCount - std::min(m_frameCount, block * m_framesPerBlock));
+        return true;
+    }
+
+    namespace AudioEncoder {
+        bool WriteWav(const std::string& filePath, const AudioClip& clip, AudioEncoding encoding) {
+            if (encoding == AudioEncoding::ImaAdpcm) {
+                return WriteImaAdpcm(filePath, clip);
+            }
+            std::vector<uint8_t> data;
+            uint16_t bits = encoding == AudioEncoding::Float ? 32 : 16;
+            data.reserve(clip.samples.size() * bits / 8);
+            for (float sample : clip.samples) {
+                if (encoding == AudioEncoding::Float) {
+                    uint32_t bitsValue;
+                    std::memcpy(&bitsValue, &sample, sizeof(bitsValue));
+                    AppendU32(data, bitsValue);
+                } else {
+                    AppendU16(data, static_cast<uint16_t>(ToPcm16(sample)));
+                }
+            }
+            uint16_t blockAlign = static_cast<uint16_t>(clip.channels * bits / 8);
+            auto header = MakeHeader(encoding == AudioEncoding::Float ? WAVE_FORMAT_IEEE_FLOAT : WAVE_FORMAT_PCM, clip,
+                                     clip.sampleRate * blockAlign, blockAlign, bits, {},
+                                     static_cast<uint32_t>(data.size()), false);
+            return WriteFile(filePath, header, data);
+        }
+
+        bool WriteImaAdpcm(const std::string& filePath, const AudioClip& clip, uint32_t framesPerBlock) {
+            if (framesPerBlock < 9 || (framesPerBlock - 1) % 8 != 0) {
+                std::cerr << "AudioEncoder: ADPCM block must hold 1 + 8n frames" << std::endl;
+                return false;
+            }
+            const uint32_t channels = clip.channels;
+            const uint32_t blockAlign = 4 * channels + (framesPerBlock - 1) / 2 * channels;
+            const uint32_t blocks = (clip.frameCount + framesPerBlock - 1) / framesPerBlock;
+
+            std::vector<uint8_t> data;
+            data.reserve(static_cast<size_t>(blocks) * blockAlign);
+            ImaChannel state[2];
+            auto sampleAt = [&clip, channels](uint32_t frame, uint32_t c) {
+                return frame < clip.frameCount ? ToPcm16(clip.samples[static_cast<size_t>(frame) * channels + c]) : 0;
+            };
+
+            for (uint32_t block = 0; block < blocks; ++block) {
+                uint32_t first = block * framesPerBlock;
+                // Первый отсчет блока хранится точно, индекс шага переходит из прошлого блока
+                for (uint32_t c = 0; c < channels; ++c) {
+                    state[c].predictor = sampleAt(first, c);
+                    AppendU16(data, static_cast<uint16_t>(static_cast<int16_t>(state[c].predictor)));
+                    data.push_back(static_cast<uint8_t>(state[c].index));
+                    data.push_back(0);
+                }
+                for (uint32_t group = 0; group < (framesPerBlock - 1) / 8; ++group) {
+                    for (uint32_t c = 0; c < channels; ++c) {
+                        uint8_t bytes[4] = { 0, 0, 0, 0 };
+                        for (uint32_t i = 0; i < 8; ++i) {
+                            uint8_t nibble = state[c].Encode(sampleAt(first + 1 + group * 8 + i, c));
+                            bytes[i / 2] |= (i & 1) ? static_cast<uint8_t>(nibble << 4) : nibble;
+                        }
+                        data.insert(data.end(), bytes, bytes + 4);
+                    }
+                }
+            }
+
+            std::vector<uint8_t> extra;
+            AppendU16(extra, static_cast<uint16_t>(framesPerBlock));
+            uint32_t byteRate = static_cast<uint32_t>(static_cast<uint64_t>(clip.sampleRate) * blockAlign / framesPerBlock);
+            auto header = MakeHeader(WAVE_FORMAT_IMA_ADPCM, clip, byteRate, static_cast<uint16_t>(blockAlign), 4, extra,
+                                     static_cast<uint32_t>(data.size()), true);
+            return WriteFile(filePath, header, data);
+        }
+    }
+
+    AudioClipPtr DecodeAudioFile(const std::string& filePath) {
+        std::unique_ptr<AudioDecoder> decoder = AudioDecoder::Open(filePath);
+        if (!decoder) {
+            return nullptr;
+        }
+        std::vector<float> samples(static_cast<size_t>(decoder->GetFrameCount()) * decoder->GetChannels());
+        uint32_t frames = 0;
+        while (frames < decoder->GetFrameCount()) {
+            uint32_t read = decoder->Read(samples.data() + static_cast<size_t>(frames) * decoder->GetChannels(),
+                                          decoder->GetFrameCount() - frames);
+            if (read == 0) {
+                break;
+            }
+            frames += read;
+        }
+        samples.resize(static_cast<size_t>(frames) * decoder->GetChannels());
+        return AudioClip::Create(std::move(samples), decoder->GetChannels(), decoder->GetSampleRate());
+    }
+}
@@ -1,10 +1,14 @@
 #include "FastEngine/Audio/AudioManager.h"
+#include "FastEngine/Audio/AudioMixer.h"
+#include "FastEngine/Audio/AudioStream.h"
 #include "FastEngine/Audio/Sound.h"
 #include <algorithm>
+#include <iostream>
 
 namespace FastEngine {
     AudioManager::AudioManager() 
-        : m_masterVolume(1.0f)
+        : m_mixerConfig(std::make_unique<AudioMixerConfig>())
+        , m_masterVolume(1.0f)
         , m_muted(false)
         , m_initialized(false) {
     }
@@ -21,10 +25,46 @@ namespace FastEngine {
         // На мобильных платформах аудио инициализируется автоматически
         // Здесь можно добавить платформо-специфичную инициализацию
         
+        // Программный микшер; устройство вывода подключается через SetOutputSink
+        m_mixer = std::make_unique<AudioMixer>(*m_mixerConfig);
+        m_mixer->SetMasterVolume(m_muted ? 0.0f : m_masterVolume);
+        if (!m_mixer->Start(std::make_unique<NullAudioSink>())) {
+            m_mixer.reset();
+            return false;
+        }
+        
+        // Подгрузка длинных звуков с диска в фоне
+        m_streamer = std::make_unique<AudioStreamer>();
+        m_streamer->Start();
+        for (auto& pair : m_sounds) {
+            pair.second->SetOutput(m_mixer.get(), m_streamer.get());
+        }
+        
         m_initialized = true;
         return true;
     }
     
+    void AudioManager::Update() {
+        if (m_mixer) {
+            m_mixer->Update();
+        }
+    }
+    
+    bool AudioManager::SetOutputSink(std::unique_ptr<AudioSink> sink) {
+        if (!m_mixer) {
+            std::cerr << "AudioManager: Not initialized" << std::endl;
+            return false;
+        }
+        // Голоса сохраняются: поток микшера перезапускается с новым приемником
+        m_mixer->Stop();
+        return m_mixer->Start(std::move(sink));
+    }
+    
+    void AudioManager::SetMixerConfig(const AudioMixerConfig& config) {
+        // Применяется при следующей инициализации
+        *m_mixerConfig = config;
+    }
+    
     void AudioManager::Shutdown() {
         if (!m_initialized) {
             return;
@@ -39,6 +79,8 @@ namespace FastEngine {
         
         // Очищаем все звуки
         m_sounds.clear();
+        m_mixer.reset();
+        m_streamer.reset();
         
         m_initialized = false;
     }
@@ -57,6 +99,7 @@ namespace FastEngine {
         }
         
         // Сохраняем звук
+        sound->SetOutput(m_mixer.get(), m_streamer.get());
         Sound* soundPtr = sound.get();
         m_sounds[filePath] = std::move(sound);
         
@@ -82,6 +125,9 @@ namespace FastEngine {
     
     void AudioManager::SetMasterVolume(float volume) {
         m_masterVolume = std::clamp(volume, 0.0f, 1.0f);
+        if (m_mixer && !m_muted) {
+            m_mixer->SetMasterVolume(m_masterVolume);
+        }
         
         // Применяем громкость ко всем звукам
         for (auto& pair : m_sounds) {
@@ -93,6 +139,9 @@ namespace FastEngine {
     
     void AudioManager::SetMuted(bool muted) {
         m_muted = muted;
+        if (m_mixer) {
+            m_mixer->SetMasterVolume(muted ? 0.0f : m_masterVolume);
+        }
         
         if (muted) {
             // Останавливаем все звуки
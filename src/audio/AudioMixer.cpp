@@ -0,0 +1,649 @@
+#include "FastEngine/Audio/AudioMixer.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FASTENGINE_AUDIO_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define FASTENGINE_AUDIO_NEON 1
+#endif
+
+namespace FastEngine {
+    namespace {
+        constexpr uint64_t FRACTION_ONE = 1ull << 32;
+        constexpr float FRACTION_SCALE = 1.0f / 4294967296.0f;
+        constexpr float QUARTER_PI = 0.78539816f;
+
+        // dst += src * gain, усиление линейно меняется от gain на delta за кадр
+        void MixChannel(const float* src, float* dst, uint32_t frames, float gain, float delta) {
+            uint32_t i = 0;
+#if defined(FASTENGINE_AUDIO_SSE2)
+            __m128 vgain = _mm_add_ps(_mm_set1_ps(gain), _mm_mul_ps(_mm_set1_ps(delta), _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f)));
+            const __m128 vstep = _mm_set1_ps(delta * 4.0f);
+            for (; i + 4 <= frames; i += 4) {
+                __m128 sample = _mm_loadu_ps(src + i);
+                _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(sample, vgain)));
+                vgain = _mm_add_ps(vgain, vstep);
+            }
+#elif defined(FASTENGINE_AUDIO_NEON)
+            const float offsets[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+            float32x4_t vgain = vmlaq_n_f32(vdupq_n_f32(gain), vld1q_f32(offsets), delta);
+            const float32x4_t vstep = vdupq_n_f32(delta * 4.0f);
+            for (; i + 4 <= frames; i += 4) {
+                vst1q_f32(dst + i, vmlaq_f32(vld1q_f32(dst + i), vld1q_f32(src + i), vgain));
+                vgain = vaddq_f32(vgain, vstep);
+            }
+#endif
+            for (; i < frames; ++i) {
+                dst[i] += src[i] * (gain + delta * static_cast<float>(i));
+            }
+        }
+
+        // Планарные L/R -> interleaved стерео с ограничением [-1, 1]
+        void InterleaveClamp(const float* left, const float* right, float* output, uint32_t frames) {
+            uint32_t i = 0;
+#if defined(FASTENGINE_AUDIO_SSE2)
+            const __m128 low = _mm_set1_ps(-1.0f);
+            const __m128 high = _mm_set1_ps(1.0f);
+            for (; i + 4 <= frames; i += 4) {
+                __m128 l = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(left + i), low), high);
+                __m128 r = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(right + i), low), high);
+                _mm_storeu_ps(output + i * 2, _mm_unpacklo_ps(l, r));
+                _mm_storeu_ps(output + i * 2 + 4, _mm_unpackhi_ps(l, r));
+            }
+#elif defined(FASTENGINE_AUDIO_NEON)
+            const float32x4_t low = vdupq_n_f32(-1.0f);
+            const float32x4_t high = vdupq_n_f32(1.0f);
+            for (; i + 4 <= frames; i += 4) {
+                float32x4x2_t pair;
+                pair.val[0] = vminq_f32(vmaxq_f32(vld1q_f32(left + i), low), high);
+                pair.val[1] = vminq_f32(vmaxq_f32(vld1q_f32(right + i), low), high);
+                vst2q_f32(output + i * 2, pair);
+            }
+#endif
+            for (; i < frames; ++i) {
+                output[i * 2] = std::min(std::max(left[i], -1.0f), 1.0f);
+                output[i * 2 + 1] = std::min(std::max(right[i], -1.0f), 1.0f);
+            }
+        }
+    }
+
+    AudioMixer::AudioMixer(const AudioMixerConfig& config)
+        : m_config(config)
+        , m_commands(config.commandQueueSize)
+        , m_nextHandle(1)
+        , m_playsSent(0)
+        , m_finished(std::max<size_t>(config.commandQueueSize, config.maxVoices * 4))
+        , m_slotHandles(std::max(config.maxVoices, 1u))
+        , m_playsProcessed(0)
+        , m_finishedLost(false)
+        , m_masterVolume(1.0f)
+        , m_startCounter(0)
+        , m_running(false)
+        , m_activeVoices(0)
+        , m_stolenVoices(0)
+        , m_rejectedVoices(0)
+        , m_renderedFrames(0)
+        , m_renderedBlocks(0)
+        , m_renderTimeNs(0) {
+        m_config.blockFrames = std::max(m_config.blockFrames, 1u);
+        m_config.maxVoices = std::max(m_config.maxVoices, 1u);
+        m_voices.resize(m_config.maxVoices);
+        for (Voice& voice : m_voices) {
+            voice.handle = INVALID_VOICE;
+            voice.clip = nullptr;
+            voice.stream = nullptr;
+        }
+        for (std::atomic<VoiceHandle>& slot : m_slotHandles) {
+            slot.store(INVALID_VOICE, std::memory_order_relaxed);
+        }
+        // Все буферы выделяются заранее: поток микшера не выделяет память
+        m_mixLeft.resize(m_config.blockFrames);
+        m_mixRight.resize(m_config.blockFrames);
+        m_sourceLeft.resize(m_config.blockFrames);
+        m_sourceRight.resize(m_config.blockFrames);
+        m_streamWindow.resize((static_cast<size_t>(m_config.blockFrames) * MAX_STREAM_STEP + 8) * 2);
+    }
+
+    AudioMixer::~AudioMixer() {
+        Stop();
+    }
+
+    bool AudioMixer::Start(std::unique_ptr<AudioSink> sink) {
+        if (m_running.load(std::memory_order_acquire)) {
+            return true;
+        }
+        Stop();
+        if (!sink) {
+            std::cerr << "AudioMixer: No output sink" << std::endl;
+            return false;
+        }
+        if (!sink->Open(m_config.sampleRate, 2, m_config.blockFrames)) {
+            std::cerr << "AudioMixer: Failed to open output sink" << std::endl;
+            return false;
+        }
+        m_sink = std::move(sink);
+        m_running.store(true, std::memory_order_release);
+        m_thread = std::thread(&AudioMixer::MixerThread, this);
+        return true;
+    }
+
+    void AudioMixer::Stop() {
+        m_running.store(false, std::memory_order_release);
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        if (m_sink) {
+            m_sink->Close();
+            m_sink.reset();
+        }
+    }
+
+    void AudioMixer::MixerThread() {
+        std::vector<float> block(m_config.blockFrames * 2);
+        while (m_running.load(std::memory_order_acquire)) {
+            Render(block.data(), m_config.blockFrames);
+            if (!m_sink->Write(block.data(), m_config.blockFrames)) {
+                std::cerr << "AudioMixer: Output sink write failed, mixer stopped" << std::endl;
+                m_running.store(false, std::memory_order_release);
+                break;
+            }
+        }
+    }
+
+    VoiceHandle AudioMixer::Play(const AudioClipPtr& clip, const VoiceParams& params) {
+        if (!clip || clip->frameCount == 0) {
+            return INVALID_VOICE;
+        }
+        LiveVoice live;
+        live.clip = clip;
+        return AddVoice(std::move(live), params);
+    }
+
+    VoiceHandle AudioMixer::PlayStream(const std::shared_ptr<AudioStream>& stream, const VoiceParams& params) {
+        if (!stream || stream->IsFinished()) {
+            return INVALID_VOICE;
+        }
+        LiveVoice live;
+        live.stream = stream;
+        return AddVoice(std::move(live), params);
+    }
+
+    VoiceHandle AudioMixer::AddVoice(LiveVoice live, const VoiceParams& params) {
+        VoiceHandle handle = m_nextHandle++;
+        if (m_nextHandle == INVALID_VOICE) {
+            m_nextHandle = 1;
+        }
+
+        Command command;
+        command.type = CommandType::Play;
+        command.voice = handle;
+        command.clip = live.clip.get();
+        command.stream = live.stream.get();
+        command.params = params;
+        command.params.volume = std::clamp(params.volume, 0.0f, 1.0f);
+        command.params.pan = std::clamp(params.pan, -1.0f, 1.0f);
+        command.params.pitch = std::clamp(params.pitch, 0.1f, 4.0f);
+        live.sequence = m_playsSent++;
+        m_liveVoices[handle] = std::move(live);
+        Send(command);
+        return handle;
+    }
+
+    void AudioMixer::StopVoice(VoiceHandle voice) {
+        Command command;
+        command.type = CommandType::Stop;
+        command.voice = voice;
+        Send(command);
+    }
+
+    void AudioMixer::StopAll() {
+        Command command;
+        command.type = CommandType::StopAll;
+        Send(command);
+    }
+
+    void AudioMixer::SetVoiceVolume(VoiceHandle voice, float volume) {
+        Command command;
+        command.type = CommandType::SetVolume;
+        command.voice = voice;
+        command.value = std::clamp(volume, 0.0f, 1.0f);
+        Send(command);
+    }
+
+    void AudioMixer::SetVoicePan(VoiceHandle voice, float pan) {
+        Command command;
+        command.type = CommandType::SetPan;
+        command.voice = voice;
+        command.value = std::clamp(pan, -1.0f, 1.0f);
+        Send(command);
+    }
+
+    void AudioMixer::SetVoicePitch(VoiceHandle voice, float pitch) {
+        Command command;
+        command.type = CommandType::SetPitch;
+        command.voice = voice;
+        command.value = std::clamp(pitch, 0.1f, 4.0f);
+        Send(command);
+    }
+
+    void AudioMixer::SetVoicePaused(VoiceHandle voice, bool paused) {
+        Command command;
+        command.type = CommandType::SetPaused;
+        command.voice = voice;
+        command.value = paused ? 1.0f : 0.0f;
+        Send(command);
+    }
+
+    void AudioMixer::SetMasterVolume(float volume) {
+        Command command;
+        command.type = CommandType::SetMasterVolume;
+        command.value = std::clamp(volume, 0.0f, 1.0f);
+        Send(command);
+    }
+
+    void AudioMixer::Send(const Command& command) {
+        // Порядок команд сохраняется: пока есть отложенные, новые идут за ними
+        FlushBacklog();
+        if (!m_backlog.empty() || !m_commands.Push(command)) {
+            m_backlog.push_back(command);
+        }
+    }
+
+    void AudioMixer::FlushBacklog() {
+        size_t sent = 0;
+        while (sent < m_backlog.size() && m_commands.Push(m_backlog[sent])) {
+            ++sent;
+        }
+        m_backlog.erase(m_backlog.begin(), m_backlog.begin() + sent);
+    }
+
+    void AudioMixer::Update() {
+        FlushBacklog();
+        VoiceHandle handle;
+        while (m_finished.Pop(handle)) {
+            m_liveVoices.erase(handle);
+        }
+        if (m_finishedLost.exchange(false, std::memory_order_acquire)) {
+            SweepLiveVoices();
+        }
+    }
+
+    void AudioMixer::SweepLiveVoices() {
+        // Play с номером меньше processed уже разобран: если его голоса нет в слотах,
+        // микшер его отпустил (или отклонил) и клип больше не читает
+        uint64_t processed = m_playsProcessed.load(std::memory_order_acquire);
+        for (auto it = m_liveVoices.begin(); it != m_liveVoices.end();) {
+            bool active = it->second.sequence >= processed;
+            for (size_t i = 0; !active && i < m_slotHandles.size(); ++i) {
+                active = m_slotHandles[i].load(std::memory_order_acquire) == it->first;
+            }
+            it = active ? std::next(it) : m_liveVoices.erase(it);
+        }
+    }
+
+    bool AudioMixer::IsPlaying(VoiceHandle voice) const {
+        return m_liveVoices.find(voice) != m_liveVoices.end();
+    }
+
+    double AudioMixer::GetAverageBlockTimeUs() const {
+        uint64_t blocks = m_renderedBlocks.load(std::memory_order_relaxed);
+        return blocks > 0 ? m_renderTimeNs.load(std::memory_order_relaxed) / 1000.0 / blocks : 0.0;
+    }
+
+    double AudioMixer::GetLoad() const {
+        uint64_t frames = m_renderedFrames.load(std::memory_order_relaxed);
+        if (frames == 0) {
+            return 0.0;
+        }
+        double audioSeconds = static_cast<double>(frames) / m_config.sampleRate;
+        return m_renderTimeNs.load(std::memory_order_relaxed) * 1e-9 / audioSeconds;
+    }
+
+    void AudioMixer::ProcessCommands() {
+        Command command;
+        while (m_commands.Pop(command)) {
+            if (command.type == CommandType::Play) {
+                StartVoice(command);
+                m_playsProcessed.store(m_playsProcessed.load(std::memory_order_relaxed) + 1,
+                                       std::memory_order_release);
+                continue;
+            }
+            if (command.type == CommandType::StopAll) {
+                for (Voice& voice : m_voices) {
+                    voice.stopping = true;
+                }
+                continue;
+            }
+            if (command.type == CommandType::SetMasterVolume) {
+                m_masterVolume = command.value;
+                continue;
+            }
+
+            Voice* voice = FindVoice(command.voice);
+            if (!voice) {
+                continue; // Голос уже завершен или вытеснен
+            }
+            switch (command.type) {
+                case CommandType::Stop:
+                    voice->stopping = true;
+                    break;
+                case CommandType::SetVolume:
+                    voice->volume = command.value;
+                    break;
+                case CommandType::SetPan:
+                    voice->pan = command.value;
+                    break;
+                case CommandType::SetPitch:
+                    voice->pitch = command.value;
+                    UpdateStep(*voice);
+                    break;
+                case CommandType::SetPaused:
+                    voice->paused = command.value != 0.0f;
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    void AudioMixer::StartVoice(const Command& command) {
+        Voice* slot = nullptr;
+        for (Voice& voice : m_voices) {
+            if (voice.handle == INVALID_VOICE) {
+                slot = &voice;
+                break;
+            }
+        }
+
+        if (!slot) {
+            // Жертва: затухающий голос, затем меньший приоритет, тише, старше
+            Voice* victim = nullptr;
+            for (Voice& voice : m_voices) {
+                if (!victim) {
+                    victim = &voice;
+                    continue;
+                }
+                int priority = voice.stopping ? INT_MIN : voice.priority;
+                int victimPriority = victim->stopping ? INT_MIN : victim->priority;
+                if (priority != victimPriority) {
+                    if (priority < victimPriority) {
+                        victim = &voice;
+                    }
+                } else if (voice.volume != victim->volume) {
+                    if (voice.volume < victim->volume) {
+                        victim = &voice;
+                    }
+                } else if (voice.startOrder < victim->startOrder) {
+                    victim = &voice;
+                }
+            }
+            if (!victim->stopping && victim->priority > command.params.priority) {
+                m_rejectedVoices.fetch_add(1, std::memory_order_relaxed);
+                NotifyFinished(command.voice);
+                return;
+            }
+            if (!victim->stopping) {
+                m_stolenVoices.fetch_add(1, std::memory_order_relaxed);
+            }
+            ReleaseVoice(*victim);
+            slot = victim;
+        }
+
+        slot->handle = command.voice;
+        SetSlotHandle(*slot, command.voice);
+        slot->clip = command.clip;
+        slot->stream = command.stream;
+        slot->channels = command.stream ? command.stream->GetChannels() : command.clip->channels;
+        slot->sampleRate = command.stream ? command.stream->GetSampleRate() : command.clip->sampleRate;
+        slot->carryFrames = 0;
+        slot->position = 0;
+        if (!command.stream && command.params.startFrame > 0) {
+            // Продолжение виртуального голоса; за концом клипа голос завершится на первом блоке
+            uint32_t start = command.params.startFrame;
+            if (command.params.looping) {
+                start %= command.clip->frameCount;
+            }
+            slot->position = static_cast<uint64_t>(start) << 32;
+        }
+        slot->volume = command.params.volume;
+        slot->pan = command.params.pan;
+        slot->pitch = command.params.pitch;
+        // Нарастание с нуля за первый блок убирает щелчок на старте
+        slot->gainLeft = 0.0f;
+        slot->gainRight = 0.0f;
+        slot->startOrder = m_startCounter++;
+        slot->priority = command.params.priority;
+        slot->looping = command.params.looping && !command.stream;
+        slot->paused = false;
+        slot->stopping = false;
+        UpdateStep(*slot);
+    }
+
+    AudioMixer::Voice* AudioMixer::FindVoice(VoiceHandle handle) {
+        if (handle == INVALID_VOICE) {
+            return nullptr;
+        }
+        for (Voice& voice : m_voices) {
+            if (voice.handle == handle) {
+                return &voice;
+            }
+        }
+        return nullptr;
+    }
+
+    void AudioMixer::SetSlotHandle(Voice& voice, VoiceHandle handle) {
+        m_slotHandles[&voice - m_voices.data()].store(handle, std::memory_order_release);
+    }
+
+    void AudioMixer::NotifyFinished(VoiceHandle handle) {
+        // Очередь полна (игровой поток давно не звал Update): Update найдет голос сверкой слотов
+        if (!m_finished.Push(handle)) {
+            m_finishedLost.store(true, std::memory_order_release);
+        }
+    }
+
+    void AudioMixer::ReleaseVoice(Voice& voice) {
+        VoiceHandle handle = voice.handle;
+        voice.handle = INVALID_VOICE;
+        voice.clip = nullptr;
+        voice.stream = nullptr;
+        // Слот освобождается до уведомления: сверка в Update не отпустит клип раньше времени
+        SetSlotHandle(voice, INVALID_VOICE);
+        NotifyFinished(handle);
+    }
+
+    void AudioMixer::UpdateStep(Voice& voice) const {
+        double ratio = static_cast<double>(voice.sampleRate) / m_config.sampleRate * voice.pitch;
+        if (voice.stream) {
+            ratio = std::min(ratio, static_cast<double>(MAX_STREAM_STEP));
+        }
+        voice.step = std::max<uint64_t>(static_cast<uint64_t>(ratio * FRACTION_ONE + 0.5), 1);
+    }
+
+    void AudioMixer::Render(float* output, uint32_t frames) {
+        auto start = std::chrono::steady_clock::now();
+        ProcessCommands();
+
+        uint32_t done = 0;
+        while (done < frames) {
+            uint32_t count = std::min(frames - done, m_config.blockFrames);
+            RenderBlock(output + done * 2, count);
+            done += count;
+        }
+
+        uint64_t elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+        m_renderTimeNs.fetch_add(elapsed, std::memory_order_relaxed);
+        m_renderedBlocks.fetch_add(1, std::memory_order_relaxed);
+        m_renderedFrames.fetch_add(frames, std::memory_order_relaxed);
+    }
+
+    void AudioMixer::RenderBlock(float* output, uint32_t frames) {
+        std::fill(m_mixLeft.begin(), m_mixLeft.begin() + frames, 0.0f);
+        std::fill(m_mixRight.begin(), m_mixRight.begin() + frames, 0.0f);
+
+        uint32_t active = 0;
+        const float inverseFrames = 1.0f / frames;
+        for (Voice& voice : m_voices) {
+            if (voice.handle == INVALID_VOICE) {
+                continue;
+            }
+            if (voice.paused && !voice.stopping && voice.gainLeft == 0.0f && voice.gainRight == 0.0f) {
+                ++active;
+                continue; // Пауза после затухания: позиция стоит
+            }
+
+            // Целевое усиление к концу блока; mono - панорама равной мощности, stereo - баланс
+            float gain = (voice.stopping || voice.paused) ? 0.0f : voice.volume * m_masterVolume;
+            float targetLeft;
+            float targetRight;
+            if (voice.channels == 1) {
+                float angle = (voice.pan + 1.0f) * QUARTER_PI;
+                targetLeft = gain * std::cos(angle);
+                targetRight = gain * std::sin(angle);
+            } else {
+                targetLeft = gain * std::min(1.0f, 1.0f - voice.pan);
+                targetRight = gain * std::min(1.0f, 1.0f + voice.pan);
+            }
+
+            bool ended = voice.stream ? FetchStream(voice, frames) : FetchClip(voice, frames);
+            float deltaLeft = (targetLeft - voice.gainLeft) * inverseFrames;
+            float deltaRight = (targetRight - voice.gainRight) * inverseFrames;
+            const float* sourceRight = voice.channels == 1 ? m_sourceLeft.data() : m_sourceRight.data();
+            MixChannel(m_sourceLeft.data(), m_mixLeft.data(), frames, voice.gainLeft, deltaLeft);
+            MixChannel(sourceRight, m_mixRight.data(), frames, voice.gainRight, deltaRight);
+            voice.gainLeft = targetLeft;
+            voice.gainRight = targetRight;
+
+            if (voice.stopping || ended) {
+                ReleaseVoice(voice);
+            } else {
+                ++active;
+            }
+        }
+
+        InterleaveClamp(m_mixLeft.data(), m_mixRight.data(), output, frames);
+        m_activeVoices.store(active, std::memory_order_relaxed);
+    }
+
+    bool AudioMixer::FetchClip(Voice& voice, uint32_t frames) {
+        const AudioClip& clip = *voice.clip;
+        const uint32_t length = clip.frameCount;
+        const float* data = clip.samples.data();
+        float* left = m_sourceLeft.data();
+        float* right = m_sourceRight.data();
+        const bool stereo = clip.channels == 2;
+
+        uint32_t written = 0;
+        while (written < frames) {
+            uint32_t index = static_cast<uint32_t>(voice.position >> 32);
+            if (index >= length) {
+                if (!voice.looping || length == 0) {
+                    break;
+                }
+                voice.position -= static_cast<uint64_t>(length) << 32;
+                continue;
+            }
+
+            if (voice.step == FRACTION_ONE) {
+                // Без пересэмплирования: копия до конца клипа
+                uint32_t count = std::min(frames - written, length - index);
+                if (stereo) {
+                    const float* source = data + static_cast<size_t>(index) * 2;
+                    for (uint32_t i = 0; i < count; ++i) {
+                        left[written + i] = source[i * 2];
+                        right[written + i] = source[i * 2 + 1];
+                    }
+                } else {
+                    std::memcpy(left + written, data + index, count * sizeof(float));
+                }
+                written += count;
+                voice.position += static_cast<uint64_t>(count) << 32;
+                continue;
+            }
+
+            // Линейная интерполяция; за концом петли берется ее начало
+            for (; written < frames; ++written) {
+                index = static_cast<uint32_t>(voice.position >> 32);
+                if (index >= length) {
+                    break;
+                }
+                uint32_t next = index + 1 < length ? index + 1 : (voice.looping ? 0 : index);
+                float fraction = static_cast<float>(voice.position & (FRACTION_ONE - 1)) * FRACTION_SCALE;
+                if (stereo) {
+                    const float* a = data + static_cast<size_t>(index) * 2;
+                    const float* b = data + static_cast<size_t>(next) * 2;
+                    left[written] = a[0] + (b[0] - a[0]) * fraction;
+                    right[written] = a[1] + (b[1] - a[1]) * fraction;
+                } else {
+                    left[written] = data[index] + (data[next] - data[index]) * fraction;
+                }
+                voice.position += voice.step;
+            }
+        }
+
+        if (written < frames) {
+            std::fill(left + written, left + frames, 0.0f);
+            if (stereo) {
+                std::fill(right + written, right + frames, 0.0f);
+            }
+        }
+        return written < frames;
+    }
+
+    bool AudioMixer::FetchStream(Voice& voice, uint32_t frames) {
+        // Окно: хвост прошлого блока, затем новые кадры потока; позиция - от начала окна
+        const uint32_t channels = voice.channels;
+        const bool stereo = channels == 2;
+        float* window = m_streamWindow.data();
+        std::memcpy(window, voice.carry, voice.carryFrames * channels * sizeof(float));
+
+        uint32_t available = voice.carryFrames;
+        uint32_t needed = static_cast<uint32_t>((voice.position + voice.step * (frames - 1)) >> 32) + 2;
+        if (needed > available) {
+            available += voice.stream->Read(window + static_cast<size_t>(available) * channels, needed - available);
+        }
+
+        float* left = m_sourceLeft.data();
+        float* right = m_sourceRight.data();
+        uint32_t written = 0;
+        for (; written < frames; ++written) {
+            uint32_t index = static_cast<uint32_t>(voice.position >> 32);
+            if (index + 1 >= available) {
+                break; // Недогрузка или конец потока
+            }
+            float fraction = static_cast<float>(voice.position & (FRACTION_ONE - 1)) * FRACTION_SCALE;
+            const float* a = window + static_cast<size_t>(index) * channels;
+            const float* b = a + channels;
+            left[written] = a[0] + (b[0] - a[0]) * fraction;
+            if (stereo) {
+                right[written] = a[1] + (b[1] - a[1]) * fraction;
+            }
+            voice.position += voice.step;
+        }
+
+        // Непрочитанный хвост окна (не больше двух кадров) переходит в следующий блок
+        uint32_t consumed = std::min(static_cast<uint32_t>(voice.position >> 32), available);
+        voice.carryFrames = std::min(available - consumed, 2u);
+        consumed = available - voice.carryFrames;
+        std::memcpy(voice.carry, window + static_cast<size_t>(consumed) * channels,
+                    voice.carryFrames * channels * sizeof(float));
+        voice.position -= static_cast<uint64_t>(consumed) << 32;
+
+        if (written < frames) {
+            std::fill(left + written, left + frames, 0.0f);
+            if (stereo) {
+                std::fill(right + written, right + frames, 0.0f);
+            }
+        }
+        return written < frames && voice.stream->IsFinished();
+    }
+}
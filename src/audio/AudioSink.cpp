@@ -0,0 +1,122 @@
+#include "FastEngine/Audio/AudioSink.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace FastEngine {
+    NullAudioSink::NullAudioSink(bool realtime)
+        : m_realtime(realtime)
+        , m_sampleRate(48000)
+        , m_channels(2)
+        , m_started(false)
+        , m_framesWritten(0)
+        , m_peak(0.0f) {
+    }
+
+    bool NullAudioSink::Open(uint32_t sampleRate, uint32_t channels, uint32_t blockFrames) {
+        (void)blockFrames;
+        m_sampleRate = sampleRate;
+        m_channels = channels;
+        m_started = false;
+        return sampleRate > 0 && channels > 0;
+    }
+
+    bool NullAudioSink::Write(const float* samples, uint32_t frames) {
+        float peak = m_peak.load(std::memory_order_relaxed);
+        for (uint32_t i = 0; i < frames * m_channels; ++i) {
+            peak = std::max(peak, std::fabs(samples[i]));
+        }
+        m_peak.store(peak, std::memory_order_relaxed);
+        m_framesWritten.fetch_add(frames, std::memory_order_relaxed);
+
+        if (m_realtime) {
+            // Темп устройства: блок уходит раз в свою длительность
+            auto now = PreciseWaiter::Clock::now();
+            auto duration = std::chrono::duration_cast<PreciseWaiter::Clock::duration>(
+                std::chrono::duration<double>(static_cast<double>(frames) / m_sampleRate));
+            if (!m_started || now - m_deadline > duration * 4) {
+                m_deadline = now;
+                m_started = true;
+            }
+            m_deadline += duration;
+            m_waiter.WaitUntil(m_deadline);
+        }
+        return true;
+    }
+
+    WavFileAudioSink::WavFileAudioSink(const std::string& filePath)
+        : m_filePath(filePath)
+        , m_sampleRate(48000)
+        , m_channels(2)
+        , m_framesWritten(0) {
+    }
+
+    WavFileAudioSink::~WavFileAudioSink() {
+        Close();
+    }
+
+    bool WavFileAudioSink::Open(uint32_t sampleRate, uint32_t channels, uint32_t blockFrames) {
+        Close();
+        m_file.open(m_filePath, std::ios::binary | std::ios::trunc);
+        if (!m_file.is_open()) {
+            std::cerr << "WavFileAudioSink: Failed to open " << m_filePath << std::endl;
+            return false;
+        }
+        m_sampleRate = sampleRate;
+        m_channels = channels;
+        m_framesWritten.store(0, std::memory_order_relaxed);
+        m_buffer.reserve(static_cast<size_t>(blockFrames) * channels);
+        WriteHeader(sampleRate, 0);
+        return true;
+    }
+
+    void WavFileAudioSink::Close() {
+        if (!m_file.is_open()) {
+            return;
+        }
+        uint64_t dataBytes = m_framesWritten.load(std::memory_order_relaxed) * m_channels * sizeof(int16_t);
+        m_file.seekp(0);
+        WriteHeader(m_sampleRate, static_cast<uint32_t>(std::min<uint64_t>(dataBytes, 0xFFFFFFF0u)));
+        m_file.close();
+    }
+
+    bool WavFileAudioSink::Write(const float* samples, uint32_t frames) {
+        if (!m_file.is_open()) {
+            return false;
+        }
+        m_buffer.resize(static_cast<size_t>(frames) * m_channels);
+        for (size_t i = 0; i < m_buffer.size(); ++i) {
+            float sample = std::min(std::max(samples[i], -1.0f), 1.0f);
+            m_buffer[i] = static_cast<int16_t>(std::lround(sample * 32767.0f));
+        }
+        m_file.write(reinterpret_cast<const char*>(m_buffer.data()), m_buffer.size() * sizeof(int16_t));
+        m_framesWritten.fetch_add(frames, std::memory_order_relaxed);
+        return m_file.good();
+    }
+
+    void WavFileAudioSink::WriteHeader(uint32_t sampleRate, uint32_t dataBytes) {
+        // RIFF/WAVE, fmt PCM 16 бит, little-endian
+        auto writeU32 = [this](uint32_t value) {
+            char bytes[4] = { static_cast<char>(value), static_cast<char>(value >> 8),
+                              static_cast<char>(value >> 16), static_cast<char>(value >> 24) };
+            m_file.write(bytes, 4);
+        };
+        auto writeU16 = [this](uint16_t value) {
+            char bytes[2] = { static_cast<char>(value), static_cast<char>(value >> 8) };
+            m_file.write(bytes, 2);
+        };
+        const uint16_t blockAlign = static_cast<uint16_t>(m_channels * sizeof(int16_t));
+        m_file.write("RIFF", 4);
+        writeU32(36 + dataBytes);
+        m_file.write("WAVEfmt ", 8);
+        writeU32(16);
+        writeU16(1);
+        writeU16(static_cast<uint16_t>(m_channels));
+        writeU32(sampleRate);
+        writeU32(sampleRate * blockAlign);
+        writeU16(blockAlign);
+        writeU16(16);
+        m_file.write("data", 4);
+        writeU32(dataBytes);
+    }
+}
@@ -0,0 +1,180 @@
+#include "FastEngine/Audio/AudioStream.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace FastEngine {
+    AudioStream::AudioStream(std::unique_ptr<AudioDecoder> decoder, bool looping, uint32_t chunkFrames)
+        : m_decoder(std::move(decoder))
+        , m_channels(m_decoder ? m_decoder->GetChannels() : 1)
+        , m_sampleRate(m_decoder ? m_decoder->GetSampleRate() : 48000)
+        , m_frameCount(m_decoder ? m_decoder->GetFrameCount() : 0)
+        , m_chunkFrames(std::max(chunkFrames, 1u))
+        , m_looping(looping)
+        , m_writeChunk(0)
+        , m_decoderFinished(!m_decoder)
+        , m_readChunk(0)
+        , m_readOffset(0)
+        , m_finished(!m_decoder)
+        , m_underruns(0) {
+        for (Chunk& chunk : m_chunks) {
+            chunk.samples.resize(static_cast<size_t>(m_chunkFrames) * m_channels);
+        }
+    }
+
+    uint32_t AudioStream::Read(float* output, uint32_t frames) {
+        uint32_t written = 0;
+        while (written < frames) {
+            Chunk& chunk = m_chunks[m_readChunk];
+            if (!chunk.ready.load(std::memory_order_acquire)) {
+                if (!m_finished.load(std::memory_order_relaxed)) {
+                    m_underruns.fetch_add(1, std::memory_order_relaxed);
+                }
+                break;
+            }
+            uint32_t count = std::min(frames - written, chunk.frames - m_readOffset);
+            std::memcpy(output + static_cast<size_t>(written) * m_channels,
+                        chunk.samples.data() + static_cast<size_t>(m_readOffset) * m_channels,
+                        static_cast<size_t>(count) * m_channels * sizeof(float));
+            written += count;
+            m_readOffset += count;
+
+            if (m_readOffset >= chunk.frames) {
+                // Буфер прочитан: возвращается потоку подгрузки
+                bool end = chunk.endOfStream;
+                m_readOffset = 0;
+                m_readChunk ^= 1;
+                chunk.ready.store(false, std::memory_order_release);
+                if (end) {
+                    m_finished.store(true, std::memory_order_release);
+                    break;
+                }
+            }
+        }
+        return written;
+    }
+
+    bool AudioStream::Fill() {
+        bool decoded = false;
+        while (!m_decoderFinished) {
+            Chunk& chunk = m_chunks[m_writeChunk];
+            if (chunk.ready.load(std::memory_order_acquire)) {
+                break; // Оба буфера ждут микшер
+            }
+            chunk.frames = 0;
+            chunk.endOfStream = false;
+            bool rewound = false;
+            while (chunk.frames < m_chunkFrames) {
+                uint32_t read = m_decoder->Read(chunk.samples.data() + static_cast<size_t>(chunk.frames) * m_channels,
+                                                m_chunkFrames - chunk.frames);
+                if (read > 0) {
+                    rewound = false;
+                    chunk.frames += read;
+                    continue;
+                }
+                // Петля: с начала файла; пустое чтение сразу после перемотки - ошибка
+                if (m_looping && !rewound && m_decoder->Seek(0)) {
+                    rewound = true;
+                    continue;
+                }
+                chunk.endOfStream = true;
+                m_decoderFinished = true;
+                break;
+            }
+            chunk.ready.store(true, std::memory_order_release);
+            m_writeChunk ^= 1;
+            decoded = true;
+        }
+        return decoded;
+    }
+
+    AudioStreamer::AudioStreamer(uint32_t chunkFrames, float pollInterval)
+        : m_chunkFrames(chunkFrames)
+        , m_pollInterval(pollInterval)
+        , m_running(false) {
+    }
+
+    AudioStreamer::~AudioStreamer() {
+        Stop();
+    }
+
+    bool AudioStreamer::Start() {
+        if (m_running) {
+            return true;
+        }
+        m_running = true;
+        m_thread = std::thread(&AudioStreamer::Run, this);
+        return true;
+    }
+
+    void AudioStreamer::Stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_running) {
+                return;
+            }
+            m_running = false;
+        }
+        m_wake.notify_all();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    std::shared_ptr<AudioStream> AudioStreamer::Open(const std::string& filePath, bool looping, uint32_t startFrame) {
+        std::unique_ptr<AudioDecoder> decoder = AudioDecoder::Open(filePath);
+        if (!decoder) {
+            return nullptr;
+        }
+        if (startFrame > 0) {
+            uint32_t frameCount = decoder->GetFrameCount();
+            if (looping && frameCount > 0) {
+                startFrame %= frameCount;
+            }
+            if (!decoder->Seek(std::min(startFrame, frameCount))) {
+                return nullptr;
+            }
+        }
+        auto stream = std::make_shared<AudioStream>(std::move(decoder), looping, m_chunkFrames);
+        stream->Fill();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_streams.push_back(stream);
+        return stream;
+    }
+
+    size_t AudioStreamer::GetStreamCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return static_cast<size_t>(std::count_if(m_streams.begin(), m_streams.end(),
+            [](const std::weak_ptr<AudioStream>& stream) { return !stream.expired(); }));
+    }
+
+    void AudioStreamer::Run() {
+        std::vector<std::shared_ptr<AudioStream>> active;
+        auto interval = std::chrono::duration<float>(m_pollInterval);
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (m_running) {
+            active.clear();
+            for (auto it = m_streams.begin(); it != m_streams.end();) {
+                std::shared_ptr<AudioStream> stream = it->lock();
+                if (stream) {
+                    active.push_back(std::move(stream));
+                    ++it;
+                } else {
+                    it = m_streams.erase(it);
+                }
+            }
+
+            // Декодирование без блокировки: Open из игрового потока не ждет диск
+            lock.unlock();
+            for (const auto& stream : active) {
+                stream->Fill();
+            }
+            active.clear();
+            lock.lock();
+
+            m_wake.wait_for(lock, interval, [this]() { return !m_running; });
+        }
+    }
+}
@@ -1,119 +1,200 @@
 #include "FastEngine/Audio/Sound.h"
-#include "FastEngine/Platform/Platform.h"
+#include "FastEngine/Audio/AudioClipCache.h"
+#include "FastEngine/Audio/AudioCodec.h"
+#include "FastEngine/Audio/AudioMixer.h"
+#include "FastEngine/Audio/AudioStream.h"
 #include <algorithm>
 
 namespace FastEngine {
-    Sound::Sound() 
+    float Sound::s_streamingThreshold = 10.0f;
+
+    Sound::Sound()
         : m_volume(1.0f)
         , m_looping(false)
         , m_pitch(1.0f)
+        , m_pan(0.0f)
+        , m_priority(0)
         , m_playing(false)
         , m_paused(false)
         , m_loaded(false)
-        , m_audioData(nullptr) {
+        , m_streaming(false)
+        , m_duration(0.0f)
+        , m_channels(0)
+        , m_sampleRate(0)
+        , m_mixer(nullptr)
+        , m_streamer(nullptr)
+        , m_voice(INVALID_VOICE) {
     }
-    
+
     Sound::~Sound() {
         Destroy();
     }
-    
+
     bool Sound::LoadFromFile(const std::string& filePath) {
         if (m_loaded) {
             Destroy();
         }
-        
+
         m_filePath = filePath;
-        
-        // На мобильных платформах загрузка звука зависит от конкретной реализации
-        // Здесь создаем заглушку для демонстрации
-        
-        // В реальном приложении здесь должна быть загрузка через:
-        // - iOS: AVAudioPlayer или AudioToolbox
-        // - Android: MediaPlayer или SoundPool
-        // - Desktop: SDL_mixer или OpenAL
-        
+
+        // Уже декодированный клип берется из кэша без обращения к диску
+        m_clip = AudioClipCache::GetInstance().Find(filePath);
+        if (!m_clip) {
+            // Заголовок решает: короткий звук декодируется целиком, длинный - потоком
+            std::unique_ptr<AudioDecoder> decoder = AudioDecoder::Open(filePath);
+            if (!decoder) {
+                return false;
+            }
+            m_duration = decoder->GetDuration();
+            m_channels = decoder->GetChannels();
+            m_sampleRate = decoder->GetSampleRate();
+            m_streaming = m_duration > s_streamingThreshold;
+            if (!m_streaming) {
+                decoder.reset();
+                m_clip = AudioClipCache::GetInstance().Load(filePath);
+                if (!m_clip) {
+                    return false;
+                }
+            }
+        }
+        if (m_clip) {
+            m_streaming = false;
+            m_duration = m_clip->GetDuration();
+            m_channels = m_clip->channels;
+            m_sampleRate = m_clip->sampleRate;
+        }
+
         m_loaded = true;
         return true;
     }
-    
+
     void Sound::Destroy() {
         if (m_loaded) {
             Stop();
-            
-            // Освобождаем платформо-специфичные данные
-            if (m_audioData) {
-                // Здесь должно быть освобождение ресурсов
-                m_audioData = nullptr;
-            }
-            
+            m_clip.reset();
+            m_streaming = false;
+            m_duration = 0.0f;
             m_loaded = false;
         }
     }
-    
-    void Sound::Play() {
-        if (!m_loaded || m_playing) {
+
+    void Sound::SetOutput(AudioMixer* mixer, AudioStreamer* streamer) {
+        Stop();
+        m_mixer = mixer;
+        m_streamer = streamer;
+    }
+
+    size_t Sound::GetMemorySize() const {
+        if (m_clip) {
+            return m_clip->GetMemorySize();
+        }
+        if (m_streaming) {
+            uint32_t chunkFrames = m_streamer ? m_streamer->GetChunkFrames() : AudioStream::DEFAULT_CHUNK_FRAMES;
+            return AudioStream::GetBufferSize(chunkFrames, m_channels);
+        }
+        return 0;
+    }
+
+    void Sound::Play(float startTime) {
+        if (!m_loaded || IsPlaying()) {
             return;
         }
-        
-        // В реальном приложении здесь должно быть воспроизведение звука
-        // через платформо-специфичные API
-        
+
+        if (m_mixer) {
+            VoiceParams params;
+            params.volume = m_volume;
+            params.pan = m_pan;
+            params.pitch = m_pitch;
+            params.priority = m_priority;
+            params.looping = m_looping;
+            params.startFrame = static_cast<uint32_t>(std::max(0.0f, startTime) * m_sampleRate);
+            if (m_clip) {
+                m_voice = m_mixer->Play(m_clip, params);
+            } else if (m_streaming && m_streamer) {
+                // У каждого воспроизведения свой поток и декодер
+                m_voice = m_mixer->PlayStream(m_streamer->Open(m_filePath, m_looping, params.startFrame), params);
+            }
+            if (m_voice == INVALID_VOICE) {
+                return;
+            }
+        }
+
         m_playing = true;
         m_paused = false;
     }
-    
+
     void Sound::Stop() {
         if (!m_loaded || !m_playing) {
             return;
         }
-        
-        // В реальном приложении здесь должно быть остановка звука
-        // через платформо-специфичные API
-        
+
+        if (m_mixer && m_voice != INVALID_VOICE) {
+            m_mixer->StopVoice(m_voice);
+        }
+        m_voice = INVALID_VOICE;
+
         m_playing = false;
         m_paused = false;
     }
-    
+
     void Sound::Pause() {
         if (!m_loaded || !m_playing || m_paused) {
             return;
         }
-        
-        // В реальном приложении здесь должно быть приостановка звука
-        // через платформо-специфичные API
-        
+
+        if (m_mixer && m_voice != INVALID_VOICE) {
+            m_mixer->SetVoicePaused(m_voice, true);
+        }
+
         m_paused = true;
     }
-    
+
     void Sound::Resume() {
         if (!m_loaded || !m_playing || !m_paused) {
             return;
         }
-        
-        // В реальном приложении здесь должно быть возобновление звука
-        // через платформо-специфичные API
-        
+
+        if (m_mixer && m_voice != INVALID_VOICE) {
+            m_mixer->SetVoicePaused(m_voice, false);
+        }
+
         m_paused = false;
     }
-    
+
+    bool Sound::IsPlaying() const {
+        // Голос мог закончиться сам: состояние берется у микшера
+        if (m_mixer && m_voice != INVALID_VOICE) {
+            return m_playing && m_mixer->IsPlaying(m_voice);
+        }
+        return m_playing;
+    }
+
     void Sound::SetVolume(float volume) {
         m_volume = std::clamp(volume, 0.0f, 1.0f);
-        
-        // В реальном приложении здесь должно быть установка громкости
-        // через платформо-специфичные API
+
+        if (m_mixer && m_voice != INVALID_VOICE) {
+            m_mixer->SetVoiceVolume(m_voice, m_volume);
+        }
+    }
+
+    void Sound::SetPan(float pan) {
+        m_pan = std::clamp(pan, -1.0f, 1.0f);
+
+        if (m_mixer && m_voice != INVALID_VOICE) {
+            m_mixer->SetVoicePan(m_voice, m_pan);
+        }
     }
-    
+
     void Sound::SetLooping(bool looping) {
+        // Применяется при следующем Play
         m_looping = looping;
-        
-        // В реальном приложении здесь должно быть установка зацикливания
-        // через платформо-специфичные API
     }
-    
+
     void Sound::SetPitch(float pitch) {
         m_pitch = std::clamp(pitch, 0.1f, 2.0f);
-        
-        // В реальном приложении здесь должно быть установка высоты тона
-        // через платформо-специфичные API
+
+        if (m_mixer && m_voice != INVALID_VOICE) {
+            m_mixer->SetVoicePitch(m_voice, m_pitch);
+        }
     }
 }
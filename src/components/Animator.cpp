@@ -1,120 +1,177 @@
 #include "FastEngine/Components/Animator.h"
+#include "FastEngine/Systems/AnimationSystem.h"
 #include <algorithm>
+#include <cmath>
 
 namespace FastEngine {
-    Animator::Animator() 
-        : m_currentFrame(0)
-        , m_frameTimer(0.0f)
-        , m_isPlaying(false)
-        , m_isPaused(false)
-        , m_speed(1.0f) {
+    Animator::Animator()
+        : m_playback()
+        , m_system(nullptr)
+        , m_slot(0) {
+        m_playback.clip = INVALID_ANIMATION_CLIP;
+        m_playback.speed = 1.0f;
+        m_playback.direction = 1;
+    }
+    
+    Animator::~Animator() {
+        if (m_system) {
+            m_system->Detach(this);
+        }
     }
     
     void Animator::AddAnimation(const Animation& animation) {
-        m_animations[animation.name] = animation;
+        AnimationClipHandle handle = AnimationClipLibrary::GetInstance().Register(animation);
+        if (handle == INVALID_ANIMATION_CLIP) {
+            return;
+        }
+        
+        m_animations[animation.name] = handle;
+        RebuildNames();
+        
+        if (animation.autoPlay && !IsPlaying()) {
+            Play(handle);
+        }
+    }
+    
+    void Animator::AddClip(AnimationClipHandle clip) {
+        const AnimationClip* data = AnimationClipLibrary::GetInstance().Get(clip);
+        if (!data) {
+            return;
+        }
+        
+        m_animations[data->GetName()] = clip;
+        RebuildNames();
     }
     
     void Animator::RemoveAnimation(const std::string& name) {
         auto it = m_animations.find(name);
         if (it != m_animations.end()) {
-            m_animations.erase(it);
-            
             // Если удаляемая анимация была текущей, останавливаем воспроизведение
-            if (m_currentAnimation == name) {
+            if (GetCurrentClip() == it->second) {
                 Stop();
             }
+            
+            m_animations.erase(it);
+            RebuildNames();
         }
     }
     
     void Animator::ClearAnimations() {
         m_animations.clear();
+        m_names.clear();
         Stop();
     }
     
     void Animator::Play(const std::string& animationName) {
+        // Поиск по имени только при запуске, кадры дальше идут по дескриптору
         auto it = m_animations.find(animationName);
         if (it == m_animations.end()) {
             return;
         }
         
-        m_currentAnimation = animationName;
-        m_currentFrame = 0;
-        m_frameTimer = 0.0f;
-        m_isPlaying = true;
-        m_isPaused = false;
+        Play(it->second);
+    }
+    
+    void Animator::Play(AnimationClipHandle clip) {
+        if (!AnimationClipLibrary::GetInstance().Get(clip)) {
+            return;
+        }
         
-        // Устанавливаем скорость из анимации
-        m_speed = it->second.speed;
+        AnimationPlayback state = GetPlayback();
+        state.clip = clip;
+        state.time = 0.0f;
+        state.frame = 0;
+        state.direction = 1;
+        state.flags = ANIMATION_PLAYING;
+        SetPlayback(state);
     }
     
     void Animator::Stop() {
-        m_isPlaying = false;
-        m_isPaused = false;
-        m_currentFrame = 0;
-        m_frameTimer = 0.0f;
+        AnimationPlayback state = GetPlayback();
+        state.time = 0.0f;
+        state.frame = 0;
+        state.direction = 1;
+        state.flags = 0;
+        SetPlayback(state);
     }
     
     void Animator::Pause() {
-        if (m_isPlaying) {
-            m_isPaused = true;
+        AnimationPlayback state = GetPlayback();
+        if (state.flags & ANIMATION_PLAYING) {
+            state.flags |= ANIMATION_PAUSED;
+            SetPlayback(state);
         }
     }
     
     void Animator::Resume() {
-        if (m_isPaused) {
-            m_isPaused = false;
+        AnimationPlayback state = GetPlayback();
+        if (state.flags & ANIMATION_PAUSED) {
+            state.flags &= ~ANIMATION_PAUSED;
+            SetPlayback(state);
         }
     }
     
-    AnimationFrame Animator::GetCurrentFrameData() const {
-        auto it = m_animations.find(m_currentAnimation);
-        if (it == m_animations.end() || it->second.frames.empty()) {
-            return AnimationFrame();
+    void Animator::SetSpeed(float speed) {
+        AnimationPlayback state = GetPlayback();
+        state.speed = speed;
+        SetPlayback(state);
+    }
+    
+    const std::string& Animator::GetCurrentAnimation() const {
+        static const std::string empty;
+        const AnimationClip* clip = AnimationClipLibrary::GetInstance().Get(GetCurrentClip());
+        return clip ? clip->GetName() : empty;
+    }
+    
+    AnimationPlayback Animator::GetPlayback() const {
+        return m_system ? m_system->GetPlayback(m_slot) : m_playback;
+    }
+    
+    void Animator::SetPlayback(const AnimationPlayback& state) {
+        if (m_system) {
+            m_system->SetPlayback(m_slot, state);
+        } else {
+            m_playback = state;
         }
-        
-        if (m_currentFrame >= 0 && m_currentFrame < static_cast<int>(it->second.frames.size())) {
-            return it->second.frames[m_currentFrame];
+    }
+    
+    const AnimationFrame& Animator::GetCurrentFrameData() const {
+        static const AnimationFrame empty;
+        AnimationPlayback state = GetPlayback();
+        const AnimationClip* clip = AnimationClipLibrary::GetInstance().Get(state.clip);
+        if (!clip) {
+            return empty;
         }
         
-        return it->second.frames[0];
+        const std::vector<AnimationFrame>& frames = clip->source.frames;
+        return frames[std::min<size_t>(state.frame, frames.size() - 1)];
     }
     
     void Animator::Update(float deltaTime) {
-        if (!m_isPlaying || m_isPaused) {
+        // Подключенным аниматором управляет AnimationSystem
+        if (m_system) {
             return;
         }
-        
-        auto it = m_animations.find(m_currentAnimation);
-        if (it == m_animations.end() || it->second.frames.empty()) {
+        if ((m_playback.flags & ANIMATION_PLAYING) == 0 || (m_playback.flags & ANIMATION_PAUSED) != 0) {
             return;
         }
         
-        const Animation& animation = it->second;
-        m_frameTimer += deltaTime * m_speed;
-        
-        float frameDuration = animation.frames[m_currentFrame].duration;
-        
-        if (m_frameTimer >= frameDuration) {
-            m_frameTimer -= frameDuration;
-            NextFrame();
+        const AnimationClip* clip = AnimationClipLibrary::GetInstance().Get(m_playback.clip);
+        if (!clip) {
+            return;
         }
+        
+        m_playback.time += deltaTime * m_playback.speed * clip->source.speed;
+        uint32_t events = Step(m_playback, *clip);
+        DispatchEvents(events, m_playback);
     }
     
     void Animator::SetOnAnimationComplete(std::function<void(const std::string&)> callback) {
-        m_onAnimationComplete = callback;
+        m_onAnimationComplete = std::move(callback);
     }
     
     void Animator::SetOnFrameChange(std::function<void(int)> callback) {
-        m_onFrameChange = callback;
-    }
-    
-    const std::vector<std::string>& Animator::GetAnimationNames() const {
-        static std::vector<std::string> names;
-        names.clear();
-        for (const auto& pair : m_animations) {
-            names.push_back(pair.first);
-        }
-        return names;
+        m_onFrameChange = std::move(callback);
     }
     
     bool Animator::HasAnimation(const std::string& name) const {
@@ -123,64 +180,78 @@ namespace FastEngine {
     
     const Animation* Animator::GetAnimation(const std::string& name) const {
         auto it = m_animations.find(name);
-        return it != m_animations.end() ? &it->second : nullptr;
+        if (it == m_animations.end()) {
+            return nullptr;
+        }
+        const AnimationClip* clip = AnimationClipLibrary::GetInstance().Get(it->second);
+        return clip ? &clip->source : nullptr;
     }
     
-    void Animator::NextFrame() {
-        auto it = m_animations.find(m_currentAnimation);
-        if (it == m_animations.end()) {
-            return;
+    uint32_t Animator::Step(AnimationPlayback& state, const AnimationClip& clip) {
+        const uint32_t frameCount = clip.GetFrameCount();
+        if (frameCount == 0 || (state.flags & ANIMATION_PLAYING) == 0) {
+            return 0;
+        }
+        if (state.frame >= frameCount) {
+            state.frame = 0;
         }
         
-        const Animation& animation = it->second;
-        int frameCount = static_cast<int>(animation.frames.size());
-        
-        // Вызываем callback смены кадра
-        if (m_onFrameChange) {
-            m_onFrameChange(m_currentFrame);
+        // Большой шаг: целые циклы отбрасываются, фаза сохраняется
+        if (clip.cycleDuration > 0.0f && state.time >= clip.cycleDuration) {
+            state.time = std::fmod(state.time, clip.cycleDuration);
         }
         
-        switch (animation.type) {
-            case AnimationType::Loop:
-                m_currentFrame = (m_currentFrame + 1) % frameCount;
-                break;
+        uint32_t events = 0;
+        while (state.time >= clip.frameDurations[state.frame]) {
+            state.time -= clip.frameDurations[state.frame];
+            
+            switch (clip.source.type) {
+                case AnimationType::Loop:
+                    state.frame = static_cast<uint16_t>((state.frame + 1) % frameCount);
+                    break;
                 
-            case AnimationType::Once:
-                if (m_currentFrame < frameCount - 1) {
-                    m_currentFrame++;
-                } else {
-                    // Анимация завершена
-                    Stop();
-                    if (m_onAnimationComplete) {
-                        m_onAnimationComplete(m_currentAnimation);
+                case AnimationType::Once:
+                    if (state.frame + 1u >= frameCount) {
+                        // Анимация завершена, остается последний кадр
+                        state.time = 0.0f;
+                        state.flags = 0;
+                        return events | EVENT_COMPLETED;
                     }
-                }
-                break;
+                    state.frame++;
+                    break;
                 
-            case AnimationType::PingPong:
-                static bool forward = true;
-                if (forward) {
-                    if (m_currentFrame < frameCount - 1) {
-                        m_currentFrame++;
-                    } else {
-                        forward = false;
-                        m_currentFrame--;
+                case AnimationType::PingPong: {
+                    if (frameCount == 1) {
+                        break;
                     }
-                } else {
-                    if (m_currentFrame > 0) {
-                        m_currentFrame--;
-                    } else {
-                        forward = true;
-                        m_currentFrame++;
+                    int next = state.frame + state.direction;
+                    if (next < 0 || next >= static_cast<int>(frameCount)) {
+                        state.direction = static_cast<int8_t>(-state.direction);
+                        next = state.frame + state.direction;
                     }
+                    state.frame = static_cast<uint16_t>(next);
+                    break;
                 }
-                break;
+            }
+            events |= EVENT_FRAME_CHANGED;
         }
+        return events;
     }
     
-    void Animator::ResetAnimation() {
-        m_currentFrame = 0;
-        m_frameTimer = 0.0f;
+    void Animator::DispatchEvents(uint32_t events, const AnimationPlayback& state) {
+        if ((events & EVENT_FRAME_CHANGED) && m_onFrameChange) {
+            m_onFrameChange(state.frame);
+        }
+        if ((events & EVENT_COMPLETED) && m_onAnimationComplete) {
+            const AnimationClip* clip = AnimationClipLibrary::GetInstance().Get(state.clip);
+            m_onAnimationComplete(clip ? clip->GetName() : std::string());
+        }
+    }
+    
+    void Animator::RebuildNames() {
+        m_names.clear();
+        for (const auto& pair : m_animations) {
+            m_names.push_back(pair.first);
+        }
     }
 }
-
@@ -1,10 +1,21 @@
 #include "FastEngine/Components/AudioSource.h"
 #include "FastEngine/Audio/Sound.h"
 #include <algorithm>
+#include <cmath>
+#include <iostream>
 
 namespace FastEngine {
+    namespace {
+        // Запаздывание микшера относительно отсчета времени источника
+        constexpr float END_TOLERANCE = 0.1f;
+        // Изменения меньше порога не отправляются в микшер
+        constexpr float PARAM_EPSILON = 0.001f;
+    }
+    
     AudioSource::AudioSource() 
-        : m_state(AudioState::Stopped)
+        : m_mixer(nullptr)
+        , m_streamer(nullptr)
+        , m_state(AudioState::Stopped)
         , m_audioType(AudioType::SFX)
         , m_volume(1.0f)
         , m_pitch(1.0f)
@@ -16,6 +27,13 @@ namespace FastEngine {
         , m_rolloffFactor(1.0f)
         , m_priority(0)
         , m_autoPlay(false)
+        , m_hasVoice(false)
+        , m_playbackTime(0.0f)
+        , m_spatialGain(1.0f)
+        , m_spatialPan(0.0f)
+        , m_voiceVolume(0.0f)
+        , m_voicePan(0.0f)
+        , m_voicePitch(1.0f)
         , m_fadingIn(false)
         , m_fadingOut(false)
         , m_fadeDuration(0.0f)
@@ -39,10 +57,10 @@ namespace FastEngine {
             return;
         }
         
+        // Повторный Play начинает сначала; голос выдаст AudioSystem
+        Virtualize();
         m_state = AudioState::Playing;
-        
-        // Здесь должен быть вызов m_sound->Play()
-        // В реальной реализации это будет зависеть от конкретной аудио системы
+        m_playbackTime = 0.0f;
         
         if (m_onPlaybackStart) {
             m_onPlaybackStart();
@@ -56,8 +74,8 @@ namespace FastEngine {
         
         m_state = AudioState::Stopped;
         StopFade();
-        
-        // Здесь должен быть вызов m_sound->Stop()
+        Virtualize();
+        m_playbackTime = 0.0f;
     }
     
     void AudioSource::Pause() {
@@ -65,9 +83,9 @@ namespace FastEngine {
             return;
         }
         
+        // Пауза освобождает голос: позиция сохранена в m_playbackTime
         m_state = AudioState::Paused;
-        
-        // Здесь должен быть вызов m_sound->Pause()
+        Virtualize();
     }
     
     void AudioSource::Resume() {
@@ -76,17 +94,20 @@ namespace FastEngine {
         }
         
         m_state = AudioState::Playing;
-        
-        // Здесь должен быть вызов m_sound->Resume()
     }
     
     bool AudioSource::LoadSound(const std::string& filePath) {
-        // В реальной реализации здесь бы создавался Sound объект
-        // Для простоты просто сохраняем путь
-        m_soundPath = filePath;
-        m_sound = std::make_shared<Sound>();
+        UnloadSound();
         
-        // Здесь должен быть вызов m_sound->LoadFromFile(filePath)
+        // Декодированные данные общие через AudioClipCache, Sound - только голос
+        auto sound = std::make_shared<Sound>();
+        if (!sound->LoadFromFile(filePath)) {
+            std::cerr << "AudioSource: Failed to load sound: " << filePath << std::endl;
+            return false;
+        }
+        sound->SetOutput(m_mixer, m_streamer);
+        m_sound = std::move(sound);
+        m_soundPath = filePath;
         
         if (m_autoPlay) {
             Play();
@@ -101,28 +122,17 @@ namespace FastEngine {
         m_soundPath.clear();
     }
     
+    // Громкость, высота и панорама применяются к голосу в проходе AudioSystem
     void AudioSource::SetVolume(float volume) {
         m_volume = std::clamp(volume, 0.0f, 1.0f);
-        
-        if (m_sound) {
-            // Здесь должен быть вызов m_sound->SetVolume(m_volume)
-        }
     }
     
     void AudioSource::SetPitch(float pitch) {
         m_pitch = std::max(0.1f, pitch);
-        
-        if (m_sound) {
-            // Здесь должен быть вызов m_sound->SetPitch(m_pitch)
-        }
     }
     
     void AudioSource::SetPan(float pan) {
         m_pan = std::clamp(pan, -1.0f, 1.0f);
-        
-        if (m_sound) {
-            // Здесь должен быть вызов m_sound->SetPan(m_pan)
-        }
     }
     
     void AudioSource::Update(float deltaTime) {
@@ -131,29 +141,115 @@ namespace FastEngine {
         }
         
         UpdateFade(deltaTime);
+        if (m_state != AudioState::Playing) {
+            return;
+        }
         UpdateTemporaryEffects(deltaTime);
-        Apply3DPositioning();
+        UpdatePlayback(deltaTime);
+    }
+    
+    void AudioSource::SetOutput(AudioMixer* mixer, AudioStreamer* streamer) {
+        Virtualize();
+        m_mixer = mixer;
+        m_streamer = streamer;
+        if (m_sound) {
+            m_sound->SetOutput(mixer, streamer);
+        }
+    }
+    
+    bool AudioSource::StartVoice() {
+        if (!m_sound || !m_mixer || m_state != AudioState::Playing) {
+            return false;
+        }
+        if (m_hasVoice) {
+            return true;
+        }
+        
+        m_voiceVolume = GetEffectiveVolume() * m_spatialGain;
+        m_voicePan = m_spatialPan;
+        m_voicePitch = GetEffectivePitch();
+        m_sound->SetLooping(m_looping);
+        m_sound->SetPriority(m_priority);
+        m_sound->SetVolume(m_voiceVolume);
+        m_sound->SetPan(m_voicePan);
+        m_sound->SetPitch(m_voicePitch);
+        m_sound->Play(m_playbackTime);
+        m_hasVoice = m_sound->IsPlaying();
+        return m_hasVoice;
+    }
+    
+    void AudioSource::SetSpatialParams(float gain, float pan) {
+        m_spatialGain = gain;
+        m_spatialPan = pan;
+        if (!m_hasVoice) {
+            return;
+        }
+        
+        float volume = GetEffectiveVolume() * gain;
+        if (std::abs(volume - m_voiceVolume) > PARAM_EPSILON) {
+            m_voiceVolume = volume;
+            m_sound->SetVolume(volume);
+        }
+        if (std::abs(pan - m_voicePan) > PARAM_EPSILON) {
+            m_voicePan = pan;
+            m_sound->SetPan(pan);
+        }
+        float pitch = GetEffectivePitch();
+        if (std::abs(pitch - m_voicePitch) > PARAM_EPSILON) {
+            m_voicePitch = pitch;
+            m_sound->SetPitch(pitch);
+        }
+    }
+    
+    void AudioSource::Virtualize() {
+        if (m_hasVoice) {
+            m_sound->Stop();
+            m_hasVoice = false;
+        }
+    }
+    
+    void AudioSource::UpdatePlayback(float deltaTime) {
+        if (!m_sound) {
+            return;
+        }
+        
+        float duration = m_sound->GetDuration();
+        m_playbackTime += deltaTime * GetEffectivePitch();
+        
+        if (m_hasVoice && !m_sound->IsPlaying()) {
+            // Голос доиграл или вытеснен микшером: во втором случае
+            // источник становится виртуальным до следующего прохода
+            m_hasVoice = false;
+            if (!m_looping && m_playbackTime >= duration - END_TOLERANCE) {
+                CompletePlayback();
+                return;
+            }
+        }
         
-        // Проверяем, завершилось ли воспроизведение
-        // В реальной реализации это проверялось бы через аудио систему
-        // if (m_sound && m_sound->IsFinished()) {
-        //     if (m_looping) {
-        //         Play();
-        //     } else {
-        //         Stop();
-        //         if (m_onPlaybackComplete) {
-        //             m_onPlaybackComplete();
-        //         }
-        //     }
-        // }
+        if (duration <= 0.0f || m_playbackTime < duration) {
+            return;
+        }
+        if (m_looping) {
+            m_playbackTime = std::fmod(m_playbackTime, duration);
+        } else if (!m_hasVoice || m_playbackTime >= duration + END_TOLERANCE) {
+            // Реальный голос сообщает о конце сам; запас - если микшер стоит
+            CompletePlayback();
+        }
+    }
+    
+    void AudioSource::CompletePlayback() {
+        Stop();
+        if (m_onPlaybackComplete) {
+            m_onPlaybackComplete();
+        }
     }
     
     void AudioSource::SetOnPlaybackComplete(std::function<void()> callback) {
-        m_onPlaybackComplete = callback;
+        m_onPlaybackComplete = std::move(callback);
     }
     
     void AudioSource::SetOnPlaybackStart(std::function<void()> callback) {
-        m_onPlaybackStart = callback;
+        m_onPlaybackStart = std::move(callback);
     }
     
     void AudioSource::FadeIn(float duration) {
@@ -167,10 +263,6 @@ namespace FastEngine {
         m_fadeTimer = 0.0f;
         m_originalVolume = m_volume;
         m_volume = 0.0f;
-        
-        if (m_sound) {
-            // m_sound->SetVolume(0.0f);
-        }
     }
     
     void AudioSource::FadeOut(float duration) {
@@ -228,65 +320,25 @@ namespace FastEngine {
                 Stop();
             }
         }
-        
-        if (m_sound) {
-            // m_sound->SetVolume(m_volume);
-        }
     }
     
     void AudioSource::UpdateTemporaryEffects(float deltaTime) {
         if (m_tempVolumeActive) {
             m_tempTimer += deltaTime;
             if (m_tempTimer >= m_tempDuration) {
+                // Дальше действует оригинальный volume
                 m_tempVolumeActive = false;
                 m_tempTimer = 0.0f;
-                // Восстанавливаем оригинальный volume
-                if (m_sound) {
-                    // m_sound->SetVolume(m_volume);
-                }
-            } else {
-                // Применяем временный volume
-                if (m_sound) {
-                    // m_sound->SetVolume(m_tempVolume);
-                }
             }
         }
         
         if (m_tempPitchActive) {
             m_tempTimer += deltaTime;
             if (m_tempTimer >= m_tempDuration) {
+                // Дальше действует оригинальный pitch
                 m_tempPitchActive = false;
                 m_tempTimer = 0.0f;
-                // Восстанавливаем оригинальный pitch
-                if (m_sound) {
-                    // m_sound->SetPitch(m_pitch);
-                }
-            } else {
-                // Применяем временный pitch
-                if (m_sound) {
-                    // m_sound->SetPitch(m_tempPitch);
-                }
             }
         }
     }
-    
-    void AudioSource::Apply3DPositioning() {
-        if (!m_3DEnabled || !m_sound) {
-            return;
-        }
-        
-        // В реальной реализации здесь бы вычислялись 3D параметры
-        // на основе позиции объекта, слушателя и настроек дистанции
-        
-        // Получаем позицию объекта (через Transform компонент)
-        // glm::vec3 position = GetEntity()->GetComponent<Transform>()->GetPosition();
-        
-        // Вычисляем расстояние до слушателя
-        // float distance = glm::length(position - listenerPosition);
-        
-        // Применяем rolloff
-        // float volumeMultiplier = CalculateVolumeRolloff(distance);
-        // m_sound->SetVolume(m_volume * volumeMultiplier);
-    }
 }
-
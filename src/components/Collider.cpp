@@ -1,5 +1,6 @@
 #include "FastEngine/Components/Collider.h"
 #include "FastEngine/Entity.h"
+#include "FastEngine/Memory/LinearArena.h"
 #include <cmath>
 
 namespace FastEngine {
@@ -57,17 +58,18 @@ namespace FastEngine {
             return Polygon();
         }
         
-        std::vector<glm::vec2> transformedVertices;
-        transformedVertices.reserve(m_vertices.size());
-        
+        Polygon polygon;
+        polygon.vertices.resize(m_vertices.size());
+        TransformVertices(position, rotation, polygon.vertices.data());
+        return polygon;
+    }
+    
+    void Collider::TransformVertices(const glm::vec2& position, float rotation, glm::vec2* out) const {
         glm::vec2 center = position + m_offset;
         
-        for (const auto& vertex : m_vertices) {
-            glm::vec2 transformed = center + RotatePoint(vertex, glm::vec2(0.0f), rotation);
-            transformedVertices.push_back(transformed);
+        for (size_t i = 0; i < m_vertices.size(); ++i) {
+            out[i] = center + RotatePoint(m_vertices[i], glm::vec2(0.0f), rotation);
         }
-        
-        return Polygon(transformedVertices);
     }
     
     bool Collider::CheckCollision(const Collider& other, const glm::vec2& thisPos, const glm::vec2& otherPos) const {
@@ -98,9 +100,16 @@ namespace FastEngine {
             return CollisionSystem::AABBvsCircle(otherAABB, thisCircle);
         }
         else if (m_type == ColliderType::Polygon && other.m_type == ColliderType::Polygon) {
-            Polygon thisPolygon = GetPolygon(thisPos);
-            Polygon otherPolygon = other.GetPolygon(otherPos);
-            return CollisionSystem::SATvsSAT(thisPolygon, otherPolygon);
+            // Вершины во временной памяти кадра, освобождаются на выходе
+            ArenaScope scope(FrameArena::Get());
+            glm::vec2* thisVertices = scope.GetArena().AllocateArray<glm::vec2>(m_vertices.size());
+            glm::vec2* otherVertices = scope.GetArena().AllocateArray<glm::vec2>(other.m_vertices.size());
+            if (!thisVertices || !otherVertices) {
+                return false;
+            }
+            TransformVertices(thisPos, 0.0f, thisVertices);
+            other.TransformVertices(otherPos, 0.0f, otherVertices);
+            return CollisionSystem::SATvsSAT(thisVertices, m_vertices.size(), otherVertices, other.m_vertices.size());
         }
         
         return false;
@@ -134,28 +143,34 @@ namespace FastEngine {
             return CollisionSystem::AABBvsCircleInfo(otherAABB, thisCircle);
         }
         else if (m_type == ColliderType::Polygon && other.m_type == ColliderType::Polygon) {
-            Polygon thisPolygon = GetPolygon(thisPos);
-            Polygon otherPolygon = other.GetPolygon(otherPos);
-            return CollisionSystem::SATvsSATInfo(thisPolygon, otherPolygon);
+            ArenaScope scope(FrameArena::Get());
+            glm::vec2* thisVertices = scope.GetArena().AllocateArray<glm::vec2>(m_vertices.size());
+            glm::vec2* otherVertices = scope.GetArena().AllocateArray<glm::vec2>(other.m_vertices.size());
+            if (!thisVertices || !otherVertices) {
+                return CollisionInfo();
+            }
+            TransformVertices(thisPos, 0.0f, thisVertices);
+            other.TransformVertices(otherPos, 0.0f, otherVertices);
+            return CollisionSystem::SATvsSATInfo(thisVertices, m_vertices.size(), otherVertices, other.m_vertices.size());
         }
         
         return CollisionInfo();
     }
     
     void Collider::SetOnCollisionEnter(std::function<void(Entity*, const CollisionInfo&)> callback) {
-        m_onCollisionEnter = callback;
+        m_onCollisionEnter = std::move(callback);
     }
     
     void Collider::SetOnCollisionExit(std::function<void(Entity*)> callback) {
-        m_onCollisionExit = callback;
+        m_onCollisionExit = std::move(callback);
     }
     
     void Collider::SetOnTriggerEnter(std::function<void(Entity*)> callback) {
-        m_onTriggerEnter = callback;
+        m_onTriggerEnter = std::move(callback);
     }
     
     void Collider::SetOnTriggerExit(std::function<void(Entity*)> callback) {
-        m_onTriggerExit = callback;
+        m_onTriggerExit = std::move(callback);
     }
     
     void Collider::OnCollisionEnter(Entity* other, const CollisionInfo& info) {
@@ -0,0 +1,84 @@
+#include "FastEngine/Components/SkeletalAnimator.h"
+#include <iostream>
+
+namespace FastEngine {
+    SkeletalAnimator::SkeletalAnimator(std::shared_ptr<const Skeleton> skeleton)
+        : m_skeleton(std::move(skeleton))
+        , m_time(0.0f)
+        , m_speed(1.0f)
+        , m_paused(false)
+        , m_cpuSkinning(false) {
+        if (m_skeleton) {
+            m_pose.SetBind(*m_skeleton);
+            m_model.resize(m_skeleton->GetBoneCount(), BoneMatrix::Identity());
+            m_skinning.resize(m_skeleton->GetBoneCount(), BoneMatrix::Identity());
+        }
+    }
+
+    SkeletalAnimator::~SkeletalAnimator() = default;
+
+    bool SkeletalAnimator::SetBlendTree(std::shared_ptr<const BlendTree> tree) {
+        if (tree && (!m_skeleton || tree->GetBoneCount() != m_skeleton->GetBoneCount())) {
+            std::cerr << "SkeletalAnimator: blend tree does not match the skeleton" << std::endl;
+            return false;
+        }
+
+        m_tree = std::move(tree);
+        m_time = 0.0f;
+        m_parameters.clear();
+        if (m_tree) {
+            for (uint32_t i = 0; i < m_tree->GetParameterCount(); ++i) {
+                m_parameters.push_back(m_tree->GetParameterDefault(i));
+            }
+        }
+        return true;
+    }
+
+    bool SkeletalAnimator::Play(std::shared_ptr<const SkeletalClip> clip) {
+        std::shared_ptr<BlendTree> tree = BlendTree::FromClip(std::move(clip));
+        return tree && SetBlendTree(tree);
+    }
+
+    void SkeletalAnimator::SetParameter(uint32_t parameter, float value) {
+        if (parameter < m_parameters.size()) {
+            m_parameters[parameter] = value;
+        }
+    }
+
+    bool SkeletalAnimator::SetParameter(const std::string& name, float value) {
+        int parameter = m_tree ? m_tree->FindParameter(name) : -1;
+        if (parameter < 0) {
+            return false;
+        }
+        m_parameters[parameter] = value;
+        return true;
+    }
+
+    void SkeletalAnimator::Update(float deltaTime) {
+        Advance(deltaTime);
+        if (!m_context) {
+            m_context = std::make_unique<BlendTreeContext>();
+        }
+        Evaluate(*m_context);
+    }
+
+    void SkeletalAnimator::Advance(float deltaTime) {
+        if (!m_paused) {
+            m_time += deltaTime * m_speed;
+        }
+    }
+
+    void SkeletalAnimator::Evaluate(BlendTreeContext& context) {
+        if (!CanEvaluate()) {
+            return;
+        }
+
+        m_tree->Evaluate(m_time, m_parameters.data(), context, m_pose);
+        LocalToModel(*m_skeleton, m_pose, m_model.data());
+        ComputeSkinningMatrices(*m_skeleton, m_model.data(), m_skinning.data());
+
+        if (m_cpuSkinning && m_mesh) {
+            SkinVertices(*m_mesh, m_skinning.data(), m_skinnedPositions, m_skinnedNormals);
+        }
+    }
+}
@@ -7,6 +7,7 @@ namespace FastEngine {
         : m_texture(nullptr)
         , m_size(64.0f, 64.0f)
         , m_color(1.0f, 1.0f, 1.0f, 1.0f)
+        , m_uvRect(0.0f, 0.0f, 1.0f, 1.0f)
         , m_visible(true) {
         // Загружаем текстуру
         m_texture = new Texture();
@@ -20,6 +21,7 @@ namespace FastEngine {
         : m_texture(texture)
         , m_size(64.0f, 64.0f)
         , m_color(1.0f, 1.0f, 1.0f, 1.0f)
+        , m_uvRect(0.0f, 0.0f, 1.0f, 1.0f)
         , m_visible(true) {
         // Если текстура не предоставлена, создаем цветную
         if (!m_texture) {
@@ -1,8 +1,59 @@
 #include "FastEngine/Components/Text.h"
 #include <algorithm>
-#include <sstream>
+#include <cctype>
 
 namespace FastEngine {
+    namespace {
+        bool IsSpace(char c) {
+            return std::isspace(static_cast<unsigned char>(c)) != 0;
+        }
+        
+        // Перенос по словам без выделений памяти. Для каждой строки
+        // visitor получает начало первого слова, конец последнего и длину
+        // строки, в которой слова разделены одним пробелом
+        template<typename Visitor>
+        void VisitWrappedLines(const std::string& text, float maxWidth, int fontSize, Visitor&& visitor) {
+            size_t lineBegin = 0;
+            size_t lineEnd = 0;
+            size_t lineLength = 0;
+            float currentWidth = 0.0f;
+            
+            size_t i = 0;
+            while (true) {
+                while (i < text.size() && IsSpace(text[i])) ++i;
+                if (i >= text.size()) break;
+                size_t wordBegin = i;
+                while (i < text.size() && !IsSpace(text[i])) ++i;
+                size_t wordLength = i - wordBegin;
+                
+                // Упрощенная реализация переноса слов
+                // В реальной реализации здесь бы учитывалась ширина символов
+                float wordWidth = wordLength * fontSize * 0.6f; // Примерная ширина символа
+                
+                if (currentWidth + wordWidth > maxWidth && lineLength > 0) {
+                    visitor(lineBegin, lineEnd, lineLength);
+                    lineBegin = wordBegin;
+                    lineLength = wordLength;
+                    currentWidth = wordWidth;
+                } else {
+                    if (lineLength > 0) {
+                        lineLength++;
+                        currentWidth += fontSize * 0.3f; // Примерная ширина пробела
+                    } else {
+                        lineBegin = wordBegin;
+                    }
+                    lineLength += wordLength;
+                    currentWidth += wordWidth;
+                }
+                lineEnd = i;
+            }
+            
+            if (lineLength > 0) {
+                visitor(lineBegin, lineEnd, lineLength);
+            }
+        }
+    }
+    
     Text::Text() 
         : m_text("")
         , m_fontSize(16)
@@ -59,7 +110,7 @@ namespace FastEngine {
     }
     
     void Text::SetOnTextChanged(std::function<void(const std::string&)> callback) {
-        m_onTextChanged = callback;
+        m_onTextChanged = std::move(callback);
     }
     
     std::vector<std::string> Text::GetWrappedLines() const {
@@ -71,7 +122,13 @@ namespace FastEngine {
     }
     
     int Text::GetLineCount() const {
-        return static_cast<int>(GetWrappedLines().size());
+        if (!m_wrapText || m_maxWidth <= 0.0f) {
+            return 1;
+        }
+        
+        int count = 0;
+        VisitWrappedLines(m_text, m_maxWidth, m_fontSize, [&count](size_t, size_t, size_t) { count++; });
+        return count;
     }
     
     int Text::GetCharacterCount() const {
@@ -95,36 +152,20 @@ namespace FastEngine {
     
     std::vector<std::string> Text::WrapText(const std::string& text, float maxWidth) const {
         std::vector<std::string> lines;
-        std::istringstream iss(text);
-        std::string word;
-        std::string currentLine;
-        
-        // Упрощенная реализация переноса слов
-        // В реальной реализации здесь бы учитывалась ширина символов
-        float currentWidth = 0.0f;
-        float wordWidth = 0.0f;
-        
-        while (iss >> word) {
-            wordWidth = word.length() * m_fontSize * 0.6f; // Примерная ширина символа
-            
-            if (currentWidth + wordWidth > maxWidth && !currentLine.empty()) {
-                lines.push_back(currentLine);
-                currentLine = word;
-                currentWidth = wordWidth;
-            } else {
-                if (!currentLine.empty()) {
-                    currentLine += " ";
-                    currentWidth += m_fontSize * 0.3f; // Примерная ширина пробела
+        VisitWrappedLines(text, maxWidth, m_fontSize, [&text, &lines](size_t begin, size_t end, size_t length) {
+            std::string line;
+            line.reserve(length);
+            for (size_t i = begin; i < end;) {
+                while (IsSpace(text[i])) ++i;
+                size_t wordBegin = i;
+                while (i < end && !IsSpace(text[i])) ++i;
+                if (!line.empty()) {
+                    line += ' ';
                 }
-                currentLine += word;
-                currentWidth += wordWidth;
+                line.append(text, wordBegin, i - wordBegin);
             }
-        }
-        
-        if (!currentLine.empty()) {
-            lines.push_back(currentLine);
-        }
-        
+            lines.push_back(std::move(line));
+        });
         return lines;
     }
     
@@ -135,18 +176,23 @@ namespace FastEngine {
         
         // Упрощенный расчет размера текста
         // В реальной реализации здесь бы использовались метрики шрифта
-        
-        std::vector<std::string> lines = m_wrapText ? WrapText(text, m_maxWidth) : std::vector<std::string>{text};
+        // Строки переноса не собираются - нужны только их длины
         
         float maxWidth = 0.0f;
-        for (const auto& line : lines) {
-            float lineWidth = line.length() * m_fontSize * 0.6f; // Примерная ширина символа
+        size_t lineCount = 0;
+        auto measure = [this, &maxWidth, &lineCount](size_t, size_t, size_t length) {
+            float lineWidth = length * m_fontSize * 0.6f; // Примерная ширина символа
             maxWidth = std::max(maxWidth, lineWidth);
+            lineCount++;
+        };
+        if (m_wrapText) {
+            VisitWrappedLines(text, m_maxWidth, m_fontSize, measure);
+        } else {
+            measure(0, text.size(), text.size());
         }
         
-        float height = lines.size() * m_fontSize * m_lineSpacing;
+        float height = lineCount * m_fontSize * m_lineSpacing;
         
         return glm::vec2(maxWidth, height);
     }
 }
-
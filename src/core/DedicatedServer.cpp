@@ -0,0 +1,119 @@
+#include "FastEngine/DedicatedServer.h"
+#include "FastEngine/World.h"
+#include <iomanip>
+#include <iostream>
+
+namespace FastEngine {
+    DedicatedServer::Match::Match(const FixedTickConfig& config)
+        : world(std::make_unique<World>())
+        , loop(config)
+        , running(false) {
+    }
+
+    DedicatedServer::DedicatedServer(const FixedTickConfig& config)
+        : m_config(config)
+        , m_running(false) {
+    }
+
+    DedicatedServer::~DedicatedServer() {
+        Stop();
+    }
+
+    size_t DedicatedServer::AddMatch(TickCallback onTick, SetupCallback setup) {
+        m_matches.push_back(std::make_unique<Match>(m_config));
+        Match& match = *m_matches.back();
+        match.onTick = std::move(onTick);
+        if (setup) {
+            setup(*match.world);
+        }
+        if (m_running) {
+            StartMatch(match);
+        }
+        return m_matches.size() - 1;
+    }
+
+    void DedicatedServer::StopMatch(size_t match) {
+        if (match >= m_matches.size()) {
+            return;
+        }
+        Match& entry = *m_matches[match];
+        entry.running.store(false, std::memory_order_release);
+        if (entry.thread.joinable()) {
+            entry.thread.join();
+        }
+    }
+
+    bool DedicatedServer::Start() {
+        if (m_running) {
+            return true;
+        }
+        m_running = true;
+        for (auto& match : m_matches) {
+            StartMatch(*match);
+        }
+        std::cout << "DedicatedServer: Started " << m_matches.size() << " matches at "
+                  << m_config.tickRate << " ticks per second" << std::endl;
+        return true;
+    }
+
+    void DedicatedServer::Stop() {
+        if (!m_running) {
+            return;
+        }
+        // Сначала сигнал всем матчам, затем ожидание - остановка за один тик
+        for (auto& match : m_matches) {
+            match->running.store(false, std::memory_order_release);
+        }
+        for (size_t i = 0; i < m_matches.size(); ++i) {
+            StopMatch(i);
+        }
+        m_running = false;
+    }
+
+    void DedicatedServer::StartMatch(Match& match) {
+        if (match.thread.joinable()) {
+            return;
+        }
+        match.running.store(true, std::memory_order_release);
+        match.thread = std::thread([&match]() {
+            match.loop.Run([&match](float deltaTime, uint64_t tick) {
+                if (match.onTick) {
+                    match.onTick(*match.world, deltaTime, tick);
+                }
+                match.world->Update(deltaTime);
+            }, match.running);
+        });
+    }
+
+    World* DedicatedServer::GetWorld(size_t match) const {
+        return match < m_matches.size() ? m_matches[match]->world.get() : nullptr;
+    }
+
+    bool DedicatedServer::IsMatchRunning(size_t match) const {
+        return match < m_matches.size() && m_matches[match]->running.load(std::memory_order_acquire);
+    }
+
+    TickStats DedicatedServer::GetMatchStats(size_t match) const {
+        return match < m_matches.size() ? m_matches[match]->loop.GetStats() : TickStats();
+    }
+
+    void DedicatedServer::WriteStats(std::ostream& out) const {
+        // Строка на матч: match ticks overruns dropped avg_ms p99_ms max_ms wake_avg_ms wake_max_ms load
+        std::ios::fmtflags flags = out.flags();
+        out << std::fixed << std::setprecision(3);
+        for (size_t i = 0; i < m_matches.size(); ++i) {
+            TickStats stats = m_matches[i]->loop.GetStats();
+            out << "match " << i
+                << " ticks " << stats.ticks
+                << " overruns " << stats.overruns
+                << " dropped " << stats.droppedTicks
+                << " avg_ms " << stats.averageTickMs
+                << " p99_ms " << stats.p99TickMs
+                << " max_ms " << stats.maxTickMs
+                << " wake_avg_ms " << stats.averageWakeErrorMs
+                << " wake_max_ms " << stats.maxWakeErrorMs
+                << " load " << stats.load << '\n';
+        }
+        out.flags(flags);
+    }
+}
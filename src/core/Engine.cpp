@@ -6,15 +6,26 @@
 #include "FastEngine/Platform/Platform.h"
 #include "FastEngine/Platform/Window.h"
 #include "FastEngine/Platform/Timer.h"
+#include "FastEngine/Jobs/JobSystem.h"
+#include "FastEngine/Memory/LinearArena.h"
+#include "FastEngine/Profiling/QuantileSketch.h"
+#include "FastEngine/Profiling/ScopeProfiler.h"
+#include "FastEngine/Profiling/TraceCapture.h"
 #include "FastEngine/Systems/RenderSystem.h"
+#include "FastEngine/Systems/AudioSystem.h"
 #include <iostream>
 
 namespace FastEngine {
     Engine::Engine() 
-        : m_running(false)
+        : m_replayFrame(0)
+        , m_running(false)
+        , m_headless(false)
+        , m_ownsJobSystem(false)
         , m_deltaTime(0.0f)
         , m_fps(0.0f)
         , m_lastFrameTime(0.0f)
+        , m_fpsTimer(0.0f)
+        , m_framesInSecond(0)
         , m_frameCount(0) {
     }
     
@@ -34,6 +45,7 @@ namespace FastEngine {
         m_audioManager = std::make_unique<AudioManager>();
         m_inputManager = std::make_unique<InputManager>();
         m_renderSystem = std::make_unique<RenderSystem>(m_world.get(), m_renderer.get());
+        m_audioSystem = std::make_unique<AudioSystem>(m_world.get(), m_audioManager.get());
         
         // Инициализация рендерера (после создания окна)
         if (!m_renderer->Initialize(width, height)) {
@@ -74,6 +86,57 @@ namespace FastEngine {
             m_renderSystem->Initialize();
         }
         
+        // Общий планировщик запускается последним: ранние return false его не оставляют
+        // работать; если его уже запустило приложение, Engine его не останавливает
+        m_ownsJobSystem = JobSystem::GetInstance().Start();
+        m_running = true;
+        return true;
+    }
+    
+    bool Engine::InitializeHeadless(const FixedTickConfig& config) {
+        if (m_running) {
+            std::cerr << "Engine: Already initialized" << std::endl;
+            return false;
+        }
+        
+        m_headless = true;
+        m_world = std::make_unique<World>();
+        m_tickLoop = std::make_unique<FixedTickLoop>(config);
+        m_deltaTime = m_tickLoop->GetDeltaTime();
+        m_fps = m_tickLoop->GetConfig().tickRate;
+        
+        std::cout << "Engine: Headless mode, " << m_fps << " ticks per second" << std::endl;
+        m_ownsJobSystem = JobSystem::GetInstance().Start();
+        m_running = true;
+        return true;
+    }
+    
+    bool Engine::InitializeReplay(std::shared_ptr<const InputRecording> recording, const ReplayConfig& config) {
+        if (m_running) {
+            std::cerr << "Engine: Already initialized" << std::endl;
+            return false;
+        }
+        if (!recording || recording->IsEmpty()) {
+            std::cerr << "Engine: Empty input recording" << std::endl;
+            return false;
+        }
+        
+        m_headless = true;
+        m_world = std::make_unique<World>();
+        m_inputManager = std::make_unique<InputManager>();
+        if (!m_inputManager->Initialize()) {
+            return false;
+        }
+        
+        m_replay = std::move(recording);
+        m_replayConfig = config;
+        m_replayFrame = 0;
+        m_replayFrameTimes = std::make_unique<QuantileSketch>();
+        m_frameCount = 0;
+        
+        std::cout << "Engine: Replaying " << m_replay->GetFrameCount() << " frames ("
+                  << m_replay->GetDuration() << " s recorded)" << std::endl;
+        m_ownsJobSystem = JobSystem::GetInstance().Start();
         m_running = true;
         return true;
     }
@@ -83,6 +146,11 @@ namespace FastEngine {
             m_renderSystem->Cleanup();
         }
         
+        // Источники отключаются от микшера до его уничтожения
+        if (m_audioSystem) {
+            m_audioSystem->Cleanup();
+        }
+        
         if (m_audioManager) {
             m_audioManager->Shutdown();
         }
@@ -95,18 +163,42 @@ namespace FastEngine {
             m_inputManager->Shutdown();
         }
         
-        Platform::GetInstance().Shutdown();
+        if (!m_headless) {
+            Platform::GetInstance().Shutdown();
+        }
+        
+        // Задания могут ссылаться на мир - дожидаемся их до его уничтожения
+        if (m_ownsJobSystem) {
+            JobSystem::GetInstance().Stop();
+            m_ownsJobSystem = false;
+        }
         
         m_world.reset();
         m_renderer.reset();
         m_audioManager.reset();
         m_inputManager.reset();
         m_renderSystem.reset();
+        m_audioSystem.reset();
+        m_tickLoop.reset();
+        m_replay.reset();
         
         m_running = false;
     }
     
     void Engine::Run() {
+        if (m_replay) {
+            while (m_running) {
+                RunReplayFrame();
+            }
+            return;
+        }
+        if (m_headless) {
+            m_tickLoop->Run([this](float deltaTime, uint64_t) {
+                m_frameCount++;
+                Update(deltaTime);
+            }, m_running);
+            return;
+        }
         while (m_running && !Platform::GetInstance().ShouldClose()) {
             RunOneFrame();
         }
@@ -115,6 +207,19 @@ namespace FastEngine {
     void Engine::RunOneFrame() {
         if (!m_running) return;
         
+        if (m_replay) {
+            RunReplayFrame();
+            return;
+        }
+        
+        if (m_headless) {
+            m_tickLoop->Step([this](float deltaTime, uint64_t) {
+                m_frameCount++;
+                Update(deltaTime);
+            });
+            return;
+        }
+        
         // Синхронизируем размер рендерера с окном (важно при смене ориентации на iOS)
         Window* win = Platform::GetInstance().GetWindow();
         if (win && m_renderer) {
@@ -134,34 +239,90 @@ namespace FastEngine {
         m_frameCount++;
         
         // Обновление FPS (раз в секунду)
-        static float fpsTimer = 0.0f;
-        static int framesInSecond = 0;
-        fpsTimer += m_deltaTime;
-        framesInSecond++;
-        if (fpsTimer >= 1.0f) {
-            m_fps = static_cast<float>(framesInSecond) / fpsTimer;
-            framesInSecond = 0;
-            fpsTimer = 0.0f;
+        m_fpsTimer += m_deltaTime;
+        m_framesInSecond++;
+        if (m_fpsTimer >= 1.0f) {
+            m_fps = static_cast<float>(m_framesInSecond) / m_fpsTimer;
+            m_framesInSecond = 0;
+            m_fpsTimer = 0.0f;
         }
         
         Platform::GetInstance().PollEvents();
         Update(m_deltaTime);
         Render();
         Platform::GetInstance().Present();
+        if (m_inputManager) {
+            m_inputManager->OnFramePresented();
+        }
     }
     
-    void Engine::Update(float deltaTime) {
-        if (m_world) {
-            m_world->Update(deltaTime);
+    void Engine::RunReplayFrame() {
+        if (m_replayFrame >= m_replay->GetFrameCount()) {
+            m_running = false;
+            return;
+        }
+        
+        // События кадра проходят ту же очередь, что и с платформы; кадр
+        // с числом событий больше емкости очереди теряет лишние
+        const InputRecording::Frame& frame = m_replay->GetFrame(m_replayFrame);
+        const InputEvent* events = m_replay->GetEvents(frame);
+        for (uint32_t i = 0; i < frame.eventCount; ++i) {
+            m_inputManager->InjectEvent(events[i]);
+        }
+        
+        m_deltaTime = m_replayConfig.fixedDeltaTime > 0.0f ? m_replayConfig.fixedDeltaTime : frame.deltaTime;
+        m_frameCount++;
+        
+        uint64_t start = ProfileClock::Now();
+        Update(m_deltaTime);
+        if (m_replayFrame >= m_replayConfig.warmupFrames) {
+            m_replayFrameTimes->Add(ProfileClock::ToMilliseconds(ProfileClock::Now() - start));
+        }
+        m_replayFrame++;
+        
+        if (m_replayFrame >= m_replay->GetFrameCount()) {
+            m_running = false;
         }
+    }
+    
+    void Engine::Update(float deltaTime) {
+        // Граница кадра профилировщика; без запущенного ScopeProfiler - одна проверка флага
+        ScopeProfiler::MarkFrame();
+        // Кадр арены этого потока; арены других циклов не затрагиваются
+        FrameArena::BeginFrame();
+        FASTENGINE_PROFILE_SCOPE("Engine::Update");
         
+        // Снимок ввода публикуется до систем, чтобы весь кадр видел одно состояние
         if (m_inputManager) {
             m_inputManager->Update(deltaTime);
         }
         
+        if (m_updateCallback) {
+            m_updateCallback(deltaTime);
+        }
+        
+        if (m_world) {
+            FASTENGINE_PROFILE_SCOPE("World::Update");
+            m_world->Update(deltaTime);
+            FASTENGINE_TRACE_COUNTER("Entities", m_world->GetEntities().size());
+        }
+        
         if (m_renderSystem) {
+            FASTENGINE_PROFILE_SCOPE("RenderSystem::Update");
             m_renderSystem->Update(deltaTime);
         }
+        
+        // Пространственный проход выдает голоса, затем микшер забирает завершенные
+        if (m_audioSystem) {
+            FASTENGINE_PROFILE_SCOPE("AudioSystem::Update");
+            m_audioSystem->Update(deltaTime);
+        }
+        
+        if (m_audioManager) {
+            m_audioManager->Update();
+        }
+        
+        FASTENGINE_TRACE_COUNTER("Pending jobs", JobSystem::GetInstance().GetPendingCount());
     }
     
     void Engine::Render() {
@@ -171,7 +332,11 @@ namespace FastEngine {
         }
     }
     
+    TickStats Engine::GetTickStats() const {
+        return m_tickLoop ? m_tickLoop->GetStats() : TickStats();
+    }
+    
     std::string Engine::GetPlatformName() const {
-        return Platform::GetInstance().GetPlatformName();
+        return m_headless ? std::string("Headless") : Platform::GetInstance().GetPlatformName();
     }
 }
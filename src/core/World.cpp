@@ -14,18 +14,25 @@ namespace FastEngine {
     World::~World() {
         m_systems.clear();
         m_entities.clear();
+        m_entityIndex.clear();
     }
     
     Entity* World::CreateEntity() {
         auto entity = std::make_unique<Entity>(this);
         Entity* ptr = entity.get();
         m_entities.push_back(std::move(entity));
+        m_entityIndex[ptr->GetID()] = ptr;
         return ptr;
     }
     
     void World::DestroyEntity(Entity* entity) {
         if (!entity) return;
         
+        auto it = m_entityIndex.find(entity->GetID());
+        if (it != m_entityIndex.end() && it->second == entity) {
+            m_entityIndex.erase(it);
+        }
+        
         // Удаляем сущность из списка
         m_entities.erase(
             std::remove_if(m_entities.begin(), m_entities.end(),
@@ -36,6 +43,11 @@ namespace FastEngine {
         );
     }
     
+    Entity* World::GetEntity(size_t id) const {
+        auto it = m_entityIndex.find(id);
+        return it != m_entityIndex.end() ? it->second : nullptr;
+    }
+    
     void World::Update(float deltaTime) {
         // Обновляем все системы
         for (auto& system : m_systems) {
@@ -57,9 +69,25 @@ namespace FastEngine {
         return result;
     }
     
+    template<typename... ComponentTypes>
+    void World::GetEntitiesWithComponents(FrameVector<Entity*>& out) {
+        out.clear();
+        // Резерв в арене дешев и избавляет от копирований при росте
+        out.reserve(m_entities.size());
+        for (auto& entity : m_entities) {
+            if (entity->HasComponents<ComponentTypes...>()) {
+                out.push_back(entity.get());
+            }
+        }
+    }
+    
     // Явная инстанциация для часто используемых типов
     template std::vector<Entity*> World::GetEntitiesWithComponents<Sprite, Transform>();
     template std::vector<Entity*> World::GetEntitiesWithComponents<Animator>();
     template std::vector<Entity*> World::GetEntitiesWithComponents<RigidBody>();
     template std::vector<Entity*> World::GetEntitiesWithComponents<Collider>();
+    template void World::GetEntitiesWithComponents<Sprite, Transform>(FrameVector<Entity*>&);
+    template void World::GetEntitiesWithComponents<Animator>(FrameVector<Entity*>&);
+    template void World::GetEntitiesWithComponents<RigidBody>(FrameVector<Entity*>&);
+    template void World::GetEntitiesWithComponents<Collider>(FrameVector<Entity*>&);
 }
\ No newline at end of file
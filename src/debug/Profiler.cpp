@@ -25,41 +25,50 @@ namespace FastEngine {
         m_minTime = 0.001; // 1ms minimum
         m_totalFrameTime = 0.0;
         m_frameCount = 0;
+        m_nextFrameTime = 0;
         
+        ScopeProfiler::GetInstance().Start();
         return true;
     }
     
     void Profiler::Shutdown() {
+        if (m_initialized && m_enabled) {
+            ScopeProfiler::GetInstance().Stop();
+        }
         m_profiles.clear();
-        m_activeProfiles.clear();
         m_frameTimes.clear();
+        m_nextFrameTime = 0;
         m_initialized = false;
     }
     
-    void Profiler::StartProfile(const std::string& name) {
-        if (!m_enabled || !m_initialized) {
+    void Profiler::SetEnabled(bool enabled) {
+        if (enabled == m_enabled) {
             return;
         }
-        
-        m_activeProfiles[name] = std::chrono::high_resolution_clock::now();
+        m_enabled = enabled;
+        if (m_initialized) {
+            if (enabled) {
+                ScopeProfiler::GetInstance().Start();
+            } else {
+                ScopeProfiler::GetInstance().Stop();
+            }
+        }
     }
     
-    void Profiler::EndProfile(const std::string& name) {
+    void Profiler::StartProfile(const std::string& name) {
         if (!m_enabled || !m_initialized) {
             return;
         }
         
-        auto it = m_activeProfiles.find(name);
-        if (it == m_activeProfiles.end()) {
+        ScopeProfiler::Begin(ProfileNames::Register(name));
+    }
+    
+    void Profiler::EndProfile(const std::string&) {
+        if (!m_enabled || !m_initialized) {
             return;
         }
         
-        auto endTime = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - it->second);
-        double timeMs = duration.count() / 1000.0;
-        
-        UpdateProfileData(name, timeMs);
-        m_activeProfiles.erase(it);
+        ScopeProfiler::End();
     }
     
     const ProfileData* Profiler::GetProfileData(const std::string& name) const {
@@ -99,14 +108,24 @@ namespace FastEngine {
         
         // Обновляем статистику кадров
         double frameTime = deltaTime * 1000.0; // Convert to milliseconds
-        m_frameTimes.push_back(frameTime);
         m_totalFrameTime += frameTime;
         m_frameCount++;
         
-        // Ограничиваем историю
-        if (static_cast<int>(m_frameTimes.size()) > m_maxHistory) {
-            m_frameTimes.erase(m_frameTimes.begin());
+        // Ограничиваем историю: кольцо перезаписывает самую старую запись
+        size_t maxHistory = static_cast<size_t>(std::max(m_maxHistory, 1));
+        if (m_frameTimes.size() > maxHistory) {
+            std::rotate(m_frameTimes.begin(), m_frameTimes.begin() + m_nextFrameTime, m_frameTimes.end());
+            m_frameTimes.erase(m_frameTimes.begin(), m_frameTimes.end() - maxHistory);
+            m_nextFrameTime = 0;
         }
+        if (m_frameTimes.size() < maxHistory) {
+            m_frameTimes.push_back(frameTime);
+        } else {
+            m_frameTimes[m_nextFrameTime] = frameTime;
+            m_nextFrameTime = (m_nextFrameTime + 1) % m_frameTimes.size();
+        }
+        
+        RefreshProfiles();
     }
     
     void Profiler::Render(Renderer* renderer) {
@@ -128,9 +147,10 @@ namespace FastEngine {
     }
     
     void Profiler::Clear() {
+        ScopeProfiler::GetInstance().ResetStats();
         m_profiles.clear();
-        m_activeProfiles.clear();
         m_frameTimes.clear();
+        m_nextFrameTime = 0;
         m_totalFrameTime = 0.0;
         m_frameCount = 0;
     }
@@ -201,31 +221,33 @@ namespace FastEngine {
     }
     
     void Profiler::OnFrameStart() {
-        StartProfile("Frame");
+        static const ProfileNameId frameName = ProfileNames::Register("Frame");
+        if (m_enabled && m_initialized) {
+            ScopeProfiler::Begin(frameName);
+        }
     }
     
     void Profiler::OnFrameEnd() {
-        EndProfile("Frame");
+        if (m_enabled && m_initialized) {
+            ScopeProfiler::End();
+        }
     }
     
-    void Profiler::UpdateProfileData(const std::string& name, double time) {
-        if (time < m_minTime) {
-            return;
-        }
-        
-        ProfileData& data = m_profiles[name];
-        data.name = name;
-        data.totalTime += time;
-        data.callCount++;
-        data.averageTime = data.totalTime / data.callCount;
-        data.lastTime = time;
-        
-        if (data.callCount == 1) {
-            data.minTime = time;
-            data.maxTime = time;
-        } else {
-            data.minTime = std::min(data.minTime, time);
-            data.maxTime = std::max(data.maxTime, time);
+    void Profiler::RefreshProfiles() {
+        // Области короче m_minTime не показываются
+        for (const ScopeStats& stats : ScopeProfiler::GetInstance().GetAllStats()) {
+            if (stats.maxMs < m_minTime) {
+                continue;
+            }
+            const std::string& name = ProfileNames::Get(stats.name);
+            ProfileData& data = m_profiles[name];
+            data.name = name;
+            data.totalTime = stats.totalMs;
+            data.callCount = static_cast<int>(stats.calls);
+            data.averageTime = stats.GetAverageMs();
+            data.minTime = stats.minMs;
+            data.maxTime = stats.maxMs;
+            data.lastTime = stats.lastMs;
         }
     }
     
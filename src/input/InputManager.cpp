@@ -1,159 +1,303 @@
 #include "FastEngine/Input/InputManager.h"
-#include "FastEngine/Input/TouchInput.h"
-#include "FastEngine/Input/KeyboardInput.h"
+#include "FastEngine/Input/InputRecording.h"
+#include "FastEngine/Profiling/ScopeProfiler.h"
+#include "FastEngine/Profiling/TraceCapture.h"
 
 namespace FastEngine {
-    InputManager::InputManager() 
-        : m_initialized(false) {
+    InputManager::InputManager()
+        : m_events(EVENT_QUEUE_CAPACITY)
+        , m_droppedEvents(0)
+        , m_droppedTotal(0)
+        , m_current(&m_snapshots[0])
+        , m_frame(0)
+        , m_recording(nullptr)
+        , m_lastLatencyMs(0.0)
+        , m_presentedFrame(0)
+        , m_initialized(false) {
     }
-    
+
     InputManager::~InputManager() {
         Shutdown();
     }
-    
+
     bool InputManager::Initialize() {
-        if (m_initialized) {
+        if (m_initialized.load(std::memory_order_acquire)) {
             return true;
         }
-        
-        // Инициализация систем ввода
-        m_touchInput = std::make_unique<TouchInput>();
-        m_keyboardInput = std::make_unique<KeyboardInput>();
-        
-        if (!m_touchInput->Initialize()) {
-            return false;
-        }
-        
-        if (!m_keyboardInput->Initialize()) {
-            return false;
+
+        for (auto& snapshot : m_snapshots) {
+            snapshot = InputSnapshot();
         }
-        
-        m_initialized = true;
+        m_current.store(&m_snapshots[0], std::memory_order_release);
+        m_frame = 0;
+        m_droppedEvents.store(0, std::memory_order_relaxed);
+        m_droppedTotal = 0;
+        m_frameEvents.reserve(EVENT_QUEUE_CAPACITY);
+        m_activeTouches.reserve(InputSnapshot::MAX_TOUCHES);
+        m_latency.Reset();
+        m_lastLatencyMs = 0.0;
+        m_presentedFrame = 0;
+
+        m_initialized.store(true, std::memory_order_release);
         return true;
     }
-    
+
     void InputManager::Shutdown() {
-        if (!m_initialized) {
+        if (!m_initialized.load(std::memory_order_acquire)) {
             return;
         }
-        
-        if (m_touchInput) {
-            m_touchInput->Shutdown();
-        }
-        
-        if (m_keyboardInput) {
-            m_keyboardInput->Shutdown();
+
+        m_initialized.store(false, std::memory_order_release);
+
+        // Необработанные события больше не нужны
+        InputEvent event;
+        while (m_events.Pop(event)) {
         }
-        
-        m_touchInput.reset();
-        m_keyboardInput.reset();
-        
+        m_frameEvents.clear();
         m_activeTouches.clear();
-        m_keyEvents.clear();
-        
-        m_initialized = false;
     }
-    
+
     void InputManager::Update(float deltaTime) {
-        if (!m_initialized) {
+        if (!m_initialized.load(std::memory_order_acquire)) {
             return;
         }
-        
-        // Обновляем состояние касаний
-        if (m_touchInput) {
-            const auto& touches = m_touchInput->GetActiveTouches();
-            m_activeTouches.clear();
-            
-            for (const auto& touch : touches) {
-                TouchPoint point;
-                point.id = &touch - &touches[0]; // Получаем индекс
-                point.position = touch.position;
-                point.pressed = touch.pressed;
-                point.released = !touch.pressed && touch.timestamp > 0.0f;
-                m_activeTouches.push_back(point);
+        FASTENGINE_PROFILE_SCOPE("InputManager::Update");
+
+        const InputSnapshot& previous = *m_current.load(std::memory_order_relaxed);
+        InputSnapshot& next = m_snapshots[(m_frame + 1) % MAX_FRAMES_IN_FLIGHT];
+
+        // Удержание клавиш и касаний переносится из прошлого кадра
+        next.keysDown = previous.keysDown;
+        next.keysPressed.reset();
+        next.keysReleased.reset();
+        next.touchCount = 0;
+        for (uint32_t i = 0; i < previous.touchCount; ++i) {
+            const InputSnapshot::Touch& touch = previous.touches[i];
+            if (touch.down) {
+                InputSnapshot::Touch& carried = next.touches[next.touchCount++];
+                carried = touch;
+                carried.delta = glm::vec2(0.0f);
+                carried.pressed = false;
+                carried.released = false;
+            }
+        }
+
+        next.eventCount = 0;
+        next.oldestEventTicks = 0;
+        next.newestEventTicks = 0;
+        m_frameEvents.clear();
+        InputEvent event;
+        while (m_events.Pop(event)) {
+            ApplyEvent(next, event);
+            if (next.eventCount == 0) {
+                next.oldestEventTicks = event.ticks;
             }
+            next.newestEventTicks = event.ticks;
+            next.eventCount++;
+            m_frameEvents.push_back(event);
         }
-        
-        // Очищаем события клавиш (они обрабатываются в реальном времени)
-        m_keyEvents.clear();
-    }
-    
-    void InputManager::OnTouchDown(int id, float x, float y) {
-        if (m_touchInput) {
-            m_touchInput->OnTouchDown(id, x, y);
+        next.droppedEvents = m_droppedEvents.exchange(0, std::memory_order_relaxed);
+        m_droppedTotal += next.droppedEvents;
+        next.frame = ++m_frame;
+        next.publishTicks = ProfileClock::Now();
+        m_current.store(&next, std::memory_order_release);
+
+        if (m_recording) {
+            m_recording->AddFrame(deltaTime, m_frameEvents.data(), m_frameEvents.size());
         }
+
+        m_activeTouches.clear();
+        for (uint32_t i = 0; i < next.touchCount; ++i) {
+            const InputSnapshot::Touch& touch = next.touches[i];
+            m_activeTouches.push_back({touch.id, touch.position, touch.down, touch.released});
+        }
+
+        DispatchCallbacks(previous);
     }
-    
-    void InputManager::OnTouchUp(int id, float x, float y) {
-        if (m_touchInput) {
-            m_touchInput->OnTouchUp(id, x, y);
+
+    void InputManager::OnFramePresented() {
+        const InputSnapshot& snapshot = GetSnapshot();
+        if (snapshot.eventCount == 0 || snapshot.frame == m_presentedFrame) {
+            return;
         }
+        m_presentedFrame = snapshot.frame;
+
+        uint64_t now = ProfileClock::Now();
+        m_lastLatencyMs = now > snapshot.oldestEventTicks
+            ? ProfileClock::ToMilliseconds(now - snapshot.oldestEventTicks) : 0.0;
+        m_latency.Add(m_lastLatencyMs);
+        FASTENGINE_TRACE_COUNTER("Input latency ms", m_lastLatencyMs);
     }
-    
-    void InputManager::OnTouchMove(int id, float x, float y) {
-        if (m_touchInput) {
-            m_touchInput->OnTouchMove(id, x, y);
+
+    void InputManager::PushEvent(InputEvent::Type type, int code, float x, float y, uint64_t ticks) {
+        if (!m_initialized.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        InputEvent event;
+        event.ticks = ticks != 0 ? ticks : ProfileClock::Now();
+        event.code = code;
+        event.x = x;
+        event.y = y;
+        event.type = type;
+        if (!m_events.Push(event)) {
+            m_droppedEvents.fetch_add(1, std::memory_order_relaxed);
         }
     }
-    
-    void InputManager::OnKeyDown(int key) {
-        if (m_keyboardInput) {
-            m_keyboardInput->OnKeyDown(key);
+
+    void InputManager::ApplyEvent(InputSnapshot& snapshot, const InputEvent& event) {
+        switch (event.type) {
+            case InputEvent::KEY_DOWN:
+                if (InputSnapshot::IsValidKey(event.code) && !snapshot.keysDown.test(event.code)) {
+                    snapshot.keysDown.set(event.code);
+                    snapshot.keysPressed.set(event.code);
+                }
+                break;
+            case InputEvent::KEY_UP:
+                if (InputSnapshot::IsValidKey(event.code) && snapshot.keysDown.test(event.code)) {
+                    snapshot.keysDown.reset(event.code);
+                    snapshot.keysReleased.set(event.code);
+                }
+                break;
+            case InputEvent::TOUCH_DOWN: {
+                InputSnapshot::Touch* touch = snapshot.FindTouch(event.code);
+                if (!touch) {
+                    if (snapshot.touchCount >= static_cast<uint32_t>(InputSnapshot::MAX_TOUCHES)) {
+                        break;
+                    }
+                    touch = &snapshot.touches[snapshot.touchCount++];
+                    touch->id = event.code;
+                    touch->delta = glm::vec2(0.0f);
+                    touch->down = false;
+                    touch->pressed = false;
+                    touch->released = false;
+                }
+                touch->pressed = touch->pressed || !touch->down;
+                touch->down = true;
+                touch->position = glm::vec2(event.x, event.y);
+                break;
+            }
+            case InputEvent::TOUCH_MOVE:
+            case InputEvent::TOUCH_UP: {
+                InputSnapshot::Touch* touch = snapshot.FindTouch(event.code);
+                if (!touch || !touch->down) {
+                    break;
+                }
+                glm::vec2 position(event.x, event.y);
+                touch->delta += position - touch->position;
+                touch->position = position;
+                if (event.type == InputEvent::TOUCH_UP) {
+                    touch->down = false;
+                    touch->released = true;
+                }
+                break;
+            }
+            default:
+                break;
         }
     }
-    
-    void InputManager::OnKeyUp(int key) {
-        if (m_keyboardInput) {
-            m_keyboardInput->OnKeyUp(key);
+
+    void InputManager::DispatchCallbacks(const InputSnapshot& previous) {
+        if (m_frameEvents.empty()) {
+            return;
+        }
+
+        // Повтор клавиши определяется по состоянию на момент события
+        std::bitset<InputSnapshot::MAX_KEYS> keysDown = previous.keysDown;
+        for (const InputEvent& event : m_frameEvents) {
+            switch (event.type) {
+                case InputEvent::KEY_DOWN: {
+                    bool repeated = InputSnapshot::IsValidKey(event.code) && keysDown.test(event.code);
+                    if (InputSnapshot::IsValidKey(event.code)) {
+                        keysDown.set(event.code);
+                    }
+                    if (OnKeyDownCallback) {
+                        OnKeyDownCallback({event.code, !repeated, false, repeated});
+                    }
+                    break;
+                }
+                case InputEvent::KEY_UP:
+                    if (InputSnapshot::IsValidKey(event.code)) {
+                        keysDown.reset(event.code);
+                    }
+                    if (OnKeyUpCallback) {
+                        OnKeyUpCallback({event.code, false, true, false});
+                    }
+                    break;
+                case InputEvent::TOUCH_DOWN:
+                    if (OnTouchDownCallback) {
+                        OnTouchDownCallback({event.code, glm::vec2(event.x, event.y), true, false});
+                    }
+                    break;
+                case InputEvent::TOUCH_UP:
+                    if (OnTouchUpCallback) {
+                        OnTouchUpCallback({event.code, glm::vec2(event.x, event.y), false, true});
+                    }
+                    break;
+                case InputEvent::TOUCH_MOVE:
+                    if (OnTouchMoveCallback) {
+                        OnTouchMoveCallback({event.code, glm::vec2(event.x, event.y), true, false});
+                    }
+                    break;
+                default:
+                    break;
+            }
         }
     }
-    
+
+    void InputManager::InjectEvent(const InputEvent& event) {
+        PushEvent(static_cast<InputEvent::Type>(event.type), event.code, event.x, event.y, event.ticks);
+    }
+
+    void InputManager::OnTouchDown(int id, float x, float y, uint64_t ticks) {
+        PushEvent(InputEvent::TOUCH_DOWN, id, x, y, ticks);
+    }
+
+    void InputManager::OnTouchUp(int id, float x, float y, uint64_t ticks) {
+        PushEvent(InputEvent::TOUCH_UP, id, x, y, ticks);
+    }
+
+    void InputManager::OnTouchMove(int id, float x, float y, uint64_t ticks) {
+        PushEvent(InputEvent::TOUCH_MOVE, id, x, y, ticks);
+    }
+
+    void InputManager::OnKeyDown(int key, uint64_t ticks) {
+        PushEvent(InputEvent::KEY_DOWN, key, 0.0f, 0.0f, ticks);
+    }
+
+    void InputManager::OnKeyUp(int key, uint64_t ticks) {
+        PushEvent(InputEvent::KEY_UP, key, 0.0f, 0.0f, ticks);
+    }
+
     bool InputManager::IsKeyPressed(int key) const {
-        if (m_keyboardInput) {
-            return m_keyboardInput->IsPressed(key);
-        }
-        return false;
+        return GetSnapshot().IsKeyDown(key);
     }
-    
+
     bool InputManager::IsKeyJustPressed(int key) const {
-        if (m_keyboardInput) {
-            return m_keyboardInput->IsJustPressed(key);
-        }
-        return false;
+        return GetSnapshot().IsKeyPressed(key);
     }
-    
+
     bool InputManager::IsKeyJustReleased(int key) const {
-        if (m_keyboardInput) {
-            return m_keyboardInput->IsJustReleased(key);
-        }
-        return false;
+        return GetSnapshot().IsKeyReleased(key);
     }
-    
+
     bool InputManager::IsTouchPressed(int id) const {
-        if (m_touchInput) {
-            return m_touchInput->IsPressed(id);
-        }
-        return false;
+        const InputSnapshot::Touch* touch = GetSnapshot().FindTouch(id);
+        return touch && touch->down;
     }
-    
+
     bool InputManager::IsTouchJustPressed(int id) const {
-        if (m_touchInput) {
-            return m_touchInput->IsJustPressed(id);
-        }
-        return false;
+        const InputSnapshot::Touch* touch = GetSnapshot().FindTouch(id);
+        return touch && touch->pressed;
     }
-    
+
     bool InputManager::IsTouchJustReleased(int id) const {
-        if (m_touchInput) {
-            return m_touchInput->IsJustReleased(id);
-        }
-        return false;
+        const InputSnapshot::Touch* touch = GetSnapshot().FindTouch(id);
+        return touch && touch->released;
     }
-    
+
     glm::vec2 InputManager::GetTouchPosition(int id) const {
-        if (m_touchInput) {
-            return m_touchInput->GetPosition(id);
-        }
-        return glm::vec2(0.0f);
+        const InputSnapshot::Touch* touch = GetSnapshot().FindTouch(id);
+        return touch ? touch->position : glm::vec2(0.0f);
     }
 }
@@ -0,0 +1,194 @@
+#include "FastEngine/Input/InputRecording.h"
+#include "FastEngine/Network/BitStream.h"
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+
+namespace FastEngine {
+    namespace {
+        const uint32_t EVENT_TYPE_BITS = 3;
+        // Больше событий в кадре - признак поврежденных данных
+        const uint32_t MAX_EVENTS_PER_FRAME = 1u << 20;
+
+        bool IsTouchEvent(uint8_t type) {
+            return type == InputEvent::TOUCH_DOWN || type == InputEvent::TOUCH_UP || type == InputEvent::TOUCH_MOVE;
+        }
+
+        bool ReadEvent(BitReader& reader, InputEvent& event) {
+            uint32_t type = 0;
+            int64_t code = 0;
+            event.ticks = 0;
+            event.x = 0.0f;
+            event.y = 0.0f;
+            if (!reader.ReadBits(EVENT_TYPE_BITS, type) || type > InputEvent::TOUCH_MOVE || !reader.ReadVarInt(code) ||
+                code < std::numeric_limits<int32_t>::min() || code > std::numeric_limits<int32_t>::max()) {
+                return false;
+            }
+            event.type = static_cast<uint8_t>(type);
+            event.code = static_cast<int32_t>(code);
+            return !IsTouchEvent(event.type) || (reader.ReadFloat(event.x) && reader.ReadFloat(event.y));
+        }
+
+        // Общая запись для BitCounter и BitWriter
+        template<typename Stream>
+        void WriteRecording(Stream& stream, const std::vector<InputRecording::Frame>& frames,
+                            const std::vector<InputEvent>& events) {
+            stream.WriteBits(InputRecording::MAGIC, 32);
+            stream.WriteVarUint(InputRecording::FORMAT_VERSION);
+            stream.WriteVarUint(frames.size());
+
+            float previousDelta = -1.0f;
+            for (const InputRecording::Frame& frame : frames) {
+                bool sameDelta = frame.deltaTime == previousDelta;
+                stream.WriteBool(sameDelta);
+                if (!sameDelta) {
+                    stream.WriteFloat(frame.deltaTime);
+                    previousDelta = frame.deltaTime;
+                }
+                stream.WriteVarUint(frame.eventCount);
+                for (uint32_t i = 0; i < frame.eventCount; ++i) {
+                    const InputEvent& event = events[frame.firstEvent + i];
+                    stream.WriteBits(event.type, EVENT_TYPE_BITS);
+                    stream.WriteVarInt(event.code);
+                    if (IsTouchEvent(event.type)) {
+                        stream.WriteFloat(event.x);
+                        stream.WriteFloat(event.y);
+                    }
+                }
+            }
+        }
+    }
+
+    InputRecording::InputRecording()
+        : m_duration(0.0) {
+    }
+
+    void InputRecording::Clear() {
+        m_frames.clear();
+        m_events.clear();
+        m_duration = 0.0;
+    }
+
+    void InputRecording::AddFrame(float deltaTime, const InputEvent* events, size_t count) {
+        Frame frame;
+        frame.deltaTime = deltaTime;
+        frame.firstEvent = static_cast<uint32_t>(m_events.size());
+        frame.eventCount = static_cast<uint32_t>(count);
+        m_frames.push_back(frame);
+        m_events.insert(m_events.end(), events, events + count);
+        m_duration += deltaTime;
+    }
+
+    bool InputRecording::Serialize(std::vector<uint8_t>& data) const {
+        BitCounter counter;
+        WriteRecording(counter, m_frames, m_events);
+        // Запас на выравнивание накопителя BitWriter
+        size_t capacity = counter.GetBitsWritten() / 8 + 8;
+        if (capacity > std::numeric_limits<uint32_t>::max()) {
+            std::cerr << "InputRecording: Recording is too large" << std::endl;
+            return false;
+        }
+
+        data.assign(capacity, 0);
+        BitWriter writer(data.data(), static_cast<uint32_t>(capacity));
+        WriteRecording(writer, m_frames, m_events);
+        writer.Flush();
+        if (writer.IsOverflow()) {
+            std::cerr << "InputRecording: Serialization overflow" << std::endl;
+            data.clear();
+            return false;
+        }
+        data.resize(writer.GetBytesWritten());
+        return true;
+    }
+
+    bool InputRecording::Deserialize(const uint8_t* data, size_t size) {
+        Clear();
+        if (size > std::numeric_limits<uint32_t>::max()) {
+            return false;
+        }
+
+        BitReader reader(data, static_cast<uint32_t>(size));
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        uint32_t frameCount = 0;
+        if (!reader.ReadBits(32, magic) || magic != MAGIC) {
+            std::cerr << "InputRecording: Not an input recording" << std::endl;
+            return false;
+        }
+        if (!reader.ReadVarUint(version) || version != FORMAT_VERSION) {
+            std::cerr << "InputRecording: Unsupported format version " << version << std::endl;
+            return false;
+        }
+        // Каждый кадр занимает хотя бы 9 бит - число кадров не больше остатка
+        if (!reader.ReadVarUint(frameCount) || frameCount > reader.GetBitsRemaining() / 9) {
+            std::cerr << "InputRecording: Corrupted header" << std::endl;
+            return false;
+        }
+        m_frames.reserve(frameCount);
+
+        float delta = 0.0f;
+        bool valid = true;
+        for (uint32_t f = 0; f < frameCount && valid; ++f) {
+            bool sameDelta = false;
+            uint32_t eventCount = 0;
+            if (!reader.ReadBool(sameDelta) || (f == 0 && sameDelta) || (!sameDelta && !reader.ReadFloat(delta)) ||
+                !reader.ReadVarUint(eventCount) || eventCount > MAX_EVENTS_PER_FRAME) {
+                valid = false;
+                break;
+            }
+
+            Frame frame;
+            frame.deltaTime = delta;
+            frame.firstEvent = static_cast<uint32_t>(m_events.size());
+            frame.eventCount = eventCount;
+            for (uint32_t i = 0; i < eventCount && valid; ++i) {
+                InputEvent event;
+                valid = ReadEvent(reader, event);
+                m_events.push_back(event);
+            }
+            if (valid) {
+                m_frames.push_back(frame);
+                m_duration += delta;
+            }
+        }
+
+        if (!valid || reader.IsError()) {
+            std::cerr << "InputRecording: Corrupted data at frame " << m_frames.size() << std::endl;
+            Clear();
+            return false;
+        }
+        return true;
+    }
+
+    bool InputRecording::SaveToFile(const std::string& path) const {
+        std::vector<uint8_t> data;
+        if (!Serialize(data)) {
+            return false;
+        }
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "InputRecording: Failed to open " << path << std::endl;
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file) {
+            std::cerr << "InputRecording: Failed to write " << path << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    bool InputRecording::LoadFromFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "InputRecording: Failed to open " << path << std::endl;
+            Clear();
+            return false;
+        }
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        return Deserialize(data.data(), data.size());
+    }
+}
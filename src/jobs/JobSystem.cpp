@@ -0,0 +1,399 @@
+#include "FastEngine/Jobs/JobSystem.h"
+#include "FastEngine/Jobs/WorkStealingDeque.h"
+#include "FastEngine/Memory/LinearArena.h"
+#include "FastEngine/Profiling/TraceCapture.h"
+#include <exception>
+#include <iostream>
+#include <string>
+
+namespace FastEngine {
+
+namespace {
+
+// Попыток найти задание перед сном рабочего потока
+const uint32_t IDLE_SPINS = 64;
+
+thread_local uint32_t t_workerIndex = JobSystem::NO_THREAD;
+thread_local uint32_t t_random = 0;
+
+ProfileNameId GetJobNameId() {
+    static const ProfileNameId id = ProfileNames::Register("Job");
+    return id;
+}
+
+uint32_t NextRandom() {
+    // xorshift32; начальное значение - от адреса переменной потока
+    uint32_t x = t_random;
+    if (x == 0) {
+        x = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&t_random) >> 4) | 1u;
+    }
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    t_random = x;
+    return x;
+}
+
+} // namespace
+
+struct JobSystem::ThreadState {
+    WorkStealingDeque<Job*> deque;
+    std::unique_ptr<Job[]> ring; // Задания, запланированные этим потоком
+    size_t ringNext;
+    // Пишет только сам поток
+    std::atomic<uint64_t> executed;
+    std::atomic<uint64_t> stolen;
+
+    ThreadState()
+        : deque(DEQUE_CAPACITY)
+        , ring(new Job[JOB_RING_SIZE])
+        , ringNext(0)
+        , executed(0)
+        , stolen(0) {}
+};
+
+JobSystem& JobSystem::GetInstance() {
+    static JobSystem instance;
+    return instance;
+}
+
+JobSystem::JobSystem()
+    : m_running(false)
+    , m_injectedCount(0)
+    , m_injectedTotal(0)
+    , m_epoch(0)
+    , m_sleeping(0)
+    , m_stopWorkers(false)
+    , m_pending(0)
+    , m_foreignExecuted(0)
+    , m_heapJobs(0)
+    , m_nextFlowId(0) {
+}
+
+JobSystem::~JobSystem() {
+    Stop();
+}
+
+bool JobSystem::Start(uint32_t workerCount) {
+    if (IsRunning()) {
+        return false;
+    }
+    if (workerCount == 0) {
+        // Хотя бы один рабочий: задания без Wait должны выполняться и на одном ядре
+        workerCount = std::max(1u, std::thread::hardware_concurrency() - 1);
+    }
+
+    m_ownerThread = std::this_thread::get_id();
+    m_threads.clear();
+    for (uint32_t i = 0; i <= workerCount; ++i) {
+        m_threads.push_back(std::unique_ptr<ThreadState>(new ThreadState()));
+    }
+    m_injectedTotal.store(0, std::memory_order_relaxed);
+    m_foreignExecuted.store(0, std::memory_order_relaxed);
+    m_heapJobs.store(0, std::memory_order_relaxed);
+    m_stopWorkers = false;
+    m_running.store(true, std::memory_order_release);
+
+    m_workers.reserve(workerCount);
+    for (uint32_t i = 1; i <= workerCount; ++i) {
+        m_workers.emplace_back(&JobSystem::WorkerThreadFunction, this, i);
+    }
+    return true;
+}
+
+void JobSystem::Stop() {
+    if (!IsRunning()) {
+        return;
+    }
+
+    // Оставшиеся задания выполняются до остановки потоков
+    while (m_pending.load(std::memory_order_acquire) != 0) {
+        bool stolen = false;
+        Job* job = FindJob(stolen);
+        if (job) {
+            Execute(job, stolen);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopWorkers = true;
+    }
+    m_sleepCondition.notify_all();
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    m_workers.clear();
+    m_running.store(false, std::memory_order_release);
+    m_threads.clear();
+    m_ownerThread = std::thread::id();
+}
+
+uint32_t JobSystem::GetThreadIndex() {
+    if (t_workerIndex != NO_THREAD) {
+        return t_workerIndex;
+    }
+    JobSystem& system = GetInstance();
+    return system.IsRunning() && std::this_thread::get_id() == system.m_ownerThread ? 0 : NO_THREAD;
+}
+
+JobSystemStats JobSystem::GetStats() const {
+    JobSystemStats stats;
+    for (const auto& state : m_threads) {
+        stats.executed += state->executed.load(std::memory_order_relaxed);
+        stats.stolen += state->stolen.load(std::memory_order_relaxed);
+    }
+    stats.executed += m_foreignExecuted.load(std::memory_order_relaxed);
+    stats.injected = m_injectedTotal.load(std::memory_order_relaxed);
+    stats.heapJobs = m_heapJobs.load(std::memory_order_relaxed);
+    stats.workers = GetWorkerCount();
+    return stats;
+}
+
+void JobSystem::Wait(JobCounter& counter) {
+    if (counter.IsDone()) {
+        return;
+    }
+    FASTENGINE_PROFILE_SCOPE("JobSystem::Wait");
+
+    uint32_t idle = 0;
+    while (!counter.IsDone()) {
+        if (!IsRunning()) {
+            std::cerr << "JobSystem: Waiting for a counter while the scheduler is stopped" << std::endl;
+            return;
+        }
+        bool stolen = false;
+        Job* job = FindJob(stolen);
+        if (job) {
+            Execute(job, stolen);
+            idle = 0;
+        } else if (++idle > IDLE_SPINS) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+Job* JobSystem::AllocateJob() {
+    uint32_t index = GetThreadIndex();
+    if (index != NO_THREAD) {
+        // Кольцо без блокировок: слот еще занят, только если за
+        // JOB_RING_SIZE заданий он не успел выполниться
+        ThreadState& state = *m_threads[index];
+        Job& job = state.ring[state.ringNext++ & (JOB_RING_SIZE - 1)];
+        if (!job.inUse.load(std::memory_order_acquire)) {
+            job.inUse.store(true, std::memory_order_relaxed);
+            job.heap = false;
+            return &job;
+        }
+    }
+    m_heapJobs.fetch_add(1, std::memory_order_relaxed);
+    Job* job = new Job();
+    job->heap = true;
+    job->inUse.store(true, std::memory_order_relaxed);
+    return job;
+}
+
+void JobSystem::ReleaseJob(Job* job) {
+    if (job->heap) {
+        delete job;
+    } else {
+        job->inUse.store(false, std::memory_order_release);
+    }
+}
+
+void JobSystem::Enqueue(Job* job, JobCounter* counter, JobCounter* dependency, ProfileNameId name) {
+    job->counter = counter;
+    job->name = name;
+    job->nextWaiter = nullptr;
+    job->flowId = 0;
+    if (counter) {
+        counter->m_value.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_pending.fetch_add(1, std::memory_order_relaxed);
+
+    if (TraceCapture::IsRecording()) {
+        job->flowId = m_nextFlowId.fetch_add(1, std::memory_order_relaxed) + 1;
+        TraceCapture::FlowBegin(GetJobNameId(), job->flowId);
+    }
+
+    if (!IsRunning()) {
+        Execute(job, false);
+        return;
+    }
+
+    if (dependency) {
+        // Переход счетчика в ноль тоже идет под мьютексом (Finish), поэтому
+        // задание либо попадет в список, либо увидит ноль
+        std::lock_guard<std::mutex> lock(dependency->m_mutex);
+        if (dependency->m_value.load(std::memory_order_acquire) != 0) {
+            job->nextWaiter = dependency->m_waiters;
+            dependency->m_waiters = job;
+            return;
+        }
+    }
+    Submit(job);
+}
+
+void JobSystem::Submit(Job* job) {
+    uint32_t index = GetThreadIndex();
+    if (index == NO_THREAD || !m_threads[index]->deque.Push(job)) {
+        std::lock_guard<std::mutex> lock(m_injectMutex);
+        m_injected.push_back(job);
+        m_injectedCount.fetch_add(1, std::memory_order_release);
+        if (index == NO_THREAD) {
+            m_injectedTotal.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Будим одного спящего; эпоха закрывает гонку с засыпанием
+    m_epoch.fetch_add(1, std::memory_order_seq_cst);
+    if (m_sleeping.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_sleepCondition.notify_one();
+    }
+}
+
+void JobSystem::Execute(Job* job, bool stolen) {
+    {
+        ScopeProfiler::Scope scope(job->name ? job->name : GetJobNameId());
+        if (job->flowId) {
+            TraceCapture::FlowEnd(GetJobNameId(), job->flowId);
+        }
+        try {
+            job->function(*job);
+        } catch (const std::exception& e) {
+            std::cerr << "JobSystem: Job threw an exception: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "JobSystem: Job threw an unknown exception" << std::endl;
+        }
+    }
+
+    JobCounter* counter = job->counter;
+    ReleaseJob(job);
+
+    uint32_t index = GetThreadIndex();
+    if (index != NO_THREAD && index < m_threads.size()) {
+        ThreadState& state = *m_threads[index];
+        state.executed.store(state.executed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (stolen) {
+            state.stolen.store(state.stolen.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    } else {
+        m_foreignExecuted.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (counter) {
+        Finish(counter);
+    }
+    m_pending.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::Finish(JobCounter* counter) {
+    uint32_t value = counter->m_value.load(std::memory_order_relaxed);
+    while (value > 1) {
+        if (counter->m_value.compare_exchange_weak(value, value - 1, std::memory_order_acq_rel,
+                                                   std::memory_order_relaxed)) {
+            return;
+        }
+    }
+
+    // Последнее задание: ожидающий Wait не уничтожит счетчик, пока
+    // мьютекс занят (деструктор JobCounter его захватывает)
+    Job* waiters = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(counter->m_mutex);
+        if (counter->m_value.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            waiters = counter->m_waiters;
+            counter->m_waiters = nullptr;
+        }
+    }
+    while (waiters) {
+        Job* next = waiters->nextWaiter;
+        waiters->nextWaiter = nullptr;
+        Submit(waiters);
+        waiters = next;
+    }
+}
+
+Job* JobSystem::FindJob(bool& stolen) {
+    stolen = false;
+    Job* job = nullptr;
+    const uint32_t index = GetThreadIndex();
+    if (index != NO_THREAD && m_threads[index]->deque.Pop(job)) {
+        return job;
+    }
+
+    if (m_injectedCount.load(std::memory_order_acquire) > 0) {
+        std::lock_guard<std::mutex> lock(m_injectMutex);
+        if (!m_injected.empty()) {
+            job = m_injected.front();
+            m_injected.pop_front();
+            m_injectedCount.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+
+    // Кража с случайной жертвы, затем по кругу
+    const size_t count = m_threads.size();
+    if (count == 0) {
+        return nullptr;
+    }
+    const size_t start = NextRandom() % count;
+    for (size_t i = 0; i < count; ++i) {
+        size_t victim = (start + i) % count;
+        if (victim != index && m_threads[victim]->deque.Steal(job)) {
+            stolen = true;
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+bool JobSystem::IsLocalQueueEmpty() const {
+    uint32_t index = GetThreadIndex();
+    if (index == NO_THREAD) {
+        return m_injectedCount.load(std::memory_order_relaxed) == 0;
+    }
+    return m_threads[index]->deque.IsEmpty();
+}
+
+void JobSystem::WorkerThreadFunction(uint32_t index) {
+    t_workerIndex = index;
+    ScopeProfiler::SetThreadName("Job Worker " + std::to_string(index));
+
+    uint32_t idle = 0;
+    for (;;) {
+        const uint64_t epoch = m_epoch.load(std::memory_order_seq_cst);
+        bool stolen = false;
+        Job* job = FindJob(stolen);
+        if (job) {
+            Execute(job, stolen);
+            // У рабочего потока нет своего цикла: память кадра живет до конца задания
+            FrameArena::BeginFrame();
+            idle = 0;
+            continue;
+        }
+        if (++idle < IDLE_SPINS) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        if (m_stopWorkers) {
+            break;
+        }
+        m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+        m_sleepCondition.wait(lock, [this, epoch]() {
+            return m_stopWorkers || m_epoch.load(std::memory_order_seq_cst) != epoch;
+        });
+        m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+        idle = 0;
+    }
+    t_workerIndex = NO_THREAD;
+}
+
+} // namespace FastEngine
@@ -0,0 +1,274 @@
+#include "FastEngine/Memory/LinearArena.h"
+#include "FastEngine/Profiling/MemoryTracker.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+
+namespace FastEngine {
+
+namespace {
+
+MemoryTag GetArenaTag() {
+    static const MemoryTag tag = MemoryTracker::RegisterTag("FrameArena");
+    return tag;
+}
+
+std::atomic<size_t> s_defaultChunkSize(LinearArena::DEFAULT_CHUNK_SIZE);
+std::atomic<uint32_t> s_defaultDebugFlags(MEMORY_DEBUG_DEFAULT);
+
+struct ThreadFrameArena {
+    LinearArena arena;
+    uint64_t frame;
+
+    ThreadFrameArena()
+        : arena(s_defaultChunkSize.load(std::memory_order_relaxed),
+                s_defaultDebugFlags.load(std::memory_order_relaxed))
+        , frame(0) {}
+};
+
+ThreadFrameArena& GetThreadFrameArena() {
+    thread_local ThreadFrameArena local;
+    return local;
+}
+
+} // namespace
+
+// LinearArena implementation
+LinearArena::LinearArena(size_t chunkSize, uint32_t debugFlags)
+    : m_current(0)
+    , m_offset(0)
+    , m_base(0)
+    , m_peak(0)
+    , m_allocations(0)
+    , m_generation(0)
+    , m_chunkSize(std::max<size_t>(chunkSize, 256))
+    , m_debugFlags(debugFlags)
+    , m_overruns(0) {
+}
+
+LinearArena::~LinearArena() {
+    CheckGuards();
+    FreeChunks();
+}
+
+void* LinearArena::Allocate(size_t size, size_t alignment) {
+    const size_t guard = (m_debugFlags & MEMORY_DEBUG_GUARDS) ? GUARD_SIZE : 0;
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        std::cerr << "LinearArena: Alignment " << alignment << " is not a power of two" << std::endl;
+        return nullptr;
+    }
+    if (size > std::numeric_limits<size_t>::max() / 2 - guard - alignment) {
+        return nullptr;
+    }
+
+    for (;;) {
+        if (m_current < m_chunks.size()) {
+            Chunk& chunk = m_chunks[m_current];
+            const uintptr_t base = reinterpret_cast<uintptr_t>(chunk.data);
+            const size_t aligned = AlignUp(base + m_offset, alignment) - base;
+            if (aligned <= chunk.size && size + guard <= chunk.size - aligned) {
+                uint8_t* pointer = chunk.data + aligned;
+                m_offset = aligned + size + guard;
+                m_peak = std::max(m_peak, GetUsed());
+                m_allocations++;
+
+                if (m_debugFlags & MEMORY_DEBUG_POISON) {
+                    UnpoisonMemory(pointer, size + guard);
+                    std::memset(pointer, MEMORY_FRESH_BYTE, size);
+                }
+                if (guard) {
+                    std::memset(pointer + size, MEMORY_GUARD_BYTE, guard);
+                    m_guards.push_back(pointer + size);
+                }
+                return pointer;
+            }
+            // Хвост блока пропускается; следующий блок остался с прошлых циклов
+            if (m_current + 1 < m_chunks.size()) {
+                m_base += chunk.size;
+                m_current++;
+                m_offset = 0;
+                continue;
+            }
+        }
+
+        const bool hadChunk = m_current < m_chunks.size();
+        if (!AddChunk(std::max(m_chunkSize, size + guard + alignment))) {
+            return nullptr;
+        }
+        if (hadChunk) {
+            m_base += m_chunks[m_current].size;
+            m_current++;
+        }
+        m_offset = 0;
+    }
+}
+
+void LinearArena::Deallocate(void* pointer, size_t size) {
+    if (!pointer || m_current >= m_chunks.size()) {
+        return;
+    }
+    const size_t guard = (m_debugFlags & MEMORY_DEBUG_GUARDS) ? GUARD_SIZE : 0;
+    Chunk& chunk = m_chunks[m_current];
+    uint8_t* bytes = static_cast<uint8_t*>(pointer);
+    if (bytes < chunk.data || bytes + size + guard != chunk.data + m_offset) {
+        return;
+    }
+
+    if (guard && !m_guards.empty() && m_guards.back() == bytes + size) {
+        CheckGuardsFrom(m_guards.size() - 1);
+        m_guards.pop_back();
+    }
+    if (m_debugFlags & MEMORY_DEBUG_POISON) {
+        PoisonMemory(bytes, size + guard);
+    }
+    m_offset = static_cast<size_t>(bytes - chunk.data);
+}
+
+LinearArena::Marker LinearArena::GetMarker() const {
+    Marker marker;
+    marker.chunk = m_current;
+    marker.offset = m_offset;
+    marker.base = m_base;
+    marker.guards = m_guards.size();
+    marker.generation = m_generation;
+    return marker;
+}
+
+void LinearArena::Rewind(const Marker& marker) {
+    if (marker.generation != m_generation) {
+        std::cerr << "LinearArena: Marker from a previous cycle is ignored" << std::endl;
+        return;
+    }
+    if (marker.chunk > m_current || (marker.chunk == m_current && marker.offset > m_offset)) {
+        return;
+    }
+
+    CheckGuardsFrom(marker.guards);
+    m_guards.resize(std::min(marker.guards, m_guards.size()));
+    if (m_debugFlags & MEMORY_DEBUG_POISON) {
+        PoisonFrom(marker.chunk, marker.offset);
+    }
+    m_current = marker.chunk;
+    m_offset = marker.offset;
+    m_base = marker.base;
+}
+
+void LinearArena::Reset() {
+    CheckGuards();
+    m_guards.clear();
+
+    // Несколько блоков за цикл - один общий блок на следующий
+    if (m_chunks.size() > 1) {
+        size_t total = GetCapacity();
+        FreeChunks();
+        AddChunk(total);
+    } else if (m_debugFlags & MEMORY_DEBUG_POISON) {
+        PoisonFrom(0, 0);
+    }
+
+    m_current = 0;
+    m_offset = 0;
+    m_base = 0;
+    m_allocations = 0;
+    m_generation++;
+}
+
+bool LinearArena::Owns(const void* pointer) const {
+    const uint8_t* bytes = static_cast<const uint8_t*>(pointer);
+    for (size_t i = 0; i < m_chunks.size() && i <= m_current; ++i) {
+        const Chunk& chunk = m_chunks[i];
+        size_t end = i < m_current ? chunk.size : m_offset;
+        if (bytes >= chunk.data && bytes < chunk.data + end) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool LinearArena::CheckGuards() {
+    return CheckGuardsFrom(0);
+}
+
+size_t LinearArena::GetCapacity() const {
+    size_t capacity = 0;
+    for (const Chunk& chunk : m_chunks) {
+        capacity += chunk.size;
+    }
+    return capacity;
+}
+
+bool LinearArena::AddChunk(size_t size) {
+    uint8_t* data = static_cast<uint8_t*>(std::malloc(size));
+    if (!data) {
+        std::cerr << "LinearArena: Failed to allocate chunk of " << size << " bytes" << std::endl;
+        return false;
+    }
+    MemoryTracker::PushTag(GetArenaTag());
+    MemoryTag tag = MemoryTracker::OnAllocate(size);
+    MemoryTracker::PopTag();
+
+    if (m_debugFlags & MEMORY_DEBUG_POISON) {
+        PoisonMemory(data, size);
+    }
+    m_chunks.push_back(Chunk{data, size, tag});
+    return true;
+}
+
+void LinearArena::FreeChunks() {
+    for (const Chunk& chunk : m_chunks) {
+        UnpoisonMemory(chunk.data, chunk.size);
+        MemoryTracker::OnFree(chunk.size, chunk.tag);
+        std::free(chunk.data);
+    }
+    m_chunks.clear();
+}
+
+bool LinearArena::CheckGuardsFrom(size_t first) {
+    bool intact = true;
+    for (size_t i = first; i < m_guards.size(); ++i) {
+        const uint8_t* guard = m_guards[i];
+        for (size_t j = 0; j < GUARD_SIZE; ++j) {
+            if (guard[j] != MEMORY_GUARD_BYTE) {
+                std::cerr << "LinearArena: Overrun detected past allocation ending at "
+                          << static_cast<const void*>(guard) << std::endl;
+                m_overruns++;
+                intact = false;
+                break;
+            }
+        }
+    }
+    return intact;
+}
+
+void LinearArena::PoisonFrom(size_t chunk, size_t offset) {
+    for (size_t i = chunk; i < m_chunks.size() && i <= m_current; ++i) {
+        size_t begin = i == chunk ? offset : 0;
+        size_t end = i < m_current ? m_chunks[i].size : std::max(begin, m_offset);
+        if (end > begin) {
+            PoisonMemory(m_chunks[i].data + begin, end - begin);
+        }
+    }
+}
+
+// FrameArena implementation
+LinearArena& FrameArena::Get() {
+    return GetThreadFrameArena().arena;
+}
+
+void FrameArena::BeginFrame() {
+    ThreadFrameArena& local = GetThreadFrameArena();
+    local.arena.Reset();
+    local.frame++;
+}
+
+uint64_t FrameArena::GetFrameIndex() {
+    return GetThreadFrameArena().frame;
+}
+
+void FrameArena::SetDefaults(size_t chunkSize, uint32_t debugFlags) {
+    s_defaultChunkSize.store(chunkSize, std::memory_order_relaxed);
+    s_defaultDebugFlags.store(debugFlags, std::memory_order_relaxed);
+}
+
+} // namespace FastEngine
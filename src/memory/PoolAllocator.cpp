@@ -0,0 +1,197 @@
+#include "FastEngine/Memory/PoolAllocator.h"
+#include "FastEngine/Profiling/MemoryTracker.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+namespace FastEngine {
+
+namespace {
+
+const uint64_t FREED_CANARY = 0xDEADF4EEDEADF4EEull;
+
+MemoryTag GetPoolTag() {
+    static const MemoryTag tag = MemoryTracker::RegisterTag("Pools");
+    return tag;
+}
+
+} // namespace
+
+// PoolAllocator implementation
+PoolAllocator::PoolAllocator(size_t blockSize, size_t alignment, size_t blocksPerSlab, uint32_t debugFlags)
+    : m_alignment(std::max(alignment, alignof(FreeBlock)))
+    , m_blocksPerSlab(std::max<size_t>(blocksPerSlab, 1))
+    , m_debugFlags(debugFlags)
+    , m_free(nullptr)
+    , m_live(0)
+    , m_doubleFrees(0) {
+    m_blockSize = AlignUp(std::max(blockSize, sizeof(FreeBlock)), m_alignment);
+}
+
+PoolAllocator::~PoolAllocator() {
+    if (m_live > 0 && m_debugFlags != MEMORY_DEBUG_NONE) {
+        std::cerr << "PoolAllocator: " << m_live << " blocks of " << m_blockSize
+                  << " bytes were not freed" << std::endl;
+    }
+    const size_t slabSize = m_blockSize * m_blocksPerSlab;
+    for (const Slab& slab : m_slabs) {
+        UnpoisonMemory(slab.data, slabSize);
+        MemoryTracker::OnFree(slabSize, slab.tag);
+        if (m_alignment <= alignof(std::max_align_t)) {
+            std::free(slab.data);
+        } else {
+            ::operator delete(slab.data, std::align_val_t(m_alignment));
+        }
+    }
+}
+
+void* PoolAllocator::Allocate() {
+    if (!m_free && !AddSlab()) {
+        return nullptr;
+    }
+    FreeBlock* block = m_free;
+    if (m_debugFlags & MEMORY_DEBUG_POISON) {
+        UnpoisonMemory(block, m_blockSize);
+        block->canary = 0;
+    }
+    m_free = block->next;
+    m_live++;
+    if (m_debugFlags & MEMORY_DEBUG_POISON) {
+        std::memset(block, MEMORY_FRESH_BYTE, m_blockSize);
+    }
+    return block;
+}
+
+void PoolAllocator::Free(void* pointer) {
+    if (!pointer) {
+        return;
+    }
+    FreeBlock* block = static_cast<FreeBlock*>(pointer);
+    if (m_debugFlags & MEMORY_DEBUG_POISON) {
+        if (!Owns(pointer)) {
+            std::cerr << "PoolAllocator: Pointer " << pointer << " does not belong to the pool" << std::endl;
+            return;
+        }
+        // Метка может совпасть случайно - подтверждаем по списку
+        if (block->canary == FREED_CANARY && IsOnFreeList(block)) {
+            std::cerr << "PoolAllocator: Double free of " << pointer << std::endl;
+            m_doubleFrees++;
+            return;
+        }
+        std::memset(block, MEMORY_POISON_BYTE, m_blockSize);
+        block->canary = FREED_CANARY;
+    }
+    block->next = m_free;
+    m_free = block;
+    m_live--;
+    if (m_debugFlags & MEMORY_DEBUG_POISON) {
+        // Заголовок остается доступным для списка свободных
+        PoisonMemory(reinterpret_cast<uint8_t*>(block) + sizeof(FreeBlock), m_blockSize - sizeof(FreeBlock));
+    }
+}
+
+bool PoolAllocator::Owns(const void* pointer) const {
+    const uint8_t* bytes = static_cast<const uint8_t*>(pointer);
+    const size_t slabSize = m_blockSize * m_blocksPerSlab;
+    for (const Slab& slab : m_slabs) {
+        if (bytes >= slab.data && bytes < slab.data + slabSize) {
+            return static_cast<size_t>(bytes - slab.data) % m_blockSize == 0;
+        }
+    }
+    return false;
+}
+
+bool PoolAllocator::AddSlab() {
+    const size_t slabSize = m_blockSize * m_blocksPerSlab;
+    // Выравнивание больше, чем у malloc, - через aligned operator new
+    uint8_t* data = nullptr;
+    if (m_alignment <= alignof(std::max_align_t)) {
+        data = static_cast<uint8_t*>(std::malloc(slabSize));
+    } else {
+        data = static_cast<uint8_t*>(::operator new(slabSize, std::align_val_t(m_alignment), std::nothrow));
+    }
+    if (!data) {
+        std::cerr << "PoolAllocator: Failed to allocate slab of " << slabSize << " bytes" << std::endl;
+        return false;
+    }
+    MemoryTracker::PushTag(GetPoolTag());
+    MemoryTag tag = MemoryTracker::OnAllocate(slabSize);
+    MemoryTracker::PopTag();
+    m_slabs.push_back(Slab{data, tag});
+
+    // Список в порядке адресов: первые выделения идут подряд
+    for (size_t i = m_blocksPerSlab; i-- > 0;) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(data + i * m_blockSize);
+        block->next = m_free;
+        block->canary = FREED_CANARY;
+        m_free = block;
+        if (m_debugFlags & MEMORY_DEBUG_POISON) {
+            PoisonMemory(data + i * m_blockSize + sizeof(FreeBlock), m_blockSize - sizeof(FreeBlock));
+        }
+    }
+    return true;
+}
+
+bool PoolAllocator::IsOnFreeList(const FreeBlock* block) const {
+    for (const FreeBlock* current = m_free; current; current = current->next) {
+        if (current == block) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// SizeClassAllocator implementation
+SizeClassAllocator::SizeClassAllocator(uint32_t debugFlags)
+    : m_debugFlags(debugFlags) {
+}
+
+SizeClassAllocator::~SizeClassAllocator() = default;
+
+void* SizeClassAllocator::Allocate(size_t size) {
+    if (size == 0 || size > MAX_POOLED_SIZE) {
+        return ::operator new(size ? size : 1, std::nothrow);
+    }
+    SizeClass& sizeClass = m_classes[(size - 1) / GRANULARITY];
+    std::lock_guard<std::mutex> lock(sizeClass.mutex);
+    if (!sizeClass.pool) {
+        size_t blockSize = AlignUp(size, GRANULARITY);
+        // Около 16 КБ на слэб для любого класса
+        sizeClass.pool.reset(new PoolAllocator(blockSize, GRANULARITY, std::max<size_t>(16384 / blockSize, 16), m_debugFlags));
+    }
+    return sizeClass.pool->Allocate();
+}
+
+void SizeClassAllocator::Free(void* pointer, size_t size) {
+    if (!pointer) {
+        return;
+    }
+    if (size == 0 || size > MAX_POOLED_SIZE) {
+        ::operator delete(pointer);
+        return;
+    }
+    SizeClass& sizeClass = m_classes[(size - 1) / GRANULARITY];
+    std::lock_guard<std::mutex> lock(sizeClass.mutex);
+    if (sizeClass.pool) {
+        sizeClass.pool->Free(pointer);
+    }
+}
+
+size_t SizeClassAllocator::GetLiveCount() const {
+    size_t live = 0;
+    for (const SizeClass& sizeClass : m_classes) {
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        if (sizeClass.pool) {
+            live += sizeClass.pool->GetLiveCount();
+        }
+    }
+    return live;
+}
+
+SizeClassAllocator& SizeClassAllocator::GetShared() {
+    // Не уничтожается: статические объекты с компонентами могут пережить его
+    static SizeClassAllocator* shared = new SizeClassAllocator();
+    return *shared;
+}
+
+} // namespace FastEngine
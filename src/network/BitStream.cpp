@@ -0,0 +1,171 @@
+#include "FastEngine/Network/BitStream.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace FastEngine {
+
+// FloatQuantization implementation
+FloatQuantization::FloatQuantization(float minValue, float maxValue, float step)
+    : min(minValue)
+    , max(std::max(minValue, maxValue))
+    , precision(step > 0.0f ? step : 1.0f)
+    , bits(1)
+    , m_maxCode(0) {
+    double steps = std::ceil(static_cast<double>(max - min) / precision);
+    m_maxCode = static_cast<uint32_t>(std::min(steps, 4294967295.0));
+    while (bits < 32 && (m_maxCode >> bits) != 0) {
+        ++bits;
+    }
+}
+
+uint32_t FloatQuantization::Quantize(float value) const {
+    if (!(value > min)) { // Также NaN
+        return 0;
+    }
+    double code = std::floor(static_cast<double>(value - min) / precision + 0.5);
+    return code >= m_maxCode ? m_maxCode : static_cast<uint32_t>(code);
+}
+
+float FloatQuantization::Dequantize(uint32_t value) const {
+    return std::min(max, static_cast<float>(min + static_cast<double>(value) * precision));
+}
+
+// BitWriter implementation
+void BitWriter::WriteVarUint(uint64_t value) {
+    // Группы по 7 бит со старшим битом продолжения
+    while (value >= 0x80) {
+        WriteBits(static_cast<uint32_t>(value & 0x7F) | 0x80, 8);
+        value >>= 7;
+    }
+    WriteBits(static_cast<uint32_t>(value), 8);
+}
+
+void BitWriter::WriteFloat(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    WriteBits(bits, 32);
+}
+
+void BitWriter::WriteBytes(const void* data, uint32_t size) {
+    WriteVarUint(size);
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    if (m_scratchBits % 8 == 0) {
+        // Выровненный поток - копирование целиком
+        FlushBytes();
+        uint32_t copied = std::min(size, m_capacity - m_size);
+        if (copied > 0) {
+            std::memcpy(m_buffer + m_size, bytes, copied);
+        }
+        m_size += copied;
+        if (copied < size) {
+            m_overflow = true;
+        }
+        return;
+    }
+    for (uint32_t i = 0; i < size; ++i) {
+        WriteBits(bytes[i], 8);
+    }
+}
+
+void BitWriter::Flush() {
+    if (m_scratchBits % 8 != 0) {
+        WriteBits(0, 8 - m_scratchBits % 8);
+    }
+    FlushBytes();
+}
+
+void BitWriter::FlushBytes() {
+    while (m_scratchBits >= 8) {
+        if (m_size < m_capacity) {
+            m_buffer[m_size++] = static_cast<uint8_t>(m_scratch);
+        } else {
+            m_overflow = true;
+        }
+        m_scratch >>= 8;
+        m_scratchBits -= 8;
+    }
+}
+
+// BitReader implementation
+bool BitReader::ReadVarUint(uint64_t& value) {
+    value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7) {
+        uint32_t byte = 0;
+        if (!ReadBits(8, byte)) {
+            return false;
+        }
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    // Слишком длинная запись
+    m_error = true;
+    return false;
+}
+
+bool BitReader::ReadVarUint(uint32_t& value) {
+    uint64_t wide = 0;
+    if (!ReadVarUint(wide) || wide > 0xFFFFFFFFull) {
+        m_error = true;
+        value = 0;
+        return false;
+    }
+    value = static_cast<uint32_t>(wide);
+    return true;
+}
+
+bool BitReader::ReadFloat(float& value) {
+    uint32_t bits = 0;
+    if (!ReadBits(32, bits)) {
+        return false;
+    }
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+bool BitReader::ReadString(std::string& value, uint32_t maxSize) {
+    uint32_t size = 0;
+    if (!ReadVarUint(size) || size > maxSize || size * 8ull > GetBitsRemaining()) {
+        m_error = true;
+        return false;
+    }
+    value.resize(size);
+    if (m_scratchBits == 0) {
+        if (size > 0) {
+            std::memcpy(&value[0], m_data + m_position, size);
+        }
+        m_position += size;
+        return true;
+    }
+    for (uint32_t i = 0; i < size; ++i) {
+        uint32_t byte = 0;
+        ReadBits(8, byte);
+        value[i] = static_cast<char>(byte);
+    }
+    return true;
+}
+
+bool BitReader::ReadBytes(uint8_t* data, uint32_t capacity, uint32_t& size) {
+    if (!ReadVarUint(size) || size > capacity || size * 8ull > GetBitsRemaining()) {
+        m_error = true;
+        size = 0;
+        return false;
+    }
+    if (m_scratchBits == 0) {
+        if (size > 0) {
+            std::memcpy(data, m_data + m_position, size);
+        }
+        m_position += size;
+        return true;
+    }
+    for (uint32_t i = 0; i < size; ++i) {
+        uint32_t byte = 0;
+        ReadBits(8, byte);
+        data[i] = static_cast<uint8_t>(byte);
+    }
+    return true;
+}
+
+} // namespace FastEngine
@@ -0,0 +1,513 @@
+#include "FastEngine/Network/NetworkConnection.h"
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+namespace FastEngine {
+
+namespace {
+
+// Заголовок пакета: протокол (2), флаги (1), номер (2), подтверждение (2), битовое поле (4)
+constexpr uint32_t PACKET_HEADER_SIZE = 11;
+
+constexpr uint8_t FLAG_ACK_ELICITING = 1 << 0; // Получатель должен подтвердить пакет
+constexpr uint8_t FLAG_HAS_ACKS = 1 << 1;      // Поля подтверждений заполнены
+
+void WriteU16(uint8_t* data, uint16_t value) {
+    data[0] = static_cast<uint8_t>(value);
+    data[1] = static_cast<uint8_t>(value >> 8);
+}
+
+void WriteU32(uint8_t* data, uint32_t value) {
+    data[0] = static_cast<uint8_t>(value);
+    data[1] = static_cast<uint8_t>(value >> 8);
+    data[2] = static_cast<uint8_t>(value >> 16);
+    data[3] = static_cast<uint8_t>(value >> 24);
+}
+
+uint16_t ReadU16(const uint8_t* data) {
+    return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+
+uint32_t ReadU32(const uint8_t* data) {
+    return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+           (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+bool IsReliable(NetworkChannel channel) {
+    return channel != NetworkChannel::Unreliable;
+}
+
+uint32_t MessageHeaderSize(NetworkChannel channel) {
+    return IsReliable(channel) ? 5 : 3;
+}
+
+} // namespace
+
+NetworkConnection::NetworkConnection(const NetworkAddress& address, PacketPool& pool)
+    : m_address(address)
+    , m_pool(pool)
+    , m_nextSequence(0)
+    , m_lossCursor(0)
+    , m_latestAck(0)
+    , m_hasLatestAck(false)
+    , m_sentPackets(SENT_PACKET_WINDOW)
+    , m_lastSendTime(-1.0)
+    , m_hasReceived(false)
+    , m_ackPending(false)
+    , m_remoteSequence(0)
+    , m_receivedBits(0)
+    , m_lastReceiveTime(0.0)
+    , m_orderedExpected(0)
+    , m_heldMessages(RELIABLE_WINDOW, HeldMessage{false, 0, nullptr})
+    , m_unorderedReceived(RECEIVED_ID_WINDOW, 0) {
+    // Самое мелкое сообщение - ненадежное без данных, 3 байта
+    m_received.reserve(MAX_PACKET_SIZE / 3);
+    for (auto& record : m_sentPackets) {
+        record.sequence = 0;
+        record.tracked = false;
+        record.resolved = true;
+        record.sendTime = 0.0;
+        record.messageCount = 0;
+    }
+    for (auto& channel : m_reliable) {
+        channel.nextId = 0;
+    }
+}
+
+NetworkConnection::~NetworkConnection() {
+    for (NetworkPacket* payload : m_unreliableQueue) {
+        m_pool.Release(payload);
+    }
+    for (auto& channel : m_reliable) {
+        for (auto& message : channel.pending) {
+            m_pool.Release(message.payload);
+        }
+    }
+    for (auto& held : m_heldMessages) {
+        if (held.valid) {
+            m_pool.Release(held.payload);
+        }
+    }
+}
+
+bool NetworkConnection::QueueMessage(NetworkChannel channel, NetworkPacket* payload) {
+    if (!payload) {
+        return false;
+    }
+    if (payload->size > MAX_MESSAGE_SIZE) {
+        std::cerr << "NetworkConnection: Message of " << payload->size << " bytes exceeds "
+                  << MAX_MESSAGE_SIZE << " bytes" << std::endl;
+        m_pool.Release(payload);
+        return false;
+    }
+
+    if (!IsReliable(channel)) {
+        // Ненадежные сообщения при переполнении вытесняют самые старые
+        if (m_unreliableQueue.size() >= MAX_UNRELIABLE_QUEUE) {
+            m_pool.Release(m_unreliableQueue.front());
+            m_unreliableQueue.pop_front();
+        }
+        m_unreliableQueue.push_back(payload);
+        return true;
+    }
+
+    ReliableSendChannel& reliable = GetReliableChannel(channel);
+    if (m_reliable[0].pending.size() + m_reliable[1].pending.size() >= MAX_PENDING_RELIABLE) {
+        std::cerr << "NetworkConnection: Reliable queue overflow for " << m_address.ToString() << std::endl;
+        m_pool.Release(payload);
+        return false;
+    }
+    reliable.pending.push_back(PendingMessage{reliable.nextId++, false, -1.0, payload});
+    return true;
+}
+
+double NetworkConnection::GetResendDelay() const {
+    if (m_stats.rttSamples == 0) {
+        return 0.1;
+    }
+    return std::max(0.03, 1.5 * m_stats.roundTripTime / 1000.0);
+}
+
+int NetworkConnection::WritePackets(double time, NetworkPacket* const* packets, int maxPackets) {
+    ResolveLostPackets(time);
+
+    bool keepalive = m_lastSendTime < 0.0 || time - m_lastSendTime >= KEEPALIVE_INTERVAL;
+    double resendDelay = GetResendDelay();
+    int written = 0;
+
+    while (written < maxPackets) {
+        NetworkPacket* packet = packets[written];
+        SentPacket& record = m_sentPackets[m_nextSequence % SENT_PACKET_WINDOW];
+        if (record.tracked && !record.resolved) {
+            // Запись вытесняется раньше, чем пакет выпал из окна подтверждений
+            record.resolved = true;
+            ++m_stats.packetsLost;
+        }
+        record.messageCount = 0;
+
+        uint32_t offset = PACKET_HEADER_SIZE;
+
+        // Надежные: новые и те, чье подтверждение не пришло за время повтора
+        for (int channelIndex = 0; channelIndex < 2; ++channelIndex) {
+            NetworkChannel channel = channelIndex == 0 ? NetworkChannel::ReliableOrdered : NetworkChannel::ReliableUnordered;
+            ReliableSendChannel& reliable = m_reliable[channelIndex];
+            size_t window = std::min(reliable.pending.size(), static_cast<size_t>(RELIABLE_WINDOW));
+            for (size_t i = 0; i < window && record.messageCount < MAX_MESSAGES_PER_PACKET; ++i) {
+                PendingMessage& message = reliable.pending[i];
+                if (message.acked || (message.lastSendTime >= 0.0 && time - message.lastSendTime < resendDelay)) {
+                    continue;
+                }
+                uint32_t size = message.payload->size;
+                if (offset + MessageHeaderSize(channel) + size > MAX_PACKET_SIZE) {
+                    continue;
+                }
+
+                packet->data[offset] = static_cast<uint8_t>(channel);
+                WriteU16(packet->data + offset + 1, message.id);
+                WriteU16(packet->data + offset + 3, static_cast<uint16_t>(size));
+                std::memcpy(packet->data + offset + 5, message.payload->data, size);
+                offset += 5 + size;
+
+                message.lastSendTime = time;
+                record.channels[record.messageCount] = static_cast<uint8_t>(channel);
+                record.messageIds[record.messageCount] = message.id;
+                ++record.messageCount;
+            }
+        }
+
+        // Ненадежные: отправляются один раз
+        uint32_t unreliableCount = 0;
+        while (!m_unreliableQueue.empty() && record.messageCount + unreliableCount < MAX_MESSAGES_PER_PACKET) {
+            NetworkPacket* payload = m_unreliableQueue.front();
+            if (offset + 3 + payload->size > MAX_PACKET_SIZE) {
+                break;
+            }
+            packet->data[offset] = static_cast<uint8_t>(NetworkChannel::Unreliable);
+            WriteU16(packet->data + offset + 1, static_cast<uint16_t>(payload->size));
+            std::memcpy(packet->data + offset + 3, payload->data, payload->size);
+            offset += 3 + payload->size;
+            m_pool.Release(payload);
+            m_unreliableQueue.pop_front();
+            ++unreliableCount;
+        }
+
+        bool hasMessages = record.messageCount + unreliableCount > 0;
+        if (!hasMessages && (written > 0 || (!m_ackPending && !keepalive))) {
+            break;
+        }
+
+        uint8_t flags = 0;
+        if (hasMessages || keepalive) {
+            flags |= FLAG_ACK_ELICITING;
+        }
+        if (m_hasReceived) {
+            flags |= FLAG_HAS_ACKS;
+        }
+        WriteU16(packet->data, PROTOCOL_ID);
+        packet->data[2] = flags;
+        WriteU16(packet->data + 3, m_nextSequence);
+        WriteU16(packet->data + 5, m_remoteSequence);
+        WriteU32(packet->data + 7, m_receivedBits);
+        packet->size = offset;
+        packet->address = m_address;
+
+        record.sequence = m_nextSequence;
+        record.tracked = (flags & FLAG_ACK_ELICITING) != 0;
+        record.resolved = !record.tracked;
+        record.sendTime = time;
+        ++m_nextSequence;
+
+        ++m_stats.packetsSent;
+        m_stats.bytesSent += offset;
+        m_ackPending = false;
+        keepalive = false;
+        m_lastSendTime = time;
+        ++written;
+
+        if (!hasMessages) {
+            break;
+        }
+    }
+
+    return written;
+}
+
+bool NetworkConnection::ReadPacket(const NetworkPacket& packet, double time, NetworkDeliverFunc deliver, void* userData) {
+    if (packet.size < PACKET_HEADER_SIZE || ReadU16(packet.data) != PROTOCOL_ID) {
+        return false;
+    }
+
+    uint8_t flags = packet.data[2];
+    uint16_t sequence = ReadU16(packet.data + 3);
+    uint16_t ack = ReadU16(packet.data + 5);
+    uint32_t ackBits = ReadU32(packet.data + 7);
+
+    ++m_stats.packetsReceived;
+    m_stats.bytesReceived += packet.size;
+    m_lastReceiveTime = time;
+
+    if (!IsNewSequence(sequence)) {
+        return true; // Дубликат
+    }
+    if (flags & FLAG_HAS_ACKS) {
+        ProcessAcks(ack, ackBits, time);
+    }
+
+    // Новые сообщения сначала копируются в буферы пула. Номер пакета
+    // отмечается принятым (и будет подтвержден) только если буферов
+    // хватило: иначе отправитель повторит надежные сообщения
+    bool valid = true;
+    bool stored = true;
+    uint16_t orderedExpected = m_orderedExpected;
+    uint32_t offset = PACKET_HEADER_SIZE;
+    while (offset < packet.size) {
+        if (packet.data[offset] >= NETWORK_CHANNEL_COUNT) {
+            valid = false;
+            break;
+        }
+        NetworkChannel channel = static_cast<NetworkChannel>(packet.data[offset]);
+        uint32_t headerSize = MessageHeaderSize(channel);
+        if (offset + headerSize > packet.size) {
+            valid = false;
+            break;
+        }
+
+        uint16_t id = 0;
+        uint32_t size;
+        if (IsReliable(channel)) {
+            id = ReadU16(packet.data + offset + 1);
+            size = ReadU16(packet.data + offset + 3);
+        } else {
+            size = ReadU16(packet.data + offset + 1);
+        }
+        offset += headerSize;
+        if (offset + size > packet.size) {
+            valid = false;
+            break;
+        }
+
+        if (NeedsDelivery(channel, id)) {
+            // Придержанное сообщение занимает буфер до прихода пропущенных,
+            // поэтому последняя четверть пула остается для доставки по
+            // порядку - иначе пропущенному сообщению может не хватить места
+            if (channel == NetworkChannel::ReliableOrdered) {
+                if (id == orderedExpected) {
+                    ++orderedExpected;
+                } else if (m_pool.GetFreeCount() <= m_pool.GetCapacity() / 4) {
+                    stored = false;
+                    break;
+                }
+            }
+            NetworkPacket* payload = m_pool.Acquire();
+            if (!payload) {
+                stored = false;
+                break;
+            }
+            std::memcpy(payload->data, packet.data + offset, size);
+            payload->size = size;
+            m_received.push_back(ReceivedMessage{channel, id, payload});
+        }
+        offset += size;
+    }
+
+    if (!valid || !stored) {
+        for (const ReceivedMessage& message : m_received) {
+            m_pool.Release(message.payload);
+        }
+        m_received.clear();
+        if (!stored) {
+            ++m_stats.packetsRefused;
+        }
+        return valid;
+    }
+
+    MarkSequenceReceived(sequence);
+    if (flags & FLAG_ACK_ELICITING) {
+        m_ackPending = true;
+    }
+    for (const ReceivedMessage& message : m_received) {
+        if (IsReliable(message.channel)) {
+            DeliverReliable(message, deliver, userData);
+        } else {
+            deliver(userData, message.payload);
+        }
+    }
+    m_received.clear();
+    return true;
+}
+
+bool NetworkConnection::IsNewSequence(uint16_t sequence) const {
+    if (!m_hasReceived || SequenceGreater(sequence, m_remoteSequence)) {
+        return true;
+    }
+
+    uint16_t age = static_cast<uint16_t>(m_remoteSequence - sequence);
+    if (age == 0) {
+        return false;
+    }
+    if (age > 32) {
+        return true; // Слишком старый для окна, надежные сообщения отсеются по id
+    }
+    return (m_receivedBits & (1u << (age - 1))) == 0;
+}
+
+void NetworkConnection::MarkSequenceReceived(uint16_t sequence) {
+    if (!m_hasReceived) {
+        m_hasReceived = true;
+        m_remoteSequence = sequence;
+        m_receivedBits = 0;
+        return;
+    }
+
+    if (SequenceGreater(sequence, m_remoteSequence)) {
+        uint16_t shift = static_cast<uint16_t>(sequence - m_remoteSequence);
+        if (shift > 32) {
+            m_receivedBits = 0;
+        } else {
+            m_receivedBits = (shift == 32 ? 0u : (m_receivedBits << shift)) | (1u << (shift - 1));
+        }
+        m_remoteSequence = sequence;
+        return;
+    }
+
+    uint16_t age = static_cast<uint16_t>(m_remoteSequence - sequence);
+    if (age > 0 && age <= 32) {
+        m_receivedBits |= 1u << (age - 1);
+    }
+}
+
+void NetworkConnection::ProcessAcks(uint16_t ack, uint32_t ackBits, double time) {
+    // Подтверждение пакета, который еще не отправлялся, - мусор
+    if (!SequenceGreater(m_nextSequence, ack)) {
+        return;
+    }
+
+    for (uint16_t i = 0; i <= 32; ++i) {
+        if (i > 0 && !(ackBits & (1u << (i - 1)))) {
+            continue;
+        }
+        uint16_t sequence = static_cast<uint16_t>(ack - i);
+        SentPacket& record = m_sentPackets[sequence % SENT_PACKET_WINDOW];
+        if (record.sequence == sequence && record.tracked && !record.resolved) {
+            AckPacket(record, time);
+        }
+    }
+
+    if (!m_hasLatestAck || SequenceGreater(ack, m_latestAck)) {
+        m_latestAck = ack;
+        m_hasLatestAck = true;
+    }
+    ResolveLostPackets(time);
+    ReleaseAckedMessages(m_reliable[0]);
+    ReleaseAckedMessages(m_reliable[1]);
+}
+
+void NetworkConnection::AckPacket(SentPacket& record, double time) {
+    record.resolved = true;
+    ++m_stats.packetsAcked;
+
+    float sample = static_cast<float>((time - record.sendTime) * 1000.0);
+    m_stats.roundTripTime = m_stats.rttSamples == 0 ? sample : m_stats.roundTripTime + 0.1f * (sample - m_stats.roundTripTime);
+    ++m_stats.rttSamples;
+
+    for (uint32_t i = 0; i < record.messageCount; ++i) {
+        ReliableSendChannel& reliable = GetReliableChannel(static_cast<NetworkChannel>(record.channels[i]));
+        if (reliable.pending.empty()) {
+            continue;
+        }
+        // Ожидающие сообщения идут подряд по id - позиция вычисляется
+        uint16_t index = static_cast<uint16_t>(record.messageIds[i] - reliable.pending.front().id);
+        if (index < reliable.pending.size() && reliable.pending[index].id == record.messageIds[i]) {
+            reliable.pending[index].acked = true;
+        }
+    }
+}
+
+void NetworkConnection::ResolveLostPackets(double time) {
+    if (static_cast<uint16_t>(m_nextSequence - m_lossCursor) > SENT_PACKET_WINDOW) {
+        m_lossCursor = static_cast<uint16_t>(m_nextSequence - SENT_PACKET_WINDOW);
+    }
+
+    // Пакет потерян, если он выпал из окна подтверждений последнего ack
+    // или подтверждение не пришло за несколько RTT
+    double lossTimeout = m_stats.rttSamples == 0 ? 1.0 : std::max(0.2, 4.0 * m_stats.roundTripTime / 1000.0);
+    while (m_lossCursor != m_nextSequence) {
+        SentPacket& record = m_sentPackets[m_lossCursor % SENT_PACKET_WINDOW];
+        if (record.sequence == m_lossCursor && record.tracked && !record.resolved) {
+            bool outOfWindow = m_hasLatestAck && SequenceGreater(m_latestAck, m_lossCursor) &&
+                               static_cast<uint16_t>(m_latestAck - m_lossCursor) > 32;
+            if (!outOfWindow && time - record.sendTime < lossTimeout) {
+                break;
+            }
+            record.resolved = true;
+            ++m_stats.packetsLost;
+        }
+        ++m_lossCursor;
+    }
+}
+
+void NetworkConnection::ReleaseAckedMessages(ReliableSendChannel& channel) {
+    while (!channel.pending.empty() && channel.pending.front().acked) {
+        m_pool.Release(channel.pending.front().payload);
+        channel.pending.pop_front();
+    }
+}
+
+bool NetworkConnection::NeedsDelivery(NetworkChannel channel, uint16_t id) const {
+    if (channel == NetworkChannel::Unreliable) {
+        return true;
+    }
+    if (channel == NetworkChannel::ReliableUnordered) {
+        return m_unorderedReceived[id % RECEIVED_ID_WINDOW] != static_cast<uint32_t>(id) + 1;
+    }
+
+    // Уже доставлено, за окном отправителя (поврежденный пакет) или уже придержано
+    uint16_t distance = static_cast<uint16_t>(id - m_orderedExpected);
+    if (distance >= RELIABLE_WINDOW) {
+        return false;
+    }
+    const HeldMessage& held = m_heldMessages[id % RELIABLE_WINDOW];
+    return distance == 0 || !held.valid;
+}
+
+void NetworkConnection::DeliverReliable(const ReceivedMessage& message, NetworkDeliverFunc deliver, void* userData) {
+    uint16_t id = message.id;
+    if (message.channel == NetworkChannel::ReliableUnordered) {
+        uint32_t& slot = m_unorderedReceived[id % RECEIVED_ID_WINDOW];
+        if (slot == static_cast<uint32_t>(id) + 1) {
+            m_pool.Release(message.payload); // Повтор внутри пакета
+            return;
+        }
+        slot = static_cast<uint32_t>(id) + 1;
+        deliver(userData, message.payload);
+        return;
+    }
+
+    uint16_t distance = static_cast<uint16_t>(id - m_orderedExpected);
+    if (distance == 0) {
+        deliver(userData, message.payload);
+        ++m_orderedExpected;
+
+        // Придержанные сообщения, ставшие следующими по порядку
+        while (true) {
+            HeldMessage& held = m_heldMessages[m_orderedExpected % RELIABLE_WINDOW];
+            if (!held.valid || held.id != m_orderedExpected) {
+                break;
+            }
+            deliver(userData, held.payload);
+            held.valid = false;
+            ++m_orderedExpected;
+        }
+        return;
+    }
+
+    HeldMessage& held = m_heldMessages[id % RELIABLE_WINDOW];
+    if (distance >= RELIABLE_WINDOW || held.valid) {
+        m_pool.Release(message.payload);
+        return;
+    }
+    held = HeldMessage{true, id, message.payload};
+}
+
+} // namespace FastEngine
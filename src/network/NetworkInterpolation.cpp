@@ -0,0 +1,150 @@
+#include "FastEngine/Network/NetworkInterpolation.h"
+#include <algorithm>
+#include <cmath>
+
+namespace FastEngine {
+
+namespace {
+
+// Разность углов в градусах по кратчайшей дуге
+glm::vec3 AngleDelta(const glm::vec3& from, const glm::vec3& to) {
+    glm::vec3 delta;
+    for (int i = 0; i < 3; ++i) {
+        float d = std::fmod(to[i] - from[i], 360.0f);
+        if (d > 180.0f) {
+            d -= 360.0f;
+        } else if (d < -180.0f) {
+            d += 360.0f;
+        }
+        delta[i] = d;
+    }
+    return delta;
+}
+
+} // namespace
+
+// NetworkTimeline implementation
+NetworkTimeline::NetworkTimeline()
+    : m_count(0)
+    , m_maxExtrapolation(0.25) {
+}
+
+void NetworkTimeline::AddSample(double time, const glm::vec3& position, const glm::vec3& rotation) {
+    // Снимки приходят почти по порядку: место ищется с конца
+    uint32_t index = m_count;
+    while (index > 0 && m_samples[index - 1].time > time) {
+        --index;
+    }
+    if (index > 0 && m_samples[index - 1].time == time) {
+        m_samples[index - 1].position = position;
+        m_samples[index - 1].rotation = rotation;
+        return;
+    }
+
+    if (m_count == CAPACITY) {
+        if (index == 0) {
+            return; // Старше всей шкалы
+        }
+        // Вытеснение самого старого состояния
+        std::move(m_samples + 1, m_samples + index, m_samples);
+        --index;
+    } else {
+        std::move_backward(m_samples + index, m_samples + m_count, m_samples + m_count + 1);
+        ++m_count;
+    }
+    m_samples[index] = NetworkStateSample{time, position, rotation};
+}
+
+bool NetworkTimeline::Sample(double time, glm::vec3& position, glm::vec3& rotation) const {
+    if (m_count == 0) {
+        return false;
+    }
+    if (time <= m_samples[0].time) {
+        position = m_samples[0].position;
+        rotation = m_samples[0].rotation;
+        return true;
+    }
+
+    uint32_t next = m_count;
+    while (next > 0 && m_samples[next - 1].time >= time) {
+        --next;
+    }
+    if (next < m_count) {
+        const NetworkStateSample& from = m_samples[next - 1];
+        const NetworkStateSample& to = m_samples[next];
+        const float t = static_cast<float>((time - from.time) / (to.time - from.time));
+        position = from.position + (to.position - from.position) * t;
+        rotation = from.rotation + AngleDelta(from.rotation, to.rotation) * t;
+        return true;
+    }
+
+    const NetworkStateSample& last = m_samples[m_count - 1];
+    position = last.position;
+    rotation = last.rotation;
+    if (m_count >= 2 && m_maxExtrapolation > 0.0) {
+        const NetworkStateSample& previous = m_samples[m_count - 2];
+        const double ahead = std::min(time - last.time, m_maxExtrapolation);
+        const float factor = static_cast<float>(ahead / (last.time - previous.time));
+        position += (last.position - previous.position) * factor;
+        rotation += AngleDelta(previous.rotation, last.rotation) * factor;
+    }
+    return true;
+}
+
+// InterpolationClock implementation
+InterpolationClock::InterpolationClock()
+    : m_snapshotMargin(2.0)
+    , m_jitterMultiplier(2.0)
+    , m_minDelay(0.0)
+    , m_maxDelay(1.0) {
+    Reset();
+}
+
+void InterpolationClock::Reset() {
+    m_synchronized = false;
+    m_offset = 0.0;
+    m_lastTransit = 0.0;
+    m_lastServerTime = 0.0;
+    m_interval = 0.0;
+    m_jitter = 0.0;
+    m_delay = std::min(std::max(0.1, m_minDelay), m_maxDelay);
+}
+
+void InterpolationClock::SetDelayBounds(double minDelay, double maxDelay) {
+    m_minDelay = std::max(minDelay, 0.0);
+    m_maxDelay = std::max(maxDelay, m_minDelay);
+    m_delay = std::min(std::max(m_delay, m_minDelay), m_maxDelay);
+}
+
+void InterpolationClock::AddSnapshot(double serverTime, double localTime) {
+    const double transit = localTime - serverTime;
+    if (!m_synchronized) {
+        m_synchronized = true;
+        m_offset = transit;
+        m_lastTransit = transit;
+        m_lastServerTime = serverTime;
+        return;
+    }
+
+    m_jitter += (std::abs(transit - m_lastTransit) - m_jitter) / 16.0;
+    m_lastTransit = transit;
+    if (serverTime > m_lastServerTime) {
+        const double gap = serverTime - m_lastServerTime;
+        m_interval = m_interval > 0.0 ? m_interval + (gap - m_interval) * 0.125 : gap;
+        m_lastServerTime = serverTime;
+    }
+
+    // Самый быстрый пакет задает смещение сразу, медленный рост
+    // отслеживает дрейф часов и смену маршрута
+    if (transit < m_offset) {
+        m_offset = transit;
+    } else {
+        m_offset += (transit - m_offset) * 0.01;
+    }
+
+    double target = m_snapshotMargin * m_interval + m_jitterMultiplier * m_jitter;
+    target = std::min(std::max(target, m_minDelay), m_maxDelay);
+    m_delay += (target - m_delay) * 0.1;
+}
+
+} // namespace FastEngine
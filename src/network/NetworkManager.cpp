@@ -2,29 +2,163 @@
 #include <iostream>
 #include <algorithm>
 #include <sstream>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
 
 namespace FastEngine {
 
+namespace {
+
+// Разбор плоского JSON, который пишет NetworkObject::Serialize
+bool FindJsonString(const std::string& data, const char* key, std::string& value) {
+    std::string pattern = std::string("\"") + key + "\":";
+    size_t position = data.find(pattern);
+    if (position == std::string::npos) {
+        return false;
+    }
+    size_t begin = data.find('"', position + pattern.size());
+    size_t end = begin == std::string::npos ? std::string::npos : data.find('"', begin + 1);
+    if (end == std::string::npos) {
+        return false;
+    }
+    value.assign(data, begin + 1, end - begin - 1);
+    return true;
+}
+
+bool FindJsonVector(const std::string& data, const char* key, glm::vec3& value) {
+    std::string pattern = std::string("\"") + key + "\":";
+    size_t position = data.find(pattern);
+    if (position == std::string::npos) {
+        return false;
+    }
+    const char* components[3] = {"\"x\":", "\"y\":", "\"z\":"};
+    glm::vec3 result(0.0f);
+    for (int i = 0; i < 3; ++i) {
+        position = data.find(components[i], position);
+        if (position == std::string::npos) {
+            return false;
+        }
+        position += 4;
+        char* end = nullptr;
+        result[i] = std::strtof(data.c_str() + position, &end);
+        if (end == data.c_str() + position) {
+            return false;
+        }
+    }
+    value = result;
+    return true;
+}
+
+// {"x": .., "y": .., "z": ..}; %g совпадает с форматом operator<< по умолчанию
+void AppendJsonVector(std::string& out, const glm::vec3& value) {
+    char buffer[128];
+    int length = std::snprintf(buffer, sizeof(buffer), "{\"x\": %g, \"y\": %g, \"z\": %g}",
+                               value.x, value.y, value.z);
+    if (length > 0) {
+        out.append(buffer, std::min(static_cast<size_t>(length), sizeof(buffer) - 1));
+    }
+}
+
+} // namespace
+
 // NetworkObject implementation
 NetworkObject::NetworkObject() 
-    : m_position(0.0f)
+    : m_netId(0)
+    , m_position(0.0f)
     , m_rotation(0.0f)
     , m_dirty(false) {
 }
 
 std::string NetworkObject::Serialize() const {
-    std::stringstream ss;
-    ss << "{\n";
-    ss << "  \"id\": \"" << m_id << "\",\n";
-    ss << "  \"ownerId\": \"" << m_ownerId << "\",\n";
-    ss << "  \"position\": {\"x\": " << m_position.x << ", \"y\": " << m_position.y << ", \"z\": " << m_position.z << "},\n";
-    ss << "  \"rotation\": {\"x\": " << m_rotation.x << ", \"y\": " << m_rotation.y << ", \"z\": " << m_rotation.z << "}\n";
-    ss << "}";
-    return ss.str();
+    // Одна строка с резервом вместо stringstream: одно выделение на вызов
+    std::string result;
+    result.reserve(256 + m_id.size() + m_ownerId.size());
+    result += "{\n  \"id\": \"";
+    result += m_id;
+    result += "\",\n  \"ownerId\": \"";
+    result += m_ownerId;
+    result += "\",\n  \"position\": ";
+    AppendJsonVector(result, m_position);
+    result += ",\n  \"rotation\": ";
+    AppendJsonVector(result, m_rotation);
+    result += "\n}";
+    return result;
 }
 
 void NetworkObject::Deserialize(const std::string& data) {
-    std::cout << "Deserializing network object: " << m_id << std::endl;
+    glm::vec3 position = m_position;
+    glm::vec3 rotation = m_rotation;
+    if (!FindJsonVector(data, "position", position) || !FindJsonVector(data, "rotation", rotation)) {
+        std::cerr << "NetworkObject: Failed to deserialize object " << m_id << std::endl;
+        return;
+    }
+    FindJsonString(data, "id", m_id);
+    FindJsonString(data, "ownerId", m_ownerId);
+    m_position = position;
+    m_rotation = rotation;
+}
+
+void NetworkObject::WriteState(BitWriter& writer, const NetworkObjectSchema& schema, uint32_t fields) const {
+    fields &= NETWORK_FIELD_ALL;
+    writer.WriteBits(fields, NETWORK_OBJECT_FIELD_COUNT);
+    if (fields & NETWORK_FIELD_POSITION) {
+        writer.WriteQuantized(m_position, schema.position);
+    }
+    if (fields & NETWORK_FIELD_ROTATION) {
+        writer.WriteQuantized(m_rotation, schema.rotation);
+    }
+    if (fields & NETWORK_FIELD_OWNER) {
+        writer.WriteString(m_ownerId);
+    }
+}
+
+bool NetworkObject::ReadState(BitReader& reader, const NetworkObjectSchema& schema) {
+    uint32_t fields = 0;
+    glm::vec3 position = m_position;
+    glm::vec3 rotation = m_rotation;
+    if (!reader.ReadBits(NETWORK_OBJECT_FIELD_COUNT, fields)) {
+        return false;
+    }
+    if ((fields & NETWORK_FIELD_POSITION) && !reader.ReadQuantized(schema.position, position)) {
+        return false;
+    }
+    if ((fields & NETWORK_FIELD_ROTATION) && !reader.ReadQuantized(schema.rotation, rotation)) {
+        return false;
+    }
+    if (fields & NETWORK_FIELD_OWNER) {
+        // Владелец меняется редко, временная строка только в этом случае
+        std::string ownerId;
+        if (!reader.ReadString(ownerId, 255)) {
+            return false;
+        }
+        m_ownerId.swap(ownerId);
+    }
+    m_position = position;
+    m_rotation = rotation;
+    return true;
+}
+
+// NetworkMessage implementation
+void NetworkMessage::Write(BitWriter& writer, NetworkMessageType type, uint32_t sequence, uint32_t timestamp,
+                           const std::string& senderId, const void* data, uint32_t size) {
+    writer.WriteBits(static_cast<uint32_t>(type), 4);
+    writer.WriteVarUint(sequence);
+    writer.WriteVarUint(timestamp);
+    writer.WriteString(senderId);
+    writer.WriteBytes(data, size);
+    writer.Flush();
+}
+
+bool NetworkMessage::Read(BitReader& reader) {
+    uint32_t messageType = 0;
+    if (!reader.ReadBits(4, messageType) || messageType > static_cast<uint32_t>(NetworkMessageType::Custom)) {
+        return false;
+    }
+    type = static_cast<NetworkMessageType>(messageType);
+    return reader.ReadVarUint(sequence) && reader.ReadVarUint(timestamp) &&
+           reader.ReadString(senderId, 255) && reader.ReadString(data, NetworkConnection::MAX_MESSAGE_SIZE);
 }
 
 // NetworkProfiler implementation
@@ -33,20 +167,19 @@ NetworkProfiler::NetworkProfiler()
     , m_bandwidthUsage(0.0f)
     , m_messagesSent(0)
     , m_messagesReceived(0)
+    , m_packetsSent(0)
     , m_packetsLost(0) {
 }
 
 void NetworkProfiler::RecordMessageSent(const NetworkMessage& message) {
     ++m_messagesSent;
-    std::cout << "NetworkProfiler: Message sent: " << static_cast<int>(message.type) << std::endl;
 }
 
 void NetworkProfiler::RecordMessageReceived(const NetworkMessage& message) {
     ++m_messagesReceived;
-    std::cout << "NetworkProfiler: Message received: " << static_cast<int>(message.type) << std::endl;
 }
 
-void NetworkProfiler::RecordLatency(uint32_t latency) {
+void NetworkProfiler::RecordLatency(float latency) {
     m_latencyHistory.push_back(latency);
     if (m_latencyHistory.size() > 100) {
         m_latencyHistory.erase(m_latencyHistory.begin());
@@ -67,6 +200,7 @@ void NetworkProfiler::Reset() {
     m_bandwidthUsage = 0.0f;
     m_messagesSent = 0;
     m_messagesReceived = 0;
+    m_packetsSent = 0;
     m_packetsLost = 0;
     m_latencyHistory.clear();
     m_bandwidthHistory.clear();
@@ -80,7 +214,7 @@ void NetworkProfiler::UpdateAverageLatency() {
     }
     
     float sum = 0.0f;
-    for (uint32_t latency : m_latencyHistory) {
+    for (float latency : m_latencyHistory) {
         sum += latency;
     }
     m_averageLatency = sum / m_latencyHistory.size();
@@ -99,22 +233,44 @@ void NetworkProfiler::UpdateBandwidthUsage() {
     m_bandwidthUsage = sum / m_bandwidthHistory.size();
 }
 
+namespace {
+
+constexpr size_t PACKET_POOL_SIZE = 4096;
+constexpr size_t MESSAGE_RING_SIZE = 2048;
+
+static_assert(NetworkConnection::MAX_PENDING_RELIABLE < PACKET_POOL_SIZE,
+              "One connection must not be able to hold the whole packet pool");
+
+} // namespace
+
 // NetworkManager implementation
 NetworkManager::NetworkManager() 
     : m_initialized(false)
     , m_connected(false)
     , m_isServer(false)
     , m_port(0)
-    , m_running(false) {
+    , m_packetPool(PACKET_POOL_SIZE)
+    , m_sendRing(MESSAGE_RING_SIZE)
+    , m_receiveRing(MESSAGE_RING_SIZE)
+    , m_maxConnections(64)
+    , m_connectionTimeout(10.0f)
+    , m_running(false)
+    , m_connectionCount(0)
+    , m_statPacketsSent(0)
+    , m_statPacketsLost(0)
+    , m_statBytes(0)
+    , m_statRttSamples(0)
+    , m_statRoundTripTime(0.0f)
+    , m_droppedMessages(0)
+    , m_reportedPacketsSent(0)
+    , m_reportedPacketsLost(0)
+    , m_reportedBytes(0)
+    , m_reportedRttSamples(0)
+    , m_replicator(nullptr) {
 }
 
 NetworkManager::~NetworkManager() {
-    if (m_running) {
-        m_running = false;
-        if (m_networkThread.joinable()) {
-            m_networkThread.join();
-        }
-    }
+    StopNetworkThread();
 }
 
 bool NetworkManager::Initialize() {
@@ -140,35 +296,61 @@ void NetworkManager::Shutdown() {
     std::cout << "NetworkManager shutdown" << std::endl;
 }
 
+void NetworkManager::SetTransport(std::unique_ptr<NetworkTransport> transport) {
+    if (m_running) {
+        std::cerr << "NetworkManager: Cannot change transport while running" << std::endl;
+        return;
+    }
+    m_transport = std::move(transport);
+}
+
+NetworkAddress NetworkManager::GetLocalAddress() const {
+    return m_transport ? m_transport->GetLocalAddress() : NetworkAddress();
+}
+
 bool NetworkManager::Connect(const std::string& host, int port) {
     if (!m_initialized) {
         std::cerr << "NetworkManager: Not initialized" << std::endl;
         return false;
     }
+    if (m_running) {
+        std::cerr << "NetworkManager: Already connected" << std::endl;
+        return false;
+    }
+    
+    NetworkAddress serverAddress;
+    if (!NetworkAddress::Resolve(host, port, serverAddress)) {
+        std::cerr << "NetworkManager: Cannot resolve " << host << ":" << port << std::endl;
+        return false;
+    }
     
     m_host = host;
     m_port = port;
-    m_connected = true;
+    m_serverAddress = serverAddress;
+    m_isServer = false;
     
     // Запускаем сетевой поток
-    m_running = true;
-    m_networkThread = std::thread(&NetworkManager::NetworkThreadFunction, this);
+    if (!StartNetworkThread(0)) {
+        return false;
+    }
+    m_connected = true;
+    SendMessage(NetworkMessage(NetworkMessageType::Connect, ""));
     
     std::cout << "NetworkManager: Connected to " << host << ":" << port << std::endl;
     return true;
 }
 
 bool NetworkManager::Disconnect() {
-    if (!m_connected) {
+    if (!m_connected || m_isServer) {
         return false;
     }
     
-    m_connected = false;
-    m_running = false;
+    // Уходит последней отправкой сетевого потока
+    SendMessage(NetworkMessage(NetworkMessageType::Disconnect, "", "", NetworkChannel::Unreliable));
+    ProcessSendQueue();
     
-    if (m_networkThread.joinable()) {
-        m_networkThread.join();
-    }
+    m_connected = false;
+    StopNetworkThread();
     
     std::cout << "NetworkManager: Disconnected" << std::endl;
     return true;
@@ -179,16 +361,26 @@ bool NetworkManager::StartServer(int port) {
         std::cerr << "NetworkManager: Not initialized" << std::endl;
         return false;
     }
+    if (m_running) {
+        std::cerr << "NetworkManager: Already running" << std::endl;
+        return false;
+    }
+    if (port < 0 || port > 0xFFFF) {
+        std::cerr << "NetworkManager: Invalid port " << port << std::endl;
+        return false;
+    }
     
     m_port = port;
     m_isServer = true;
-    m_connected = true;
     
     // Запускаем сетевой поток
-    m_running = true;
-    m_networkThread = std::thread(&NetworkManager::NetworkThreadFunction, this);
+    if (!StartNetworkThread(static_cast<uint16_t>(port))) {
+        m_isServer = false;
+        return false;
+    }
+    m_connected = true;
     
-    std::cout << "NetworkManager: Started server on port " << port << std::endl;
+    std::cout << "NetworkManager: Started server on port " << GetLocalAddress().port << std::endl;
     return true;
 }
 
@@ -197,13 +389,12 @@ bool NetworkManager::StopServer() {
         return false;
     }
     
+    BroadcastMessage(NetworkMessage(NetworkMessageType::Disconnect, "", "", NetworkChannel::Unreliable));
+    ProcessSendQueue();
+    
     m_isServer = false;
     m_connected = false;
-    m_running = false;
-    
-    if (m_networkThread.joinable()) {
-        m_networkThread.join();
-    }
+    StopNetworkThread();
     
     std::cout << "NetworkManager: Stopped server" << std::endl;
     return true;
@@ -278,21 +469,74 @@ std::shared_ptr<NetworkObject> NetworkManager::GetObject(const std::string& obje
 }
 
 void NetworkManager::SendMessage(const NetworkMessage& message) {
-    std::lock_guard<std::mutex> lock(m_sendMutex);
-    m_sendQueue.push(message);
-    m_profiler.RecordMessageSent(message);
+    QueueOutgoing(message, message.data.data(), static_cast<uint32_t>(message.data.size()),
+                  m_isServer ? NetworkAddress() : m_serverAddress, m_isServer);
+}
+
+void NetworkManager::SendPayload(NetworkMessageType type, const uint8_t* data, uint32_t size, NetworkChannel channel) {
+    // Пустые строки заголовка не выделяют память
+    NetworkMessage header;
+    header.type = type;
+    header.channel = channel;
+    QueueOutgoing(header, data, size, m_isServer ? NetworkAddress() : m_serverAddress, m_isServer);
+}
+
+void NetworkManager::SendPayloadToPlayer(const std::string& playerId, NetworkMessageType type, const uint8_t* data,
+                                         uint32_t size, NetworkChannel channel) {
+    NetworkAddress address;
+    if (!NetworkAddress::Parse(playerId, address)) {
+        std::cerr << "NetworkManager: Player " << playerId << " has no network address" << std::endl;
+        return;
+    }
+    NetworkMessage header;
+    header.type = type;
+    header.channel = channel;
+    QueueOutgoing(header, data, size, address, false);
 }
 
 void NetworkManager::SendMessageToPlayer(const std::string& playerId, const NetworkMessage& message) {
-    // В реальной реализации здесь бы отправлялось сообщение конкретному игроку
-    SendMessage(message);
-    std::cout << "NetworkManager: Sent message to player " << playerId << std::endl;
+    // Идентификатор игрока, подключившегося по сети, - адрес его узла
+    NetworkAddress address;
+    if (!NetworkAddress::Parse(playerId, address)) {
+        std::cerr << "NetworkManager: Player " << playerId << " has no network address" << std::endl;
+        return;
+    }
+    QueueOutgoing(message, message.data.data(), static_cast<uint32_t>(message.data.size()), address, false);
 }
 
 void NetworkManager::BroadcastMessage(const NetworkMessage& message) {
-    // В реальной реализации здесь бы отправлялось сообщение всем игрокам
-    SendMessage(message);
-    std::cout << "NetworkManager: Broadcasted message" << std::endl;
+    QueueOutgoing(message, message.data.data(), static_cast<uint32_t>(message.data.size()), NetworkAddress(), true);
+}
+
+void NetworkManager::QueueOutgoing(const NetworkMessage& header, const void* data, uint32_t size,
+                                   const NetworkAddress& target, bool broadcast) {
+    if (!m_running) {
+        std::cerr << "NetworkManager: Not connected" << std::endl;
+        return;
+    }
+    
+    NetworkPacket* payload = m_packetPool.Acquire();
+    if (!payload) {
+        std::cerr << "NetworkManager: Packet pool exhausted, message dropped" << std::endl;
+        m_droppedMessages.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    
+    BitWriter writer(payload->data, NetworkConnection::MAX_MESSAGE_SIZE);
+    NetworkMessage::Write(writer, header.type, header.sequence, header.timestamp, header.senderId, data, size);
+    if (writer.IsOverflow()) {
+        std::cerr << "NetworkManager: Message is too large (" << size << " bytes)" << std::endl;
+        m_packetPool.Release(payload);
+        return;
+    }
+    payload->size = writer.GetBytesWritten();
+    payload->address = target;
+    
+    OutgoingMessage outgoing{payload, header.channel, broadcast};
+    if (!m_sendBacklog.empty() || !m_sendRing.Push(outgoing)) {
+        m_sendBacklog.push_back(outgoing);
+    }
+    m_profiler.RecordMessageSent(header);
 }
 
 void NetworkManager::Update(float deltaTime) {
@@ -303,39 +547,340 @@ void NetworkManager::Update(float deltaTime) {
     ProcessReceivedMessages();
     ProcessSendQueue();
     UpdateObjects(deltaTime);
-    SynchronizeObjects();
+    SynchronizeObjects(deltaTime);
+    UpdateProfiler(deltaTime);
 }
 
 std::vector<NetworkMessage> NetworkManager::GetReceivedMessages() {
-    std::lock_guard<std::mutex> lock(m_receiveMutex);
     std::vector<NetworkMessage> messages;
+    NetworkMessage message;
     
-    while (!m_receiveQueue.empty()) {
-        messages.push_back(m_receiveQueue.front());
-        m_receiveQueue.pop();
+    while (PopReceivedMessage(message)) {
+        messages.push_back(message);
     }
     
     return messages;
 }
 
+bool NetworkManager::PopReceivedMessage(NetworkMessage& message) {
+    NetworkPacket* payload = nullptr;
+    while (m_receiveRing.Pop(payload)) {
+        BitReader reader(payload->data, payload->size);
+        bool valid = message.Read(reader);
+        NetworkAddress from = payload->address;
+        m_packetPool.Release(payload);
+        
+        if (valid) {
+            if (message.senderId.empty()) {
+                message.senderId = from.ToString();
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
 void NetworkManager::NetworkThreadFunction() {
     std::cout << "NetworkManager: Network thread started" << std::endl;
     
-    while (m_running) {
-        // В реальной реализации здесь бы обрабатывались сетевые соединения
-        std::this_thread::sleep_for(std::chrono::milliseconds(16));
+    auto startTime = std::chrono::steady_clock::now();
+    double time = 0.0;
+    
+    while (m_running.load(std::memory_order_acquire)) {
+        time = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        
+        bool received = ReceiveData(time);
+        bool sent = SendData(time);
+        
+        // Узлы, от которых давно нет пакетов
+        for (size_t i = m_connections.size(); i-- > 0;) {
+            if (time - m_connections[i]->GetLastReceiveTime() > m_connectionTimeout) {
+                HandleDisconnection(i);
+            }
+        }
+        
+        PublishStats();
+        
+        if (!received && !sent) {
+            m_transport->WaitForData(1);
+        }
     }
     
+    // Последняя отправка: сообщения, поставленные перед остановкой
+    time = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    SendData(time);
+    PublishStats();
+    
     std::cout << "NetworkManager: Network thread stopped" << std::endl;
 }
 
-void NetworkManager::ProcessReceivedMessages() {
-    std::lock_guard<std::mutex> lock(m_receiveMutex);
+bool NetworkManager::StartNetworkThread(uint16_t port) {
+    if (!m_transport) {
+        m_transport.reset(new UdpTransport());
+    }
+    if (!m_transport->Open(port)) {
+        std::cerr << "NetworkManager: Failed to open transport" << std::endl;
+        return false;
+    }
+    
+    m_sendBuffers.resize(NETWORK_BATCH_SIZE);
+    m_receiveBuffers.resize(NETWORK_BATCH_SIZE);
+    
+    if (!m_isServer) {
+        m_connections.emplace_back(new NetworkConnection(m_serverAddress, m_packetPool));
+        m_connectionIndex[m_serverAddress] = 0;
+        m_connectionCount.store(1, std::memory_order_relaxed);
+    }
+    
+    m_running.store(true, std::memory_order_release);
+    m_networkThread = std::thread(&NetworkManager::NetworkThreadFunction, this);
+    return true;
+}
+
+void NetworkManager::StopNetworkThread() {
+    m_running.store(false, std::memory_order_release);
+    if (m_networkThread.joinable()) {
+        m_networkThread.join();
+    }
+    
+    // Поток остановлен - его состояние доступно игровому потоку
+    while (!m_connections.empty()) {
+        HandleDisconnection(m_connections.size() - 1);
+    }
+    PublishStats();
+    if (m_transport) {
+        m_transport->Close();
+    }
     
-    while (!m_receiveQueue.empty()) {
-        NetworkMessage message = m_receiveQueue.front();
-        m_receiveQueue.pop();
+    OutgoingMessage outgoing;
+    while (m_sendRing.Pop(outgoing)) {
+        m_packetPool.Release(outgoing.payload);
+    }
+    for (const auto& backlog : m_sendBacklog) {
+        m_packetPool.Release(backlog.payload);
+    }
+    m_sendBacklog.clear();
+    NetworkPacket* payload = nullptr;
+    while (m_receiveRing.Pop(payload)) {
+        m_packetPool.Release(payload);
+    }
+    for (NetworkPacket* backlog : m_receiveBacklog) {
+        m_packetPool.Release(backlog);
+    }
+    m_receiveBacklog.clear();
+}
+
+bool NetworkManager::SendData(double time) {
+    // Сообщения игрового потока - в очереди соединений
+    OutgoingMessage outgoing;
+    while (m_sendRing.Pop(outgoing)) {
+        if (!outgoing.broadcast) {
+            NetworkConnection* connection = FindConnection(outgoing.payload->address);
+            if (connection) {
+                connection->QueueMessage(outgoing.channel, outgoing.payload);
+            } else {
+                m_packetPool.Release(outgoing.payload);
+                m_droppedMessages.fetch_add(1, std::memory_order_relaxed);
+            }
+            continue;
+        }
         
+        if (m_connections.empty()) {
+            m_packetPool.Release(outgoing.payload);
+            continue;
+        }
+        for (size_t i = 1; i < m_connections.size(); ++i) {
+            NetworkPacket* copy = m_packetPool.Acquire();
+            if (!copy) {
+                m_droppedMessages.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            std::memcpy(copy->data, outgoing.payload->data, outgoing.payload->size);
+            copy->size = outgoing.payload->size;
+            m_connections[i]->QueueMessage(outgoing.channel, copy);
+        }
+        m_connections[0]->QueueMessage(outgoing.channel, outgoing.payload);
+    }
+    
+    // Пакеты всех соединений уходят пачками
+    NetworkPacket* batch[NETWORK_BATCH_SIZE];
+    for (int i = 0; i < NETWORK_BATCH_SIZE; ++i) {
+        batch[i] = &m_sendBuffers[i];
+    }
+    
+    int count = 0;
+    bool sent = false;
+    for (auto& connection : m_connections) {
+        while (true) {
+            int written = connection->WritePackets(time, batch + count, NETWORK_BATCH_SIZE - count);
+            count += written;
+            if (count < NETWORK_BATCH_SIZE) {
+                break;
+            }
+            m_transport->SendBatch(batch, count);
+            count = 0;
+            sent = true;
+        }
+    }
+    if (count > 0) {
+        m_transport->SendBatch(batch, count);
+        sent = true;
+    }
+    return sent;
+}
+
+bool NetworkManager::ReceiveData(double time) {
+    FlushReceiveBacklog();
+    
+    NetworkPacket* batch[NETWORK_BATCH_SIZE];
+    for (int i = 0; i < NETWORK_BATCH_SIZE; ++i) {
+        batch[i] = &m_receiveBuffers[i];
+    }
+    
+    bool received = false;
+    while (true) {
+        int count = m_transport->ReceiveBatch(batch, NETWORK_BATCH_SIZE);
+        for (int i = 0; i < count; ++i) {
+            const NetworkPacket& packet = *batch[i];
+            NetworkConnection* connection = FindConnection(packet.address);
+            if (!connection && m_isServer && packet.size >= 2 &&
+                (packet.data[0] | (packet.data[1] << 8)) == NetworkConnection::PROTOCOL_ID) {
+                connection = HandleConnection(packet.address);
+            }
+            if (!connection) {
+                continue;
+            }
+            m_deliverFrom = packet.address;
+            connection->ReadPacket(packet, time, &NetworkManager::DeliverMessage, this);
+        }
+        received = received || count > 0;
+        if (count < NETWORK_BATCH_SIZE) {
+            break;
+        }
+    }
+    return received;
+}
+
+void NetworkManager::DeliverMessage(void* userData, NetworkPacket* payload) {
+    NetworkManager* manager = static_cast<NetworkManager*>(userData);
+    payload->address = manager->m_deliverFrom;
+    manager->PushReceived(payload);
+}
+
+void NetworkManager::PushReceived(NetworkPacket* payload) {
+    // Соединение уже подтвердило пакет - сообщение не теряется. Очередь
+    // ограничена пулом: каждое ожидающее сообщение держит его буфер
+    if (!m_receiveBacklog.empty() || !m_receiveRing.Push(payload)) {
+        m_receiveBacklog.push_back(payload);
+    }
+}
+
+void NetworkManager::FlushReceiveBacklog() {
+    size_t pushed = 0;
+    while (pushed < m_receiveBacklog.size() && m_receiveRing.Push(m_receiveBacklog[pushed])) {
+        ++pushed;
+    }
+    m_receiveBacklog.erase(m_receiveBacklog.begin(), m_receiveBacklog.begin() + pushed);
+}
+
+NetworkConnection* NetworkManager::FindConnection(const NetworkAddress& address) {
+    auto it = m_connectionIndex.find(address);
+    return it != m_connectionIndex.end() ? m_connections[it->second].get() : nullptr;
+}
+
+NetworkConnection* NetworkManager::HandleConnection(const NetworkAddress& address) {
+    if (static_cast<int>(m_connections.size()) >= m_maxConnections) {
+        return nullptr;
+    }
+    
+    m_connectionIndex[address] = m_connections.size();
+    m_connections.emplace_back(new NetworkConnection(address, m_packetPool));
+    m_connectionCount.store(static_cast<int>(m_connections.size()), std::memory_order_relaxed);
+    return m_connections.back().get();
+}
+
+void NetworkManager::HandleDisconnection(size_t index) {
+    NetworkConnection& connection = *m_connections[index];
+    
+    // Игровой поток узнает об отключении обычным сообщением Disconnect
+    if (m_running.load(std::memory_order_relaxed)) {
+        NetworkPacket* payload = m_packetPool.Acquire();
+        if (payload) {
+            BitWriter writer(payload->data, MAX_PACKET_SIZE);
+            NetworkMessage::Write(writer, NetworkMessageType::Disconnect, 0, 0, std::string(), nullptr, 0);
+            payload->size = writer.GetBytesWritten();
+            payload->address = connection.GetAddress();
+            PushReceived(payload);
+        }
+    }
+    
+    const NetworkConnectionStats& stats = connection.GetStats();
+    m_closedStats.packetsSent += stats.packetsSent;
+    m_closedStats.packetsLost += stats.packetsLost;
+    m_closedStats.bytesSent += stats.bytesSent;
+    m_closedStats.bytesReceived += stats.bytesReceived;
+    m_closedStats.rttSamples += stats.rttSamples;
+    
+    m_connectionIndex.erase(connection.GetAddress());
+    if (index + 1 != m_connections.size()) {
+        m_connections[index] = std::move(m_connections.back());
+        m_connectionIndex[m_connections[index]->GetAddress()] = index;
+    }
+    m_connections.pop_back();
+    m_connectionCount.store(static_cast<int>(m_connections.size()), std::memory_order_relaxed);
+}
+
+void NetworkManager::PublishStats() {
+    NetworkConnectionStats total = m_closedStats;
+    float roundTripTime = 0.0f;
+    int measured = 0;
+    for (const auto& connection : m_connections) {
+        const NetworkConnectionStats& stats = connection->GetStats();
+        total.packetsSent += stats.packetsSent;
+        total.packetsLost += stats.packetsLost;
+        total.bytesSent += stats.bytesSent;
+        total.bytesReceived += stats.bytesReceived;
+        total.rttSamples += stats.rttSamples;
+        if (stats.rttSamples > 0) {
+            roundTripTime += stats.roundTripTime;
+            ++measured;
+        }
+    }
+    
+    m_statPacketsSent.store(total.packetsSent, std::memory_order_relaxed);
+    m_statPacketsLost.store(total.packetsLost, std::memory_order_relaxed);
+    m_statBytes.store(total.bytesSent + total.bytesReceived, std::memory_order_relaxed);
+    if (measured > 0) {
+        m_statRoundTripTime.store(roundTripTime / measured, std::memory_order_relaxed);
+    }
+    m_statRttSamples.store(total.rttSamples, std::memory_order_release);
+}
+
+void NetworkManager::UpdateProfiler(float deltaTime) {
+    uint32_t samples = m_statRttSamples.load(std::memory_order_acquire);
+    uint32_t packetsSent = m_statPacketsSent.load(std::memory_order_relaxed);
+    uint32_t packetsLost = m_statPacketsLost.load(std::memory_order_relaxed);
+    uint64_t bytes = m_statBytes.load(std::memory_order_relaxed);
+    
+    m_profiler.RecordPacketsSent(packetsSent - m_reportedPacketsSent);
+    m_profiler.RecordPacketsLost(packetsLost - m_reportedPacketsLost);
+    if (samples != m_reportedRttSamples) {
+        m_profiler.RecordLatency(m_statRoundTripTime.load(std::memory_order_relaxed));
+    }
+    if (m_running && deltaTime > 0.0f) {
+        m_profiler.RecordBandwidth(static_cast<float>(bytes - m_reportedBytes) / deltaTime);
+    }
+    
+    m_reportedPacketsSent = packetsSent;
+    m_reportedPacketsLost = packetsLost;
+    m_reportedBytes = bytes;
+    m_reportedRttSamples = samples;
+}
+
+void NetworkManager::ProcessReceivedMessages() {
+    NetworkMessage message;
+    
+    while (PopReceivedMessage(message)) {
         m_profiler.RecordMessageReceived(message);
         HandleMessage(message);
         
@@ -346,24 +891,25 @@ void NetworkManager::ProcessReceivedMessages() {
 }
 
 void NetworkManager::ProcessSendQueue() {
-    std::lock_guard<std::mutex> lock(m_sendMutex);
-    
-    while (!m_sendQueue.empty()) {
-        NetworkMessage message = m_sendQueue.front();
-        m_sendQueue.pop();
-        
-        // В реальной реализации здесь бы отправлялись данные по сети
-        std::cout << "NetworkManager: Sending message type " << static_cast<int>(message.type) << std::endl;
+    // Сообщения, не поместившиеся в очередь сетевого потока
+    size_t pushed = 0;
+    while (pushed < m_sendBacklog.size() && m_sendRing.Push(m_sendBacklog[pushed])) {
+        ++pushed;
     }
+    m_sendBacklog.erase(m_sendBacklog.begin(), m_sendBacklog.begin() + pushed);
 }
 
 void NetworkManager::HandleMessage(const NetworkMessage& message) {
     switch (message.type) {
         case NetworkMessageType::Connect:
-            std::cout << "NetworkManager: Handle connect message" << std::endl;
+            if (m_isServer && !GetPlayer(message.senderId)) {
+                AddPlayer(message.senderId, message.data.empty() ? message.senderId : message.data);
+            }
             break;
         case NetworkMessageType::Disconnect:
-            std::cout << "NetworkManager: Handle disconnect message" << std::endl;
+            if (GetPlayer(message.senderId)) {
+                RemovePlayer(message.senderId);
+            }
             break;
         case NetworkMessageType::PlayerJoin:
             std::cout << "NetworkManager: Handle player join message" << std::endl;
@@ -371,9 +917,6 @@ void NetworkManager::HandleMessage(const NetworkMessage& message) {
         case NetworkMessageType::PlayerLeave:
             std::cout << "NetworkManager: Handle player leave message" << std::endl;
             break;
-        case NetworkMessageType::PlayerUpdate:
-            std::cout << "NetworkManager: Handle player update message" << std::endl;
-            break;
         case NetworkMessageType::ObjectSpawn:
             std::cout << "NetworkManager: Handle object spawn message" << std::endl;
             break;
@@ -381,10 +924,13 @@ void NetworkManager::HandleMessage(const NetworkMessage& message) {
             std::cout << "NetworkManager: Handle object destroy message" << std::endl;
             break;
         case NetworkMessageType::ObjectUpdate:
-            std::cout << "NetworkManager: Handle object update message" << std::endl;
+            if (m_replicator) {
+                m_replicator->HandleMessage(message);
+            }
             break;
+        case NetworkMessageType::PlayerUpdate:
         case NetworkMessageType::Custom:
-            std::cout << "NetworkManager: Handle custom message" << std::endl;
+            // Частые сообщения обрабатываются в OnMessageReceived
             break;
     }
 }
@@ -397,10 +943,13 @@ void NetworkManager::UpdateObjects(float deltaTime) {
     }
 }
 
-void NetworkManager::SynchronizeObjects() {
+void NetworkManager::SynchronizeObjects(float deltaTime) {
+    // Сервер рассылает снимки, клиент интерполирует принятые объекты
+    if (m_replicator) {
+        m_replicator->UpdateReplication(deltaTime);
+    }
     for (auto& object : m_objects) {
         if (object && object->IsDirty()) {
-            // В реальной реализации здесь бы синхронизировались объекты
             object->SetDirty(false);
         }
     }
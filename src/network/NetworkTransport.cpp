@@ -0,0 +1,491 @@
+#include "FastEngine/Network/NetworkTransport.h"
+#include <iostream>
+#include <sstream>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+
+#if defined(_WIN32) || defined(_WIN64)
+// UDP-транспорт пока реализован только для POSIX
+#else
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace FastEngine {
+
+// NetworkAddress implementation
+bool NetworkAddress::Resolve(const std::string& host, int port, NetworkAddress& address) {
+    if (port <= 0 || port > 0xFFFF) {
+        return false;
+    }
+
+    if (host.empty() || host == "localhost") {
+        address = NetworkAddress(0x7F000001u, static_cast<uint16_t>(port));
+        return true;
+    }
+
+    // Точечная запись разбирается без обращения к резолверу
+    unsigned int parts[4];
+    char tail = 0;
+    if (std::sscanf(host.c_str(), "%u.%u.%u.%u%c", &parts[0], &parts[1], &parts[2], &parts[3], &tail) == 4 &&
+        parts[0] < 256 && parts[1] < 256 && parts[2] < 256 && parts[3] < 256) {
+        address = NetworkAddress((parts[0] << 24) | (parts[1] << 16) | (parts[2] << 8) | parts[3],
+                                 static_cast<uint16_t>(port));
+        return true;
+    }
+
+#if defined(_WIN32) || defined(_WIN64)
+    return false;
+#else
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(host.c_str(), nullptr, &hints, &result) != 0 || !result) {
+        return false;
+    }
+    const sockaddr_in* resolved = reinterpret_cast<const sockaddr_in*>(result->ai_addr);
+    address = NetworkAddress(ntohl(resolved->sin_addr.s_addr), static_cast<uint16_t>(port));
+    freeaddrinfo(result);
+    return true;
+#endif
+}
+
+bool NetworkAddress::Parse(const std::string& endpoint, NetworkAddress& address) {
+    size_t colon = endpoint.rfind(':');
+    if (colon == std::string::npos) {
+        return false;
+    }
+    int port = std::atoi(endpoint.c_str() + colon + 1);
+    return Resolve(endpoint.substr(0, colon), port, address);
+}
+
+std::string NetworkAddress::ToString() const {
+    std::stringstream ss;
+    ss << ((ip >> 24) & 0xFF) << "." << ((ip >> 16) & 0xFF) << "." << ((ip >> 8) & 0xFF) << "." << (ip & 0xFF)
+       << ":" << port;
+    return ss.str();
+}
+
+// PacketPool implementation
+PacketPool::PacketPool(size_t capacity)
+    : m_capacity(capacity)
+    , m_packets(new NetworkPacket[capacity])
+    , m_next(new std::atomic<uint32_t>[capacity])
+    , m_head(capacity > 0 ? 0 : INVALID_INDEX)
+    , m_freeCount(capacity) {
+    for (size_t i = 0; i < capacity; ++i) {
+        m_next[i].store(i + 1 < capacity ? static_cast<uint32_t>(i + 1) : INVALID_INDEX, std::memory_order_relaxed);
+    }
+}
+
+NetworkPacket* PacketPool::Acquire() {
+    uint64_t head = m_head.load(std::memory_order_acquire);
+    while (true) {
+        uint32_t index = static_cast<uint32_t>(head);
+        if (index == INVALID_INDEX) {
+            return nullptr;
+        }
+        uint64_t next = ((head >> 32) + 1) << 32 | m_next[index].load(std::memory_order_relaxed);
+        if (m_head.compare_exchange_weak(head, next, std::memory_order_acquire, std::memory_order_acquire)) {
+            m_freeCount.fetch_sub(1, std::memory_order_relaxed);
+            NetworkPacket* packet = &m_packets[index];
+            packet->size = 0;
+            return packet;
+        }
+    }
+}
+
+void PacketPool::Release(NetworkPacket* packet) {
+    if (!packet) {
+        return;
+    }
+
+    uint32_t index = static_cast<uint32_t>(packet - m_packets.get());
+    uint64_t head = m_head.load(std::memory_order_relaxed);
+    while (true) {
+        m_next[index].store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        uint64_t next = ((head >> 32) + 1) << 32 | index;
+        if (m_head.compare_exchange_weak(head, next, std::memory_order_release, std::memory_order_relaxed)) {
+            m_freeCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+}
+
+// UdpTransport implementation
+UdpTransport::UdpTransport() : m_socket(-1) {}
+
+UdpTransport::~UdpTransport() {
+    Close();
+}
+
+#if defined(_WIN32) || defined(_WIN64)
+
+bool UdpTransport::Open(uint16_t port) {
+    std::cerr << "UdpTransport: Not supported on this platform" << std::endl;
+    return false;
+}
+
+void UdpTransport::Close() {}
+
+int UdpTransport::SendBatch(NetworkPacket* const* packets, int count) { return 0; }
+
+int UdpTransport::ReceiveBatch(NetworkPacket* const* packets, int count) { return 0; }
+
+void UdpTransport::WaitForData(int timeoutMs) {}
+
+#else
+
+namespace {
+
+void ToSockAddr(const NetworkAddress& address, sockaddr_in& out) {
+    std::memset(&out, 0, sizeof(out));
+    out.sin_family = AF_INET;
+    out.sin_addr.s_addr = htonl(address.ip);
+    out.sin_port = htons(address.port);
+}
+
+NetworkAddress FromSockAddr(const sockaddr_in& in) {
+    return NetworkAddress(ntohl(in.sin_addr.s_addr), ntohs(in.sin_port));
+}
+
+} // namespace
+
+bool UdpTransport::Open(uint16_t port) {
+    Close();
+
+    m_socket = socket(AF_INET, SOCK_DGRAM, 0);
+    if (m_socket < 0) {
+        std::cerr << "UdpTransport: Failed to create socket: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    // Буферы сокета побольше: пачка пакетов не должна теряться в ядре
+    int bufferSize = 1 << 20;
+    setsockopt(m_socket, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+    setsockopt(m_socket, SOL_SOCKET, SO_SNDBUF, &bufferSize, sizeof(bufferSize));
+
+    sockaddr_in bindAddress;
+    ToSockAddr(NetworkAddress(INADDR_ANY, port), bindAddress);
+    if (bind(m_socket, reinterpret_cast<sockaddr*>(&bindAddress), sizeof(bindAddress)) < 0) {
+        std::cerr << "UdpTransport: Failed to bind port " << port << ": " << std::strerror(errno) << std::endl;
+        Close();
+        return false;
+    }
+
+    int flags = fcntl(m_socket, F_GETFL, 0);
+    if (flags < 0 || fcntl(m_socket, F_SETFL, flags | O_NONBLOCK) < 0) {
+        std::cerr << "UdpTransport: Failed to make socket nonblocking" << std::endl;
+        Close();
+        return false;
+    }
+
+    sockaddr_in local;
+    socklen_t length = sizeof(local);
+    getsockname(m_socket, reinterpret_cast<sockaddr*>(&local), &length);
+    m_localAddress = FromSockAddr(local);
+    return true;
+}
+
+void UdpTransport::Close() {
+    if (m_socket >= 0) {
+        close(m_socket);
+        m_socket = -1;
+    }
+    m_localAddress = NetworkAddress();
+}
+
+int UdpTransport::SendBatch(NetworkPacket* const* packets, int count) {
+    if (m_socket < 0) {
+        return 0;
+    }
+
+    int sent = 0;
+    while (sent < count) {
+        int batch = std::min(count - sent, NETWORK_BATCH_SIZE);
+        sockaddr_in addresses[NETWORK_BATCH_SIZE];
+#if defined(__linux__)
+        mmsghdr messages[NETWORK_BATCH_SIZE];
+        iovec buffers[NETWORK_BATCH_SIZE];
+        std::memset(messages, 0, sizeof(mmsghdr) * batch);
+        for (int i = 0; i < batch; ++i) {
+            NetworkPacket* packet = packets[sent + i];
+            ToSockAddr(packet->address, addresses[i]);
+            buffers[i].iov_base = packet->data;
+            buffers[i].iov_len = packet->size;
+            messages[i].msg_hdr.msg_name = &addresses[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            messages[i].msg_hdr.msg_iov = &buffers[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+        int result = sendmmsg(m_socket, messages, batch, 0);
+        if (result <= 0) {
+            if (result < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                // Пакет с недоступным адресом пропускаем, иначе он заблокирует пачку
+                ++sent;
+                continue;
+            }
+            break;
+        }
+        sent += result;
+#else
+        (void)addresses;
+        NetworkPacket* packet = packets[sent];
+        sockaddr_in address;
+        ToSockAddr(packet->address, address);
+        ssize_t result = sendto(m_socket, packet->data, packet->size, 0,
+                                reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        ++sent;
+#endif
+    }
+    return sent;
+}
+
+int UdpTransport::ReceiveBatch(NetworkPacket* const* packets, int count) {
+    if (m_socket < 0 || count <= 0) {
+        return 0;
+    }
+
+    count = std::min(count, NETWORK_BATCH_SIZE);
+    sockaddr_in addresses[NETWORK_BATCH_SIZE];
+#if defined(__linux__)
+    mmsghdr messages[NETWORK_BATCH_SIZE];
+    iovec buffers[NETWORK_BATCH_SIZE];
+    std::memset(messages, 0, sizeof(mmsghdr) * count);
+    for (int i = 0; i < count; ++i) {
+        buffers[i].iov_base = packets[i]->data;
+        buffers[i].iov_len = MAX_PACKET_SIZE;
+        messages[i].msg_hdr.msg_name = &addresses[i];
+        messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        messages[i].msg_hdr.msg_iov = &buffers[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
+    int received = recvmmsg(m_socket, messages, count, MSG_DONTWAIT, nullptr);
+    if (received <= 0) {
+        return 0;
+    }
+    for (int i = 0; i < received; ++i) {
+        packets[i]->size = messages[i].msg_len;
+        packets[i]->address = FromSockAddr(addresses[i]);
+    }
+    return received;
+#else
+    int received = 0;
+    while (received < count) {
+        socklen_t length = sizeof(sockaddr_in);
+        ssize_t result = recvfrom(m_socket, packets[received]->data, MAX_PACKET_SIZE, 0,
+                                  reinterpret_cast<sockaddr*>(&addresses[received]), &length);
+        if (result < 0) {
+            break;
+        }
+        packets[received]->size = static_cast<uint32_t>(result);
+        packets[received]->address = FromSockAddr(addresses[received]);
+        ++received;
+    }
+    return received;
+#endif
+}
+
+void UdpTransport::WaitForData(int timeoutMs) {
+    if (m_socket < 0) {
+        return;
+    }
+    pollfd descriptor;
+    descriptor.fd = m_socket;
+    descriptor.events = POLLIN;
+    descriptor.revents = 0;
+    poll(&descriptor, 1, timeoutMs);
+}
+
+#endif
+
+// LoopbackTransport implementation
+
+/**
+ * Входящая очередь транспорта; общая таблица портов держит слабые ссылки
+ */
+struct LoopbackTransport::Endpoint {
+    struct Datagram {
+        NetworkAddress from;
+        std::chrono::steady_clock::time_point deliverTime;
+        uint32_t size;
+        uint8_t data[MAX_PACKET_SIZE];
+    };
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<Datagram> queue;
+};
+
+namespace {
+
+struct LoopbackNetwork {
+    std::mutex mutex;
+    std::unordered_map<uint16_t, std::weak_ptr<LoopbackTransport::Endpoint>> endpoints;
+    uint16_t nextPort = 49152;
+};
+
+LoopbackNetwork& GetLoopbackNetwork() {
+    static LoopbackNetwork network;
+    return network;
+}
+
+} // namespace
+
+LoopbackTransport::LoopbackTransport()
+    : m_packetLoss(0.0f)
+    , m_latencyMs(0.0f)
+    , m_random(12345u) {}
+
+LoopbackTransport::~LoopbackTransport() {
+    Close();
+}
+
+bool LoopbackTransport::Open(uint16_t port) {
+    Close();
+
+    LoopbackNetwork& network = GetLoopbackNetwork();
+    std::lock_guard<std::mutex> lock(network.mutex);
+
+    if (port == 0) {
+        for (int attempt = 0; attempt < 0x4000; ++attempt) {
+            uint16_t candidate = network.nextPort;
+            network.nextPort = network.nextPort == 0xFFFF ? 49152 : network.nextPort + 1;
+            auto it = network.endpoints.find(candidate);
+            if (it == network.endpoints.end() || it->second.expired()) {
+                port = candidate;
+                break;
+            }
+        }
+        if (port == 0) {
+            std::cerr << "LoopbackTransport: No free ports" << std::endl;
+            return false;
+        }
+    } else {
+        auto it = network.endpoints.find(port);
+        if (it != network.endpoints.end() && !it->second.expired()) {
+            std::cerr << "LoopbackTransport: Port " << port << " is already in use" << std::endl;
+            return false;
+        }
+    }
+
+    m_endpoint = std::make_shared<Endpoint>();
+    network.endpoints[port] = m_endpoint;
+    m_localAddress = NetworkAddress(0x7F000001u, port);
+    return true;
+}
+
+void LoopbackTransport::Close() {
+    if (!m_endpoint) {
+        return;
+    }
+
+    LoopbackNetwork& network = GetLoopbackNetwork();
+    {
+        std::lock_guard<std::mutex> lock(network.mutex);
+        network.endpoints.erase(m_localAddress.port);
+    }
+    m_endpoint.reset();
+    m_localAddress = NetworkAddress();
+}
+
+int LoopbackTransport::SendBatch(NetworkPacket* const* packets, int count) {
+    if (!m_endpoint) {
+        return 0;
+    }
+
+    auto deliverTime = std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<float, std::milli>(m_latencyMs));
+
+    LoopbackNetwork& network = GetLoopbackNetwork();
+    for (int i = 0; i < count; ++i) {
+        const NetworkPacket* packet = packets[i];
+
+        // Потеря - как в настоящей сети: пакет считается отправленным
+        m_random = m_random * 1664525u + 1013904223u;
+        if (static_cast<float>(m_random >> 8) / static_cast<float>(1u << 24) < m_packetLoss) {
+            continue;
+        }
+
+        std::shared_ptr<Endpoint> target;
+        {
+            std::lock_guard<std::mutex> lock(network.mutex);
+            auto it = network.endpoints.find(packet->address.port);
+            if (it != network.endpoints.end()) {
+                target = it->second.lock();
+            }
+        }
+        if (!target) {
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(target->mutex);
+            target->queue.emplace_back();
+            Endpoint::Datagram& datagram = target->queue.back();
+            datagram.from = m_localAddress;
+            datagram.deliverTime = deliverTime;
+            datagram.size = packet->size;
+            std::memcpy(datagram.data, packet->data, packet->size);
+        }
+        target->condition.notify_one();
+    }
+    return count;
+}
+
+int LoopbackTransport::ReceiveBatch(NetworkPacket* const* packets, int count) {
+    if (!m_endpoint) {
+        return 0;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(m_endpoint->mutex);
+    int received = 0;
+    while (received < count && !m_endpoint->queue.empty() && m_endpoint->queue.front().deliverTime <= now) {
+        const Endpoint::Datagram& datagram = m_endpoint->queue.front();
+        packets[received]->address = datagram.from;
+        packets[received]->size = datagram.size;
+        std::memcpy(packets[received]->data, datagram.data, datagram.size);
+        m_endpoint->queue.pop_front();
+        ++received;
+    }
+    return received;
+}
+
+void LoopbackTransport::WaitForData(int timeoutMs) {
+    if (!m_endpoint) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_endpoint->mutex);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    if (!m_endpoint->queue.empty()) {
+        // Данные есть, но могут быть еще "в пути"
+        deadline = std::min(deadline, m_endpoint->queue.front().deliverTime);
+    }
+    m_endpoint->condition.wait_until(lock, deadline, [this]() {
+        return !m_endpoint->queue.empty() && m_endpoint->queue.front().deliverTime <= std::chrono::steady_clock::now();
+    });
+}
+
+} // namespace FastEngine
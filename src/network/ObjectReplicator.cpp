@@ -0,0 +1,838 @@
+#include "FastEngine/Network/NetworkManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace FastEngine {
+
+// Пакет репликатора: вид (2 бита), номер снимка (varint), далее
+// снимок: серверное время в мс (varint), число удалений и их netId (varint), затем объекты, каждый
+// с битом-признаком продолжения: netId (varint), бит базы и расстояние
+// до нее в снимках (varint), маска полей (NetworkObjectField), коды полей
+// (с базой - бит и 7-битная разность либо полный код), владелец (строка)
+namespace {
+
+enum ReplicationPacketKind : uint32_t {
+    REPLICATION_SNAPSHOT = 0,
+    REPLICATION_ACK = 1
+};
+
+constexpr uint32_t PACKET_KIND_BITS = 2;
+constexpr uint32_t SMALL_DELTA_BITS = 7;
+constexpr uint32_t MAX_SNAPSHOT_PAYLOAD = NetworkConnection::MAX_MESSAGE_SIZE - 16;
+
+uint32_t HashOwner(const std::string& owner) {
+    uint32_t hash = 2166136261u;
+    for (char c : owner) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    return hash;
+}
+
+// Квантование кода поля: позиция xyz, затем поворот xyz
+const FloatQuantization& CodeQuantization(const NetworkObjectSchema& schema, uint32_t index) {
+    return index < 3 ? schema.position : schema.rotation;
+}
+
+template <typename Stream>
+void WriteCode(Stream& stream, uint32_t code, const uint32_t* base, uint32_t bits) {
+    if (base) {
+        int64_t delta = static_cast<int64_t>(code) - static_cast<int64_t>(*base);
+        uint64_t zigzag = (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63);
+        if (zigzag < (1u << SMALL_DELTA_BITS)) {
+            stream.WriteBits(0, 1);
+            stream.WriteBits(static_cast<uint32_t>(zigzag), SMALL_DELTA_BITS);
+            return;
+        }
+        stream.WriteBits(1, 1);
+    }
+    stream.WriteBits(code, bits);
+}
+
+bool ReadCode(BitReader& reader, const uint32_t* base, const FloatQuantization& quantization, uint32_t& code) {
+    if (base) {
+        uint32_t full = 0;
+        if (!reader.ReadBits(1, full)) {
+            return false;
+        }
+        if (full == 0) {
+            uint32_t zigzag = 0;
+            if (!reader.ReadBits(SMALL_DELTA_BITS, zigzag)) {
+                return false;
+            }
+            int64_t delta = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+            int64_t value = static_cast<int64_t>(*base) + delta;
+            if (value < 0 || value > quantization.GetMaxCode()) {
+                return false;
+            }
+            code = static_cast<uint32_t>(value);
+            return true;
+        }
+    }
+    return reader.ReadBits(quantization.bits, code) && code <= quantization.GetMaxCode();
+}
+
+// Запись объекта; без базы - все поля целиком
+template <typename Stream>
+void WriteObjectRecord(Stream& stream, const NetworkObjectSchema& schema, uint32_t netId, const uint32_t* codes,
+                       const uint32_t* baseCodes, uint32_t baselineDistance, bool ownerChanged,
+                       const std::string& owner) {
+    uint32_t fields = NETWORK_FIELD_ALL;
+    if (baseCodes) {
+        fields = ownerChanged ? static_cast<uint32_t>(NETWORK_FIELD_OWNER) : 0u;
+        if (codes[0] != baseCodes[0] || codes[1] != baseCodes[1] || codes[2] != baseCodes[2]) {
+            fields |= NETWORK_FIELD_POSITION;
+        }
+        if (codes[3] != baseCodes[3] || codes[4] != baseCodes[4] || codes[5] != baseCodes[5]) {
+            fields |= NETWORK_FIELD_ROTATION;
+        }
+    }
+
+    stream.WriteVarUint(netId);
+    stream.WriteBits(baseCodes ? 1u : 0u, 1);
+    if (baseCodes) {
+        stream.WriteVarUint(baselineDistance);
+    }
+    stream.WriteBits(fields, NETWORK_OBJECT_FIELD_COUNT);
+    for (uint32_t i = 0; i < 6; ++i) {
+        uint32_t field = i < 3 ? NETWORK_FIELD_POSITION : NETWORK_FIELD_ROTATION;
+        if (fields & field) {
+            WriteCode(stream, codes[i], baseCodes ? baseCodes + i : nullptr, CodeQuantization(schema, i).bits);
+        }
+    }
+    if (fields & NETWORK_FIELD_OWNER) {
+        stream.WriteString(owner);
+    }
+}
+
+} // namespace
+
+// ObjectReplicator implementation
+ObjectReplicator::ObjectReplicator()
+    : m_networkManager(nullptr)
+    , m_replicationRate(20.0f)
+    , m_maxReplicationDistance(100.0f)
+    , m_interestCellSize(0.0f)
+    , m_defaultBandwidth(16384.0f)
+    , m_lastReplicationTime(0.0f)
+    , m_localTime(0.0)
+    , m_nextNetId(1)
+    , m_snapshotId(0)
+    , m_snapshots(SNAPSHOT_WINDOW)
+    , m_packetBuffer(MAX_SNAPSHOT_PAYLOAD)
+    , m_latestReceivedSnapshot(0)
+    , m_interpolationEnabled(false)
+    , m_lastUpdateTime(0.0)
+    , m_lastBytesSent(0)
+    , m_lastObjectsSent(0)
+    , m_lastCandidates(0) {
+    for (Snapshot& snapshot : m_snapshots) {
+        snapshot.id = 0;
+    }
+}
+
+void ObjectReplicator::Initialize(NetworkManager* networkManager) {
+    m_networkManager = networkManager;
+    if (m_networkManager) {
+        m_networkManager->SetReplicator(this);
+    }
+}
+
+void ObjectReplicator::StartReplicating(std::shared_ptr<NetworkObject> object) {
+    if (!object) {
+        return;
+    }
+    if (m_slotIndex.count(object->GetId())) {
+        std::cerr << "ObjectReplicator: Object " << object->GetId() << " is already replicated" << std::endl;
+        return;
+    }
+
+    if (object->GetNetId() == 0) {
+        object->SetNetId(m_nextNetId++);
+    } else {
+        m_nextNetId = std::max(m_nextNetId, object->GetNetId() + 1);
+    }
+
+    uint32_t slot;
+    if (!m_freeSlots.empty()) {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(m_objectSlots.size());
+        m_objectSlots.push_back(ObjectSlot());
+        for (auto& client : m_clients) {
+            client->ackedSnapshot.push_back(0);
+            client->lastSentSnapshot.push_back(0);
+        }
+    }
+    m_objectSlots[slot].object = object;
+    m_objectSlots[slot].relevance = 1.0f;
+    m_objectSlots[slot].lastChanged = m_snapshotId + 1;
+    m_slotIndex[object->GetId()] = slot;
+}
+
+void ObjectReplicator::StopReplicating(const std::string& objectId) {
+    auto it = m_slotIndex.find(objectId);
+    if (it == m_slotIndex.end()) {
+        return;
+    }
+    uint32_t slot = it->second;
+    uint32_t netId = m_objectSlots[slot].object->GetNetId();
+
+    // Удаление доставляется только клиентам, которым объект отправлялся
+    for (auto& client : m_clients) {
+        if (client->lastSentSnapshot[slot] != 0) {
+            client->removals.push_back(PendingRemoval{netId, 0});
+        }
+        client->ackedSnapshot[slot] = 0;
+        client->lastSentSnapshot[slot] = 0;
+    }
+
+    m_objectSlots[slot].object.reset();
+    m_freeSlots.push_back(slot);
+    m_slotIndex.erase(it);
+}
+
+void ObjectReplicator::SetObjectRelevance(const std::string& objectId, float relevance) {
+    auto it = m_slotIndex.find(objectId);
+    if (it != m_slotIndex.end()) {
+        m_objectSlots[it->second].relevance = std::max(relevance, 0.0f);
+    }
+}
+
+void ObjectReplicator::AddClient(const std::string& clientId) {
+    if (FindClient(clientId)) {
+        return;
+    }
+    std::unique_ptr<ReplicationClient> client(new ReplicationClient());
+    client->id = clientId;
+    client->viewpoint = glm::vec3(0.0f);
+    client->bandwidth = 0.0f;
+    client->fromPlayers = false;
+    client->ackedSnapshot.assign(m_objectSlots.size(), 0);
+    client->lastSentSnapshot.assign(m_objectSlots.size(), 0);
+    client->sent.resize(SNAPSHOT_WINDOW);
+    for (SentRecord& record : client->sent) {
+        record.snapshotId = 0;
+        record.acked = false;
+    }
+    m_clients.push_back(std::move(client));
+}
+
+void ObjectReplicator::RemoveClient(const std::string& clientId) {
+    m_clients.erase(
+        std::remove_if(m_clients.begin(), m_clients.end(),
+            [&clientId](const std::unique_ptr<ReplicationClient>& client) {
+                return client->id == clientId;
+            }),
+        m_clients.end()
+    );
+}
+
+void ObjectReplicator::SetClientViewpoint(const std::string& clientId, const glm::vec3& position) {
+    if (ReplicationClient* client = FindClient(clientId)) {
+        client->viewpoint = position;
+    }
+}
+
+void ObjectReplicator::SetClientBandwidth(const std::string& clientId, float bytesPerSecond) {
+    if (ReplicationClient* client = FindClient(clientId)) {
+        client->bandwidth = bytesPerSecond;
+    }
+}
+
+void ObjectReplicator::AcknowledgeSnapshot(const std::string& clientId, uint32_t snapshotId) {
+    ReplicationClient* client = FindClient(clientId);
+    if (!client || snapshotId == 0) {
+        return;
+    }
+    SentRecord& record = client->sent[snapshotId % SNAPSHOT_WINDOW];
+    if (record.snapshotId != snapshotId || record.acked) {
+        return;
+    }
+    record.acked = true;
+
+    for (uint32_t slot : record.slots) {
+        if (client->ackedSnapshot[slot] < snapshotId) {
+            client->ackedSnapshot[slot] = snapshotId;
+        }
+    }
+
+    // Удаления идут в каждом пакете с первой отправки, поэтому
+    // подтвержден любой пакет не раньше первой отправки
+    size_t acked = 0;
+    while (acked < client->removals.size() && client->removals[acked].firstSent != 0 &&
+           client->removals[acked].firstSent <= snapshotId) {
+        ++acked;
+    }
+    client->removals.erase(client->removals.begin(), client->removals.begin() + acked);
+}
+
+ObjectReplicator::ReplicationClient* ObjectReplicator::FindClient(const std::string& clientId) {
+    for (auto& client : m_clients) {
+        if (client->id == clientId) {
+            return client.get();
+        }
+    }
+    return nullptr;
+}
+
+void ObjectReplicator::SyncClientsWithPlayers() {
+    const std::vector<PlayerInfo>& players = m_networkManager->GetPlayers();
+    for (const PlayerInfo& player : players) {
+        if (!player.connected) {
+            continue;
+        }
+        ReplicationClient* client = FindClient(player.id);
+        if (!client) {
+            AddClient(player.id);
+            client = m_clients.back().get();
+            client->fromPlayers = true;
+        }
+        client->viewpoint = player.position;
+    }
+
+    m_clients.erase(
+        std::remove_if(m_clients.begin(), m_clients.end(),
+            [&players](const std::unique_ptr<ReplicationClient>& client) {
+                if (!client->fromPlayers) {
+                    return false;
+                }
+                for (const PlayerInfo& player : players) {
+                    if (player.connected && player.id == client->id) {
+                        return false;
+                    }
+                }
+                return true;
+            }),
+        m_clients.end()
+    );
+}
+
+void ObjectReplicator::UpdateReplication(float deltaTime) {
+    m_localTime += deltaTime;
+    if (m_interpolationEnabled && !m_receivedObjects.empty()) {
+        ApplyInterpolation();
+    }
+
+    m_lastReplicationTime += deltaTime;
+    float interval = m_replicationRate > 0.0f ? 1.0f / m_replicationRate : 0.0f;
+    if (m_lastReplicationTime < interval) {
+        return;
+    }
+    m_lastReplicationTime = interval > 0.0f ? std::fmod(m_lastReplicationTime, interval) : 0.0f;
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    if (m_networkManager && m_networkManager->IsServer()) {
+        SyncClientsWithPlayers();
+    }
+
+    CaptureSnapshot();
+    BuildInterestGrid();
+
+    m_lastBytesSent = 0;
+    m_lastObjectsSent = 0;
+    m_lastCandidates = 0;
+    for (auto& client : m_clients) {
+        CollectCandidates(*client);
+        WriteClientPacket(*client);
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    m_lastUpdateTime = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+}
+
+void ObjectReplicator::CaptureSnapshot() {
+    ++m_snapshotId;
+    Snapshot& snapshot = m_snapshots[m_snapshotId % SNAPSHOT_WINDOW];
+    const Snapshot& previous = m_snapshots[(m_snapshotId - 1) % SNAPSHOT_WINDOW];
+    const bool hasPrevious = previous.id == m_snapshotId - 1;
+
+    snapshot.id = m_snapshotId;
+    snapshot.states.resize(m_objectSlots.size());
+    for (size_t slot = 0; slot < m_objectSlots.size(); ++slot) {
+        ObjectSlot& objectSlot = m_objectSlots[slot];
+        ReplicatedState& state = snapshot.states[slot];
+        if (!objectSlot.object) {
+            state.netId = 0;
+            continue;
+        }
+
+        const NetworkObject& object = *objectSlot.object;
+        const glm::vec3& position = object.GetPosition();
+        const glm::vec3& rotation = object.GetRotation();
+        state.netId = object.GetNetId();
+        state.ownerHash = HashOwner(object.GetOwnerId());
+        for (int i = 0; i < 3; ++i) {
+            state.codes[i] = m_schema.position.Quantize(position[i]);
+            state.codes[3 + i] = m_schema.rotation.Quantize(rotation[i]);
+        }
+
+        if (!hasPrevious || slot >= previous.states.size() ||
+            std::memcmp(&previous.states[slot], &state, sizeof(state)) != 0) {
+            objectSlot.lastChanged = m_snapshotId;
+        }
+    }
+}
+
+void ObjectReplicator::BuildInterestGrid() {
+    const Snapshot& snapshot = m_snapshots[m_snapshotId % SNAPSHOT_WINDOW];
+    const size_t slotCount = m_objectSlots.size();
+    m_grid.positions.resize(slotCount);
+    m_grid.cells.resize(slotCount);
+
+    // Позиции по квантованным кодам: в границах схемы и без NaN
+    glm::vec3 minBound(0.0f);
+    glm::vec3 maxBound(0.0f);
+    size_t liveCount = 0;
+    for (size_t slot = 0; slot < slotCount; ++slot) {
+        const ReplicatedState& state = snapshot.states[slot];
+        if (state.netId == 0) {
+            continue;
+        }
+        glm::vec3 position(m_schema.position.Dequantize(state.codes[0]),
+                           m_schema.position.Dequantize(state.codes[1]),
+                           m_schema.position.Dequantize(state.codes[2]));
+        m_grid.positions[slot] = position;
+        minBound = liveCount == 0 ? position : glm::min(minBound, position);
+        maxBound = liveCount == 0 ? position : glm::max(maxBound, position);
+        ++liveCount;
+    }
+
+    float cellSize = m_interestCellSize > 0.0f ? m_interestCellSize : std::max(m_maxReplicationDistance * 0.5f, 1.0f);
+    const glm::vec3 extent = maxBound - minBound;
+    size_t cellCount = 0;
+    for (;;) {
+        cellCount = 1;
+        for (int axis = 0; axis < 3; ++axis) {
+            m_grid.size[axis] = static_cast<int>(extent[axis] / cellSize) + 1;
+            cellCount *= static_cast<size_t>(m_grid.size[axis]);
+        }
+        // Разреженный мир не должен раздувать сетку
+        if (cellCount <= liveCount * 4 + 64) {
+            break;
+        }
+        cellSize *= 2.0f;
+    }
+    m_grid.origin = minBound;
+    m_grid.inverseCellSize = 1.0f / cellSize;
+
+    m_grid.offsets.assign(cellCount + 1, 0);
+    for (size_t slot = 0; slot < slotCount; ++slot) {
+        if (snapshot.states[slot].netId == 0) {
+            m_grid.cells[slot] = UINT32_MAX;
+            continue;
+        }
+        glm::vec3 local = (m_grid.positions[slot] - m_grid.origin) * m_grid.inverseCellSize;
+        int x = std::min(static_cast<int>(local.x), m_grid.size[0] - 1);
+        int y = std::min(static_cast<int>(local.y), m_grid.size[1] - 1);
+        int z = std::min(static_cast<int>(local.z), m_grid.size[2] - 1);
+        uint32_t cell = static_cast<uint32_t>((z * m_grid.size[1] + y) * m_grid.size[0] + x);
+        m_grid.cells[slot] = cell;
+        ++m_grid.offsets[cell + 1];
+    }
+    for (size_t i = 0; i < cellCount; ++i) {
+        m_grid.offsets[i + 1] += m_grid.offsets[i];
+    }
+    // Раскладка с offsets в роли курсоров, затем восстановление сдвигом
+    m_grid.slots.resize(liveCount);
+    for (size_t slot = 0; slot < slotCount; ++slot) {
+        uint32_t cell = m_grid.cells[slot];
+        if (cell != UINT32_MAX) {
+            m_grid.slots[m_grid.offsets[cell]++] = static_cast<uint32_t>(slot);
+        }
+    }
+    for (size_t i = cellCount; i > 0; --i) {
+        m_grid.offsets[i] = m_grid.offsets[i - 1];
+    }
+    m_grid.offsets[0] = 0;
+}
+
+const ObjectReplicator::ReplicatedState* ObjectReplicator::GetBaseline(const ReplicationClient& client, uint32_t slot,
+                                                                       uint32_t& baselineId) const {
+    const uint32_t acked = client.ackedSnapshot[slot];
+    // История клиента хранит SNAPSHOT_WINDOW последних отправок объекта
+    if (acked == 0 || client.lastSentSnapshot[slot] - acked >= SNAPSHOT_WINDOW) {
+        return nullptr;
+    }
+
+    const ReplicatedState& current = m_snapshots[m_snapshotId % SNAPSHOT_WINDOW].states[slot];
+    baselineId = acked;
+    if (m_objectSlots[slot].lastChanged <= acked) {
+        // Не менялся с подтвержденного снимка: база - текущее состояние
+        return &current;
+    }
+    if (m_snapshotId - acked >= SNAPSHOT_WINDOW) {
+        return nullptr;
+    }
+    const Snapshot& snapshot = m_snapshots[acked % SNAPSHOT_WINDOW];
+    if (snapshot.id != acked || slot >= snapshot.states.size() || snapshot.states[slot].netId != current.netId) {
+        return nullptr;
+    }
+    return &snapshot.states[slot];
+}
+
+void ObjectReplicator::CollectCandidates(ReplicationClient& client) {
+    m_candidates.clear();
+    const size_t liveCount = m_grid.slots.size();
+    if (liveCount == 0 || m_maxReplicationDistance <= 0.0f) {
+        return;
+    }
+
+    const Snapshot& snapshot = m_snapshots[m_snapshotId % SNAPSHOT_WINDOW];
+    const float radius = m_maxReplicationDistance;
+    const float radiusSquared = radius * radius;
+    const glm::vec3 viewpoint = client.viewpoint;
+
+    int low[3];
+    int high[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        float from = (viewpoint[axis] - radius - m_grid.origin[axis]) * m_grid.inverseCellSize;
+        float to = (viewpoint[axis] + radius - m_grid.origin[axis]) * m_grid.inverseCellSize;
+        if (to < 0.0f || from >= static_cast<float>(m_grid.size[axis])) {
+            return;
+        }
+        low[axis] = from <= 0.0f ? 0 : static_cast<int>(from);
+        high[axis] = std::min(static_cast<int>(to), m_grid.size[axis] - 1);
+    }
+
+    for (int z = low[2]; z <= high[2]; ++z) {
+        for (int y = low[1]; y <= high[1]; ++y) {
+            const uint32_t row = static_cast<uint32_t>((z * m_grid.size[1] + y) * m_grid.size[0]);
+            const uint32_t begin = m_grid.offsets[row + low[0]];
+            const uint32_t end = m_grid.offsets[row + high[0] + 1];
+            for (uint32_t i = begin; i < end; ++i) {
+                const uint32_t slot = m_grid.slots[i];
+                const glm::vec3 offset = m_grid.positions[slot] - viewpoint;
+                const float distanceSquared = glm::dot(offset, offset);
+                if (distanceSquared > radiusSquared) {
+                    continue;
+                }
+
+                uint32_t baselineId = 0;
+                const ReplicatedState* base = GetBaseline(client, slot, baselineId);
+                const ReplicatedState& current = snapshot.states[slot];
+                if (base && std::memcmp(base, &current, sizeof(current)) == 0) {
+                    continue; // У клиента подтверждено текущее состояние
+                }
+
+                // Давность: сколько снимков объект не отправлялся этому клиенту
+                const uint32_t lastSent = client.lastSentSnapshot[slot];
+                const float staleness = lastSent == 0 ? static_cast<float>(SNAPSHOT_WINDOW)
+                    : static_cast<float>(std::min(m_snapshotId - lastSent, SNAPSHOT_WINDOW));
+                const float closeness = 1.0f - std::sqrt(distanceSquared) / radius;
+                Candidate candidate;
+                candidate.priority = m_objectSlots[slot].relevance * (1.0f + staleness) * (0.1f + closeness);
+                candidate.slot = slot;
+                candidate.baseline = base ? baselineId : 0;
+                candidate.base = base;
+                m_candidates.push_back(candidate);
+            }
+        }
+    }
+}
+
+void ObjectReplicator::WriteClientPacket(ReplicationClient& client) {
+    const Snapshot& snapshot = m_snapshots[m_snapshotId % SNAPSHOT_WINDOW];
+    const float bandwidth = client.bandwidth > 0.0f ? client.bandwidth : m_defaultBandwidth;
+    const float interval = m_replicationRate > 0.0f ? 1.0f / m_replicationRate : 1.0f;
+    const uint32_t budgetBits = static_cast<uint32_t>(
+        std::min(bandwidth * interval, static_cast<float>(MAX_SNAPSHOT_PAYLOAD))) * 8;
+    m_lastCandidates += static_cast<uint32_t>(m_candidates.size());
+
+    std::sort(m_candidates.begin(), m_candidates.end(),
+              [](const Candidate& a, const Candidate& b) { return a.priority > b.priority; });
+
+    BitWriter writer(m_packetBuffer.data(), MAX_SNAPSHOT_PAYLOAD);
+    writer.WriteBits(REPLICATION_SNAPSHOT, PACKET_KIND_BITS);
+    writer.WriteVarUint(m_snapshotId);
+    writer.WriteVarUint(static_cast<uint64_t>(m_localTime * 1000.0 + 0.5));
+
+    const uint32_t removalCount = static_cast<uint32_t>(
+        std::min<size_t>(client.removals.size(), MAX_REMOVALS_PER_PACKET));
+    writer.WriteVarUint(removalCount);
+    for (uint32_t i = 0; i < removalCount; ++i) {
+        writer.WriteVarUint(client.removals[i].netId);
+        if (client.removals[i].firstSent == 0) {
+            client.removals[i].firstSent = m_snapshotId;
+        }
+    }
+
+    SentRecord& record = client.sent[m_snapshotId % SNAPSHOT_WINDOW];
+    record.snapshotId = m_snapshotId;
+    record.acked = false;
+    record.slots.clear();
+
+    for (const Candidate& candidate : m_candidates) {
+        const ReplicatedState& state = snapshot.states[candidate.slot];
+        const NetworkObject& object = *m_objectSlots[candidate.slot].object;
+        const uint32_t* baseCodes = candidate.base ? candidate.base->codes : nullptr;
+        const bool ownerChanged = candidate.base && candidate.base->ownerHash != state.ownerHash;
+        const uint32_t distance = m_snapshotId - candidate.baseline;
+
+        BitCounter counter;
+        WriteObjectRecord(counter, m_schema, state.netId, state.codes, baseCodes, distance, ownerChanged,
+                          object.GetOwnerId());
+        // Бит продолжения этой записи и завершающий бит пакета
+        if (writer.GetBitsWritten() + counter.GetBitsWritten() + 2 > budgetBits) {
+            continue; // Меньшие записи могут еще поместиться
+        }
+
+        writer.WriteBits(1, 1);
+        WriteObjectRecord(writer, m_schema, state.netId, state.codes, baseCodes, distance, ownerChanged,
+                          object.GetOwnerId());
+        record.slots.push_back(candidate.slot);
+        client.lastSentSnapshot[candidate.slot] = m_snapshotId;
+    }
+    writer.WriteBits(0, 1);
+    writer.Flush();
+
+    if (record.slots.empty() && removalCount == 0) {
+        record.snapshotId = 0;
+        return;
+    }
+    Send(client.id, m_packetBuffer.data(), writer.GetBytesWritten());
+    m_lastBytesSent += writer.GetBytesWritten();
+    m_lastObjectsSent += static_cast<uint32_t>(record.slots.size());
+}
+
+void ObjectReplicator::HandleMessage(const NetworkMessage& message) {
+    HandlePayload(message.senderId, reinterpret_cast<const uint8_t*>(message.data.data()),
+                  static_cast<uint32_t>(message.data.size()));
+}
+
+bool ObjectReplicator::HandlePayload(const std::string& senderId, const uint8_t* data, uint32_t size) {
+    BitReader reader(data, size);
+    uint32_t kind = 0;
+    uint32_t snapshotId = 0;
+    if (!reader.ReadBits(PACKET_KIND_BITS, kind)) {
+        return false;
+    }
+
+    if (kind == REPLICATION_ACK) {
+        if (!reader.ReadVarUint(snapshotId)) {
+            return false;
+        }
+        AcknowledgeSnapshot(senderId, snapshotId);
+        return true;
+    }
+    if (kind != REPLICATION_SNAPSHOT || !ReadSnapshot(reader, snapshotId)) {
+        return false;
+    }
+
+    uint8_t ack[8];
+    BitWriter writer(ack, sizeof(ack));
+    writer.WriteBits(REPLICATION_ACK, PACKET_KIND_BITS);
+    writer.WriteVarUint(snapshotId);
+    writer.Flush();
+    Send(senderId, ack, writer.GetBytesWritten());
+    return true;
+}
+
+bool ObjectReplicator::ReadSnapshot(BitReader& reader, uint32_t& snapshotId) {
+    uint32_t removalCount = 0;
+    uint64_t serverTimeMs = 0;
+    if (!reader.ReadVarUint(snapshotId) || snapshotId == 0 ||
+        snapshotId + SNAPSHOT_WINDOW <= m_latestReceivedSnapshot || !reader.ReadVarUint(serverTimeMs)) {
+        return false;
+    }
+    const double serverTime = static_cast<double>(serverTimeMs) * 0.001;
+    if (!reader.ReadVarUint(removalCount) || removalCount > MAX_REMOVALS_PER_PACKET) {
+        return false;
+    }
+    for (uint32_t i = 0; i < removalCount; ++i) {
+        uint32_t netId = 0;
+        if (!reader.ReadVarUint(netId)) {
+            return false;
+        }
+        RemoveReceivedObject(netId, snapshotId);
+    }
+
+    for (;;) {
+        uint32_t more = 0;
+        if (!reader.ReadBits(1, more)) {
+            return false;
+        }
+        if (more == 0) {
+            break;
+        }
+
+        uint32_t netId = 0;
+        uint32_t hasBase = 0;
+        uint32_t distance = 0;
+        uint32_t fields = 0;
+        if (!reader.ReadVarUint(netId) || !reader.ReadBits(1, hasBase) ||
+            (hasBase && (!reader.ReadVarUint(distance) || distance == 0 || distance >= snapshotId)) ||
+            !reader.ReadBits(NETWORK_OBJECT_FIELD_COUNT, fields)) {
+            return false;
+        }
+
+        auto it = m_receivedObjects.find(netId);
+        ReceivedObject* received = it != m_receivedObjects.end() ? it->second.get() : nullptr;
+        const uint32_t* baseCodes = nullptr;
+        if (hasBase) {
+            const uint32_t baselineId = snapshotId - distance;
+            const uint32_t index = baselineId % SNAPSHOT_WINDOW;
+            if (!received || received->historyIds[index] != baselineId) {
+                std::cerr << "ObjectReplicator: Missing baseline " << baselineId << " for object " << netId << std::endl;
+                return false;
+            }
+            baseCodes = received->historyCodes[index];
+        } else if (fields != NETWORK_FIELD_ALL) {
+            return false;
+        }
+
+        uint32_t codes[FIELD_CODES];
+        for (uint32_t i = 0; i < FIELD_CODES; ++i) {
+            uint32_t field = i < 3 ? NETWORK_FIELD_POSITION : NETWORK_FIELD_ROTATION;
+            if (!(fields & field)) {
+                codes[i] = baseCodes[i];
+            } else if (!ReadCode(reader, baseCodes ? baseCodes + i : nullptr, CodeQuantization(m_schema, i), codes[i])) {
+                return false;
+            }
+        }
+        if ((fields & NETWORK_FIELD_OWNER) && !reader.ReadString(m_ownerScratch, 255)) {
+            return false;
+        }
+
+        if (!received) {
+            // Запоздавший пакет с уже удаленным объектом
+            bool removed = false;
+            for (const RemovedObject& object : m_removedObjects) {
+                removed |= object.netId == netId && snapshotId <= object.snapshotId;
+            }
+            if (removed) {
+                continue;
+            }
+
+            std::shared_ptr<NetworkObject> object = m_objectFactory ? m_objectFactory(netId) : nullptr;
+            if (!object) {
+                object = std::make_shared<NetworkObject>();
+                object->SetId("net_" + std::to_string(netId));
+                if (m_networkManager) {
+                    m_networkManager->RegisterObject(object);
+                }
+            }
+            object->SetNetId(netId);
+            std::unique_ptr<ReceivedObject> entry(new ReceivedObject());
+            entry->object = object;
+            entry->latestSnapshot = 0;
+            std::fill(std::begin(entry->historyIds), std::end(entry->historyIds), 0u);
+            received = entry.get();
+            m_receivedObjects[netId] = std::move(entry);
+        }
+
+        const uint32_t index = snapshotId % SNAPSHOT_WINDOW;
+        received->historyIds[index] = snapshotId;
+        std::memcpy(received->historyCodes[index], codes, sizeof(codes));
+
+        const glm::vec3 position(m_schema.position.Dequantize(codes[0]),
+                                 m_schema.position.Dequantize(codes[1]),
+                                 m_schema.position.Dequantize(codes[2]));
+        const glm::vec3 rotation(m_schema.rotation.Dequantize(codes[3]),
+                                 m_schema.rotation.Dequantize(codes[4]),
+                                 m_schema.rotation.Dequantize(codes[5]));
+        received->timeline.AddSample(serverTime, position, rotation);
+
+        // Более старые снимки только пополняют историю
+        if (snapshotId >= received->latestSnapshot) {
+            received->latestSnapshot = snapshotId;
+            NetworkObject& object = *received->object;
+            if (fields & NETWORK_FIELD_OWNER) {
+                object.SetOwnerId(m_ownerScratch);
+            }
+            const bool owned = IsLocallyOwned(object);
+            // Новый объект появляется сразу на месте, дальше - по шкале
+            if (!m_interpolationEnabled || owned || received->timeline.GetSampleCount() == 1) {
+                object.SetPosition(position);
+                object.SetRotation(rotation);
+            }
+            if (owned && m_authoritativeStateCallback) {
+                m_authoritativeStateCallback(object, serverTime);
+            }
+        }
+    }
+    if (reader.IsError()) {
+        return false;
+    }
+    m_clock.AddSnapshot(serverTime, m_localTime);
+
+    m_latestReceivedSnapshot = std::max(m_latestReceivedSnapshot, snapshotId);
+    m_removedObjects.erase(
+        std::remove_if(m_removedObjects.begin(), m_removedObjects.end(),
+            [this](const RemovedObject& object) {
+                return object.snapshotId + SNAPSHOT_WINDOW <= m_latestReceivedSnapshot;
+            }),
+        m_removedObjects.end()
+    );
+    return true;
+}
+
+bool ObjectReplicator::IsLocallyOwned(const NetworkObject& object) const {
+    return !m_localOwnerId.empty() && object.GetOwnerId() == m_localOwnerId;
+}
+
+void ObjectReplicator::ApplyInterpolation() {
+    if (!m_clock.IsSynchronized()) {
+        return;
+    }
+    const double renderTime = m_clock.GetRenderTime(m_localTime);
+    glm::vec3 position;
+    glm::vec3 rotation;
+    for (auto& entry : m_receivedObjects) {
+        ReceivedObject& received = *entry.second;
+        NetworkObject& object = *received.object;
+        if (IsLocallyOwned(object) || !received.timeline.Sample(renderTime, position, rotation)) {
+            continue;
+        }
+        object.SetPosition(position);
+        object.SetRotation(rotation);
+    }
+}
+
+void ObjectReplicator::RemoveReceivedObject(uint32_t netId, uint32_t snapshotId) {
+    auto it = m_receivedObjects.find(netId);
+    if (it != m_receivedObjects.end()) {
+        if (m_networkManager) {
+            m_networkManager->UnregisterObject(it->second->object->GetId());
+        }
+        m_receivedObjects.erase(it);
+    }
+    for (RemovedObject& object : m_removedObjects) {
+        if (object.netId == netId) {
+            object.snapshotId = std::max(object.snapshotId, snapshotId);
+            return;
+        }
+    }
+    m_removedObjects.push_back(RemovedObject{netId, snapshotId});
+}
+
+std::shared_ptr<NetworkObject> ObjectReplicator::GetReplicatedObject(uint32_t netId) const {
+    auto it = m_receivedObjects.find(netId);
+    if (it != m_receivedObjects.end()) {
+        return it->second->object;
+    }
+    for (const ObjectSlot& slot : m_objectSlots) {
+        if (slot.object && slot.object->GetNetId() == netId) {
+            return slot.object;
+        }
+    }
+    return nullptr;
+}
+
+void ObjectReplicator::Send(const std::string& targetId, const uint8_t* data, uint32_t size) {
+    if (m_sendCallback) {
+        m_sendCallback(targetId, data, size);
+    } else if (m_networkManager) {
+        if (m_networkManager->IsServer()) {
+            m_networkManager->SendPayloadToPlayer(targetId, NetworkMessageType::ObjectUpdate, data, size);
+        } else {
+            m_networkManager->SendPayload(NetworkMessageType::ObjectUpdate, data, size);
+        }
+    }
+}
+
+} // namespace FastEngine
@@ -148,26 +148,23 @@ namespace FastEngine {
     }
     
     bool CollisionSystem::SATvsSAT(const Polygon& a, const Polygon& b) {
-        auto axes = GetAxes(a);
-        auto axesB = GetAxes(b);
-        axes.insert(axes.end(), axesB.begin(), axesB.end());
-        
-        for (const auto& axis : axes) {
-            auto projA = ProjectPolygon(a, axis);
-            auto projB = ProjectPolygon(b, axis);
-            
-            if (!Overlap(projA, projB)) {
-                return false;
-            }
-        }
-        
-        return true;
+        return SATvsSAT(a.vertices.data(), a.vertices.size(), b.vertices.data(), b.vertices.size());
     }
     
     CollisionInfo CollisionSystem::SATvsSATInfo(const Polygon& a, const Polygon& b) {
+        return SATvsSATInfo(a.vertices.data(), a.vertices.size(), b.vertices.data(), b.vertices.size());
+    }
+    
+    bool CollisionSystem::SATvsSAT(const glm::vec2* a, size_t countA, const glm::vec2* b, size_t countB) {
+        // Оси - нормали ребер обоих полигонов
+        return !SeparatedByEdges(a, countA, a, countA, b, countB) &&
+               !SeparatedByEdges(b, countB, a, countA, b, countB);
+    }
+    
+    CollisionInfo CollisionSystem::SATvsSATInfo(const glm::vec2* a, size_t countA, const glm::vec2* b, size_t countB) {
         CollisionInfo info;
         
-        if (!SATvsSAT(a, b)) {
+        if (!SATvsSAT(a, countA, b, countB)) {
             return info;
         }
         
@@ -175,9 +172,20 @@ namespace FastEngine {
         
         // Упрощенная реализация - в реальном проекте нужен более сложный алгоритм
         // для определения нормали и проникновения
+        glm::vec2 centerA(0.0f);
+        glm::vec2 centerB(0.0f);
+        for (size_t i = 0; i < countA; i++) {
+            centerA += a[i];
+        }
+        for (size_t i = 0; i < countB; i++) {
+            centerB += b[i];
+        }
+        if (countA > 0) centerA /= static_cast<float>(countA);
+        if (countB > 0) centerB /= static_cast<float>(countB);
+        
         info.normal = glm::vec2(1.0f, 0.0f);
         info.penetration = 0.1f;
-        info.contactPoint = (a.GetCenter() + b.GetCenter()) * 0.5f;
+        info.contactPoint = (centerA + centerB) * 0.5f;
         
         return info;
     }
@@ -223,27 +231,28 @@ namespace FastEngine {
         return result;
     }
     
-    std::vector<glm::vec2> CollisionSystem::GetAxes(const Polygon& polygon) {
-        std::vector<glm::vec2> axes;
-        
-        for (size_t i = 0; i < polygon.vertices.size(); i++) {
-            size_t j = (i + 1) % polygon.vertices.size();
-            glm::vec2 edge = polygon.vertices[j] - polygon.vertices[i];
-            glm::vec2 normal = glm::vec2(-edge.y, edge.x);
-            axes.push_back(glm::normalize(normal));
+    bool CollisionSystem::SeparatedByEdges(const glm::vec2* edges, size_t edgeCount,
+                                           const glm::vec2* a, size_t countA, const glm::vec2* b, size_t countB) {
+        for (size_t i = 0; i < edgeCount; i++) {
+            size_t j = (i + 1) % edgeCount;
+            glm::vec2 edge = edges[j] - edges[i];
+            glm::vec2 axis = glm::normalize(glm::vec2(-edge.y, edge.x));
+            
+            if (!Overlap(ProjectPoints(a, countA, axis), ProjectPoints(b, countB, axis))) {
+                return true;
+            }
         }
-        
-        return axes;
+        return false;
     }
     
-    glm::vec2 CollisionSystem::ProjectPolygon(const Polygon& polygon, const glm::vec2& axis) {
-        if (polygon.vertices.empty()) return glm::vec2(0.0f);
+    glm::vec2 CollisionSystem::ProjectPoints(const glm::vec2* points, size_t count, const glm::vec2& axis) {
+        if (count == 0) return glm::vec2(0.0f);
         
-        float min = glm::dot(polygon.vertices[0], axis);
+        float min = glm::dot(points[0], axis);
         float max = min;
         
-        for (const auto& vertex : polygon.vertices) {
-            float projection = glm::dot(vertex, axis);
+        for (size_t i = 1; i < count; i++) {
+            float projection = glm::dot(points[i], axis);
             min = std::min(min, projection);
             max = std::max(max, projection);
         }
@@ -0,0 +1,140 @@
+#include "FastEngine/Platform/FixedTickLoop.h"
+#include "FastEngine/Memory/LinearArena.h"
+#include <algorithm>
+#include <thread>
+
+namespace FastEngine {
+    // PreciseWaiter implementation
+    PreciseWaiter::PreciseWaiter(float spinThreshold)
+        : m_spinThreshold(std::max(spinThreshold, 0.0f))
+        , m_sleepOvershoot(0.0005) {
+    }
+
+    void PreciseWaiter::WaitUntil(Clock::time_point deadline) {
+        Clock::time_point now = Clock::now();
+        const double remaining = std::chrono::duration<double>(deadline - now).count();
+        const double sleepTime = remaining - m_spinThreshold - m_sleepOvershoot;
+        if (sleepTime > 0.0) {
+            std::this_thread::sleep_for(std::chrono::duration<double>(sleepTime));
+            const Clock::time_point woke = Clock::now();
+            const double overshoot = std::max(std::chrono::duration<double>(woke - now).count() - sleepTime, 0.0);
+            m_sleepOvershoot += (overshoot - m_sleepOvershoot) * (overshoot > m_sleepOvershoot ? 0.5 : 0.05);
+            now = woke;
+        }
+        while (now < deadline) {
+            std::this_thread::yield();
+            now = Clock::now();
+        }
+    }
+
+    // FixedTickLoop implementation
+    FixedTickLoop::FixedTickLoop(const FixedTickConfig& config)
+        : m_config(config)
+        , m_started(false)
+        , m_tick(0)
+        , m_waiter(config.spinThreshold)
+        , m_history(HISTORY_SIZE, 0.0f) {
+        if (m_config.tickRate <= 0.0f) {
+            m_config.tickRate = 60.0f;
+        }
+        m_deltaTime = 1.0f / m_config.tickRate;
+        m_period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_config.tickRate));
+        ResetStats();
+    }
+
+    void FixedTickLoop::Reset() {
+        m_nextTick = Clock::now();
+        m_started = true;
+    }
+
+    void FixedTickLoop::Step(const TickFunction& tick) {
+        if (!m_started) {
+            Reset();
+        }
+
+        // Опоздание считается только когда цикл действительно ждал
+        Clock::time_point start = Clock::now();
+        double wakeErrorMs = -1.0;
+        if (start < m_nextTick) {
+            m_waiter.WaitUntil(m_nextTick);
+            start = Clock::now();
+            wakeErrorMs = std::chrono::duration<double, std::milli>(start - m_nextTick).count();
+        }
+
+        // Граница кадра для арены потока, который крутит этот цикл
+        FrameArena::BeginFrame();
+        tick(m_deltaTime, m_tick);
+        ++m_tick;
+
+        const Clock::time_point end = Clock::now();
+        const double tickMs = std::chrono::duration<double, std::milli>(end - start).count();
+        m_nextTick += m_period;
+
+        bool overrun = false;
+        uint64_t dropped = 0;
+        if (end > m_nextTick) {
+            overrun = true;
+            const Clock::duration lag = end - m_nextTick;
+            if (lag > m_period * static_cast<int64_t>(m_config.maxCatchUpTicks)) {
+                dropped = static_cast<uint64_t>(lag / m_period);
+                m_nextTick = end;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        ++m_stats.ticks;
+        m_stats.overruns += overrun ? 1 : 0;
+        m_stats.droppedTicks += dropped;
+        m_stats.lastTickMs = tickMs;
+        m_stats.maxTickMs = std::max(m_stats.maxTickMs, tickMs);
+        m_totalTickMs += tickMs;
+        if (wakeErrorMs >= 0.0) {
+            m_totalWakeErrorMs += wakeErrorMs;
+            ++m_wakeSamples;
+            m_stats.maxWakeErrorMs = std::max(m_stats.maxWakeErrorMs, wakeErrorMs);
+        }
+        m_history[m_historyCount % HISTORY_SIZE] = static_cast<float>(tickMs);
+        ++m_historyCount;
+    }
+
+    void FixedTickLoop::Run(const TickFunction& tick, const std::atomic<bool>& running) {
+        Reset();
+        while (running.load(std::memory_order_acquire)) {
+            Step(tick);
+        }
+    }
+
+    TickStats FixedTickLoop::GetStats() const {
+        std::vector<float> recent;
+        TickStats stats;
+        {
+            std::lock_guard<std::mutex> lock(m_statsMutex);
+            stats = m_stats;
+            if (m_stats.ticks > 0) {
+                stats.averageTickMs = m_totalTickMs / static_cast<double>(m_stats.ticks);
+            }
+            if (m_wakeSamples > 0) {
+                stats.averageWakeErrorMs = m_totalWakeErrorMs / static_cast<double>(m_wakeSamples);
+            }
+            recent.assign(m_history.begin(), m_history.begin() + std::min(m_historyCount, HISTORY_SIZE));
+        }
+
+        stats.tickPeriodMs = 1000.0 / m_config.tickRate;
+        stats.load = stats.averageTickMs / stats.tickPeriodMs;
+        if (!recent.empty()) {
+            const size_t index = std::min(recent.size() - 1, recent.size() * 99 / 100);
+            std::nth_element(recent.begin(), recent.begin() + index, recent.end());
+            stats.p99TickMs = recent[index];
+        }
+        return stats;
+    }
+
+    void FixedTickLoop::ResetStats() {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        m_stats = TickStats();
+        m_totalTickMs = 0.0;
+        m_totalWakeErrorMs = 0.0;
+        m_wakeSamples = 0;
+        m_historyCount = 0;
+    }
+}
@@ -0,0 +1,409 @@
+#include "FastEngine/Profiling/MemoryTracker.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <new>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__GLIBC__) || defined(__APPLE__)
+#include <execinfo.h>
+#define FASTENGINE_MEMORY_BACKTRACE
+#endif
+
+namespace FastEngine {
+
+#if defined(FASTENGINE_TRACK_ALLOCATIONS)
+// Определена рядом с заменой operator new; ссылка отсюда гарантирует,
+// что замена попадет в программу из статической библиотеки
+bool MemoryTrackerHooksInstalled();
+#endif
+
+namespace {
+
+const size_t TAG_NAME_LENGTH = 32;
+const uint8_t FLAG_TRACKED = 1;
+
+/**
+ * Заголовок перед данными блока
+ */
+struct AllocationHeader {
+    uint64_t size;
+    uint32_t offset;  // От начала блока malloc до данных
+    uint16_t sample;  // Слот выборки + 1; 0 - без стека
+    uint8_t tag;
+    uint8_t flags;
+};
+
+static_assert(sizeof(AllocationHeader) == MemoryTracker::DEFAULT_ALIGNMENT, "Header must keep data aligned");
+
+/**
+ * Блок счетчиков; пишет один поток, читают снимки
+ */
+struct ThreadCounters {
+    std::atomic<int64_t> liveBytes[MemoryTracker::MAX_TAGS];
+    std::atomic<uint64_t> allocations[MemoryTracker::MAX_TAGS];
+    std::atomic<uint64_t> frees[MemoryTracker::MAX_TAGS];
+    std::atomic<uint64_t> bytesAllocated[MemoryTracker::MAX_TAGS];
+    ThreadCounters* next;     // Список всех блоков
+    ThreadCounters* nextFree; // Список блоков без потока
+};
+
+// Все глобальные объекты инициализируются константами: operator new
+// может быть вызван до динамической инициализации этого файла
+std::atomic<bool> s_enabled(false);
+std::atomic<uint32_t> s_sampleRate(0);
+
+std::mutex s_tagsMutex;
+char s_tagNames[MemoryTracker::MAX_TAGS][TAG_NAME_LENGTH];
+std::atomic<uint32_t> s_tagCount(1);
+
+std::mutex s_countersMutex;
+ThreadCounters* s_allCounters = nullptr;
+ThreadCounters* s_freeCounters = nullptr;
+// Потоки на этапе завершения пишут сюда атомарными сложениями
+ThreadCounters s_sharedCounters;
+
+std::mutex s_samplesMutex;
+AllocationSample s_samples[MemoryTracker::MAX_SAMPLES];
+uint32_t s_nextSample = 0;
+
+thread_local ThreadCounters* t_counters = nullptr;
+thread_local bool t_exited = false;
+thread_local MemoryTag t_tags[MemoryTracker::MAX_TAG_DEPTH];
+thread_local uint32_t t_tagDepth = 0;
+thread_local uint32_t t_sampleCountdown = 0;
+thread_local bool t_sampling = false;
+
+// Возвращает блок потока в список свободных при выходе потока
+struct CountersHolder {
+    ThreadCounters* counters = nullptr;
+
+    ~CountersHolder() {
+        if (counters) {
+            std::lock_guard<std::mutex> lock(s_countersMutex);
+            counters->nextFree = s_freeCounters;
+            s_freeCounters = counters;
+        }
+        t_counters = nullptr;
+        t_exited = true;
+    }
+};
+
+thread_local CountersHolder t_holder;
+
+// nullptr - общий блок
+ThreadCounters* GetCounters() {
+    ThreadCounters* counters = t_counters;
+    if (counters || t_exited) {
+        return counters;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(s_countersMutex);
+        if (s_freeCounters) {
+            counters = s_freeCounters;
+            s_freeCounters = counters->nextFree;
+        } else {
+            // calloc, а не new: вызов идет из operator new
+            void* memory = std::calloc(1, sizeof(ThreadCounters));
+            if (!memory) {
+                return nullptr;
+            }
+            counters = new (memory) ThreadCounters();
+            counters->next = s_allCounters;
+            s_allCounters = counters;
+        }
+    }
+    t_holder.counters = counters;
+    t_counters = counters;
+    return counters;
+}
+
+template<typename T>
+void Bump(std::atomic<T>& counter, T value, bool shared) {
+    if (shared) {
+        counter.fetch_add(value, std::memory_order_relaxed);
+    } else {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+}
+
+void CountAllocation(MemoryTag tag, size_t size) {
+    ThreadCounters* counters = GetCounters();
+    const bool shared = counters == nullptr;
+    ThreadCounters& target = shared ? s_sharedCounters : *counters;
+    Bump<int64_t>(target.liveBytes[tag], static_cast<int64_t>(size), shared);
+    Bump<uint64_t>(target.allocations[tag], 1, shared);
+    Bump<uint64_t>(target.bytesAllocated[tag], size, shared);
+}
+
+void CountFree(MemoryTag tag, size_t size) {
+    ThreadCounters* counters = GetCounters();
+    const bool shared = counters == nullptr;
+    ThreadCounters& target = shared ? s_sharedCounters : *counters;
+    Bump<int64_t>(target.liveBytes[tag], -static_cast<int64_t>(size), shared);
+    Bump<uint64_t>(target.frees[tag], 1, shared);
+}
+
+uint32_t CaptureStack(void** frames, uint32_t maxFrames) {
+#if defined(_WIN32)
+    return CaptureStackBackTrace(2, maxFrames, frames, nullptr);
+#elif defined(FASTENGINE_MEMORY_BACKTRACE)
+    int depth = backtrace(frames, static_cast<int>(maxFrames));
+    return depth > 0 ? static_cast<uint32_t>(depth) : 0;
+#else
+    (void)frames;
+    (void)maxFrames;
+    return 0;
+#endif
+}
+
+// Слот + 1; 0, если таблица выборки заполнена
+uint16_t TakeSample(const void* address, size_t size, MemoryTag tag) {
+    AllocationSample sample;
+    sample.address = address;
+    sample.size = size;
+    sample.tag = tag;
+    sample.depth = CaptureStack(sample.frames, AllocationSample::MAX_FRAMES);
+
+    std::lock_guard<std::mutex> lock(s_samplesMutex);
+    for (uint32_t i = 0; i < MemoryTracker::MAX_SAMPLES; ++i) {
+        uint32_t slot = (s_nextSample + i) % MemoryTracker::MAX_SAMPLES;
+        if (!s_samples[slot].address) {
+            s_samples[slot] = sample;
+            s_nextSample = slot + 1;
+            return static_cast<uint16_t>(slot + 1);
+        }
+    }
+    return 0;
+}
+
+void ReleaseSample(uint16_t sample) {
+    std::lock_guard<std::mutex> lock(s_samplesMutex);
+    s_samples[sample - 1].address = nullptr;
+}
+
+AllocationHeader* GetHeader(const void* pointer) {
+    return reinterpret_cast<AllocationHeader*>(
+        const_cast<unsigned char*>(static_cast<const unsigned char*>(pointer)) - sizeof(AllocationHeader));
+}
+
+} // namespace
+
+// MemoryTracker implementation
+void MemoryTracker::SetEnabled(bool enabled) {
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool MemoryTracker::IsEnabled() {
+    return s_enabled.load(std::memory_order_relaxed);
+}
+
+void MemoryTracker::SetSampleRate(uint32_t everyN) {
+    s_sampleRate.store(everyN, std::memory_order_relaxed);
+}
+
+uint32_t MemoryTracker::GetSampleRate() {
+    return s_sampleRate.load(std::memory_order_relaxed);
+}
+
+bool MemoryTracker::HasGlobalHooks() {
+#if defined(FASTENGINE_TRACK_ALLOCATIONS)
+    return MemoryTrackerHooksInstalled();
+#else
+    return false;
+#endif
+}
+
+MemoryTag MemoryTracker::RegisterTag(const char* name) {
+    std::lock_guard<std::mutex> lock(s_tagsMutex);
+    const uint32_t count = s_tagCount.load(std::memory_order_relaxed);
+    for (uint32_t tag = 1; tag < count; ++tag) {
+        if (std::strncmp(s_tagNames[tag], name, TAG_NAME_LENGTH - 1) == 0) {
+            return static_cast<MemoryTag>(tag);
+        }
+    }
+    if (count >= MAX_TAGS) {
+        std::cerr << "MemoryTracker: Tag table is full, '" << name << "' is counted as untagged" << std::endl;
+        return UNTAGGED;
+    }
+    std::strncpy(s_tagNames[count], name, TAG_NAME_LENGTH - 1);
+    s_tagCount.store(count + 1, std::memory_order_release);
+    return static_cast<MemoryTag>(count);
+}
+
+const char* MemoryTracker::GetTagName(MemoryTag tag) {
+    if (tag == UNTAGGED || tag >= s_tagCount.load(std::memory_order_acquire)) {
+        return "Untagged";
+    }
+    return s_tagNames[tag];
+}
+
+uint32_t MemoryTracker::GetTagCount() {
+    return s_tagCount.load(std::memory_order_acquire);
+}
+
+void MemoryTracker::PushTag(MemoryTag tag) {
+    if (t_tagDepth < MAX_TAG_DEPTH) {
+        t_tags[t_tagDepth] = tag;
+    }
+    t_tagDepth++;
+}
+
+void MemoryTracker::PopTag() {
+    if (t_tagDepth > 0) {
+        t_tagDepth--;
+    }
+}
+
+MemoryTag MemoryTracker::GetCurrentTag() {
+    if (t_tagDepth == 0) {
+        return UNTAGGED;
+    }
+    // Глубже MAX_TAG_DEPTH действует последний сохраненный тег
+    return t_tags[(t_tagDepth < MAX_TAG_DEPTH ? t_tagDepth : MAX_TAG_DEPTH) - 1];
+}
+
+void* MemoryTracker::Allocate(size_t size, size_t alignment) noexcept {
+    if (alignment < DEFAULT_ALIGNMENT) {
+        alignment = DEFAULT_ALIGNMENT;
+    }
+    // malloc уже выравнивает на max_align_t; иначе нужен запас на сдвиг
+    const size_t extra = sizeof(AllocationHeader) + (alignment > alignof(std::max_align_t) ? alignment : 0);
+    if (size > SIZE_MAX - extra) {
+        return nullptr;
+    }
+    unsigned char* raw = static_cast<unsigned char*>(std::malloc(size + extra));
+    if (!raw) {
+        return nullptr;
+    }
+
+    const uintptr_t start = reinterpret_cast<uintptr_t>(raw) + sizeof(AllocationHeader);
+    unsigned char* data = raw + ((start + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1)) - reinterpret_cast<uintptr_t>(raw);
+    AllocationHeader* header = GetHeader(data);
+    header->size = size;
+    header->offset = static_cast<uint32_t>(data - raw);
+    header->sample = 0;
+    header->tag = UNTAGGED;
+    header->flags = 0;
+
+    if (!s_enabled.load(std::memory_order_relaxed)) {
+        return data;
+    }
+    header->tag = GetCurrentTag();
+    header->flags = FLAG_TRACKED;
+    CountAllocation(header->tag, size);
+
+    const uint32_t rate = s_sampleRate.load(std::memory_order_relaxed);
+    if (rate > 0 && !t_sampling && ++t_sampleCountdown >= rate) {
+        // Снятие стека может выделять память - повторно не сэмплируем
+        t_sampleCountdown = 0;
+        t_sampling = true;
+        header->sample = TakeSample(data, size, header->tag);
+        t_sampling = false;
+    }
+    return data;
+}
+
+void MemoryTracker::Free(void* pointer) noexcept {
+    if (!pointer) {
+        return;
+    }
+    AllocationHeader* header = GetHeader(pointer);
+    // Учтенный блок вычитается, даже если учет уже выключен
+    if (header->flags & FLAG_TRACKED) {
+        CountFree(header->tag, static_cast<size_t>(header->size));
+    }
+    if (header->sample) {
+        ReleaseSample(header->sample);
+    }
+    std::free(static_cast<unsigned char*>(pointer) - header->offset);
+}
+
+size_t MemoryTracker::GetAllocationSize(const void* pointer) {
+    return pointer ? static_cast<size_t>(GetHeader(pointer)->size) : 0;
+}
+
+MemoryTag MemoryTracker::OnAllocate(size_t size) {
+    if (!s_enabled.load(std::memory_order_relaxed)) {
+        return NOT_TRACKED;
+    }
+    MemoryTag tag = GetCurrentTag();
+    CountAllocation(tag, size);
+    return tag;
+}
+
+void MemoryTracker::OnFree(size_t size, MemoryTag tag) {
+    if (tag == NOT_TRACKED || tag >= MAX_TAGS) {
+        return;
+    }
+    CountFree(tag, size);
+}
+
+MemoryTrackerSnapshot MemoryTracker::GetSnapshot() {
+    // Память снимка выделяется до блокировки: выделение внутри могло бы
+    // регистрировать блок счетчиков под тем же мьютексом
+    MemoryTrackerSnapshot snapshot;
+    const uint32_t tagCount = GetTagCount();
+    snapshot.tags.resize(tagCount);
+    for (uint32_t tag = 0; tag < tagCount; ++tag) {
+        snapshot.tags[tag].tag = static_cast<MemoryTag>(tag);
+    }
+
+    auto add = [&snapshot, tagCount](const ThreadCounters& counters) {
+        for (uint32_t tag = 0; tag < tagCount; ++tag) {
+            MemoryTagStats& stats = snapshot.tags[tag];
+            stats.liveBytes += counters.liveBytes[tag].load(std::memory_order_relaxed);
+            stats.allocations += counters.allocations[tag].load(std::memory_order_relaxed);
+            stats.frees += counters.frees[tag].load(std::memory_order_relaxed);
+            stats.bytesAllocated += counters.bytesAllocated[tag].load(std::memory_order_relaxed);
+        }
+    };
+    {
+        std::lock_guard<std::mutex> lock(s_countersMutex);
+        for (const ThreadCounters* counters = s_allCounters; counters; counters = counters->next) {
+            add(*counters);
+        }
+    }
+    add(s_sharedCounters);
+
+    for (const MemoryTagStats& stats : snapshot.tags) {
+        snapshot.liveBytes += stats.liveBytes;
+        snapshot.allocations += stats.allocations;
+        snapshot.frees += stats.frees;
+        snapshot.bytesAllocated += stats.bytesAllocated;
+    }
+    return snapshot;
+}
+
+std::vector<AllocationSample> MemoryTracker::GetLiveSamples() {
+    std::vector<AllocationSample> samples;
+    samples.reserve(MAX_SAMPLES);
+    std::lock_guard<std::mutex> lock(s_samplesMutex);
+    for (const AllocationSample& sample : s_samples) {
+        if (sample.address) {
+            samples.push_back(sample);
+        }
+    }
+    return samples;
+}
+
+std::string MemoryTracker::DescribeFrame(void* frame) {
+#if defined(FASTENGINE_MEMORY_BACKTRACE)
+    char** symbols = backtrace_symbols(&frame, 1);
+    if (symbols) {
+        std::string description(symbols[0]);
+        std::free(symbols);
+        return description;
+    }
+#endif
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%p", frame);
+    return buffer;
+}
+
+} // namespace FastEngine
@@ -0,0 +1,130 @@
+#include "FastEngine/Profiling/MemoryTracker.h"
+#include <new>
+
+// Замена глобальных operator new/delete; собирается только с опцией
+// FASTENGINE_TRACK_ALLOCATIONS. Все варианты delete ведут в
+// MemoryTracker::Free: размер и выравнивание хранятся в заголовке блока.
+
+namespace FastEngine {
+
+bool MemoryTrackerHooksInstalled() {
+    return true;
+}
+
+} // namespace FastEngine
+
+namespace {
+
+void* AllocateOrNull(std::size_t size, std::size_t alignment) noexcept {
+    for (;;) {
+        void* pointer = FastEngine::MemoryTracker::Allocate(size ? size : 1, alignment);
+        if (pointer) {
+            return pointer;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            return nullptr;
+        }
+        try {
+            handler();
+        } catch (...) {
+            return nullptr;
+        }
+    }
+}
+
+void* AllocateOrThrow(std::size_t size, std::size_t alignment) {
+    for (;;) {
+        void* pointer = FastEngine::MemoryTracker::Allocate(size ? size : 1, alignment);
+        if (pointer) {
+            return pointer;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    return AllocateOrThrow(size, FastEngine::MemoryTracker::DEFAULT_ALIGNMENT);
+}
+
+void* operator new[](std::size_t size) {
+    return AllocateOrThrow(size, FastEngine::MemoryTracker::DEFAULT_ALIGNMENT);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return AllocateOrNull(size, FastEngine::MemoryTracker::DEFAULT_ALIGNMENT);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return AllocateOrNull(size, FastEngine::MemoryTracker::DEFAULT_ALIGNMENT);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return AllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return AllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return AllocateOrNull(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return AllocateOrNull(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept {
+    FastEngine::MemoryTracker::Free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    FastEngine::MemoryTracker::Free(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    FastEngine::MemoryTracker::Free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    FastEngine::MemoryTracker::Free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    FastEngine::MemoryTracker::Free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    FastEngine::MemoryTracker::Free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+    FastEngine::MemoryTracker::Free(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+    FastEngine::MemoryTracker::Free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    FastEngine::MemoryTracker::Free(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    FastEngine::MemoryTracker::Free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+    FastEngine::MemoryTracker::Free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept {
+    FastEngine::MemoryTracker::Free(pointer);
+}
@@ -3,6 +3,7 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <iomanip>
 #include <algorithm>
 #include <numeric>
 #include <cmath>
@@ -11,108 +12,129 @@ namespace FastEngine {
 
 // CPUProfiler implementation
 CPUProfiler::CPUProfiler() 
-    : m_profiling(false)
+    : m_nextMetric(0)
+    , m_profiling(false)
     , m_maxSamples(10000)
-    , m_samplingRate(1.0f) {
+    , m_samplingRate(1.0f)
+    , m_listener(0) {
+}
+
+CPUProfiler::~CPUProfiler() {
+    if (m_profiling) {
+        StopProfiling();
+    }
 }
 
 void CPUProfiler::StartProfiling() {
-    m_profiling = true;
+    if (m_profiling.exchange(true)) return;
+    
     m_profilingStart = std::chrono::high_resolution_clock::now();
+    ScopeProfiler& profiler = ScopeProfiler::GetInstance();
+    profiler.Start();
+    m_listener = profiler.AddListener([this](const CompletedScope& scope) {
+        AddMetric(ProfileNames::Get(scope.name), scope.GetDurationMs());
+    });
     std::cout << "CPUProfiler: Started profiling" << std::endl;
 }
 
 void CPUProfiler::StopProfiling() {
-    m_profiling = false;
+    if (!m_profiling.exchange(false)) return;
+    
+    ScopeProfiler& profiler = ScopeProfiler::GetInstance();
+    profiler.Flush();
+    profiler.RemoveListener(m_listener);
+    profiler.Stop();
     auto endTime = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - m_profilingStart);
     std::cout << "CPUProfiler: Stopped profiling after " << duration.count() << "ms" << std::endl;
 }
 
 void CPUProfiler::Reset() {
-    std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(m_mutex));
-    m_samples.clear();
-    m_metrics.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_metrics.clear();
+        m_nextMetric = 0;
+    }
+    ScopeProfiler::GetInstance().ResetStats();
     std::cout << "CPUProfiler: Reset" << std::endl;
 }
 
 void CPUProfiler::BeginSample(const std::string& name) {
     if (!m_profiling) return;
-    
-    std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(m_mutex));
-    auto& sample = m_samples[name];
-    sample.name = name;
-    sample.startTime = std::chrono::high_resolution_clock::now();
-    sample.active = true;
+    ScopeProfiler::Begin(ProfileNames::Register(name));
 }
 
-void CPUProfiler::EndSample(const std::string& name) {
+void CPUProfiler::EndSample(const std::string&) {
     if (!m_profiling) return;
-    
-    std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(m_mutex));
-    auto it = m_samples.find(name);
-    if (it != m_samples.end() && it->second.active) {
-        it->second.endTime = std::chrono::high_resolution_clock::now();
-        it->second.duration = std::chrono::duration<double, std::milli>(
-            it->second.endTime - it->second.startTime).count();
-        it->second.active = false;
-        
-        AddMetric(name, it->second.duration);
-    }
+    ScopeProfiler::End();
+}
+
+void CPUProfiler::BeginSample(ProfileNameId name) {
+    if (!m_profiling) return;
+    ScopeProfiler::Begin(name);
+}
+
+void CPUProfiler::EndSample() {
+    if (!m_profiling) return;
+    ScopeProfiler::End();
 }
 
 PerformanceStats CPUProfiler::GetStats(const std::string& name) const {
-    std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(m_mutex));
     PerformanceStats stats;
-    
-    std::vector<double> values;
-    for (const auto& metric : m_metrics) {
-        if (metric.name == name) {
-            values.push_back(metric.value);
-        }
-    }
-    
-    if (values.empty()) {
+    ProfileNameId id = ProfileNames::Find(name);
+    if (id == 0) {
         return stats;
     }
     
-    std::sort(values.begin(), values.end());
-    
-    stats.min = values.front();
-    stats.max = values.back();
-    stats.average = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
-    stats.sampleCount = values.size();
-    
-    // Медиана
-    if (values.size() % 2 == 0) {
-        stats.median = (values[values.size() / 2 - 1] + values[values.size() / 2]) / 2.0;
-    } else {
-        stats.median = values[values.size() / 2];
-    }
-    
-    // 95-й и 99-й перцентили
-    if (values.size() > 0) {
-        size_t p95Index = static_cast<size_t>(values.size() * 0.95);
-        size_t p99Index = static_cast<size_t>(values.size() * 0.99);
-        stats.p95 = values[std::min(p95Index, values.size() - 1)];
-        stats.p99 = values[std::min(p99Index, values.size() - 1)];
+    // Статистика ведется агрегатором ScopeProfiler; мьютекс профилировщика
+    // здесь не берется - слушатель вызывается под мьютексом агрегатора
+    ScopeStats scope = ScopeProfiler::GetInstance().GetStats(id);
+    if (scope.calls == 0) {
+        return stats;
     }
-    
+    stats.min = scope.minMs;
+    stats.max = scope.maxMs;
+    stats.average = scope.GetAverageMs();
+    stats.sampleCount = static_cast<size_t>(scope.calls);
+    stats.totalTime = std::chrono::milliseconds(static_cast<int64_t>(scope.totalMs));
+    ScopeProfiler::GetInstance().GetSketch(id, stats.sketch);
+    stats.RefreshPercentiles();
     return stats;
 }
 
 std::vector<PerformanceMetric> CPUProfiler::GetMetrics() const {
     std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(m_mutex));
-    return m_metrics;
+    // В хронологическом порядке
+    std::vector<PerformanceMetric> metrics;
+    metrics.reserve(m_metrics.size());
+    metrics.insert(metrics.end(), m_metrics.begin() + m_nextMetric, m_metrics.end());
+    metrics.insert(metrics.end(), m_metrics.begin(), m_metrics.begin() + m_nextMetric);
+    return metrics;
+}
+
+void CPUProfiler::SetMaxSamples(size_t maxSamples) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::rotate(m_metrics.begin(), m_metrics.begin() + m_nextMetric, m_metrics.end());
+    m_nextMetric = 0;
+    m_maxSamples = std::max<size_t>(maxSamples, 1);
+    if (m_metrics.size() > m_maxSamples) {
+        m_metrics.erase(m_metrics.begin(), m_metrics.end() - m_maxSamples);
+    }
 }
 
 void CPUProfiler::AddMetric(const std::string& name, double duration) {
-    if (m_metrics.size() >= m_maxSamples) {
-        m_metrics.erase(m_metrics.begin());
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_metrics.size() < m_maxSamples) {
+        m_metrics.emplace_back(name, ProfilerType::CPU, duration, "ms");
+        return;
     }
     
-    PerformanceMetric metric(name, ProfilerType::CPU, duration, "ms");
-    m_metrics.push_back(metric);
+    // Кольцо заполнено: перезапись самой старой метрики за O(1)
+    PerformanceMetric& metric = m_metrics[m_nextMetric];
+    metric.name = name;
+    metric.value = duration;
+    metric.timestamp = std::chrono::high_resolution_clock::now();
+    m_nextMetric = (m_nextMetric + 1) % m_metrics.size();
 }
 
 // GPUProfiler implementation
@@ -139,6 +161,7 @@ void GPUProfiler::Reset() {
     std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(m_mutex));
     m_queries.clear();
     m_metrics.clear();
+    m_stats.clear();
     m_drawCalls = 0;
     m_triangles = 0;
     m_vertices = 0;
@@ -176,40 +199,8 @@ void GPUProfiler::EndQuery(const std::string& name) {
 
 PerformanceStats GPUProfiler::GetStats(const std::string& name) const {
     std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(m_mutex));
-    PerformanceStats stats;
-    
-    std::vector<double> values;
-    for (const auto& metric : m_metrics) {
-        if (metric.name == name) {
-            values.push_back(metric.value);
-        }
-    }
-    
-    if (values.empty()) {
-        return stats;
-    }
-    
-    std::sort(values.begin(), values.end());
-    
-    stats.min = values.front();
-    stats.max = values.back();
-    stats.average = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
-    stats.sampleCount = values.size();
-    
-    if (values.size() % 2 == 0) {
-        stats.median = (values[values.size() / 2 - 1] + values[values.size() / 2]) / 2.0;
-    } else {
-        stats.median = values[values.size() / 2];
-    }
-    
-    if (values.size() > 0) {
-        size_t p95Index = static_cast<size_t>(values.size() * 0.95);
-        size_t p99Index = static_cast<size_t>(values.size() * 0.99);
-        stats.p95 = values[std::min(p95Index, values.size() - 1)];
-        stats.p99 = values[std::min(p99Index, values.size() - 1)];
-    }
-    
-    return stats;
+    auto it = m_stats.find(name);
+    return it != m_stats.end() ? it->second : PerformanceStats();
 }
 
 std::vector<PerformanceMetric> GPUProfiler::GetMetrics() const {
@@ -222,6 +213,11 @@ void GPUProfiler::RecordDrawCalls(int count) {
     m_drawCalls += count;
 }
 
+int GPUProfiler::GetDrawCalls() const {
+    std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(m_mutex));
+    return m_drawCalls;
+}
+
 void GPUProfiler::RecordTriangles(int count) {
     std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(m_mutex));
     m_triangles += count;
@@ -245,6 +241,7 @@ void GPUProfiler::RecordBufferMemory(size_t bytes) {
 void GPUProfiler::AddMetric(const std::string& name, double duration) {
     PerformanceMetric metric(name, ProfilerType::GPU, duration, "ms");
     m_metrics.push_back(metric);
+    m_stats[name].Update(duration);
 }
 
 unsigned int GPUProfiler::CreateQuery() {
@@ -261,7 +258,12 @@ void GPUProfiler::DeleteQuery(unsigned int queryId) {
 MemoryProfiler::MemoryProfiler() 
     : m_profiling(false)
     , m_totalMemory(0)
-    , m_peakMemory(0) {
+    , m_peakMemory(0)
+    , m_trackedMemory(0)
+    , m_trackedPeak(0)
+    , m_lastAllocationCount(0)
+    , m_allocationsPerFrame(0)
+    , m_trackedCaptured(false) {
 }
 
 void MemoryProfiler::StartProfiling() {
@@ -280,6 +282,11 @@ void MemoryProfiler::Reset() {
     m_metrics.clear();
     m_totalMemory = 0;
     m_peakMemory = 0;
+    m_trackedMemory = 0;
+    m_trackedPeak = 0;
+    m_allocationsPerFrame = 0;
+    m_trackedCaptured = false;
+    m_allocationStats = PerformanceStats();
     std::cout << "MemoryProfiler: Reset" << std::endl;
 }
 
@@ -325,6 +332,37 @@ void MemoryProfiler::RecordMemoryUsage(const std::string& category, size_t curre
     AddMetric(category + "_peak", static_cast<double>(peak), "bytes");
 }
 
+void MemoryProfiler::CaptureTrackedAllocations() {
+    if (!m_profiling) return;
+    
+    // Снимок собирается до блокировки: он сам выделяет память
+    MemoryTrackerSnapshot snapshot = MemoryTracker::GetSnapshot();
+    
+    std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(m_mutex));
+    for (const auto& tagStats : snapshot.tags) {
+        if (tagStats.allocations == 0) continue;
+        
+        // Категория с именем тега; пик - по захватам
+        auto& cat = m_categories[MemoryTracker::GetTagName(tagStats.tag)];
+        cat.current = static_cast<size_t>(std::max<int64_t>(tagStats.liveBytes, 0));
+        cat.peak = std::max(cat.peak, cat.current);
+        cat.totalAllocated = static_cast<size_t>(tagStats.bytesAllocated);
+        cat.totalDeallocated = static_cast<size_t>(tagStats.bytesAllocated - cat.current);
+        cat.allocationCount = static_cast<size_t>(tagStats.allocations);
+        cat.deallocationCount = static_cast<size_t>(tagStats.frees);
+    }
+    
+    m_trackedMemory = snapshot.liveBytes;
+    m_trackedPeak = std::max(m_trackedPeak, m_trackedMemory);
+    // Первый захват только запоминает отсчет
+    m_allocationsPerFrame = m_trackedCaptured ? snapshot.allocations - m_lastAllocationCount : 0;
+    if (m_trackedCaptured) {
+        m_allocationStats.Update(static_cast<double>(m_allocationsPerFrame));
+    }
+    m_lastAllocationCount = snapshot.allocations;
+    m_trackedCaptured = true;
+}
+
 PerformanceStats MemoryProfiler::GetStats(const std::string& category) const {
     std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(m_mutex));
     PerformanceStats stats;
@@ -354,6 +392,26 @@ size_t MemoryProfiler::GetPeakMemoryUsage() const {
     return m_peakMemory;
 }
 
+int64_t MemoryProfiler::GetTrackedMemoryUsage() const {
+    std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(m_mutex));
+    return m_trackedMemory;
+}
+
+int64_t MemoryProfiler::GetTrackedPeakMemoryUsage() const {
+    std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(m_mutex));
+    return m_trackedPeak;
+}
+
+uint64_t MemoryProfiler::GetAllocationsPerFrame() const {
+    std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(m_mutex));
+    return m_allocationsPerFrame;
+}
+
+PerformanceStats MemoryProfiler::GetAllocationStats() const {
+    std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(m_mutex));
+    return m_allocationStats;
+}
+
 void MemoryProfiler::DetectMemoryLeaks() {
     std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(m_mutex));
     
@@ -384,6 +442,48 @@ std::vector<std::string> MemoryProfiler::GetMemoryLeaks() const {
     return leaks;
 }
 
+std::vector<std::string> MemoryProfiler::GetAllocationSites(size_t maxSites) const {
+    struct Site {
+        const AllocationSample* sample;
+        size_t bytes;
+        size_t count;
+    };
+    
+    std::vector<AllocationSample> samples = MemoryTracker::GetLiveSamples();
+    std::map<std::vector<void*>, Site> sites;
+    for (const auto& sample : samples) {
+        std::vector<void*> stack(sample.frames, sample.frames + sample.depth);
+        auto it = sites.find(stack);
+        if (it == sites.end()) {
+            sites.emplace(std::move(stack), Site{&sample, sample.size, 1});
+        } else {
+            it->second.bytes += sample.size;
+            it->second.count++;
+        }
+    }
+    
+    std::vector<Site> sorted;
+    for (const auto& pair : sites) {
+        sorted.push_back(pair.second);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Site& a, const Site& b) {
+        return a.bytes > b.bytes;
+    });
+    
+    std::vector<std::string> result;
+    for (size_t i = 0; i < sorted.size() && i < maxSites; ++i) {
+        const AllocationSample& sample = *sorted[i].sample;
+        std::ostringstream line;
+        line << MemoryTracker::GetTagName(sample.tag) << ": " << sorted[i].bytes << " bytes in "
+             << sorted[i].count << " sampled allocations";
+        for (uint32_t frame = 0; frame < sample.depth; ++frame) {
+            line << "\n    " << MemoryTracker::DescribeFrame(sample.frames[frame]);
+        }
+        result.push_back(line.str());
+    }
+    return result;
+}
+
 void MemoryProfiler::AddMetric(const std::string& category, double value, const std::string& unit) {
     PerformanceMetric metric(category, ProfilerType::Memory, value, unit);
     m_metrics.push_back(metric);
@@ -484,7 +584,8 @@ PerformanceMonitor::PerformanceMonitor()
     : m_monitoringEnabled(false)
     , m_exportEnabled(false)
     , m_exportInterval(5.0f)
-    , m_exportTimer(0.0f) {
+    , m_exportTimer(0.0f)
+    , m_lastDrawCalls(0) {
 }
 
 bool PerformanceMonitor::Initialize() {
@@ -525,8 +626,25 @@ void PerformanceMonitor::Reset() {
 }
 
 void PerformanceMonitor::Update(float deltaTime) {
+    TraceCapture::GetInstance().Update();
     if (!m_monitoringEnabled) return;
     
+    if (MemoryTracker::IsEnabled()) {
+        m_memoryProfiler.CaptureTrackedAllocations();
+    }
+    
+    // Счетчики трассы; без захвата - одна проверка флага
+    if (TraceCapture::IsRecording()) {
+        int drawCalls = m_gpuProfiler.GetDrawCalls();
+        FASTENGINE_TRACE_COUNTER("Memory", m_memoryProfiler.GetTotalMemoryUsage());
+        if (MemoryTracker::IsEnabled()) {
+            FASTENGINE_TRACE_COUNTER("Tracked memory", m_memoryProfiler.GetTrackedMemoryUsage());
+            FASTENGINE_TRACE_COUNTER("Allocations", m_memoryProfiler.GetAllocationsPerFrame());
+        }
+        FASTENGINE_TRACE_COUNTER("Draw calls", drawCalls - m_lastDrawCalls);
+        m_lastDrawCalls = drawCalls;
+    }
+    
     // Проверяем алерты производительности
     CheckPerformanceAlerts();
     
@@ -675,6 +793,24 @@ void PerformanceMonitor::ExportToHTML(const std::string& filename) const {
     std::cout << "PerformanceMonitor: Exported data to HTML: " << filename << std::endl;
 }
 
+bool PerformanceMonitor::CaptureFrames(const std::string& filename, uint32_t frames) {
+    if (!TraceCapture::GetInstance().StartCapture(filename, frames)) {
+        return false;
+    }
+    m_lastDrawCalls = m_gpuProfiler.GetDrawCalls();
+    std::cout << "PerformanceMonitor: Capturing " << frames << " frames to " << filename << std::endl;
+    return true;
+}
+
+void PerformanceMonitor::SetSpikeCapture(double thresholdMs, uint32_t framesBefore, uint32_t framesAfter, const std::string& filePrefix) {
+    m_lastDrawCalls = m_gpuProfiler.GetDrawCalls();
+    TraceCapture::GetInstance().SetSpikeTrigger(thresholdMs, framesBefore, framesAfter, filePrefix);
+}
+
+void PerformanceMonitor::DisableSpikeCapture() {
+    TraceCapture::GetInstance().DisableSpikeTrigger();
+}
+
 void PerformanceMonitor::CheckPerformanceAlerts() {
     if (!m_performanceAlertCallback) return;
     
@@ -0,0 +1,111 @@
+#include "FastEngine/Profiling/QuantileSketch.h"
+#include <algorithm>
+#include <cmath>
+
+namespace FastEngine {
+
+void QuantileSketch::Merge(const QuantileSketch& other) {
+    if (other.m_count == 0) {
+        return;
+    }
+    if (m_count == 0) {
+        *this = other;
+        return;
+    }
+
+    // Сдвиг, при котором суммы корзин помещаются в 32 бита
+    int shift = 0;
+    for (int i = 0; i < BUCKETS; ++i) {
+        const uint64_t sum = static_cast<uint64_t>(m_buckets[i]) + other.m_buckets[i];
+        while ((sum >> shift) >= UINT32_MAX) {
+            ++shift;
+        }
+    }
+
+    const uint64_t round = (static_cast<uint64_t>(1) << shift) - 1;
+    m_weight = 0;
+    for (int group = 0; group < GROUPS; ++group) {
+        uint64_t total = 0;
+        for (int i = group << SUB_BITS, end = i + SUB_BUCKETS; i < end; ++i) {
+            const uint64_t sum = static_cast<uint64_t>(m_buckets[i]) + other.m_buckets[i];
+            m_buckets[i] = static_cast<uint32_t>((sum + round) >> shift);
+            total += m_buckets[i];
+        }
+        m_groups[group] = total;
+        m_weight += total;
+    }
+
+    m_count += other.m_count;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+}
+
+void QuantileSketch::Reset() {
+    m_buckets.fill(0);
+    m_groups.fill(0);
+    m_count = 0;
+    m_weight = 0;
+    m_min = 0.0;
+    m_max = 0.0;
+}
+
+double QuantileSketch::GetQuantile(double q) const {
+    if (m_count == 0) {
+        return 0.0;
+    }
+    if (q <= 0.0) {
+        return m_min;
+    }
+    if (q >= 1.0) {
+        return m_max;
+    }
+
+    // Ранг искомого значения: сначала порядок, затем корзина внутри него
+    const uint64_t target = std::min(std::max<uint64_t>(static_cast<uint64_t>(std::ceil(q * m_weight)), 1), m_weight);
+    uint64_t seen = 0;
+    int group = 0;
+    while (group < GROUPS && seen + m_groups[group] < target) {
+        seen += m_groups[group];
+        ++group;
+    }
+    if (group == GROUPS) {
+        return m_max;
+    }
+
+    int bucket = group << SUB_BITS;
+    for (int end = bucket + SUB_BUCKETS - 1; bucket < end; ++bucket) {
+        seen += m_buckets[bucket];
+        if (seen >= target) {
+            break;
+        }
+    }
+    // Крайние корзины собирают значения вне диапазона - для них точные min и max
+    if (bucket == 0) {
+        return m_min;
+    }
+    if (bucket == BUCKETS - 1) {
+        return m_max;
+    }
+    return std::min(std::max(GetBucketValue(bucket), m_min), m_max);
+}
+
+double QuantileSketch::GetBucketValue(int bucket) {
+    const int exponent = (bucket >> SUB_BITS) + MIN_EXPONENT;
+    const int sub = bucket & (SUB_BUCKETS - 1);
+    return std::ldexp(1.0 + (sub + 0.5) / SUB_BUCKETS, exponent);
+}
+
+void QuantileSketch::Halve() {
+    m_weight = 0;
+    for (int group = 0; group < GROUPS; ++group) {
+        uint64_t total = 0;
+        for (int i = group << SUB_BITS, end = i + SUB_BUCKETS; i < end; ++i) {
+            m_buckets[i] = static_cast<uint32_t>((static_cast<uint64_t>(m_buckets[i]) + 1) >> 1);
+            total += m_buckets[i];
+        }
+        m_groups[group] = total;
+        m_weight += total;
+    }
+}
+
+} // namespace FastEngine
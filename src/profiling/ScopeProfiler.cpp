@@ -0,0 +1,667 @@
+#include "FastEngine/Profiling/ScopeProfiler.h"
+#include "FastEngine/Platform/SpscRing.h"
+#include <algorithm>
+#include <iostream>
+#include <unordered_map>
+
+namespace FastEngine {
+
+/**
+ * Кольцевой буфер событий потока. Глубина меняется только потоком-
+ * владельцем; буфер переживает поток, пока агрегатор его не разберет
+ */
+struct ProfileThreadBuffer {
+    explicit ProfileThreadBuffer(size_t capacity)
+        : ring(capacity)
+        , depth(0)
+        , index(0)
+        , dropped(0)
+        , retired(false) {}
+
+    SpscRing<ProfileEvent> ring;
+    uint16_t depth;
+    uint32_t index;
+    std::atomic<uint64_t> dropped;
+    std::atomic<bool> retired;
+};
+
+namespace {
+
+const size_t FRAME_MARKER_CAPACITY = 256;
+const size_t MAX_PENDING_ROOTS = 65536;
+
+struct NameTable {
+    std::mutex mutex;
+    std::deque<std::string> names;
+    std::unordered_map<std::string, ProfileNameId> ids;
+
+    NameTable() {
+        names.emplace_back(); // Идентификатор 0 - без имени
+    }
+};
+
+NameTable& GetNameTable() {
+    static NameTable table;
+    return table;
+}
+
+// Буфер вызывающего потока; держатель помечает его завершенным при выходе потока
+thread_local ProfileThreadBuffer* t_buffer = nullptr;
+thread_local bool t_exited = false;
+
+struct ThreadBufferHolder {
+    std::shared_ptr<ProfileThreadBuffer> buffer;
+
+    ~ThreadBufferHolder() {
+        if (buffer) {
+            buffer->retired.store(true, std::memory_order_release);
+        }
+        t_buffer = nullptr;
+        t_exited = true;
+    }
+};
+
+thread_local ThreadBufferHolder t_holder;
+
+double CalibrateClock() {
+#if defined(FASTENGINE_PROFILE_TSC)
+    auto wallStart = std::chrono::steady_clock::now();
+    uint64_t ticksStart = ProfileClock::Now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    auto wallEnd = std::chrono::steady_clock::now();
+    uint64_t ticksEnd = ProfileClock::Now();
+    double ms = std::chrono::duration<double, std::milli>(wallEnd - wallStart).count();
+    return static_cast<double>(ticksEnd - ticksStart) / ms;
+#elif defined(__aarch64__)
+    uint64_t frequency;
+    asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+    return static_cast<double>(frequency) / 1000.0;
+#else
+    return 1.0e6;
+#endif
+}
+
+} // namespace
+
+// ProfileNames implementation
+ProfileNameId ProfileNames::Register(const std::string& name) {
+    NameTable& table = GetNameTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto it = table.ids.find(name);
+    if (it != table.ids.end()) {
+        return it->second;
+    }
+    ProfileNameId id = static_cast<ProfileNameId>(table.names.size());
+    table.names.push_back(name);
+    table.ids.emplace(name, id);
+    return id;
+}
+
+ProfileNameId ProfileNames::Find(const std::string& name) {
+    NameTable& table = GetNameTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto it = table.ids.find(name);
+    return it != table.ids.end() ? it->second : 0;
+}
+
+const std::string& ProfileNames::Get(ProfileNameId id) {
+    NameTable& table = GetNameTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return id < table.names.size() ? table.names[id] : table.names[0];
+}
+
+uint32_t ProfileNames::GetCount() {
+    NameTable& table = GetNameTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return static_cast<uint32_t>(table.names.size() - 1);
+}
+
+// ProfileClock implementation
+double ProfileClock::GetTicksPerMillisecond() {
+    static const double ticksPerMillisecond = CalibrateClock();
+    return ticksPerMillisecond;
+}
+
+// ScopeProfiler implementation
+struct ScopeProfiler::ThreadState {
+    struct OpenScope {
+        ProfileNameId name;
+        uint16_t depth;
+        uint64_t startTicks;
+    };
+
+    std::vector<OpenScope> stack;
+    std::vector<CompletedScope> records; // Завершенные области текущего корня, в порядке завершения
+};
+
+struct ScopeProfiler::NameStats {
+    uint64_t calls = 0;
+    double totalMs = 0.0;
+    double minMs = 0.0;
+    double maxMs = 0.0;
+    double lastMs = 0.0;
+    std::unique_ptr<QuantileSketch> sketch; // Создается при первом вызове
+};
+
+struct ScopeProfiler::PendingRoot {
+    uint32_t thread;
+    uint64_t endTicks;
+    std::vector<CompletedScope> scopes; // Корень - последний
+};
+
+std::atomic<bool> ScopeProfiler::s_enabled(false);
+
+ScopeProfiler& ScopeProfiler::GetInstance() {
+    static ScopeProfiler instance;
+    return instance;
+}
+
+ScopeProfiler::ScopeProfiler()
+    : m_threadCapacity(DEFAULT_THREAD_CAPACITY)
+    , m_retiredDropped(0)
+    , m_frameMarkers(new SpscRing<uint64_t>(FRAME_MARKER_CAPACITY))
+    , m_droppedMarkers(0)
+    , m_users(0)
+    , m_stopAggregator(false)
+    , m_intervalMs(2)
+    , m_nextFrameIndex(0)
+    , m_frameHistory(DEFAULT_FRAME_HISTORY)
+    , m_nextListenerId(1) {
+}
+
+ScopeProfiler::~ScopeProfiler() {
+    s_enabled.store(false);
+    if (m_aggregator.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            m_stopAggregator = true;
+        }
+        m_wakeCondition.notify_all();
+        m_aggregator.join();
+    }
+}
+
+bool ScopeProfiler::Begin(ProfileNameId name) {
+    if (!s_enabled.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    ProfileThreadBuffer* buffer = t_buffer;
+    if (!buffer) {
+        buffer = RegisterThread();
+        if (!buffer) {
+            return false;
+        }
+    }
+
+    ProfileEvent event;
+    event.ticks = ProfileClock::Now();
+    event.name = name;
+    event.depth = buffer->depth++;
+    event.kind = ProfileEvent::BEGIN;
+    event.reserved = 0;
+    if (!buffer->ring.Push(event)) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+void ScopeProfiler::End() {
+    ProfileThreadBuffer* buffer = t_buffer;
+    if (!buffer || buffer->depth == 0) {
+        return;
+    }
+
+    ProfileEvent event;
+    event.ticks = ProfileClock::Now();
+    event.name = 0;
+    event.depth = --buffer->depth;
+    event.kind = ProfileEvent::END;
+    event.reserved = 0;
+    if (!buffer->ring.Push(event)) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void ScopeProfiler::MarkFrame() {
+    if (!s_enabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+    ScopeProfiler& profiler = GetInstance();
+    if (!profiler.m_frameMarkers->Push(ProfileClock::Now())) {
+        profiler.m_droppedMarkers.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+ProfileThreadBuffer* ScopeProfiler::RegisterThread() {
+    if (t_exited) {
+        return nullptr;
+    }
+    ScopeProfiler& profiler = GetInstance();
+    auto buffer = std::make_shared<ProfileThreadBuffer>(profiler.m_threadCapacity.load(std::memory_order_relaxed));
+    {
+        std::lock_guard<std::mutex> lock(profiler.m_threadsMutex);
+        buffer->index = static_cast<uint32_t>(profiler.m_threadNames.size());
+        profiler.m_threadNames.push_back("Thread " + std::to_string(buffer->index));
+        profiler.m_threads.push_back(buffer);
+    }
+    t_holder.buffer = buffer;
+    t_buffer = buffer.get();
+    return t_buffer;
+}
+
+void ScopeProfiler::SetThreadName(const std::string& name) {
+    ProfileThreadBuffer* buffer = t_buffer ? t_buffer : RegisterThread();
+    if (!buffer) {
+        return;
+    }
+    ScopeProfiler& profiler = GetInstance();
+    std::lock_guard<std::mutex> lock(profiler.m_threadsMutex);
+    profiler.m_threadNames[buffer->index] = name;
+}
+
+uint32_t ScopeProfiler::GetCurrentThread() {
+    ProfileThreadBuffer* buffer = t_buffer ? t_buffer : RegisterThread();
+    return buffer ? buffer->index : NO_THREAD;
+}
+
+void ScopeProfiler::Start() {
+    std::lock_guard<std::mutex> lock(m_controlMutex);
+    if (m_users++ > 0) {
+        return;
+    }
+
+    // Калибровка часов до первой записи
+    ProfileClock::GetTicksPerMillisecond();
+    // Границы кадров прошлого запуска не продолжают новые кадры
+    {
+        std::lock_guard<std::mutex> stateLock(m_mutex);
+        m_frameStarts.clear();
+        m_pendingRoots.clear();
+    }
+    m_stopAggregator = false;
+    s_enabled.store(true);
+    m_aggregator = std::thread(&ScopeProfiler::AggregatorThreadFunction, this);
+}
+
+void ScopeProfiler::Stop() {
+    std::lock_guard<std::mutex> lock(m_controlMutex);
+    if (m_users == 0 || --m_users > 0) {
+        return;
+    }
+
+    s_enabled.store(false);
+    {
+        std::lock_guard<std::mutex> wakeLock(m_wakeMutex);
+        m_stopAggregator = true;
+    }
+    m_wakeCondition.notify_all();
+    if (m_aggregator.joinable()) {
+        m_aggregator.join();
+    }
+    Aggregate();
+}
+
+bool ScopeProfiler::IsRunning() const {
+    return s_enabled.load(std::memory_order_relaxed);
+}
+
+void ScopeProfiler::Flush() {
+    Aggregate();
+}
+
+void ScopeProfiler::ResetStats() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.clear();
+    m_pendingRoots.clear();
+    m_frameStarts.clear();
+    m_frames.clear();
+}
+
+void ScopeProfiler::SetFrameHistory(size_t frames) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_frameHistory = std::max<size_t>(frames, 1);
+    while (m_frames.size() > m_frameHistory) {
+        m_frames.pop_front();
+    }
+}
+
+void ScopeProfiler::AggregatorThreadFunction() {
+    SetThreadName("Profiler");
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    while (!m_stopAggregator) {
+        auto interval = std::chrono::milliseconds(m_intervalMs.load(std::memory_order_relaxed));
+        m_wakeCondition.wait_for(lock, interval, [this]() { return m_stopAggregator; });
+        if (m_stopAggregator) {
+            break;
+        }
+        lock.unlock();
+        Aggregate();
+        lock.lock();
+    }
+}
+
+void ScopeProfiler::Aggregate() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<std::shared_ptr<ProfileThreadBuffer>> threads;
+    {
+        std::lock_guard<std::mutex> threadsLock(m_threadsMutex);
+        threads = m_threads;
+    }
+
+    // Границы кадров забираются до событий: корень, завершившийся после
+    // первой границы, попадает в ожидающие. Кадры закрываются после разбора
+    uint64_t marker;
+    while (m_frameMarkers->Pop(marker)) {
+        m_frameStarts.push_back(marker);
+    }
+
+    std::vector<ProfileThreadBuffer*> retired;
+    for (const auto& buffer : threads) {
+        bool isRetired = buffer->retired.load(std::memory_order_acquire);
+        DrainThread(*buffer);
+        if (isRetired) {
+            retired.push_back(buffer.get());
+        }
+    }
+    if (!retired.empty()) {
+        std::lock_guard<std::mutex> threadsLock(m_threadsMutex);
+        for (ProfileThreadBuffer* buffer : retired) {
+            m_retiredDropped.fetch_add(buffer->dropped.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        m_threads.erase(std::remove_if(m_threads.begin(), m_threads.end(),
+            [&retired](const std::shared_ptr<ProfileThreadBuffer>& buffer) {
+                return std::find(retired.begin(), retired.end(), buffer.get()) != retired.end();
+            }), m_threads.end());
+    }
+
+    CloseFrames();
+}
+
+void ScopeProfiler::DrainThread(ProfileThreadBuffer& buffer) {
+    if (buffer.index >= m_states.size()) {
+        m_states.resize(buffer.index + 1);
+    }
+    ThreadState& state = m_states[buffer.index];
+
+    ProfileEvent event;
+    while (buffer.ring.Pop(event)) {
+        if (event.kind == ProfileEvent::BEGIN) {
+            // Потеряны END открытых областей - они отбрасываются
+            while (!state.stack.empty() && state.stack.back().depth >= event.depth) {
+                state.stack.pop_back();
+            }
+            if (state.stack.empty()) {
+                state.records.clear();
+            }
+            state.stack.push_back(ThreadState::OpenScope{event.name, event.depth, event.ticks});
+            continue;
+        }
+
+        while (!state.stack.empty() && state.stack.back().depth > event.depth) {
+            state.stack.pop_back();
+        }
+        // Потерян BEGIN этой области
+        if (state.stack.empty() || state.stack.back().depth != event.depth) {
+            continue;
+        }
+
+        const ThreadState::OpenScope open = state.stack.back();
+        state.stack.pop_back();
+        CompletedScope scope;
+        scope.name = open.name;
+        scope.thread = buffer.index;
+        scope.depth = open.depth;
+        scope.startTicks = open.startTicks;
+        scope.endTicks = event.ticks;
+        CompleteScope(scope);
+
+        // Деревья кадров строятся, только если кадры размечаются
+        if (m_frameStarts.empty()) {
+            state.records.clear();
+            continue;
+        }
+        state.records.push_back(scope);
+        if (state.stack.empty()) {
+            if (m_pendingRoots.size() >= MAX_PENDING_ROOTS) {
+                m_pendingRoots.erase(m_pendingRoots.begin());
+            }
+            PendingRoot root;
+            root.thread = buffer.index;
+            root.endTicks = scope.endTicks;
+            root.scopes.swap(state.records);
+            m_pendingRoots.push_back(std::move(root));
+        }
+    }
+}
+
+void ScopeProfiler::CompleteScope(const CompletedScope& scope) {
+    if (scope.name >= m_stats.size()) {
+        m_stats.resize(scope.name + 1);
+    }
+    NameStats& stats = m_stats[scope.name];
+    const double ms = scope.GetDurationMs();
+    stats.minMs = stats.calls == 0 ? ms : std::min(stats.minMs, ms);
+    stats.maxMs = stats.calls == 0 ? ms : std::max(stats.maxMs, ms);
+    stats.calls++;
+    stats.totalMs += ms;
+    stats.lastMs = ms;
+    if (!stats.sketch) {
+        stats.sketch = std::make_unique<QuantileSketch>();
+    }
+    stats.sketch->Add(ms);
+
+    for (const auto& listener : m_listeners) {
+        listener.second(scope);
+    }
+}
+
+void ScopeProfiler::CloseFrames() {
+    // Кадр [starts[0], starts[1]) закрывается, когда завершился и следующий
+    while (m_frameStarts.size() >= 3) {
+        ProfileFrame frame;
+        frame.index = m_nextFrameIndex++;
+        frame.startTicks = m_frameStarts[0];
+        frame.endTicks = m_frameStarts[1];
+        frame.durationMs = ProfileClock::ToMilliseconds(frame.endTicks - frame.startTicks);
+
+        size_t kept = 0;
+        for (size_t i = 0; i < m_pendingRoots.size(); ++i) {
+            PendingRoot& root = m_pendingRoots[i];
+            if (root.endTicks >= frame.endTicks) {
+                if (kept != i) {
+                    m_pendingRoots[kept] = std::move(root);
+                }
+                ++kept;
+            } else if (root.endTicks >= frame.startTicks) {
+                MergeRoot(frame, root);
+            }
+        }
+        m_pendingRoots.resize(kept);
+
+        for (const auto& listener : m_frameListeners) {
+            listener.second(frame);
+        }
+        m_frames.push_back(std::move(frame));
+        while (m_frames.size() > m_frameHistory) {
+            m_frames.pop_front();
+        }
+        m_frameStarts.pop_front();
+    }
+}
+
+void ScopeProfiler::MergeRoot(ProfileFrame& frame, const PendingRoot& root) {
+    // Обратный порядок завершения - обход от корня; path - цепочка предков
+    std::vector<uint32_t> path;
+    const uint16_t baseDepth = root.scopes.back().depth;
+    for (auto it = root.scopes.rbegin(); it != root.scopes.rend(); ++it) {
+        size_t level = it->depth > baseDepth ? it->depth - baseDepth : 0;
+        level = std::min(level, path.size());
+        path.resize(level);
+        const uint32_t parent = level ? path.back() : ProfileNode::NO_NODE;
+
+        uint32_t node = ProfileNode::NO_NODE;
+        if (parent == ProfileNode::NO_NODE) {
+            for (uint32_t i = 0; i < frame.nodes.size(); ++i) {
+                const ProfileNode& candidate = frame.nodes[i];
+                if (candidate.parent == ProfileNode::NO_NODE && candidate.thread == root.thread &&
+                    candidate.name == it->name) {
+                    node = i;
+                    break;
+                }
+            }
+        } else {
+            for (uint32_t child = frame.nodes[parent].firstChild; child != ProfileNode::NO_NODE;
+                 child = frame.nodes[child].nextSibling) {
+                if (frame.nodes[child].name == it->name) {
+                    node = child;
+                    break;
+                }
+            }
+        }
+
+        if (node == ProfileNode::NO_NODE) {
+            ProfileNode added;
+            added.name = it->name;
+            added.thread = root.thread;
+            added.parent = parent;
+            added.firstChild = ProfileNode::NO_NODE;
+            added.nextSibling = ProfileNode::NO_NODE;
+            added.depth = it->depth;
+            added.calls = 0;
+            added.totalMs = 0.0;
+            added.selfMs = 0.0;
+            node = static_cast<uint32_t>(frame.nodes.size());
+            if (parent != ProfileNode::NO_NODE) {
+                added.nextSibling = frame.nodes[parent].firstChild;
+                frame.nodes[parent].firstChild = node;
+            }
+            frame.nodes.push_back(added);
+        }
+
+        const double ms = it->GetDurationMs();
+        frame.nodes[node].calls++;
+        frame.nodes[node].totalMs += ms;
+        frame.nodes[node].selfMs += ms;
+        if (parent != ProfileNode::NO_NODE) {
+            frame.nodes[parent].selfMs -= ms;
+        }
+        path.push_back(node);
+    }
+}
+
+ScopeStats ScopeProfiler::GetStats(ProfileNameId name) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ScopeStats result;
+    result.name = name;
+    if (name >= m_stats.size() || m_stats[name].calls == 0) {
+        return result;
+    }
+
+    const NameStats& stats = m_stats[name];
+    result.calls = stats.calls;
+    result.totalMs = stats.totalMs;
+    result.minMs = stats.minMs;
+    result.maxMs = stats.maxMs;
+    result.lastMs = stats.lastMs;
+
+    result.p50Ms = stats.sketch->GetQuantile(0.5);
+    result.p95Ms = stats.sketch->GetQuantile(0.95);
+    result.p99Ms = stats.sketch->GetQuantile(0.99);
+    return result;
+}
+
+double ScopeProfiler::GetPercentile(ProfileNameId name, double q) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (name >= m_stats.size() || !m_stats[name].sketch) {
+        return 0.0;
+    }
+    return m_stats[name].sketch->GetQuantile(q);
+}
+
+bool ScopeProfiler::GetSketch(ProfileNameId name, QuantileSketch& sketch) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (name >= m_stats.size() || m_stats[name].calls == 0) {
+        return false;
+    }
+    sketch = *m_stats[name].sketch;
+    return true;
+}
+
+std::vector<ScopeStats> ScopeProfiler::GetAllStats() const {
+    size_t count;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        count = m_stats.size();
+    }
+    std::vector<ScopeStats> result;
+    for (size_t name = 1; name < count; ++name) {
+        ScopeStats stats = GetStats(static_cast<ProfileNameId>(name));
+        if (stats.calls > 0) {
+            result.push_back(stats);
+        }
+    }
+    return result;
+}
+
+bool ScopeProfiler::GetLastFrame(ProfileFrame& frame) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_frames.empty()) {
+        return false;
+    }
+    frame = m_frames.back();
+    return true;
+}
+
+std::vector<ProfileFrame> ScopeProfiler::GetFrameHistory() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::vector<ProfileFrame>(m_frames.begin(), m_frames.end());
+}
+
+uint64_t ScopeProfiler::GetDroppedEvents() const {
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    uint64_t dropped = m_retiredDropped.load(std::memory_order_relaxed) +
+                       m_droppedMarkers.load(std::memory_order_relaxed);
+    for (const auto& buffer : m_threads) {
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+uint32_t ScopeProfiler::GetThreadCount() const {
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    return static_cast<uint32_t>(m_threadNames.size());
+}
+
+std::string ScopeProfiler::GetThreadName(uint32_t thread) const {
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    return thread < m_threadNames.size() ? m_threadNames[thread] : std::string();
+}
+
+uint32_t ScopeProfiler::AddListener(Listener listener) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint32_t id = m_nextListenerId++;
+    m_listeners.emplace_back(id, std::move(listener));
+    return id;
+}
+
+void ScopeProfiler::RemoveListener(uint32_t id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_listeners.erase(std::remove_if(m_listeners.begin(), m_listeners.end(),
+        [id](const std::pair<uint32_t, Listener>& entry) { return entry.first == id; }), m_listeners.end());
+}
+
+uint32_t ScopeProfiler::AddFrameListener(FrameListener listener) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint32_t id = m_nextListenerId++;
+    m_frameListeners.emplace_back(id, std::move(listener));
+    return id;
+}
+
+void ScopeProfiler::RemoveFrameListener(uint32_t id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_frameListeners.erase(std::remove_if(m_frameListeners.begin(), m_frameListeners.end(),
+        [id](const std::pair<uint32_t, FrameListener>& entry) { return entry.first == id; }), m_frameListeners.end());
+}
+
+} // namespace FastEngine
@@ -0,0 +1,491 @@
+#include "FastEngine/Profiling/TraceCapture.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+namespace FastEngine {
+
+// TraceWriter implementation
+TraceWriter::TraceWriter()
+    : m_events(0) {
+}
+
+TraceWriter::~TraceWriter() {
+    Close();
+}
+
+bool TraceWriter::Open(const std::string& filename) {
+    Close();
+    m_file.open(filename, std::ios::out | std::ios::trunc);
+    if (!m_file.is_open()) {
+        return false;
+    }
+    m_events = 0;
+    m_file << std::fixed << std::setprecision(3);
+    m_file << "{\"traceEvents\":[\n";
+    return true;
+}
+
+void TraceWriter::Close() {
+    if (!m_file.is_open()) {
+        return;
+    }
+    m_file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    m_file.close();
+}
+
+void TraceWriter::WriteThreadName(uint32_t thread, const std::string& name) {
+    BeginEvent();
+    m_file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread << ",\"args\":{\"name\":";
+    WriteString(name);
+    m_file << "}}";
+}
+
+void TraceWriter::WriteSlice(const std::string& name, const char* category, uint32_t thread, double startUs, double durationUs) {
+    BeginEvent();
+    m_file << "{\"name\":";
+    WriteString(name);
+    m_file << ",\"cat\":\"" << category << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread
+           << ",\"ts\":" << startUs << ",\"dur\":" << durationUs << "}";
+}
+
+void TraceWriter::WriteCounter(const std::string& name, double timeUs, double value) {
+    BeginEvent();
+    m_file << "{\"name\":";
+    WriteString(name);
+    m_file << ",\"ph\":\"C\",\"pid\":1,\"ts\":" << timeUs << ",\"args\":{\"value\":" << value << "}}";
+}
+
+void TraceWriter::WriteFlow(const std::string& name, uint64_t id, uint32_t thread, double timeUs, bool start) {
+    BeginEvent();
+    m_file << "{\"name\":";
+    WriteString(name);
+    m_file << ",\"cat\":\"flow\",\"ph\":\"" << (start ? "s" : "f") << "\"";
+    if (!start) {
+        m_file << ",\"bp\":\"e\"";
+    }
+    m_file << ",\"id\":" << id << ",\"pid\":1,\"tid\":" << thread << ",\"ts\":" << timeUs << "}";
+}
+
+void TraceWriter::BeginEvent() {
+    if (m_events++ > 0) {
+        m_file << ",\n";
+    }
+}
+
+void TraceWriter::WriteString(const std::string& value) {
+    m_file << '"';
+    for (char c : value) {
+        switch (c) {
+            case '"': m_file << "\\\""; break;
+            case '\\': m_file << "\\\\"; break;
+            case '\n': m_file << "\\n"; break;
+            case '\t': m_file << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    m_file << "\\u00" << "0123456789abcdef"[(c >> 4) & 0xF] << "0123456789abcdef"[c & 0xF];
+                } else {
+                    m_file << c;
+                }
+                break;
+        }
+    }
+    m_file << '"';
+}
+
+// TraceCapture implementation
+std::atomic<bool> TraceCapture::s_recording(false);
+
+TraceCapture& TraceCapture::GetInstance() {
+    static TraceCapture instance;
+    return instance;
+}
+
+TraceCapture::TraceCapture()
+    : m_attached(false)
+    , m_scopeListener(0)
+    , m_frameListener(0)
+    , m_dropped(0)
+    , m_capturing(false)
+    , m_captureStarted(false)
+    , m_captureFrom(0)
+    , m_baseTicks(0)
+    , m_framesLeft(0)
+    , m_triggerEnabled(false)
+    , m_thresholdMs(0.0)
+    , m_framesBefore(0)
+    , m_framesAfter(0)
+    , m_captureCount(0) {
+    // Профилировщик создается раньше и уничтожается позже захвата
+    ScopeProfiler::GetInstance();
+}
+
+TraceCapture::~TraceCapture() {
+    s_recording.store(false);
+    {
+        std::lock_guard<std::mutex> lock(m_controlMutex);
+        if (m_attached) {
+            ScopeProfiler& profiler = ScopeProfiler::GetInstance();
+            profiler.RemoveListener(m_scopeListener);
+            profiler.RemoveFrameListener(m_frameListener);
+            profiler.Stop();
+            m_attached = false;
+        }
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_writer.Close();
+}
+
+void TraceCapture::Counter(ProfileNameId name, double value) {
+    if (!IsRecording()) {
+        return;
+    }
+    TraceEvent event;
+    event.kind = TraceEvent::COUNTER;
+    event.thread = 0;
+    event.name = name;
+    event.startTicks = event.endTicks = ProfileClock::Now();
+    event.flowId = 0;
+    event.value = value;
+    GetInstance().Record(event);
+}
+
+void TraceCapture::FlowBegin(ProfileNameId name, uint64_t id) {
+    if (!IsRecording()) {
+        return;
+    }
+    TraceEvent event;
+    event.kind = TraceEvent::FLOW_BEGIN;
+    event.thread = ScopeProfiler::GetCurrentThread();
+    event.name = name;
+    event.startTicks = event.endTicks = ProfileClock::Now();
+    event.flowId = id;
+    event.value = 0.0;
+    if (event.thread != ScopeProfiler::NO_THREAD) {
+        GetInstance().Record(event);
+    }
+}
+
+void TraceCapture::FlowEnd(ProfileNameId name, uint64_t id) {
+    if (!IsRecording()) {
+        return;
+    }
+    TraceEvent event;
+    event.kind = TraceEvent::FLOW_END;
+    event.thread = ScopeProfiler::GetCurrentThread();
+    event.name = name;
+    event.startTicks = event.endTicks = ProfileClock::Now();
+    event.flowId = id;
+    event.value = 0.0;
+    if (event.thread != ScopeProfiler::NO_THREAD) {
+        GetInstance().Record(event);
+    }
+}
+
+bool TraceCapture::StartCapture(const std::string& filename, uint32_t frames) {
+    std::lock_guard<std::mutex> control(m_controlMutex);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_capturing) {
+            std::cerr << "TraceCapture: Capture already in progress" << std::endl;
+            return false;
+        }
+        if (frames == 0) {
+            std::cerr << "TraceCapture: Frame count must be positive" << std::endl;
+            return false;
+        }
+        if (!OpenCapture(filename, 0)) {
+            return false;
+        }
+        m_captureStarted = false;
+        m_captureFrom = ProfileClock::Now();
+        m_framesLeft = frames;
+        UpdateRecording();
+    }
+    Attach();
+    return true;
+}
+
+void TraceCapture::StopCapture() {
+    std::lock_guard<std::mutex> control(m_controlMutex);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_capturing) {
+            FinishCapture();
+        }
+    }
+    DetachIfIdle();
+}
+
+bool TraceCapture::IsCapturing() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_capturing;
+}
+
+void TraceCapture::SetSpikeTrigger(double thresholdMs, uint32_t framesBefore, uint32_t framesAfter, const std::string& filePrefix) {
+    std::lock_guard<std::mutex> control(m_controlMutex);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_triggerEnabled = true;
+        m_thresholdMs = thresholdMs;
+        m_framesBefore = framesBefore;
+        m_framesAfter = framesAfter;
+        m_filePrefix = filePrefix;
+        m_history.clear();
+        UpdateRecording();
+    }
+    Attach();
+}
+
+void TraceCapture::DisableSpikeTrigger() {
+    std::lock_guard<std::mutex> control(m_controlMutex);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_triggerEnabled = false;
+        m_history.clear();
+        UpdateRecording();
+    }
+    DetachIfIdle();
+}
+
+bool TraceCapture::IsSpikeTriggerEnabled() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_triggerEnabled;
+}
+
+void TraceCapture::Update() {
+    std::lock_guard<std::mutex> control(m_controlMutex);
+    DetachIfIdle();
+}
+
+uint32_t TraceCapture::GetCaptureCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_captureCount;
+}
+
+bool TraceCapture::GetLastCapture(TraceCaptureInfo& info) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_captureCount == 0) {
+        return false;
+    }
+    info = m_lastCapture;
+    return true;
+}
+
+uint64_t TraceCapture::GetDroppedEvents() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_dropped;
+}
+
+void TraceCapture::SetOnCaptureComplete(std::function<void(const TraceCaptureInfo&)> callback) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_onCaptureComplete = callback;
+}
+
+void TraceCapture::Record(const TraceEvent& event) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Кадры не размечаются - новые события отбрасываются
+    if (m_pending.size() >= MAX_PENDING_EVENTS) {
+        m_dropped++;
+        return;
+    }
+    m_pending.push_back(event);
+}
+
+void TraceCapture::UpdateRecording() {
+    s_recording.store(m_capturing || m_triggerEnabled);
+}
+
+void TraceCapture::Attach() {
+    if (m_attached) {
+        return;
+    }
+    ScopeProfiler& profiler = ScopeProfiler::GetInstance();
+    profiler.Start();
+    m_scopeListener = profiler.AddListener([this](const CompletedScope& scope) { OnScope(scope); });
+    m_frameListener = profiler.AddFrameListener([this](const ProfileFrame& frame) { OnFrame(frame); });
+    m_attached = true;
+}
+
+void TraceCapture::DetachIfIdle() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_capturing || m_triggerEnabled) {
+            return;
+        }
+    }
+    if (!m_attached) {
+        return;
+    }
+    ScopeProfiler& profiler = ScopeProfiler::GetInstance();
+    profiler.RemoveListener(m_scopeListener);
+    profiler.RemoveFrameListener(m_frameListener);
+    profiler.Stop();
+    m_attached = false;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending.clear();
+    m_history.clear();
+}
+
+void TraceCapture::OnScope(const CompletedScope& scope) {
+    if (!IsRecording()) {
+        return;
+    }
+    TraceEvent event;
+    event.kind = TraceEvent::SLICE;
+    event.thread = scope.thread;
+    event.name = scope.name;
+    event.startTicks = scope.startTicks;
+    event.endTicks = scope.endTicks;
+    event.flowId = 0;
+    event.value = 0.0;
+    Record(event);
+}
+
+void TraceCapture::OnFrame(const ProfileFrame& frame) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_capturing && !m_triggerEnabled) {
+        m_pending.clear();
+        return;
+    }
+
+    // Кадру достаются события, завершившиеся до его конца
+    FrameEvents bucket;
+    bucket.index = frame.index;
+    bucket.startTicks = frame.startTicks;
+    bucket.endTicks = frame.endTicks;
+    bucket.durationMs = frame.durationMs;
+    size_t kept = 0;
+    for (size_t i = 0; i < m_pending.size(); ++i) {
+        if (m_pending[i].endTicks < frame.endTicks) {
+            bucket.events.push_back(m_pending[i]);
+        } else {
+            m_pending[kept++] = m_pending[i];
+        }
+    }
+    m_pending.resize(kept);
+
+    if (m_capturing) {
+        if (!m_captureStarted && frame.startTicks >= m_captureFrom) {
+            m_captureStarted = true;
+            m_current.firstFrame = frame.index;
+            m_baseTicks = frame.startTicks;
+            for (const TraceEvent& event : bucket.events) {
+                m_baseTicks = std::min(m_baseTicks, event.startTicks);
+            }
+        }
+        if (m_captureStarted) {
+            WriteFrame(bucket);
+            if (--m_framesLeft == 0) {
+                FinishCapture();
+            }
+        }
+    } else if (m_triggerEnabled && frame.durationMs > m_thresholdMs) {
+        uint64_t baseTicks = m_history.empty() ? frame.startTicks : m_history.front().startTicks;
+        for (const FrameEvents& previous : m_history) {
+            for (const TraceEvent& event : previous.events) {
+                baseTicks = std::min(baseTicks, event.startTicks);
+            }
+        }
+        for (const TraceEvent& event : bucket.events) {
+            baseTicks = std::min(baseTicks, event.startTicks);
+        }
+
+        if (OpenCapture(m_filePrefix + "_frame" + std::to_string(frame.index) + ".json", baseTicks)) {
+            m_captureStarted = true;
+            m_current.spike = true;
+            m_current.spikeMs = frame.durationMs;
+            m_current.firstFrame = m_history.empty() ? frame.index : m_history.front().index;
+            for (const FrameEvents& previous : m_history) {
+                WriteFrame(previous);
+            }
+            WriteFrame(bucket);
+            m_framesLeft = m_framesAfter;
+            if (m_framesLeft == 0) {
+                FinishCapture();
+            }
+        }
+    }
+
+    if (m_triggerEnabled && m_framesBefore > 0) {
+        m_history.push_back(std::move(bucket));
+        while (m_history.size() > m_framesBefore) {
+            m_history.pop_front();
+        }
+    } else {
+        m_history.clear();
+    }
+}
+
+bool TraceCapture::OpenCapture(const std::string& filename, uint64_t baseTicks) {
+    if (!m_writer.Open(filename)) {
+        std::cerr << "TraceCapture: Failed to open trace file: " << filename << std::endl;
+        return false;
+    }
+    m_capturing = true;
+    m_baseTicks = baseTicks;
+    m_namedThreads.clear();
+    m_current = TraceCaptureInfo();
+    m_current.filename = filename;
+    m_writer.WriteThreadName(TraceWriter::FRAME_TRACK, "Frames");
+    return true;
+}
+
+void TraceCapture::WriteFrame(const FrameEvents& frame) {
+    m_writer.WriteSlice("Frame " + std::to_string(frame.index), "frame", TraceWriter::FRAME_TRACK,
+                        ToMicroseconds(frame.startTicks), frame.durationMs * 1000.0);
+
+    for (const TraceEvent& event : frame.events) {
+        if (event.kind != TraceEvent::COUNTER) {
+            if (event.thread >= m_namedThreads.size()) {
+                m_namedThreads.resize(event.thread + 1, false);
+            }
+            if (!m_namedThreads[event.thread]) {
+                m_namedThreads[event.thread] = true;
+                m_writer.WriteThreadName(event.thread, ScopeProfiler::GetInstance().GetThreadName(event.thread));
+            }
+        }
+
+        const std::string& name = ProfileNames::Get(event.name);
+        const double timeUs = ToMicroseconds(event.startTicks);
+        switch (event.kind) {
+            case TraceEvent::SLICE:
+                m_writer.WriteSlice(name, "cpu", event.thread, timeUs,
+                                    ProfileClock::ToMilliseconds(event.endTicks - event.startTicks) * 1000.0);
+                break;
+            case TraceEvent::COUNTER:
+                m_writer.WriteCounter(name, timeUs, event.value);
+                break;
+            case TraceEvent::FLOW_BEGIN:
+            case TraceEvent::FLOW_END:
+                m_writer.WriteFlow(name, event.flowId, event.thread, timeUs, event.kind == TraceEvent::FLOW_BEGIN);
+                break;
+        }
+    }
+
+    m_current.frames++;
+    m_current.lastFrame = frame.index;
+}
+
+void TraceCapture::FinishCapture() {
+    m_current.events = m_writer.GetEventCount();
+    m_writer.Close();
+    m_capturing = false;
+    m_captureStarted = false;
+    m_captureCount++;
+    m_lastCapture = m_current;
+    UpdateRecording();
+
+    std::cout << "TraceCapture: Wrote " << m_current.frames << " frames to " << m_current.filename << std::endl;
+    if (m_onCaptureComplete) {
+        m_onCaptureComplete(m_lastCapture);
+    }
+}
+
+double TraceCapture::ToMicroseconds(uint64_t ticks) const {
+    const int64_t delta = static_cast<int64_t>(ticks - m_baseTicks);
+    return static_cast<double>(delta) / ProfileClock::GetTicksPerMillisecond() * 1000.0;
+}
+
+} // namespace FastEngine
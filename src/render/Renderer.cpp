@@ -95,12 +95,13 @@ attribute vec2 aTexCoord;
 uniform mat4 uProjection;
 uniform mat4 uView;
 uniform mat4 uModel;
+uniform vec4 uUVRect;
 
 varying vec2 TexCoord;
 
 void main() {
     gl_Position = uProjection * uView * uModel * vec4(aPos, 1.0);
-    TexCoord = aTexCoord;
+    TexCoord = mix(uUVRect.xy, uUVRect.zw, aTexCoord);
 }
             )";
             
@@ -223,6 +224,8 @@ void main() {
         // Установка цвета
         glm::vec4 color = sprite->GetColor();
         m_spriteShader->SetVec4("uColor", color);
+        // Кадр атласа
+        m_spriteShader->SetVec4("uUVRect", sprite->GetUVRect());
         
         // Установка текстуры
         if (sprite->GetTexture()) {
@@ -0,0 +1,92 @@
+#include "FastEngine/Resources/AnimationClip.h"
+#include <algorithm>
+
+namespace FastEngine {
+    namespace {
+        bool SameFrames(const std::vector<AnimationFrame>& a, const std::vector<AnimationFrame>& b) {
+            if (a.size() != b.size()) {
+                return false;
+            }
+            for (size_t i = 0; i < a.size(); ++i) {
+                if (a[i].duration != b[i].duration || a[i].uvRect != b[i].uvRect ||
+                    a[i].offset != b[i].offset || a[i].size != b[i].size ||
+                    a[i].texturePath != b[i].texturePath) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    glm::vec4 AtlasGridRect(uint32_t columns, uint32_t rows, uint32_t index) {
+        if (columns == 0 || rows == 0) {
+            return glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+        }
+        float width = 1.0f / columns;
+        float height = 1.0f / rows;
+        float u = static_cast<float>(index % columns) * width;
+        float v = static_cast<float>((index / columns) % rows) * height;
+        return glm::vec4(u, v, u + width, v + height);
+    }
+
+    AnimationClipLibrary& AnimationClipLibrary::GetInstance() {
+        static AnimationClipLibrary instance;
+        return instance;
+    }
+
+    AnimationClipHandle AnimationClipLibrary::Register(const Animation& animation) {
+        if (animation.frames.empty()) {
+            return INVALID_ANIMATION_CLIP;
+        }
+
+        auto range = m_byName.equal_range(animation.name);
+        for (auto it = range.first; it != range.second; ++it) {
+            const Animation& existing = m_clips[it->second - 1]->source;
+            if (existing.type == animation.type && existing.speed == animation.speed &&
+                SameFrames(existing.frames, animation.frames)) {
+                return it->second;
+            }
+        }
+
+        auto clip = std::make_unique<AnimationClip>();
+        clip->source = animation;
+        clip->duration = 0.0f;
+        for (const AnimationFrame& frame : animation.frames) {
+            float duration = std::max(frame.duration, AnimationClip::MIN_FRAME_DURATION);
+            clip->frameDurations.push_back(duration);
+            clip->uvRects.push_back(frame.uvRect);
+            clip->duration += duration;
+        }
+
+        // PingPong не повторяет крайние кадры: 0 1 2 1 0 1 2 ...
+        switch (animation.type) {
+            case AnimationType::Loop:
+                clip->cycleDuration = clip->duration;
+                break;
+            case AnimationType::PingPong:
+                clip->cycleDuration = clip->frameDurations.size() > 1
+                    ? 2.0f * clip->duration - clip->frameDurations.front() - clip->frameDurations.back()
+                    : clip->duration;
+                break;
+            case AnimationType::Once:
+                clip->cycleDuration = 0.0f;
+                break;
+        }
+
+        m_clips.push_back(std::move(clip));
+        AnimationClipHandle handle = static_cast<AnimationClipHandle>(m_clips.size());
+        m_byName.emplace(animation.name, handle);
+        return handle;
+    }
+
+    AnimationClipHandle AnimationClipLibrary::Find(const std::string& name) const {
+        AnimationClipHandle result = INVALID_ANIMATION_CLIP;
+        auto range = m_byName.equal_range(name);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (result == INVALID_ANIMATION_CLIP || it->second < result) {
+                result = it->second;
+            }
+        }
+        return result;
+    }
+}
@@ -3,6 +3,7 @@
 #include "FastEngine/Audio/Sound.h"
 #include "FastEngine/Render/Shader.h"
 #include "FastEngine/Platform/FileSystem.h"
+#include "FastEngine/Profiling/ScopeProfiler.h"
 #if !(defined(__APPLE__) && defined(TARGET_OS_IPHONE) && TARGET_OS_IPHONE)
 #include <filesystem>
 #endif
@@ -22,6 +23,10 @@ namespace FastEngine {
         m_autoUnload = true;
         m_hotReload = false;
         m_shutdown = false;
+        {
+            std::lock_guard<std::mutex> lock(m_loadMutex);
+            m_stopLoading = false;
+        }
         
         return true;
     }
@@ -29,13 +34,15 @@ namespace FastEngine {
     void ResourceManager::Shutdown() {
         m_shutdown = true;
         
-        // Ждем завершения всех потоков загрузки
-        for (auto& thread : m_loadingThreads) {
-            if (thread.joinable()) {
-                thread.join();
-            }
+        // Поток ввода-вывода дорабатывает очередь и завершается
+        {
+            std::lock_guard<std::mutex> lock(m_loadMutex);
+            m_stopLoading = true;
+        }
+        m_loadCondition.notify_all();
+        if (m_loadThread.joinable()) {
+            m_loadThread.join();
         }
-        m_loadingThreads.clear();
         
         // Выгружаем все ресурсы
         UnloadAll();
@@ -94,7 +101,9 @@ namespace FastEngine {
             info.type = ResourceType::Sound;
             info.path = path;
             info.name = GenerateResourceName(path);
-            info.size = 0;
+            // Декодированные отсчеты (общие через AudioClipCache) или буферы потока
+            info.size = sound->GetMemorySize();
+            m_usedMemory += info.size;
             info.lastAccess = std::chrono::system_clock::now();
             info.loaded = true;
             info.persistent = persistent;
@@ -151,12 +160,14 @@ namespace FastEngine {
             return;
         }
         
-        std::thread loadingThread([this, path, callback, persistent]() {
+        bool queued = QueueLoad([this, path, callback, persistent]() {
+            FASTENGINE_PROFILE_SCOPE("ResourceManager::LoadTextureAsync");
             auto texture = LoadTexture(path, persistent);
             callback(texture);
         });
-        
-        m_loadingThreads.push_back(std::move(loadingThread));
+        if (!queued) {
+            callback(nullptr);
+        }
     }
     
     void ResourceManager::LoadSoundAsync(const std::string& path, std::function<void(std::shared_ptr<Sound>)> callback, bool persistent) {
@@ -165,12 +176,14 @@ namespace FastEngine {
             return;
         }
         
-        std::thread loadingThread([this, path, callback, persistent]() {
+        bool queued = QueueLoad([this, path, callback, persistent]() {
+            FASTENGINE_PROFILE_SCOPE("ResourceManager::LoadSoundAsync");
             auto sound = LoadSound(path, persistent);
             callback(sound);
         });
-        
-        m_loadingThreads.push_back(std::move(loadingThread));
+        if (!queued) {
+            callback(nullptr);
+        }
     }
     
     void ResourceManager::UnloadResource(const std::string& path) {
@@ -182,6 +195,7 @@ namespace FastEngine {
         }
         
         ResourceType type = infoIt->second.type;
+        m_usedMemory -= std::min(m_usedMemory, infoIt->second.size);
         
         switch (type) {
             case ResourceType::Texture:
@@ -210,6 +224,7 @@ namespace FastEngine {
         for (auto it = m_resourceInfo.begin(); it != m_resourceInfo.end();) {
             if (it->second.type == type && it->second.name == name) {
                 std::string path = it->first;
+                m_usedMemory -= std::min(m_usedMemory, it->second.size);
                 it = m_resourceInfo.erase(it);
                 
                 switch (type) {
@@ -257,6 +272,7 @@ namespace FastEngine {
                 
                 std::string path = it->first;
                 ResourceType type = it->second.type;
+                m_usedMemory -= std::min(m_usedMemory, it->second.size);
                 
                 switch (type) {
                     case ResourceType::Texture:
@@ -339,15 +355,6 @@ namespace FastEngine {
         if (m_autoUnload) {
             UnloadUnused();
         }
-        
-        // Очищаем завершенные потоки
-        m_loadingThreads.erase(
-            std::remove_if(m_loadingThreads.begin(), m_loadingThreads.end(),
-                [](std::thread& t) {
-                    return !t.joinable();
-                }),
-            m_loadingThreads.end()
-        );
     }
     
     std::vector<ResourceInfo> ResourceManager::GetResourceInfo() const {
@@ -452,4 +459,37 @@ namespace FastEngine {
         // Упрощенная реализация перезагрузки ресурса
         // В реальной реализации ресурс бы перезагружался
     }
+    
+    bool ResourceManager::QueueLoad(std::function<void()> load) {
+        {
+            std::lock_guard<std::mutex> lock(m_loadMutex);
+            if (m_stopLoading) {
+                return false;
+            }
+            m_loadQueue.push_back(std::move(load));
+            if (!m_loadThread.joinable()) {
+                m_loadThread = std::thread(&ResourceManager::LoadThreadFunction, this);
+            }
+        }
+        m_loadCondition.notify_one();
+        return true;
+    }
+    
+    void ResourceManager::LoadThreadFunction() {
+        ScopeProfiler::SetThreadName("Resource Loading");
+        
+        while (true) {
+            std::function<void()> load;
+            {
+                std::unique_lock<std::mutex> lock(m_loadMutex);
+                m_loadCondition.wait(lock, [this]() { return m_stopLoading || !m_loadQueue.empty(); });
+                if (m_loadQueue.empty()) {
+                    return;
+                }
+                load = std::move(m_loadQueue.front());
+                m_loadQueue.pop_front();
+            }
+            load();
+        }
+    }
 }
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <FastEngine/Memory/LinearArena.h>
+#include <FastEngine/Memory/PoolAllocator.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace FastEngine;
+
+namespace {
+
+const int FRAMES = 200;
+const int ALLOCATIONS_PER_FRAME = 2000;
+
+double NanosecondsPerAllocation(std::chrono::high_resolution_clock::time_point start, int allocations) {
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / allocations;
+}
+
+size_t SizeFor(int i) {
+    return 16 + static_cast<size_t>((i * 29) % 240);
+}
+
+} // namespace
+
+TEST(AllocatorPerformanceTest, FrameArenaVersusMalloc) {
+    const int total = FRAMES * ALLOCATIONS_PER_FRAME;
+    std::vector<void*> pointers(ALLOCATIONS_PER_FRAME);
+    volatile uint8_t sink = 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        for (int i = 0; i < ALLOCATIONS_PER_FRAME; ++i) {
+            pointers[i] = std::malloc(SizeFor(i));
+            static_cast<uint8_t*>(pointers[i])[0] = static_cast<uint8_t>(i);
+        }
+        for (int i = 0; i < ALLOCATIONS_PER_FRAME; ++i) {
+            sink = sink + static_cast<uint8_t*>(pointers[i])[0];
+            std::free(pointers[i]);
+        }
+    }
+    double mallocNs = NanosecondsPerAllocation(start, total);
+
+    LinearArena arena(LinearArena::DEFAULT_CHUNK_SIZE, MEMORY_DEBUG_NONE);
+    start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        for (int i = 0; i < ALLOCATIONS_PER_FRAME; ++i) {
+            pointers[i] = arena.Allocate(SizeFor(i));
+            static_cast<uint8_t*>(pointers[i])[0] = static_cast<uint8_t>(i);
+        }
+        for (int i = 0; i < ALLOCATIONS_PER_FRAME; ++i) {
+            sink = sink + static_cast<uint8_t*>(pointers[i])[0];
+        }
+        arena.Reset();
+    }
+    double arenaNs = NanosecondsPerAllocation(start, total);
+
+    std::cout << "malloc/free: " << mallocNs << " ns per allocation" << std::endl;
+    std::cout << "Frame arena: " << arenaNs << " ns per allocation" << std::endl;
+    std::cout << "Arena chunks after warm-up: " << arena.GetChunkCount()
+              << ", peak " << arena.GetPeakUsed() << " bytes" << std::endl;
+
+    // После первого кадра все выделения укладываются в один блок
+    EXPECT_EQ(arena.GetChunkCount(), 1u);
+    EXPECT_LT(arenaNs, mallocNs);
+}
+
+TEST(AllocatorPerformanceTest, PoolVersusNew) {
+    struct Particle {
+        float position[2];
+        float velocity[2];
+        float lifetime;
+        int flags;
+    };
+
+    const int total = FRAMES * ALLOCATIONS_PER_FRAME;
+    std::vector<Particle*> particles(ALLOCATIONS_PER_FRAME);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        for (int i = 0; i < ALLOCATIONS_PER_FRAME; ++i) {
+            particles[i] = new Particle{{0.0f, 0.0f}, {1.0f, 1.0f}, 1.0f, i};
+        }
+        for (int i = 0; i < ALLOCATIONS_PER_FRAME; ++i) {
+            delete particles[i];
+        }
+    }
+    double newNs = NanosecondsPerAllocation(start, total);
+
+    ObjectPool<Particle> pool(1024, MEMORY_DEBUG_NONE);
+    start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        for (int i = 0; i < ALLOCATIONS_PER_FRAME; ++i) {
+            particles[i] = pool.Create(Particle{{0.0f, 0.0f}, {1.0f, 1.0f}, 1.0f, i});
+        }
+        for (int i = 0; i < ALLOCATIONS_PER_FRAME; ++i) {
+            pool.Destroy(particles[i]);
+        }
+    }
+    double poolNs = NanosecondsPerAllocation(start, total);
+
+    std::cout << "new/delete: " << newNs << " ns per object" << std::endl;
+    std::cout << "Object pool: " << poolNs << " ns per object" << std::endl;
+
+    EXPECT_EQ(pool.GetPool().GetLiveCount(), 0u);
+    EXPECT_EQ(pool.GetPool().GetSlabCount(), 2u);
+    EXPECT_LT(poolNs, newNs * 2.0);
+}
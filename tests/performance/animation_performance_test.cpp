@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <FastEngine/Components/Animator.h>
+#include <FastEngine/Components/Sprite.h>
+#include <FastEngine/Entity.h>
+#include <FastEngine/Resources/AnimationClip.h>
+#include <FastEngine/Systems/AnimationSystem.h>
+#include <FastEngine/World.h>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace FastEngine;
+
+namespace {
+
+const int ENTITIES = 10000;
+const int FRAMES = 300;
+const float FRAME_TIME = 1.0f / 60.0f;
+
+} // namespace
+
+TEST(AnimationPerformanceTest, SystemPass10kSprites) {
+    // Восемь общих клипов атласа 8x8 на десять тысяч сущностей
+    std::vector<AnimationClipHandle> clips;
+    for (int c = 0; c < 8; ++c) {
+        Animation animation("perf_clip_" + std::to_string(c));
+        animation.type = c % 3 == 0 ? AnimationType::PingPong : AnimationType::Loop;
+        for (uint32_t i = 0; i < 8; ++i) {
+            animation.frames.push_back(AnimationFrame(AtlasGridRect(8, 8, c * 8 + i), 0.08f + 0.01f * c));
+        }
+        clips.push_back(AnimationClipLibrary::GetInstance().Register(animation));
+    }
+
+    World world;
+    AnimationSystem* system = world.AddSystem<AnimationSystem>(&world);
+    for (int i = 0; i < ENTITIES; ++i) {
+        Entity* entity = world.CreateEntity();
+        entity->AddComponent<Sprite>(static_cast<Texture*>(nullptr));
+        Animator* animator = entity->AddComponent<Animator>();
+        animator->AddClip(clips[i % clips.size()]);
+        animator->Play(clips[i % clips.size()]);
+        animator->SetSpeed(0.75f + 0.5f * (i % 7) / 6.0f);
+    }
+
+    system->Update(FRAME_TIME); // Подключение аниматоров
+    uint64_t frameChanges = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        system->Update(FRAME_TIME);
+        frameChanges += system->GetStats().frameChanges;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double microseconds = std::chrono::duration<double, std::micro>(end - start).count() / FRAMES;
+    std::cout << "AnimationSystem, " << ENTITIES << " sprites: " << microseconds << " us per frame, "
+              << static_cast<double>(frameChanges) / FRAMES << " frame changes per frame" << std::endl;
+
+    EXPECT_EQ(system->GetAnimatorCount(), static_cast<size_t>(ENTITIES));
+    EXPECT_GT(frameChanges, 0u);
+    // Бюджет: не больше 2 мс кадра на 10k спрайтов
+    EXPECT_LT(microseconds, 2000.0);
+}
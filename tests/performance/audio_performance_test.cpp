@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <FastEngine/Audio/AudioCodec.h>
+#include <FastEngine/Audio/AudioManager.h>
+#include <FastEngine/Audio/AudioMixer.h>
+#include <FastEngine/Components/AudioSource.h>
+#include <FastEngine/Components/Transform.h>
+#include <FastEngine/Entity.h>
+#include <FastEngine/Systems/AudioSystem.h>
+#include <FastEngine/World.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+using namespace FastEngine;
+
+namespace {
+
+const uint32_t SAMPLE_RATE = 48000;
+const uint32_t BLOCK_FRAMES = 256;
+const float AUDIO_SECONDS = 2.0f;
+
+AudioClipPtr MakeToneClip(uint32_t channels, float frequency) {
+    const uint32_t frames = SAMPLE_RATE;
+    std::vector<float> samples(frames * channels);
+    for (uint32_t i = 0; i < frames; ++i) {
+        float value = 0.5f * std::sin(6.2831853f * frequency * i / SAMPLE_RATE);
+        for (uint32_t c = 0; c < channels; ++c) {
+            samples[i * channels + c] = value;
+        }
+    }
+    return AudioClip::Create(std::move(samples), channels, SAMPLE_RATE);
+}
+
+// Голосов, которые одно ядро смешивает в реальном времени
+double MeasureVoicesPerCore(uint32_t voices, float pitch, uint32_t channels) {
+    AudioMixerConfig config;
+    config.sampleRate = SAMPLE_RATE;
+    config.blockFrames = BLOCK_FRAMES;
+    config.maxVoices = voices;
+    AudioMixer mixer(config);
+
+    AudioClipPtr clip = MakeToneClip(channels, 440.0f);
+    for (uint32_t i = 0; i < voices; ++i) {
+        VoiceParams params;
+        params.volume = 0.01f;
+        params.pan = (i % 9) / 4.0f - 1.0f;
+        params.pitch = pitch;
+        params.looping = true;
+        mixer.Play(clip, params);
+    }
+
+    std::vector<float> output(BLOCK_FRAMES * 2);
+    const uint32_t blocks = static_cast<uint32_t>(AUDIO_SECONDS * SAMPLE_RATE / BLOCK_FRAMES);
+    mixer.Render(output.data(), BLOCK_FRAMES); // Прогрев, запуск голосов
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < blocks; ++i) {
+        mixer.Render(output.data(), BLOCK_FRAMES);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    EXPECT_EQ(mixer.GetActiveVoiceCount(), voices);
+
+    double cpuSeconds = std::chrono::duration<double>(end - start).count();
+    double audioSeconds = static_cast<double>(blocks) * BLOCK_FRAMES / SAMPLE_RATE;
+    return voices * audioSeconds / cpuSeconds;
+}
+
+} // namespace
+
+TEST(AudioPerformanceTest, MixerVoicesPerCore) {
+    const uint32_t VOICES = 256;
+    double direct = MeasureVoicesPerCore(VOICES, 1.0f, 1);
+    double resampled = MeasureVoicesPerCore(VOICES, 1.13f, 1);
+    double stereo = MeasureVoicesPerCore(VOICES, 1.13f, 2);
+
+    std::cout << "Mixer, " << VOICES << " voices, block " << BLOCK_FRAMES << " frames:" << std::endl;
+    std::cout << "  mono, no resampling: " << direct << " voices per core" << std::endl;
+    std::cout << "  mono, resampled:     " << resampled << " voices per core" << std::endl;
+    std::cout << "  stereo, resampled:   " << stereo << " voices per core" << std::endl;
+
+    // Бюджет мобильного устройства - порядка 32-64 голосов на долю ядра
+    EXPECT_GT(direct, 256.0);
+    EXPECT_GT(resampled, 128.0);
+    EXPECT_GT(stereo, 64.0);
+    EXPECT_GT(direct, resampled);
+}
+
+TEST(AudioPerformanceTest, CommandThroughput) {
+    const int COMMANDS = 200000;
+    AudioMixerConfig config;
+    config.maxVoices = 64;
+    config.commandQueueSize = 4096;
+    AudioMixer mixer(config);
+    AudioClipPtr clip = MakeToneClip(1, 220.0f);
+
+    std::vector<VoiceHandle> voices;
+    for (int i = 0; i < 64; ++i) {
+        VoiceParams params;
+        params.looping = true;
+        voices.push_back(mixer.Play(clip, params));
+    }
+
+    std::vector<float> output(config.blockFrames * 2);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < COMMANDS; ++i) {
+        mixer.SetVoicePan(voices[i % voices.size()], (i % 200) / 100.0f - 1.0f);
+        if (i % 2048 == 0) {
+            mixer.Render(output.data(), config.blockFrames);
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double nsPerCommand = std::chrono::duration<double, std::nano>(end - start).count() / COMMANDS;
+    std::cout << "Mixer command (enqueue + apply, with mixing): " << nsPerCommand << " ns" << std::endl;
+    EXPECT_LT(nsPerCommand, 2000.0);
+}
+
+TEST(AudioPerformanceTest, SpatialPass500Emitters) {
+    const int EMITTERS = 500;
+    const int FRAMES = 600;
+    const char* path = "spatial_bench.wav";
+    ASSERT_TRUE(AudioEncoder::WriteWav(path, *MakeToneClip(1, 330.0f)));
+
+    AudioManager manager;
+    ASSERT_TRUE(manager.Initialize());
+    World world;
+    Entity* listener = world.CreateEntity();
+    listener->AddComponent<Transform>();
+    AudioSystem system(&world, &manager);
+    system.SetListener(listener);
+    system.SetMaxRealVoices(32);
+
+    std::vector<Transform*> transforms;
+    for (int i = 0; i < EMITTERS; ++i) {
+        Entity* entity = world.CreateEntity();
+        transforms.push_back(entity->AddComponent<Transform>());
+        AudioSource* source = entity->AddComponent<AudioSource>();
+        ASSERT_TRUE(source->LoadSound(path));
+        source->SetLooping(true);
+        source->Set3DEnabled(true);
+        source->SetMinDistance(5.0f);
+        source->SetMaxDistance(120.0f);
+        source->Play();
+    }
+
+    // Источники кружат вокруг слушателя: набор слышимых меняется каждый кадр
+    double totalUs = 0.0;
+    uint64_t started = 0;
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        for (int i = 0; i < EMITTERS; ++i) {
+            float angle = i * 0.7f + frame * 0.01f * (1 + i % 3);
+            float radius = 10.0f + (i % 50) * 6.0f;
+            transforms[i]->SetPosition(radius * std::cos(angle), radius * std::sin(angle));
+        }
+        auto start = std::chrono::high_resolution_clock::now();
+        system.Update(1.0f / 60.0f);
+        auto end = std::chrono::high_resolution_clock::now();
+        totalUs += std::chrono::duration<double, std::micro>(end - start).count();
+        started += system.GetStats().startedVoices;
+        manager.Update();
+    }
+
+    const AudioSystemStats& stats = system.GetStats();
+    double usPerFrame = totalUs / FRAMES;
+    std::cout << "Spatial pass, " << EMITTERS << " emitters: " << usPerFrame << " us per frame, "
+              << stats.realVoices << " real, " << stats.virtualVoices << " virtual, "
+              << static_cast<double>(started) / FRAMES << " voice starts per frame, mixer load "
+              << manager.GetMixer()->GetLoad() * 100.0 << "%" << std::endl;
+    EXPECT_EQ(stats.playingSources, static_cast<uint32_t>(EMITTERS));
+    EXPECT_EQ(stats.realVoices, 32u);
+    EXPECT_LE(manager.GetMixer()->GetActiveVoiceCount(), 64u);
+    // Бюджет: заметно меньше миллисекунды кадра на мобильном
+    EXPECT_LT(usPerFrame, 500.0);
+
+    system.Cleanup();
+    std::remove(path);
+}
@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+#include <FastEngine/AI/BehaviorTree.h>
+#include <FastEngine/AI/CompiledBehaviorTree.h>
+#include <FastEngine/Jobs/JobSystem.h>
+#include <any>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace FastEngine;
+
+namespace {
+
+const int AGENT_COUNT = 10000;
+const int FRAME_COUNT = 50;
+
+// Дерево агента: атаковать, если здоров и видит цель; иначе идти к цели; иначе патрулировать
+BlackboardKey<int> g_health;
+BlackboardKey<int> g_hasTarget;
+BlackboardKey<int> g_actions;
+
+bool CompiledIsHealthy(BehaviorTickContext& context) { return context.blackboard.Get(g_health) > 50; }
+bool CompiledHasTarget(BehaviorTickContext& context) { return context.blackboard.Get(g_hasTarget) != 0; }
+BehaviorStatus CompiledAct(BehaviorTickContext& context) {
+    context.blackboard.Set(g_actions, context.blackboard.Get(g_actions) + 1);
+    return BehaviorStatus::Success;
+}
+
+std::shared_ptr<BehaviorTree> CreateLegacyTree() {
+    auto tree = std::make_shared<BehaviorTree>();
+    auto isHealthy = [](BehaviorContext& context) { return std::any_cast<int>(context.GetData("health")) > 50; };
+    auto hasTarget = [](BehaviorContext& context) { return std::any_cast<int>(context.GetData("hasTarget")) != 0; };
+    auto act = [](BehaviorContext& context) {
+        context.SetData("actions", std::any_cast<int>(context.GetData("actions")) + 1);
+        return BehaviorStatus::Success;
+    };
+
+    auto attack = tree->CreateSequence();
+    attack->AddChild(tree->CreateCondition(isHealthy));
+    attack->AddChild(tree->CreateCondition(hasTarget));
+    attack->AddChild(tree->CreateAction(act));
+
+    auto chase = tree->CreateSequence();
+    chase->AddChild(tree->CreateCondition(hasTarget));
+    chase->AddChild(tree->CreateAction(act));
+
+    auto root = tree->CreateSelector();
+    root->AddChild(attack);
+    root->AddChild(chase);
+    root->AddChild(tree->CreateAction(act));
+    tree->SetRoot(root);
+    return tree;
+}
+
+} // namespace
+
+TEST(BehaviorTreePerformanceTest, CompiledVsLegacy) {
+    // Прежний способ: дерево и контекст на каждого агента
+    std::vector<std::shared_ptr<BehaviorTree>> legacyTrees;
+    std::vector<BehaviorContext> legacyContexts(AGENT_COUNT);
+    for (int i = 0; i < AGENT_COUNT; ++i) {
+        legacyTrees.push_back(CreateLegacyTree());
+        legacyContexts[i].SetData("health", i % 100);
+        legacyContexts[i].SetData("hasTarget", i % 3);
+        legacyContexts[i].SetData("actions", 0);
+    }
+
+    BehaviorTreeBuilder builder;
+    g_health = builder.GetLayout().AddSlot<int>("health");
+    g_hasTarget = builder.GetLayout().AddSlot<int>("hasTarget");
+    g_actions = builder.GetLayout().AddSlot<int>("actions");
+    builder.Selector()
+               .Sequence().Condition(CompiledIsHealthy).Condition(CompiledHasTarget).Action(CompiledAct).End()
+               .Sequence().Condition(CompiledHasTarget).Action(CompiledAct).End()
+               .Action(CompiledAct)
+           .End();
+
+    BehaviorAgentGroup group(builder.Build());
+    group.Reserve(AGENT_COUNT);
+    for (int i = 0; i < AGENT_COUNT; ++i) {
+        uint32_t agent = group.AddAgent();
+        group.GetBlackboard(agent).Set(g_health, i % 100);
+        group.GetBlackboard(agent).Set(g_hasTarget, i % 3);
+    }
+
+    auto legacyStart = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAME_COUNT; ++frame) {
+        for (int i = 0; i < AGENT_COUNT; ++i) {
+            legacyTrees[i]->Execute(legacyContexts[i]);
+        }
+    }
+    auto legacyEnd = std::chrono::high_resolution_clock::now();
+
+    auto compiledStart = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAME_COUNT; ++frame) {
+        group.TickAll(0.016f);
+    }
+    auto compiledEnd = std::chrono::high_resolution_clock::now();
+
+    for (int i = 0; i < AGENT_COUNT; i += 97) {
+        ASSERT_EQ(std::any_cast<int>(legacyContexts[i].GetData("actions")),
+                  group.GetBlackboard(static_cast<uint32_t>(i)).Get(g_actions));
+    }
+
+    double legacyMs = std::chrono::duration<double, std::milli>(legacyEnd - legacyStart).count() / FRAME_COUNT;
+    double compiledMs = std::chrono::duration<double, std::milli>(compiledEnd - compiledStart).count() / FRAME_COUNT;
+    std::cout << AGENT_COUNT << " agents per frame: legacy " << legacyMs << " ms, compiled "
+              << compiledMs << " ms (x" << (legacyMs / compiledMs) << ")" << std::endl;
+
+    EXPECT_LT(compiledMs, legacyMs);
+}
+
+namespace {
+
+// Глубокое дерево, где агент большую часть времени выполняет длинное действие
+BlackboardKey<int> g_walk;
+
+BehaviorStatus LongWalk(BehaviorTickContext& context) {
+    int steps = context.blackboard.Get(g_walk) + 1;
+    context.blackboard.Set(g_walk, steps);
+    return steps % 20 == 0 ? BehaviorStatus::Success : BehaviorStatus::Running;
+}
+
+std::shared_ptr<const CompiledBehaviorTree> CreateDeepTree() {
+    BehaviorTreeBuilder builder;
+    g_health = builder.GetLayout().AddSlot<int>("health");
+    g_hasTarget = builder.GetLayout().AddSlot<int>("hasTarget");
+    g_actions = builder.GetLayout().AddSlot<int>("actions");
+    g_walk = builder.GetLayout().AddSlot<int>("walk");
+    builder.Selector()
+               .Sequence().Condition(CompiledIsHealthy).Condition(CompiledHasTarget).Action(CompiledAct).End()
+               .Sequence().Condition(CompiledHasTarget).Action(CompiledAct).End()
+               .Sequence()
+                   .Action(CompiledAct)
+                   .Sequence().Action(CompiledAct).Sequence().Action(CompiledAct).Action(LongWalk).End().End()
+               .End()
+           .End();
+    return builder.Build();
+}
+
+// Средние за кадр: время Update и число тикнутых агентов
+void RunScheduler(BehaviorTreeManager& manager, double& updateMs, double& tickedPerFrame) {
+    updateMs = 0.0;
+    tickedPerFrame = 0.0;
+    for (int frame = 0; frame < FRAME_COUNT; ++frame) {
+        manager.Update(0.016f);
+        updateMs += manager.GetLastUpdateTime();
+        tickedPerFrame += static_cast<double>(manager.GetLastTickedAgents());
+    }
+    updateMs /= FRAME_COUNT;
+    tickedPerFrame /= FRAME_COUNT;
+}
+
+} // namespace
+
+TEST(BehaviorTreePerformanceTest, SchedulerThroughput) {
+    auto tree = CreateDeepTree();
+    struct Config {
+        const char* name;
+        int workers;
+        bool lod;
+    };
+    const Config configs[] = {
+        {"serial, every frame", 0, false},
+        {"workers, every frame", 3, false},
+        {"workers, LOD", 3, true},
+    };
+
+    double everyFrameMs = 0.0;
+    for (const Config& config : configs) {
+        if (config.workers > 0) {
+            JobSystem::GetInstance().Start(config.workers);
+        }
+        BehaviorTreeManager manager;
+        manager.Initialize();
+        manager.AddCompiledTree("agent", tree);
+        if (config.lod) {
+            manager.SetLodLevels({BehaviorLodLevel(50.0f, 1), BehaviorLodLevel(150.0f, 4), BehaviorLodLevel(1000.0f, 16)});
+        }
+        for (int i = 0; i < AGENT_COUNT; ++i) {
+            BehaviorAgentId agent = manager.AddAgent("agent");
+            manager.GetBlackboard(agent).Set(g_health, i % 100);
+            manager.GetBlackboard(agent).Set(g_hasTarget, i % 3 == 0 ? 0 : (i % 7 == 0 ? 1 : 0));
+            manager.SetAgentPosition(agent, glm::vec3(static_cast<float>(i % 400), 0.0f, 0.0f));
+        }
+
+        double updateMs = 0.0;
+        double tickedPerFrame = 0.0;
+        RunScheduler(manager, updateMs, tickedPerFrame);
+        std::cout << AGENT_COUNT << " agents, " << config.name << ": " << updateMs << " ms per frame, "
+                  << tickedPerFrame << " ticked per frame, " << (tickedPerFrame / updateMs)
+                  << " agents per ms" << std::endl;
+
+        if (!config.lod && config.workers == 0) {
+            everyFrameMs = updateMs;
+        }
+        if (config.lod) {
+            EXPECT_LT(tickedPerFrame, AGENT_COUNT * 0.5);
+            EXPECT_LT(updateMs, everyFrameMs);
+        }
+        manager.Shutdown();
+        JobSystem::GetInstance().Stop();
+    }
+
+    // Бюджет кадра ограничивает время Update
+    BehaviorTreeManager budgeted;
+    budgeted.Initialize();
+    budgeted.AddCompiledTree("agent", tree);
+    budgeted.SetFrameBudget(0.1f);
+    for (int i = 0; i < AGENT_COUNT; ++i) {
+        budgeted.AddAgent("agent");
+    }
+    double updateMs = 0.0;
+    double tickedPerFrame = 0.0;
+    RunScheduler(budgeted, updateMs, tickedPerFrame);
+    std::cout << AGENT_COUNT << " agents, 0.1 ms budget: " << updateMs << " ms per frame, "
+              << tickedPerFrame << " ticked per frame" << std::endl;
+    EXPECT_GT(tickedPerFrame, 0.0);
+    EXPECT_LT(tickedPerFrame, static_cast<double>(AGENT_COUNT));
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <FastEngine/Jobs/JobSystem.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace FastEngine;
+
+namespace {
+
+double MillisecondsSince(std::chrono::high_resolution_clock::time_point start) {
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+float Work(float value) {
+    for (int i = 0; i < 16; ++i) {
+        value = std::sqrt(value * value + 1.0f) * 0.5f;
+    }
+    return value;
+}
+
+} // namespace
+
+TEST(JobSystemPerformanceTest, SchedulingOverhead) {
+    JobSystem& jobs = JobSystem::GetInstance();
+    ASSERT_TRUE(jobs.Start());
+
+    const int count = 200000;
+    std::atomic<int> executed(0);
+    JobCounter counter;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < count; ++i) {
+        jobs.Schedule([&executed]() { executed.fetch_add(1, std::memory_order_relaxed); }, &counter);
+    }
+    jobs.Wait(counter);
+    double totalMs = MillisecondsSince(start);
+    JobSystemStats stats = jobs.GetStats();
+    jobs.Stop();
+
+    double perJobNs = totalMs * 1e6 / count;
+    std::cout << "Workers: " << stats.workers << std::endl;
+    std::cout << "Empty job: " << perJobNs << " ns (schedule + execute)" << std::endl;
+    std::cout << "Stolen: " << stats.stolen << ", heap jobs: " << stats.heapJobs << std::endl;
+
+    EXPECT_EQ(executed.load(), count);
+    EXPECT_LT(perJobNs, 5000.0);
+}
+
+TEST(JobSystemPerformanceTest, ParallelForScaling) {
+    const size_t count = 1 << 20;
+    std::vector<float> input(count);
+    for (size_t i = 0; i < count; ++i) {
+        input[i] = static_cast<float>(i % 1000);
+    }
+    std::vector<float> serial(count);
+    std::vector<float> parallel(count);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        serial[i] = Work(input[i]);
+    }
+    double serialMs = MillisecondsSince(start);
+
+    JobSystem& jobs = JobSystem::GetInstance();
+    ASSERT_TRUE(jobs.Start());
+    start = std::chrono::high_resolution_clock::now();
+    jobs.ParallelFor(0, count, [&](size_t i) { parallel[i] = Work(input[i]); }, 256);
+    double parallelMs = MillisecondsSince(start);
+    uint32_t threads = jobs.GetThreadCount();
+    jobs.Stop();
+
+    std::cout << "Serial: " << serialMs << " ms" << std::endl;
+    std::cout << "ParallelFor on " << threads << " threads: " << parallelMs << " ms ("
+              << serialMs / std::max(parallelMs, 1e-3) << "x)" << std::endl;
+
+    EXPECT_TRUE(std::equal(serial.begin(), serial.end(), parallel.begin()));
+    // На одном ядре ускорения нет, но и деление не должно стоить заметно
+    if (std::thread::hardware_concurrency() <= 1) {
+        EXPECT_LT(parallelMs, serialMs * 1.5 + 5.0);
+    } else {
+        EXPECT_LT(parallelMs, serialMs);
+    }
+}
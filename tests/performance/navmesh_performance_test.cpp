@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <FastEngine/AI/NavMesh.h>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Линейный перебор, которым раньше отвечали IsWalkable и поиск ближайшего узла
+bool LinearIsWalkable(const FastEngine::NavMesh& navMesh, const glm::vec3& point) {
+    const auto& nodes = navMesh.GetNodes();
+    for (const auto& triangle : navMesh.GetTriangles()) {
+        if (!triangle.walkable) continue;
+        
+        const glm::vec3& v0 = nodes[triangle.vertices[0]].position;
+        const glm::vec3& v1 = nodes[triangle.vertices[1]].position;
+        const glm::vec3& v2 = nodes[triangle.vertices[2]].position;
+        float denom = (v1.z - v2.z) * (v0.x - v2.x) + (v2.x - v1.x) * (v0.z - v2.z);
+        if (std::abs(denom) < 1e-10f) continue;
+        float a = ((v1.z - v2.z) * (point.x - v2.x) + (v2.x - v1.x) * (point.z - v2.z)) / denom;
+        float b = ((v2.z - v0.z) * (point.x - v2.x) + (v0.x - v2.x) * (point.z - v2.z)) / denom;
+        if (a >= -1e-5f && b >= -1e-5f && 1.0f - a - b >= -1e-5f) return true;
+    }
+    return false;
+}
+
+int LinearNearestNode(const FastEngine::NavMesh& navMesh, const glm::vec3& point) {
+    const auto& nodes = navMesh.GetNodes();
+    int nearest = -1;
+    float minDist = std::numeric_limits<float>::max();
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (!nodes[i].walkable) continue;
+        float dist = glm::distance(point, nodes[i].position);
+        if (dist < minDist) { minDist = dist; nearest = static_cast<int>(i); }
+    }
+    return nearest;
+}
+
+} // namespace
+
+class NavMeshPerformanceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // 225x225 вершин -> 100352 треугольника
+        const int size = 225;
+        std::vector<std::vector<float>> heightmap(size, std::vector<float>(size));
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                heightmap[y][x] = 1.0f + std::sin(x * 0.2f) * std::cos(y * 0.17f);
+            }
+        }
+        
+        navMesh = std::make_unique<FastEngine::NavMesh>();
+        ASSERT_TRUE(navMesh->GenerateFromHeightmap(heightmap, 1.0f, 0.3f));
+        ASSERT_GE(navMesh->GetTriangles().size(), 100000u);
+        
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> coord(-5.0f, static_cast<float>(size + 5));
+        for (int i = 0; i < 2000; ++i) {
+            points.emplace_back(coord(rng), 1.0f, coord(rng));
+        }
+    }
+    
+    template <typename Fn>
+    static double MeasureSeconds(Fn&& fn) {
+        auto start = std::chrono::high_resolution_clock::now();
+        fn();
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double>(end - start).count();
+    }
+    
+    std::unique_ptr<FastEngine::NavMesh> navMesh;
+    std::vector<glm::vec3> points;
+};
+
+TEST_F(NavMeshPerformanceTest, WalkabilityQueries) {
+    const size_t linearCount = 200;
+    int linearHits = 0;
+    int indexedHits = 0;
+    
+    double linearSeconds = MeasureSeconds([&]() {
+        for (size_t i = 0; i < linearCount; ++i) {
+            linearHits += LinearIsWalkable(*navMesh, points[i]) ? 1 : 0;
+        }
+    });
+    double indexedSeconds = MeasureSeconds([&]() {
+        for (size_t i = 0; i < linearCount; ++i) {
+            indexedHits += navMesh->IsWalkable(points[i]) ? 1 : 0;
+        }
+    });
+    
+    EXPECT_EQ(linearHits, indexedHits);
+    std::cout << "IsWalkable on " << navMesh->GetTriangles().size() << " triangles: linear "
+              << (linearSeconds * 1e6 / linearCount) << " us/query, grid "
+              << (indexedSeconds * 1e6 / linearCount) << " us/query" << std::endl;
+    EXPECT_LT(indexedSeconds, linearSeconds);
+}
+
+TEST_F(NavMeshPerformanceTest, NearestNodeQueries) {
+    const size_t linearCount = 200;
+    
+    std::vector<int> linear;
+    std::vector<int> indexed;
+    double linearSeconds = MeasureSeconds([&]() {
+        for (size_t i = 0; i < linearCount; ++i) linear.push_back(LinearNearestNode(*navMesh, points[i]));
+    });
+    double indexedSeconds = MeasureSeconds([&]() {
+        for (size_t i = 0; i < linearCount; ++i) indexed.push_back(navMesh->FindNearestNode(points[i]));
+    });
+    
+    const auto& nodes = navMesh->GetNodes();
+    for (size_t i = 0; i < linearCount; ++i) {
+        ASSERT_GE(indexed[i], 0);
+        EXPECT_FLOAT_EQ(glm::distance(points[i], nodes[indexed[i]].position),
+                        glm::distance(points[i], nodes[linear[i]].position));
+    }
+    
+    std::cout << "FindNearestNode on " << nodes.size() << " nodes: linear "
+              << (linearSeconds * 1e6 / linearCount) << " us/query, grid "
+              << (indexedSeconds * 1e6 / linearCount) << " us/query" << std::endl;
+    EXPECT_LT(indexedSeconds, linearSeconds);
+}
+
+TEST_F(NavMeshPerformanceTest, RaycastQueries) {
+    int blocked = 0;
+    double seconds = MeasureSeconds([&]() {
+        for (size_t i = 0; i + 1 < points.size(); i += 2) {
+            // Короткие лучи порядка длины шага при натягивании пути
+            glm::vec3 to = points[i] + glm::normalize(points[i + 1] - points[i]) * 20.0f;
+            blocked += navMesh->Raycast(points[i], to) ? 1 : 0;
+        }
+    });
+    
+    const size_t rayCount = points.size() / 2;
+    std::cout << "Raycast (20 units): " << (seconds * 1e6 / rayCount) << " us/ray, "
+              << blocked << "/" << rayCount << " blocked" << std::endl;
+    EXPECT_GT(blocked, 0);
+}
+
+TEST_F(NavMeshPerformanceTest, TiledGeneration) {
+    // Карта 1024x1024 - около двух миллионов треугольников
+    const int size = 1024;
+    std::vector<std::vector<float>> rows(size, std::vector<float>(size));
+    std::vector<float> flat(static_cast<size_t>(size) * size);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            float h = 1.0f + std::sin(x * 0.05f) * std::cos(y * 0.04f);
+            rows[y][x] = h;
+            flat[static_cast<size_t>(y) * size + x] = h;
+        }
+    }
+    
+    FastEngine::NavMesh serial;
+    double serialSeconds = MeasureSeconds([&]() {
+        ASSERT_TRUE(serial.GenerateFromHeightmap(rows, 1.0f, 0.3f));
+    });
+    
+    FastEngine::NavMeshGenerator generator;
+    generator.SetCellSize(1.0f);
+    generator.SetHeightThreshold(0.3f);
+    generator.SetAgentRadius(1.0f);
+    generator.SetTileSize(64);
+    
+    std::unique_ptr<FastEngine::NavMesh> tiled;
+    double tiledSeconds = MeasureSeconds([&]() {
+        tiled = generator.GenerateFromHeightmap(FastEngine::HeightmapView(flat.data(), size, size));
+    });
+    ASSERT_TRUE(tiled);
+    EXPECT_EQ(tiled->GetTriangles().size(), serial.GetTriangles().size());
+    
+    // Локальная правка: яма 8x8
+    for (int y = 500; y < 508; ++y) {
+        for (int x = 500; x < 508; ++x) {
+            flat[static_cast<size_t>(y) * size + x] = 0.0f;
+        }
+    }
+    int rebuiltTiles = 0;
+    double rebuildSeconds = MeasureSeconds([&]() {
+        rebuiltTiles = generator.RebuildRegion(*tiled, FastEngine::HeightmapView(flat.data(), size, size),
+                                               500, 500, 507, 507);
+    });
+    EXPECT_FALSE(tiled->IsWalkable(glm::vec3(503.5f, 0.0f, 503.5f)));
+    
+    std::cout << "Heightmap " << size << "x" << size << ": serial (no filters) " << serialSeconds * 1000.0
+              << " ms, tiled on " << generator.GetWorkerCount() << " workers (slope + radius filters) "
+              << tiledSeconds * 1000.0 << " ms, region rebuild (" << rebuiltTiles << " tiles) "
+              << rebuildSeconds * 1000.0 << " ms" << std::endl;
+    EXPECT_GT(rebuiltTiles, 0);
+    EXPECT_LT(tiledSeconds, serialSeconds);
+    EXPECT_LT(rebuildSeconds * 20.0, tiledSeconds);
+}
@@ -0,0 +1,239 @@
+#include <gtest/gtest.h>
+#include <FastEngine/Network/BitStream.h>
+#include <FastEngine/Network/NetworkManager.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace FastEngine;
+
+namespace {
+
+const int OBJECT_COUNT = 5000;
+const int ITERATIONS = 20;
+
+std::vector<NetworkObject> CreateObjects() {
+    std::vector<NetworkObject> objects(OBJECT_COUNT);
+    for (int i = 0; i < OBJECT_COUNT; ++i) {
+        objects[i].SetId("object_" + std::to_string(i));
+        objects[i].SetNetId(static_cast<uint32_t>(i));
+        objects[i].SetOwnerId("server");
+        objects[i].SetPosition(glm::vec3(i * 0.731f - 1500.0f, (i % 17) * 1.37f, i * -0.291f));
+        objects[i].SetRotation(glm::vec3(0.0f, static_cast<float>(i % 360), 0.0f));
+    }
+    return objects;
+}
+
+} // namespace
+
+TEST(NetworkPerformanceTest, BinaryVsJsonObjectUpdate) {
+    std::vector<NetworkObject> objects = CreateObjects();
+    std::vector<NetworkObject> received(OBJECT_COUNT);
+    NetworkObjectSchema schema;
+    const uint32_t updateFields = NETWORK_FIELD_POSITION | NETWORK_FIELD_ROTATION;
+
+    // JSON: строка на обновление
+    std::vector<std::string> json(OBJECT_COUNT);
+    size_t jsonBytes = 0;
+    auto jsonEncodeStart = std::chrono::high_resolution_clock::now();
+    for (int iteration = 0; iteration < ITERATIONS; ++iteration) {
+        jsonBytes = 0;
+        for (int i = 0; i < OBJECT_COUNT; ++i) {
+            json[i] = objects[i].Serialize();
+            jsonBytes += json[i].size();
+        }
+    }
+    auto jsonEncodeEnd = std::chrono::high_resolution_clock::now();
+    for (int iteration = 0; iteration < ITERATIONS; ++iteration) {
+        for (int i = 0; i < OBJECT_COUNT; ++i) {
+            received[i].Deserialize(json[i]);
+        }
+    }
+    auto jsonDecodeEnd = std::chrono::high_resolution_clock::now();
+
+    // Двоичный формат: все обновления в один переиспользуемый буфер
+    std::vector<uint8_t> buffer(OBJECT_COUNT * 32);
+    BitWriter writer(buffer.data(), static_cast<uint32_t>(buffer.size()));
+    auto binaryEncodeStart = std::chrono::high_resolution_clock::now();
+    for (int iteration = 0; iteration < ITERATIONS; ++iteration) {
+        writer.Reset();
+        for (int i = 0; i < OBJECT_COUNT; ++i) {
+            writer.WriteVarUint(objects[i].GetNetId());
+            objects[i].WriteState(writer, schema, updateFields);
+        }
+        writer.Flush();
+    }
+    auto binaryEncodeEnd = std::chrono::high_resolution_clock::now();
+    ASSERT_FALSE(writer.IsOverflow());
+    uint32_t binaryBytes = writer.GetBytesWritten();
+
+    bool decoded = true;
+    for (int iteration = 0; iteration < ITERATIONS; ++iteration) {
+        BitReader reader(buffer.data(), binaryBytes);
+        for (int i = 0; i < OBJECT_COUNT; ++i) {
+            uint32_t netId = 0;
+            decoded &= reader.ReadVarUint(netId) && netId < received.size() &&
+                       received[netId].ReadState(reader, schema);
+        }
+    }
+    auto binaryDecodeEnd = std::chrono::high_resolution_clock::now();
+    ASSERT_TRUE(decoded);
+    for (int i = 0; i < OBJECT_COUNT; i += 101) {
+        EXPECT_NEAR(received[i].GetPosition().x, objects[i].GetPosition().x, schema.position.precision);
+        EXPECT_NEAR(received[i].GetRotation().y, objects[i].GetRotation().y, schema.rotation.precision);
+    }
+
+    auto nsPerObject = [](std::chrono::high_resolution_clock::time_point start,
+                          std::chrono::high_resolution_clock::time_point end) {
+        return std::chrono::duration<double, std::nano>(end - start).count() / (ITERATIONS * OBJECT_COUNT);
+    };
+    double jsonPerUpdate = static_cast<double>(jsonBytes) / OBJECT_COUNT;
+    double binaryPerUpdate = static_cast<double>(binaryBytes) / OBJECT_COUNT;
+    double jsonEncodeNs = nsPerObject(jsonEncodeStart, jsonEncodeEnd);
+    double jsonDecodeNs = nsPerObject(jsonEncodeEnd, jsonDecodeEnd);
+    double binaryEncodeNs = nsPerObject(binaryEncodeStart, binaryEncodeEnd);
+    double binaryDecodeNs = nsPerObject(binaryEncodeEnd, binaryDecodeEnd);
+
+    std::cout << "Object update, JSON: " << jsonPerUpdate << " bytes, encode " << jsonEncodeNs
+              << " ns, decode " << jsonDecodeNs << " ns" << std::endl;
+    std::cout << "Object update, binary: " << binaryPerUpdate << " bytes, encode " << binaryEncodeNs
+              << " ns, decode " << binaryDecodeNs << " ns" << std::endl;
+
+    EXPECT_LT(binaryPerUpdate * 5.0, jsonPerUpdate);
+    EXPECT_LT(binaryEncodeNs, jsonEncodeNs);
+    EXPECT_LT(binaryDecodeNs, jsonDecodeNs);
+}
+
+TEST(NetworkPerformanceTest, MessageEncodeDecode) {
+    const int MESSAGE_COUNT = 100000;
+    NetworkMessage message(NetworkMessageType::PlayerUpdate, std::string(48, 'x'), "player_12");
+    uint8_t buffer[MAX_PACKET_SIZE];
+
+    uint32_t size = 0;
+    auto encodeStart = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < MESSAGE_COUNT; ++i) {
+        BitWriter writer(buffer, sizeof(buffer));
+        message.sequence = static_cast<uint32_t>(i);
+        message.Write(writer);
+        size = writer.GetBytesWritten();
+    }
+    auto encodeEnd = std::chrono::high_resolution_clock::now();
+
+    // Одно сообщение на весь цикл: строки переиспользуют емкость
+    NetworkMessage decoded;
+    bool valid = true;
+    for (int i = 0; i < MESSAGE_COUNT; ++i) {
+        BitReader reader(buffer, size);
+        valid &= decoded.Read(reader);
+    }
+    auto decodeEnd = std::chrono::high_resolution_clock::now();
+    ASSERT_TRUE(valid);
+    EXPECT_EQ(decoded.data, message.data);
+
+    double encodeNs = std::chrono::duration<double, std::nano>(encodeEnd - encodeStart).count() / MESSAGE_COUNT;
+    double decodeNs = std::chrono::duration<double, std::nano>(decodeEnd - encodeEnd).count() / MESSAGE_COUNT;
+    std::cout << "Message (" << message.data.size() << " bytes payload): " << size << " bytes, encode "
+              << encodeNs << " ns, decode " << decodeNs << " ns" << std::endl;
+    EXPECT_LT(size, message.data.size() + message.senderId.size() + 10);
+}
+
+TEST(NetworkPerformanceTest, SnapshotReplication) {
+    const int CLIENT_COUNT = 64;
+    const int SNAPSHOT_COUNT = 100;
+    const float WORLD_SIZE = 2000.0f;
+
+    ObjectReplicator server;
+    server.SetMaxReplicationDistance(150.0f);
+    server.SetBandwidthBudget(32768.0f);
+
+    // Пакеты доставляются клиентам после снимка, подтверждения - серверу
+    struct Datagram {
+        int client;
+        std::vector<uint8_t> data;
+    };
+    std::vector<Datagram> toClients;
+    std::vector<Datagram> toServer;
+    std::vector<std::unique_ptr<ObjectReplicator>> clients;
+    std::vector<std::string> clientIds;
+    server.SetSendCallback([&](const std::string& target, const uint8_t* data, uint32_t size) {
+        toClients.push_back(Datagram{std::stoi(target.substr(7)), std::vector<uint8_t>(data, data + size)});
+    });
+    for (int i = 0; i < CLIENT_COUNT; ++i) {
+        clientIds.push_back("client_" + std::to_string(i));
+        server.AddClient(clientIds.back());
+        clients.emplace_back(new ObjectReplicator());
+        clients.back()->SetSendCallback([&toServer, i](const std::string&, const uint8_t* data, uint32_t size) {
+            toServer.push_back(Datagram{i, std::vector<uint8_t>(data, data + size)});
+        });
+    }
+
+    uint32_t random = 1;
+    auto nextRandom = [&random]() {
+        random = random * 1664525u + 1013904223u;
+        return (random >> 8) * (1.0f / 16777216.0f);
+    };
+    std::vector<std::shared_ptr<NetworkObject>> objects;
+    for (int i = 0; i < OBJECT_COUNT; ++i) {
+        auto object = std::make_shared<NetworkObject>();
+        object->SetId("object_" + std::to_string(i));
+        object->SetPosition(glm::vec3(nextRandom() * WORLD_SIZE - WORLD_SIZE * 0.5f, 0.0f,
+                                      nextRandom() * WORLD_SIZE - WORLD_SIZE * 0.5f));
+        objects.push_back(object);
+        server.StartReplicating(object);
+    }
+    std::vector<glm::vec3> viewpoints(CLIENT_COUNT);
+    for (int i = 0; i < CLIENT_COUNT; ++i) {
+        viewpoints[i] = objects[i * 37]->GetPosition();
+    }
+
+    double serverMs = 0.0;
+    double maxServerMs = 0.0;
+    double bytesPerClient = 0.0;
+    double objectsPerClient = 0.0;
+    double candidatesPerClient = 0.0;
+    for (int snapshot = 0; snapshot < SNAPSHOT_COUNT; ++snapshot) {
+        // Треть объектов движется, игроки перемещаются
+        for (int i = snapshot % 3; i < OBJECT_COUNT; i += 3) {
+            objects[i]->SetPosition(objects[i]->GetPosition() +
+                                    glm::vec3(nextRandom() - 0.5f, 0.0f, nextRandom() - 0.5f));
+        }
+        for (int i = 0; i < CLIENT_COUNT; ++i) {
+            viewpoints[i] += glm::vec3(1.0f, 0.0f, 0.5f);
+            server.SetClientViewpoint(clientIds[i], viewpoints[i]);
+        }
+
+        server.UpdateReplication(1.0f / 20.0f);
+        if (snapshot >= 10) { // Без начальной рассылки полных состояний
+            serverMs += server.GetLastUpdateTime();
+            maxServerMs = std::max(maxServerMs, server.GetLastUpdateTime());
+            bytesPerClient += static_cast<double>(server.GetLastBytesSent()) / CLIENT_COUNT;
+            objectsPerClient += static_cast<double>(server.GetLastObjectsSent()) / CLIENT_COUNT;
+            candidatesPerClient += static_cast<double>(server.GetLastCandidates()) / CLIENT_COUNT;
+        }
+
+        for (const Datagram& datagram : toClients) {
+            clients[datagram.client]->HandlePayload("server", datagram.data.data(),
+                                                    static_cast<uint32_t>(datagram.data.size()));
+        }
+        toClients.clear();
+        for (const Datagram& datagram : toServer) {
+            server.HandlePayload(clientIds[datagram.client], datagram.data.data(),
+                                 static_cast<uint32_t>(datagram.data.size()));
+        }
+        toServer.clear();
+    }
+
+    const int measured = SNAPSHOT_COUNT - 10;
+    serverMs /= measured;
+    std::cout << CLIENT_COUNT << " clients x " << OBJECT_COUNT << " objects: " << serverMs << " ms per snapshot (max "
+              << maxServerMs << " ms), per client " << bytesPerClient / measured << " bytes, "
+              << objectsPerClient / measured << " objects of " << candidatesPerClient / measured
+              << " candidates" << std::endl;
+
+    // Снимок 20 раз в секунду укладывается в малую долю одного ядра
+    EXPECT_LT(serverMs, 10.0);
+    EXPECT_GT(objectsPerClient, 0.0);
+}
@@ -0,0 +1,244 @@
+#include <gtest/gtest.h>
+#include <FastEngine/AI/NavMesh.h>
+#include <FastEngine/AI/Pathfinding.h>
+#include <FastEngine/AI/HierarchicalPathfinding.h>
+#include <FastEngine/Jobs/JobSystem.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+// Прежняя реализация A* (хэш-контейнеры на каждый запрос, линейный поиск
+// стартового и конечного узла, std::function-эвристика). Используется как
+// базовая линия для сравнения.
+struct LegacyNode {
+    int nodeIndex;
+    float fCost;
+    bool operator>(const LegacyNode& other) const { return fCost > other.fCost; }
+};
+
+float LegacyFindPath(const FastEngine::NavMesh& navMesh, const glm::vec3& start, const glm::vec3& end,
+                     const std::function<float(const glm::vec3&, const glm::vec3&)>& heuristic) {
+    const auto& nodes = navMesh.GetNodes();
+    
+    int startNode = -1;
+    int endNode = -1;
+    float minStartDist = std::numeric_limits<float>::max();
+    float minEndDist = std::numeric_limits<float>::max();
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (!nodes[i].walkable) continue;
+        float startDist = glm::distance(start, nodes[i].position);
+        float endDist = glm::distance(end, nodes[i].position);
+        if (startDist < minStartDist) { minStartDist = startDist; startNode = static_cast<int>(i); }
+        if (endDist < minEndDist) { minEndDist = endDist; endNode = static_cast<int>(i); }
+    }
+    if (startNode == -1 || endNode == -1) return -1.0f;
+    if (startNode == endNode) return 0.0f;
+    
+    // Списки смежности в прежнем виде: отдельный вектор на каждый узел
+    std::priority_queue<LegacyNode, std::vector<LegacyNode>, std::greater<LegacyNode>> openSet;
+    std::unordered_set<int> closedSet;
+    std::unordered_map<int, int> cameFrom;
+    std::unordered_map<int, float> gScore;
+    std::unordered_map<int, float> fScore;
+    
+    gScore[startNode] = 0.0f;
+    fScore[startNode] = heuristic(nodes[startNode].position, nodes[endNode].position);
+    openSet.push({startNode, fScore[startNode]});
+    
+    while (!openSet.empty()) {
+        LegacyNode current = openSet.top();
+        openSet.pop();
+        if (current.nodeIndex == endNode) {
+            return gScore[endNode];
+        }
+        closedSet.insert(current.nodeIndex);
+        
+        for (int neighbor : navMesh.GetNeighbors(current.nodeIndex)) {
+            if (closedSet.find(neighbor) != closedSet.end() || !nodes[neighbor].walkable) continue;
+            
+            float tentative = gScore[current.nodeIndex] +
+                glm::distance(nodes[current.nodeIndex].position, nodes[neighbor].position) * nodes[neighbor].cost;
+            if (gScore.find(neighbor) == gScore.end() || tentative < gScore[neighbor]) {
+                cameFrom[neighbor] = current.nodeIndex;
+                gScore[neighbor] = tentative;
+                fScore[neighbor] = tentative + heuristic(nodes[neighbor].position, nodes[endNode].position);
+                openSet.push({neighbor, fScore[neighbor]});
+            }
+        }
+    }
+    return -1.0f;
+}
+
+} // namespace
+
+class PathfindingPerformanceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Холмистая карта 256x256 с непроходимыми впадинами
+        const int size = 256;
+        std::vector<std::vector<float>> heightmap(size, std::vector<float>(size));
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                heightmap[y][x] = 1.0f + std::sin(x * 0.15f) * std::cos(y * 0.11f);
+            }
+        }
+        
+        navMesh = std::make_unique<FastEngine::NavMesh>();
+        ASSERT_TRUE(navMesh->GenerateFromHeightmap(heightmap, 1.0f, 0.2f));
+        
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> coord(0.0f, static_cast<float>(size - 1));
+        for (int i = 0; i < queryCount; ++i) {
+            queries.emplace_back(glm::vec3(coord(rng), 1.0f, coord(rng)),
+                                 glm::vec3(coord(rng), 1.0f, coord(rng)));
+        }
+    }
+    
+    static constexpr int queryCount = 200;
+    std::unique_ptr<FastEngine::NavMesh> navMesh;
+    std::vector<std::pair<glm::vec3, glm::vec3>> queries;
+};
+
+TEST_F(PathfindingPerformanceTest, QueriesPerSecondVsLegacy) {
+    FastEngine::AStarPathfinding pathfinder;
+    pathfinder.SetSmoothing(false);
+    pathfinder.SetMaxIterations(std::numeric_limits<int>::max());
+    
+    std::function<float(const glm::vec3&, const glm::vec3&)> legacyHeuristic =
+        [](const glm::vec3& a, const glm::vec3& b) { return glm::distance(a, b); };
+    
+    std::vector<float> legacyCosts;
+    auto legacyStart = std::chrono::high_resolution_clock::now();
+    for (const auto& query : queries) {
+        legacyCosts.push_back(LegacyFindPath(*navMesh, query.first, query.second, legacyHeuristic));
+    }
+    auto legacyEnd = std::chrono::high_resolution_clock::now();
+    
+    std::vector<float> costs;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const auto& query : queries) {
+        FastEngine::PathfindingResult result = pathfinder.FindPath(*navMesh, query.first, query.second);
+        costs.push_back(result.success ? result.totalCost : -1.0f);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    
+    for (size_t i = 0; i < queries.size(); ++i) {
+        EXPECT_NEAR(costs[i], legacyCosts[i], 1e-2f) << "query " << i;
+    }
+    
+    double legacySeconds = std::chrono::duration<double>(legacyEnd - legacyStart).count();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double legacyQps = queryCount / legacySeconds;
+    double qps = queryCount / seconds;
+    
+    std::cout << "A* on " << navMesh->GetNodeCount() << " nodes: legacy " << legacyQps
+              << " q/s, flat " << qps << " q/s (x" << (qps / legacyQps) << ")" << std::endl;
+    
+    EXPECT_GT(qps, legacyQps);
+}
+
+TEST_F(PathfindingPerformanceTest, HierarchicalVsFlat) {
+    FastEngine::AStarPathfinding pathfinder;
+    pathfinder.SetSmoothing(false);
+    pathfinder.SetMaxIterations(std::numeric_limits<int>::max());
+    
+    FastEngine::HierarchicalPathfinder hierarchical;
+    hierarchical.SetSmoothing(false);
+    hierarchical.SetCacheCapacity(queryCount);
+    
+    auto snapshot = std::make_shared<const FastEngine::NavMesh>(*navMesh);
+    auto buildStart = std::chrono::high_resolution_clock::now();
+    ASSERT_TRUE(hierarchical.Build(snapshot));
+    auto buildEnd = std::chrono::high_resolution_clock::now();
+    
+    auto measure = [this](const std::function<FastEngine::PathfindingResult(const glm::vec3&, const glm::vec3&)>& find,
+                          std::vector<float>& costs) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const auto& query : queries) {
+            FastEngine::PathfindingResult result = find(query.first, query.second);
+            costs.push_back(result.success ? result.totalCost : -1.0f);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count() / queryCount;
+    };
+    
+    std::vector<float> flatCosts;
+    std::vector<float> coldCosts;
+    std::vector<float> cachedCosts;
+    double flatMs = measure([&](const glm::vec3& a, const glm::vec3& b) { return pathfinder.FindPath(*navMesh, a, b); }, flatCosts);
+    double coldMs = measure([&](const glm::vec3& a, const glm::vec3& b) { return hierarchical.FindPath(a, b); }, coldCosts);
+    double cachedMs = measure([&](const glm::vec3& a, const glm::vec3& b) { return hierarchical.FindPath(a, b); }, cachedCosts);
+    
+    double overhead = 0.0;
+    int found = 0;
+    for (size_t i = 0; i < queries.size(); ++i) {
+        ASSERT_EQ(coldCosts[i] >= 0.0f, flatCosts[i] >= 0.0f) << "query " << i;
+        EXPECT_FLOAT_EQ(cachedCosts[i], coldCosts[i]);
+        if (flatCosts[i] > 0.0f) {
+            overhead += coldCosts[i] / flatCosts[i];
+            ++found;
+        }
+    }
+    
+    std::cout << "HPA* on " << navMesh->GetNodeCount() << " nodes (" << hierarchical.GetClusterCount()
+              << " clusters, " << hierarchical.GetPortalCount() << " portals, build "
+              << std::chrono::duration<double, std::milli>(buildEnd - buildStart).count() << " ms): A* "
+              << flatMs << " ms/query, HPA* cold " << coldMs << " ms/query, cached " << cachedMs
+              << " ms/query, mean cost x" << (found > 0 ? overhead / found : 0.0) << std::endl;
+    
+    EXPECT_EQ(hierarchical.GetCacheHits(), found);
+    EXPECT_LT(coldMs, flatMs);
+    EXPECT_LT(cachedMs, coldMs);
+}
+
+TEST_F(PathfindingPerformanceTest, BatchedRequestsThroughput) {
+    // 2000 юнитов перезапрашивают путь одновременно
+    const int unitCount = 2000;
+    
+    // Поиски выполняются заданиями общего планировщика
+    FastEngine::JobSystem& jobs = FastEngine::JobSystem::GetInstance();
+    jobs.Start();
+    FastEngine::PathfindingManager manager;
+    ASSERT_TRUE(manager.Initialize());
+    manager.SetMaxIterations(std::numeric_limits<int>::max());
+    manager.SetMaxDispatchPerFrame(unitCount);
+    manager.AddNavMesh("terrain", std::move(navMesh));
+    
+    int delivered = 0;
+    auto callback = [&delivered](FastEngine::PathRequestId, const FastEngine::PathfindingResult&) { ++delivered; };
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < unitCount; ++i) {
+        const auto& query = queries[i % queries.size()];
+        manager.RequestPath("terrain", query.first, query.second, callback);
+    }
+    
+    double worstUpdateMs = 0.0;
+    while (manager.GetPendingRequestCount() > 0) {
+        auto updateStart = std::chrono::high_resolution_clock::now();
+        manager.Update();
+        auto updateEnd = std::chrono::high_resolution_clock::now();
+        worstUpdateMs = std::max(worstUpdateMs, std::chrono::duration<double, std::milli>(updateEnd - updateStart).count());
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << unitCount << " requests (" << manager.GetDeduplicatedRequests() << " deduplicated) on "
+              << jobs.GetWorkerCount() << " job workers: " << (unitCount / seconds)
+              << " q/s, worst Update " << worstUpdateMs << " ms" << std::endl;
+    
+    EXPECT_EQ(delivered, unitCount);
+    manager.Shutdown();
+    jobs.Stop();
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <FastEngine/Profiling/PerformanceProfiler.h>
+#include <FastEngine/Profiling/QuantileSketch.h>
+#include <FastEngine/Profiling/ScopeProfiler.h>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace FastEngine;
+
+namespace {
+
+const int SCOPES = 400000;
+
+double NanosecondsPerScope(std::chrono::high_resolution_clock::time_point start, int scopes) {
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / scopes;
+}
+
+} // namespace
+
+TEST(ProfilerPerformanceTest, ScopeOverhead) {
+    ScopeProfiler& profiler = ScopeProfiler::GetInstance();
+    const size_t capacity = profiler.GetThreadCapacity();
+    profiler.SetThreadCapacity(static_cast<size_t>(1) << 20);
+    profiler.Start();
+    profiler.ResetStats();
+    // Агрегатор не просыпается во время замера: новый поток получает
+    // буфер на 1M событий, разбор - в Flush после замера
+    profiler.SetAggregationInterval(std::chrono::milliseconds(10000));
+    profiler.Flush();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    double scopeNs = 0.0;
+    double disabledNs = 0.0;
+    std::thread thread([&]() {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < SCOPES; ++i) {
+            FASTENGINE_PROFILE_SCOPE("perf.scope");
+        }
+        scopeNs = NanosecondsPerScope(start, SCOPES);
+    });
+    thread.join();
+    profiler.Flush();
+    profiler.SetAggregationInterval(std::chrono::milliseconds(2));
+    EXPECT_EQ(profiler.GetStats(ProfileNames::Find("perf.scope")).calls, static_cast<uint64_t>(SCOPES));
+    uint64_t dropped = profiler.GetDroppedEvents();
+
+    profiler.Stop();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < SCOPES; ++i) {
+        FASTENGINE_PROFILE_SCOPE("perf.disabled");
+    }
+    disabledNs = NanosecondsPerScope(start, SCOPES);
+    profiler.SetThreadCapacity(capacity);
+
+    std::cout << "Scope profiler: " << scopeNs << " ns per scope (Begin + End), "
+              << disabledNs << " ns when disabled, dropped " << dropped << " events" << std::endl;
+
+    // На железе с быстрым TSC - около 20 нс; с запасом на виртуальные машины
+    EXPECT_LT(scopeNs, 150.0);
+    EXPECT_LT(disabledNs, 10.0);
+}
+
+TEST(ProfilerPerformanceTest, LegacyStringSamples) {
+    CPUProfiler cpu;
+    cpu.StartProfiling();
+    const ProfileNameId id = ProfileNames::Register("perf.cpu");
+    const int samples = SCOPES / 4;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < samples; ++i) {
+        cpu.BeginSample("perf.cpu");
+        cpu.EndSample("perf.cpu");
+    }
+    double stringNs = NanosecondsPerScope(start, samples);
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < samples; ++i) {
+        cpu.BeginSample(id);
+        cpu.EndSample();
+    }
+    double idNs = NanosecondsPerScope(start, samples);
+    cpu.StopProfiling();
+
+    std::cout << "CPUProfiler samples: " << stringNs << " ns by name, " << idNs << " ns by id" << std::endl;
+    EXPECT_LT(idNs, stringNs);
+}
+
+TEST(ProfilerPerformanceTest, QuantileSketchUpdateAndQuery) {
+    std::mt19937 random(3);
+    std::lognormal_distribution<double> frameTimes(std::log(8.0), 0.3);
+    std::vector<double> values(SCOPES);
+    for (double& value : values) {
+        value = frameTimes(random);
+    }
+
+    QuantileSketch sketch;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (double value : values) {
+        sketch.Add(value);
+    }
+    double addNs = NanosecondsPerScope(start, SCOPES);
+
+    // Запрос не зависит от числа значений - дашборд опрашивает каждый кадр
+    const int queries = 100000;
+    volatile double sink = 0.0;
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < queries; ++i) {
+        sink = sink + sketch.GetQuantile(0.5 + 0.49 * (i & 1));
+    }
+    double queryNs = NanosecondsPerScope(start, queries);
+
+    std::cout << "QuantileSketch: " << addNs << " ns per Add, " << queryNs << " ns per percentile query, "
+              << sizeof(QuantileSketch) << " bytes" << std::endl;
+    EXPECT_LT(addNs, 50.0);
+    EXPECT_LT(queryNs, 1000.0);
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <FastEngine/Animation/BlendTree.h>
+#include <FastEngine/Animation/SkeletalClip.h>
+#include <FastEngine/Components/SkeletalAnimator.h>
+#include <FastEngine/Entity.h>
+#include <FastEngine/Systems/SkeletalAnimationSystem.h>
+#include <FastEngine/World.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace FastEngine;
+
+namespace {
+
+const uint32_t BONES = 64;
+const int CHARACTERS = 200;
+const int FRAMES = 60;
+const float FRAME_TIME = 1.0f / 60.0f;
+
+glm::vec4 AxisAngle(glm::vec3 axis, float angle) {
+    axis = glm::normalize(axis);
+    float s = std::sin(angle * 0.5f);
+    return glm::vec4(axis.x * s, axis.y * s, axis.z * s, std::cos(angle * 0.5f));
+}
+
+// Скелет-дерево: позвоночник и ветви по четыре кости
+std::shared_ptr<Skeleton> MakeSkeleton() {
+    auto skeleton = std::make_shared<Skeleton>();
+    for (uint32_t i = 0; i < BONES; ++i) {
+        int parent = i == 0 ? Skeleton::NO_PARENT : (i % 4 == 0 ? static_cast<int>(i) - 4 : static_cast<int>(i) - 1);
+        skeleton->AddBone("bone" + std::to_string(i), parent,
+                          BoneTransform(glm::vec3(0.0f, 0.2f, 0.0f), AxisAngle(glm::vec3(0, 0, 1), 0.05f * (i % 4))));
+    }
+    return skeleton;
+}
+
+std::shared_ptr<const SkeletalClip> MakeClip(const std::string& name, float frequency) {
+    RawSkeletalClip raw;
+    raw.name = name;
+    raw.boneCount = BONES;
+    for (int frame = 0; frame < 60; ++frame) {
+        float t = frame / raw.sampleRate;
+        for (uint32_t bone = 0; bone < BONES; ++bone) {
+            float phase = frequency * t + 0.1f * bone;
+            raw.frames.push_back(BoneTransform(glm::vec3(0.0f, 0.2f, 0.02f * std::sin(phase)),
+                                               AxisAngle(glm::vec3(1.0f, 0.5f, bone % 3), 0.4f * std::sin(phase))));
+        }
+    }
+    return SkeletalClip::Compress(raw);
+}
+
+std::shared_ptr<SkinnedMeshData> MakeMesh(uint32_t vertices) {
+    auto mesh = std::make_shared<SkinnedMeshData>();
+    for (uint32_t v = 0; v < vertices; ++v) {
+        mesh->positions.push_back(glm::vec3(0.01f * v, 0.2f * (v % BONES), 0.0f));
+        mesh->normals.push_back(glm::vec3(0.0f, 0.0f, 1.0f));
+        uint16_t indices[4] = {static_cast<uint16_t>(v % BONES), static_cast<uint16_t>((v + 1) % BONES),
+                               static_cast<uint16_t>((v + 7) % BONES), 0};
+        float weights[4] = {0.6f, 0.3f, 0.1f, 0.0f};
+        mesh->boneIndices.insert(mesh->boneIndices.end(), indices, indices + 4);
+        mesh->boneWeights.insert(mesh->boneWeights.end(), weights, weights + 4);
+    }
+    return mesh;
+}
+
+double RunFrames(SkeletalAnimationSystem* system) {
+    system->Update(FRAME_TIME);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        system->Update(FRAME_TIME);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / FRAMES;
+}
+
+} // namespace
+
+TEST(SkeletalAnimationPerformanceTest, BonesPerMillisecond) {
+    auto skeleton = MakeSkeleton();
+    auto walk = MakeClip("perf_walk", 6.0f);
+    auto run = MakeClip("perf_run", 11.0f);
+    ASSERT_TRUE(walk && run);
+    std::cout << "Clip compression: " << walk->GetRawSize() << " -> " << walk->GetCompressedSize()
+              << " bytes, " << walk->GetKeyCount() << " keys" << std::endl;
+
+    auto tree = std::make_shared<BlendTree>();
+    uint32_t speed = tree->AddParameter("speed");
+    tree->AddBlend(tree->AddClip(walk), tree->AddClip(run), speed);
+
+    World world;
+    SkeletalAnimationSystem* system = world.AddSystem<SkeletalAnimationSystem>(&world);
+    for (int i = 0; i < CHARACTERS; ++i) {
+        SkeletalAnimator* animator = world.CreateEntity()->AddComponent<SkeletalAnimator>(skeleton);
+        animator->SetBlendTree(tree);
+        animator->SetParameter(speed, (i % 10) / 9.0f);
+        animator->SetTime(0.01f * i);
+    }
+
+    // Один поток: кости в миллисекунду на ядро
+    double serialMs = RunFrames(system);
+    double bones = static_cast<double>(CHARACTERS) * BONES;
+    std::cout << "Skeletal animation, " << CHARACTERS << " x " << BONES << " bones, 2-clip blend: "
+              << serialMs << " ms per frame, " << bones / serialMs << " bones/ms/core" << std::endl;
+    EXPECT_EQ(system->GetStats().bones, static_cast<uint32_t>(CHARACTERS * BONES));
+
+    uint32_t workers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+    if (workers > 0) {
+        system->SetWorkerCount(workers);
+        double parallelMs = RunFrames(system);
+        std::cout << "  with " << workers << " workers: " << parallelMs << " ms per frame, "
+                  << bones / parallelMs << " bones/ms" << std::endl;
+    }
+
+    // Бюджет: 12.8k костей со смешиванием - не больше 4 мс кадра на одном ядре
+    EXPECT_LT(serialMs, 4.0);
+}
+
+TEST(SkeletalAnimationPerformanceTest, CpuSkinning) {
+    auto skeleton = MakeSkeleton();
+    auto walk = MakeClip("perf_skin_walk", 6.0f);
+    auto mesh = MakeMesh(5000);
+
+    World world;
+    SkeletalAnimationSystem* system = world.AddSystem<SkeletalAnimationSystem>(&world);
+    const int characters = 20;
+    for (int i = 0; i < characters; ++i) {
+        SkeletalAnimator* animator = world.CreateEntity()->AddComponent<SkeletalAnimator>(skeleton);
+        animator->Play(walk);
+        animator->SetSkinnedMesh(mesh);
+        animator->SetCpuSkinning(true);
+    }
+
+    double ms = RunFrames(system);
+    double vertices = static_cast<double>(characters) * mesh->GetVertexCount();
+    std::cout << "CPU skinning, " << characters << " x " << mesh->GetVertexCount() << " vertices: " << ms
+              << " ms per frame, " << vertices / ms << " vertices/ms" << std::endl;
+    EXPECT_EQ(system->GetStats().skinnedVertices, static_cast<uint32_t>(vertices));
+}
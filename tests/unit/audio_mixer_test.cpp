@@ -0,0 +1,390 @@
+#include <gtest/gtest.h>
+#include "FastEngine/Audio/AudioManager.h"
+#include "FastEngine/Audio/AudioMixer.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+using namespace FastEngine;
+
+namespace {
+
+const uint32_t RATE = 48000;
+const uint32_t BLOCK = 256;
+
+AudioClipPtr MakeConstantClip(float value, uint32_t frames, uint32_t channels = 1) {
+    return AudioClip::Create(std::vector<float>(frames * channels, value), channels, RATE);
+}
+
+// Отсчет i равен i / frames: линейная интерполяция на нем точна
+AudioClipPtr MakeRampClip(uint32_t frames, uint32_t sampleRate = RATE) {
+    std::vector<float> samples(frames);
+    for (uint32_t i = 0; i < frames; ++i) {
+        samples[i] = static_cast<float>(i) / frames;
+    }
+    return AudioClip::Create(std::move(samples), 1, sampleRate);
+}
+
+AudioMixerConfig MakeConfig(uint32_t maxVoices = 16) {
+    AudioMixerConfig config;
+    config.sampleRate = RATE;
+    config.blockFrames = BLOCK;
+    config.maxVoices = maxVoices;
+    return config;
+}
+
+} // namespace
+
+TEST(AudioMixerTest, AppliesVolumeAndPanWithRamp) {
+    AudioMixer mixer(MakeConfig());
+    VoiceParams params;
+    params.volume = 0.8f;
+    params.pan = -1.0f;
+    mixer.Play(MakeConstantClip(0.5f, RATE), params);
+
+    std::vector<float> output(BLOCK * 2 * 2);
+    mixer.Render(output.data(), BLOCK * 2);
+    EXPECT_EQ(mixer.GetActiveVoiceCount(), 1u);
+
+    // Первый блок нарастает с нуля, дальше усиление постоянно
+    EXPECT_FLOAT_EQ(output[0], 0.0f);
+    EXPECT_NEAR(output[(BLOCK / 2) * 2], 0.2f, 1e-3f);
+    for (uint32_t i = BLOCK; i < BLOCK * 2; ++i) {
+        EXPECT_NEAR(output[i * 2], 0.4f, 1e-5f);
+        EXPECT_NEAR(output[i * 2 + 1], 0.0f, 1e-5f);
+    }
+
+    // Стерео клип в центре не ослабляется, панорама работает как баланс
+    AudioMixer stereo(MakeConfig());
+    params.volume = 1.0f;
+    params.pan = 0.5f;
+    stereo.Play(MakeConstantClip(0.5f, RATE, 2), params);
+    stereo.Render(output.data(), BLOCK * 2);
+    EXPECT_NEAR(output[BLOCK * 3], 0.25f, 1e-5f);
+    EXPECT_NEAR(output[BLOCK * 3 + 1], 0.5f, 1e-5f);
+}
+
+TEST(AudioMixerTest, ResamplesByPitchAndClipRate) {
+    const float centerGain = std::sqrt(0.5f);
+    const uint32_t length = RATE;
+
+    struct Case {
+        float pitch;
+        uint32_t clipRate;
+        float speed;
+    };
+    const Case cases[] = { { 0.5f, RATE, 0.5f }, { 2.0f, RATE, 2.0f }, { 1.0f, RATE / 2, 0.5f }, { 1.3f, RATE, 1.3f } };
+    for (const Case& test : cases) {
+        AudioMixer mixer(MakeConfig());
+        VoiceParams params;
+        params.pitch = test.pitch;
+        mixer.Play(MakeRampClip(length, test.clipRate), params);
+
+        std::vector<float> output(BLOCK * 4 * 2);
+        mixer.Render(output.data(), BLOCK * 4);
+        for (uint32_t i = BLOCK; i < BLOCK * 4; ++i) {
+            float expected = static_cast<float>(i) * test.speed / length * centerGain;
+            ASSERT_NEAR(output[i * 2], expected, 2e-5f) << "pitch " << test.pitch << " frame " << i;
+            ASSERT_NEAR(output[i * 2 + 1], expected, 2e-5f);
+        }
+    }
+}
+
+TEST(AudioMixerTest, FinishesOneShotsAndLoopsSeamlessly) {
+    AudioMixer mixer(MakeConfig());
+    VoiceHandle oneShot = mixer.Play(MakeConstantClip(0.25f, 100));
+    VoiceParams loopParams;
+    loopParams.looping = true;
+    loopParams.pan = 1.0f;
+    VoiceHandle loop = mixer.Play(MakeConstantClip(0.5f, 100), loopParams);
+    EXPECT_TRUE(mixer.IsPlaying(oneShot));
+    EXPECT_EQ(mixer.Play(nullptr), INVALID_VOICE);
+
+    std::vector<float> output(BLOCK * 2 * 4);
+    mixer.Render(output.data(), BLOCK * 4);
+    mixer.Update();
+    EXPECT_FALSE(mixer.IsPlaying(oneShot));
+    EXPECT_TRUE(mixer.IsPlaying(loop));
+    EXPECT_EQ(mixer.GetActiveVoiceCount(), 1u);
+
+    // Короткая петля без разрывов на стыках
+    for (uint32_t i = BLOCK; i < BLOCK * 4; ++i) {
+        ASSERT_NEAR(output[i * 2 + 1], 0.5f, 1e-5f) << i;
+        ASSERT_NEAR(output[i * 2], 0.0f, 1e-5f) << i;
+    }
+}
+
+TEST(AudioMixerTest, StopFadesOutWithinOneBlock) {
+    AudioMixer mixer(MakeConfig());
+    VoiceParams params;
+    params.pan = -1.0f;
+    params.looping = true;
+    VoiceHandle voice = mixer.Play(MakeConstantClip(1.0f, 1000), params);
+
+    std::vector<float> output(BLOCK * 2);
+    mixer.Render(output.data(), BLOCK);
+    mixer.Render(output.data(), BLOCK);
+    EXPECT_NEAR(output[0], 1.0f, 1e-5f);
+
+    mixer.StopVoice(voice);
+    mixer.Render(output.data(), BLOCK);
+    EXPECT_NEAR(output[0], 1.0f, 1e-5f);
+    EXPECT_LT(output[(BLOCK - 1) * 2], 0.01f);
+    for (uint32_t i = 1; i < BLOCK; ++i) {
+        ASSERT_LE(output[i * 2], output[(i - 1) * 2]);
+    }
+    mixer.Update();
+    EXPECT_FALSE(mixer.IsPlaying(voice));
+    EXPECT_EQ(mixer.GetActiveVoiceCount(), 0u);
+}
+
+TEST(AudioMixerTest, PauseHoldsPosition) {
+    AudioMixer mixer(MakeConfig());
+    VoiceParams params;
+    params.pan = -1.0f;
+    VoiceHandle voice = mixer.Play(MakeRampClip(RATE), params);
+
+    std::vector<float> output(BLOCK * 2);
+    mixer.Render(output.data(), BLOCK);
+    mixer.SetVoicePaused(voice, true);
+    mixer.Render(output.data(), BLOCK); // Затухание
+    mixer.Render(output.data(), BLOCK);
+    EXPECT_FLOAT_EQ(output[0], 0.0f);
+    EXPECT_FLOAT_EQ(output[(BLOCK - 1) * 2], 0.0f);
+    EXPECT_EQ(mixer.GetActiveVoiceCount(), 1u);
+
+    // После паузы воспроизведение продолжается с позиции 2 * BLOCK
+    mixer.SetVoicePaused(voice, false);
+    mixer.Render(output.data(), BLOCK);
+    mixer.Render(output.data(), BLOCK);
+    EXPECT_NEAR(output[0], static_cast<float>(BLOCK * 3) / RATE, 1e-5f);
+    EXPECT_TRUE(mixer.IsPlaying(voice));
+}
+
+TEST(AudioMixerTest, StartsFromGivenFrame) {
+    AudioMixer mixer(MakeConfig());
+    VoiceParams params;
+    params.pan = -1.0f;
+    params.startFrame = RATE / 2;
+    mixer.Play(MakeRampClip(RATE), params);
+
+    // Петля берет начальный кадр по модулю длины
+    AudioMixer looping(MakeConfig());
+    params.looping = true;
+    params.startFrame = RATE + 100;
+    looping.Play(MakeRampClip(RATE), params);
+
+    // За концом клипа голос без петли сразу завершается
+    params.looping = false;
+    params.startFrame = RATE;
+    VoiceHandle past = mixer.Play(MakeRampClip(RATE), params);
+
+    std::vector<float> output(BLOCK * 2);
+    mixer.Render(output.data(), BLOCK);
+    mixer.Render(output.data(), BLOCK);
+    EXPECT_NEAR(output[0], static_cast<float>(RATE / 2 + BLOCK) / RATE, 1e-5f);
+    looping.Render(output.data(), BLOCK);
+    looping.Render(output.data(), BLOCK);
+    EXPECT_NEAR(output[0], static_cast<float>(100 + BLOCK) / RATE, 1e-5f);
+
+    mixer.Update();
+    EXPECT_FALSE(mixer.IsPlaying(past));
+    EXPECT_EQ(mixer.GetActiveVoiceCount(), 1u);
+}
+
+TEST(AudioMixerTest, StealsLowestPriorityVoice) {
+    AudioMixer mixer(MakeConfig(2));
+    AudioClipPtr clip = MakeConstantClip(0.1f, RATE);
+    VoiceParams params;
+
+    params.priority = 1;
+    VoiceHandle low = mixer.Play(clip, params);
+    params.priority = 5;
+    VoiceHandle high = mixer.Play(clip, params);
+    std::vector<float> output(BLOCK * 2);
+    mixer.Render(output.data(), BLOCK);
+
+    // Пул полон: вытесняется голос с приоритетом 1
+    params.priority = 3;
+    VoiceHandle middle = mixer.Play(clip, params);
+    // Ниже всех активных - отклоняется
+    params.priority = 0;
+    VoiceHandle rejected = mixer.Play(clip, params);
+    mixer.Render(output.data(), BLOCK);
+    mixer.Update();
+
+    EXPECT_FALSE(mixer.IsPlaying(low));
+    EXPECT_TRUE(mixer.IsPlaying(high));
+    EXPECT_TRUE(mixer.IsPlaying(middle));
+    EXPECT_FALSE(mixer.IsPlaying(rejected));
+    EXPECT_EQ(mixer.GetStolenVoiceCount(), 1u);
+    EXPECT_EQ(mixer.GetRejectedVoiceCount(), 1u);
+    EXPECT_EQ(mixer.GetActiveVoiceCount(), 2u);
+
+    // Равный приоритет: вытесняется более тихий, при равной громкости - старший
+    AudioMixer equal(MakeConfig(2));
+    params.priority = 2;
+    params.volume = 1.0f;
+    VoiceHandle older = equal.Play(clip, params);
+    VoiceHandle newer = equal.Play(clip, params);
+    equal.Render(output.data(), BLOCK);
+    VoiceHandle third = equal.Play(clip, params);
+    equal.Render(output.data(), BLOCK);
+    equal.Update();
+    EXPECT_FALSE(equal.IsPlaying(older));
+    EXPECT_TRUE(equal.IsPlaying(newer));
+
+    equal.SetVoiceVolume(third, 0.2f);
+    VoiceHandle fourth = equal.Play(clip, params);
+    equal.Render(output.data(), BLOCK);
+    equal.Update();
+    EXPECT_FALSE(equal.IsPlaying(third));
+    EXPECT_TRUE(equal.IsPlaying(newer));
+    EXPECT_TRUE(equal.IsPlaying(fourth));
+}
+
+TEST(AudioMixerTest, CommandQueueOverflowKeepsOrder) {
+    AudioMixerConfig config = MakeConfig();
+    config.commandQueueSize = 4;
+    AudioMixer mixer(config);
+    VoiceParams params;
+    params.pan = -1.0f;
+    params.looping = true;
+    VoiceHandle voice = mixer.Play(MakeConstantClip(1.0f, 1000), params);
+    for (int i = 0; i < 20; ++i) {
+        mixer.SetVoiceVolume(voice, i / 20.0f);
+    }
+    mixer.SetVoiceVolume(voice, 0.75f);
+
+    // Очередь разбирается за несколько Update, последнее значение побеждает
+    std::vector<float> output(BLOCK * 2);
+    for (int i = 0; i < 10; ++i) {
+        mixer.Update();
+        mixer.Render(output.data(), BLOCK);
+    }
+    EXPECT_NEAR(output[(BLOCK - 1) * 2], 0.75f, 1e-5f);
+}
+
+TEST(AudioMixerTest, LostFinishNotificationsDoNotLeakClips) {
+    // Очередь уведомлений на 4 элемента, игровой поток не зовет Update
+    AudioMixerConfig config = MakeConfig(1);
+    config.commandQueueSize = 4;
+    AudioMixer mixer(config);
+    AudioClipPtr clip = MakeConstantClip(0.5f, 16);
+    std::vector<float> output(BLOCK * 2);
+    std::vector<VoiceHandle> voices;
+    for (int i = 0; i < 12; ++i) {
+        voices.push_back(mixer.Play(clip));
+        mixer.Render(output.data(), BLOCK);
+    }
+    VoiceParams params;
+    params.looping = true;
+    VoiceHandle loop = mixer.Play(clip, params);
+    mixer.Render(output.data(), BLOCK);
+
+    mixer.Update();
+    for (VoiceHandle voice : voices) {
+        EXPECT_FALSE(mixer.IsPlaying(voice)) << voice;
+    }
+    EXPECT_TRUE(mixer.IsPlaying(loop));
+    EXPECT_EQ(clip.use_count(), 2);
+
+    mixer.StopAll();
+    mixer.Update();
+    mixer.Render(output.data(), BLOCK);
+    mixer.Update();
+    EXPECT_FALSE(mixer.IsPlaying(loop));
+    EXPECT_EQ(clip.use_count(), 1);
+}
+
+TEST(AudioMixerTest, MixerThreadFeedsSink) {
+    AudioMixer mixer(MakeConfig());
+    auto sink = std::make_unique<NullAudioSink>(true);
+    NullAudioSink* null = sink.get();
+    ASSERT_TRUE(mixer.Start(std::move(sink)));
+    EXPECT_TRUE(mixer.IsRunning());
+
+    VoiceHandle voice = mixer.Play(MakeConstantClip(0.5f, RATE / 20));
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (mixer.IsPlaying(voice) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        mixer.Update();
+    }
+    EXPECT_FALSE(mixer.IsPlaying(voice));
+    uint64_t frames = null->GetFramesWritten();
+    EXPECT_GE(frames, RATE / 20);
+    EXPECT_NEAR(null->GetPeak(), 0.5f * std::sqrt(0.5f), 1e-4f);
+    EXPECT_GT(mixer.GetAverageBlockTimeUs(), 0.0);
+
+    mixer.Stop();
+    EXPECT_FALSE(mixer.IsRunning());
+    EXPECT_EQ(mixer.GetRenderedFrames(), frames);
+}
+
+TEST(AudioMixerTest, WavSinkWritesPcm) {
+    const std::string path = "audio_mixer_test.wav";
+    AudioMixer mixer(MakeConfig());
+    VoiceParams params;
+    params.pan = -1.0f;
+    params.volume = 0.5f;
+    mixer.Play(MakeConstantClip(1.0f, RATE), params);
+
+    WavFileAudioSink sink(path);
+    ASSERT_TRUE(sink.Open(RATE, 2, BLOCK));
+    std::vector<float> output(BLOCK * 2);
+    for (int i = 0; i < 4; ++i) {
+        mixer.Render(output.data(), BLOCK);
+        ASSERT_TRUE(sink.Write(output.data(), BLOCK));
+    }
+    sink.Close();
+
+    std::ifstream file(path, std::ios::binary);
+    ASSERT_TRUE(file.is_open());
+    std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    std::remove(path.c_str());
+
+    ASSERT_EQ(bytes.size(), 44u + BLOCK * 4 * 4);
+    auto readU32 = [&bytes](size_t offset) {
+        return static_cast<uint32_t>(static_cast<uint8_t>(bytes[offset])) |
+               static_cast<uint32_t>(static_cast<uint8_t>(bytes[offset + 1])) << 8 |
+               static_cast<uint32_t>(static_cast<uint8_t>(bytes[offset + 2])) << 16 |
+               static_cast<uint32_t>(static_cast<uint8_t>(bytes[offset + 3])) << 24;
+    };
+    EXPECT_EQ(std::string(bytes.data(), 4), "RIFF");
+    EXPECT_EQ(std::string(bytes.data() + 8, 4), "WAVE");
+    EXPECT_EQ(readU32(24), RATE);
+    EXPECT_EQ(readU32(40), BLOCK * 4 * 4);
+
+    // Последний кадр: левый 0.5, правый тишина
+    size_t last = bytes.size() - 4;
+    int16_t left = static_cast<int16_t>(static_cast<uint8_t>(bytes[last]) | static_cast<uint8_t>(bytes[last + 1]) << 8);
+    int16_t right = static_cast<int16_t>(static_cast<uint8_t>(bytes[last + 2]) | static_cast<uint8_t>(bytes[last + 3]) << 8);
+    EXPECT_NEAR(left, 16384, 2);
+    EXPECT_EQ(right, 0);
+}
+
+TEST(AudioMixerTest, AudioManagerOwnsMixer) {
+    AudioManager manager;
+    EXPECT_EQ(manager.GetMixer(), nullptr);
+    ASSERT_TRUE(manager.Initialize());
+    ASSERT_NE(manager.GetMixer(), nullptr);
+    EXPECT_TRUE(manager.GetMixer()->IsRunning());
+
+    auto sink = std::make_unique<NullAudioSink>(false);
+    NullAudioSink* null = sink.get();
+    ASSERT_TRUE(manager.SetOutputSink(std::move(sink)));
+    manager.SetMuted(true);
+    manager.GetMixer()->Play(MakeConstantClip(1.0f, RATE / 10));
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (null->GetFramesWritten() < RATE && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(null->GetPeak(), 0.0f);
+    manager.Update();
+
+    manager.Shutdown();
+    EXPECT_EQ(manager.GetMixer(), nullptr);
+}
@@ -0,0 +1,224 @@
+#include <gtest/gtest.h>
+#include "FastEngine/Audio/AudioCodec.h"
+#include "FastEngine/Audio/AudioManager.h"
+#include "FastEngine/Audio/AudioMixer.h"
+#include "FastEngine/Components/AudioSource.h"
+#include "FastEngine/Components/Transform.h"
+#include "FastEngine/Entity.h"
+#include "FastEngine/Systems/AudioSystem.h"
+#include "FastEngine/World.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+using namespace FastEngine;
+
+namespace {
+
+const uint32_t RATE = 48000;
+const float FRAME = 1.0f / 60.0f;
+
+class AudioSpatialTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite() {
+        // Секунда тона; клип декодируется один раз и общий для всех источников
+        std::vector<float> samples(RATE);
+        for (uint32_t i = 0; i < RATE; ++i) {
+            samples[i] = 0.5f * std::sin(6.2831853f * 440.0f * i / RATE);
+        }
+        ASSERT_TRUE(AudioEncoder::WriteWav(PATH, *AudioClip::Create(std::move(samples), 1, RATE)));
+    }
+
+    static void TearDownTestSuite() {
+        std::remove(PATH);
+    }
+
+    AudioSource* AddSource(float x, float y, bool looping = true) {
+        Entity* entity = world.CreateEntity();
+        entity->AddComponent<Transform>(x, y);
+        AudioSource* source = entity->AddComponent<AudioSource>();
+        EXPECT_TRUE(source->LoadSound(PATH));
+        source->SetLooping(looping);
+        source->Set3DEnabled(true);
+        source->SetMinDistance(4.0f);
+        source->SetMaxDistance(100.0f);
+        source->Play();
+        return source;
+    }
+
+    static constexpr const char* PATH = "spatial_tone.wav";
+    World world;
+};
+
+} // namespace
+
+TEST_F(AudioSpatialTest, AttenuatesAndPansFromListenerTransform) {
+    Entity* listener = world.CreateEntity();
+    Transform* ear = listener->AddComponent<Transform>(100.0f, 50.0f);
+    AudioSystem system(&world, nullptr);
+    system.SetListener(listener);
+    EXPECT_EQ(system.GetListener(), listener);
+
+    AudioSource* inside = AddSource(102.0f, 50.0f);  // Ближе minDistance
+    AudioSource* above = AddSource(100.0f, 70.0f);
+    AudioSource* left = AddSource(60.0f, 50.0f);
+    AudioSource* edge = AddSource(195.0f, 50.0f);    // В зоне затухания у maxDistance
+    AudioSource* far = AddSource(250.0f, 50.0f);
+    AudioSource* flat = AddSource(250.0f, 50.0f);
+    flat->Set3DEnabled(false);
+    flat->SetPan(-0.3f);
+
+    system.Update(FRAME);
+    EXPECT_FLOAT_EQ(inside->GetSpatialGain(), 1.0f);
+    EXPECT_NEAR(inside->GetSpatialPan(), 0.5f, 1e-5f);
+    EXPECT_NEAR(above->GetSpatialGain(), 4.0f / 20.0f, 1e-5f);
+    EXPECT_NEAR(above->GetSpatialPan(), 0.0f, 1e-5f);
+    EXPECT_NEAR(left->GetSpatialGain(), 4.0f / 40.0f, 1e-5f);
+    EXPECT_NEAR(left->GetSpatialPan(), -1.0f, 1e-5f);
+    EXPECT_NEAR(edge->GetSpatialGain(), 4.0f / 95.0f * (5.0f / 9.6f), 1e-5f);
+    EXPECT_FLOAT_EQ(far->GetSpatialGain(), 0.0f);
+    EXPECT_FLOAT_EQ(flat->GetSpatialGain(), 1.0f);
+    EXPECT_FLOAT_EQ(flat->GetSpatialPan(), -0.3f);
+
+    // Rolloff 0: громкость постоянна до зоны у maxDistance
+    above->SetRolloffFactor(0.0f);
+    // Поворот слушателя на 90 градусов: "вправо" теперь +y
+    ear->SetRotation(90.0f);
+    system.Update(FRAME);
+    EXPECT_FLOAT_EQ(above->GetSpatialGain(), 1.0f);
+    EXPECT_NEAR(above->GetSpatialPan(), 1.0f, 1e-5f);
+    EXPECT_NEAR(inside->GetSpatialPan(), 0.0f, 1e-5f);
+
+    const AudioSystemStats& stats = system.GetStats();
+    EXPECT_EQ(stats.playingSources, 6u);
+    EXPECT_EQ(stats.inaudibleSources, 1u);
+    // Без микшера все источники виртуальные
+    EXPECT_EQ(stats.realVoices, 0u);
+    EXPECT_EQ(stats.virtualVoices, 6u);
+}
+
+TEST_F(AudioSpatialTest, CapsRealVoicesByPriorityAndAudibility) {
+    AudioManager manager;
+    ASSERT_TRUE(manager.Initialize());
+    Entity* listener = world.CreateEntity();
+    Transform* ear = listener->AddComponent<Transform>();
+    AudioSystem system(&world, &manager);
+    system.SetListener(listener);
+    system.SetMaxRealVoices(16);
+
+    // 500 источников на квадрате 400x400, детерминированная раскладка
+    std::vector<AudioSource*> sources;
+    uint32_t seed = 12345;
+    auto next = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24) * 400.0f - 200.0f;
+    };
+    for (int i = 0; i < 500; ++i) {
+        float x = next();
+        float y = next();
+        sources.push_back(AddSource(x, y));
+    }
+    // Дальний, но важный источник получает голос раньше близких
+    AudioSource* important = AddSource(0.0f, 90.0f);
+    important->SetPriority(10);
+
+    system.Update(FRAME);
+    const AudioSystemStats& stats = system.GetStats();
+    EXPECT_EQ(stats.playingSources, 501u);
+    EXPECT_EQ(stats.realVoices, 16u);
+    EXPECT_EQ(stats.startedVoices, 16u);
+    EXPECT_EQ(stats.virtualVoices, 485u);
+    EXPECT_GT(stats.inaudibleSources, 0u);
+    EXPECT_TRUE(important->HasVoice());
+
+    float quietestReal = 1.0f;
+    float loudestVirtual = 0.0f;
+    for (AudioSource* source : sources) {
+        if (source->HasVoice()) {
+            quietestReal = std::min(quietestReal, source->GetSpatialGain());
+        } else {
+            EXPECT_TRUE(source->IsVirtual());
+            loudestVirtual = std::max(loudestVirtual, source->GetSpatialGain());
+        }
+    }
+    EXPECT_GE(quietestReal, loudestVirtual);
+
+    // Без движения набор голосов не меняется
+    system.Update(FRAME);
+    EXPECT_EQ(stats.startedVoices, 0u);
+    EXPECT_EQ(stats.virtualizedVoices, 0u);
+    EXPECT_EQ(stats.realVoices, 16u);
+
+    // Слушатель ушел: часть голосов переходит к новым ближайшим источникам
+    ear->SetPosition(150.0f, 150.0f);
+    system.Update(FRAME);
+    EXPECT_GT(stats.startedVoices, 0u);
+    EXPECT_EQ(stats.startedVoices, stats.virtualizedVoices);
+    EXPECT_EQ(stats.realVoices, 16u);
+    manager.Update();
+    EXPECT_LE(manager.GetMixer()->GetActiveVoiceCount(), 32u);
+
+    system.Cleanup();
+    for (AudioSource* source : sources) {
+        EXPECT_FALSE(source->HasVoice());
+        EXPECT_FALSE(source->HasOutput());
+    }
+}
+
+TEST_F(AudioSpatialTest, VirtualSourceKeepsPositionAndResumes) {
+    AudioManager manager;
+    ASSERT_TRUE(manager.Initialize());
+    AudioSystem system(&world, &manager);
+
+    AudioSource* source = AddSource(150.0f, 0.0f);
+    system.Update(FRAME);
+    EXPECT_TRUE(source->IsVirtual());
+    EXPECT_TRUE(source->HasOutput());
+
+    // Виртуальный голос отсчитывает позицию с учетом pitch и петли
+    source->SetPitch(2.0f);
+    for (int i = 0; i < 45; ++i) {
+        system.Update(FRAME);
+    }
+    EXPECT_NEAR(source->GetPlaybackTime(), std::fmod((46 - 1) * FRAME * 2.0f + FRAME, 1.0f), 1e-3f);
+
+    Entity* entity = world.GetEntities().back().get();
+    entity->GetComponent<Transform>()->SetPosition(10.0f, 0.0f);
+    system.Update(FRAME);
+    EXPECT_TRUE(source->HasVoice());
+    EXPECT_EQ(system.GetStats().startedVoices, 1u);
+
+    // Пауза отдает голос, позиция сохраняется
+    source->Pause();
+    EXPECT_FALSE(source->HasVoice());
+    float paused = source->GetPlaybackTime();
+    system.Update(FRAME);
+    EXPECT_FLOAT_EQ(source->GetPlaybackTime(), paused);
+    EXPECT_EQ(system.GetStats().playingSources, 0u);
+    source->Resume();
+    system.Update(FRAME);
+    EXPECT_TRUE(source->HasVoice());
+    EXPECT_NEAR(source->GetPlaybackTime(), std::fmod(paused + FRAME * 2.0f, 1.0f), 1e-5f);
+
+    system.Cleanup();
+}
+
+TEST_F(AudioSpatialTest, VirtualOneShotCompletesOnTime) {
+    AudioSystem system(&world, nullptr);
+    AudioSource* source = AddSource(0.0f, 0.0f, false);
+    int completed = 0;
+    source->SetOnPlaybackComplete([&completed]() { ++completed; });
+
+    for (int i = 0; i < 59; ++i) {
+        system.Update(FRAME);
+    }
+    EXPECT_TRUE(source->IsPlaying());
+    EXPECT_EQ(completed, 0);
+
+    system.Update(FRAME);
+    system.Update(FRAME);
+    EXPECT_TRUE(source->IsStopped());
+    EXPECT_EQ(completed, 1);
+    EXPECT_FLOAT_EQ(source->GetPlaybackTime(), 0.0f);
+    EXPECT_EQ(system.GetStats().playingSources, 0u);
+}
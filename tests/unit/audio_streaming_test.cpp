@@ -0,0 +1,352 @@
+#include <gtest/gtest.h>
+#include "FastEngine/Audio/AudioClipCache.h"
+#include "FastEngine/Audio/AudioCodec.h"
+#include "FastEngine/Audio/AudioManager.h"
+#include "FastEngine/Audio/AudioMixer.h"
+#include "FastEngine/Audio/AudioStream.h"
+#include "FastEngine/Audio/Sound.h"
+#include "FastEngine/Resources/ResourceManager.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+using namespace FastEngine;
+
+namespace {
+
+const uint32_t RATE = 48000;
+
+// Два тона в каналах, чтобы перепутанные каналы были заметны
+std::shared_ptr<AudioClip> MakeToneClip(uint32_t frames, uint32_t channels, uint32_t sampleRate = RATE) {
+    std::vector<float> samples(static_cast<size_t>(frames) * channels);
+    for (uint32_t i = 0; i < frames; ++i) {
+        for (uint32_t c = 0; c < channels; ++c) {
+            float frequency = c == 0 ? 440.0f : 660.0f;
+            samples[i * channels + c] = 0.6f * std::sin(6.2831853f * frequency * i / sampleRate);
+        }
+    }
+    return AudioClip::Create(std::move(samples), channels, sampleRate);
+}
+
+// Отношение сигнал/шум декодированного клипа, дБ
+double SignalToNoise(const AudioClip& original, const AudioClip& decoded) {
+    double signal = 0.0;
+    double noise = 0.0;
+    for (size_t i = 0; i < original.samples.size(); ++i) {
+        double error = decoded.samples[i] - original.samples[i];
+        signal += original.samples[i] * original.samples[i];
+        noise += error * error;
+    }
+    return 10.0 * std::log10(signal / std::max(noise, 1e-20));
+}
+
+class TempFile {
+public:
+    explicit TempFile(const std::string& name) : path(name) {}
+    ~TempFile() { std::remove(path.c_str()); }
+    std::string path;
+};
+
+} // namespace
+
+TEST(AudioCodecTest, PcmAndFloatRoundTrip) {
+    auto clip = MakeToneClip(1000, 2);
+    TempFile pcm("codec_pcm.wav");
+    TempFile floats("codec_float.wav");
+    ASSERT_TRUE(AudioEncoder::WriteWav(pcm.path, *clip, AudioEncoding::Pcm));
+    ASSERT_TRUE(AudioEncoder::WriteWav(floats.path, *clip, AudioEncoding::Float));
+
+    auto decoder = AudioDecoder::Open(pcm.path);
+    ASSERT_NE(decoder, nullptr);
+    EXPECT_EQ(decoder->GetEncoding(), AudioEncoding::Pcm);
+    EXPECT_EQ(decoder->GetChannels(), 2u);
+    EXPECT_EQ(decoder->GetSampleRate(), RATE);
+    EXPECT_EQ(decoder->GetFrameCount(), 1000u);
+
+    AudioClipPtr decoded = DecodeAudioFile(pcm.path);
+    ASSERT_NE(decoded, nullptr);
+    for (size_t i = 0; i < clip->samples.size(); ++i) {
+        // Квантование до 16 бит плюс масштаб 32767 при записи и 1/32768 при чтении
+        ASSERT_NEAR(decoded->samples[i], clip->samples[i], 2.0f / 32767.0f) << i;
+    }
+
+    AudioClipPtr exact = DecodeAudioFile(floats.path);
+    ASSERT_NE(exact, nullptr);
+    EXPECT_EQ(exact->samples, clip->samples);
+}
+
+TEST(AudioCodecTest, ImaAdpcmCompressesAndDecodesIncrementally) {
+    for (uint32_t channels = 1; channels <= 2; ++channels) {
+        // Длина не кратна блоку: последний блок неполный, длину дает fact
+        auto clip = MakeToneClip(RATE / 2 + 123, channels);
+        TempFile adpcm("codec_adpcm.wav");
+        TempFile pcm("codec_adpcm_pcm.wav");
+        ASSERT_TRUE(AudioEncoder::WriteImaAdpcm(adpcm.path, *clip));
+        ASSERT_TRUE(AudioEncoder::WriteWav(pcm.path, *clip));
+
+        std::ifstream adpcmFile(adpcm.path, std::ios::binary | std::ios::ate);
+        std::ifstream pcmFile(pcm.path, std::ios::binary | std::ios::ate);
+        EXPECT_LT(adpcmFile.tellg() * 3, pcmFile.tellg()) << "channels " << channels;
+
+        AudioClipPtr decoded = DecodeAudioFile(adpcm.path);
+        ASSERT_NE(decoded, nullptr);
+        ASSERT_EQ(decoded->frameCount, clip->frameCount);
+        ASSERT_EQ(decoded->channels, channels);
+        EXPECT_GT(SignalToNoise(*clip, *decoded), 25.0) << "channels " << channels;
+
+        // Чтение кусками произвольной длины и перемотка дают те же отсчеты
+        auto decoder = AudioDecoder::Open(adpcm.path);
+        ASSERT_NE(decoder, nullptr);
+        EXPECT_EQ(decoder->GetEncoding(), AudioEncoding::ImaAdpcm);
+        std::vector<float> pieces(decoded->samples.size());
+        uint32_t frames = 0;
+        uint32_t piece = 1;
+        while (uint32_t read = decoder->Read(pieces.data() + frames * channels, piece)) {
+            frames += read;
+            piece = piece * 3 % 1500 + 1;
+        }
+        EXPECT_EQ(frames, clip->frameCount);
+        EXPECT_EQ(pieces, decoded->samples);
+
+        ASSERT_TRUE(decoder->Seek(5000));
+        std::vector<float> tail(10 * channels);
+        ASSERT_EQ(decoder->Read(tail.data(), 10), 10u);
+        for (uint32_t i = 0; i < tail.size(); ++i) {
+            EXPECT_EQ(tail[i], decoded->samples[5000 * channels + i]);
+        }
+    }
+}
+
+TEST(AudioCodecTest, RejectsMalformedWavHeaders) {
+    // Заголовок WAV с произвольными полями fmt и 64 байтами данных
+    auto writeWav = [](const std::string& path, uint32_t fmtSize, uint16_t format, uint16_t channels,
+                       uint16_t blockAlign, uint16_t bits) {
+        std::vector<uint8_t> out;
+        auto u16 = [&out](uint16_t value) {
+            out.push_back(static_cast<uint8_t>(value));
+            out.push_back(static_cast<uint8_t>(value >> 8));
+        };
+        auto u32 = [&u16](uint32_t value) {
+            u16(static_cast<uint16_t>(value));
+            u16(static_cast<uint16_t>(value >> 16));
+        };
+        auto tag = [&out](const char* name) { out.insert(out.end(), name, name + 4); };
+        tag("RIFF");
+        u32(0);
+        tag("WAVE");
+        tag("fmt ");
+        u32(fmtSize);
+        u16(format);
+        u16(channels);
+        u32(RATE);
+        u32(RATE * blockAlign);
+        u16(blockAlign);
+        u16(bits);
+        tag("data");
+        u32(64);
+        out.resize(out.size() + 64, 0x7F);
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(out.data()), out.size());
+    };
+
+    TempFile file("codec_malformed.wav");
+    writeWav(file.path, 16, 1, 2, 4, 16);
+    AudioClipPtr valid = DecodeAudioFile(file.path);
+    ASSERT_NE(valid, nullptr);
+    EXPECT_EQ(valid->samples.size(), 32u);
+
+    // blockAlign меньше кадра: разбор отсчетов вышел бы за прочитанный буфер
+    writeWav(file.path, 16, 1, 2, 1, 16);
+    EXPECT_EQ(AudioDecoder::Open(file.path), nullptr);
+    EXPECT_EQ(DecodeAudioFile(file.path), nullptr);
+    writeWav(file.path, 16, 3, 2, 4, 32);
+    EXPECT_EQ(DecodeAudioFile(file.path), nullptr);
+    writeWav(file.path, 16, 1, 1, 3, 20);
+    EXPECT_EQ(DecodeAudioFile(file.path), nullptr);
+
+    // Огромный размер fmt не выделяется
+    writeWav(file.path, 0xFFFFFFF0u, 1, 2, 4, 16);
+    EXPECT_EQ(DecodeAudioFile(file.path), nullptr);
+}
+
+TEST(AudioCodecTest, RejectsUnsupportedFiles) {
+    TempFile garbage("codec_garbage.ogg");
+    {
+        std::ofstream file(garbage.path, std::ios::binary);
+        file << "OggS not really a wav file";
+    }
+    EXPECT_EQ(AudioDecoder::Open(garbage.path), nullptr);
+    EXPECT_EQ(AudioDecoder::Open("does_not_exist.wav"), nullptr);
+    EXPECT_EQ(DecodeAudioFile("does_not_exist.wav"), nullptr);
+}
+
+TEST(AudioStreamTest, DoubleBufferedPlaybackMatchesDecodedFile) {
+    auto clip = MakeToneClip(RATE, 2, 44100);
+    TempFile file("stream_music.wav");
+    ASSERT_TRUE(AudioEncoder::WriteImaAdpcm(file.path, *clip));
+    AudioClipPtr reference = DecodeAudioFile(file.path);
+
+    // Короткие буферы: поток подгрузки работает постоянно
+    AudioStreamer streamer(2048, 0.001f);
+    ASSERT_TRUE(streamer.Start());
+    auto stream = streamer.Open(file.path);
+    ASSERT_NE(stream, nullptr);
+    EXPECT_EQ(streamer.GetStreamCount(), 1u);
+    EXPECT_EQ(stream->GetMemorySize(), 2u * 2048 * 2 * sizeof(float));
+
+    AudioMixerConfig config;
+    config.sampleRate = RATE;
+    AudioMixer streamed(config);
+    AudioMixer inMemory(config);
+    VoiceParams params;
+    params.pitch = 1.1f;
+    VoiceHandle voice = streamed.PlayStream(stream, params);
+    inMemory.Play(reference, params);
+    ASSERT_NE(voice, INVALID_VOICE);
+
+    // Блоками в темпе, который успевает подгрузка, результат совпадает с клипом в памяти
+    std::vector<float> a(config.blockFrames * 2);
+    std::vector<float> b(config.blockFrames * 2);
+    uint32_t blocks = 0;
+    while (streamed.IsPlaying(voice) && blocks < 1000) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        streamed.Render(a.data(), config.blockFrames);
+        inMemory.Render(b.data(), config.blockFrames);
+        streamed.Update();
+        // Последний блок: клип в памяти еще интерполирует последний кадр
+        if (!stream->IsFinished()) {
+            for (size_t i = 0; i < a.size(); ++i) {
+                ASSERT_NEAR(a[i], b[i], 1e-5f) << "block " << blocks << " sample " << i;
+            }
+        }
+        ++blocks;
+    }
+    EXPECT_FALSE(streamed.IsPlaying(voice));
+    EXPECT_TRUE(stream->IsFinished());
+    EXPECT_EQ(stream->GetUnderrunCount(), 0u);
+    // 48000 кадров при 44.1 кГц с pitch 1.1: около 0.99 с
+    EXPECT_NEAR(blocks * config.blockFrames / static_cast<float>(RATE), RATE / 44100.0f / 1.1f, 0.02f);
+
+    stream.reset();
+    EXPECT_EQ(streamer.GetStreamCount(), 0u);
+    streamer.Stop();
+}
+
+TEST(AudioStreamTest, LoopingStreamWrapsAndReportsUnderruns) {
+    auto clip = MakeToneClip(3000, 1);
+    TempFile file("stream_loop.wav");
+    ASSERT_TRUE(AudioEncoder::WriteWav(file.path, *clip));
+
+    // Без потока подгрузки: буферы заполняются вручную
+    auto stream = std::make_shared<AudioStream>(AudioDecoder::Open(file.path), true, 2048);
+    EXPECT_TRUE(stream->Fill());
+    EXPECT_FALSE(stream->Fill());
+
+    std::vector<float> output(4096);
+    ASSERT_EQ(stream->Read(output.data(), 4096), 4096u);
+    EXPECT_NEAR(output[3000], clip->samples[0], 1.0f / 32767.0f);
+    EXPECT_NEAR(output[3100], clip->samples[100], 1.0f / 32767.0f);
+
+    // Оба буфера прочитаны, подгрузки не было - недогрузка, но не конец
+    EXPECT_EQ(stream->Read(output.data(), 16), 0u);
+    EXPECT_EQ(stream->GetUnderrunCount(), 1u);
+    EXPECT_FALSE(stream->IsFinished());
+    EXPECT_TRUE(stream->Fill());
+    EXPECT_EQ(stream->Read(output.data(), 16), 16u);
+}
+
+TEST(AudioClipCacheTest, DecodesOnceAndSharesClip) {
+    TempFile file("cache_sfx.wav");
+    ASSERT_TRUE(AudioEncoder::WriteWav(file.path, *MakeToneClip(4800, 1)));
+    AudioClipCache& cache = AudioClipCache::GetInstance();
+    uint64_t decodes = cache.GetDecodeCount();
+    size_t memory = cache.GetMemoryUsage();
+
+    AudioClipPtr first = cache.Load(file.path);
+    AudioClipPtr second = cache.Load(file.path);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(cache.GetDecodeCount(), decodes + 1);
+    EXPECT_EQ(cache.GetReferenceCount(file.path), 2);
+    EXPECT_EQ(cache.GetMemoryUsage(), memory + 4800 * sizeof(float));
+
+    // Память освобождается с последним владельцем
+    first.reset();
+    EXPECT_EQ(cache.GetReferenceCount(file.path), 1);
+    second.reset();
+    EXPECT_EQ(cache.GetReferenceCount(file.path), 0);
+    EXPECT_EQ(cache.Find(file.path), nullptr);
+    EXPECT_EQ(cache.GetMemoryUsage(), memory);
+    cache.Purge();
+
+    AudioClipPtr again = cache.Load(file.path);
+    EXPECT_EQ(cache.GetDecodeCount(), decodes + 2);
+}
+
+TEST(SoundTest, ShortSoundsDecodeAndLongSoundsStream) {
+    TempFile sfx("sound_sfx.wav");
+    TempFile music("sound_music.wav");
+    ASSERT_TRUE(AudioEncoder::WriteWav(sfx.path, *MakeToneClip(RATE / 10, 1)));
+    ASSERT_TRUE(AudioEncoder::WriteImaAdpcm(music.path, *MakeToneClip(RATE, 2)));
+
+    float threshold = Sound::GetStreamingThreshold();
+    Sound::SetStreamingThreshold(0.5f);
+
+    AudioManager manager;
+    ASSERT_TRUE(manager.Initialize());
+    auto sink = std::make_unique<NullAudioSink>(false);
+    NullAudioSink* null = sink.get();
+    ASSERT_TRUE(manager.SetOutputSink(std::move(sink)));
+
+    Sound* effect = manager.LoadSound(sfx.path);
+    Sound* song = manager.LoadSound(music.path);
+    ASSERT_NE(effect, nullptr);
+    ASSERT_NE(song, nullptr);
+    EXPECT_EQ(manager.LoadSound("missing.wav"), nullptr);
+    EXPECT_FALSE(effect->IsStreaming());
+    EXPECT_TRUE(song->IsStreaming());
+    EXPECT_NE(effect->GetClip(), nullptr);
+    EXPECT_EQ(song->GetClip(), nullptr);
+    EXPECT_NEAR(song->GetDuration(), 1.0f, 1e-3f);
+    EXPECT_EQ(effect->GetMemorySize(), RATE / 10 * sizeof(float));
+    EXPECT_EQ(song->GetMemorySize(), AudioStream::GetBufferSize(AudioStream::DEFAULT_CHUNK_FRAMES, 2));
+
+    // Звуки играют через микшер и сами завершаются
+    effect->Play();
+    song->Play();
+    EXPECT_TRUE(effect->IsPlaying());
+    EXPECT_TRUE(song->IsPlaying());
+    EXPECT_EQ(manager.GetStreamer()->GetStreamCount(), 1u);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while ((effect->IsPlaying() || song->IsPlaying()) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        manager.Update();
+    }
+    EXPECT_FALSE(effect->IsPlaying());
+    EXPECT_FALSE(song->IsPlaying());
+    EXPECT_GT(null->GetPeak(), 0.3f);
+
+    manager.Shutdown();
+    Sound::SetStreamingThreshold(threshold);
+}
+
+TEST(SoundTest, ResourceManagerAccountsDecodedMemory) {
+    TempFile sfx("resource_sfx.wav");
+    ASSERT_TRUE(AudioEncoder::WriteWav(sfx.path, *MakeToneClip(9600, 2)));
+    ResourceManager& resources = ResourceManager::GetInstance();
+    resources.Initialize();
+    size_t before = resources.GetUsedMemory();
+
+    auto sound = resources.LoadSound(sfx.path);
+    ASSERT_NE(sound, nullptr);
+    EXPECT_EQ(resources.GetUsedMemory(), before + 9600 * 2 * sizeof(float));
+    EXPECT_EQ(AudioClipCache::GetInstance().GetReferenceCount(sfx.path), 1);
+
+    resources.UnloadResource(sfx.path);
+    EXPECT_EQ(resources.GetUsedMemory(), before);
+    sound.reset();
+    EXPECT_EQ(AudioClipCache::GetInstance().GetReferenceCount(sfx.path), 0);
+    resources.Shutdown();
+}
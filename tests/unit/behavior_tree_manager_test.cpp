@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include "FastEngine/AI/BehaviorTree.h"
+#include "FastEngine/AI/CompiledBehaviorTree.h"
+#include "FastEngine/Jobs/JobSystem.h"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+using namespace FastEngine;
+
+namespace {
+
+// Слоты доски тестового дерева
+BlackboardKey<int> g_ticks;
+BlackboardKey<float> g_time;
+BlackboardKey<uint32_t> g_state;
+
+// Считает тики и накопленное время; исход детерминированно зависит от состояния агента
+BehaviorStatus CountTick(BehaviorTickContext& context) {
+    context.blackboard.Set(g_ticks, context.blackboard.Get(g_ticks) + 1);
+    context.blackboard.Set(g_time, context.blackboard.Get(g_time) + context.deltaTime);
+    uint32_t state = context.blackboard.Get(g_state) * 1664525u + 1013904223u;
+    context.blackboard.Set(g_state, state);
+    return (state >> 16) % 3 == 0 ? BehaviorStatus::Running : BehaviorStatus::Success;
+}
+
+// Действие заметной длительности для проверки бюджета кадра
+BehaviorStatus SlowTick(BehaviorTickContext& context) {
+    auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(20);
+    while (std::chrono::steady_clock::now() < end) {}
+    return CountTick(context);
+}
+
+std::shared_ptr<const CompiledBehaviorTree> BuildTree(BehaviorActionFunc action) {
+    BehaviorTreeBuilder builder;
+    g_ticks = builder.GetLayout().AddSlot<int>("ticks");
+    g_time = builder.GetLayout().AddSlot<float>("time");
+    g_state = builder.GetLayout().AddSlot<uint32_t>("state");
+    builder.Action(action);
+    return builder.Build();
+}
+
+} // namespace
+
+TEST(BehaviorTreeManagerTest, LodIntervalsFollowDistanceAndImportance) {
+    BehaviorTreeManager manager;
+    ASSERT_TRUE(manager.Initialize());
+    ASSERT_TRUE(manager.AddCompiledTree("agent", BuildTree(CountTick)));
+    manager.SetLodLevels({BehaviorLodLevel(10.0f, 1), BehaviorLodLevel(50.0f, 4)});
+
+    BehaviorAgentId nearAgent = manager.AddAgent("agent");
+    BehaviorAgentId farAgent = manager.AddAgent("agent");
+    BehaviorAgentId importantAgent = manager.AddAgent("agent");
+    manager.SetAgentPosition(nearAgent, glm::vec3(5.0f, 0.0f, 0.0f));
+    manager.SetAgentPosition(farAgent, glm::vec3(40.0f, 0.0f, 0.0f));
+    manager.SetAgentPosition(importantAgent, glm::vec3(40.0f, 0.0f, 0.0f));
+    manager.SetAgentImportance(importantAgent, 5.0f);
+
+    const int frames = 40;
+    for (int frame = 0; frame < frames; ++frame) {
+        manager.Update(0.01f);
+    }
+
+    EXPECT_EQ(manager.GetBlackboard(nearAgent).Get(g_ticks), frames);
+    EXPECT_EQ(manager.GetBlackboard(importantAgent).Get(g_ticks), frames);
+    int farTicks = manager.GetBlackboard(farAgent).Get(g_ticks);
+    EXPECT_GE(farTicks, frames / 4);
+    EXPECT_LE(farTicks, frames / 4 + 1);
+
+    // Редкий тик получает все прошедшее время
+    EXPECT_NEAR(manager.GetBlackboard(farAgent).Get(g_time),
+                manager.GetBlackboard(nearAgent).Get(g_time), 0.04f);
+}
+
+TEST(BehaviorTreeManagerTest, AgentsAreSpreadAcrossFrames) {
+    BehaviorTreeManager manager;
+    manager.Initialize();
+    manager.AddCompiledTree("agent", BuildTree(CountTick));
+    manager.SetLodLevels({BehaviorLodLevel(1.0f, 1), BehaviorLodLevel(1000.0f, 4)});
+
+    const int agentCount = 1000;
+    for (int i = 0; i < agentCount; ++i) {
+        manager.SetAgentPosition(manager.AddAgent("agent"), glm::vec3(100.0f, 0.0f, 0.0f));
+    }
+
+    // Первый кадр тикает всех новых агентов, дальше каждый кадр - примерно четверть
+    manager.Update(0.016f);
+    EXPECT_EQ(manager.GetLastTickedAgents(), static_cast<size_t>(agentCount));
+    size_t total = 0;
+    for (int frame = 0; frame < 8; ++frame) {
+        manager.Update(0.016f);
+        EXPECT_GT(manager.GetLastTickedAgents(), static_cast<size_t>(agentCount / 4 - 100));
+        EXPECT_LT(manager.GetLastTickedAgents(), static_cast<size_t>(agentCount / 4 + 100));
+        total += manager.GetLastTickedAgents();
+    }
+    EXPECT_EQ(total, static_cast<size_t>(agentCount * 2));
+}
+
+TEST(BehaviorTreeManagerTest, FrameBudgetDefersAgents) {
+    BehaviorTreeManager manager;
+    manager.Initialize();
+    manager.AddCompiledTree("agent", BuildTree(SlowTick));
+    manager.SetFrameBudget(1.0f);
+
+    const int agentCount = 500;
+    std::vector<BehaviorAgentId> agents;
+    for (int i = 0; i < agentCount; ++i) {
+        agents.push_back(manager.AddAgent("agent"));
+    }
+
+    manager.Update(0.016f);
+    EXPECT_LT(manager.GetLastTickedAgents(), static_cast<size_t>(agentCount));
+    EXPECT_EQ(manager.GetLastTickedAgents() + manager.GetLastDeferredAgents(), static_cast<size_t>(agentCount));
+
+    // Без бюджета отложенные агенты догоняют, время между тиками не теряется
+    manager.SetFrameBudget(0.0f);
+    manager.Update(0.016f);
+    EXPECT_EQ(manager.GetLastDeferredAgents(), 0u);
+    for (BehaviorAgentId agent : agents) {
+        EXPECT_NEAR(manager.GetBlackboard(agent).Get(g_time), 0.032f, 1e-5f);
+    }
+}
+
+TEST(BehaviorTreeManagerTest, JobsMatchSingleThread) {
+    auto tree = BuildTree(CountTick);
+    std::vector<BehaviorLodLevel> levels = {BehaviorLodLevel(20.0f, 1), BehaviorLodLevel(60.0f, 2),
+                                            BehaviorLodLevel(200.0f, 5)};
+    const int agentCount = 2000;
+    const int frames = 30;
+
+    // Без запущенного JobSystem - в потоке Update, затем на его заданиях
+    auto run = [&](BehaviorTreeManager& manager, std::vector<size_t>& ticked) {
+        manager.Initialize();
+        manager.AddCompiledTree("agent", tree);
+        manager.SetLodLevels(levels);
+        for (int i = 0; i < agentCount; ++i) {
+            BehaviorAgentId agent = manager.AddAgent("agent");
+            manager.GetBlackboard(agent).Set(g_state, static_cast<uint32_t>(i));
+            manager.SetAgentPosition(agent, glm::vec3(static_cast<float>(i % 150), 0.0f, 0.0f));
+        }
+        for (int frame = 0; frame < frames; ++frame) {
+            manager.Update(0.016f);
+            ticked.push_back(manager.GetLastTickedAgents());
+        }
+    };
+
+    BehaviorTreeManager serial;
+    std::vector<size_t> serialTicked;
+    ASSERT_FALSE(JobSystem::GetInstance().IsRunning());
+    run(serial, serialTicked);
+
+    BehaviorTreeManager parallel;
+    std::vector<size_t> parallelTicked;
+    ASSERT_TRUE(JobSystem::GetInstance().Start(3));
+    EXPECT_EQ(JobSystem::GetInstance().GetWorkerCount(), 3u);
+    run(parallel, parallelTicked);
+    uint64_t executed = JobSystem::GetInstance().GetStats().executed;
+    JobSystem::GetInstance().Stop();
+    EXPECT_GT(executed, 0u);
+
+    EXPECT_EQ(serialTicked, parallelTicked);
+    for (BehaviorAgentId agent = 0; agent < static_cast<BehaviorAgentId>(agentCount); ++agent) {
+        ASSERT_EQ(serial.GetBlackboard(agent).Get(g_ticks), parallel.GetBlackboard(agent).Get(g_ticks));
+        ASSERT_EQ(serial.GetBlackboard(agent).Get(g_state), parallel.GetBlackboard(agent).Get(g_state));
+        ASSERT_EQ(serial.GetAgentStatus(agent), parallel.GetAgentStatus(agent));
+    }
+    parallel.Shutdown();
+}
+
+TEST(BehaviorTreeManagerTest, RemoveAgentKeepsOtherIdsValid) {
+    BehaviorTreeManager manager;
+    manager.Initialize();
+    EXPECT_EQ(manager.AddAgent("missing"), INVALID_BEHAVIOR_AGENT);
+    manager.AddCompiledTree("agent", BuildTree(CountTick));
+
+    std::vector<BehaviorAgentId> agents;
+    for (int i = 0; i < 5; ++i) {
+        agents.push_back(manager.AddAgent("agent"));
+        manager.GetBlackboard(agents.back()).Set(g_state, static_cast<uint32_t>(100 + i));
+    }
+
+    manager.RemoveAgent(agents[1]);
+    EXPECT_FALSE(manager.HasAgent(agents[1]));
+    EXPECT_EQ(manager.GetAgentCount(), 4u);
+    EXPECT_EQ(manager.GetBlackboard(agents[4]).Get(g_state), 104u);
+    EXPECT_EQ(manager.GetBlackboard(agents[3]).Get(g_state), 103u);
+
+    // Освободившийся идентификатор переиспользуется
+    BehaviorAgentId reused = manager.AddAgent("agent");
+    EXPECT_EQ(reused, agents[1]);
+    EXPECT_EQ(manager.GetBlackboard(reused).Get(g_state), 0u);
+
+    manager.Update(0.016f);
+    EXPECT_EQ(manager.GetLastTickedAgents(), 5u);
+}
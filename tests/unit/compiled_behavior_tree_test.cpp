@@ -0,0 +1,284 @@
+#include <gtest/gtest.h>
+#include "FastEngine/AI/CompiledBehaviorTree.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace FastEngine;
+
+namespace {
+
+// Слоты доски тестового дерева
+BlackboardKey<int> g_health;
+BlackboardKey<int> g_attacks;
+BlackboardKey<int> g_patrols;
+BlackboardKey<int> g_steps;
+
+bool IsHealthy(BehaviorTickContext& context) {
+    return context.blackboard.Get(g_health) > 50;
+}
+
+BehaviorStatus Attack(BehaviorTickContext& context) {
+    context.blackboard.Set(g_attacks, context.blackboard.Get(g_attacks) + 1);
+    return BehaviorStatus::Success;
+}
+
+BehaviorStatus Patrol(BehaviorTickContext& context) {
+    context.blackboard.Set(g_patrols, context.blackboard.Get(g_patrols) + 1);
+    return BehaviorStatus::Success;
+}
+
+// Два тика Running, затем успех
+BehaviorStatus Walk(BehaviorTickContext& context) {
+    int steps = context.blackboard.Get(g_steps) + 1;
+    context.blackboard.Set(g_steps, steps);
+    return steps % 3 == 0 ? BehaviorStatus::Success : BehaviorStatus::Running;
+}
+
+BehaviorStatus Fail(BehaviorTickContext&) {
+    return BehaviorStatus::Failure;
+}
+
+// Действие со случайным исходом из детерминированного потока агента;
+// журнал вызовов сравнивается с деревом на узлах BehaviorNode
+BlackboardKey<uint32_t> g_random;
+std::vector<std::string> g_compiledLog;
+
+BehaviorStatus NextOutcome(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    uint32_t roll = (state >> 16) % 3;
+    return roll == 0 ? BehaviorStatus::Success : (roll == 1 ? BehaviorStatus::Failure : BehaviorStatus::Running);
+}
+
+template<int ID>
+BehaviorStatus RandomAction(BehaviorTickContext& context) {
+    uint32_t state = context.blackboard.Get(g_random);
+    BehaviorStatus status = NextOutcome(state);
+    context.blackboard.Set(g_random, state);
+    g_compiledLog.push_back(std::to_string(ID));
+    return status;
+}
+
+} // namespace
+
+class CompiledBehaviorTreeTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        BlackboardLayout& layout = builder.GetLayout();
+        g_health = layout.AddSlot<int>("health");
+        g_attacks = layout.AddSlot<int>("attacks");
+        g_patrols = layout.AddSlot<int>("patrols");
+        g_steps = layout.AddSlot<int>("steps");
+    }
+    
+    BehaviorTreeBuilder builder;
+};
+
+TEST_F(CompiledBehaviorTreeTest, LayoutResolvesTypedSlots) {
+    BlackboardLayout& layout = builder.GetLayout();
+    BlackboardKey<double> speed = layout.AddSlot<double>("speed");
+    
+    EXPECT_EQ(layout.FindSlot<int>("attacks").offset, g_attacks.offset);
+    EXPECT_EQ(speed.offset % alignof(double), 0u);
+    EXPECT_FALSE(layout.FindSlot<float>("health").IsValid());
+    EXPECT_FALSE(layout.AddSlot<float>("health").IsValid());
+    EXPECT_FALSE(layout.FindSlot<int>("missing").IsValid());
+}
+
+TEST_F(CompiledBehaviorTreeTest, FlattensTreeInPreorder) {
+    builder.Selector()
+               .Sequence().Condition(IsHealthy).Action(Attack).End()
+               .Action(Patrol)
+           .End();
+    auto tree = builder.Build();
+    ASSERT_TRUE(tree);
+    
+    const auto& nodes = tree->GetNodes();
+    ASSERT_EQ(nodes.size(), 5u);
+    EXPECT_EQ(nodes[0].type, BehaviorNodeType::Selector);
+    EXPECT_EQ(nodes[0].childCount, 2u);
+    EXPECT_EQ(nodes[0].next, 5u);
+    EXPECT_EQ(nodes[1].type, BehaviorNodeType::Sequence);
+    EXPECT_EQ(nodes[1].next, 4u);
+    EXPECT_EQ(nodes[4].type, BehaviorNodeType::Action);
+    EXPECT_EQ(tree->GetStateSlotCount(), 2u);
+}
+
+TEST_F(CompiledBehaviorTreeTest, AgentsShareTreeWithSeparateState) {
+    builder.Selector()
+               .Sequence().Condition(IsHealthy).Action(Attack).End()
+               .Action(Patrol)
+           .End();
+    auto tree = builder.Build();
+    ASSERT_TRUE(tree);
+    
+    BehaviorAgentGroup group(tree);
+    uint32_t healthy = group.AddAgent();
+    uint32_t wounded = group.AddAgent();
+    group.GetBlackboard(healthy).Set(g_health, 100);
+    group.GetBlackboard(wounded).Set(g_health, 10);
+    
+    group.TickAll(0.016f);
+    group.TickAll(0.016f);
+    
+    EXPECT_EQ(group.GetBlackboard(healthy).Get(g_attacks), 2);
+    EXPECT_EQ(group.GetBlackboard(healthy).Get(g_patrols), 0);
+    EXPECT_EQ(group.GetBlackboard(wounded).Get(g_attacks), 0);
+    EXPECT_EQ(group.GetBlackboard(wounded).Get(g_patrols), 2);
+    EXPECT_EQ(group.GetStatus(healthy), BehaviorStatus::Success);
+}
+
+TEST_F(CompiledBehaviorTreeTest, SequenceResumesRunningChild) {
+    builder.Sequence().Action(Attack).Action(Walk).Action(Patrol).End();
+    BehaviorAgentGroup group(builder.Build());
+    uint32_t agent = group.AddAgent();
+    
+    EXPECT_EQ(group.Tick(agent, 0.016f), BehaviorStatus::Running);
+    EXPECT_EQ(group.Tick(agent, 0.016f), BehaviorStatus::Running);
+    EXPECT_EQ(group.Tick(agent, 0.016f), BehaviorStatus::Success);
+    
+    // Attack выполнен один раз: на Running последовательность продолжает с Walk
+    Blackboard blackboard = group.GetBlackboard(agent);
+    EXPECT_EQ(blackboard.Get(g_attacks), 1);
+    EXPECT_EQ(blackboard.Get(g_patrols), 1);
+}
+
+TEST_F(CompiledBehaviorTreeTest, DelayUsesDeltaTime) {
+    builder.Sequence().Delay(0.5f).Action(Attack).End();
+    BehaviorAgentGroup group(builder.Build());
+    uint32_t agent = group.AddAgent();
+    
+    EXPECT_EQ(group.Tick(agent, 0.2f), BehaviorStatus::Running);
+    EXPECT_EQ(group.Tick(agent, 0.2f), BehaviorStatus::Running);
+    EXPECT_EQ(group.Tick(agent, 0.2f), BehaviorStatus::Success);
+    EXPECT_EQ(group.Tick(agent, 0.2f), BehaviorStatus::Running);
+    EXPECT_EQ(group.GetBlackboard(agent).Get(g_attacks), 1);
+}
+
+TEST_F(CompiledBehaviorTreeTest, RepeatRunsChildCountTimes) {
+    builder.Repeat(3).Action(Attack).End();
+    BehaviorAgentGroup group(builder.Build());
+    uint32_t agent = group.AddAgent();
+    
+    EXPECT_EQ(group.Tick(agent, 0.016f), BehaviorStatus::Running);
+    EXPECT_EQ(group.Tick(agent, 0.016f), BehaviorStatus::Running);
+    EXPECT_EQ(group.Tick(agent, 0.016f), BehaviorStatus::Success);
+    EXPECT_EQ(group.GetBlackboard(agent).Get(g_attacks), 3);
+}
+
+TEST_F(CompiledBehaviorTreeTest, ParallelAndInverter) {
+    builder.Parallel(2, 1).Action(Walk).Inverter().Action(Fail).End().End();
+    BehaviorAgentGroup group(builder.Build());
+    uint32_t agent = group.AddAgent();
+    
+    EXPECT_EQ(group.Tick(agent, 0.016f), BehaviorStatus::Running);
+    EXPECT_EQ(group.Tick(agent, 0.016f), BehaviorStatus::Running);
+    EXPECT_EQ(group.Tick(agent, 0.016f), BehaviorStatus::Success);
+}
+
+TEST_F(CompiledBehaviorTreeTest, ParallelResetsRunningChildrenOnFinish) {
+    builder.Parallel(1, 2).Sequence().Delay(0.5f).Action(Attack).End().Action(Walk).End();
+    BehaviorAgentGroup group(builder.Build());
+    uint32_t agent = group.AddAgent();
+    
+    // Walk завершается на третьем тике, Delay еще выполняется
+    EXPECT_EQ(group.Tick(agent, 0.1f), BehaviorStatus::Running);
+    EXPECT_EQ(group.Tick(agent, 0.1f), BehaviorStatus::Running);
+    EXPECT_EQ(group.Tick(agent, 0.1f), BehaviorStatus::Success);
+    
+    // Delay начинает отсчет заново, а не с накопленных 0.3 с
+    EXPECT_EQ(group.Tick(agent, 0.1f), BehaviorStatus::Running);
+    EXPECT_EQ(group.Tick(agent, 0.1f), BehaviorStatus::Running);
+    EXPECT_EQ(group.Tick(agent, 0.1f), BehaviorStatus::Success);
+    EXPECT_EQ(group.GetBlackboard(agent).Get(g_attacks), 0);
+}
+
+TEST_F(CompiledBehaviorTreeTest, RemoveAgentMovesLastIntoSlot) {
+    builder.Action(Attack);
+    BehaviorAgentGroup group(builder.Build());
+    for (int i = 0; i < 3; ++i) {
+        uint32_t agent = group.AddAgent();
+        group.GetBlackboard(agent).Set(g_health, i);
+    }
+    
+    group.RemoveAgent(0);
+    ASSERT_EQ(group.GetAgentCount(), 2u);
+    EXPECT_EQ(group.GetBlackboard(0).Get(g_health), 2);
+    EXPECT_EQ(group.GetBlackboard(1).Get(g_health), 1);
+}
+
+TEST_F(CompiledBehaviorTreeTest, InvalidTreesAreRejected) {
+    builder.Sequence().Action(Attack);
+    EXPECT_EQ(builder.Build(), nullptr);
+    
+    BehaviorTreeBuilder decorator;
+    decorator.Inverter().Action(Attack).Action(Patrol).End();
+    EXPECT_EQ(decorator.Build(), nullptr);
+    
+    BehaviorTreeBuilder twoRoots;
+    twoRoots.Action(Attack).Action(Patrol);
+    EXPECT_EQ(twoRoots.Build(), nullptr);
+}
+
+TEST_F(CompiledBehaviorTreeTest, RunningNodeIsResumedWithoutWalkingFromRoot) {
+    builder.Sequence().Action(Attack).Sequence().Sequence().Action(Walk).End().End().Action(Patrol).End();
+    BehaviorAgentGroup group(builder.Build());
+    uint32_t agent = group.AddAgent();
+    
+    EXPECT_EQ(group.Tick(agent, 0.016f), BehaviorStatus::Running);
+    EXPECT_EQ(group.GetResumeNode(agent), 4u);
+    EXPECT_EQ(group.Tick(agent, 0.016f), BehaviorStatus::Running);
+    EXPECT_EQ(group.Tick(agent, 0.016f), BehaviorStatus::Success);
+    EXPECT_EQ(group.GetResumeNode(agent), CompiledBehaviorNode::INVALID_INDEX);
+    EXPECT_EQ(group.GetBlackboard(agent).Get(g_patrols), 1);
+    EXPECT_EQ(group.GetBlackboard(agent).Get(g_attacks), 1);
+}
+
+TEST_F(CompiledBehaviorTreeTest, MatchesNodeGraphTree) {
+    g_random = builder.GetLayout().AddSlot<uint32_t>("random");
+    builder.Selector()
+               .Sequence().Action(RandomAction<1>).Inverter().Action(RandomAction<2>).End().Action(RandomAction<3>).End()
+               .Sequence().Action(RandomAction<4>).Selector().Action(RandomAction<5>).Action(RandomAction<6>).End().End()
+               .Action(RandomAction<7>)
+           .End();
+    BehaviorAgentGroup group(builder.Build());
+    
+    // То же дерево на узлах BehaviorNode
+    std::vector<std::string> legacyLog;
+    uint32_t legacyState = 12345;
+    BehaviorTree legacy;
+    auto action = [&](int id) {
+        return legacy.CreateAction([&legacyLog, &legacyState, id](BehaviorContext&) {
+            legacyLog.push_back(std::to_string(id));
+            return NextOutcome(legacyState);
+        });
+    };
+    auto first = legacy.CreateSequence();
+    auto inverter = legacy.CreateInverter();
+    inverter->AddChild(action(2));
+    first->AddChild(action(1));
+    first->AddChild(inverter);
+    first->AddChild(action(3));
+    auto inner = legacy.CreateSelector();
+    inner->AddChild(action(5));
+    inner->AddChild(action(6));
+    auto second = legacy.CreateSequence();
+    second->AddChild(action(4));
+    second->AddChild(inner);
+    auto root = legacy.CreateSelector();
+    root->AddChild(first);
+    root->AddChild(second);
+    root->AddChild(action(7));
+    legacy.SetRoot(root);
+    
+    uint32_t agent = group.AddAgent();
+    group.GetBlackboard(agent).Set(g_random, 12345u);
+    BehaviorContext context;
+    g_compiledLog.clear();
+    
+    for (int tick = 0; tick < 500; ++tick) {
+        BehaviorStatus expected = legacy.Execute(context);
+        ASSERT_EQ(group.Tick(agent, 0.016f), expected) << "tick " << tick;
+    }
+    EXPECT_EQ(g_compiledLog, legacyLog);
+}
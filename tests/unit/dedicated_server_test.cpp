@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+#include "FastEngine/DedicatedServer.h"
+#include "FastEngine/Engine.h"
+#include "FastEngine/System.h"
+#include "FastEngine/World.h"
+#include "FastEngine/Memory/LinearArena.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+
+using namespace FastEngine;
+
+namespace {
+
+// Система, считающая тики мира и суммарное время
+class CountingSystem : public System {
+public:
+    explicit CountingSystem(World* world) : System(world), ticks(0), time(0.0f) {}
+    void Update(float deltaTime) override {
+        ++ticks;
+        time += deltaTime;
+    }
+
+    int ticks;
+    float time;
+};
+
+} // namespace
+
+TEST(FixedTickLoopTest, KeepsFixedPeriod) {
+    FixedTickLoop loop(FixedTickConfig(200.0f));
+    EXPECT_FLOAT_EQ(loop.GetDeltaTime(), 0.005f);
+
+    int ticks = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 40; ++i) {
+        loop.Step([&ticks](float deltaTime, uint64_t tick) {
+            EXPECT_FLOAT_EQ(deltaTime, 0.005f);
+            EXPECT_EQ(tick, static_cast<uint64_t>(ticks));
+            ++ticks;
+        });
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Первый тик сразу, остальные через период
+    EXPECT_GE(elapsed, 39 * 0.005 - 1e-3);
+    EXPECT_LT(elapsed, 39 * 0.005 + 0.1);
+    TickStats stats = loop.GetStats();
+    EXPECT_EQ(stats.ticks, 40u);
+    EXPECT_EQ(stats.droppedTicks, 0u);
+    EXPECT_NEAR(stats.tickPeriodMs, 5.0, 1e-6);
+    EXPECT_LT(stats.averageWakeErrorMs, 2.0);
+    EXPECT_LT(stats.load, 0.5);
+}
+
+TEST(FixedTickLoopTest, CatchesUpShortStallsAndDropsLongOnes) {
+    FixedTickConfig config(100.0f);
+    config.maxCatchUpTicks = 5;
+    FixedTickLoop loop(config);
+
+    // Тик в 3 периода: следующие тики идут без ожидания, пока не догонят
+    std::vector<std::chrono::steady_clock::time_point> starts;
+    for (int i = 0; i < 6; ++i) {
+        loop.Step([&](float, uint64_t tick) {
+            starts.push_back(std::chrono::steady_clock::now());
+            if (tick == 1) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(30));
+            }
+        });
+    }
+    TickStats stats = loop.GetStats();
+    EXPECT_GE(stats.overruns, 1u);
+    EXPECT_EQ(stats.droppedTicks, 0u);
+    EXPECT_GE(stats.maxTickMs, 30.0);
+    EXPECT_LT(std::chrono::duration<double>(starts[3] - starts[2]).count(), 0.005);
+
+    // Задержка больше maxCatchUpTicks периодов отбрасывается
+    loop.Step([](float, uint64_t) { std::this_thread::sleep_for(std::chrono::milliseconds(120)); });
+    stats = loop.GetStats();
+    EXPECT_GE(stats.droppedTicks, 5u);
+    loop.ResetStats();
+    EXPECT_EQ(loop.GetStats().ticks, 0u);
+}
+
+TEST(FixedTickLoopTest, EachLoopOwnsItsFrameArena) {
+    // Два цикла в разных потоках тикают вперемешку; тик одного не
+    // сбрасывает память кадра, которую держит тик другого
+    std::atomic<int> step(0);
+    std::atomic<bool> failed(false);
+    auto runLoop = [&step, &failed](int parity) {
+        FixedTickLoop loop(FixedTickConfig(1000.0f));
+        size_t peak = 0;
+        for (int i = 0; i < 20; ++i) {
+            loop.Step([&](float, uint64_t) {
+                LinearArena& arena = FrameArena::Get();
+                if (arena.GetUsed() != 0) {
+                    failed = true;
+                }
+                FrameVector<int> values(256, parity);
+                // Ход передается другому циклу посреди тика
+                while (step.load() % 2 != parity) {
+                    std::this_thread::yield();
+                }
+                FrameVector<int> nested(64, 7);
+                step.fetch_add(1);
+                for (int value : values) {
+                    if (value != parity) {
+                        failed = true;
+                    }
+                }
+                if (!arena.Owns(values.data()) || !arena.Owns(nested.data())) {
+                    failed = true;
+                }
+                peak = std::max(peak, arena.GetUsed());
+            });
+        }
+        // Арена не растет от тика к тику
+        if (FrameArena::Get().GetPeakUsed() > peak) {
+            failed = true;
+        }
+        if (FrameArena::GetFrameIndex() != 20u) {
+            failed = true;
+        }
+    };
+    std::thread first(runLoop, 0);
+    std::thread second(runLoop, 1);
+    first.join();
+    second.join();
+    EXPECT_FALSE(failed);
+    EXPECT_EQ(step.load(), 40);
+}
+
+TEST(DedicatedServerTest, RunsMatchesOnSeparateThreads) {
+    DedicatedServer server(FixedTickConfig(100.0f));
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    std::atomic<int> callbacks(0);
+    std::vector<CountingSystem*> systems;
+
+    for (int i = 0; i < 3; ++i) {
+        size_t match = server.AddMatch([&](World&, float deltaTime, uint64_t) {
+            EXPECT_FLOAT_EQ(deltaTime, 0.01f);
+            std::lock_guard<std::mutex> lock(mutex);
+            threads.insert(std::this_thread::get_id());
+            ++callbacks;
+        });
+        systems.push_back(server.GetWorld(match)->AddSystem<CountingSystem>(server.GetWorld(match)));
+    }
+    EXPECT_EQ(server.GetMatchCount(), 3u);
+    EXPECT_FALSE(server.IsMatchRunning(0));
+
+    ASSERT_TRUE(server.Start());
+    EXPECT_TRUE(server.IsRunning());
+    // Матч, добавленный на ходу, стартует сразу
+    size_t late = server.AddMatch(nullptr, [&systems](World& world) {
+        systems.push_back(world.AddSystem<CountingSystem>(&world));
+    });
+    EXPECT_TRUE(server.IsMatchRunning(late));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    server.StopMatch(late);
+    EXPECT_FALSE(server.IsMatchRunning(late));
+    server.Stop();
+    EXPECT_FALSE(server.IsRunning());
+
+    EXPECT_EQ(threads.size(), 3u);
+    for (size_t i = 0; i < systems.size(); ++i) {
+        EXPECT_GE(systems[i]->ticks, 5) << "match " << i;
+        EXPECT_EQ(server.GetMatchStats(i).ticks, static_cast<uint64_t>(systems[i]->ticks));
+        EXPECT_NEAR(systems[i]->time, systems[i]->ticks * 0.01f, 1e-3f);
+    }
+
+    std::ostringstream out;
+    server.WriteStats(out);
+    EXPECT_NE(out.str().find("match 3 ticks"), std::string::npos);
+}
+
+TEST(EngineHeadlessTest, FixedTicksWithoutWindow) {
+    Engine engine;
+    ASSERT_TRUE(engine.InitializeHeadless(FixedTickConfig(500.0f)));
+    EXPECT_TRUE(engine.IsHeadless());
+    EXPECT_EQ(engine.GetRenderer(), nullptr);
+    EXPECT_EQ(engine.GetAudioManager(), nullptr);
+    EXPECT_EQ(engine.GetPlatformName(), "Headless");
+    CountingSystem* system = engine.GetWorld()->AddSystem<CountingSystem>(engine.GetWorld());
+
+    for (int i = 0; i < 10; ++i) {
+        engine.RunOneFrame();
+    }
+    EXPECT_EQ(system->ticks, 10);
+    EXPECT_EQ(engine.GetFrameCount(), 10u);
+    EXPECT_FLOAT_EQ(engine.GetDeltaTime(), 0.002f);
+
+    // Остановка из другого потока завершает Run
+    std::thread stopper([&engine]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        engine.Stop();
+    });
+    engine.Run();
+    stopper.join();
+    EXPECT_GT(system->ticks, 10);
+    EXPECT_EQ(engine.GetTickStats().ticks, static_cast<uint64_t>(system->ticks));
+
+    engine.Shutdown();
+    EXPECT_EQ(engine.GetWorld(), nullptr);
+}
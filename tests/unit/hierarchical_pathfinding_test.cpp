@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include "FastEngine/AI/HierarchicalPathfinding.h"
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace FastEngine;
+
+class HierarchicalPathfindingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Поле 48x48, стена по x = 24 с проходом у верхнего края (y = 44..47)
+        heightmap.assign(48, std::vector<float>(48, 1.0f));
+        for (int y = 0; y < 44; ++y) {
+            heightmap[y][24] = 0.0f;
+        }
+        
+        navMesh = std::make_shared<NavMesh>();
+        ASSERT_TRUE(navMesh->GenerateFromHeightmap(heightmap, 1.0f, 0.5f));
+        
+        hpa.SetClusterSize(8.0f);
+        hpa.SetSmoothing(false);
+        ASSERT_TRUE(hpa.Build(navMesh));
+        
+        astar.SetSmoothing(false);
+        astar.SetMaxIterations(1000000);
+    }
+    
+    int NodeAt(int x, int y) const { return y * 48 + x; }
+    
+    // Новая версия сетки, как EditNavMesh у PathfindingManager
+    std::shared_ptr<NavMesh> SetColumnWalkable(const NavMesh& source, int x, int y0, int y1, bool walkable) const {
+        auto edited = std::make_shared<NavMesh>(source);
+        for (int y = y0; y < y1; ++y) {
+            edited->SetNodeWalkable(NodeAt(x, y), walkable);
+        }
+        return edited;
+    }
+    
+    std::vector<std::vector<float>> heightmap;
+    std::shared_ptr<NavMesh> navMesh;
+    HierarchicalPathfinder hpa;
+    AStarPathfinding astar;
+};
+
+TEST_F(HierarchicalPathfindingTest, BuildsClustersAndPortals) {
+    EXPECT_EQ(hpa.GetClusterCount(), 36);
+    EXPECT_GT(hpa.GetPortalCount(), 0u);
+}
+
+TEST_F(HierarchicalPathfindingTest, PathGoesThroughGap) {
+    PathfindingResult result = hpa.FindPath(glm::vec3(2.0f, 1.0f, 2.0f), glm::vec3(45.0f, 1.0f, 2.0f));
+    ASSERT_TRUE(result.success);
+    
+    bool throughGap = false;
+    for (const auto& point : result.path) {
+        ASSERT_TRUE(navMesh->IsWalkable(point));
+        if (std::abs(point.x - 24.0f) < 0.01f) {
+            EXPECT_GE(point.z, 44.0f);
+            throughGap = true;
+        }
+    }
+    EXPECT_TRUE(throughGap);
+}
+
+TEST_F(HierarchicalPathfindingTest, CostIsCloseToOptimal) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> coord(0, 47);
+    
+    int compared = 0;
+    for (int i = 0; i < 50; ++i) {
+        glm::vec3 start(coord(rng), 1.0f, coord(rng));
+        glm::vec3 end(coord(rng), 1.0f, coord(rng));
+        if (!navMesh->IsWalkable(start) || !navMesh->IsWalkable(end)) continue;
+        
+        PathfindingResult optimal = astar.FindPath(*navMesh, start, end);
+        PathfindingResult hierarchical = hpa.FindPath(start, end);
+        ASSERT_EQ(optimal.success, hierarchical.success);
+        if (!optimal.success) continue;
+        
+        EXPECT_GE(hierarchical.totalCost, optimal.totalCost - 1e-3f);
+        // Крюк через порталы ограничен половиной кластера на каждом конце
+        EXPECT_LE(hierarchical.totalCost, optimal.totalCost * 1.2f + 8.0f);
+        ++compared;
+    }
+    EXPECT_GT(compared, 20);
+}
+
+TEST_F(HierarchicalPathfindingTest, RepeatedQueryHitsCache) {
+    glm::vec3 start(2.0f, 1.0f, 2.0f);
+    glm::vec3 end(45.0f, 1.0f, 2.0f);
+    
+    PathfindingResult first = hpa.FindPath(start, end);
+    PathfindingResult second = hpa.FindPath(start, end);
+    ASSERT_TRUE(first.success);
+    ASSERT_TRUE(second.success);
+    EXPECT_EQ(hpa.GetCacheMisses(), 1);
+    EXPECT_EQ(hpa.GetCacheHits(), 1);
+    EXPECT_EQ(first.path, second.path);
+}
+
+TEST_F(HierarchicalPathfindingTest, RepairsAfterClosingAndOpeningPassage) {
+    glm::vec3 start(2.0f, 1.0f, 2.0f);
+    glm::vec3 end(45.0f, 1.0f, 2.0f);
+    ASSERT_TRUE(hpa.FindPath(start, end).success);
+    
+    // Закрываем проход - пути нет, кэшированный путь не используется
+    std::shared_ptr<NavMesh> closed = SetColumnWalkable(*navMesh, 24, 44, 48, false);
+    ASSERT_TRUE(hpa.UpdateNavMesh(closed));
+    EXPECT_EQ(hpa.GetNavMesh(), closed);
+    EXPECT_FALSE(hpa.FindPath(start, end).success);
+    EXPECT_TRUE(navMesh->GetNodes()[NodeAt(24, 45)].walkable); // Исходный снимок не изменен
+    
+    // Открываем проход снизу - путь стал короче
+    std::shared_ptr<NavMesh> reopenedMesh = SetColumnWalkable(*closed, 24, 0, 4, true);
+    ASSERT_TRUE(hpa.UpdateNavMesh(reopenedMesh));
+    PathfindingResult reopened = hpa.FindPath(start, end);
+    ASSERT_TRUE(reopened.success);
+    
+    PathfindingResult optimal = astar.FindPath(*reopenedMesh, start, end);
+    ASSERT_TRUE(optimal.success);
+    EXPECT_LE(reopened.totalCost, optimal.totalCost * 1.2f + 8.0f);
+    for (const auto& point : reopened.path) {
+        EXPECT_LT(point.z, 44.0f);
+    }
+}
+
+TEST_F(HierarchicalPathfindingTest, RebuildsWhenTopologyChanges) {
+    // Сетка другого размера - граф строится заново, а не чинится по узлам
+    auto smaller = std::make_shared<NavMesh>();
+    std::vector<std::vector<float>> field(16, std::vector<float>(16, 1.0f));
+    ASSERT_TRUE(smaller->GenerateFromHeightmap(field, 1.0f, 0.5f));
+    ASSERT_TRUE(hpa.UpdateNavMesh(smaller));
+    EXPECT_EQ(hpa.GetClusterCount(), 4);
+    
+    PathfindingResult result = hpa.FindPath(glm::vec3(1.0f, 1.0f, 1.0f), glm::vec3(14.0f, 1.0f, 14.0f));
+    ASSERT_TRUE(result.success);
+    for (const auto& point : result.path) {
+        EXPECT_TRUE(smaller->IsWalkable(point));
+    }
+    EXPECT_FALSE(hpa.UpdateNavMesh(nullptr));
+}
@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+#include "FastEngine/Input/InputManager.h"
+#include "FastEngine/Profiling/ScopeProfiler.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace FastEngine;
+
+namespace {
+
+class InputManagerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(input.Initialize());
+    }
+
+    void TearDown() override {
+        input.Shutdown();
+    }
+
+    InputManager input;
+};
+
+} // namespace
+
+TEST_F(InputManagerTest, EventsApplyOnUpdate) {
+    input.OnKeyDown(26);
+    // До Update кадр видит прежнее состояние
+    EXPECT_FALSE(input.IsKeyPressed(26));
+
+    input.Update(0.016f);
+    EXPECT_TRUE(input.IsKeyPressed(26));
+    EXPECT_TRUE(input.IsKeyJustPressed(26));
+    EXPECT_EQ(input.GetSnapshot().frame, 1u);
+    EXPECT_EQ(input.GetSnapshot().eventCount, 1u);
+
+    // Удержание переносится, "только что" - нет
+    input.Update(0.016f);
+    EXPECT_TRUE(input.IsKeyPressed(26));
+    EXPECT_FALSE(input.IsKeyJustPressed(26));
+    EXPECT_EQ(input.GetSnapshot().eventCount, 0u);
+
+    input.OnKeyUp(26);
+    input.Update(0.016f);
+    EXPECT_FALSE(input.IsKeyPressed(26));
+    EXPECT_TRUE(input.IsKeyJustReleased(26));
+
+    // Нажатие и отпускание в одном кадре не теряются
+    input.OnKeyDown(4);
+    input.OnKeyUp(4);
+    input.Update(0.016f);
+    EXPECT_FALSE(input.IsKeyPressed(4));
+    EXPECT_TRUE(input.IsKeyJustPressed(4));
+    EXPECT_TRUE(input.IsKeyJustReleased(4));
+
+    // Коды вне диапазона игнорируются
+    input.OnKeyDown(-1);
+    input.OnKeyDown(InputSnapshot::MAX_KEYS);
+    input.Update(0.016f);
+    EXPECT_FALSE(input.IsKeyPressed(-1));
+    EXPECT_FALSE(input.IsKeyPressed(InputSnapshot::MAX_KEYS));
+}
+
+TEST_F(InputManagerTest, TouchLifecycle) {
+    input.OnTouchDown(7, 10.0f, 20.0f);
+    input.OnTouchMove(7, 15.0f, 25.0f);
+    input.OnTouchMove(3, 1.0f, 1.0f); // Без нажатия - игнорируется
+    input.Update(0.016f);
+
+    const InputSnapshot& first = input.GetSnapshot();
+    ASSERT_EQ(first.touchCount, 1u);
+    const InputSnapshot::Touch* touch = first.FindTouch(7);
+    ASSERT_NE(touch, nullptr);
+    EXPECT_TRUE(touch->down);
+    EXPECT_TRUE(touch->pressed);
+    EXPECT_FLOAT_EQ(touch->delta.x, 5.0f);
+    EXPECT_TRUE(input.IsTouchJustPressed(7));
+    EXPECT_FLOAT_EQ(input.GetTouchPosition(7).y, 25.0f);
+    ASSERT_EQ(input.GetActiveTouches().size(), 1u);
+    EXPECT_EQ(input.GetActiveTouches()[0].id, 7);
+
+    input.Update(0.016f);
+    EXPECT_TRUE(input.IsTouchPressed(7));
+    EXPECT_FALSE(input.IsTouchJustPressed(7));
+    EXPECT_FLOAT_EQ(input.GetSnapshot().FindTouch(7)->delta.x, 0.0f);
+
+    input.OnTouchUp(7, 30.0f, 25.0f);
+    input.Update(0.016f);
+    EXPECT_FALSE(input.IsTouchPressed(7));
+    EXPECT_TRUE(input.IsTouchJustReleased(7));
+    EXPECT_FLOAT_EQ(input.GetTouchPosition(7).x, 30.0f);
+
+    // Отпущенное касание исчезает в следующем кадре
+    input.Update(0.016f);
+    EXPECT_EQ(input.GetSnapshot().touchCount, 0u);
+    EXPECT_TRUE(input.GetActiveTouches().empty());
+}
+
+TEST_F(InputManagerTest, CallbacksRunAfterPublish) {
+    std::vector<InputManager::KeyEvent> keys;
+    bool stateVisible = false;
+    input.OnKeyDownCallback = [&](const InputManager::KeyEvent& event) {
+        keys.push_back(event);
+        stateVisible = input.IsKeyPressed(event.key);
+    };
+    int touchUps = 0;
+    input.OnTouchUpCallback = [&](const InputManager::TouchPoint& point) {
+        EXPECT_EQ(point.id, 0);
+        touchUps++;
+    };
+
+    input.OnKeyDown(44);
+    input.OnKeyDown(44); // Автоповтор
+    input.OnTouchDown(0, 1.0f, 1.0f);
+    input.OnTouchUp(0, 1.0f, 1.0f);
+    input.Update(0.016f);
+
+    ASSERT_EQ(keys.size(), 2u);
+    EXPECT_TRUE(keys[0].pressed);
+    EXPECT_FALSE(keys[0].repeated);
+    EXPECT_FALSE(keys[1].pressed);
+    EXPECT_TRUE(keys[1].repeated);
+    EXPECT_TRUE(stateVisible);
+    EXPECT_EQ(touchUps, 1);
+}
+
+TEST_F(InputManagerTest, OverflowIsCounted) {
+    const size_t extra = 10;
+    for (size_t i = 0; i < InputManager::EVENT_QUEUE_CAPACITY + extra; ++i) {
+        input.OnTouchMove(0, static_cast<float>(i), 0.0f);
+    }
+    input.Update(0.016f);
+    EXPECT_EQ(input.GetSnapshot().eventCount, InputManager::EVENT_QUEUE_CAPACITY);
+    EXPECT_EQ(input.GetSnapshot().droppedEvents, extra);
+    EXPECT_EQ(input.GetDroppedEventCount(), extra);
+
+    input.Update(0.016f);
+    EXPECT_EQ(input.GetSnapshot().droppedEvents, 0u);
+}
+
+TEST_F(InputManagerTest, LatencyFromEventToPresent) {
+    // Событие "произошло" 5 мс назад
+    uint64_t ticks = ProfileClock::Now();
+    uint64_t past = ticks - static_cast<uint64_t>(ProfileClock::GetTicksPerMillisecond() * 5.0);
+    input.OnKeyDown(30, past);
+    input.Update(0.016f);
+    EXPECT_EQ(input.GetSnapshot().oldestEventTicks, past);
+    EXPECT_GE(input.GetSnapshot().publishTicks, ticks);
+
+    input.OnFramePresented();
+    EXPECT_GE(input.GetLastLatencyMs(), 4.5);
+    EXPECT_EQ(input.GetLatencyStats().GetCount(), 1u);
+
+    // Кадр без событий и повторный показ не учитываются
+    input.OnFramePresented();
+    input.Update(0.016f);
+    input.OnFramePresented();
+    EXPECT_EQ(input.GetLatencyStats().GetCount(), 1u);
+}
+
+TEST_F(InputManagerTest, PlatformThreadFeedsGameThread) {
+    const int presses = 2000;
+    std::atomic<bool> producerDone(false);
+
+    // Поток платформы шлет нажатия, игровой поток публикует снимки,
+    // третий поток читает их без блокировок
+    std::thread platform([&]() {
+        for (int i = 0; i < presses; ++i) {
+            input.OnKeyDown(i % 64);
+            input.OnKeyUp(i % 64);
+            if (i % 128 == 0) {
+                std::this_thread::yield();
+            }
+        }
+        producerDone.store(true);
+    });
+
+    // Читатель обязан закончить со снимком за MAX_FRAMES_IN_FLIGHT кадров:
+    // игровой поток не уходит дальше, чем на кадр вперед подтверждения
+    std::atomic<bool> readerStop(false);
+    std::atomic<uint64_t> readerAck(0);
+    std::atomic<int> readerErrors(0);
+    std::thread reader([&]() {
+        uint64_t lastFrame = 0;
+        while (!readerStop.load()) {
+            const InputSnapshot& snapshot = input.GetSnapshot();
+            uint64_t frame = snapshot.frame;
+            size_t changed = snapshot.keysPressed.count() + snapshot.keysReleased.count();
+            if (frame < lastFrame || changed > snapshot.eventCount || snapshot.frame != frame) {
+                readerErrors.fetch_add(1);
+            }
+            lastFrame = frame;
+            readerAck.store(frame);
+        }
+    });
+
+    auto update = [&]() {
+        input.Update(0.016f);
+        uint64_t frame = input.GetSnapshot().frame;
+        while (readerAck.load() + 1 < frame) {
+            std::this_thread::yield();
+        }
+        return input.GetSnapshot().eventCount;
+    };
+
+    uint64_t applied = 0;
+    while (!producerDone.load()) {
+        applied += update();
+    }
+    platform.join();
+    applied += update();
+    readerStop.store(true);
+    reader.join();
+
+    EXPECT_EQ(applied + input.GetDroppedEventCount(), static_cast<uint64_t>(presses * 2));
+    EXPECT_EQ(input.GetSnapshot().keysDown.count(), 0u);
+    EXPECT_EQ(readerErrors.load(), 0);
+}
@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include "FastEngine/Engine.h"
+#include "FastEngine/World.h"
+#include "FastEngine/Input/InputManager.h"
+#include "FastEngine/Input/InputRecording.h"
+#include "FastEngine/Profiling/QuantileSketch.h"
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace FastEngine;
+
+namespace {
+
+InputEvent MakeEvent(InputEvent::Type type, int code, float x = 0.0f, float y = 0.0f) {
+    InputEvent event;
+    event.ticks = 0;
+    event.code = code;
+    event.x = x;
+    event.y = y;
+    event.type = type;
+    return event;
+}
+
+// Сессия: удержание клавиши, касание с движением, отпускание
+void PlaySession(InputManager& input, std::vector<InputSnapshot>& snapshots) {
+    for (int frame = 0; frame < 30; ++frame) {
+        if (frame == 2) {
+            input.OnKeyDown(26);
+        }
+        if (frame == 5) {
+            input.OnTouchDown(1, 100.0f, 50.0f);
+        }
+        if (frame > 5 && frame < 20) {
+            input.OnTouchMove(1, 100.0f + frame, 50.0f - frame * 0.5f);
+        }
+        if (frame == 20) {
+            input.OnTouchUp(1, 120.0f, 40.0f);
+            input.OnKeyUp(26);
+            input.OnKeyDown(-3); // Вне диапазона, но записывается как есть
+        }
+        input.Update(frame < 10 ? 0.016f : 0.033f);
+        snapshots.push_back(input.GetSnapshot());
+    }
+}
+
+} // namespace
+
+TEST(InputRecordingTest, SerializeRoundTrip) {
+    InputRecording recording;
+    std::vector<InputEvent> events = {
+        MakeEvent(InputEvent::KEY_DOWN, 44),
+        MakeEvent(InputEvent::TOUCH_DOWN, 3, 1.5f, -2.25f),
+        MakeEvent(InputEvent::TOUCH_MOVE, 3, 1000.0f, 2000.0f),
+        MakeEvent(InputEvent::KEY_UP, -100000),
+    };
+    recording.AddFrame(0.016f, events.data(), 2);
+    for (int i = 0; i < 100; ++i) {
+        recording.AddFrame(0.016f, nullptr, 0);
+    }
+    recording.AddFrame(0.5f, events.data() + 2, 2);
+    EXPECT_EQ(recording.GetFrameCount(), 102u);
+    EXPECT_EQ(recording.GetEventCount(), 4u);
+    EXPECT_NEAR(recording.GetDuration(), 101 * 0.016 + 0.5, 1e-4);
+
+    std::vector<uint8_t> data;
+    ASSERT_TRUE(recording.Serialize(data));
+    // Пустые кадры с прежним шагом - по 9 бит
+    EXPECT_LT(data.size(), 160u);
+
+    InputRecording loaded;
+    ASSERT_TRUE(loaded.Deserialize(data.data(), data.size()));
+    ASSERT_EQ(loaded.GetFrameCount(), recording.GetFrameCount());
+    ASSERT_EQ(loaded.GetEventCount(), recording.GetEventCount());
+    for (size_t f = 0; f < loaded.GetFrameCount(); ++f) {
+        const InputRecording::Frame& a = recording.GetFrame(f);
+        const InputRecording::Frame& b = loaded.GetFrame(f);
+        ASSERT_EQ(a.deltaTime, b.deltaTime) << "frame " << f;
+        ASSERT_EQ(a.eventCount, b.eventCount) << "frame " << f;
+        for (uint32_t i = 0; i < a.eventCount; ++i) {
+            const InputEvent& x = recording.GetEvents(a)[i];
+            const InputEvent& y = loaded.GetEvents(b)[i];
+            EXPECT_EQ(x.type, y.type);
+            EXPECT_EQ(x.code, y.code);
+            EXPECT_EQ(x.x, y.x);
+            EXPECT_EQ(x.y, y.y);
+        }
+    }
+}
+
+TEST(InputRecordingTest, RejectsCorruptedData) {
+    InputRecording recording;
+    InputEvent event = MakeEvent(InputEvent::TOUCH_MOVE, 0, 1.0f, 2.0f);
+    for (int i = 0; i < 10; ++i) {
+        recording.AddFrame(0.01f * (i + 1), &event, 1);
+    }
+    std::vector<uint8_t> data;
+    ASSERT_TRUE(recording.Serialize(data));
+
+    InputRecording loaded;
+    EXPECT_FALSE(loaded.Deserialize(data.data(), data.size() / 2));
+    EXPECT_TRUE(loaded.IsEmpty());
+
+    std::vector<uint8_t> wrongMagic = data;
+    wrongMagic[0] ^= 0xFF;
+    EXPECT_FALSE(loaded.Deserialize(wrongMagic.data(), wrongMagic.size()));
+    EXPECT_FALSE(loaded.Deserialize(nullptr, 0));
+    EXPECT_FALSE(loaded.LoadFromFile("nonexistent_input_recording.feir"));
+
+    ASSERT_TRUE(loaded.Deserialize(data.data(), data.size()));
+    EXPECT_EQ(loaded.GetFrameCount(), 10u);
+}
+
+TEST(InputRecordingTest, ReplayReproducesSnapshots) {
+    // Запись живой сессии через InputManager
+    InputRecording recording;
+    std::vector<InputSnapshot> recorded;
+    {
+        InputManager input;
+        ASSERT_TRUE(input.Initialize());
+        input.StartRecording(&recording);
+        PlaySession(input, recorded);
+        input.StopRecording();
+        input.Update(0.016f); // После StopRecording кадры не пишутся
+    }
+    ASSERT_EQ(recording.GetFrameCount(), 30u);
+
+    const std::string path = "input_recording_test.feir";
+    ASSERT_TRUE(recording.SaveToFile(path));
+    auto loaded = std::make_shared<InputRecording>();
+    ASSERT_TRUE(loaded->LoadFromFile(path));
+    std::remove(path.c_str());
+
+    // Воспроизведение движком: записанный шаг и те же снимки по кадрам
+    Engine engine;
+    ASSERT_TRUE(engine.InitializeReplay(loaded));
+    EXPECT_TRUE(engine.IsReplaying());
+    EXPECT_TRUE(engine.IsHeadless());
+    EXPECT_EQ(engine.GetRenderer(), nullptr);
+
+    size_t frame = 0;
+    std::vector<float> deltas;
+    engine.SetUpdateCallback([&](float deltaTime) {
+        const InputSnapshot& snapshot = engine.GetInputManager()->GetSnapshot();
+        ASSERT_LT(frame, recorded.size());
+        EXPECT_EQ(snapshot.keysDown, recorded[frame].keysDown) << "frame " << frame;
+        EXPECT_EQ(snapshot.keysPressed, recorded[frame].keysPressed) << "frame " << frame;
+        EXPECT_EQ(snapshot.keysReleased, recorded[frame].keysReleased) << "frame " << frame;
+        ASSERT_EQ(snapshot.touchCount, recorded[frame].touchCount) << "frame " << frame;
+        for (uint32_t i = 0; i < snapshot.touchCount; ++i) {
+            EXPECT_EQ(snapshot.touches[i].position, recorded[frame].touches[i].position);
+            EXPECT_EQ(snapshot.touches[i].released, recorded[frame].touches[i].released);
+        }
+        deltas.push_back(deltaTime);
+        frame++;
+    });
+    engine.Run();
+
+    EXPECT_FALSE(engine.IsRunning());
+    EXPECT_EQ(frame, 30u);
+    EXPECT_EQ(engine.GetFrameCount(), 30u);
+    ASSERT_EQ(deltas.size(), 30u);
+    EXPECT_FLOAT_EQ(deltas[0], 0.016f);
+    EXPECT_FLOAT_EQ(deltas[29], 0.033f);
+    ASSERT_NE(engine.GetReplayFrameTimes(), nullptr);
+    EXPECT_EQ(engine.GetReplayFrameTimes()->GetCount(), 30u);
+    engine.Shutdown();
+
+    // Фиксированный шаг и прогрев
+    Engine fixed;
+    ReplayConfig config;
+    config.fixedDeltaTime = 0.01f;
+    config.warmupFrames = 10;
+    ASSERT_TRUE(fixed.InitializeReplay(loaded, config));
+    float total = 0.0f;
+    fixed.SetUpdateCallback([&total](float deltaTime) { total += deltaTime; });
+    while (fixed.IsRunning()) {
+        fixed.RunOneFrame();
+    }
+    EXPECT_NEAR(total, 0.3f, 1e-4f);
+    EXPECT_EQ(fixed.GetReplayFrameTimes()->GetCount(), 20u);
+
+    Engine empty;
+    EXPECT_FALSE(empty.InitializeReplay(std::make_shared<InputRecording>()));
+}
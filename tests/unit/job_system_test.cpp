@@ -0,0 +1,311 @@
+#include <gtest/gtest.h>
+#include "FastEngine/Jobs/JobSystem.h"
+#include "FastEngine/Jobs/WorkStealingDeque.h"
+#include "FastEngine/Memory/LinearArena.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace FastEngine;
+
+namespace {
+
+// Планировщик запущен на время теста
+class JobSystemTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(JobSystem::GetInstance().Start(3));
+    }
+
+    void TearDown() override {
+        JobSystem::GetInstance().Stop();
+    }
+};
+
+} // namespace
+
+TEST(WorkStealingDequeTest, OwnerIsLifoAndThievesAreFifo) {
+    WorkStealingDeque<int> deque(4);
+    EXPECT_EQ(deque.GetCapacity(), 4u);
+    for (int i = 1; i <= 4; ++i) {
+        EXPECT_TRUE(deque.Push(i));
+    }
+    EXPECT_FALSE(deque.Push(5));
+    EXPECT_EQ(deque.GetSize(), 4u);
+
+    int value = 0;
+    EXPECT_TRUE(deque.Pop(value));
+    EXPECT_EQ(value, 4);
+    EXPECT_TRUE(deque.Steal(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(deque.Steal(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_TRUE(deque.Pop(value));
+    EXPECT_EQ(value, 3);
+    EXPECT_FALSE(deque.Pop(value));
+    EXPECT_FALSE(deque.Steal(value));
+    EXPECT_TRUE(deque.IsEmpty());
+
+    // После опустошения индексы продолжают расти по кругу
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(deque.Push(i));
+        EXPECT_TRUE(deque.Pop(value));
+        EXPECT_EQ(value, i);
+    }
+}
+
+TEST(WorkStealingDequeTest, EveryItemIsTakenExactlyOnce) {
+    const int items = 20000;
+    WorkStealingDeque<int> deque(256);
+    std::vector<std::atomic<int>> taken(items);
+    for (auto& count : taken) {
+        count.store(0);
+    }
+    std::atomic<bool> done(false);
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; ++t) {
+        thieves.emplace_back([&]() {
+            int value = 0;
+            while (!done.load()) {
+                if (deque.Steal(value)) {
+                    taken[value].fetch_add(1);
+                }
+            }
+        });
+    }
+
+    int value = 0;
+    for (int i = 0; i < items; ++i) {
+        while (!deque.Push(i)) {
+            if (deque.Pop(value)) {
+                taken[value].fetch_add(1);
+            }
+        }
+        if (i % 3 == 0 && deque.Pop(value)) {
+            taken[value].fetch_add(1);
+        }
+    }
+    while (deque.Pop(value)) {
+        taken[value].fetch_add(1);
+    }
+    while (!deque.IsEmpty()) {
+        std::this_thread::yield();
+    }
+    done.store(true);
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    for (int i = 0; i < items; ++i) {
+        ASSERT_EQ(taken[i].load(), 1) << "item " << i;
+    }
+}
+
+TEST(JobSystemInlineTest, RunsImmediatelyWhenStopped) {
+    JobSystem& jobs = JobSystem::GetInstance();
+    ASSERT_FALSE(jobs.IsRunning());
+    EXPECT_EQ(JobSystem::GetThreadIndex(), JobSystem::NO_THREAD);
+
+    JobCounter counter;
+    int value = 0;
+    jobs.Schedule([&value]() { value = 42; }, &counter);
+    EXPECT_EQ(value, 42);
+    EXPECT_TRUE(counter.IsDone());
+    jobs.Wait(counter);
+
+    std::vector<int> data(100, 1);
+    int sum = 0;
+    jobs.ParallelFor(0, data.size(), [&](size_t i) { sum += data[i]; });
+    EXPECT_EQ(sum, 100);
+}
+
+TEST_F(JobSystemTest, ExecutesAllScheduledJobs) {
+    JobSystem& jobs = JobSystem::GetInstance();
+    EXPECT_EQ(jobs.GetWorkerCount(), 3u);
+    EXPECT_EQ(jobs.GetThreadCount(), 4u);
+    EXPECT_EQ(JobSystem::GetThreadIndex(), 0u);
+    EXPECT_FALSE(jobs.Start(2));
+
+    const int count = 10000;
+    std::atomic<int> executed(0);
+    JobCounter counter;
+    for (int i = 0; i < count; ++i) {
+        jobs.Schedule([&executed]() { executed.fetch_add(1, std::memory_order_relaxed); }, &counter);
+    }
+    jobs.Wait(counter);
+    EXPECT_EQ(executed.load(), count);
+    EXPECT_TRUE(counter.IsDone());
+    EXPECT_EQ(jobs.GetPendingCount(), 0u);
+
+    JobSystemStats stats = jobs.GetStats();
+    EXPECT_GE(stats.executed, static_cast<uint64_t>(count));
+    EXPECT_EQ(stats.workers, 3u);
+
+    // Счетчик переиспользуется после Wait
+    jobs.Schedule([&executed]() { executed.fetch_add(1); }, &counter);
+    jobs.Wait(counter);
+    EXPECT_EQ(executed.load(), count + 1);
+}
+
+TEST_F(JobSystemTest, DependenciesFormGraph) {
+    JobSystem& jobs = JobSystem::GetInstance();
+
+    // a -> (b1, b2) -> c
+    std::atomic<int> step(0);
+    std::array<int, 4> order = {{-1, -1, -1, -1}};
+    JobCounter aDone, bDone, cDone;
+
+    // a медленный: b и c встают в списки ожидания, а не в очередь
+    jobs.Schedule([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        order[0] = step.fetch_add(1);
+    }, &aDone);
+    jobs.Schedule([&]() { order[2] = step.fetch_add(1); }, &bDone, &aDone);
+    jobs.Schedule([&]() { order[3] = step.fetch_add(1); }, &bDone, &aDone);
+    jobs.Schedule([&]() { order[1] = step.fetch_add(1); }, &cDone, &bDone);
+
+    jobs.Wait(cDone);
+    EXPECT_TRUE(aDone.IsDone());
+    EXPECT_TRUE(bDone.IsDone());
+    EXPECT_EQ(order[0], 0);
+    EXPECT_GE(order[2], 1);
+    EXPECT_GE(order[3], 1);
+    EXPECT_LE(order[2], 2);
+    EXPECT_LE(order[3], 2);
+    EXPECT_EQ(order[1], 3);
+}
+
+TEST_F(JobSystemTest, ParallelForCoversRangeOnce) {
+    JobSystem& jobs = JobSystem::GetInstance();
+
+    const size_t count = 100000;
+    std::vector<uint8_t> visits(count, 0);
+    jobs.ParallelFor(0, count, [&visits](size_t i) { visits[i]++; });
+    for (size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(visits[i], 1) << "index " << i;
+    }
+
+    // Порции не мельче minChunk, кроме остатков после деления
+    std::atomic<size_t> chunks(0);
+    std::atomic<size_t> covered(0);
+    jobs.ParallelForRange(10, 10 + count, [&](size_t first, size_t last) {
+        chunks.fetch_add(1);
+        covered.fetch_add(last - first);
+    }, 1000);
+    EXPECT_EQ(covered.load(), count);
+    EXPECT_LE(chunks.load(), 2 * count / 1000);
+
+    jobs.ParallelFor(5, 5, [](size_t) { FAIL(); });
+}
+
+TEST_F(JobSystemTest, NestedParallelForHelpsInsteadOfBlocking) {
+    JobSystem& jobs = JobSystem::GetInstance();
+
+    // Вложенные Wait на всех потоках сразу не должны зависнуть
+    const size_t outer = 16;
+    const size_t inner = 2000;
+    std::vector<uint64_t> sums(outer, 0);
+    jobs.ParallelFor(0, outer, [&](size_t i) {
+        std::atomic<uint64_t> sum(0);
+        jobs.ParallelFor(0, inner, [&sum](size_t j) { sum.fetch_add(j, std::memory_order_relaxed); }, 64);
+        sums[i] = sum.load();
+    });
+    for (uint64_t sum : sums) {
+        EXPECT_EQ(sum, inner * (inner - 1) / 2);
+    }
+}
+
+TEST_F(JobSystemTest, ForeignThreadsAndLargeCallables) {
+    JobSystem& jobs = JobSystem::GetInstance();
+
+    std::atomic<int> value(0);
+    std::thread foreign([&]() {
+        EXPECT_EQ(JobSystem::GetThreadIndex(), JobSystem::NO_THREAD);
+        JobCounter counter;
+        for (int i = 0; i < 100; ++i) {
+            jobs.Schedule([&value]() { value.fetch_add(1); }, &counter);
+        }
+        jobs.Wait(counter);
+    });
+    foreign.join();
+    EXPECT_EQ(value.load(), 100);
+    EXPECT_GE(jobs.GetStats().injected, 100u);
+
+    // Не помещается в задание - хранится в куче
+    std::array<uint64_t, 32> payload;
+    std::iota(payload.begin(), payload.end(), 1);
+    uint64_t sum = 0;
+    JobCounter counter;
+    jobs.Schedule([payload, &sum]() { sum = std::accumulate(payload.begin(), payload.end(), uint64_t(0)); }, &counter);
+    jobs.Wait(counter);
+    EXPECT_EQ(sum, 32u * 33u / 2u);
+}
+
+TEST_F(JobSystemTest, WaitKeepsCallerFrameMemory) {
+    JobSystem& jobs = JobSystem::GetInstance();
+    std::atomic<int> broken(0);
+
+    // Задание на рабочем потоке ждет вложенные: его память кадра жива
+    auto nested = [&jobs, &broken]() {
+        FrameVector<int> outer(512, 3);
+        JobCounter inner;
+        for (int i = 0; i < 64; ++i) {
+            jobs.Schedule([]() { FrameVector<int> scratch(256, 1); }, &inner);
+        }
+        jobs.Wait(inner);
+        for (int value : outer) {
+            if (value != 3) {
+                broken.fetch_add(1);
+                break;
+            }
+        }
+    };
+
+    // Поток кадра помогает в Wait, но его арена не сбрасывается
+    FrameArena::BeginFrame();
+    LinearArena& arena = FrameArena::Get();
+    FrameVector<int> values(1024, 7);
+    const uint64_t generation = arena.GetGeneration();
+    JobCounter counter;
+    for (int i = 0; i < 32; ++i) {
+        jobs.Schedule(nested, &counter);
+    }
+    jobs.Wait(counter);
+
+    EXPECT_EQ(arena.GetGeneration(), generation);
+    EXPECT_TRUE(arena.Owns(values.data()));
+    for (int value : values) {
+        ASSERT_EQ(value, 7);
+    }
+    EXPECT_EQ(broken.load(), 0);
+}
+
+TEST_F(JobSystemTest, StopDrainsPendingJobs) {
+    JobSystem& jobs = JobSystem::GetInstance();
+
+    std::atomic<int> executed(0);
+    for (int i = 0; i < 500; ++i) {
+        jobs.Schedule([&executed]() {
+            std::this_thread::yield();
+            executed.fetch_add(1);
+        });
+    }
+    // Исключение в задании не теряет счетчик
+    JobCounter counter;
+    jobs.Schedule([]() { throw std::runtime_error("job failure"); }, &counter);
+    jobs.Wait(counter);
+
+    jobs.Stop();
+    EXPECT_FALSE(jobs.IsRunning());
+    EXPECT_EQ(executed.load(), 500);
+    EXPECT_EQ(jobs.GetPendingCount(), 0u);
+
+    // TearDown повторно вызывает Stop - без эффекта
+    ASSERT_TRUE(jobs.Start(1));
+}
@@ -0,0 +1,358 @@
+#include <gtest/gtest.h>
+#include "FastEngine/Memory/LinearArena.h"
+#include "FastEngine/Memory/MemoryResource.h"
+#include "FastEngine/Memory/PoolAllocator.h"
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace FastEngine;
+
+namespace {
+
+bool IsAligned(const void* pointer, size_t alignment) {
+    return reinterpret_cast<uintptr_t>(pointer) % alignment == 0;
+}
+
+struct Tracked {
+    static int s_alive;
+    int value;
+
+    explicit Tracked(int v) : value(v) { s_alive++; }
+    ~Tracked() { s_alive--; }
+};
+
+int Tracked::s_alive = 0;
+
+struct Throwing {
+    explicit Throwing(bool fail) {
+        if (fail) {
+            throw std::runtime_error("fail");
+        }
+    }
+};
+
+} // namespace
+
+TEST(LinearArenaTest, AlignsAndRewinds) {
+    LinearArena arena(1024, MEMORY_DEBUG_NONE);
+
+    void* a = arena.Allocate(3, 1);
+    void* b = arena.Allocate(8, 64);
+    double* c = arena.AllocateArray<double>(4);
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    ASSERT_NE(c, nullptr);
+    EXPECT_TRUE(IsAligned(b, 64));
+    EXPECT_TRUE(IsAligned(c, alignof(double)));
+    EXPECT_EQ(arena.Allocate(8, 3), nullptr);
+    EXPECT_EQ(arena.GetAllocationCount(), 3u);
+    EXPECT_TRUE(arena.Owns(c));
+
+    LinearArena::Marker marker = arena.GetMarker();
+    size_t used = arena.GetUsed();
+    {
+        ArenaScope scope(arena);
+        EXPECT_NE(arena.Allocate(100), nullptr);
+        EXPECT_GT(arena.GetUsed(), used);
+    }
+    EXPECT_EQ(arena.GetUsed(), used);
+
+    // Освобождение последнего выделения возвращает память
+    void* last = arena.Allocate(32, 1);
+    arena.Deallocate(last, 32);
+    EXPECT_EQ(arena.GetUsed(), used);
+    // Не последнее - игнорируется
+    arena.Deallocate(a, 3);
+    EXPECT_EQ(arena.GetUsed(), used);
+
+    arena.Reset();
+    EXPECT_EQ(arena.GetUsed(), 0u);
+    EXPECT_EQ(arena.GetGeneration(), 1u);
+    EXPECT_FALSE(arena.Owns(c));
+
+    // Отметка прошлого цикла не откатывает новый
+    arena.Allocate(16);
+    used = arena.GetUsed();
+    arena.Rewind(marker);
+    EXPECT_EQ(arena.GetUsed(), used);
+}
+
+TEST(LinearArenaTest, ConsolidatesChunksOnReset) {
+    LinearArena arena(256, MEMORY_DEBUG_NONE);
+
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_NE(arena.Allocate(100), nullptr);
+    }
+    void* large = arena.Allocate(4096);
+    ASSERT_NE(large, nullptr);
+    EXPECT_GT(arena.GetChunkCount(), 2u);
+    size_t peak = arena.GetPeakUsed();
+    EXPECT_GE(peak, 20u * 100u + 4096u);
+
+    arena.Reset();
+    EXPECT_EQ(arena.GetChunkCount(), 1u);
+    EXPECT_GE(arena.GetCapacity(), peak);
+
+    // Тот же объем в следующем цикле - без новых блоков
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_NE(arena.Allocate(100), nullptr);
+    }
+    ASSERT_NE(arena.Allocate(4096), nullptr);
+    EXPECT_EQ(arena.GetChunkCount(), 1u);
+    EXPECT_EQ(arena.GetPeakUsed(), peak);
+}
+
+TEST(LinearArenaTest, ReusesChunksAfterRewind) {
+    LinearArena arena(256, MEMORY_DEBUG_NONE);
+    arena.Allocate(16);
+    LinearArena::Marker marker = arena.GetMarker();
+
+    for (int i = 0; i < 10; ++i) {
+        arena.Allocate(200);
+    }
+    size_t chunks = arena.GetChunkCount();
+    size_t used = arena.GetUsed();
+    arena.Rewind(marker);
+
+    for (int i = 0; i < 10; ++i) {
+        arena.Allocate(200);
+    }
+    EXPECT_EQ(arena.GetChunkCount(), chunks);
+    EXPECT_EQ(arena.GetUsed(), used);
+}
+
+TEST(LinearArenaTest, DetectsOverrunsAndPoisonsFreedMemory) {
+    LinearArena arena(1024, MEMORY_DEBUG_ALL);
+
+    uint8_t* bytes = static_cast<uint8_t*>(arena.Allocate(24));
+    ASSERT_NE(bytes, nullptr);
+    EXPECT_EQ(bytes[0], MEMORY_FRESH_BYTE);
+    EXPECT_TRUE(arena.CheckGuards());
+
+    bytes[24] = 0;
+    EXPECT_FALSE(arena.CheckGuards());
+    EXPECT_GE(arena.GetOverrunCount(), 1u);
+    bytes[24] = MEMORY_GUARD_BYTE;
+    EXPECT_TRUE(arena.CheckGuards());
+
+    LinearArena::Marker marker = arena.GetMarker();
+    uint8_t* scratch = static_cast<uint8_t*>(arena.Allocate(32));
+    ASSERT_NE(scratch, nullptr);
+    std::memset(scratch, 0x11, 32);
+    arena.Rewind(marker);
+#if !defined(FASTENGINE_MEMORY_ASAN)
+    // Под ASan откаченная память недоступна и для чтения
+    EXPECT_EQ(scratch[0], MEMORY_POISON_BYTE);
+#endif
+
+    // Повторное выделение снова доступно
+    uint8_t* again = static_cast<uint8_t*>(arena.Allocate(32));
+    EXPECT_EQ(again, scratch);
+    std::memset(again, 0x22, 32);
+    EXPECT_TRUE(arena.CheckGuards());
+}
+
+TEST(FrameArenaTest, ResetsOnlyOnOwnBeginFrame) {
+    LinearArena& arena = FrameArena::Get();
+    uint64_t frame = FrameArena::GetFrameIndex();
+    uint64_t generation = arena.GetGeneration();
+
+    void* memory = FrameArena::Allocate(128);
+    ASSERT_NE(memory, nullptr);
+    EXPECT_TRUE(arena.Owns(memory));
+    EXPECT_EQ(&FrameArena::Get(), &arena);
+    EXPECT_EQ(arena.GetGeneration(), generation);
+
+    // У другого потока своя арена и свои кадры: его BeginFrame не
+    // затрагивает память этого потока
+    LinearArena* other = nullptr;
+    uint64_t otherFrame = 0;
+    std::thread thread([&other, &otherFrame]() {
+        other = &FrameArena::Get();
+        EXPECT_NE(FrameArena::Allocate(64), nullptr);
+        FrameArena::BeginFrame();
+        FrameArena::BeginFrame();
+        otherFrame = FrameArena::GetFrameIndex();
+    });
+    thread.join();
+    EXPECT_NE(other, &arena);
+    EXPECT_EQ(otherFrame, 2u);
+    EXPECT_EQ(FrameArena::GetFrameIndex(), frame);
+    EXPECT_EQ(arena.GetGeneration(), generation);
+    EXPECT_TRUE(arena.Owns(memory));
+
+    // Сброс только явным BeginFrame своего потока
+    FrameArena::BeginFrame();
+    EXPECT_EQ(FrameArena::GetFrameIndex(), frame + 1);
+    EXPECT_EQ(arena.GetGeneration(), generation + 1);
+    EXPECT_EQ(arena.GetUsed(), 0u);
+    EXPECT_EQ(&FrameArena::Get(), &arena);
+    EXPECT_EQ(arena.GetGeneration(), generation + 1);
+}
+
+TEST(FrameArenaTest, FrameVectorReclaimsGrowth) {
+    FrameArena::BeginFrame();
+    LinearArena& arena = FrameArena::Get();
+
+    FrameVector<int> values;
+    for (int i = 0; i < 1000; ++i) {
+        values.push_back(i);
+    }
+    EXPECT_EQ(values.size(), 1000u);
+    EXPECT_EQ(values[999], 999);
+    EXPECT_TRUE(arena.Owns(values.data()));
+    // Старые буферы остаются до конца кадра, но в сумме меньше итогового
+    EXPECT_LT(arena.GetUsed(), 2 * values.capacity() * sizeof(int) + 1024);
+
+    // С reserve - ровно один буфер
+    size_t used = arena.GetUsed();
+    FrameVector<int> reserved;
+    reserved.reserve(1000);
+    for (int i = 0; i < 1000; ++i) {
+        reserved.push_back(i);
+    }
+    EXPECT_LE(arena.GetUsed() - used, 1000 * sizeof(int) + alignof(std::max_align_t));
+
+    LinearArena local(1024, MEMORY_DEBUG_NONE);
+    std::vector<int, ArenaAllocator<int>> localValues{ArenaAllocator<int>(local)};
+    localValues.assign(10, 7);
+    EXPECT_TRUE(local.Owns(localValues.data()));
+    EXPECT_FALSE(arena.Owns(localValues.data()));
+    EXPECT_NE(localValues.get_allocator(), values.get_allocator());
+}
+
+TEST(PoolAllocatorTest, ReusesBlocksAndGrowsBySlabs) {
+    PoolAllocator pool(24, 8, 4, MEMORY_DEBUG_NONE);
+    EXPECT_GE(pool.GetBlockSize(), 24u);
+
+    std::vector<void*> blocks;
+    std::set<void*> unique;
+    for (int i = 0; i < 10; ++i) {
+        void* block = pool.Allocate();
+        ASSERT_NE(block, nullptr);
+        EXPECT_TRUE(IsAligned(block, 8));
+        EXPECT_TRUE(pool.Owns(block));
+        blocks.push_back(block);
+        unique.insert(block);
+    }
+    EXPECT_EQ(unique.size(), 10u);
+    EXPECT_EQ(pool.GetSlabCount(), 3u);
+    EXPECT_EQ(pool.GetCapacity(), 12u);
+    EXPECT_EQ(pool.GetLiveCount(), 10u);
+
+    void* freed = blocks.back();
+    pool.Free(freed);
+    EXPECT_EQ(pool.Allocate(), freed);
+
+    for (void* block : blocks) {
+        pool.Free(block);
+    }
+    EXPECT_EQ(pool.GetLiveCount(), 0u);
+    EXPECT_EQ(pool.GetSlabCount(), 3u);
+
+    int local = 0;
+    EXPECT_FALSE(pool.Owns(&local));
+}
+
+TEST(PoolAllocatorTest, DetectsDoubleFreeInPoisonMode) {
+    PoolAllocator pool(32, alignof(std::max_align_t), 8, MEMORY_DEBUG_POISON);
+
+    uint8_t* block = static_cast<uint8_t*>(pool.Allocate());
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(block[0], MEMORY_FRESH_BYTE);
+    void* other = pool.Allocate();
+
+    pool.Free(block);
+    pool.Free(block);
+    EXPECT_EQ(pool.GetDoubleFreeCount(), 1u);
+    EXPECT_EQ(pool.GetLiveCount(), 1u);
+
+    // Чужой указатель не попадает в список свободных
+    int local = 0;
+    pool.Free(&local);
+    EXPECT_EQ(pool.GetLiveCount(), 1u);
+
+    pool.Free(other);
+    EXPECT_EQ(pool.GetLiveCount(), 0u);
+}
+
+TEST(PoolAllocatorTest, ObjectPoolConstructsAndDestroys) {
+    ObjectPool<Tracked> pool(16);
+    Tracked* a = pool.Create(1);
+    Tracked* b = pool.Create(2);
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(a->value, 1);
+    EXPECT_EQ(Tracked::s_alive, 2);
+
+    pool.Destroy(a);
+    EXPECT_EQ(Tracked::s_alive, 1);
+    EXPECT_EQ(pool.Create(3), a);
+    pool.Destroy(a);
+    pool.Destroy(b);
+    EXPECT_EQ(Tracked::s_alive, 0);
+    EXPECT_EQ(pool.GetPool().GetLiveCount(), 0u);
+
+    // Исключение конструктора возвращает блок
+    ObjectPool<Throwing> throwing(4);
+    EXPECT_THROW(throwing.Create(true), std::runtime_error);
+    EXPECT_EQ(throwing.GetPool().GetLiveCount(), 0u);
+}
+
+TEST(PoolAllocatorTest, SizeClassesAreThreadSafe) {
+    SizeClassAllocator allocator(MEMORY_DEBUG_NONE);
+
+    const int threads = 4;
+    const int iterations = 2000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&allocator, t]() {
+            std::vector<std::pair<uint8_t*, size_t>> live;
+            for (int i = 0; i < iterations; ++i) {
+                size_t size = 1 + static_cast<size_t>((i * 37 + t * 11) % 600);
+                uint8_t* memory = static_cast<uint8_t*>(allocator.Allocate(size));
+                ASSERT_NE(memory, nullptr);
+                std::memset(memory, t, size);
+                live.emplace_back(memory, size);
+                if (live.size() > 16) {
+                    auto& oldest = live.front();
+                    EXPECT_EQ(oldest.first[oldest.second - 1], static_cast<uint8_t>(t));
+                    allocator.Free(oldest.first, oldest.second);
+                    live.erase(live.begin());
+                }
+            }
+            for (auto& entry : live) {
+                allocator.Free(entry.first, entry.second);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    EXPECT_EQ(allocator.GetLiveCount(), 0u);
+}
+
+#if defined(FASTENGINE_HAS_PMR)
+TEST(MemoryResourceTest, PmrContainersUseArena) {
+    LinearArena arena(4096, MEMORY_DEBUG_NONE);
+    ArenaResource resource(arena);
+
+    std::pmr::vector<int> values(&resource);
+    for (int i = 0; i < 100; ++i) {
+        values.push_back(i);
+    }
+    EXPECT_TRUE(arena.Owns(values.data()));
+    EXPECT_EQ(values[50], 50);
+
+    SizeClassResource pooled;
+    std::pmr::vector<double> doubles(&pooled);
+    doubles.assign(8, 1.5);
+    EXPECT_EQ(doubles.back(), 1.5);
+    EXPECT_TRUE(pooled.is_equal(SizeClassResource()));
+    EXPECT_FALSE(resource.is_equal(pooled));
+}
+#endif
@@ -0,0 +1,239 @@
+#include <gtest/gtest.h>
+#include "FastEngine/Profiling/MemoryTracker.h"
+#include "FastEngine/Profiling/PerformanceProfiler.h"
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace FastEngine;
+
+namespace {
+
+const MemoryTagStats& TagStats(const MemoryTrackerSnapshot& snapshot, MemoryTag tag) {
+    return snapshot.tags.at(tag);
+}
+
+// Учет включен на время теста
+class MemoryTrackerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        MemoryTracker::SetSampleRate(0);
+        MemoryTracker::SetEnabled(true);
+    }
+
+    void TearDown() override {
+        MemoryTracker::SetEnabled(false);
+        MemoryTracker::SetSampleRate(0);
+    }
+};
+
+} // namespace
+
+TEST_F(MemoryTrackerTest, CountsAllocationsPerTagAndAlignment) {
+    MemoryTag render = MemoryTracker::RegisterTag("Test.Render");
+    MemoryTag physics = MemoryTracker::RegisterTag("Test.Physics");
+    EXPECT_NE(render, MemoryTracker::UNTAGGED);
+    EXPECT_NE(render, physics);
+    EXPECT_EQ(MemoryTracker::RegisterTag("Test.Render"), render);
+    EXPECT_STREQ(MemoryTracker::GetTagName(render), "Test.Render");
+
+    MemoryTrackerSnapshot before = MemoryTracker::GetSnapshot();
+    void* a = nullptr;
+    void* b = nullptr;
+    void* c = nullptr;
+    {
+        MemoryTagScope renderScope(render);
+        a = MemoryTracker::Allocate(100);
+        {
+            MemoryTagScope physicsScope(physics);
+            EXPECT_EQ(MemoryTracker::GetCurrentTag(), physics);
+            b = MemoryTracker::Allocate(200, 64);
+        }
+        c = MemoryTracker::Allocate(0, 4096);
+    }
+    EXPECT_EQ(MemoryTracker::GetCurrentTag(), MemoryTracker::UNTAGGED);
+
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    ASSERT_NE(c, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(a) % MemoryTracker::DEFAULT_ALIGNMENT, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 64, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(c) % 4096, 0u);
+    EXPECT_EQ(MemoryTracker::GetAllocationSize(b), 200u);
+    std::memset(b, 0xAB, 200);
+
+    MemoryTrackerSnapshot during = MemoryTracker::GetSnapshot();
+    EXPECT_EQ(TagStats(during, render).liveBytes - TagStats(before, render).liveBytes, 100);
+    EXPECT_EQ(TagStats(during, render).allocations - TagStats(before, render).allocations, 2u);
+    EXPECT_EQ(TagStats(during, physics).liveBytes - TagStats(before, physics).liveBytes, 200);
+    // Со сборкой FASTENGINE_TRACK_ALLOCATIONS сам снимок тоже учитывается
+    EXPECT_GE(during.allocations - before.allocations, 3u);
+
+    MemoryTracker::Free(a);
+    MemoryTracker::Free(b);
+    MemoryTracker::Free(c);
+    MemoryTracker::Free(nullptr);
+
+    MemoryTrackerSnapshot after = MemoryTracker::GetSnapshot();
+    EXPECT_EQ(TagStats(after, render).liveBytes, TagStats(before, render).liveBytes);
+    EXPECT_EQ(TagStats(after, physics).liveBytes, TagStats(before, physics).liveBytes);
+    EXPECT_EQ(TagStats(after, physics).frees - TagStats(before, physics).frees, 1u);
+    EXPECT_EQ(TagStats(after, render).bytesAllocated - TagStats(before, render).bytesAllocated, 100u);
+}
+
+TEST_F(MemoryTrackerTest, DisabledTrackingIsNotCounted) {
+    // Снимки берутся вне тега: с заменой operator new они тоже выделяют память
+    MemoryTag tag = MemoryTracker::RegisterTag("Test.Disabled");
+
+    MemoryTracker::SetEnabled(false);
+    MemoryTrackerSnapshot before = MemoryTracker::GetSnapshot();
+    MemoryTracker::PushTag(tag);
+    void* untracked = MemoryTracker::Allocate(64);
+    MemoryTag ignored = MemoryTracker::OnAllocate(64);
+    MemoryTracker::PopTag();
+    EXPECT_EQ(ignored, MemoryTracker::NOT_TRACKED);
+    MemoryTracker::OnFree(64, ignored);
+
+    // Блок, выделенный до включения, не вычитается при освобождении
+    MemoryTracker::SetEnabled(true);
+    MemoryTracker::Free(untracked);
+    MemoryTrackerSnapshot after = MemoryTracker::GetSnapshot();
+    EXPECT_EQ(TagStats(after, tag).allocations, TagStats(before, tag).allocations);
+    EXPECT_EQ(TagStats(after, tag).frees, TagStats(before, tag).frees);
+    EXPECT_EQ(TagStats(after, tag).liveBytes, TagStats(before, tag).liveBytes);
+
+    // Аллокатор со своей памятью сообщает о выделениях сам
+    MemoryTracker::PushTag(tag);
+    MemoryTag reported = MemoryTracker::OnAllocate(512);
+    MemoryTracker::PopTag();
+    EXPECT_EQ(reported, tag);
+    EXPECT_EQ(TagStats(MemoryTracker::GetSnapshot(), tag).liveBytes - TagStats(before, tag).liveBytes, 512);
+    MemoryTracker::OnFree(512, reported);
+    EXPECT_EQ(TagStats(MemoryTracker::GetSnapshot(), tag).liveBytes, TagStats(before, tag).liveBytes);
+}
+
+TEST_F(MemoryTrackerTest, MergesCountersAcrossThreads) {
+    MemoryTag tag = MemoryTracker::RegisterTag("Test.Threads");
+    MemoryTrackerSnapshot before = MemoryTracker::GetSnapshot();
+
+    const int threadCount = 4;
+    const int perThread = 1000;
+    std::vector<std::vector<void*>> blocks(threadCount);
+    for (auto& list : blocks) {
+        list.reserve(perThread);
+    }
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&blocks, tag, t]() {
+            MemoryTagScope scope(tag);
+            for (int i = 0; i < perThread; ++i) {
+                blocks[t].push_back(MemoryTracker::Allocate(32));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    MemoryTrackerSnapshot during = MemoryTracker::GetSnapshot();
+    EXPECT_EQ(TagStats(during, tag).allocations - TagStats(before, tag).allocations,
+              static_cast<uint64_t>(threadCount * perThread));
+    EXPECT_EQ(TagStats(during, tag).liveBytes - TagStats(before, tag).liveBytes, threadCount * perThread * 32);
+
+    // Освобождение в другом потоке: счетчики потоков складываются в снимке,
+    // значения завершившихся потоков сохраняются
+    std::thread releaser([&blocks]() {
+        for (auto& list : blocks) {
+            for (void* block : list) {
+                MemoryTracker::Free(block);
+            }
+        }
+    });
+    releaser.join();
+
+    MemoryTrackerSnapshot after = MemoryTracker::GetSnapshot();
+    EXPECT_EQ(TagStats(after, tag).liveBytes, TagStats(before, tag).liveBytes);
+    EXPECT_EQ(TagStats(after, tag).frees - TagStats(before, tag).frees,
+              static_cast<uint64_t>(threadCount * perThread));
+}
+
+TEST_F(MemoryTrackerTest, SamplesLiveAllocations) {
+    MemoryTag tag = MemoryTracker::RegisterTag("Test.Sampled");
+    MemoryTracker::SetSampleRate(1);
+
+    std::vector<void*> blocks;
+    blocks.reserve(8);
+    {
+        MemoryTagScope scope(tag);
+        for (int i = 0; i < 8; ++i) {
+            blocks.push_back(MemoryTracker::Allocate(1000));
+        }
+    }
+
+    size_t sampled = 0;
+    for (const auto& sample : MemoryTracker::GetLiveSamples()) {
+        if (sample.tag == tag) {
+            sampled++;
+            EXPECT_EQ(sample.size, 1000u);
+            EXPECT_LE(sample.depth, AllocationSample::MAX_FRAMES);
+            if (sample.depth > 0) {
+                EXPECT_FALSE(MemoryTracker::DescribeFrame(sample.frames[0]).empty());
+            }
+        }
+    }
+    EXPECT_EQ(sampled, blocks.size());
+
+    for (void* block : blocks) {
+        MemoryTracker::Free(block);
+    }
+    for (const auto& sample : MemoryTracker::GetLiveSamples()) {
+        EXPECT_NE(sample.tag, tag);
+    }
+}
+
+TEST_F(MemoryTrackerTest, MemoryProfilerCapturesTrackedAllocations) {
+    MemoryTag tag = MemoryTracker::RegisterTag("Test.Profiler");
+    MemoryProfiler profiler;
+    profiler.StartProfiling();
+    MemoryTracker::SetSampleRate(1);
+
+    profiler.CaptureTrackedAllocations();
+    std::vector<void*> blocks;
+    blocks.reserve(5);
+    {
+        MemoryTagScope scope(tag);
+        for (int i = 0; i < 5; ++i) {
+            blocks.push_back(MemoryTracker::Allocate(256));
+        }
+    }
+    profiler.CaptureTrackedAllocations();
+
+    EXPECT_GE(profiler.GetAllocationsPerFrame(), 5u);
+    EXPECT_GE(profiler.GetTrackedMemoryUsage(), 5 * 256);
+    PerformanceStats stats = profiler.GetStats("Test.Profiler");
+    EXPECT_GE(stats.average, 5 * 256.0);
+    EXPECT_GE(stats.sampleCount, 5u);
+
+    // Невысвобожденные блоки видны как утечки и места выделения
+    bool leakReported = false;
+    for (const auto& leak : profiler.GetMemoryLeaks()) {
+        leakReported |= leak.find("Test.Profiler") == 0;
+    }
+    EXPECT_TRUE(leakReported);
+    bool siteReported = false;
+    for (const auto& site : profiler.GetAllocationSites(100)) {
+        siteReported |= site.find("Test.Profiler") == 0;
+    }
+    EXPECT_TRUE(siteReported);
+
+    int64_t peak = profiler.GetTrackedPeakMemoryUsage();
+    for (void* block : blocks) {
+        MemoryTracker::Free(block);
+    }
+    profiler.CaptureTrackedAllocations();
+    EXPECT_EQ(profiler.GetStats("Test.Profiler").average, 0.0);
+    EXPECT_EQ(profiler.GetTrackedPeakMemoryUsage(), peak);
+    EXPECT_EQ(profiler.GetAllocationStats().sampleCount, 2u);
+    profiler.StopProfiling();
+}
@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+#include "FastEngine/AI/NavMesh.h"
+#include "FastEngine/AI/Pathfinding.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace FastEngine;
+
+namespace {
+
+void ExpectSameMesh(const NavMesh& expected, const NavMesh& actual) {
+    ASSERT_EQ(expected.GetNodeCount(), actual.GetNodeCount());
+    ASSERT_EQ(expected.GetTriangles().size(), actual.GetTriangles().size());
+    
+    for (size_t i = 0; i < expected.GetNodeCount(); ++i) {
+        const NavNode& a = expected.GetNodes()[i];
+        const NavNode& b = actual.GetNodes()[i];
+        ASSERT_EQ(a.walkable, b.walkable) << "node " << i;
+        ASSERT_FLOAT_EQ(a.position.x, b.position.x);
+        ASSERT_FLOAT_EQ(a.position.y, b.position.y);
+        ASSERT_FLOAT_EQ(a.position.z, b.position.z);
+        ASSERT_FLOAT_EQ(a.cost, b.cost);
+    }
+    for (size_t i = 0; i < expected.GetTriangles().size(); ++i) {
+        const NavTriangle& a = expected.GetTriangles()[i];
+        const NavTriangle& b = actual.GetTriangles()[i];
+        ASSERT_EQ(a.walkable, b.walkable) << "triangle " << i;
+        for (int j = 0; j < 3; ++j) {
+            ASSERT_EQ(a.vertices[j], b.vertices[j]);
+        }
+    }
+    EXPECT_EQ(expected.GetAdjacencyOffsets(), actual.GetAdjacencyOffsets());
+    EXPECT_EQ(expected.GetAdjacency(), actual.GetAdjacency());
+    
+    for (size_t i = 0; i < expected.GetNodeCount(); ++i) {
+        NavIndexRange a = expected.GetNodeTriangles(static_cast<int>(i));
+        NavIndexRange b = actual.GetNodeTriangles(static_cast<int>(i));
+        ASSERT_TRUE(std::equal(a.begin(), a.end(), b.begin(), b.end())) << "node " << i;
+    }
+    for (size_t i = 0; i < expected.GetTriangles().size(); ++i) {
+        for (int edge = 0; edge < 3; ++edge) {
+            ASSERT_EQ(expected.GetTriangleNeighbor(static_cast<int>(i), edge),
+                      actual.GetTriangleNeighbor(static_cast<int>(i), edge)) << "triangle " << i;
+        }
+    }
+}
+
+} // namespace
+
+class NavMeshGeneratorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Холмы 61x47 с ямой в центре - размеры не кратны тайлу
+        width = 61;
+        height = 47;
+        heights.resize(static_cast<size_t>(width) * height);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                float h = 1.0f + 0.4f * std::sin(x * 0.3f) * std::cos(y * 0.2f);
+                if (std::abs(x - 30) < 4 && std::abs(y - 23) < 4) h = 0.0f;
+                heights[static_cast<size_t>(y) * width + x] = h;
+            }
+        }
+        
+        generator.SetCellSize(1.0f);
+        generator.SetHeightThreshold(0.5f);
+        generator.SetTileSize(8);
+        generator.SetWorkerCount(4);
+    }
+    
+    HeightmapView View() const { return HeightmapView(heights.data(), width, height); }
+    
+    int width;
+    int height;
+    std::vector<float> heights;
+    NavMeshGenerator generator;
+};
+
+TEST_F(NavMeshGeneratorTest, TiledMatchesSerialWithoutFilters) {
+    generator.SetAgentRadius(0.0f);
+    generator.SetMaxSlope(90.0f);
+    
+    std::unique_ptr<NavMesh> tiled = generator.GenerateFromHeightmap(View());
+    ASSERT_TRUE(tiled);
+    
+    NavMesh serial;
+    ASSERT_TRUE(serial.GenerateFromHeightmap(View(), 1.0f, 0.5f));
+    ExpectSameMesh(serial, *tiled);
+}
+
+TEST_F(NavMeshGeneratorTest, ResultDoesNotDependOnTilingOrThreads) {
+    generator.SetAgentRadius(2.0f);
+    
+    generator.SetTileSize(1000);
+    generator.SetWorkerCount(1);
+    std::unique_ptr<NavMesh> single = generator.GenerateFromHeightmap(View());
+    
+    generator.SetTileSize(5);
+    generator.SetWorkerCount(8);
+    std::unique_ptr<NavMesh> tiled = generator.GenerateFromHeightmap(View());
+    
+    ASSERT_TRUE(single && tiled);
+    ExpectSameMesh(*single, *tiled);
+}
+
+TEST_F(NavMeshGeneratorTest, StridedViewReadsSubregion) {
+    generator.SetAgentRadius(0.0f);
+    
+    // Левая половина карты как вид с исходным шагом строки
+    HeightmapView half(heights.data(), 20, height, static_cast<size_t>(width));
+    std::unique_ptr<NavMesh> navMesh = generator.GenerateFromHeightmap(half);
+    ASSERT_TRUE(navMesh);
+    ASSERT_EQ(navMesh->GetNodeCount(), static_cast<size_t>(20 * height));
+    
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < 20; ++x) {
+            EXPECT_FLOAT_EQ(navMesh->GetNodes()[y * 20 + x].position.y, heights[static_cast<size_t>(y) * width + x]);
+        }
+    }
+}
+
+TEST_F(NavMeshGeneratorTest, AgentRadiusErodesAroundObstacles) {
+    generator.SetAgentRadius(2.0f);
+    std::unique_ptr<NavMesh> navMesh = generator.GenerateFromHeightmap(View());
+    ASSERT_TRUE(navMesh);
+    
+    const auto& nodes = navMesh->GetNodes();
+    // Яма занимает x, y в (26..34, 19..27); отсчеты ближе 2 к ней закрыты
+    EXPECT_FALSE(nodes[23 * width + 25].walkable);
+    EXPECT_FALSE(nodes[23 * width + 35].walkable);
+    EXPECT_TRUE(nodes[23 * width + 37].walkable);
+    // Край карты тоже непроходим для агента
+    EXPECT_FALSE(nodes[23 * width + 1].walkable);
+    EXPECT_TRUE(nodes[23 * width + 2].walkable);
+}
+
+TEST_F(NavMeshGeneratorTest, SteepSlopeIsNotWalkable) {
+    generator.SetAgentRadius(0.0f);
+    generator.SetMaxSlope(30.0f);
+    
+    // Уступ высотой 2 на x = 10
+    for (int y = 0; y < height; ++y) {
+        heights[static_cast<size_t>(y) * width + 10] += 2.0f;
+    }
+    std::unique_ptr<NavMesh> navMesh = generator.GenerateFromHeightmap(View());
+    ASSERT_TRUE(navMesh);
+    EXPECT_FALSE(navMesh->GetNodes()[5 * width + 10].walkable);
+    EXPECT_FALSE(navMesh->GetNodes()[5 * width + 9].walkable);
+    EXPECT_TRUE(navMesh->GetNodes()[5 * width + 5].walkable);
+}
+
+TEST_F(NavMeshGeneratorTest, RebuildRegionMatchesFullRebuild) {
+    generator.SetAgentRadius(1.0f);
+    std::unique_ptr<NavMesh> navMesh = generator.GenerateFromHeightmap(View());
+    ASSERT_TRUE(navMesh);
+    
+    // Новая стена в углу карты
+    for (int y = 3; y <= 6; ++y) {
+        for (int x = 40; x <= 45; ++x) {
+            heights[static_cast<size_t>(y) * width + x] = 0.0f;
+        }
+    }
+    
+    int rebuilt = generator.RebuildRegion(*navMesh, View(), 40, 3, 45, 6);
+    EXPECT_GT(rebuilt, 0);
+    EXPECT_LE(rebuilt, 6);
+    
+    std::unique_ptr<NavMesh> full = generator.GenerateFromHeightmap(View());
+    ASSERT_TRUE(full);
+    ExpectSameMesh(*full, *navMesh);
+    EXPECT_FALSE(navMesh->IsWalkable(glm::vec3(42.5f, 0.0f, 4.5f)));
+}
+
+TEST_F(NavMeshGeneratorTest, RebuildRejectsMismatchedHeightmap) {
+    std::unique_ptr<NavMesh> navMesh = generator.GenerateFromHeightmap(View());
+    ASSERT_TRUE(navMesh);
+    
+    HeightmapView smaller(heights.data(), width - 1, height, static_cast<size_t>(width));
+    EXPECT_EQ(generator.RebuildRegion(*navMesh, smaller, 0, 0, 4, 4), -1);
+}
+
+TEST_F(NavMeshGeneratorTest, RebuildKeepsGenerationThreshold) {
+    std::unique_ptr<NavMesh> navMesh = generator.GenerateFromHeightmap(View());
+    ASSERT_TRUE(navMesh);
+    std::unique_ptr<NavMesh> expected = generator.GenerateFromHeightmap(View());
+    ASSERT_TRUE(expected);
+    
+    // Порог генератора сменился после построения - перестройка его не применяет
+    generator.SetHeightThreshold(1.0f);
+    EXPECT_GT(generator.RebuildRegion(*navMesh, View(), 0, 0, width - 1, height - 1), 0);
+    ExpectSameMesh(*expected, *navMesh);
+    
+    // Сетка, построенная не генератором, отклоняется даже при совпадении размеров
+    std::vector<std::vector<float>> rows(height, std::vector<float>(width, 1.0f));
+    NavMesh manual;
+    ASSERT_TRUE(manual.GenerateFromHeightmap(rows, 1.0f, 0.5f));
+    EXPECT_EQ(generator.RebuildRegion(manual, View(), 0, 0, 4, 4), -1);
+}
+
+TEST_F(NavMeshGeneratorTest, CollidersProduceWalkableTops) {
+    generator.SetAgentRadius(0.0f);
+    generator.SetMaxSlope(45.0f);
+    
+    // Пол 40x40 и куб 6x4x6 в центре
+    std::vector<glm::vec3> positions = {glm::vec3(0.0f, -0.5f, 0.0f), glm::vec3(0.0f, 2.0f, 0.0f)};
+    std::vector<glm::vec3> sizes = {glm::vec3(40.0f, 1.0f, 40.0f), glm::vec3(6.0f, 4.0f, 6.0f)};
+    
+    std::unique_ptr<NavMesh> navMesh = generator.GenerateFromColliders(positions, sizes);
+    ASSERT_TRUE(navMesh);
+    
+    EXPECT_TRUE(navMesh->IsWalkable(glm::vec3(-15.0f, 0.0f, -15.0f)));
+    EXPECT_TRUE(navMesh->IsWalkable(glm::vec3(0.5f, 4.0f, 0.5f)));
+    EXPECT_FALSE(navMesh->IsWalkable(glm::vec3(3.0f, 0.0f, 0.5f)));
+    
+    int top = navMesh->FindNearestNode(glm::vec3(0.0f, 4.0f, 0.0f));
+    ASSERT_GE(top, 0);
+    EXPECT_FLOAT_EQ(navMesh->GetNodes()[top].position.y, 4.0f);
+    
+    // С пола на крышу куба не подняться
+    AStarPathfinding pathfinder;
+    pathfinder.SetMaxIterations(1000000);
+    EXPECT_TRUE(pathfinder.FindPath(*navMesh, glm::vec3(-15.0f, 0.0f, -15.0f), glm::vec3(15.0f, 0.0f, 15.0f)).success);
+    EXPECT_FALSE(pathfinder.FindPath(*navMesh, glm::vec3(-15.0f, 0.0f, -15.0f), glm::vec3(0.0f, 4.0f, 0.0f)).success);
+}
@@ -0,0 +1,329 @@
+#include <gtest/gtest.h>
+#include "FastEngine/Components/RigidBody.h"
+#include "FastEngine/Components/Transform.h"
+#include "FastEngine/Entity.h"
+#include "FastEngine/Network/NetworkManager.h"
+#include "FastEngine/Network/NetworkPrediction.h"
+#include "FastEngine/World.h"
+#include "FastEngine/WorldSnapshot.h"
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <string>
+#include <vector>
+
+using namespace FastEngine;
+
+namespace {
+
+uint32_t NextRandom(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+struct MoveInput {
+    glm::vec2 velocity;
+};
+
+void Move(Entity* entity, const MoveInput& input, float deltaTime, float wall) {
+    Transform* transform = entity->GetComponent<Transform>();
+    glm::vec2 position = transform->GetPosition() + input.velocity * deltaTime;
+    position.x = std::min(position.x, wall);
+    transform->SetPosition(position);
+}
+
+} // namespace
+
+TEST(NetworkInterpolationTest, TimelineInterpolatesAndExtrapolates) {
+    NetworkTimeline timeline;
+    glm::vec3 position;
+    glm::vec3 rotation;
+    EXPECT_FALSE(timeline.Sample(0.0, position, rotation));
+
+    // Запоздавший снимок встает на свое место
+    timeline.AddSample(0.0, glm::vec3(0.0f), glm::vec3(0.0f, 170.0f, 0.0f));
+    timeline.AddSample(0.2, glm::vec3(4.0f, 0.0f, 0.0f), glm::vec3(0.0f, -150.0f, 0.0f));
+    timeline.AddSample(0.1, glm::vec3(2.0f, 0.0f, 0.0f), glm::vec3(0.0f, -170.0f, 0.0f));
+    EXPECT_EQ(timeline.GetSampleCount(), 3u);
+
+    ASSERT_TRUE(timeline.Sample(0.05, position, rotation));
+    EXPECT_NEAR(position.x, 1.0f, 1e-5f);
+    EXPECT_NEAR(rotation.y, 180.0f, 1e-4f); // Через 180, а не через 0
+
+    ASSERT_TRUE(timeline.Sample(-1.0, position, rotation));
+    EXPECT_EQ(position.x, 0.0f);
+
+    // Экстраполяция по последней скорости, не дальше 0.25 с
+    ASSERT_TRUE(timeline.Sample(0.25, position, rotation));
+    EXPECT_NEAR(position.x, 5.0f, 1e-4f);
+    EXPECT_NEAR(rotation.y, -140.0f, 1e-3f);
+    ASSERT_TRUE(timeline.Sample(10.0, position, rotation));
+    EXPECT_NEAR(position.x, 9.0f, 1e-4f);
+    timeline.SetMaxExtrapolation(0.0);
+    ASSERT_TRUE(timeline.Sample(10.0, position, rotation));
+    EXPECT_EQ(position.x, 4.0f);
+
+    // Переполнение вытесняет самые старые состояния
+    for (int i = 3; i < 40; ++i) {
+        timeline.AddSample(i * 0.1, glm::vec3(i * 2.0f, 0.0f, 0.0f), glm::vec3(0.0f));
+    }
+    EXPECT_EQ(timeline.GetSampleCount(), NetworkTimeline::CAPACITY);
+    EXPECT_NEAR(timeline.GetLatestTime(), 3.9, 1e-9);
+    timeline.AddSample(0.05, glm::vec3(-1.0f), glm::vec3(0.0f));
+    ASSERT_TRUE(timeline.Sample(0.0, position, rotation));
+    EXPECT_EQ(position.x, 16.0f);
+}
+
+TEST(NetworkInterpolationTest, ClockDelayFollowsJitter) {
+    const double interval = 0.05;
+    InterpolationClock steady;
+    for (int i = 0; i < 200; ++i) {
+        steady.AddSnapshot(i * interval, i * interval + 0.03);
+    }
+    EXPECT_NEAR(steady.GetSnapshotInterval(), interval, 1e-6);
+    EXPECT_NEAR(steady.GetJitter(), 0.0, 1e-6);
+    EXPECT_NEAR(steady.GetDelay(), 2.0 * interval, 1e-3);
+    EXPECT_NEAR(steady.GetServerTime(20.0), 19.97, 1e-6);
+
+    // Задержка доставки от 30 до 90 мс: отображаемое время не обгоняет
+    // последний принятый снимок
+    InterpolationClock jittery;
+    uint32_t random = 7;
+    double latestServerTime = 0.0;
+    int ahead = 0;
+    int frames = 0;
+    std::vector<std::pair<double, double>> arrivals;
+    for (int i = 0; i < 400; ++i) {
+        double transit = 0.03 + (NextRandom(random) % 1000) * 0.00006;
+        arrivals.emplace_back(i * interval + transit, i * interval);
+    }
+    std::sort(arrivals.begin(), arrivals.end());
+    size_t next = 0;
+    for (double now = 0.0; now < 400 * interval; now += 1.0 / 60.0) {
+        while (next < arrivals.size() && arrivals[next].first <= now) {
+            jittery.AddSnapshot(arrivals[next].second, arrivals[next].first);
+            latestServerTime = std::max(latestServerTime, arrivals[next].second);
+            ++next;
+        }
+        if (now > 2.0) {
+            ++frames;
+            ahead += jittery.GetRenderTime(now) > latestServerTime ? 1 : 0;
+        }
+    }
+    EXPECT_GT(jittery.GetJitter(), 0.005);
+    EXPECT_GT(jittery.GetDelay(), steady.GetDelay());
+    EXPECT_LE(jittery.GetDelay(), 0.25);
+    EXPECT_LT(ahead, frames / 100 + 1);
+}
+
+TEST(NetworkInterpolationTest, ReplicatorSmoothsRemoteObjects) {
+    const float frameTime = 1.0f / 60.0f;
+    ObjectReplicator server;
+    ObjectReplicator client;
+    client.SetInterpolationEnabled(true);
+    client.SetLocalOwnerId("client_0");
+    server.AddClient("client_0");
+
+    // Доставка клиенту через 2-5 кадров, подтверждения - через кадр
+    struct Datagram {
+        int deliverFrame;
+        bool toServer;
+        std::vector<uint8_t> data;
+    };
+    std::vector<Datagram> queue;
+    int frame = 0;
+    uint32_t random = 99;
+    server.SetSendCallback([&](const std::string&, const uint8_t* data, uint32_t size) {
+        int latency = 2 + static_cast<int>(NextRandom(random) % 4);
+        queue.push_back(Datagram{frame + latency, false, std::vector<uint8_t>(data, data + size)});
+    });
+    client.SetSendCallback([&](const std::string&, const uint8_t* data, uint32_t size) {
+        queue.push_back(Datagram{frame + 1, true, std::vector<uint8_t>(data, data + size)});
+    });
+    int authoritativeUpdates = 0;
+    client.SetAuthoritativeStateCallback([&](NetworkObject& object, double) {
+        EXPECT_EQ(object.GetOwnerId(), "client_0");
+        ++authoritativeUpdates;
+    });
+
+    auto remote = std::make_shared<NetworkObject>();
+    remote->SetId("remote");
+    remote->SetOwnerId("server");
+    auto owned = std::make_shared<NetworkObject>();
+    owned->SetId("owned");
+    owned->SetOwnerId("client_0");
+    server.StartReplicating(remote);
+    server.StartReplicating(owned);
+
+    float previousX = 0.0f;
+    float maxStep = 0.0f;
+    bool monotonic = true;
+    for (frame = 0; frame < 300; ++frame) {
+        const float time = frame * frameTime;
+        remote->SetPosition(glm::vec3(time * 3.0f, 0.0f, 0.0f));
+        owned->SetPosition(glm::vec3(0.0f, 0.0f, time));
+        server.UpdateReplication(frameTime);
+
+        std::vector<Datagram> due;
+        for (auto it = queue.begin(); it != queue.end();) {
+            if (it->deliverFrame <= frame) {
+                due.push_back(*it);
+                it = queue.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        for (const Datagram& datagram : due) {
+            ObjectReplicator& target = datagram.toServer ? server : client;
+            target.HandlePayload(datagram.toServer ? "client_0" : "server", datagram.data.data(),
+                                 static_cast<uint32_t>(datagram.data.size()));
+        }
+        client.UpdateReplication(frameTime);
+
+        std::shared_ptr<NetworkObject> replica = client.GetReplicatedObject(remote->GetNetId());
+        if (frame >= 90 && replica) {
+            const float x = replica->GetPosition().x;
+            monotonic &= x >= previousX - 1e-4f;
+            maxStep = std::max(maxStep, x - previousX);
+            // Отставание на задержку интерполяции
+            EXPECT_LT(x, remote->GetPosition().x);
+            EXPECT_GT(x, remote->GetPosition().x - 3.0f * 0.5f);
+        }
+        if (replica) {
+            previousX = replica->GetPosition().x;
+        }
+    }
+
+    // Без интерполяции позиция прыгает на 0.15 раз в три кадра
+    EXPECT_TRUE(monotonic);
+    EXPECT_LT(maxStep, 3.0f * frameTime * 1.8f);
+    EXPECT_GT(client.GetInterpolationClock().GetDelay(), 0.1);
+
+    // Собственный объект не интерполируется: последнее состояние сервера
+    std::shared_ptr<NetworkObject> ownedReplica = client.GetReplicatedObject(owned->GetNetId());
+    ASSERT_TRUE(ownedReplica);
+    EXPECT_GT(authoritativeUpdates, 50);
+    EXPECT_GT(ownedReplica->GetPosition().z, owned->GetPosition().z - 0.2f);
+}
+
+TEST(WorldSnapshotTest, RestoresCapturedComponents) {
+    World world;
+    Entity* first = world.CreateEntity();
+    first->AddComponent<Transform>(1.0f, 2.0f, 30.0f);
+    first->AddComponent<RigidBody>()->SetVelocity(glm::vec2(5.0f, 0.0f));
+    Entity* second = world.CreateEntity();
+    second->AddComponent<Transform>(-1.0f, -2.0f);
+    const size_t secondId = second->GetID();
+    EXPECT_EQ(world.GetEntity(secondId), second);
+
+    WorldSnapshot snapshot;
+    snapshot.Capture<Transform>(world);
+    snapshot.Capture<RigidBody>(world);
+    EXPECT_EQ(snapshot.GetComponentCount(), 3u);
+
+    first->GetComponent<Transform>()->SetPosition(100.0f, 100.0f);
+    first->GetComponent<Transform>()->SetRotation(0.0f);
+    first->GetComponent<RigidBody>()->SetVelocity(glm::vec2(0.0f));
+    world.DestroyEntity(second);
+    EXPECT_EQ(world.GetEntity(secondId), nullptr);
+    Entity* third = world.CreateEntity();
+    third->AddComponent<Transform>(7.0f, 7.0f);
+
+    snapshot.Restore(world);
+    EXPECT_EQ(first->GetComponent<Transform>()->GetPosition(), glm::vec2(1.0f, 2.0f));
+    EXPECT_EQ(first->GetComponent<Transform>()->GetRotation(), 30.0f);
+    EXPECT_EQ(first->GetComponent<RigidBody>()->GetVelocity(), glm::vec2(5.0f, 0.0f));
+    EXPECT_EQ(third->GetComponent<Transform>()->GetPosition(), glm::vec2(7.0f, 7.0f));
+
+    snapshot.Clear();
+    EXPECT_EQ(snapshot.GetComponentCount(), 0u);
+    snapshot.Capture<Transform>(*third);
+    EXPECT_EQ(snapshot.GetComponentCount(), 1u);
+}
+
+TEST(NetworkPredictionTest, RollbackResimulatesAfterCorrection) {
+    const float deltaTime = 0.1f;
+    const float wall = 3.0f; // Известна только серверу
+    const int latency = 3;
+
+    World clientWorld;
+    Entity* predicted = clientWorld.CreateEntity();
+    predicted->AddComponent<Transform>();
+    World serverWorld;
+    Entity* authoritative = serverWorld.CreateEntity();
+    authoritative->AddComponent<Transform>();
+
+    PredictionBuffer<MoveInput> prediction(
+        clientWorld,
+        [predicted](World&, WorldSnapshot& snapshot) { snapshot.Capture<Transform>(*predicted); },
+        [predicted](World&, const MoveInput& input, float dt) { Move(predicted, input, dt, 1e9f); });
+
+    struct InputPacket { int deliverTick; uint32_t tick; MoveInput input; };
+    struct StatePacket { int deliverTick; uint32_t tick; glm::vec2 position; };
+    std::deque<InputPacket> toServer;
+    std::deque<StatePacket> toClient;
+    std::vector<int> results;
+
+    for (int tick = 0; tick < 80; ++tick) {
+        if (tick < 60) {
+            MoveInput input{glm::vec2(1.0f, 0.5f)};
+            uint32_t id = prediction.Predict(input, deltaTime);
+            toServer.push_back(InputPacket{tick + latency, id, input});
+        }
+        while (!toServer.empty() && toServer.front().deliverTick <= tick) {
+            Move(authoritative, toServer.front().input, deltaTime, wall);
+            toClient.push_back(StatePacket{tick + latency, toServer.front().tick,
+                                           authoritative->GetComponent<Transform>()->GetPosition()});
+            toServer.pop_front();
+        }
+        while (!toClient.empty() && toClient.front().deliverTick <= tick) {
+            const glm::vec2 serverPosition = toClient.front().position;
+            results.push_back(prediction.Reconcile(toClient.front().tick, [&](World&) {
+                Transform* transform = predicted->GetComponent<Transform>();
+                if (glm::length(transform->GetPosition() - serverPosition) < 1e-4f) {
+                    return false;
+                }
+                transform->SetPosition(serverPosition);
+                return true;
+            }));
+            toClient.pop_front();
+        }
+    }
+
+    ASSERT_EQ(results.size(), 60u);
+    // До стены предсказание совпадает, после - каждое подтверждение
+    // пересимулирует неподтвержденные тики
+    EXPECT_EQ(results[10], 0);
+    EXPECT_EQ(results[29], 0);
+    EXPECT_EQ(results[31], 2 * latency);
+    EXPECT_EQ(prediction.GetPendingCount(), 0u);
+    EXPECT_EQ(predicted->GetComponent<Transform>()->GetPosition(),
+              authoritative->GetComponent<Transform>()->GetPosition());
+    EXPECT_EQ(prediction.Reconcile(10, [](World&) { return true; }), 0); // Уже подтвержден
+}
+
+TEST(NetworkPredictionTest, RejectsTicksOutsideHistory) {
+    World world;
+    Entity* entity = world.CreateEntity();
+    entity->AddComponent<Transform>();
+    PredictionBuffer<MoveInput> prediction(
+        world,
+        [entity](World&, WorldSnapshot& snapshot) { snapshot.Capture<Transform>(*entity); },
+        [entity](World&, const MoveInput& input, float dt) { Move(entity, input, dt, 1e9f); },
+        8);
+
+    for (int i = 0; i < 20; ++i) {
+        prediction.Predict(MoveInput{glm::vec2(1.0f, 0.0f)}, 1.0f);
+    }
+    EXPECT_EQ(prediction.GetLatestTick(), 20u);
+    EXPECT_EQ(prediction.Reconcile(5, [](World&) { return true; }), -1);
+    EXPECT_EQ(prediction.Reconcile(21, [](World&) { return true; }), -1);
+    ASSERT_NE(prediction.GetInput(15), nullptr);
+    EXPECT_EQ(prediction.GetInput(5), nullptr);
+
+    // Совпавшее подтверждение возвращает мир к последнему тику
+    EXPECT_EQ(prediction.Reconcile(15, [](World&) { return false; }), 0);
+    EXPECT_EQ(entity->GetComponent<Transform>()->GetPosition().x, 20.0f);
+    EXPECT_EQ(prediction.GetPendingCount(), 5u);
+    EXPECT_EQ(prediction.GetInput(15), nullptr);
+}
@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+#include "FastEngine/Network/BitStream.h"
+#include "FastEngine/Network/NetworkManager.h"
+#include <cmath>
+#include <cstring>
+#include <string>
+
+using namespace FastEngine;
+
+TEST(BitStreamTest, BitsRoundTrip) {
+    uint8_t buffer[64];
+    BitWriter writer(buffer, sizeof(buffer));
+    writer.WriteBits(5, 3);
+    writer.WriteBool(true);
+    writer.WriteBits(0xFFFFFFFFu, 32);
+    writer.WriteBits(0x1234, 13);
+    writer.WriteFloat(-3.25f);
+    writer.Flush();
+    EXPECT_FALSE(writer.IsOverflow());
+    EXPECT_EQ(writer.GetBytesWritten(), (3 + 1 + 32 + 13 + 32 + 7) / 8u);
+
+    BitReader reader(buffer, writer.GetBytesWritten());
+    uint32_t value = 0;
+    bool flag = false;
+    float number = 0.0f;
+    ASSERT_TRUE(reader.ReadBits(3, value));
+    EXPECT_EQ(value, 5u);
+    ASSERT_TRUE(reader.ReadBool(flag));
+    EXPECT_TRUE(flag);
+    ASSERT_TRUE(reader.ReadBits(32, value));
+    EXPECT_EQ(value, 0xFFFFFFFFu);
+    ASSERT_TRUE(reader.ReadBits(13, value));
+    EXPECT_EQ(value, 0x1234u);
+    ASSERT_TRUE(reader.ReadFloat(number));
+    EXPECT_EQ(number, -3.25f);
+}
+
+TEST(BitStreamTest, VarintSizes) {
+    uint8_t buffer[64];
+    BitWriter writer(buffer, sizeof(buffer));
+    writer.WriteVarUint(1);
+    EXPECT_EQ(writer.GetBytesWritten(), 1u);
+    writer.WriteVarUint(300);
+    EXPECT_EQ(writer.GetBytesWritten(), 3u);
+    writer.WriteVarUint(0xFFFFFFFFFFFFFFFFull);
+    writer.WriteVarInt(-2);
+    writer.WriteVarInt(1000000);
+    writer.Flush();
+
+    BitReader reader(buffer, writer.GetBytesWritten());
+    uint64_t value = 0;
+    int64_t signedValue = 0;
+    ASSERT_TRUE(reader.ReadVarUint(value));
+    EXPECT_EQ(value, 1u);
+    ASSERT_TRUE(reader.ReadVarUint(value));
+    EXPECT_EQ(value, 300u);
+    ASSERT_TRUE(reader.ReadVarUint(value));
+    EXPECT_EQ(value, 0xFFFFFFFFFFFFFFFFull);
+    ASSERT_TRUE(reader.ReadVarInt(signedValue));
+    EXPECT_EQ(signedValue, -2);
+    ASSERT_TRUE(reader.ReadVarInt(signedValue));
+    EXPECT_EQ(signedValue, 1000000);
+}
+
+TEST(BitStreamTest, QuantizationPrecisionAndBounds) {
+    FloatQuantization quantization(-100.0f, 100.0f, 0.01f);
+    EXPECT_EQ(quantization.bits, 15u); // 20000 шагов
+
+    for (float value = -100.0f; value <= 100.0f; value += 0.737f) {
+        float restored = quantization.Dequantize(quantization.Quantize(value));
+        EXPECT_NEAR(restored, value, 0.005f + 1e-4f);
+    }
+    // Вне диапазона - прижатие к границам
+    EXPECT_FLOAT_EQ(quantization.Dequantize(quantization.Quantize(500.0f)), 100.0f);
+    EXPECT_FLOAT_EQ(quantization.Dequantize(quantization.Quantize(-500.0f)), -100.0f);
+    EXPECT_EQ(quantization.Quantize(std::nanf("")), 0u);
+}
+
+TEST(BitStreamTest, WriterOverflowDoesNotWritePastBuffer) {
+    uint8_t buffer[8];
+    std::memset(buffer, 0xCC, sizeof(buffer));
+    BitWriter writer(buffer, 4);
+    writer.WriteBits(0, 32);
+    EXPECT_FALSE(writer.IsOverflow());
+    writer.WriteBits(0, 1);
+    writer.WriteString("overflowing string");
+    writer.Flush();
+    EXPECT_TRUE(writer.IsOverflow());
+    for (int i = 4; i < 8; ++i) {
+        EXPECT_EQ(buffer[i], 0xCC);
+    }
+
+    // После Reset буфер используется заново
+    writer.Reset();
+    writer.WriteVarUint(7);
+    EXPECT_FALSE(writer.IsOverflow());
+    EXPECT_EQ(writer.GetBytesWritten(), 1u);
+}
+
+TEST(BitStreamTest, ReaderRejectsTruncatedData) {
+    uint8_t buffer[64];
+    BitWriter writer(buffer, sizeof(buffer));
+    writer.WriteString("hello, network");
+    writer.WriteVarUint(123456);
+    writer.Flush();
+    uint32_t size = writer.GetBytesWritten();
+
+    for (uint32_t truncated = 0; truncated < size; ++truncated) {
+        BitReader reader(buffer, truncated);
+        std::string text;
+        uint32_t value = 0;
+        bool ok = reader.ReadString(text) && reader.ReadVarUint(value);
+        EXPECT_FALSE(ok);
+        EXPECT_TRUE(reader.IsError());
+    }
+
+    // Длина строки больше оставшихся данных
+    uint8_t forged[4];
+    BitWriter forger(forged, sizeof(forged));
+    forger.WriteVarUint(1000);
+    forger.Flush();
+    BitReader reader(forged, forger.GetBytesWritten());
+    std::string text;
+    EXPECT_FALSE(reader.ReadString(text));
+
+    // Код вне диапазона квантования
+    FloatQuantization quantization(0.0f, 10.0f, 1.0f); // 4 бита, коды 0..10
+    uint8_t code[1] = {15};
+    BitReader codeReader(code, 1);
+    float value = 0.0f;
+    EXPECT_FALSE(codeReader.ReadQuantized(quantization, value));
+}
+
+TEST(NetworkSerializerTest, ObjectStateRoundTrip) {
+    NetworkObjectSchema schema;
+    NetworkObject source;
+    source.SetNetId(4242);
+    source.SetOwnerId("player_7");
+    source.SetPosition(glm::vec3(12.345f, -1000.5f, 3999.99f));
+    source.SetRotation(glm::vec3(90.0f, -45.5f, 359.9f));
+
+    uint8_t buffer[64];
+    BitWriter writer(buffer, sizeof(buffer));
+    writer.WriteVarUint(source.GetNetId());
+    source.WriteState(writer, schema);
+    writer.Flush();
+    ASSERT_FALSE(writer.IsOverflow());
+
+    BitReader reader(buffer, writer.GetBytesWritten());
+    uint32_t netId = 0;
+    NetworkObject target;
+    ASSERT_TRUE(reader.ReadVarUint(netId));
+    ASSERT_TRUE(target.ReadState(reader, schema));
+    EXPECT_EQ(netId, 4242u);
+    EXPECT_EQ(target.GetOwnerId(), "player_7");
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_NEAR(target.GetPosition()[i], source.GetPosition()[i], schema.position.precision * 0.5f + 1e-3f);
+        EXPECT_NEAR(target.GetRotation()[i], source.GetRotation()[i], schema.rotation.precision * 0.5f + 1e-3f);
+    }
+
+    // Только позиция: 3 бита маски + 3 * 20 бит
+    BitWriter positionWriter(buffer, sizeof(buffer));
+    source.WriteState(positionWriter, schema, NETWORK_FIELD_POSITION);
+    EXPECT_EQ(positionWriter.GetBitsWritten(), 3u + 3u * schema.position.bits);
+}
+
+TEST(NetworkSerializerTest, ObjectStateUnchangedOnCorruptData) {
+    NetworkObjectSchema schema(FloatQuantization(-10.0f, 10.0f, 0.1f), FloatQuantization(-180.0f, 180.0f, 1.0f));
+    NetworkObject source;
+    source.SetPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+    source.SetRotation(glm::vec3(10.0f, 20.0f, 30.0f));
+
+    uint8_t buffer[32];
+    BitWriter writer(buffer, sizeof(buffer));
+    source.WriteState(writer, schema, NETWORK_FIELD_POSITION | NETWORK_FIELD_ROTATION);
+    writer.Flush();
+
+    NetworkObject target;
+    target.SetPosition(glm::vec3(-5.0f));
+    BitReader reader(buffer, writer.GetBytesWritten() - 1);
+    EXPECT_FALSE(target.ReadState(reader, schema));
+    EXPECT_EQ(target.GetPosition(), glm::vec3(-5.0f));
+}
+
+TEST(NetworkSerializerTest, JsonRoundTrip) {
+    NetworkObject source;
+    source.SetId("crate_1");
+    source.SetOwnerId("server");
+    source.SetPosition(glm::vec3(1.5f, -2.25f, 3.0f));
+    source.SetRotation(glm::vec3(0.0f, 90.0f, 180.0f));
+
+    NetworkObject target;
+    target.Deserialize(source.Serialize());
+    EXPECT_EQ(target.GetId(), "crate_1");
+    EXPECT_EQ(target.GetOwnerId(), "server");
+    EXPECT_EQ(target.GetPosition(), source.GetPosition());
+    EXPECT_EQ(target.GetRotation(), source.GetRotation());
+}
+
+TEST(NetworkSerializerTest, MessageRoundTrip) {
+    NetworkMessage source(NetworkMessageType::ObjectUpdate, std::string("\0\1\2binary", 9), "client_3");
+    source.sequence = 70000;
+    source.timestamp = 123;
+
+    uint8_t buffer[128];
+    BitWriter writer(buffer, sizeof(buffer));
+    source.Write(writer);
+    ASSERT_FALSE(writer.IsOverflow());
+    // 4 бита типа, varint 3 + 1 байта, строки с длиной
+    EXPECT_LE(writer.GetBytesWritten(), 1u + 3u + 1u + 9u + 10u);
+
+    NetworkMessage target;
+    BitReader reader(buffer, writer.GetBytesWritten());
+    ASSERT_TRUE(target.Read(reader));
+    EXPECT_EQ(target.type, NetworkMessageType::ObjectUpdate);
+    EXPECT_EQ(target.sequence, 70000u);
+    EXPECT_EQ(target.timestamp, 123u);
+    EXPECT_EQ(target.senderId, "client_3");
+    EXPECT_EQ(target.data, source.data);
+
+    // Неизвестный тип сообщения
+    buffer[0] = 0x0F;
+    BitReader badReader(buffer, writer.GetBytesWritten());
+    EXPECT_FALSE(target.Read(badReader));
+}
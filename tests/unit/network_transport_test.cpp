@@ -0,0 +1,433 @@
+#include <gtest/gtest.h>
+#include "FastEngine/Network/NetworkManager.h"
+#include "FastEngine/Network/NetworkConnection.h"
+#include "FastEngine/Network/NetworkTransport.h"
+#include "FastEngine/Platform/SpscRing.h"
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace FastEngine;
+
+namespace {
+
+// Принятые соединением сообщения (первые 4 байта - номер)
+struct DeliveredLog {
+    PacketPool* pool;
+    std::vector<uint32_t> ids;
+};
+
+void LogDelivery(void* userData, NetworkPacket* payload) {
+    DeliveredLog* log = static_cast<DeliveredLog*>(userData);
+    uint32_t id = 0;
+    if (payload->size >= 4) {
+        std::memcpy(&id, payload->data, 4);
+    }
+    log->ids.push_back(id);
+    log->pool->Release(payload);
+}
+
+NetworkPacket* MakePayload(PacketPool& pool, uint32_t id, uint32_t size = 32) {
+    NetworkPacket* payload = pool.Acquire();
+    payload->size = size;
+    std::memset(payload->data, 0xAB, size);
+    std::memcpy(payload->data, &id, 4);
+    return payload;
+}
+
+// Обмен пакетами между двумя соединениями с потерей каждого lossEvery-го пакета
+void Exchange(NetworkConnection& a, NetworkConnection& b, double time, int lossEvery, int& packetCounter,
+              DeliveredLog& logA, DeliveredLog& logB) {
+    std::vector<NetworkPacket> buffers(NETWORK_BATCH_SIZE);
+    NetworkPacket* batch[NETWORK_BATCH_SIZE];
+    for (int i = 0; i < NETWORK_BATCH_SIZE; ++i) {
+        batch[i] = &buffers[i];
+    }
+
+    NetworkConnection* from[2] = {&a, &b};
+    NetworkConnection* to[2] = {&b, &a};
+    DeliveredLog* logs[2] = {&logB, &logA};
+    for (int side = 0; side < 2; ++side) {
+        int count = from[side]->WritePackets(time, batch, NETWORK_BATCH_SIZE);
+        for (int i = 0; i < count; ++i) {
+            if (lossEvery > 0 && ++packetCounter % lossEvery == 0) {
+                continue;
+            }
+            EXPECT_TRUE(to[side]->ReadPacket(*batch[i], time, LogDelivery, logs[side]));
+        }
+    }
+}
+
+template<typename Predicate>
+bool WaitFor(Predicate predicate, int timeoutMs) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (predicate()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return predicate();
+}
+
+} // namespace
+
+TEST(NetworkTransportTest, SpscRingPreservesOrderAcrossThreads) {
+    SpscRing<uint32_t> ring(100);
+    EXPECT_EQ(ring.GetCapacity(), 128u);
+
+    const uint32_t count = 200000;
+    std::thread producer([&ring]() {
+        for (uint32_t i = 0; i < count; ++i) {
+            while (!ring.Push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t expected = 0;
+    while (expected < count) {
+        uint32_t value;
+        if (ring.Pop(value)) {
+            ASSERT_EQ(value, expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(ring.IsEmpty());
+}
+
+TEST(NetworkTransportTest, PacketPoolReusesBuffers) {
+    PacketPool pool(4);
+    std::vector<NetworkPacket*> packets;
+    for (int i = 0; i < 4; ++i) {
+        packets.push_back(pool.Acquire());
+        ASSERT_NE(packets.back(), nullptr);
+    }
+    EXPECT_EQ(pool.Acquire(), nullptr);
+    EXPECT_EQ(pool.GetFreeCount(), 0u);
+
+    pool.Release(packets[2]);
+    EXPECT_EQ(pool.Acquire(), packets[2]);
+
+    for (NetworkPacket* packet : packets) {
+        pool.Release(packet);
+    }
+    EXPECT_EQ(pool.GetFreeCount(), 4u);
+
+    // Одновременные Acquire/Release из двух потоков не теряют буферы
+    auto churn = [&pool]() {
+        for (int i = 0; i < 20000; ++i) {
+            NetworkPacket* packet = pool.Acquire();
+            if (packet) {
+                packet->size = static_cast<uint32_t>(i);
+                pool.Release(packet);
+            }
+        }
+    };
+    std::thread other(churn);
+    churn();
+    other.join();
+    EXPECT_EQ(pool.GetFreeCount(), 4u);
+}
+
+TEST(NetworkTransportTest, ReliableChannelsSurvivePacketLoss) {
+    PacketPool pool(1024);
+    NetworkConnection client(NetworkAddress(0x7F000001u, 1000), pool);
+    NetworkConnection server(NetworkAddress(0x7F000001u, 2000), pool);
+
+    const uint32_t messageCount = 300;
+    for (uint32_t i = 0; i < messageCount; ++i) {
+        ASSERT_TRUE(client.QueueMessage(NetworkChannel::ReliableOrdered, MakePayload(pool, i)));
+        ASSERT_TRUE(client.QueueMessage(NetworkChannel::ReliableUnordered, MakePayload(pool, 100000 + i)));
+    }
+
+    DeliveredLog clientLog{&pool, {}};
+    DeliveredLog serverLog{&pool, {}};
+    int packetCounter = 0;
+    double time = 0.0;
+    for (int step = 0; step < 400 && serverLog.ids.size() < messageCount * 2; ++step) {
+        time += 0.02;
+        Exchange(client, server, time, 4, packetCounter, clientLog, serverLog);
+    }
+    // Последние подтверждения
+    for (int step = 0; step < 20; ++step) {
+        time += 0.02;
+        Exchange(client, server, time, 0, packetCounter, clientLog, serverLog);
+    }
+
+    std::vector<uint32_t> ordered;
+    std::vector<bool> unorderedSeen(messageCount, false);
+    for (size_t i = 0; i < serverLog.ids.size(); ++i) {
+        if (serverLog.ids[i] < 100000) {
+            ordered.push_back(serverLog.ids[i]);
+        } else {
+            uint32_t index = serverLog.ids[i] - 100000;
+            ASSERT_LT(index, messageCount);
+            EXPECT_FALSE(unorderedSeen[index]) << "duplicate " << index;
+            unorderedSeen[index] = true;
+        }
+    }
+
+    ASSERT_EQ(ordered.size(), messageCount);
+    for (uint32_t i = 0; i < messageCount; ++i) {
+        EXPECT_EQ(ordered[i], i);
+        EXPECT_TRUE(unorderedSeen[i]);
+    }
+
+    // Потери видны по подтверждениям, все буферы вернулись в пул
+    EXPECT_GT(client.GetStats().packetsLost, 0u);
+    EXPECT_GT(client.GetStats().rttSamples, 0u);
+    EXPECT_EQ(pool.GetFreeCount(), pool.GetCapacity());
+}
+
+TEST(NetworkTransportTest, UnreliableMessagesAreNotResent) {
+    PacketPool pool(64);
+    NetworkConnection client(NetworkAddress(0x7F000001u, 1000), pool);
+    NetworkConnection server(NetworkAddress(0x7F000001u, 2000), pool);
+
+    for (uint32_t i = 0; i < 10; ++i) {
+        client.QueueMessage(NetworkChannel::Unreliable, MakePayload(pool, i, 200));
+    }
+
+    DeliveredLog clientLog{&pool, {}};
+    DeliveredLog serverLog{&pool, {}};
+    int packetCounter = 0;
+    double time = 0.0;
+    for (int step = 0; step < 20; ++step) {
+        time += 0.05;
+        Exchange(client, server, time, 2, packetCounter, clientLog, serverLog);
+    }
+
+    // Каждый второй пакет потерян; пакет вмещает 5 сообщений по 200 байт
+    EXPECT_LT(serverLog.ids.size(), 10u);
+    EXPECT_GT(serverLog.ids.size(), 0u);
+    EXPECT_EQ(pool.GetFreeCount(), pool.GetCapacity());
+
+    // Простой канал: только keep-alive и подтверждения, без бесконечного обмена
+    uint32_t sentBefore = client.GetStats().packetsSent + server.GetStats().packetsSent;
+    time += 0.01;
+    Exchange(client, server, time, 0, packetCounter, clientLog, serverLog);
+    time += 0.01;
+    Exchange(client, server, time, 0, packetCounter, clientLog, serverLog);
+    EXPECT_LE(client.GetStats().packetsSent + server.GetStats().packetsSent, sentBefore + 1);
+}
+
+TEST(NetworkTransportTest, PoolExhaustionDoesNotStallOrderedChannel) {
+    PacketPool senderPool(256);
+    PacketPool receiverPool(4);
+    NetworkConnection client(NetworkAddress(0x7F000001u, 1000), senderPool);
+    NetworkConnection server(NetworkAddress(0x7F000001u, 2000), receiverPool);
+
+    const uint32_t messageCount = 40;
+    for (uint32_t i = 0; i < messageCount; ++i) {
+        ASSERT_TRUE(client.QueueMessage(NetworkChannel::ReliableOrdered, MakePayload(senderPool, i, 400)));
+    }
+
+    // Получатель держит доставленные буферы, пока игровой поток их не заберет
+    std::vector<NetworkPacket*> delivered;
+    auto keep = [](void* userData, NetworkPacket* payload) {
+        static_cast<std::vector<NetworkPacket*>*>(userData)->push_back(payload);
+    };
+    std::vector<NetworkPacket> buffers(NETWORK_BATCH_SIZE);
+    NetworkPacket* batch[NETWORK_BATCH_SIZE];
+    for (int i = 0; i < NETWORK_BATCH_SIZE; ++i) {
+        batch[i] = &buffers[i];
+    }
+
+    DeliveredLog clientLog{&senderPool, {}};
+    std::vector<uint32_t> ids;
+    int packetCounter = 0;
+    double time = 0.0;
+    for (int step = 0; step < 400 && ids.size() < messageCount; ++step) {
+        time += 0.02;
+        int count = client.WritePackets(time, batch, NETWORK_BATCH_SIZE);
+        for (int i = 0; i < count; ++i) {
+            // Потери заставляют придерживать сообщения, пришедшие раньше
+            if (++packetCounter % 3 != 0) {
+                EXPECT_TRUE(server.ReadPacket(*batch[i], time, keep, &delivered));
+            }
+        }
+        count = server.WritePackets(time, batch, NETWORK_BATCH_SIZE);
+        for (int i = 0; i < count; ++i) {
+            client.ReadPacket(*batch[i], time, LogDelivery, &clientLog);
+        }
+        for (NetworkPacket* payload : delivered) {
+            uint32_t id = 0;
+            std::memcpy(&id, payload->data, 4);
+            ids.push_back(id);
+            receiverPool.Release(payload);
+        }
+        delivered.clear();
+    }
+
+    // Пакеты без буферов не подтверждались и пришли повторно
+    EXPECT_GT(server.GetStats().packetsRefused, 0u);
+    ASSERT_EQ(ids.size(), messageCount);
+    for (uint32_t i = 0; i < messageCount; ++i) {
+        EXPECT_EQ(ids[i], i);
+    }
+    EXPECT_EQ(receiverPool.GetFreeCount(), receiverPool.GetCapacity());
+}
+
+TEST(NetworkTransportTest, ReliableQueueIsCappedPerConnection) {
+    PacketPool pool(NetworkConnection::MAX_PENDING_RELIABLE + 8);
+    NetworkConnection connection(NetworkAddress(0x7F000001u, 1000), pool);
+    for (size_t i = 0; i < NetworkConnection::MAX_PENDING_RELIABLE; ++i) {
+        NetworkChannel channel = i % 2 ? NetworkChannel::ReliableOrdered : NetworkChannel::ReliableUnordered;
+        ASSERT_TRUE(connection.QueueMessage(channel, MakePayload(pool, static_cast<uint32_t>(i), 8)));
+    }
+    EXPECT_FALSE(connection.QueueMessage(NetworkChannel::ReliableOrdered, MakePayload(pool, 0, 8)));
+    EXPECT_EQ(pool.GetFreeCount(), 8u);
+}
+
+TEST(NetworkTransportTest, MalformedPacketsAreRejected) {
+    PacketPool pool(16);
+    NetworkConnection connection(NetworkAddress(0x7F000001u, 1000), pool);
+    DeliveredLog log{&pool, {}};
+
+    NetworkPacket packet;
+    packet.size = 5;
+    EXPECT_FALSE(connection.ReadPacket(packet, 0.0, LogDelivery, &log));
+
+    // Заголовок верный, но длина сообщения выходит за пакет
+    packet.size = 16;
+    std::memset(packet.data, 0, packet.size);
+    packet.data[0] = NetworkConnection::PROTOCOL_ID & 0xFF;
+    packet.data[1] = NetworkConnection::PROTOCOL_ID >> 8;
+    packet.data[11] = static_cast<uint8_t>(NetworkChannel::Unreliable);
+    packet.data[12] = 200;
+    EXPECT_FALSE(connection.ReadPacket(packet, 0.0, LogDelivery, &log));
+    EXPECT_TRUE(log.ids.empty());
+}
+
+TEST(NetworkTransportTest, AddressParsing) {
+    NetworkAddress address;
+    ASSERT_TRUE(NetworkAddress::Resolve("10.1.2.3", 7777, address));
+    EXPECT_EQ(address.ip, 0x0A010203u);
+    EXPECT_EQ(address.ToString(), "10.1.2.3:7777");
+
+    NetworkAddress parsed;
+    ASSERT_TRUE(NetworkAddress::Parse(address.ToString(), parsed));
+    EXPECT_EQ(parsed, address);
+    EXPECT_FALSE(NetworkAddress::Parse("no-port", parsed));
+    EXPECT_FALSE(NetworkAddress::Resolve("localhost", 0, parsed));
+}
+
+TEST(NetworkTransportTest, ManagersExchangeMessagesOverLossyLoopback) {
+    NetworkManager server;
+    NetworkManager client;
+    server.Initialize();
+    client.Initialize();
+
+    std::unique_ptr<LoopbackTransport> serverTransport(new LoopbackTransport());
+    std::unique_ptr<LoopbackTransport> clientTransport(new LoopbackTransport());
+    serverTransport->SetPacketLoss(0.2f);
+    serverTransport->SetLatency(2.0f);
+    clientTransport->SetPacketLoss(0.2f);
+    clientTransport->SetLatency(2.0f);
+    clientTransport->SetSeed(777);
+    server.SetTransport(std::move(serverTransport));
+    client.SetTransport(std::move(clientTransport));
+
+    ASSERT_TRUE(server.StartServer(0));
+    ASSERT_TRUE(client.Connect("127.0.0.1", server.GetLocalAddress().port));
+
+    std::vector<std::string> received;
+    server.SetOnMessageReceived([&received](const NetworkMessage& message) {
+        if (message.type == NetworkMessageType::Custom) {
+            received.push_back(message.data);
+        }
+    });
+
+    const int messageCount = 200;
+    for (int i = 0; i < messageCount; ++i) {
+        client.SendMessage(NetworkMessage(NetworkMessageType::Custom, std::to_string(i)));
+    }
+
+    bool delivered = WaitFor([&]() {
+        server.Update(0.001f);
+        client.Update(0.001f);
+        return received.size() >= static_cast<size_t>(messageCount);
+    }, 10000);
+    ASSERT_TRUE(delivered) << received.size() << " messages received";
+
+    // Поток ненадежных обновлений, пока потери не станут видны по подтверждениям
+    ASSERT_TRUE(WaitFor([&]() {
+        client.SendMessage(NetworkMessage(NetworkMessageType::PlayerUpdate, "tick", "", NetworkChannel::Unreliable));
+        server.Update(0.001f);
+        client.Update(0.001f);
+        return client.GetProfiler().GetPacketsLost() > 0 && client.GetProfiler().GetPacketsSent() > 100;
+    }, 10000));
+
+    for (int i = 0; i < messageCount; ++i) {
+        EXPECT_EQ(received[i], std::to_string(i));
+    }
+
+    // Подключение клиента - игрок на сервере; профилировщик видит RTT и потери
+    EXPECT_EQ(server.GetPlayers().size(), 1u);
+    EXPECT_EQ(server.GetConnectionCount(), 1);
+    EXPECT_GT(client.GetProfiler().GetAverageLatency(), 0.0f);
+    EXPECT_GT(client.GetProfiler().GetPacketLoss(), 0.0f);
+    EXPECT_LT(client.GetProfiler().GetPacketLoss(), 0.5f);
+
+    // Ответ конкретному игроку по его идентификатору-адресу
+    std::vector<std::string> replies;
+    client.SetOnMessageReceived([&replies](const NetworkMessage& message) {
+        if (message.type == NetworkMessageType::Custom) {
+            replies.push_back(message.data);
+        }
+    });
+    server.SendMessageToPlayer(server.GetPlayers()[0].id, NetworkMessage(NetworkMessageType::Custom, "welcome"));
+    ASSERT_TRUE(WaitFor([&]() {
+        server.Update(0.001f);
+        client.Update(0.001f);
+        return !replies.empty();
+    }, 5000));
+    EXPECT_EQ(replies[0], "welcome");
+
+    client.Disconnect();
+    server.StopServer();
+    EXPECT_EQ(client.GetDroppedMessages(), 0u);
+}
+
+TEST(NetworkTransportTest, ManagersExchangeMessagesOverUdp) {
+    NetworkManager server;
+    NetworkManager client;
+    server.Initialize();
+    client.Initialize();
+
+    if (!server.StartServer(0)) {
+        GTEST_SKIP() << "UDP sockets are not available";
+    }
+    ASSERT_TRUE(client.Connect("127.0.0.1", server.GetLocalAddress().port));
+
+    int received = 0;
+    server.SetOnMessageReceived([&received](const NetworkMessage& message) {
+        if (message.type == NetworkMessageType::PlayerUpdate) {
+            ++received;
+        }
+    });
+
+    // Больше сообщений, чем помещается в пачку пакетов
+    const int messageCount = 500;
+    std::string payload(600, 'x');
+    for (int i = 0; i < messageCount; ++i) {
+        client.SendMessage(NetworkMessage(NetworkMessageType::PlayerUpdate, payload, "", NetworkChannel::ReliableUnordered));
+    }
+
+    ASSERT_TRUE(WaitFor([&]() {
+        server.Update(0.001f);
+        client.Update(0.001f);
+        return received == messageCount;
+    }, 10000)) << received << " messages received";
+
+    EXPECT_EQ(server.GetPlayers().size(), 1u);
+    client.Disconnect();
+    server.StopServer();
+}
@@ -0,0 +1,305 @@
+#include <gtest/gtest.h>
+#include "FastEngine/Network/NetworkManager.h"
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace FastEngine;
+
+namespace {
+
+// Сервер и клиенты, соединенные очередями с задержкой и потерями
+class ReplicationHarness {
+public:
+    explicit ReplicationHarness(int clientCount, float loss = 0.0f, int latency = 1)
+        : m_loss(loss), m_latency(latency), m_tick(0), m_random(12345), m_bytes(0) {
+        m_server.SetSendCallback([this](const std::string& target, const uint8_t* data, uint32_t size) {
+            Queue(target, "server", data, size);
+            m_bytes += size;
+        });
+        for (int i = 0; i < clientCount; ++i) {
+            std::string id = "client_" + std::to_string(i);
+            m_server.AddClient(id);
+            m_clients.emplace_back(new ObjectReplicator());
+            m_clients.back()->SetSendCallback([this, id](const std::string&, const uint8_t* data, uint32_t size) {
+                Queue("server", id, data, size);
+            });
+        }
+    }
+
+    ObjectReplicator& Server() { return m_server; }
+    ObjectReplicator& Client(int index) { return *m_clients[index]; }
+    uint64_t TakeBytes() { uint64_t bytes = m_bytes; m_bytes = 0; return bytes; }
+
+    // Один снимок сервера и доставка всего, что пришло к этому тику
+    void Step() {
+        m_server.UpdateReplication(1.0f / 20.0f);
+        ++m_tick;
+        while (!m_queue.empty() && m_queue.front().deliverTick <= m_tick) {
+            Datagram datagram = m_queue.front();
+            m_queue.pop_front();
+            if (datagram.target == "server") {
+                m_server.HandlePayload(datagram.sender, datagram.data.data(), static_cast<uint32_t>(datagram.data.size()));
+            } else {
+                int index = std::stoi(datagram.target.substr(7));
+                m_clients[index]->HandlePayload(datagram.sender, datagram.data.data(),
+                                                static_cast<uint32_t>(datagram.data.size()));
+            }
+        }
+    }
+
+private:
+    struct Datagram {
+        std::string target;
+        std::string sender;
+        std::vector<uint8_t> data;
+        int deliverTick;
+    };
+
+    ObjectReplicator m_server;
+    std::vector<std::unique_ptr<ObjectReplicator>> m_clients;
+    std::deque<Datagram> m_queue;
+    float m_loss;
+    int m_latency;
+    int m_tick;
+    uint32_t m_random;
+    uint64_t m_bytes;
+
+    void Queue(const std::string& target, const std::string& sender, const uint8_t* data, uint32_t size) {
+        m_random = m_random * 1664525u + 1013904223u;
+        if ((m_random >> 8) * (1.0f / 16777216.0f) < m_loss) {
+            return;
+        }
+        m_queue.push_back(Datagram{target, sender, std::vector<uint8_t>(data, data + size), m_tick + m_latency});
+    }
+};
+
+std::shared_ptr<NetworkObject> MakeObject(const std::string& id, const glm::vec3& position) {
+    auto object = std::make_shared<NetworkObject>();
+    object->SetId(id);
+    object->SetOwnerId("server");
+    object->SetPosition(position);
+    return object;
+}
+
+void ExpectReplicated(ObjectReplicator& client, const NetworkObject& source, float tolerance) {
+    auto replica = client.GetReplicatedObject(source.GetNetId());
+    ASSERT_NE(replica, nullptr) << source.GetId();
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_NEAR(replica->GetPosition()[i], source.GetPosition()[i], tolerance) << source.GetId();
+        EXPECT_NEAR(replica->GetRotation()[i], source.GetRotation()[i], tolerance) << source.GetId();
+    }
+}
+
+} // namespace
+
+TEST(ObjectReplicatorTest, ClientConvergesAndUnchangedObjectsCostNothing) {
+    ReplicationHarness harness(1);
+    std::vector<std::shared_ptr<NetworkObject>> objects;
+    for (int i = 0; i < 50; ++i) {
+        objects.push_back(MakeObject("object_" + std::to_string(i), glm::vec3(i * 1.5f, 0.0f, -i * 0.5f)));
+        harness.Server().StartReplicating(objects.back());
+    }
+
+    for (int step = 0; step < 5; ++step) {
+        harness.Step();
+    }
+    for (auto& object : objects) {
+        ExpectReplicated(harness.Client(0), *object, 0.01f);
+    }
+    EXPECT_EQ(harness.Client(0).GetReplicatedObject(objects[0]->GetNetId())->GetOwnerId(), "server");
+
+    // Все подтверждено: пакеты больше не отправляются
+    harness.TakeBytes();
+    harness.Step();
+    harness.Step();
+    EXPECT_EQ(harness.TakeBytes(), 0u);
+
+    // Сдвиг одного объекта - одна короткая разностная запись (плюс
+    // заголовок с номером снимка и серверным временем)
+    objects[7]->SetPosition(objects[7]->GetPosition() + glm::vec3(0.05f, 0.0f, 0.0f));
+    harness.Step();
+    EXPECT_EQ(harness.Server().GetLastObjectsSent(), 1u);
+    EXPECT_LT(harness.Server().GetLastBytesSent(), 12u);
+    harness.Step();
+    ExpectReplicated(harness.Client(0), *objects[7], 0.01f);
+}
+
+TEST(ObjectReplicatorTest, InterestLimitsObjectsByDistance) {
+    ReplicationHarness harness(2);
+    harness.Server().SetMaxReplicationDistance(22.0f);
+    harness.Server().SetClientViewpoint("client_0", glm::vec3(0.0f));
+    harness.Server().SetClientViewpoint("client_1", glm::vec3(200.0f, 0.0f, 0.0f));
+
+    std::vector<std::shared_ptr<NetworkObject>> objects;
+    for (int i = 0; i < 100; ++i) {
+        objects.push_back(MakeObject("object_" + std::to_string(i), glm::vec3(i * 5.0f, 0.0f, 0.0f)));
+        harness.Server().StartReplicating(objects.back());
+    }
+    for (int step = 0; step < 4; ++step) {
+        harness.Step();
+    }
+
+    for (auto& object : objects) {
+        float x = object->GetPosition().x;
+        EXPECT_EQ(harness.Client(0).GetReplicatedObject(object->GetNetId()) != nullptr, x <= 22.0f) << x;
+        EXPECT_EQ(harness.Client(1).GetReplicatedObject(object->GetNetId()) != nullptr,
+                  std::abs(x - 200.0f) <= 22.0f) << x;
+    }
+}
+
+TEST(ObjectReplicatorTest, BudgetPrioritizesRelevantAndCloseObjects) {
+    ReplicationHarness harness(1);
+    harness.Server().SetMaxReplicationDistance(1000.0f);
+    harness.Server().SetBandwidthBudget(40.0f * 20.0f); // 40 байт на снимок
+
+    std::vector<std::shared_ptr<NetworkObject>> objects;
+    for (int i = 0; i < 40; ++i) {
+        objects.push_back(MakeObject("object_" + std::to_string(i), glm::vec3(10.0f + i * 20.0f, 0.0f, 0.0f)));
+        harness.Server().StartReplicating(objects.back());
+    }
+    harness.Server().SetObjectRelevance("object_39", 100.0f);
+
+    // Пока подтверждение не пришло, важный объект повторяется
+    harness.Step();
+    harness.Step();
+    harness.Step();
+    EXPECT_LT(harness.Server().GetLastObjectsSent(), 10u);
+    EXPECT_NE(harness.Client(0).GetReplicatedObject(objects[39]->GetNetId()), nullptr);
+    EXPECT_NE(harness.Client(0).GetReplicatedObject(objects[0]->GetNetId()), nullptr);
+    EXPECT_EQ(harness.Client(0).GetReplicatedObject(objects[30]->GetNetId()), nullptr);
+
+    // Давность поднимает приоритет дальних объектов: в итоге доходят все
+    for (int step = 0; step < 40; ++step) {
+        harness.Step();
+    }
+    for (auto& object : objects) {
+        ExpectReplicated(harness.Client(0), *object, 0.01f);
+    }
+}
+
+TEST(ObjectReplicatorTest, DeltasStayExactUnderLossAndReordering) {
+    ReplicationHarness harness(3, 0.3f, 3);
+    harness.Server().SetMaxReplicationDistance(1000.0f);
+
+    std::vector<std::shared_ptr<NetworkObject>> objects;
+    for (int i = 0; i < 30; ++i) {
+        objects.push_back(MakeObject("object_" + std::to_string(i), glm::vec3(i * 3.0f, 1.0f, 2.0f)));
+        harness.Server().StartReplicating(objects.back());
+    }
+
+    // Объекты движутся туда и обратно: возврат к старому значению
+    // должен доходить, даже если промежуточный снимок потерян
+    for (int step = 0; step < 120; ++step) {
+        for (size_t i = 0; i < objects.size(); ++i) {
+            float phase = static_cast<float>(step + i) * 0.3f;
+            objects[i]->SetPosition(glm::vec3(i * 3.0f + std::sin(phase) * (i % 4 == 0 ? 50.0f : 0.2f), 1.0f,
+                                              (step / 10) % 2 == 0 ? 2.0f : 3.0f));
+            objects[i]->SetRotation(glm::vec3(0.0f, static_cast<float>((step * 7 + i) % 360), 0.0f));
+        }
+        harness.Step();
+    }
+    // После остановки неподтвержденное досылается, несмотря на потери
+    for (int step = 0; step < 60; ++step) {
+        harness.Step();
+    }
+    for (int client = 0; client < 3; ++client) {
+        for (auto& object : objects) {
+            ExpectReplicated(harness.Client(client), *object, 0.05f);
+        }
+    }
+}
+
+TEST(ObjectReplicatorTest, RemovedObjectsDisappearOnClients) {
+    ReplicationHarness harness(1, 0.2f, 2);
+    std::vector<std::shared_ptr<NetworkObject>> objects;
+    for (int i = 0; i < 10; ++i) {
+        objects.push_back(MakeObject("object_" + std::to_string(i), glm::vec3(static_cast<float>(i), 0.0f, 0.0f)));
+        harness.Server().StartReplicating(objects.back());
+    }
+    for (int step = 0; step < 20; ++step) {
+        harness.Step();
+    }
+    ASSERT_NE(harness.Client(0).GetReplicatedObject(objects[3]->GetNetId()), nullptr);
+
+    harness.Server().StopReplicating("object_3");
+    harness.Server().StopReplicating("object_5");
+    // Слот переиспользуется новым объектом с новым netId
+    auto replacement = MakeObject("replacement", glm::vec3(42.0f, 0.0f, 0.0f));
+    harness.Server().StartReplicating(replacement);
+    for (int step = 0; step < 30; ++step) {
+        harness.Step();
+    }
+
+    EXPECT_EQ(harness.Client(0).GetReplicatedObject(objects[3]->GetNetId()), nullptr);
+    EXPECT_EQ(harness.Client(0).GetReplicatedObject(objects[5]->GetNetId()), nullptr);
+    EXPECT_NE(harness.Client(0).GetReplicatedObject(objects[4]->GetNetId()), nullptr);
+    ExpectReplicated(harness.Client(0), *replacement, 0.01f);
+}
+
+TEST(ObjectReplicatorTest, RejectsCorruptPayloads) {
+    ObjectReplicator client;
+    const uint8_t empty[1] = {0};
+    EXPECT_FALSE(client.HandlePayload("server", empty, 0));
+    // Снимок с несуществующей базой
+    uint8_t data[16];
+    BitWriter writer(data, sizeof(data));
+    writer.WriteBits(0, 2);    // Снимок
+    writer.WriteVarUint(10);   // Номер
+    writer.WriteVarUint(0);    // Удалений нет
+    writer.WriteBits(1, 1);    // Объект
+    writer.WriteVarUint(5);
+    writer.WriteBits(1, 1);    // С базой
+    writer.WriteVarUint(2);
+    writer.WriteBits(NETWORK_FIELD_POSITION, 3);
+    writer.Flush();
+    EXPECT_FALSE(client.HandlePayload("server", data, writer.GetBytesWritten()));
+    EXPECT_EQ(client.GetReplicatedObject(5), nullptr);
+}
+
+TEST(ObjectReplicatorTest, ReplicatesThroughNetworkManager) {
+    NetworkManager server;
+    NetworkManager client;
+    server.Initialize();
+    client.Initialize();
+    server.SetTransport(std::unique_ptr<NetworkTransport>(new LoopbackTransport()));
+    client.SetTransport(std::unique_ptr<NetworkTransport>(new LoopbackTransport()));
+    ASSERT_TRUE(server.StartServer(0));
+    ASSERT_TRUE(client.Connect("127.0.0.1", server.GetLocalAddress().port));
+
+    ObjectReplicator serverReplicator;
+    ObjectReplicator clientReplicator;
+    serverReplicator.Initialize(&server);
+    clientReplicator.Initialize(&client);
+
+    auto crate = MakeObject("crate", glm::vec3(5.0f, 0.0f, 1.0f));
+    serverReplicator.StartReplicating(crate);
+
+    // Клиент сервера - подключившийся игрок; репликацию ведет NetworkManager::Update
+    auto converged = [&]() {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (std::chrono::steady_clock::now() < deadline) {
+            server.Update(0.05f);
+            client.Update(0.05f);
+            auto replica = clientReplicator.GetReplicatedObject(crate->GetNetId());
+            if (replica && glm::length(replica->GetPosition() - crate->GetPosition()) < 0.01f) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return false;
+    };
+    ASSERT_TRUE(converged());
+    EXPECT_EQ(serverReplicator.GetClientCount(), 1u);
+    EXPECT_NE(client.GetObject("net_" + std::to_string(crate->GetNetId())), nullptr);
+
+    crate->SetPosition(glm::vec3(-7.5f, 2.0f, 0.0f));
+    EXPECT_TRUE(converged());
+
+    client.Disconnect();
+    server.StopServer();
+}
@@ -0,0 +1,245 @@
+#include <gtest/gtest.h>
+#include "FastEngine/AI/NavMesh.h"
+#include "FastEngine/AI/Pathfinding.h"
+#include "FastEngine/Jobs/JobSystem.h"
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace FastEngine;
+
+class PathRequestTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::vector<std::vector<float>> heightmap(32, std::vector<float>(32, 1.0f));
+        navMesh = std::make_unique<NavMesh>();
+        ASSERT_TRUE(navMesh->GenerateFromHeightmap(heightmap, 1.0f, 0.5f));
+    }
+    
+    void StartManager(int workers) {
+        manager.SetWorkerCount(workers);
+        ASSERT_TRUE(manager.Initialize());
+        manager.AddNavMesh("grid", std::move(navMesh));
+    }
+    
+    // Крутим Update, пока не будут доставлены все запросы
+    void Drain() {
+        for (int i = 0; i < 1000 && manager.GetPendingRequestCount() > 0; ++i) {
+            manager.Update();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    
+    void TearDown() override {
+        manager.Shutdown();
+    }
+    
+    std::unique_ptr<NavMesh> navMesh;
+    PathfindingManager manager;
+};
+
+TEST_F(PathRequestTest, ResultsAreDeliveredWithRequestIds) {
+    StartManager(2);
+    
+    std::vector<PathRequestId> delivered;
+    auto callback = [&delivered](PathRequestId id, const PathfindingResult& result) {
+        EXPECT_TRUE(result.success);
+        delivered.push_back(id);
+    };
+    
+    PathRequestId first = manager.RequestPath("grid", glm::vec3(0, 1, 0), glm::vec3(30, 1, 30), callback);
+    PathRequestId second = manager.RequestPath("grid", glm::vec3(5, 1, 0), glm::vec3(0, 1, 25), callback);
+    EXPECT_NE(first, 0u);
+    EXPECT_NE(first, second);
+    EXPECT_TRUE(manager.IsRequestPending(first));
+    
+    Drain();
+    
+    ASSERT_EQ(delivered.size(), 2u);
+    EXPECT_FALSE(manager.IsRequestPending(first));
+    EXPECT_EQ(manager.GetTotalPathsFound(), 2);
+}
+
+TEST_F(PathRequestTest, SearchesRunAsJobsWithoutOwnWorkers) {
+    JobSystem& jobs = JobSystem::GetInstance();
+    ASSERT_TRUE(jobs.Start(3));
+    StartManager(0);
+    EXPECT_EQ(manager.GetWorkerCount(), 0);
+    
+    int delivered = 0;
+    auto callback = [&delivered](PathRequestId, const PathfindingResult& result) {
+        EXPECT_TRUE(result.success);
+        ++delivered;
+    };
+    for (int i = 0; i < 20; ++i) {
+        manager.RequestPath("grid", glm::vec3(0, 1, i), glm::vec3(30, 1, 31 - i), callback);
+    }
+    Drain();
+    EXPECT_EQ(delivered, 20);
+    EXPECT_GE(jobs.GetStats().executed, 20u);
+    
+    // Незавершенные задания дожидаются при Shutdown
+    manager.RequestPath("grid", glm::vec3(0, 1, 0), glm::vec3(30, 1, 30), callback);
+    manager.Update();
+    manager.Shutdown();
+    jobs.Stop();
+}
+
+TEST_F(PathRequestTest, IdenticalCellsAreDeduplicated) {
+    StartManager(0);
+    
+    int callbacks = 0;
+    auto callback = [&callbacks](PathRequestId, const PathfindingResult& result) {
+        EXPECT_TRUE(result.success);
+        ++callbacks;
+    };
+    
+    // Три запроса попадают в одни и те же клетки старта и цели
+    manager.RequestPath("grid", glm::vec3(1.1f, 1, 1.1f), glm::vec3(20.2f, 1, 20.2f), callback);
+    manager.RequestPath("grid", glm::vec3(1.4f, 1, 1.7f), glm::vec3(20.9f, 1, 20.1f), callback);
+    manager.RequestPath("grid", glm::vec3(1.9f, 1, 1.0f), glm::vec3(20.5f, 1, 20.5f), callback);
+    
+    Drain();
+    
+    EXPECT_EQ(callbacks, 3);
+    EXPECT_EQ(manager.GetDeduplicatedRequests(), 2);
+    EXPECT_EQ(manager.GetTotalPathsFound(), 1);
+}
+
+TEST_F(PathRequestTest, HighPriorityIsServedFirst) {
+    StartManager(0);
+    manager.SetMaxDispatchPerFrame(1);
+    
+    std::vector<PathRequestId> order;
+    auto callback = [&order](PathRequestId id, const PathfindingResult&) { order.push_back(id); };
+    
+    PathRequestId low = manager.RequestPath("grid", glm::vec3(0, 1, 0), glm::vec3(10, 1, 10), callback,
+                                            PathRequestPriority::Low);
+    PathRequestId high = manager.RequestPath("grid", glm::vec3(0, 1, 5), glm::vec3(10, 1, 20), callback,
+                                             PathRequestPriority::High);
+    
+    manager.Update();
+    ASSERT_EQ(order.size(), 1u);
+    EXPECT_EQ(order[0], high);
+    
+    manager.Update();
+    ASSERT_EQ(order.size(), 2u);
+    EXPECT_EQ(order[1], low);
+}
+
+TEST_F(PathRequestTest, CancelledRequestIsNotDelivered) {
+    StartManager(0);
+    
+    int callbacks = 0;
+    PathRequestId id = manager.RequestPath("grid", glm::vec3(0, 1, 0), glm::vec3(10, 1, 10),
+        [&callbacks](PathRequestId, const PathfindingResult&) { ++callbacks; });
+    
+    EXPECT_TRUE(manager.CancelRequest(id));
+    EXPECT_FALSE(manager.CancelRequest(id));
+    Drain();
+    
+    EXPECT_EQ(callbacks, 0);
+    EXPECT_EQ(manager.GetTotalPathsFound(), 0);
+}
+
+TEST_F(PathRequestTest, ComponentReceivesPathAndMoves) {
+    StartManager(1);
+    
+    PathfindingComponent component;
+    component.SetPathfindingManager(&manager);
+    component.SetNavMeshName("grid");
+    component.SetPosition(glm::vec3(0, 1, 0));
+    component.SetTargetPosition(glm::vec3(6, 1, 0));
+    component.SetSpeed(100.0f);
+    
+    bool completed = false;
+    component.SetOnPathComplete([&completed]() { completed = true; });
+    
+    component.StartPathfinding();
+    EXPECT_TRUE(component.IsPathPending());
+    Drain();
+    
+    EXPECT_FALSE(component.IsPathPending());
+    EXPECT_TRUE(component.HasPath());
+    
+    for (int i = 0; i < 100 && !completed; ++i) {
+        component.Update(0.1f);
+    }
+    EXPECT_TRUE(completed);
+    EXPECT_EQ(component.GetPosition(), glm::vec3(6, 1, 0));
+}
+
+TEST_F(PathRequestTest, EditPublishesNewVersion) {
+    StartManager(2);
+    std::shared_ptr<const NavMesh> before = manager.GetNavMesh("grid");
+    ASSERT_NE(before, nullptr);
+    
+    bool firstSuccess = false;
+    manager.RequestPath("grid", glm::vec3(0, 1, 0), glm::vec3(30, 1, 30),
+        [&firstSuccess](PathRequestId, const PathfindingResult& result) { firstSuccess = result.success; });
+    
+    // Стена поперек сетки: запрос, созданный до изменения, ее не видит
+    ASSERT_TRUE(manager.EditNavMesh("grid", [](NavMesh& navMesh) {
+        for (size_t i = 0; i < navMesh.GetNodeCount(); ++i) {
+            if (std::abs(navMesh.GetNodes()[i].position.x - 15.0f) < 0.5f) {
+                navMesh.SetNodeWalkable(static_cast<int>(i), false);
+            }
+        }
+    }));
+    EXPECT_FALSE(manager.EditNavMesh("missing", [](NavMesh&) {}));
+    
+    std::shared_ptr<const NavMesh> after = manager.GetNavMesh("grid");
+    EXPECT_NE(after, before);
+    EXPECT_EQ(after->GetNodeCount(), before->GetNodeCount());
+    for (const NavNode& node : before->GetNodes()) {
+        EXPECT_TRUE(node.walkable);
+    }
+    
+    bool secondSuccess = true;
+    manager.RequestPath("grid", glm::vec3(0, 1, 0), glm::vec3(30, 1, 30),
+        [&secondSuccess](PathRequestId, const PathfindingResult& result) { secondSuccess = result.success; });
+    Drain();
+    
+    EXPECT_TRUE(firstSuccess);
+    EXPECT_FALSE(secondSuccess);
+}
+
+TEST_F(PathRequestTest, EditsDoNotRaceWithWorkers) {
+    StartManager(2);
+    
+    int callbacks = 0;
+    auto callback = [&callbacks](PathRequestId, const PathfindingResult&) { ++callbacks; };
+    for (int i = 0; i < 40; ++i) {
+        manager.RequestPath("grid", glm::vec3(0, 1, i % 30), glm::vec3(30, 1, 30 - i % 30), callback);
+        manager.EditNavMesh("grid", [i](NavMesh& navMesh) {
+            navMesh.SetNodeWalkable(100 + i, i % 2 == 0);
+            navMesh.SetNodeCost(200 + i, 1.0f + i);
+        });
+        manager.Update();
+    }
+    Drain();
+    
+    EXPECT_EQ(callbacks, 40);
+}
+
+TEST_F(PathRequestTest, FrameBudgetLimitsWorkerDelivery) {
+    StartManager(2);
+    manager.SetFrameBudget(0.0f);
+    
+    int delivered = 0;
+    auto callback = [&delivered](PathRequestId, const PathfindingResult&) { ++delivered; };
+    for (int i = 0; i < 5; ++i) {
+        manager.RequestPath("grid", glm::vec3(0, 1, i * 5), glm::vec3(30, 1, 30), callback);
+    }
+    
+    // Нулевой бюджет: не больше одного результата за кадр, но без застревания
+    for (int i = 0; i < 1000 && manager.GetPendingRequestCount() > 0; ++i) {
+        int before = delivered;
+        manager.Update();
+        EXPECT_LE(delivered - before, 1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(delivered, 5);
+}
@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+#include "FastEngine/AI/NavMesh.h"
+#include "FastEngine/AI/Pathfinding.h"
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace FastEngine;
+
+class PathfindingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Поле 16x16 со стеной по x = 8, проход только у верхнего края
+        std::vector<std::vector<float>> heightmap(16, std::vector<float>(16, 1.0f));
+        for (int y = 0; y < 14; ++y) {
+            heightmap[y][8] = 0.0f;
+        }
+        
+        navMesh = std::make_unique<NavMesh>();
+        ASSERT_TRUE(navMesh->GenerateFromHeightmap(heightmap, 1.0f, 0.5f));
+        
+        pathfinder.SetSmoothing(false);
+        pathfinder.SetMaxIterations(100000);
+    }
+    
+    std::unique_ptr<NavMesh> navMesh;
+    AStarPathfinding pathfinder;
+};
+
+TEST_F(PathfindingTest, AdjacencyIsSymmetric) {
+    const int nodeCount = static_cast<int>(navMesh->GetNodeCount());
+    ASSERT_EQ(navMesh->GetAdjacencyOffsets().size(), navMesh->GetNodeCount() + 1);
+    
+    for (int i = 0; i < nodeCount; ++i) {
+        NavIndexRange neighbors = navMesh->GetNeighbors(i);
+        EXPECT_TRUE(std::is_sorted(neighbors.begin(), neighbors.end()));
+        
+        for (int neighbor : neighbors) {
+            NavIndexRange back = navMesh->GetNeighbors(neighbor);
+            EXPECT_NE(std::find(back.begin(), back.end(), i), back.end());
+        }
+    }
+}
+
+TEST_F(PathfindingTest, PathGoesAroundWall) {
+    PathfindingResult result = pathfinder.FindPath(*navMesh, glm::vec3(2.0f, 1.0f, 2.0f),
+                                                   glm::vec3(13.0f, 1.0f, 2.0f));
+    
+    ASSERT_TRUE(result.success);
+    ASSERT_GE(result.path.size(), 2u);
+    EXPECT_EQ(result.path.front(), glm::vec3(2.0f, 1.0f, 2.0f));
+    EXPECT_EQ(result.path.back(), glm::vec3(13.0f, 1.0f, 2.0f));
+    
+    // Путь обязан пройти через проход у верхнего края
+    bool crossedGap = false;
+    for (const auto& point : result.path) {
+        if (point.x == 8.0f) {
+            EXPECT_GE(point.z, 14.0f);
+            crossedGap = true;
+        }
+    }
+    EXPECT_TRUE(crossedGap);
+    EXPECT_GT(result.totalCost, 11.0f);
+}
+
+TEST_F(PathfindingTest, RepeatedQueriesReuseScratch) {
+    PathfindingResult first = pathfinder.FindPath(*navMesh, glm::vec3(0.0f, 1.0f, 0.0f),
+                                                  glm::vec3(15.0f, 1.0f, 15.0f));
+    PathfindingResult second = pathfinder.FindPath(*navMesh, glm::vec3(0.0f, 1.0f, 0.0f),
+                                                   glm::vec3(15.0f, 1.0f, 15.0f));
+    
+    ASSERT_TRUE(first.success);
+    ASSERT_TRUE(second.success);
+    EXPECT_EQ(first.path.size(), second.path.size());
+    EXPECT_FLOAT_EQ(first.totalCost, second.totalCost);
+    EXPECT_EQ(first.nodesExplored, second.nodesExplored);
+}
+
+TEST_F(PathfindingTest, CustomHeuristicMatchesDefault) {
+    // Нулевая эвристика превращает A* в Дейкстру: стоимость должна совпасть
+    auto dijkstra = [](const glm::vec3&, const glm::vec3&) { return 0.0f; };
+    
+    PathfindingResult astar = pathfinder.FindPath(*navMesh, glm::vec3(1.0f, 1.0f, 12.0f),
+                                                  glm::vec3(14.0f, 1.0f, 3.0f));
+    PathfindingResult reference = pathfinder.FindPath(*navMesh, glm::vec3(1.0f, 1.0f, 12.0f),
+                                                      glm::vec3(14.0f, 1.0f, 3.0f), dijkstra);
+    
+    ASSERT_TRUE(astar.success);
+    ASSERT_TRUE(reference.success);
+    EXPECT_NEAR(astar.totalCost, reference.totalCost, 1e-3f);
+    EXPECT_LE(astar.nodesExplored, reference.nodesExplored);
+}
+
+TEST_F(PathfindingTest, UnreachableGoalFails) {
+    // Полностью отделенный участок: стена по всей высоте
+    std::vector<std::vector<float>> heightmap(8, std::vector<float>(8, 1.0f));
+    for (int y = 0; y < 8; ++y) {
+        heightmap[y][4] = 0.0f;
+    }
+    NavMesh isolated;
+    ASSERT_TRUE(isolated.GenerateFromHeightmap(heightmap, 1.0f, 0.5f));
+    
+    PathfindingResult result = pathfinder.FindPath(isolated, glm::vec3(0.0f, 1.0f, 0.0f),
+                                                   glm::vec3(7.0f, 1.0f, 7.0f));
+    EXPECT_FALSE(result.success);
+    EXPECT_TRUE(result.path.empty());
+}
+
+TEST_F(PathfindingTest, NavMeshFindPathUsesAStar) {
+    std::vector<glm::vec3> path = navMesh->FindPath(glm::vec3(2.0f, 1.0f, 2.0f),
+                                                    glm::vec3(13.0f, 1.0f, 2.0f));
+    ASSERT_FALSE(path.empty());
+    EXPECT_EQ(path.front(), glm::vec3(2.0f, 1.0f, 2.0f));
+    EXPECT_EQ(path.back(), glm::vec3(13.0f, 1.0f, 2.0f));
+}
+
+TEST_F(PathfindingTest, PointQueriesUseGroundPlane) {
+    EXPECT_TRUE(navMesh->IsWalkable(glm::vec3(2.5f, 1.0f, 3.2f)));
+    EXPECT_FALSE(navMesh->IsWalkable(glm::vec3(8.0f, 1.0f, 5.5f)));   // Стена
+    EXPECT_FALSE(navMesh->IsWalkable(glm::vec3(-3.0f, 1.0f, 5.0f)));  // Вне сетки
+    
+    int triangle = navMesh->FindTriangle(glm::vec3(2.5f, 0.0f, 3.2f), false);
+    ASSERT_GE(triangle, 0);
+    EXPECT_TRUE(navMesh->GetTriangles()[triangle].walkable);
+    
+    // Нечисловые координаты не попадают ни в одну ячейку
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+    EXPECT_FALSE(navMesh->IsWalkable(glm::vec3(nan, 0.0f, 3.2f)));
+    EXPECT_EQ(navMesh->FindTriangle(glm::vec3(2.5f, 0.0f, nan), false), -1);
+    EXPECT_EQ(navMesh->FindNearestNode(glm::vec3(-inf, 0.0f, 3.2f)), -1);
+    EXPECT_EQ(navMesh->FindNearestNode(glm::vec3(2.5f, nan, 3.2f)), -1);
+}
+
+TEST_F(PathfindingTest, NearestNodeMatchesBruteForce) {
+    const auto& nodes = navMesh->GetNodes();
+    const glm::vec3 probes[] = {
+        glm::vec3(8.2f, 0.0f, 4.0f), glm::vec3(-10.0f, 5.0f, -10.0f),
+        glm::vec3(40.0f, 0.0f, 7.0f), glm::vec3(7.9f, 1.0f, 13.1f)
+    };
+    
+    for (const auto& probe : probes) {
+        float best = std::numeric_limits<float>::max();
+        for (const auto& node : nodes) {
+            if (node.walkable) {
+                best = std::min(best, glm::distance(probe, node.position));
+            }
+        }
+        
+        int found = navMesh->FindNearestNode(probe);
+        ASSERT_GE(found, 0);
+        EXPECT_TRUE(nodes[found].walkable);
+        EXPECT_FLOAT_EQ(glm::distance(probe, nodes[found].position), best);
+    }
+}
+
+TEST_F(PathfindingTest, RaycastStopsAtWall) {
+    glm::vec3 hit;
+    EXPECT_TRUE(navMesh->Raycast(glm::vec3(2.0f, 1.0f, 5.5f), glm::vec3(12.0f, 1.0f, 5.5f), &hit));
+    EXPECT_GT(hit.x, 2.0f);
+    EXPECT_LE(hit.x, 8.0f);
+    
+    EXPECT_FALSE(navMesh->Raycast(glm::vec3(1.0f, 1.0f, 1.0f), glm::vec3(6.0f, 1.0f, 12.0f)));
+    EXPECT_FALSE(navMesh->Raycast(glm::vec3(0.0f, 1.0f, 15.0f), glm::vec3(15.0f, 1.0f, 15.0f)));
+    EXPECT_TRUE(navMesh->Raycast(glm::vec3(1.0f, 1.0f, 1.0f), glm::vec3(30.0f, 1.0f, 1.0f)));
+}
+
+TEST_F(PathfindingTest, RaycastAgreesWithSampling) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> coord(0.0f, 15.0f);
+    
+    for (int i = 0; i < 500; ++i) {
+        glm::vec3 from(coord(rng), 1.0f, coord(rng));
+        glm::vec3 to(coord(rng), 1.0f, coord(rng));
+        if (!navMesh->IsWalkable(from)) continue;
+        
+        bool sampledClear = true;
+        for (int k = 0; k <= 200 && sampledClear; ++k) {
+            sampledClear = navMesh->IsWalkable(from + (to - from) * (k / 200.0f));
+        }
+        
+        EXPECT_EQ(navMesh->Raycast(from, to), !sampledClear) << "segment " << i;
+    }
+}
+
+TEST_F(PathfindingTest, SmoothedPathStaysWalkable) {
+    AStarPathfinding smoothing;
+    smoothing.SetMaxIterations(100000);
+    
+    PathfindingResult raw = pathfinder.FindPath(*navMesh, glm::vec3(2.0f, 1.0f, 2.0f), glm::vec3(13.0f, 1.0f, 2.0f));
+    PathfindingResult smooth = smoothing.FindPath(*navMesh, glm::vec3(2.0f, 1.0f, 2.0f), glm::vec3(13.0f, 1.0f, 2.0f));
+    
+    ASSERT_TRUE(smooth.success);
+    EXPECT_LT(smooth.path.size(), raw.path.size());
+    for (size_t i = 0; i + 1 < smooth.path.size(); ++i) {
+        EXPECT_FALSE(navMesh->Raycast(smooth.path[i], smooth.path[i + 1])) << "segment " << i;
+    }
+}
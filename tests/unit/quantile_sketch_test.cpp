@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include "FastEngine/Profiling/PerformanceProfiler.h"
+#include "FastEngine/Profiling/QuantileSketch.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace FastEngine;
+
+namespace {
+
+double Exact(std::vector<double> values, double q) {
+    std::sort(values.begin(), values.end());
+    size_t rank = static_cast<size_t>(std::ceil(q * values.size()));
+    return values[std::min(std::max<size_t>(rank, 1), values.size()) - 1];
+}
+
+std::vector<double> FrameTimes(size_t count, unsigned seed) {
+    // Логнормальное распределение с редкими пиками - как время кадра
+    std::mt19937 random(seed);
+    std::lognormal_distribution<double> normal(std::log(8.0), 0.25);
+    std::uniform_real_distribution<double> spike(0.0, 1.0);
+    std::vector<double> values(count);
+    for (double& value : values) {
+        value = normal(random) * (spike(random) < 0.02 ? 4.0 : 1.0);
+    }
+    return values;
+}
+
+} // namespace
+
+TEST(QuantileSketchTest, MatchesExactPercentilesWithinRelativeError) {
+    std::vector<double> values = FrameTimes(100000, 7);
+    QuantileSketch sketch;
+    for (double value : values) {
+        sketch.Add(value);
+    }
+
+    EXPECT_EQ(sketch.GetCount(), values.size());
+    EXPECT_EQ(sketch.GetMin(), *std::min_element(values.begin(), values.end()));
+    EXPECT_EQ(sketch.GetMax(), *std::max_element(values.begin(), values.end()));
+    for (double q : {0.01, 0.25, 0.5, 0.9, 0.95, 0.99, 0.999}) {
+        double exact = Exact(values, q);
+        EXPECT_NEAR(sketch.GetQuantile(q), exact, exact / 64.0 + 1e-12) << "q = " << q;
+    }
+    EXPECT_EQ(sketch.GetQuantile(0.0), sketch.GetMin());
+    EXPECT_EQ(sketch.GetQuantile(1.0), sketch.GetMax());
+}
+
+TEST(QuantileSketchTest, CoversWideRangeOfUnits) {
+    // Байты и наносекунды одной гистограммой
+    QuantileSketch bytes;
+    QuantileSketch seconds;
+    for (int i = 0; i < 1000; ++i) {
+        bytes.Add(64.0 * (1 << (i % 20)));
+        seconds.Add(1e-5 * (i + 1));
+    }
+    EXPECT_NEAR(bytes.GetQuantile(0.5), 64.0 * (1 << 9), 64.0 * (1 << 9) / 64.0);
+    EXPECT_NEAR(seconds.GetQuantile(0.5), 5e-3, 5e-3 / 64.0);
+
+    // Вне диапазона - крайние корзины, ответ ограничен точными min и max
+    QuantileSketch extremes;
+    extremes.Add(0.0);
+    extremes.Add(-3.0);
+    extremes.Add(1e30);
+    EXPECT_EQ(extremes.GetMin(), 0.0);
+    EXPECT_EQ(extremes.GetQuantile(0.1), 0.0);
+    EXPECT_EQ(extremes.GetQuantile(0.99), 1e30);
+    EXPECT_EQ(QuantileSketch::GetBucket(1e30), QuantileSketch::BUCKETS - 1);
+
+    QuantileSketch empty;
+    EXPECT_EQ(empty.GetQuantile(0.5), 0.0);
+    QuantileSketch single;
+    single.Add(12.5);
+    EXPECT_EQ(single.GetQuantile(0.5), 12.5);
+    EXPECT_EQ(single.GetQuantile(0.99), 12.5);
+}
+
+TEST(QuantileSketchTest, MergeOfThreadSketchesEqualsSingleSketch) {
+    const int threadCount = 4;
+    std::vector<std::vector<double>> parts;
+    for (int t = 0; t < threadCount; ++t) {
+        parts.push_back(FrameTimes(20000, 100 + t));
+    }
+
+    std::vector<QuantileSketch> local(threadCount);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&local, &parts, t]() {
+            for (double value : parts[t]) {
+                local[t].Add(value);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    QuantileSketch merged;
+    QuantileSketch single;
+    for (int t = 0; t < threadCount; ++t) {
+        merged.Merge(local[t]);
+        for (double value : parts[t]) {
+            single.Add(value);
+        }
+    }
+    EXPECT_EQ(merged.GetCount(), single.GetCount());
+    EXPECT_EQ(merged.GetMin(), single.GetMin());
+    EXPECT_EQ(merged.GetMax(), single.GetMax());
+    for (double q : {0.5, 0.95, 0.99}) {
+        EXPECT_EQ(merged.GetQuantile(q), single.GetQuantile(q));
+    }
+}
+
+TEST(QuantileSketchTest, PerformanceStatsKeepsPercentilesUpdated) {
+    std::vector<double> values = FrameTimes(5000, 11);
+    PerformanceStats first;
+    PerformanceStats second;
+    PerformanceStats all;
+    for (size_t i = 0; i < values.size(); ++i) {
+        (i % 2 ? first : second).Update(values[i]);
+        all.Update(values[i]);
+    }
+
+    EXPECT_NEAR(all.median, Exact(values, 0.5), Exact(values, 0.5) / 64.0);
+    EXPECT_NEAR(all.p95, Exact(values, 0.95), Exact(values, 0.95) / 64.0);
+    EXPECT_NEAR(all.p99, Exact(values, 0.99), Exact(values, 0.99) / 64.0);
+    EXPECT_EQ(all.GetPercentile(0.99), all.p99);
+    EXPECT_LE(all.min, all.median);
+    EXPECT_LE(all.p99, all.max);
+
+    first.Merge(second);
+    EXPECT_EQ(first.sampleCount, all.sampleCount);
+    EXPECT_EQ(first.min, all.min);
+    EXPECT_EQ(first.max, all.max);
+    EXPECT_NEAR(first.average, all.average, 1e-9);
+    EXPECT_EQ(first.median, all.median);
+    EXPECT_EQ(first.p99, all.p99);
+}
+
+TEST(QuantileSketchTest, GPUProfilerStatsAreMaintainedOnRecord) {
+    GPUProfiler gpu;
+    gpu.StartProfiling();
+    for (int i = 0; i < 20; ++i) {
+        gpu.BeginQuery("gpu.pass");
+        gpu.EndQuery("gpu.pass");
+    }
+    PerformanceStats stats = gpu.GetStats("gpu.pass");
+    EXPECT_EQ(stats.sampleCount, 20u);
+    EXPECT_EQ(stats.sketch.GetCount(), 20u);
+    EXPECT_LE(stats.min, stats.median);
+    EXPECT_LE(stats.p99, stats.max);
+    EXPECT_EQ(gpu.GetStats("gpu.missing").sampleCount, 0u);
+
+    gpu.Reset();
+    EXPECT_EQ(gpu.GetStats("gpu.pass").sampleCount, 0u);
+    gpu.StopProfiling();
+}
@@ -0,0 +1,251 @@
+#include <gtest/gtest.h>
+#include "FastEngine/Profiling/PerformanceProfiler.h"
+#include "FastEngine/Profiling/ScopeProfiler.h"
+#include <atomic>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace FastEngine;
+
+namespace {
+
+class ScopeProfilerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ScopeProfiler::GetInstance().Start();
+        ScopeProfiler::GetInstance().ResetStats();
+    }
+
+    void TearDown() override {
+        ScopeProfiler::GetInstance().Stop();
+    }
+
+    static const ProfileNode* FindNode(const ProfileFrame& frame, uint32_t parent, const std::string& name) {
+        for (const ProfileNode& node : frame.nodes) {
+            if (node.parent == parent && ProfileNames::Get(node.name) == name) {
+                return &node;
+            }
+        }
+        return nullptr;
+    }
+
+    static void Work(int iterations) {
+        volatile double sink = 0.0;
+        for (int i = 0; i < iterations; ++i) {
+            sink = sink + i * 0.5;
+        }
+    }
+};
+
+} // namespace
+
+TEST(ProfileNamesTest, RegisterIsStable) {
+    ProfileNameId a = ProfileNames::Register("names.a");
+    ProfileNameId b = ProfileNames::Register("names.b");
+    EXPECT_NE(a, 0u);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(ProfileNames::Register("names.a"), a);
+    EXPECT_EQ(ProfileNames::Find("names.b"), b);
+    EXPECT_EQ(ProfileNames::Find("names.missing"), 0u);
+    EXPECT_EQ(ProfileNames::Get(a), "names.a");
+    EXPECT_EQ(ProfileNames::Get(0), "");
+}
+
+TEST_F(ScopeProfilerTest, BuildsFrameCallTree) {
+    ScopeProfiler& profiler = ScopeProfiler::GetInstance();
+    ScopeProfiler::MarkFrame();
+    {
+        FASTENGINE_PROFILE_SCOPE("tree.update");
+        for (int i = 0; i < 2; ++i) {
+            FASTENGINE_PROFILE_SCOPE("tree.physics");
+            Work(1000);
+        }
+        Work(1000);
+    }
+    {
+        FASTENGINE_PROFILE_SCOPE("tree.render");
+        Work(500);
+    }
+    ScopeProfiler::MarkFrame();
+    ScopeProfiler::MarkFrame();
+    profiler.Flush();
+
+    ProfileFrame frame;
+    ASSERT_TRUE(profiler.GetLastFrame(frame));
+    EXPECT_GT(frame.durationMs, 0.0);
+
+    const ProfileNode* update = FindNode(frame, ProfileNode::NO_NODE, "tree.update");
+    const ProfileNode* render = FindNode(frame, ProfileNode::NO_NODE, "tree.render");
+    ASSERT_NE(update, nullptr);
+    ASSERT_NE(render, nullptr);
+    EXPECT_EQ(update->calls, 1u);
+    EXPECT_EQ(update->depth, 0u);
+
+    const ProfileNode* physics = FindNode(frame, static_cast<uint32_t>(update - frame.nodes.data()), "tree.physics");
+    ASSERT_NE(physics, nullptr);
+    EXPECT_EQ(physics->calls, 2u);
+    EXPECT_EQ(physics->depth, 1u);
+    EXPECT_EQ(update->firstChild, static_cast<uint32_t>(physics - frame.nodes.data()));
+    EXPECT_LE(physics->totalMs, update->totalMs);
+    EXPECT_NEAR(update->selfMs, update->totalMs - physics->totalMs, 1e-9);
+    EXPECT_GE(update->selfMs, 0.0);
+    EXPECT_LE(update->totalMs + render->totalMs, frame.durationMs);
+
+    EXPECT_EQ(profiler.GetStats(ProfileNames::Find("tree.physics")).calls, 2u);
+}
+
+TEST_F(ScopeProfilerTest, CollectsStatsAcrossThreads) {
+    ScopeProfiler& profiler = ScopeProfiler::GetInstance();
+    const ProfileNameId outer = ProfileNames::Register("threads.outer");
+    const ProfileNameId inner = ProfileNames::Register("threads.inner");
+    const int threadCount = 4;
+    const int scopes = 500;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([=]() {
+            ScopeProfiler::SetThreadName("Worker " + std::to_string(t));
+            for (int i = 0; i < scopes; ++i) {
+                ScopeProfiler::Scope scope(outer);
+                ScopeProfiler::Scope nested(inner);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    profiler.Flush();
+
+    EXPECT_EQ(profiler.GetStats(outer).calls, static_cast<uint64_t>(threadCount * scopes));
+    EXPECT_EQ(profiler.GetStats(inner).calls, static_cast<uint64_t>(threadCount * scopes));
+    EXPECT_LE(profiler.GetStats(inner).maxMs, profiler.GetStats(outer).maxMs + 1e-3);
+
+    bool named = false;
+    for (uint32_t i = 0; i < profiler.GetThreadCount(); ++i) {
+        named = named || profiler.GetThreadName(i) == "Worker 3";
+    }
+    EXPECT_TRUE(named);
+}
+
+TEST_F(ScopeProfilerTest, RecoversNestingAfterOverflow) {
+    ScopeProfiler& profiler = ScopeProfiler::GetInstance();
+    const ProfileNameId flat = ProfileNames::Register("overflow.flat");
+    const ProfileNameId outer = ProfileNames::Register("overflow.outer");
+    const ProfileNameId inner = ProfileNames::Register("overflow.inner");
+
+    // Агрегатор засыпает надолго, у нового потока буфер на 8 событий
+    profiler.SetAggregationInterval(std::chrono::milliseconds(10000));
+    profiler.Flush();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const size_t capacity = profiler.GetThreadCapacity();
+    profiler.SetThreadCapacity(8);
+    const uint64_t droppedBefore = profiler.GetDroppedEvents();
+
+    std::promise<void> filled;
+    std::promise<void> flushed;
+    std::thread thread([&]() {
+        for (int i = 0; i < 50; ++i) {
+            ScopeProfiler::Scope scope(flat);
+        }
+        // Незакрытая область, чей END потерян, и закрытая после разбора
+        ScopeProfiler::Begin(outer);
+        filled.set_value();
+        flushed.get_future().wait();
+        ScopeProfiler::End();
+        ScopeProfiler::Scope scope(outer);
+        ScopeProfiler::Scope nested(inner);
+    });
+    filled.get_future().wait();
+    EXPECT_GE(profiler.GetDroppedEvents() - droppedBefore, 90u);
+    profiler.Flush();
+    flushed.set_value();
+    thread.join();
+    profiler.Flush();
+
+    EXPECT_EQ(profiler.GetStats(flat).calls, 4u);
+    EXPECT_EQ(profiler.GetStats(outer).calls, 1u);
+    EXPECT_EQ(profiler.GetStats(inner).calls, 1u);
+
+    profiler.SetThreadCapacity(capacity);
+    profiler.SetAggregationInterval(std::chrono::milliseconds(2));
+}
+
+TEST_F(ScopeProfilerTest, ListenersAndPercentiles) {
+    ScopeProfiler& profiler = ScopeProfiler::GetInstance();
+    const ProfileNameId name = ProfileNames::Register("listener.scope");
+    std::atomic<int> seen(0);
+    uint32_t listener = profiler.AddListener([&seen, name](const CompletedScope& scope) {
+        if (scope.name == name) {
+            EXPECT_GE(scope.endTicks, scope.startTicks);
+            seen++;
+        }
+    });
+
+    for (int i = 0; i < 200; ++i) {
+        ScopeProfiler::Scope scope(name);
+        Work(50 * (i % 10 + 1));
+    }
+    profiler.Flush();
+    EXPECT_EQ(seen.load(), 200);
+
+    ScopeStats stats = profiler.GetStats(name);
+    EXPECT_EQ(stats.calls, 200u);
+    EXPECT_LE(stats.minMs, stats.p50Ms);
+    EXPECT_LE(stats.p50Ms, stats.p95Ms);
+    EXPECT_LE(stats.p95Ms, stats.p99Ms);
+    EXPECT_LE(stats.p99Ms, stats.maxMs);
+    EXPECT_NEAR(stats.GetAverageMs() * 200.0, stats.totalMs, 1e-9);
+
+    profiler.RemoveListener(listener);
+    {
+        ScopeProfiler::Scope scope(name);
+    }
+    profiler.Flush();
+    EXPECT_EQ(seen.load(), 200);
+    EXPECT_EQ(profiler.GetStats(name).calls, 201u);
+}
+
+TEST(CPUProfilerTest, SamplesFeedMetricsAndStats) {
+    CPUProfiler cpu;
+    cpu.BeginSample("cpu.sample"); // До StartProfiling не пишется
+    cpu.EndSample("cpu.sample");
+
+    cpu.StartProfiling();
+    cpu.Reset();
+    for (int i = 0; i < 10; ++i) {
+        cpu.BeginSample("cpu.sample");
+        cpu.EndSample("cpu.sample");
+    }
+    const ProfileNameId id = ProfileNames::Register("cpu.sample");
+    for (int i = 0; i < 5; ++i) {
+        cpu.BeginSample(id);
+        cpu.EndSample();
+    }
+    ScopeProfiler::GetInstance().Flush();
+
+    PerformanceStats stats = cpu.GetStats("cpu.sample");
+    EXPECT_EQ(stats.sampleCount, 15u);
+    EXPECT_LE(stats.min, stats.median);
+    EXPECT_LE(stats.p99, stats.max);
+    EXPECT_EQ(cpu.GetStats("cpu.unknown").sampleCount, 0u);
+
+    size_t named = 0;
+    for (const auto& metric : cpu.GetMetrics()) {
+        named += metric.name == "cpu.sample" ? 1 : 0;
+    }
+    EXPECT_EQ(named, 15u);
+
+    // Кольцо метрик: остаются последние, в хронологическом порядке
+    cpu.SetMaxSamples(4);
+    cpu.BeginSample("cpu.last");
+    cpu.EndSample("cpu.last");
+    ScopeProfiler::GetInstance().Flush();
+    std::vector<PerformanceMetric> metrics = cpu.GetMetrics();
+    ASSERT_EQ(metrics.size(), 4u);
+    EXPECT_EQ(metrics.back().name, "cpu.last");
+    EXPECT_EQ(metrics.front().name, "cpu.sample");
+
+    cpu.StopProfiling();
+}
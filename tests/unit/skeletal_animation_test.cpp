@@ -0,0 +1,375 @@
+#include <gtest/gtest.h>
+#include "FastEngine/Animation/BlendTree.h"
+#include "FastEngine/Animation/SkeletalClip.h"
+#include "FastEngine/Animation/Skeleton.h"
+#include "FastEngine/Components/SkeletalAnimator.h"
+#include "FastEngine/Entity.h"
+#include "FastEngine/Jobs/JobSystem.h"
+#include "FastEngine/Systems/SkeletalAnimationSystem.h"
+#include "FastEngine/World.h"
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace FastEngine;
+
+namespace {
+
+glm::vec4 AxisAngle(glm::vec3 axis, float angle) {
+    axis = glm::normalize(axis);
+    float s = std::sin(angle * 0.5f);
+    return glm::vec4(axis.x * s, axis.y * s, axis.z * s, std::cos(angle * 0.5f));
+}
+
+// Скалярная эталонная реализация: v' = v + 2w(q x v) + 2q x (q x v)
+glm::vec3 RotateReference(const glm::vec4& q, const glm::vec3& v) {
+    glm::vec3 u(q.x, q.y, q.z);
+    glm::vec3 t = 2.0f * glm::cross(u, v);
+    return v + q.w * t + glm::cross(u, t);
+}
+
+glm::vec3 ApplyReference(const BoneTransform& transform, const glm::vec3& point) {
+    return transform.translation + RotateReference(transform.rotation, point * transform.scale);
+}
+
+float QuaternionAngle(const glm::vec4& a, const glm::vec4& b) {
+    float dot = std::fabs(glm::dot(a, b));
+    return 2.0f * std::acos(std::min(dot, 1.0f));
+}
+
+std::shared_ptr<Skeleton> MakeChain(uint32_t bones) {
+    auto skeleton = std::make_shared<Skeleton>();
+    for (uint32_t i = 0; i < bones; ++i) {
+        BoneTransform bind(glm::vec3(0.0f, i == 0 ? 0.0f : 1.0f, 0.0f), AxisAngle(glm::vec3(0, 0, 1), 0.1f * i));
+        skeleton->AddBone("bone" + std::to_string(i), static_cast<int>(i) - 1, bind);
+    }
+    return skeleton;
+}
+
+// Клип с постоянной позой: все кости повернуты на angle вокруг Z и сдвинуты на offset
+std::shared_ptr<const SkeletalClip> MakeStaticClip(const std::string& name, uint32_t bones, float angle,
+                                                   const glm::vec3& offset) {
+    RawSkeletalClip raw;
+    raw.name = name;
+    raw.boneCount = bones;
+    for (int frame = 0; frame < 10; ++frame) {
+        for (uint32_t bone = 0; bone < bones; ++bone) {
+            raw.frames.push_back(BoneTransform(offset, AxisAngle(glm::vec3(0, 0, 1), angle)));
+        }
+    }
+    return SkeletalClip::Compress(raw);
+}
+
+// Кость 0 неподвижна, кость 1 вращается, кость 2 качается по синусу
+RawSkeletalClip MakeMovingClip(uint32_t frames) {
+    RawSkeletalClip raw;
+    raw.name = "moving";
+    raw.boneCount = 3;
+    for (uint32_t f = 0; f < frames; ++f) {
+        float t = static_cast<float>(f) / raw.sampleRate;
+        raw.frames.push_back(BoneTransform(glm::vec3(1.0f, 2.0f, 3.0f), glm::vec4(0, 0, 0, 1)));
+        raw.frames.push_back(BoneTransform(glm::vec3(0.0f, 1.0f, 0.0f), AxisAngle(glm::vec3(0.3f, 1.0f, 0.2f), 3.0f * t)));
+        raw.frames.push_back(BoneTransform(glm::vec3(std::sin(4.0f * t), 0.5f, 0.0f),
+                                           AxisAngle(glm::vec3(1, 0, 0), 0.5f * std::sin(2.0f * t)),
+                                           glm::vec3(1.0f + 0.25f * t)));
+    }
+    return raw;
+}
+
+} // namespace
+
+TEST(SkeletalClipTest, CompressionStaysWithinTolerance) {
+    RawSkeletalClip raw = MakeMovingClip(61);
+    SkeletalCompressionSettings settings;
+    auto clip = SkeletalClip::Compress(raw, settings);
+    ASSERT_NE(clip, nullptr);
+    EXPECT_EQ(clip->GetFrameCount(), 61u);
+    EXPECT_FLOAT_EQ(clip->GetDuration(), 2.0f);
+
+    // Неподвижная кость - по ключу на дорожку, остальные сокращены
+    EXPECT_LT(clip->GetKeyCount(), static_cast<size_t>(61 * 3 * 3) / 2);
+    EXPECT_LT(clip->GetCompressedSize() * 4, clip->GetRawSize());
+
+    SkeletalSampleContext context;
+    Pose pose;
+    for (uint32_t frame = 0; frame < 61; ++frame) {
+        clip->Sample(frame / raw.sampleRate, context, pose);
+        ASSERT_EQ(pose.GetBoneCount(), 3u);
+        for (uint32_t bone = 0; bone < 3; ++bone) {
+            const BoneTransform& expected = raw.frames[frame * 3 + bone];
+            BoneTransform actual = pose.GetBone(bone);
+            // Допуск сокращения плюс шаг квантования
+            EXPECT_LT(glm::length(actual.translation - expected.translation), 3.0f * settings.translationTolerance);
+            EXPECT_LT(glm::length(actual.scale - expected.scale), 3.0f * settings.scaleTolerance);
+            EXPECT_LT(QuaternionAngle(actual.rotation, expected.rotation), 3.0f * settings.rotationTolerance);
+        }
+    }
+
+    // Время за пределами клипа зажимается
+    clip->Sample(100.0f, context, pose);
+    EXPECT_NEAR(pose.GetBone(2).scale.x, raw.frames[60 * 3 + 2].scale.x, 0.01f);
+}
+
+TEST(SkeletalClipTest, RejectsInvalidInput) {
+    RawSkeletalClip raw;
+    raw.boneCount = 2;
+    EXPECT_EQ(SkeletalClip::Compress(raw), nullptr);
+    raw.frames.resize(3);
+    EXPECT_EQ(SkeletalClip::Compress(raw), nullptr);
+}
+
+TEST(SkeletonPoseTest, BlendMatchesScalarReference) {
+    // Шесть костей: полная группа SIMD и неполный хвост
+    const uint32_t bones = 6;
+    Pose a(bones);
+    Pose b(bones);
+    std::vector<BoneTransform> ta;
+    std::vector<BoneTransform> tb;
+    for (uint32_t i = 0; i < bones; ++i) {
+        ta.push_back(BoneTransform(glm::vec3(i, 0.0f, -1.0f), AxisAngle(glm::vec3(1, i, 0), 0.2f * i + 0.1f),
+                                   glm::vec3(1.0f)));
+        glm::vec4 rotation = AxisAngle(glm::vec3(0, 1, i), 1.5f - 0.1f * i);
+        // Тот же поворот в другой полусфере - смешивание идет по короткой дуге
+        if (i % 2) {
+            rotation = -rotation;
+        }
+        tb.push_back(BoneTransform(glm::vec3(0.0f, i, 1.0f), rotation, glm::vec3(2.0f)));
+        a.SetBone(i, ta[i]);
+        b.SetBone(i, tb[i]);
+    }
+
+    const float weight = 0.3f;
+    Pose out;
+    BlendPoses(a, b, weight, out);
+    ASSERT_EQ(out.GetBoneCount(), bones);
+    for (uint32_t i = 0; i < bones; ++i) {
+        BoneTransform actual = out.GetBone(i);
+        glm::vec4 target = glm::dot(ta[i].rotation, tb[i].rotation) < 0.0f ? -tb[i].rotation : tb[i].rotation;
+        glm::vec4 rotation = glm::normalize(ta[i].rotation + (target - ta[i].rotation) * weight);
+        glm::vec3 translation = ta[i].translation + (tb[i].translation - ta[i].translation) * weight;
+        EXPECT_LT(glm::length(actual.translation - translation), 1e-5f);
+        EXPECT_LT(glm::length(actual.rotation - rotation), 1e-4f);
+        EXPECT_NEAR(actual.scale.y, 1.3f, 1e-5f);
+    }
+
+    // Смешивание на месте и вес на кость
+    std::vector<float> zero(out.GetStride(), 0.0f);
+    std::vector<float> one(out.GetStride(), 1.0f);
+    BlendPoses(a, b, zero.data(), zero.data(), one.data(), a);
+    EXPECT_LT(glm::length(a.GetBone(3).translation - ta[3].translation), 1e-6f);
+    EXPECT_NEAR(a.GetBone(3).scale.z, 2.0f, 1e-6f);
+}
+
+TEST(SkeletonPoseTest, LocalToModelMatchesScalarReference) {
+    const uint32_t bones = 7;
+    Skeleton skeleton;
+    Pose pose(bones);
+    std::vector<BoneTransform> locals;
+    for (uint32_t i = 0; i < bones; ++i) {
+        BoneTransform local(glm::vec3(0.5f * i, 1.0f, -0.25f * i),
+                            AxisAngle(glm::vec3(i % 3 == 0, 1.0f, i % 2), 0.3f * i + 0.2f),
+                            glm::vec3(1.0f + 0.1f * i));
+        // Ветвление: кость 4 - потомок корня
+        int parent = i == 0 ? Skeleton::NO_PARENT : (i == 4 ? 0 : static_cast<int>(i) - 1);
+        ASSERT_EQ(skeleton.AddBone("b" + std::to_string(i), parent, local), static_cast<int>(i));
+        locals.push_back(local);
+        pose.SetBone(i, local);
+    }
+    EXPECT_EQ(skeleton.AddBone("orphan", 42, BoneTransform()), -1);
+    EXPECT_EQ(skeleton.FindBone("b4"), 4);
+
+    std::vector<BoneMatrix> model(bones);
+    LocalToModel(skeleton, pose, model.data());
+
+    const glm::vec3 point(0.3f, -0.7f, 1.1f);
+    for (uint32_t i = 0; i < bones; ++i) {
+        glm::vec3 expected = point;
+        for (int bone = static_cast<int>(i); bone != Skeleton::NO_PARENT; bone = skeleton.GetParent(bone)) {
+            expected = ApplyReference(locals[bone], expected);
+        }
+        EXPECT_LT(glm::length(model[i].TransformPoint(point) - expected), 1e-3f) << "bone " << i;
+    }
+}
+
+TEST(SkeletonPoseTest, BindPoseSkinningIsIdentity) {
+    auto skeleton = MakeChain(5);
+    Pose pose;
+    pose.SetBind(*skeleton);
+    std::vector<BoneMatrix> model(5);
+    std::vector<BoneMatrix> skinning(5);
+    LocalToModel(*skeleton, pose, model.data());
+    ComputeSkinningMatrices(*skeleton, model.data(), skinning.data());
+
+    BoneMatrix identity = BoneMatrix::Identity();
+    for (const BoneMatrix& matrix : skinning) {
+        for (int k = 0; k < 16; ++k) {
+            EXPECT_NEAR(matrix.m[k], identity.m[k], 1e-5f);
+        }
+    }
+
+    SkinnedMeshData mesh;
+    for (int v = 0; v < 9; ++v) {
+        mesh.positions.push_back(glm::vec3(v, 0.5f * v, -v));
+        mesh.normals.push_back(glm::vec3(0, 1, 0));
+        uint16_t indices[4] = {static_cast<uint16_t>(v % 5), static_cast<uint16_t>((v + 1) % 5), 0, 0};
+        float weights[4] = {0.75f, 0.25f, 0.0f, 0.0f};
+        mesh.boneIndices.insert(mesh.boneIndices.end(), indices, indices + 4);
+        mesh.boneWeights.insert(mesh.boneWeights.end(), weights, weights + 4);
+    }
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> normals;
+    SkinVertices(mesh, skinning.data(), positions, normals);
+    ASSERT_EQ(positions.size(), mesh.positions.size());
+    ASSERT_EQ(normals.size(), mesh.normals.size());
+    for (size_t v = 0; v < positions.size(); ++v) {
+        EXPECT_LT(glm::length(positions[v] - mesh.positions[v]), 1e-4f);
+        EXPECT_LT(glm::length(normals[v] - mesh.normals[v]), 1e-4f);
+    }
+}
+
+TEST(BlendTreeTest, BlendAndBlend1DWeights) {
+    auto idle = MakeStaticClip("idle", 3, 0.0f, glm::vec3(0.0f));
+    auto walk = MakeStaticClip("walk", 3, 1.0f, glm::vec3(2.0f, 0.0f, 0.0f));
+    auto run = MakeStaticClip("run", 3, 1.0f, glm::vec3(6.0f, 0.0f, 0.0f));
+    ASSERT_TRUE(idle && walk && run);
+
+    BlendTree tree;
+    uint32_t speed = tree.AddParameter("speed");
+    uint32_t idleNode = tree.AddClip(idle);
+    uint32_t walkNode = tree.AddClip(walk);
+    uint32_t runNode = tree.AddClip(run);
+    EXPECT_EQ(tree.AddClip(MakeStaticClip("other", 4, 0.0f, glm::vec3(0.0f))), BlendTree::INVALID_NODE);
+    uint32_t root = tree.AddBlend1D(speed, {{0.0f, idleNode}, {1.0f, walkNode}, {3.0f, runNode}});
+    ASSERT_NE(root, BlendTree::INVALID_NODE);
+    EXPECT_EQ(tree.GetRoot(), root);
+
+    BlendTreeContext context;
+    Pose pose;
+    float value = -1.0f;
+    tree.Evaluate(0.0f, &value, context, pose);
+    EXPECT_NEAR(pose.GetBone(1).translation.x, 0.0f, 1e-3f);
+    value = 0.5f;
+    tree.Evaluate(0.0f, &value, context, pose);
+    EXPECT_NEAR(pose.GetBone(1).translation.x, 1.0f, 1e-3f);
+    value = 2.0f;
+    tree.Evaluate(0.0f, &value, context, pose);
+    EXPECT_NEAR(pose.GetBone(1).translation.x, 4.0f, 1e-3f);
+    EXPECT_LT(QuaternionAngle(pose.GetBone(1).rotation, AxisAngle(glm::vec3(0, 0, 1), 1.0f)), 1e-3f);
+    value = 10.0f;
+    tree.Evaluate(0.0f, &value, context, pose);
+    EXPECT_NEAR(pose.GetBone(1).translation.x, 6.0f, 1e-3f);
+
+    // Вложенное смешивание: (idle -> walk) -> run
+    uint32_t mix = tree.AddParameter("mix", 0.5f);
+    uint32_t inner = tree.AddBlend(idleNode, walkNode, speed);
+    tree.AddBlend(inner, runNode, mix);
+    float values[2] = {0.5f, 0.5f};
+    tree.Evaluate(0.0f, values, context, pose);
+    EXPECT_NEAR(pose.GetBone(0).translation.x, 3.5f, 1e-3f);
+    EXPECT_EQ(tree.AddBlend(0, 42, speed), BlendTree::INVALID_NODE);
+}
+
+TEST(SkeletalAnimatorTest, ComponentUpdateAndParameters) {
+    auto skeleton = MakeChain(3);
+    auto clip = SkeletalClip::Compress(MakeMovingClip(31));
+    ASSERT_NE(clip, nullptr);
+
+    SkeletalAnimator animator(skeleton);
+    EXPECT_FALSE(animator.CanEvaluate());
+    EXPECT_FALSE(animator.SetBlendTree(BlendTree::FromClip(MakeStaticClip("x", 2, 0.0f, glm::vec3(0.0f)))));
+    ASSERT_TRUE(animator.Play(clip));
+    EXPECT_FALSE(animator.SetParameter("missing", 1.0f));
+
+    animator.Update(0.5f);
+    EXPECT_FLOAT_EQ(animator.GetTime(), 0.5f);
+    SkeletalSampleContext context;
+    Pose expected;
+    clip->Sample(0.5f, context, expected);
+    EXPECT_LT(glm::length(animator.GetPose().GetBone(2).translation - expected.GetBone(2).translation), 1e-5f);
+
+    // Корень клипа без родителя - модельная матрица совпадает с локальной
+    glm::vec3 origin = animator.GetModelMatrices()[0].TransformPoint(glm::vec3(0.0f));
+    EXPECT_LT(glm::length(origin - glm::vec3(1.0f, 2.0f, 3.0f)), 1e-3f);
+
+    animator.SetPaused(true);
+    animator.Update(0.5f);
+    EXPECT_FLOAT_EQ(animator.GetTime(), 0.5f);
+}
+
+TEST(SkeletalAnimationSystemTest, WorkersMatchSingleThread) {
+    auto skeleton = MakeChain(3);
+    auto walk = SkeletalClip::Compress(MakeMovingClip(31));
+    auto idle = MakeStaticClip("idle", 3, 0.4f, glm::vec3(0.0f, 1.0f, 0.0f));
+    auto tree = std::make_shared<BlendTree>();
+    uint32_t blend = tree->AddParameter("blend");
+    tree->AddBlend(tree->AddClip(idle), tree->AddClip(walk), blend);
+
+    auto mesh = std::make_shared<SkinnedMeshData>();
+    for (int v = 0; v < 12; ++v) {
+        mesh->positions.push_back(glm::vec3(0.1f * v, v % 3, 0.0f));
+        uint16_t indices[4] = {static_cast<uint16_t>(v % 3), 0, 0, 0};
+        float weights[4] = {1.0f, 0.0f, 0.0f, 0.0f};
+        mesh->boneIndices.insert(mesh->boneIndices.end(), indices, indices + 4);
+        mesh->boneWeights.insert(mesh->boneWeights.end(), weights, weights + 4);
+    }
+
+    const int characters = 50;
+    World serialWorld;
+    World parallelWorld;
+    auto* serial = serialWorld.AddSystem<SkeletalAnimationSystem>(&serialWorld);
+    auto* parallel = parallelWorld.AddSystem<SkeletalAnimationSystem>(&parallelWorld, 3u);
+    EXPECT_EQ(serial->GetWorkerCount(), 0u);
+    EXPECT_EQ(parallel->GetWorkerCount(), 3u);
+
+    std::vector<SkeletalAnimator*> serialAnimators;
+    std::vector<SkeletalAnimator*> parallelAnimators;
+    for (World* world : {&serialWorld, &parallelWorld}) {
+        auto& animators = world == &serialWorld ? serialAnimators : parallelAnimators;
+        for (int i = 0; i < characters; ++i) {
+            auto* animator = world->CreateEntity()->AddComponent<SkeletalAnimator>(skeleton);
+            animator->SetBlendTree(tree);
+            animator->SetParameter(blend, (i % 5) / 4.0f);
+            animator->SetSpeed(0.5f + 0.1f * (i % 7));
+            animator->SetSkinnedMesh(mesh);
+            animator->SetCpuSkinning(i % 2 == 0);
+            animators.push_back(animator);
+        }
+    }
+
+    for (int frame = 0; frame < 5; ++frame) {
+        serial->Update(1.0f / 30.0f);
+        parallel->Update(1.0f / 30.0f);
+    }
+
+    EXPECT_EQ(parallel->GetStats().animators, static_cast<uint32_t>(characters));
+    EXPECT_EQ(parallel->GetStats().bones, static_cast<uint32_t>(characters * 3));
+    EXPECT_EQ(parallel->GetStats().skinnedVertices, static_cast<uint32_t>(characters / 2 * 12));
+    EXPECT_EQ(parallel->GetStats().workers, 3u);
+    for (int i = 0; i < characters; ++i) {
+        const auto& a = serialAnimators[i]->GetSkinningMatrices();
+        const auto& b = parallelAnimators[i]->GetSkinningMatrices();
+        for (uint32_t bone = 0; bone < 3; ++bone) {
+            for (int k = 0; k < 16; ++k) {
+                ASSERT_EQ(a[bone].m[k], b[bone].m[k]);
+            }
+        }
+        EXPECT_EQ(serialAnimators[i]->GetSkinnedPositions(), parallelAnimators[i]->GetSkinnedPositions());
+    }
+
+    // Смена числа потоков между кадрами
+    parallel->SetWorkerCount(1);
+    parallel->Update(1.0f / 30.0f);
+    EXPECT_EQ(parallel->GetStats().workers, 1u);
+    
+    // Без своих потоков порции выполняет общий JobSystem
+    serial->Update(1.0f / 30.0f);
+    serial->Update(1.0f / 30.0f);
+    ASSERT_TRUE(JobSystem::GetInstance().Start(2));
+    parallel->SetWorkerCount(0);
+    parallel->Update(1.0f / 30.0f);
+    EXPECT_EQ(parallel->GetStats().workers, 2u);
+    JobSystem::GetInstance().Stop();
+    for (int i = 0; i < characters; ++i) {
+        EXPECT_EQ(serialAnimators[i]->GetSkinnedPositions(), parallelAnimators[i]->GetSkinnedPositions());
+    }
+}
@@ -0,0 +1,253 @@
+#include <gtest/gtest.h>
+#include "FastEngine/Components/Animator.h"
+#include "FastEngine/Components/Sprite.h"
+#include "FastEngine/Entity.h"
+#include "FastEngine/Resources/AnimationClip.h"
+#include "FastEngine/Systems/AnimationSystem.h"
+#include "FastEngine/World.h"
+#include <string>
+#include <vector>
+
+using namespace FastEngine;
+
+namespace {
+
+// Анимация по ячейкам атласа 4x4; имя уникально в пределах теста
+Animation MakeGridAnimation(const std::string& name, AnimationType type, uint32_t frames, float duration = 0.1f) {
+    Animation animation(name);
+    animation.type = type;
+    for (uint32_t i = 0; i < frames; ++i) {
+        animation.frames.push_back(AnimationFrame(AtlasGridRect(4, 4, i), duration));
+    }
+    return animation;
+}
+
+std::vector<int> RunFrames(Animator& animator, int steps, float dt) {
+    std::vector<int> frames;
+    for (int i = 0; i < steps; ++i) {
+        animator.Update(dt);
+        frames.push_back(animator.GetCurrentFrame());
+    }
+    return frames;
+}
+
+class AnimationSystemTest : public ::testing::Test {
+protected:
+    Entity* AddAnimated(const Animation& animation, Sprite** sprite = nullptr) {
+        Entity* entity = world.CreateEntity();
+        Sprite* added = entity->AddComponent<Sprite>(static_cast<Texture*>(nullptr));
+        if (sprite) {
+            *sprite = added;
+        }
+        Animator* animator = entity->AddComponent<Animator>();
+        animator->AddAnimation(animation);
+        animator->Play(animation.name);
+        return entity;
+    }
+
+    World world;
+};
+
+} // namespace
+
+TEST(AnimationClipLibraryTest, SharesIdenticalClips) {
+    AnimationClipLibrary& library = AnimationClipLibrary::GetInstance();
+    Animation walk = MakeGridAnimation("shared_walk", AnimationType::Loop, 4);
+    AnimationClipHandle first = library.Register(walk);
+    EXPECT_NE(first, INVALID_ANIMATION_CLIP);
+    EXPECT_EQ(library.Register(walk), first);
+    EXPECT_EQ(library.Find("shared_walk"), first);
+
+    // То же имя, другие кадры - отдельный клип; Find отдает первый
+    Animation faster = walk;
+    faster.frames[0].duration = 0.05f;
+    AnimationClipHandle second = library.Register(faster);
+    EXPECT_NE(second, first);
+    EXPECT_EQ(library.Find("shared_walk"), first);
+
+    const AnimationClip* clip = library.Get(first);
+    ASSERT_NE(clip, nullptr);
+    EXPECT_EQ(clip->GetFrameCount(), 4u);
+    EXPECT_FLOAT_EQ(clip->duration, 0.4f);
+    EXPECT_FLOAT_EQ(clip->cycleDuration, 0.4f);
+    EXPECT_EQ(clip->uvRects[1], glm::vec4(0.25f, 0.0f, 0.5f, 0.25f));
+    EXPECT_EQ(library.Get(INVALID_ANIMATION_CLIP), nullptr);
+    EXPECT_EQ(library.Register(Animation("empty_clip")), INVALID_ANIMATION_CLIP);
+
+    // Тысяча аниматоров с одной анимацией не добавляют клипов
+    size_t clips = library.GetClipCount();
+    std::vector<std::unique_ptr<Animator>> animators;
+    for (int i = 0; i < 1000; ++i) {
+        animators.push_back(std::make_unique<Animator>());
+        animators.back()->AddAnimation(walk);
+    }
+    EXPECT_EQ(library.GetClipCount(), clips);
+    EXPECT_EQ(animators.back()->GetAnimation("shared_walk"), &clip->source);
+}
+
+TEST(AnimatorStepTest, LoopOncePingPong) {
+    Animator loop;
+    loop.AddAnimation(MakeGridAnimation("step_loop", AnimationType::Loop, 3));
+    loop.Play("step_loop");
+    EXPECT_EQ(RunFrames(loop, 7, 0.1f), std::vector<int>({1, 2, 0, 1, 2, 0, 1}));
+
+    Animator once;
+    std::vector<std::string> completed;
+    once.SetOnAnimationComplete([&completed](const std::string& name) { completed.push_back(name); });
+    once.AddAnimation(MakeGridAnimation("step_once", AnimationType::Once, 3));
+    once.Play("step_once");
+    EXPECT_EQ(RunFrames(once, 4, 0.1f), std::vector<int>({1, 2, 2, 2}));
+    EXPECT_FALSE(once.IsPlaying());
+    EXPECT_EQ(completed, std::vector<std::string>({"step_once"}));
+
+    Animator pingPong;
+    pingPong.AddAnimation(MakeGridAnimation("step_pingpong", AnimationType::PingPong, 3));
+    pingPong.Play("step_pingpong");
+    EXPECT_EQ(RunFrames(pingPong, 8, 0.1f), std::vector<int>({1, 2, 1, 0, 1, 2, 1, 0}));
+}
+
+TEST(AnimatorStepTest, LargeStepKeepsPhase) {
+    Animator animator;
+    animator.AddAnimation(MakeGridAnimation("step_large", AnimationType::Loop, 4));
+    animator.Play("step_large");
+    // 1000 циклов и еще 2.5 кадра: целые циклы отбрасываются
+    animator.Update(400.25f);
+    EXPECT_EQ(animator.GetCurrentFrame(), 2);
+    EXPECT_NEAR(animator.GetPlayback().time, 0.05f, 1e-3f);
+
+    // Скорость аниматора умножается на скорость клипа
+    Animation fast = MakeGridAnimation("step_fast", AnimationType::Loop, 4);
+    fast.speed = 2.0f;
+    animator.AddAnimation(fast);
+    animator.SetSpeed(0.5f);
+    animator.Play("step_fast");
+    EXPECT_EQ(RunFrames(animator, 2, 0.1f), std::vector<int>({1, 2}));
+    EXPECT_FLOAT_EQ(animator.GetSpeed(), 0.5f);
+}
+
+TEST_F(AnimationSystemTest, WritesFrameUVToSprite) {
+    AnimationSystem system(&world);
+    Sprite* sprite = nullptr;
+    Entity* entity = AddAnimated(MakeGridAnimation("uv_walk", AnimationType::Loop, 4), &sprite);
+    Animator* animator = entity->GetComponent<Animator>();
+
+    system.Update(0.05f);
+    EXPECT_EQ(system.GetAnimatorCount(), 1u);
+    EXPECT_EQ(sprite->GetUVRect(), AtlasGridRect(4, 4, 0));
+    system.Update(0.1f);
+    EXPECT_EQ(animator->GetCurrentFrame(), 1);
+    EXPECT_EQ(sprite->GetUVRect(), AtlasGridRect(4, 4, 1));
+    EXPECT_EQ(system.GetStats().frameChanges, 1u);
+    EXPECT_EQ(animator->GetCurrentFrameData().uvRect, AtlasGridRect(4, 4, 1));
+
+    // Подключенный аниматор не продвигается сам
+    animator->Update(1.0f);
+    EXPECT_EQ(animator->GetCurrentFrame(), 1);
+
+    // Пауза аниматора, пауза и скорость системы
+    animator->Pause();
+    system.Update(0.5f);
+    EXPECT_EQ(animator->GetCurrentFrame(), 1);
+    EXPECT_EQ(system.GetStats().playing, 0u);
+    animator->Resume();
+    system.SetGlobalSpeed(2.0f);
+    system.Update(0.05f);
+    EXPECT_EQ(animator->GetCurrentFrame(), 2);
+    system.SetPaused(true);
+    system.Update(1.0f);
+    EXPECT_EQ(animator->GetCurrentFrame(), 2);
+    system.SetPaused(false);
+
+    // Смена клипа пишет UV при следующем Update
+    animator->AddAnimation(MakeGridAnimation("uv_idle", AnimationType::Loop, 2));
+    animator->Play("uv_idle");
+    EXPECT_EQ(sprite->GetUVRect(), AtlasGridRect(4, 4, 2));
+    system.Update(0.0f);
+    EXPECT_EQ(sprite->GetUVRect(), AtlasGridRect(4, 4, 0));
+    EXPECT_EQ(system.GetCurrentAnimation(entity), "uv_idle");
+}
+
+TEST_F(AnimationSystemTest, MatchesStandaloneAnimator) {
+    // Разная скорость и фаза: путь через плотные массивы совпадает с Animator::Update
+    AnimationSystem system(&world);
+    Animation pingPong = MakeGridAnimation("match_pingpong", AnimationType::PingPong, 5, 0.07f);
+    std::vector<Animator*> attached;
+    std::vector<std::unique_ptr<Animator>> standalone;
+    for (int i = 0; i < 16; ++i) {
+        attached.push_back(AddAnimated(pingPong)->GetComponent<Animator>());
+        attached.back()->SetSpeed(0.5f + 0.1f * i);
+        standalone.push_back(std::make_unique<Animator>());
+        standalone.back()->AddAnimation(pingPong);
+        standalone.back()->Play("match_pingpong");
+        standalone.back()->SetSpeed(0.5f + 0.1f * i);
+    }
+
+    for (int frame = 0; frame < 120; ++frame) {
+        system.Update(1.0f / 60.0f);
+        for (size_t i = 0; i < standalone.size(); ++i) {
+            standalone[i]->Update(1.0f / 60.0f);
+            ASSERT_EQ(attached[i]->GetCurrentFrame(), standalone[i]->GetCurrentFrame()) << "animator " << i;
+        }
+    }
+}
+
+TEST_F(AnimationSystemTest, CallbacksMayDestroyEntities) {
+    AnimationSystem system(&world);
+    Entity* first = AddAnimated(MakeGridAnimation("destroy_once", AnimationType::Once, 2));
+    Entity* second = AddAnimated(MakeGridAnimation("destroy_once", AnimationType::Once, 2));
+    Entity* survivor = AddAnimated(MakeGridAnimation("destroy_loop", AnimationType::Loop, 2));
+    system.Update(0.0f);
+    EXPECT_EQ(system.GetAnimatorCount(), 3u);
+
+    // Колбэк первой сущности удаляет вторую: ее колбэки уже не вызываются
+    int frameChanges = 0;
+    int completions = 0;
+    first->GetComponent<Animator>()->SetOnFrameChange([&](int) {
+        ++frameChanges;
+        world.DestroyEntity(second);
+    });
+    first->GetComponent<Animator>()->SetOnAnimationComplete([&](const std::string&) { ++completions; });
+    second->GetComponent<Animator>()->SetOnFrameChange([&](int) {
+        ++frameChanges;
+        world.DestroyEntity(first);
+    });
+    second->GetComponent<Animator>()->SetOnAnimationComplete([&](const std::string&) {
+        ++completions;
+        world.DestroyEntity(second);
+    });
+
+    system.Update(0.25f);
+    EXPECT_EQ(frameChanges, 1);
+    EXPECT_EQ(completions, 1);
+    EXPECT_EQ(system.GetAnimatorCount(), 2u);
+    EXPECT_EQ(system.GetStats().completed, 2u);
+
+    world.DestroyEntity(first);
+    system.Update(0.1f);
+    EXPECT_EQ(system.GetAnimatorCount(), 1u);
+    EXPECT_EQ(survivor->GetComponent<Animator>()->GetCurrentFrame(), 1);
+}
+
+TEST_F(AnimationSystemTest, DetachRestoresAnimatorState) {
+    Animator* animator = nullptr;
+    {
+        AnimationSystem system(&world);
+        animator = AddAnimated(MakeGridAnimation("detach_walk", AnimationType::Loop, 4))->GetComponent<Animator>();
+        system.Update(0.25f);
+        EXPECT_EQ(animator->GetCurrentFrame(), 2);
+    }
+
+    // Без системы аниматор продолжает с того же времени
+    animator->Update(0.07f);
+    EXPECT_EQ(animator->GetCurrentFrame(), 3);
+    EXPECT_TRUE(animator->IsPlaying());
+
+    AnimationSystem system(&world);
+    system.Update(0.1f);
+    EXPECT_EQ(animator->GetCurrentFrame(), 0);
+    animator->Stop();
+    system.Update(1.0f);
+    EXPECT_FALSE(animator->IsPlaying());
+    EXPECT_EQ(animator->GetCurrentFrame(), 0);
+    EXPECT_EQ(system.GetStats().playing, 0u);
+}
@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+#include "FastEngine/Profiling/ScopeProfiler.h"
+#include "FastEngine/Profiling/TraceCapture.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace FastEngine;
+
+namespace {
+
+class TempFile {
+public:
+    explicit TempFile(const std::string& name) : path(name) {}
+    ~TempFile() { std::remove(path.c_str()); }
+    std::string path;
+};
+
+std::string ReadFile(const std::string& path) {
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+size_t Count(const std::string& text, const std::string& pattern) {
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+        count++;
+    }
+    return count;
+}
+
+// Скобки вне строк сбалансированы, документ - объект с traceEvents
+bool IsWellFormed(const std::string& json) {
+    if (json.compare(0, 16, "{\"traceEvents\":[") != 0) {
+        return false;
+    }
+    int depth = 0;
+    bool inString = false;
+    for (size_t i = 0; i < json.size(); ++i) {
+        char c = json[i];
+        if (inString) {
+            if (c == '\\') {
+                ++i;
+            } else if (c == '"') {
+                inString = false;
+            }
+        } else if (c == '"') {
+            inString = true;
+        } else if (c == '{' || c == '[') {
+            depth++;
+        } else if (c == '}' || c == ']') {
+            if (--depth < 0) {
+                return false;
+            }
+        }
+    }
+    return depth == 0 && !inString;
+}
+
+} // namespace
+
+TEST(TraceWriterTest, StreamsWellFormedDocument) {
+    TempFile file("trace_writer.json");
+    TraceWriter writer;
+    ASSERT_TRUE(writer.Open(file.path));
+    writer.WriteThreadName(1, "Main \"game\" thread");
+    writer.WriteSlice("Update\\Physics", "cpu", 1, 10.0, 2.5);
+    writer.WriteCounter("Entities", 11.0, 42.0);
+    writer.WriteFlow("job", 7, 1, 11.5, true);
+    writer.WriteFlow("job", 7, 2, 12.0, false);
+    EXPECT_EQ(writer.GetEventCount(), 5u);
+    writer.Close();
+    EXPECT_FALSE(writer.IsOpen());
+
+    std::string json = ReadFile(file.path);
+    EXPECT_TRUE(IsWellFormed(json));
+    EXPECT_NE(json.find("Main \\\"game\\\" thread"), std::string::npos);
+    EXPECT_NE(json.find("Update\\\\Physics"), std::string::npos);
+    EXPECT_NE(json.find("\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"value\":42.000}"), std::string::npos);
+    EXPECT_EQ(Count(json, "\"ph\":\"s\""), 1u);
+    EXPECT_EQ(Count(json, "\"ph\":\"f\",\"bp\":\"e\""), 1u);
+}
+
+TEST(TraceCaptureTest, CapturesFramesWithCountersAndFlows) {
+    TraceCapture& capture = TraceCapture::GetInstance();
+    TempFile file("trace_capture.json");
+    const ProfileNameId flow = ProfileNames::Register("capture.flow");
+    std::atomic<int> completed(0);
+    capture.SetOnCaptureComplete([&completed](const TraceCaptureInfo&) { completed++; });
+
+    EXPECT_FALSE(TraceCapture::IsRecording());
+    ASSERT_TRUE(capture.StartCapture(file.path, 2));
+    EXPECT_TRUE(TraceCapture::IsRecording());
+    EXPECT_FALSE(capture.StartCapture("trace_capture_second.json", 2));
+
+    for (int frame = 0; frame < 4; ++frame) {
+        ScopeProfiler::MarkFrame();
+        FASTENGINE_PROFILE_SCOPE("capture.frame");
+        FASTENGINE_TRACE_COUNTER("capture.counter", frame);
+        TraceCapture::FlowBegin(flow, frame + 1);
+        std::thread worker([flow, frame]() {
+            ScopeProfiler::SetThreadName("Capture Worker");
+            FASTENGINE_PROFILE_SCOPE("capture.job");
+            TraceCapture::FlowEnd(flow, frame + 1);
+        });
+        worker.join();
+    }
+    ScopeProfiler::MarkFrame();
+    ScopeProfiler::MarkFrame();
+    ScopeProfiler::GetInstance().Flush();
+
+    EXPECT_FALSE(capture.IsCapturing());
+    EXPECT_FALSE(TraceCapture::IsRecording());
+    EXPECT_EQ(completed.load(), 1);
+    TraceCaptureInfo info;
+    ASSERT_TRUE(capture.GetLastCapture(info));
+    EXPECT_EQ(info.filename, file.path);
+    EXPECT_EQ(info.frames, 2u);
+    EXPECT_EQ(info.lastFrame, info.firstFrame + 1);
+    EXPECT_FALSE(info.spike);
+
+    std::string json = ReadFile(file.path);
+    EXPECT_TRUE(IsWellFormed(json));
+    EXPECT_EQ(Count(json, "\"name\":\"capture.frame\""), 2u);
+    EXPECT_EQ(Count(json, "\"name\":\"capture.job\""), 2u);
+    EXPECT_EQ(Count(json, "\"name\":\"capture.counter\""), 2u);
+    EXPECT_EQ(Count(json, "\"ph\":\"s\""), 2u);
+    EXPECT_EQ(Count(json, "\"ph\":\"f\""), 2u);
+    EXPECT_EQ(Count(json, "\"cat\":\"frame\""), 2u);
+    EXPECT_NE(json.find("Capture Worker"), std::string::npos);
+    EXPECT_EQ(info.events, Count(json, "\"ph\":"));
+
+    capture.SetOnCaptureComplete(nullptr);
+    capture.Update();
+    EXPECT_FALSE(ScopeProfiler::GetInstance().IsRunning());
+}
+
+TEST(TraceCaptureTest, SpikeTriggerCapturesSurroundingFrames) {
+    TraceCapture& capture = TraceCapture::GetInstance();
+    const uint32_t capturesBefore = capture.GetCaptureCount();
+    capture.SetSpikeTrigger(25.0, 2, 1, "trace_spike");
+    EXPECT_TRUE(capture.IsSpikeTriggerEnabled());
+    EXPECT_TRUE(TraceCapture::IsRecording());
+
+    for (int frame = 0; frame < 7; ++frame) {
+        ScopeProfiler::MarkFrame();
+        if (frame == 4) {
+            FASTENGINE_PROFILE_SCOPE("spike.slow");
+            std::this_thread::sleep_for(std::chrono::milliseconds(60));
+        } else {
+            FASTENGINE_PROFILE_SCOPE("spike.normal");
+        }
+    }
+    ScopeProfiler::MarkFrame();
+    ScopeProfiler::MarkFrame();
+    ScopeProfiler::GetInstance().Flush();
+    capture.DisableSpikeTrigger();
+
+    ASSERT_EQ(capture.GetCaptureCount(), capturesBefore + 1);
+    TraceCaptureInfo info;
+    ASSERT_TRUE(capture.GetLastCapture(info));
+    TempFile file(info.filename);
+    EXPECT_TRUE(info.spike);
+    EXPECT_GE(info.spikeMs, 25.0);
+    EXPECT_EQ(info.frames, 4u);
+    EXPECT_EQ(info.filename, "trace_spike_frame" + std::to_string(info.firstFrame + 2) + ".json");
+
+    std::string json = ReadFile(file.path);
+    EXPECT_TRUE(IsWellFormed(json));
+    EXPECT_EQ(Count(json, "\"name\":\"spike.slow\""), 1u);
+    EXPECT_EQ(Count(json, "\"name\":\"spike.normal\""), 3u);
+    EXPECT_FALSE(TraceCapture::IsRecording());
+    EXPECT_FALSE(ScopeProfiler::GetInstance().IsRunning());
+}
+
+TEST(TraceCaptureTest, StopCaptureClosesFile) {
+    TraceCapture& capture = TraceCapture::GetInstance();
+    TempFile file("trace_stop.json");
+    ASSERT_TRUE(capture.StartCapture(file.path, 100));
+    for (int frame = 0; frame < 3; ++frame) {
+        ScopeProfiler::MarkFrame();
+        FASTENGINE_PROFILE_SCOPE("stop.frame");
+    }
+    ScopeProfiler::MarkFrame();
+    ScopeProfiler::GetInstance().Flush();
+    capture.StopCapture();
+
+    EXPECT_FALSE(capture.IsCapturing());
+    TraceCaptureInfo info;
+    ASSERT_TRUE(capture.GetLastCapture(info));
+    EXPECT_EQ(info.frames, 2u);
+    std::string json = ReadFile(file.path);
+    EXPECT_TRUE(IsWellFormed(json));
+    EXPECT_EQ(Count(json, "\"name\":\"stop.frame\""), 2u);
+
+    // Пустое имя файла не открывается
+    EXPECT_FALSE(capture.StartCapture("", 1));
+    EXPECT_FALSE(TraceCapture::IsRecording());
+}